@@ -16,6 +16,10 @@ export {
   AssetInfo,
   RemoteControlPreset,
   EditorCommand,
+  EditorContextSnapshot,
+  EditorContextChanges,
+  BridgeMetric,
+  BridgeStats,
   createRemoteControlClient,
 } from './remote-control.js';
 
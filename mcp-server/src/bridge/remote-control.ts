@@ -107,6 +107,144 @@ export interface RemoteControlPreset {
   }>;
 }
 
+export interface JournalRecord {
+  sequence: number;
+  path: string;
+  name: string;
+  class: string;
+  changes: Array<'added' | 'removed' | 'transform' | 'properties'>;
+  /** Changed properties or component names; absent means anything may have changed */
+  properties?: string[];
+  timestamp: string;
+}
+
+export interface JournalChanges {
+  epoch: number;
+  head: number;
+  since: number;
+  /** Records were lost since `since`; the caller must recapture */
+  resyncRequired: boolean;
+  records: JournalRecord[];
+  hasMore: boolean;
+  /** Sequence to pass to the next call */
+  nextSequence: number;
+}
+
+export type JobState = 'queued' | 'running' | 'succeeded' | 'failed' | 'cancelled';
+
+/** Status of a bridge job, as carried by job.progress and job.completed events */
+export interface JobStatus {
+  jobId: string;
+  kind: string;
+  state: JobState;
+  done: number;
+  total: number;
+  /** done / total in [0, 1] */
+  progress: number;
+  stage: string;
+  chunks: number;
+  error?: string;
+}
+
+export interface JobResult<T = unknown> extends JobStatus {
+  result?: T;
+}
+
+/** One page of an asset index search */
+export interface AssetSearchPage {
+  assets: Array<{ name: string; path: string; class: string; package: string }>;
+  count: number;
+  /** Empty on the last page */
+  nextCursor: string;
+}
+
+/** Server-side actor query. Class filters also match subclasses of a named actor class. */
+export interface ActorQuery {
+  classFilters?: string[];
+  /** Case-insensitive substring of the actor name */
+  nameFilter?: string;
+  /** All of these tags */
+  tags?: string[];
+  bounds?: { min: { x: number; y: number; z: number }; max: { x: number; y: number; z: number } };
+  /** Orders results nearest first; radius (if > 0) drops actors farther away */
+  near?: { origin: { x: number; y: number; z: number }; radius?: number };
+  offset?: number;
+  limit?: number;
+}
+
+export interface ActorQueryResult {
+  actors: Array<{
+    name: string;
+    class: string;
+    path: string;
+    transform: {
+      location: { x: number; y: number; z: number };
+      rotation: { pitch: number; yaw: number; roll: number };
+      scale: { x: number; y: number; z: number };
+    };
+    tags: string[];
+  }>;
+  /** Actors returned */
+  count: number;
+  /** Matches before offset and limit */
+  total: number;
+}
+
+/** Editor context as the plugin caches it; version changes whenever any part of it does */
+export interface EditorContextSnapshot {
+  version: number;
+  world?: { name: string; mapName: string; actorCount: number };
+  selection: Array<{ name: string; class: string; path: string }>;
+  streamingLevels?: Array<{ name: string; loaded: boolean }>;
+  isPlaying: boolean;
+  isSimulating: boolean;
+}
+
+/** Pushed 'editor.context.changed' payload: the sections changed since baseVersion */
+export interface EditorContextChanges extends Partial<Omit<EditorContextSnapshot, 'version'>> {
+  version: number;
+  baseVersion: number;
+}
+
+/** Latency figures of one bridge metric, in microseconds */
+export interface BridgeMetric {
+  name: string;
+  count: number;
+  min: number;
+  mean: number;
+  p50: number;
+  p90: number;
+  p99: number;
+  p999: number;
+  max: number;
+  totalMs: number;
+  bytesIn: number;
+  bytesOut: number;
+}
+
+export interface BridgeStats {
+  uptimeSeconds: number;
+  enabled: boolean;
+  /** Busiest first: "<Namespace>.<Function>" commands, "request.*" dispatches, "ws.*" transport */
+  metrics: BridgeMetric[];
+  webSocket: {
+    clients: Array<{
+      clientId: string;
+      queuedMessages: number;
+      queuedBytes: number;
+      peakQueuedMessages: number;
+      sentMessages: number;
+      sentBytes: number;
+      droppedMessages: number;
+      /** Frames larger than the whole queue budget, also counted as dropped */
+      oversizedMessages: number;
+    }>;
+    queuedMessages: number;
+    queuedBytes: number;
+  };
+  activeJobs: number;
+}
+
 export interface EditorCommand {
   command: string;
   parameters?: string[];
@@ -137,6 +275,7 @@ export class RemoteControlClient {
   private baseUrl: string;
   private connected: boolean = false;
   private lastPingTime: Date | null = null;
+  private editorContext: EditorContextSnapshot | null = null;
 
   constructor(config: Partial<RemoteControlConfig>, logger: Logger) {
     this.config = { ...DEFAULT_CONFIG, ...config };
@@ -519,6 +658,104 @@ export class RemoteControlClient {
     };
   }
 
+  /**
+   * Query actors in the editor world. Filtering, ordering and paging all run in the editor.
+   */
+  async queryActors(query: ActorQuery): Promise<RemoteControlResponse<ActorQueryResult>> {
+    const parameters: Record<string, unknown> = {
+      ClassFilters: query.classFilters ?? [],
+      NameFilter: query.nameFilter ?? '',
+      Tags: query.tags ?? [],
+      Offset: query.offset ?? 0,
+      Limit: query.limit ?? 0,
+    };
+    if (query.bounds) {
+      parameters.BoundsMin = query.bounds.min;
+      parameters.BoundsMax = query.bounds.max;
+    }
+    if (query.near) {
+      parameters.Origin = query.near.origin;
+      parameters.Radius = query.near.radius ?? 0;
+    }
+
+    const result = await this.callFunction<{ success: boolean; message?: string; data?: ActorQueryResult }>(
+      '/Script/AegisBridge.AegisSubsystem',
+      'QueryActors',
+      parameters,
+      false
+    );
+
+    if (!result.success || !result.data?.success || !result.data.data) {
+      return { success: false, error: result.error || result.data?.message };
+    }
+
+    return { success: true, data: result.data.data };
+  }
+
+  /**
+   * Get the editor context. The last reply is kept and its version sent along, so when
+   * nothing changed the editor only confirms the version.
+   */
+  async getEditorContext(forceRefresh: boolean = false): Promise<RemoteControlResponse<EditorContextSnapshot>> {
+    const cached = forceRefresh ? null : this.editorContext;
+
+    const result = await this.callFunction<{
+      success: boolean;
+      message?: string;
+      data?: EditorContextSnapshot & { unchanged?: boolean };
+    }>(
+      '/Script/AegisBridge.AegisSubsystem',
+      'GetEditorContext',
+      { SinceVersion: cached?.version ?? -1 },
+      false
+    );
+
+    if (!result.success || !result.data?.success || !result.data.data) {
+      return { success: false, error: result.error || result.data?.message };
+    }
+
+    const { unchanged, ...snapshot } = result.data.data;
+    if (unchanged && cached) {
+      return { success: true, data: cached };
+    }
+
+    this.editorContext = { ...snapshot, selection: snapshot.selection ?? [] };
+    return { success: true, data: this.editorContext };
+  }
+
+  /**
+   * Apply a pushed context diff to the kept context. Returns false when the diff does not
+   * follow the kept version; the next getEditorContext then fetches in full.
+   */
+  applyEditorContextChanges(changes: EditorContextChanges): boolean {
+    const { baseVersion, ...sections } = changes;
+    if (!this.editorContext || this.editorContext.version !== baseVersion) {
+      this.editorContext = null;
+      return false;
+    }
+
+    this.editorContext = { ...this.editorContext, ...sections };
+    return true;
+  }
+
+  /**
+   * Get the plugin's latency, payload and queue figures, optionally clearing them
+   */
+  async getBridgeStats(reset: boolean = false): Promise<RemoteControlResponse<BridgeStats>> {
+    const result = await this.callFunction<{ success: boolean; message?: string; data?: BridgeStats }>(
+      '/Script/AegisBridge.AegisSubsystem',
+      'GetBridgeStats',
+      { bReset: reset },
+      false
+    );
+
+    if (!result.success || !result.data?.success || !result.data.data) {
+      return { success: false, error: result.error || result.data?.message };
+    }
+
+    return { success: true, data: result.data.data };
+  }
+
   /**
    * Set actor transform
    */
@@ -616,6 +853,39 @@ export class RemoteControlClient {
     return { success: true, data: assets };
   }
 
+  /**
+   * Search the editor's asset name index, one page at a time. Pass the returned nextCursor
+   * to continue; it comes back empty on the last page.
+   */
+  async searchAssetIndex(query: {
+    text?: string;
+    prefix?: boolean;
+    classNames?: string[];
+    path?: string;
+    cursor?: string;
+    limit?: number;
+  }): Promise<RemoteControlResponse<AssetSearchPage>> {
+    const result = await this.callFunction<{ success: boolean; message?: string; data?: AssetSearchPage }>(
+      '/Script/AegisBridge.AegisSubsystem',
+      'SearchAssets',
+      {
+        SearchQuery: query.text ?? '',
+        bPrefix: query.prefix ?? false,
+        AssetTypes: query.classNames ?? [],
+        Path: query.path ?? '',
+        Cursor: query.cursor ?? '',
+        Limit: query.limit ?? 0,
+      },
+      false
+    );
+
+    if (!result.success || !result.data?.success || !result.data.data) {
+      return { success: false, error: result.error || result.data?.message };
+    }
+
+    return { success: true, data: result.data.data };
+  }
+
   /**
    * Load an asset
    */
@@ -836,6 +1106,91 @@ export class RemoteControlClient {
     }));
   }
 
+  // ============================================================================
+  // Change Journal
+  // ============================================================================
+
+  /**
+   * Get actor changes recorded after a journal sequence number
+   */
+  async getChangesSince(
+    since: number,
+    maxRecords: number = 1000
+  ): Promise<RemoteControlResponse<JournalChanges>> {
+    const result = await this.callFunction<JournalChanges & { error?: string }>(
+      '/Script/AegisBridge.AegisChangeJournal',
+      'GetChangesSince',
+      { Since: since, MaxRecords: maxRecords },
+      false
+    );
+
+    if (!result.success || !result.data || result.data.error) {
+      return { success: false, error: result.error || result.data?.error };
+    }
+
+    return { success: true, data: result.data };
+  }
+
+  // ============================================================================
+  // Jobs
+  // ============================================================================
+
+  /**
+   * Start a long-running command as a job. Progress, chunks and completion arrive as
+   * job.progress, job.chunk and job.completed events; the result can also be pulled
+   * with getJobResult.
+   */
+  async startJob(kind: string, params: Record<string, unknown> = {}): Promise<RemoteControlResponse<{ jobId: string }>> {
+    return this.callJobManager<{ jobId: string }>('StartJob', { Kind: kind, Params: params });
+  }
+
+  /**
+   * Get the status of a job
+   */
+  async getJob(jobId: string): Promise<RemoteControlResponse<JobStatus>> {
+    return this.callJobManager<JobStatus>('GetJob', { JobId: jobId });
+  }
+
+  /**
+   * Get the status and result of a job
+   */
+  async getJobResult<T = unknown>(jobId: string): Promise<RemoteControlResponse<JobResult<T>>> {
+    return this.callJobManager<JobResult<T>>('GetJobResult', { JobId: jobId });
+  }
+
+  /**
+   * Request cancellation of a running job
+   */
+  async cancelJob(jobId: string): Promise<RemoteControlResponse<void>> {
+    const result = await this.callJobManager<void>('CancelJob', { JobId: jobId });
+    return { success: result.success, error: result.error };
+  }
+
+  /**
+   * List retained jobs
+   */
+  async listJobs(): Promise<RemoteControlResponse<{ active: number; jobs: JobStatus[] }>> {
+    return this.callJobManager<{ active: number; jobs: JobStatus[] }>('ListJobs', {});
+  }
+
+  private async callJobManager<T>(
+    functionName: string,
+    parameters: Record<string, unknown>
+  ): Promise<RemoteControlResponse<T>> {
+    const result = await this.callFunction<T & { error?: string }>(
+      '/Script/AegisBridge.AegisJobManager',
+      functionName,
+      parameters,
+      false
+    );
+
+    if (!result.success || result.data?.error) {
+      return { success: false, error: result.error || result.data?.error };
+    }
+
+    return { success: true, data: result.data };
+  }
+
   // ============================================================================
   // Batch Operations
   // ============================================================================
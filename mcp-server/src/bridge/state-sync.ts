@@ -5,7 +5,13 @@
 
 import { EventEmitter } from 'events';
 import { Logger } from '../utils/logger.js';
-import { RemoteControlClient, ActorInfo, AssetInfo } from './remote-control.js';
+import {
+  RemoteControlClient,
+  ActorInfo,
+  AssetInfo,
+  EditorContextChanges,
+  JournalRecord,
+} from './remote-control.js';
 import { UnrealWebSocketClient, WebSocketEvent, WebSocketEventType } from './websocket.js';
 
 // ============================================================================
@@ -33,6 +39,9 @@ export interface StateSyncConfig {
 
   /** Maximum tracked changes */
   maxTrackedChanges: number;
+
+  /** Subscribe to editor context diffs instead of relying on conditional fetches alone */
+  pushEditorContext: boolean;
 }
 
 export interface SyncedActor {
@@ -99,8 +108,12 @@ const DEFAULT_CONFIG: StateSyncConfig = {
   maxCachedAssets: 500,
   enableChangeTracking: true,
   maxTrackedChanges: 100,
+  pushEditorContext: false,
 };
 
+/** Journal records fetched per request while catching up */
+const JOURNAL_PAGE_SIZE = 1000;
+
 // ============================================================================
 // State Synchronization Manager
 // ============================================================================
@@ -126,6 +139,9 @@ export class StateSyncManager extends EventEmitter {
   private lastSyncTime: Date | null = null;
   private syncInProgress: boolean = false;
 
+  // Last change journal sequence applied, null until the editor journal has been reached
+  private journalSequence: number | null = null;
+
   // Event subscriptions
   private unsubscribers: Array<() => void> = [];
 
@@ -182,6 +198,7 @@ export class StateSyncManager extends EventEmitter {
     this.assetCache.clear();
     this.changeHistory = [];
     this.pendingChanges.clear();
+    this.journalSequence = null;
 
     this.logger.info('State sync manager shutdown complete');
   }
@@ -493,6 +510,9 @@ export class StateSyncManager extends EventEmitter {
     this.logger.info('Starting full state sync');
 
     try {
+      // Take the journal position first so changes made during the sync are polled again
+      await this.refreshJournalHead();
+
       // Sync level state
       await this.syncLevelState();
 
@@ -519,6 +539,70 @@ export class StateSyncManager extends EventEmitter {
     }
   }
 
+  /**
+   * Apply the actor changes the editor journal recorded since the last poll.
+   * Falls back to a full sync when the journal is unreachable or has dropped records.
+   */
+  async pollChanges(): Promise<void> {
+    if (this.journalSequence === null) {
+      await this.performFullSync();
+      return;
+    }
+
+    if (this.syncInProgress) {
+      return;
+    }
+
+    this.syncInProgress = true;
+    let resyncRequired = false;
+
+    try {
+      let since = this.journalSequence;
+      const modified = new Set<string>();
+
+      for (;;) {
+        const result = await this.remoteControl.getChangesSince(since, JOURNAL_PAGE_SIZE);
+        if (!result.success || !result.data || result.data.resyncRequired) {
+          resyncRequired = true;
+          break;
+        }
+
+        for (const record of result.data.records) {
+          if (this.applyJournalRecord(record)) {
+            modified.add(record.path);
+          }
+        }
+
+        since = result.data.nextSequence;
+        if (!result.data.hasMore) {
+          break;
+        }
+      }
+
+      if (!resyncRequired) {
+        this.journalSequence = since;
+
+        // Only cached actors the journal reported are refetched
+        for (const path of modified) {
+          await this.getActor(path, true);
+        }
+
+        this.lastSyncTime = new Date();
+        this.emit('sync_complete', { timestamp: this.lastSyncTime, incremental: true });
+      }
+    } catch (error) {
+      this.logger.error('Incremental state sync failed', error as Error);
+      this.emit('sync_error', error);
+    } finally {
+      this.syncInProgress = false;
+    }
+
+    if (resyncRequired) {
+      this.logger.info('Change journal requires resync');
+      await this.performFullSync();
+    }
+  }
+
   /**
    * Start automatic synchronization
    */
@@ -529,7 +613,7 @@ export class StateSyncManager extends EventEmitter {
 
     this.syncTimer = setInterval(async () => {
       if (!this.syncInProgress) {
-        await this.performFullSync();
+        await this.pollChanges();
       }
     }, this.config.syncIntervalMs);
 
@@ -588,6 +672,15 @@ export class StateSyncManager extends EventEmitter {
     this.unsubscribers.push(
       this.webSocket.subscribe('transaction_ended', (event) => this.handleTransactionEnded(event))
     );
+
+    // Editor context diffs keep the client's copy current between fetches
+    if (this.config.pushEditorContext) {
+      this.unsubscribers.push(
+        this.webSocket.subscribe('editor_context_changed', (event) =>
+          this.remoteControl.applyEditorContextChanges(event.data as EditorContextChanges)
+        )
+      );
+    }
   }
 
   private handleActorSpawned(event: WebSocketEvent): void {
@@ -771,6 +864,80 @@ export class StateSyncManager extends EventEmitter {
     this.emit('transaction_ended', data);
   }
 
+  private async refreshJournalHead(): Promise<void> {
+    const result = await this.remoteControl.getChangesSince(0, 0);
+    this.journalSequence = result.success && result.data ? result.data.head : null;
+  }
+
+  /**
+   * Fold one journal record into the caches. Returns true when a cached actor needs a refetch.
+   */
+  private applyJournalRecord(record: JournalRecord): boolean {
+    if (record.changes.includes('removed')) {
+      const cached = this.actorCache.get(record.path);
+
+      this.recordChange({
+        type: 'actor',
+        target: record.path,
+        changeType: 'delete',
+        previousValue: cached?.info,
+        source: 'remote',
+        undoable: true,
+      });
+
+      this.actorCache.delete(record.path);
+      if (this.levelState) {
+        this.levelState.actors = this.levelState.actors.filter((a) => a !== record.path);
+        this.levelState.dirty = true;
+      }
+
+      this.emit('actor_deleted', { actorPath: record.path });
+      return false;
+    }
+
+    if (record.changes.includes('added')) {
+      this.recordChange({
+        type: 'actor',
+        target: record.path,
+        changeType: 'create',
+        newValue: record,
+        source: 'remote',
+        undoable: true,
+      });
+
+      if (this.levelState && !this.levelState.actors.includes(record.path)) {
+        this.levelState.actors.push(record.path);
+        this.levelState.dirty = true;
+      }
+
+      this.emit('actor_spawned', { actorPath: record.path, actorClass: record.class });
+      return false;
+    }
+
+    const cached = this.actorCache.get(record.path);
+
+    this.recordChange({
+      type: 'actor',
+      target: record.path,
+      changeType: 'modify',
+      previousValue: cached?.info,
+      newValue: { changes: record.changes, properties: record.properties },
+      source: 'remote',
+      undoable: true,
+    });
+
+    this.emit('actor_modified', {
+      actorPath: record.path,
+      changes: { changes: record.changes, properties: record.properties },
+    });
+
+    if (cached) {
+      cached.dirty = true;
+      return true;
+    }
+    return false;
+  }
+
   private isCacheStale(lastSyncedAt: Date): boolean {
     return Date.now() - lastSyncedAt.getTime() > this.config.cacheTtlMs;
   }
@@ -7,6 +7,7 @@ import WebSocket from 'ws';
 import { EventEmitter } from 'events';
 import { Logger } from '../utils/logger.js';
 import { UnrealConnectionError } from '../utils/errors.js';
+import { decodeMessagePack, encodeMessagePack, isMessagePack, WireEncoding } from './wire-codec.js';
 
 // ============================================================================
 // Types
@@ -42,6 +43,9 @@ export interface WebSocketConfig {
 
   /** Message queue size when disconnected */
   messageQueueSize: number;
+
+  /** Preferred frame encoding; MessagePack is only used when the server offers it */
+  encoding: WireEncoding;
 }
 
 export interface WebSocketMessage {
@@ -49,6 +53,10 @@ export interface WebSocketMessage {
   requestId?: string;
   payload?: unknown;
   timestamp?: number;
+
+  /** Topic of a server event frame ({type: 'event', event, data}) */
+  event?: string;
+  data?: unknown;
 }
 
 export interface WebSocketEvent {
@@ -65,16 +73,57 @@ export type WebSocketEventType =
   | 'message'
   | 'actor_spawned'
   | 'actor_deleted'
+  | 'entities_changed'
   | 'actor_modified'
   | 'property_changed'
   | 'level_loaded'
   | 'level_saved'
   | 'selection_changed'
+  | 'editor_context_changed'
   | 'blueprint_compiled'
   | 'asset_imported'
   | 'pcg_executed'
   | 'transaction_started'
-  | 'transaction_ended';
+  | 'transaction_ended'
+  | 'job_progress'
+  | 'job_chunk'
+  | 'job_completed';
+
+/**
+ * Server topics for the client event types. The plugin only builds and sends an event
+ * to clients subscribed to its topic (wildcards such as 'world.entity.*' are accepted).
+ * Spawns and deletes arrive batched in 'world.entity.changed' and are fanned out per actor.
+ */
+const EVENT_TOPICS: Record<string, string> = {
+  actor_spawned: 'world.entity.changed',
+  actor_deleted: 'world.entity.changed',
+  entities_changed: 'world.entity.changed',
+  'world.entity.spawned': 'world.entity.changed',
+  'world.entity.destroyed': 'world.entity.changed',
+  level_loaded: 'world.level.changed',
+  selection_changed: 'editor.selection.changed',
+  editor_context_changed: 'editor.context.changed',
+  job_progress: 'job.progress',
+  job_chunk: 'job.chunk',
+  job_completed: 'job.completed',
+};
+
+const TOPIC_EVENTS: Record<string, WebSocketEventType> = {
+  'world.entity.changed': 'entities_changed',
+  'world.level.changed': 'level_loaded',
+  'editor.selection.changed': 'selection_changed',
+  'editor.context.changed': 'editor_context_changed',
+  'job.progress': 'job_progress',
+  'job.chunk': 'job_chunk',
+  'job.completed': 'job_completed',
+};
+
+/** Batched spawn/delete payload of 'world.entity.changed' */
+export interface EntityChangeBatch {
+  spawned: Array<{ actorName: string; actorClass: string; actorPath: string }>;
+  destroyed: Array<{ actorName: string; actorClass: string; actorPath: string }>;
+  cancelled: number;
+}
 
 export interface PendingRequest {
   resolve: (response: unknown) => void;
@@ -97,6 +146,7 @@ const DEFAULT_CONFIG: WebSocketConfig = {
   pingIntervalMs: 30000,
   pongTimeoutMs: 10000,
   messageQueueSize: 100,
+  encoding: 'msgpack',
 };
 
 // ============================================================================
@@ -117,6 +167,7 @@ export class UnrealWebSocketClient extends EventEmitter {
   private messageQueue: WebSocketMessage[] = [];
   private eventSubscriptions: Map<string, Set<(event: WebSocketEvent) => void>> = new Map();
   private lastMessageTime: Date | null = null;
+  private wireEncoding: WireEncoding = 'json';
 
   constructor(config: Partial<WebSocketConfig>, logger: Logger) {
     super();
@@ -211,6 +262,13 @@ export class UnrealWebSocketClient extends EventEmitter {
     return this.lastMessageTime;
   }
 
+  /**
+   * Get the frame encoding negotiated with the server
+   */
+  getWireEncoding(): WireEncoding {
+    return this.wireEncoding;
+  }
+
   /**
    * Send a message and wait for response
    */
@@ -255,7 +313,7 @@ export class UnrealWebSocketClient extends EventEmitter {
       return;
     }
 
-    const data = JSON.stringify(message);
+    const data = this.wireEncoding === 'msgpack' ? encodeMessagePack(message) : JSON.stringify(message);
     this.ws!.send(data);
 
     this.logger.debug('Message sent', { type: message.type, requestId: message.requestId });
@@ -264,7 +322,7 @@ export class UnrealWebSocketClient extends EventEmitter {
   /**
    * Subscribe to an event type
    */
-  subscribe(eventType: WebSocketEventType, handler: (event: WebSocketEvent) => void): () => void {
+  subscribe(eventType: WebSocketEventType | string, handler: (event: WebSocketEvent) => void): () => void {
     let handlers = this.eventSubscriptions.get(eventType);
     if (!handlers) {
       handlers = new Set();
@@ -273,11 +331,10 @@ export class UnrealWebSocketClient extends EventEmitter {
 
     handlers.add(handler);
 
-    // Send subscription message to server
-    this.send({
-      type: 'subscribe',
-      payload: { eventType },
-    });
+    // Send subscription message to server, once per topic
+    if (handlers.size === 1 && this.countTopicUsers(eventType) === 1) {
+      this.sendSubscription('subscribe', eventType);
+    }
 
     // Return unsubscribe function
     return () => {
@@ -285,11 +342,10 @@ export class UnrealWebSocketClient extends EventEmitter {
       if (handlers!.size === 0) {
         this.eventSubscriptions.delete(eventType);
 
-        // Send unsubscription message
-        this.send({
-          type: 'unsubscribe',
-          payload: { eventType },
-        });
+        // Send unsubscription message once nothing else needs the topic
+        if (this.countTopicUsers(eventType) === 0) {
+          this.sendSubscription('unsubscribe', eventType);
+        }
       }
     };
   }
@@ -382,10 +438,22 @@ export class UnrealWebSocketClient extends EventEmitter {
     this.lastMessageTime = new Date();
 
     try {
-      const message = JSON.parse(data.toString()) as WebSocketMessage;
+      const message = this.decodeFrame(data);
 
       this.logger.debug('Message received', { type: message.type, requestId: message.requestId });
 
+      // Encoding handshake
+      if (message.type === 'event' && message.event === 'connection.established') {
+        this.negotiateEncoding(message.data as { encodings?: string[] } | undefined);
+      } else if (message.type === 'configured' && !message.requestId) {
+        const encoding = (message.payload as { encoding?: WireEncoding } | undefined)?.encoding;
+        if (encoding) {
+          this.wireEncoding = encoding;
+          this.logger.info('Wire encoding negotiated', { encoding });
+        }
+        return;
+      }
+
       // Check if this is a response to a pending request
       if (message.requestId && this.pendingRequests.has(message.requestId)) {
         const pending = this.pendingRequests.get(message.requestId)!;
@@ -400,23 +468,25 @@ export class UnrealWebSocketClient extends EventEmitter {
         return;
       }
 
-      // Handle event message
+      // Handle event message; server event frames carry their topic separately
+      const topic = message.type === 'event' && message.event ? message.event : message.type;
+      const eventType = TOPIC_EVENTS[topic] ?? topic;
+      const timestamp = new Date(message.timestamp || Date.now());
+
       const event: WebSocketEvent = {
-        type: message.type,
-        data: message.payload,
-        timestamp: new Date(message.timestamp || Date.now()),
+        type: eventType,
+        data: message.type === 'event' ? message.data : message.payload,
+        timestamp,
       };
 
-      // Notify subscribers
-      const handlers = this.eventSubscriptions.get(message.type as WebSocketEventType);
-      if (handlers) {
-        for (const handler of handlers) {
-          try {
-            handler(event);
-          } catch (error) {
-            this.logger.error('Event handler error', error as Error, { type: message.type });
-          }
-        }
+      // Notify subscribers, by client event type and by raw topic
+      this.dispatch(eventType, event);
+      if (topic !== eventType) {
+        this.dispatch(topic, event);
+      }
+
+      if (topic === 'world.entity.changed') {
+        this.dispatchEntityBatch(event.data as EntityChangeBatch, timestamp);
       }
 
       // Emit generic message event
@@ -426,9 +496,66 @@ export class UnrealWebSocketClient extends EventEmitter {
     }
   }
 
+  /**
+   * Decode a text or binary frame; the first byte tells JSON and MessagePack apart
+   */
+  private decodeFrame(data: WebSocket.Data): WebSocketMessage {
+    if (typeof data === 'string') {
+      return JSON.parse(data) as WebSocketMessage;
+    }
+
+    const bytes = Array.isArray(data)
+      ? Buffer.concat(data)
+      : data instanceof ArrayBuffer ? new Uint8Array(data) : data;
+
+    if (isMessagePack(bytes)) {
+      return decodeMessagePack(bytes) as WebSocketMessage;
+    }
+    return JSON.parse(Buffer.from(bytes.buffer, bytes.byteOffset, bytes.byteLength).toString('utf8')) as WebSocketMessage;
+  }
+
+  private negotiateEncoding(data: { encodings?: string[] } | undefined): void {
+    if (this.config.encoding !== 'msgpack' || !data?.encodings?.includes('msgpack')) {
+      return;
+    }
+
+    // Frames keep arriving as JSON until the server acknowledges
+    this.send({ type: 'configure', payload: { encoding: 'msgpack' } });
+  }
+
+  private dispatch(type: string, event: WebSocketEvent): void {
+    const handlers = this.eventSubscriptions.get(type);
+    if (!handlers) {
+      return;
+    }
+
+    for (const handler of handlers) {
+      try {
+        handler(event);
+      } catch (error) {
+        this.logger.error('Event handler error', error as Error, { type });
+      }
+    }
+  }
+
+  /**
+   * Fan a batch out to per-actor subscribers.
+   */
+  private dispatchEntityBatch(batch: EntityChangeBatch | undefined, timestamp: Date): void {
+    for (const actor of batch?.spawned ?? []) {
+      this.dispatch('actor_spawned', { type: 'actor_spawned', data: actor, timestamp });
+      this.dispatch('world.entity.spawned', { type: 'world.entity.spawned', data: actor, timestamp });
+    }
+    for (const actor of batch?.destroyed ?? []) {
+      this.dispatch('actor_deleted', { type: 'actor_deleted', data: actor, timestamp });
+      this.dispatch('world.entity.destroyed', { type: 'world.entity.destroyed', data: actor, timestamp });
+    }
+  }
+
   private handleClose(code: number, reason: string): void {
     this.logger.info('WebSocket closed', { code, reason });
     this.connected = false;
+    this.wireEncoding = 'json';
 
     // Stop ping
     this.stopPing();
@@ -547,13 +674,37 @@ export class UnrealWebSocketClient extends EventEmitter {
   }
 
   private resubscribeEvents(): void {
-    // Re-send subscription messages for all subscribed event types
+    // Re-send subscription messages for all subscribed topics
+    const topics = new Set<string>();
     for (const eventType of this.eventSubscriptions.keys()) {
-      this.send({
-        type: 'subscribe',
-        payload: { eventType },
-      });
+      topics.add(this.topicOf(eventType));
+    }
+    for (const topic of topics) {
+      this.send({ type: 'subscribe', payload: { topic } });
+    }
+  }
+
+  private topicOf(eventType: string): string {
+    return EVENT_TOPICS[eventType] ?? eventType;
+  }
+
+  /** Subscribed event types sharing the topic of eventType */
+  private countTopicUsers(eventType: string): number {
+    const topic = this.topicOf(eventType);
+    let count = 0;
+    for (const subscribed of this.eventSubscriptions.keys()) {
+      if (this.topicOf(subscribed) === topic) {
+        count++;
+      }
     }
+    return count;
+  }
+
+  private sendSubscription(type: 'subscribe' | 'unsubscribe', eventType: string): void {
+    this.send({
+      type,
+      payload: { eventType, topic: this.topicOf(eventType) },
+    });
   }
 
   private generateRequestId(): string {
@@ -0,0 +1,351 @@
+/**
+ * AEGIS Wire Codec
+ * MessagePack encoding for the bridge WebSocket, matching FAegisMessagePack in the plugin.
+ * Only the JSON data model is supported: nil, booleans, numbers, strings, arrays and maps.
+ */
+
+const textEncoder = new TextEncoder();
+const textDecoder = new TextDecoder();
+
+export type WireEncoding = 'json' | 'msgpack';
+
+/**
+ * Whether a frame starts with a MessagePack map header rather than JSON text
+ */
+export function isMessagePack(data: Uint8Array): boolean {
+  if (data.length === 0) {
+    return false;
+  }
+  const code = data[0];
+  return (code & 0xf0) === 0x80 || code === 0xde || code === 0xdf;
+}
+
+// ============================================================================
+// Encoder
+// ============================================================================
+
+class PackWriter {
+  private buffer = new Uint8Array(256);
+  private view = new DataView(this.buffer.buffer);
+  private length = 0;
+
+  bytes(): Uint8Array {
+    return this.buffer.subarray(0, this.length);
+  }
+
+  private reserve(size: number): void {
+    if (this.length + size <= this.buffer.length) {
+      return;
+    }
+    let capacity = this.buffer.length * 2;
+    while (capacity < this.length + size) {
+      capacity *= 2;
+    }
+    const next = new Uint8Array(capacity);
+    next.set(this.buffer.subarray(0, this.length));
+    this.buffer = next;
+    this.view = new DataView(next.buffer);
+  }
+
+  u8(value: number): void {
+    this.reserve(1);
+    this.view.setUint8(this.length, value);
+    this.length += 1;
+  }
+
+  u16(code: number, value: number): void {
+    this.reserve(3);
+    this.view.setUint8(this.length, code);
+    this.view.setUint16(this.length + 1, value);
+    this.length += 3;
+  }
+
+  u32(code: number, value: number): void {
+    this.reserve(5);
+    this.view.setUint8(this.length, code);
+    this.view.setUint32(this.length + 1, value);
+    this.length += 5;
+  }
+
+  u64(code: number, value: bigint): void {
+    this.reserve(9);
+    this.view.setUint8(this.length, code);
+    this.view.setBigUint64(this.length + 1, BigInt.asUintN(64, value));
+    this.length += 9;
+  }
+
+  f32(value: number): void {
+    this.reserve(5);
+    this.view.setUint8(this.length, 0xca);
+    this.view.setFloat32(this.length + 1, value);
+    this.length += 5;
+  }
+
+  f64(value: number): void {
+    this.reserve(9);
+    this.view.setUint8(this.length, 0xcb);
+    this.view.setFloat64(this.length + 1, value);
+    this.length += 9;
+  }
+
+  raw(bytes: Uint8Array): void {
+    this.reserve(bytes.length);
+    this.buffer.set(bytes, this.length);
+    this.length += bytes.length;
+  }
+}
+
+function writeHeader(writer: PackWriter, count: number, fixBase: number, code16: number, code32: number): void {
+  if (count < 16) {
+    writer.u8(fixBase | count);
+  } else if (count <= 0xffff) {
+    writer.u16(code16, count);
+  } else {
+    writer.u32(code32, count);
+  }
+}
+
+function writeString(writer: PackWriter, value: string): void {
+  const bytes = textEncoder.encode(value);
+  if (bytes.length < 32) {
+    writer.u8(0xa0 | bytes.length);
+  } else if (bytes.length <= 0xff) {
+    writer.u8(0xd9);
+    writer.u8(bytes.length);
+  } else if (bytes.length <= 0xffff) {
+    writer.u16(0xda, bytes.length);
+  } else {
+    writer.u32(0xdb, bytes.length);
+  }
+  writer.raw(bytes);
+}
+
+function writeNumber(writer: PackWriter, value: number): void {
+  if (Number.isSafeInteger(value)) {
+    if (value >= 0) {
+      if (value < 0x80) writer.u8(value);
+      else if (value <= 0xff) { writer.u8(0xcc); writer.u8(value); }
+      else if (value <= 0xffff) writer.u16(0xcd, value);
+      else if (value <= 0xffffffff) writer.u32(0xce, value);
+      else writer.u64(0xcf, BigInt(value));
+    } else {
+      if (value >= -32) writer.u8(value & 0xff);
+      else if (value >= -0x80) { writer.u8(0xd0); writer.u8(value & 0xff); }
+      else if (value >= -0x8000) writer.u16(0xd1, value & 0xffff);
+      else if (value >= -0x80000000) writer.u32(0xd2, value >>> 0);
+      else writer.u64(0xd3, BigInt(value));
+    }
+    return;
+  }
+
+  // NaN and infinities have no JSON form; JSON.stringify would send null
+  if (!Number.isFinite(value)) {
+    writer.u8(0xc0);
+    return;
+  }
+
+  if (Math.fround(value) === value) {
+    writer.f32(value);
+  } else {
+    writer.f64(value);
+  }
+}
+
+function writeValue(writer: PackWriter, value: unknown): void {
+  if (value === null || value === undefined) {
+    writer.u8(0xc0);
+  } else if (typeof value === 'boolean') {
+    writer.u8(value ? 0xc3 : 0xc2);
+  } else if (typeof value === 'number') {
+    writeNumber(writer, value);
+  } else if (typeof value === 'string') {
+    writeString(writer, value);
+  } else if (Array.isArray(value)) {
+    writeHeader(writer, value.length, 0x90, 0xdc, 0xdd);
+    for (const item of value) {
+      writeValue(writer, item === undefined ? null : item);
+    }
+  } else if (value instanceof Date) {
+    writeString(writer, value.toISOString());
+  } else if (typeof value === 'object') {
+    // Same key selection as JSON.stringify: undefined members are skipped
+    const entries = Object.entries(value as Record<string, unknown>).filter(([, v]) => v !== undefined);
+    writeHeader(writer, entries.length, 0x80, 0xde, 0xdf);
+    for (const [key, item] of entries) {
+      writeString(writer, key);
+      writeValue(writer, item);
+    }
+  } else {
+    throw new TypeError(`Cannot encode ${typeof value} as MessagePack`);
+  }
+}
+
+/**
+ * Encode a JSON-compatible value
+ */
+export function encodeMessagePack(value: unknown): Uint8Array {
+  const writer = new PackWriter();
+  writeValue(writer, value);
+  return writer.bytes();
+}
+
+// ============================================================================
+// Decoder
+// ============================================================================
+
+class PackReader {
+  private offset = 0;
+  private readonly view: DataView;
+
+  constructor(private readonly data: Uint8Array) {
+    this.view = new DataView(data.buffer, data.byteOffset, data.byteLength);
+  }
+
+  done(): boolean {
+    return this.offset === this.data.length;
+  }
+
+  private need(size: number): void {
+    if (this.offset + size > this.data.length) {
+      throw new RangeError('Truncated MessagePack frame');
+    }
+  }
+
+  u8(): number {
+    this.need(1);
+    return this.view.getUint8(this.offset++);
+  }
+
+  u16(): number {
+    this.need(2);
+    const value = this.view.getUint16(this.offset);
+    this.offset += 2;
+    return value;
+  }
+
+  u32(): number {
+    this.need(4);
+    const value = this.view.getUint32(this.offset);
+    this.offset += 4;
+    return value;
+  }
+
+  i8(): number {
+    this.need(1);
+    return this.view.getInt8(this.offset++);
+  }
+
+  i16(): number {
+    this.need(2);
+    const value = this.view.getInt16(this.offset);
+    this.offset += 2;
+    return value;
+  }
+
+  i32(): number {
+    this.need(4);
+    const value = this.view.getInt32(this.offset);
+    this.offset += 4;
+    return value;
+  }
+
+  u64(): number {
+    this.need(8);
+    const value = this.view.getBigUint64(this.offset);
+    this.offset += 8;
+    return Number(value);
+  }
+
+  i64(): number {
+    this.need(8);
+    const value = this.view.getBigInt64(this.offset);
+    this.offset += 8;
+    return Number(value);
+  }
+
+  f32(): number {
+    this.need(4);
+    const value = this.view.getFloat32(this.offset);
+    this.offset += 4;
+    return value;
+  }
+
+  f64(): number {
+    this.need(8);
+    const value = this.view.getFloat64(this.offset);
+    this.offset += 8;
+    return value;
+  }
+
+  str(length: number): string {
+    this.need(length);
+    const value = textDecoder.decode(this.data.subarray(this.offset, this.offset + length));
+    this.offset += length;
+    return value;
+  }
+}
+
+function readArray(reader: PackReader, count: number): unknown[] {
+  const result = new Array<unknown>(count);
+  for (let i = 0; i < count; i++) {
+    result[i] = readValue(reader);
+  }
+  return result;
+}
+
+function readMap(reader: PackReader, count: number): Record<string, unknown> {
+  const result: Record<string, unknown> = {};
+  for (let i = 0; i < count; i++) {
+    const key = String(readValue(reader));
+    // Assignment would treat a "__proto__" key as the prototype setter
+    Object.defineProperty(result, key, { value: readValue(reader), enumerable: true, writable: true, configurable: true });
+  }
+  return result;
+}
+
+function readValue(reader: PackReader): unknown {
+  const code = reader.u8();
+
+  if (code < 0x80) return code;
+  if (code >= 0xe0) return code - 0x100;
+  if ((code & 0xf0) === 0x80) return readMap(reader, code & 0x0f);
+  if ((code & 0xf0) === 0x90) return readArray(reader, code & 0x0f);
+  if ((code & 0xe0) === 0xa0) return reader.str(code & 0x1f);
+
+  switch (code) {
+    case 0xc0: return null;
+    case 0xc2: return false;
+    case 0xc3: return true;
+    case 0xca: return reader.f32();
+    case 0xcb: return reader.f64();
+    case 0xcc: return reader.u8();
+    case 0xcd: return reader.u16();
+    case 0xce: return reader.u32();
+    case 0xcf: return reader.u64();
+    case 0xd0: return reader.i8();
+    case 0xd1: return reader.i16();
+    case 0xd2: return reader.i32();
+    case 0xd3: return reader.i64();
+    case 0xd9: return reader.str(reader.u8());
+    case 0xda: return reader.str(reader.u16());
+    case 0xdb: return reader.str(reader.u32());
+    case 0xdc: return readArray(reader, reader.u16());
+    case 0xdd: return readArray(reader, reader.u32());
+    case 0xde: return readMap(reader, reader.u16());
+    case 0xdf: return readMap(reader, reader.u32());
+    default:
+      throw new TypeError(`Unsupported MessagePack type 0x${code.toString(16)}`);
+  }
+}
+
+/**
+ * Decode a MessagePack document
+ */
+export function decodeMessagePack(data: Uint8Array): unknown {
+  const reader = new PackReader(data);
+  const value = readValue(reader);
+  if (!reader.done()) {
+    throw new RangeError('Trailing bytes after MessagePack document');
+  }
+  return value;
+}
@@ -50,6 +50,11 @@ const QueryActorsParamsSchema = z.object({
     min: Vector3DSchema,
     max: Vector3DSchema,
   }).optional().describe('Filter by bounding box'),
+  near: z.object({
+    origin: Vector3DSchema,
+    radius: z.number().positive().optional().describe('Only actors within this distance'),
+  }).optional().describe('Order results nearest first from a point'),
+  offset: z.number().int().nonnegative().optional().default(0).describe('Matches to skip'),
   limit: z.number().int().positive().optional().default(100).describe('Maximum results'),
   includeTransform: z.boolean().optional().default(true).describe('Include transform in results'),
 });
@@ -375,68 +380,42 @@ export function createActorCommands(bridge: BridgeManager): CommandDefinition[]
       },
       handler: async (context: CommandContext): Promise<QueryActorsResult> => {
         const params = context.params as z.infer<typeof QueryActorsParamsSchema>;
-        let actorPaths: string[] = [];
-
-        // Query by class or tag
-        if (params.className) {
-          const result = await bridge.remoteControl.findActorsByClass(params.className);
-          if (result.success && result.data) {
-            actorPaths = result.data;
-          }
-        } else if (params.tag) {
-          const result = await bridge.remoteControl.findActorsByTag(params.tag);
-          if (result.success && result.data) {
-            actorPaths = result.data;
-          }
-        } else {
-          // Get all actors from level state
-          const levelState = await bridge.stateSync.getLevelState();
-          actorPaths = levelState?.actors || [];
-        }
-
-        // Fetch actor details
-        const actors: QueryActorsResult['actors'] = [];
         const limit = params.limit || 100;
 
-        for (const path of actorPaths.slice(0, limit)) {
-          const actorData = await bridge.stateSync.getActor(path);
-          if (!actorData) continue;
-
-          const info = actorData.info;
-
-          // Apply name pattern filter
-          if (params.namePattern) {
-            const regex = new RegExp(params.namePattern, 'i');
-            if (!regex.test(info.name) && !regex.test(info.label || '')) {
-              continue;
-            }
-          }
+        // The name pattern is a regex, so it is applied here and paging has to follow it
+        const result = await bridge.remoteControl.queryActors({
+          classFilters: params.className ? [params.className] : undefined,
+          tags: params.tag ? [params.tag] : undefined,
+          bounds: params.inBox,
+          near: params.near,
+          offset: params.namePattern ? 0 : params.offset,
+          limit: params.namePattern ? 0 : limit,
+        });
 
-          // Apply bounding box filter
-          if (params.inBox && info.transform) {
-            const loc = info.transform.location;
-            if (
-              loc.x < params.inBox.min.x || loc.x > params.inBox.max.x ||
-              loc.y < params.inBox.min.y || loc.y > params.inBox.max.y ||
-              loc.z < params.inBox.min.z || loc.z > params.inBox.max.z
-            ) {
-              continue;
-            }
-          }
+        if (!result.success || !result.data) {
+          throw new ExecutionError('query_actors', result.error || 'Failed to query actors', false);
+        }
 
-          actors.push({
-            path: info.path,
-            name: info.name,
-            class: info.class,
-            label: info.label,
-            tags: info.tags,
-            transform: params.includeTransform ? info.transform : undefined,
-          });
+        let matched = result.data.actors;
+        let totalCount = result.data.total;
+        if (params.namePattern) {
+          const regex = new RegExp(params.namePattern, 'i');
+          matched = matched.filter((actor) => regex.test(actor.name));
+          totalCount = matched.length;
+          matched = matched.slice(params.offset, params.offset + limit);
         }
 
+        const actors: QueryActorsResult['actors'] = matched.map((actor) => ({
+          path: actor.path,
+          name: actor.name,
+          class: actor.class,
+          tags: actor.tags,
+          transform: params.includeTransform ? actor.transform : undefined,
+        }));
+
         return {
           actors,
-          totalCount: actors.length,
+          totalCount,
         };
       },
     },
@@ -14,9 +14,11 @@ import { AssetImportError, ExecutionError } from '../../utils/errors.js';
 
 const SearchAssetsParamsSchema = z.object({
   searchPath: z.string().optional().describe('Path to search in (e.g., /Game/Meshes)'),
-  searchQuery: z.string().optional().describe('Search query string'),
+  searchQuery: z.string().optional().describe('Text in the asset name (case-insensitive)'),
+  prefix: z.boolean().optional().default(false).describe('Match the query at the start of the name only'),
   assetTypes: z.array(z.string()).optional().describe('Filter by asset types (e.g., StaticMesh, Material)'),
-  limit: z.number().int().positive().optional().default(50).describe('Maximum results'),
+  limit: z.number().int().positive().max(5000).optional().default(50).describe('Maximum results per page'),
+  cursor: z.string().optional().describe('nextCursor from a previous page'),
   recursive: z.boolean().optional().default(true).describe('Search subdirectories'),
 });
 
@@ -83,6 +85,8 @@ interface SearchAssetsResult {
     diskSize?: number;
   }>;
   totalCount: number;
+  /** Pass back as cursor for the next page; absent on the last page */
+  nextCursor?: string;
 }
 
 interface LoadAssetResult {
@@ -145,29 +149,26 @@ export function createAssetCommands(bridge: BridgeManager): CommandDefinition[]
 
         const searchPath = params.searchPath || '/Game';
 
-        const result = await bridge.remoteControl.searchAssets(searchPath, {
+        // Name matching, class filtering and paging all run against the editor's asset index
+        const result = await bridge.remoteControl.searchAssetIndex({
+          text: params.searchQuery,
+          prefix: params.prefix,
           classNames: params.assetTypes,
+          path: searchPath,
+          cursor: params.cursor,
           limit: params.limit,
         });
 
-        if (!result.success) {
-          throw new ExecutionError(
-            'search_assets',
-            result.error || 'Failed to search assets',
-            { searchPath }
-          );
+        if (!result.success || !result.data) {
+          throw new ExecutionError('search_assets', result.error || 'Failed to search assets', false);
         }
 
-        let assets = result.data || [];
+        let assets = result.data.assets;
 
-        // Apply search query filter
-        if (params.searchQuery) {
-          const query = params.searchQuery.toLowerCase();
-          assets = assets.filter(
-            (a) =>
-              a.name.toLowerCase().includes(query) ||
-              a.path.toLowerCase().includes(query)
-          );
+        // The index searches recursively; keep direct children only when asked to
+        if (!params.recursive) {
+          const prefix = searchPath.endsWith('/') ? searchPath : `${searchPath}/`;
+          assets = assets.filter((a) => !a.package.slice(prefix.length).includes('/'));
         }
 
         return {
@@ -178,6 +179,7 @@ export function createAssetCommands(bridge: BridgeManager): CommandDefinition[]
             package: a.package,
           })),
           totalCount: assets.length,
+          nextCursor: result.data.nextCursor || undefined,
         };
       },
     },
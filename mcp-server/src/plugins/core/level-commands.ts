@@ -5,7 +5,7 @@
 
 import { z } from 'zod';
 import { CommandDefinition, CommandContext } from '../../registry/plugin-types.js';
-import { BridgeManager } from '../../bridge/index.js';
+import { BridgeManager, BridgeStats } from '../../bridge/index.js';
 import { ExecutionError } from '../../utils/errors.js';
 import { Vector3DSchema } from '../../schema/commands.js';
 
@@ -776,5 +776,36 @@ export function createLevelCommands(bridge: BridgeManager): CommandDefinition[]
         return { redone: result.success };
       },
     },
+
+    // ========================================================================
+    // get_bridge_stats
+    // ========================================================================
+    {
+      name: 'get_bridge_stats',
+      description:
+        'Get per-command latency percentiles, payload sizes and WebSocket queue depths measured in the editor',
+      inputSchema: z.object({
+        reset: z.boolean().optional().default(false).describe('Clear the figures after reading them'),
+        limit: z.number().int().min(1).optional().default(20).describe('Busiest metrics to return'),
+      }),
+      annotations: {
+        riskLevel: 'low',
+        category: 'level',
+        tags: ['stats', 'profiling', 'latency', 'editor'],
+        estimatedDuration: 'fast',
+        requiresPreview: false,
+        supportsUndo: false,
+      },
+      handler: async (context: CommandContext): Promise<BridgeStats> => {
+        const params = context.params as { reset: boolean; limit: number };
+
+        const result = await bridge.remoteControl.getBridgeStats(params.reset);
+        if (!result.success || !result.data) {
+          throw new ExecutionError('get_bridge_stats', result.error || 'Failed to get bridge stats', false);
+        }
+
+        return { ...result.data, metrics: result.data.metrics.slice(0, params.limit) };
+      },
+    },
   ];
 }
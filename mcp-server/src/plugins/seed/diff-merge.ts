@@ -894,6 +894,7 @@ export function createDiffMergeCommands(bridge: BridgeManager): CommandDefinitio
           captureCurrentFirst: z.boolean().optional().default(true),
           conflictResolution: z.enum(['source', 'target', 'manual', 'newest']).optional().default('target'),
           dryRun: z.boolean().optional().default(false),
+          baseSnapshotId: z.string().optional().describe('Snapshot the world was last synced from; enables three-way conflict detection'),
         }).optional(),
       }),
       handler: async ({ params, logger }) => {
@@ -904,6 +905,7 @@ export function createDiffMergeCommands(bridge: BridgeManager): CommandDefinitio
               captureCurrentFirst: z.boolean().optional().default(true),
               conflictResolution: z.enum(['source', 'target', 'manual', 'newest']).optional().default('target'),
               dryRun: z.boolean().optional().default(false),
+              baseSnapshotId: z.string().optional(),
             }).optional(),
           })
           .parse(params);
@@ -932,6 +934,7 @@ export function createDiffMergeCommands(bridge: BridgeManager): CommandDefinitio
             CaptureCurrentFirst: options.captureCurrentFirst,
             ConflictResolution: options.conflictResolution,
             DryRun: options.dryRun,
+            BaseSnapshotId: options.baseSnapshotId,
           }
         );
 
@@ -949,6 +952,7 @@ export function createDiffMergeCommands(bridge: BridgeManager): CommandDefinitio
             dryRun: true,
             targetSnapshot: validatedParams.targetSnapshotId,
             plannedChanges: syncResult.data?.plannedChanges,
+            conflicts: syncResult.data?.conflicts || [],
           };
         }
 
@@ -958,6 +962,7 @@ export function createDiffMergeCommands(bridge: BridgeManager): CommandDefinitio
           targetSnapshot: validatedParams.targetSnapshotId,
           appliedChanges: syncResult.data?.appliedChanges,
           currentSnapshotId: syncResult.data?.currentSnapshotId,
+          conflicts: syncResult.data?.conflicts || [],
           warnings: syncResult.data?.warnings,
         };
       },
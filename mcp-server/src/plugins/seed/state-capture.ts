@@ -37,6 +37,13 @@ const CaptureOptionsSchema = z.object({
   filterByTag: z.array(z.string()).optional(),
   maxDepth: z.number().min(1).max(10).optional().default(5),
   compressData: z.boolean().optional().default(false),
+  pageSize: z
+    .number()
+    .min(1)
+    .max(10000)
+    .optional()
+    .default(1000)
+    .describe('Actors fetched per CaptureActorsPage call'),
 });
 
 const CaptureWorldStateParamsSchema = z.object({
@@ -56,6 +63,11 @@ const RestoreWorldStateParamsSchema = z.object({
         .describe('How to handle existing entities'),
       preserveGUIDs: z.boolean().optional().default(true),
       dryRun: z.boolean().optional().default(false),
+      background: z
+        .boolean()
+        .optional()
+        .default(false)
+        .describe('Restore as a job spread over editor frames; returns a jobId and reports job.progress events'),
     })
     .optional(),
 });
@@ -175,14 +187,24 @@ async function captureActors(
       queryParams.TagFilter = options.filterByTag;
     }
 
-    const result = await bridge.remoteControl.callFunction(
-      '/Script/AegisBridge.AegisSeedSubsystem',
-      'CaptureAllActors',
-      queryParams
-    );
+    // Pull the capture page by page; the editor keeps the actor set stable behind the cursor
+    let cursor = '';
+    do {
+      const result = await bridge.remoteControl.callFunction(
+        '/Script/AegisBridge.AegisSeedSubsystem',
+        'CaptureActorsPage',
+        { ...queryParams, Cursor: cursor, PageSize: options.pageSize }
+      );
+
+      if (!result.success || !result.data) {
+        break;
+      }
+
+      if (result.data.error) {
+        throw new Error(result.data.error);
+      }
 
-    if (result.success && result.data?.actors) {
-      for (const actor of result.data.actors) {
+      for (const actor of result.data.actors || []) {
         const entityGuid =
           guidRegistry.get(actor.guid)?.guid ||
           generateDeterministicGUID('actor', actor.class, '', entities.length, actor.name);
@@ -245,7 +267,9 @@ async function captureActors(
 
         entities.push(entitySnapshot);
       }
-    }
+
+      cursor = result.data.nextCursor || '';
+    } while (cursor);
   } catch (error) {
     // Return empty array on failure, let caller handle
     console.error('Failed to capture actors:', error);
@@ -267,7 +291,7 @@ async function captureLandscape(
     const result = await bridge.remoteControl.callFunction(
       '/Script/AegisBridge.AegisSeedSubsystem',
       'CaptureLandscape',
-      { IncludeHeightmap: true, IncludeLayers: true }
+      { bIncludeHeightmap: true, bIncludeLayers: true }
     );
 
     if (result.success && result.data?.landscapes) {
@@ -292,6 +316,8 @@ async function captureLandscape(
             sizeY: landscape.sizeY,
             heightmapHash: landscape.heightmapHash,
             layerInfo: landscape.layers,
+            componentSizeQuads: landscape.componentSizeQuads,
+            tiles: landscape.tiles,
           },
           components: [],
           references: [],
@@ -318,7 +344,7 @@ async function captureFoliage(
     const result = await bridge.remoteControl.callFunction(
       '/Script/AegisBridge.AegisSeedSubsystem',
       'CaptureFoliage',
-      { IncludeInstances: true }
+      { bIncludeInstances: true }
     );
 
     if (result.success && result.data?.foliageActors) {
@@ -340,7 +366,8 @@ async function captureFoliage(
           properties: {
             foliageTypes: foliage.types,
             instanceCount: foliage.instanceCount,
-            instanceDataHash: foliage.instanceDataHash,
+            // Instances are hashed per type across the world, not per partition actor
+            instanceDataHash: result.data.instanceDataHash,
           },
           components: [],
           references: [],
@@ -543,6 +570,31 @@ export function createStateCaptureCommands(bridge: BridgeManager): CommandDefini
           mergeMode: options.mergeMode,
         });
 
+        if (options.background) {
+          const job = await bridge.remoteControl.startJob('RestoreWorldState', {
+            SnapshotId: validatedParams.snapshotId,
+            Entities: JSON.stringify(snapshot.entities),
+            MergeMode: options.mergeMode,
+            bPreserveGUIDs: options.preserveGUIDs,
+          });
+
+          if (!job.success || !job.data) {
+            return {
+              success: false,
+              error: 'Failed to start world state restore in Unreal Engine',
+              details: job.error,
+            };
+          }
+
+          return {
+            success: true,
+            snapshotId: validatedParams.snapshotId,
+            jobId: job.data.jobId,
+            entityCount: snapshot.entities.length,
+            mergeMode: options.mergeMode,
+          };
+        }
+
         // Perform restoration in UE
         const restorationResult = await bridge.remoteControl.callFunction(
           '/Script/AegisBridge.AegisSeedSubsystem',
@@ -791,6 +843,19 @@ export function createStateCaptureCommands(bridge: BridgeManager): CommandDefini
         outputPath: z.string().describe('Path to save the snapshot file'),
         format: z.enum(['json', 'binary']).optional().default('json'),
         compress: z.boolean().optional().default(true),
+        codec: z
+          .enum(['kraken', 'mermaid', 'selkie', 'leviathan'])
+          .optional()
+          .default('kraken')
+          .describe('Oodle codec used when compress is set'),
+        compressionLevel: z
+          .number()
+          .int()
+          .min(-4)
+          .max(8)
+          .optional()
+          .default(4)
+          .describe('Oodle compression level, -4 (HyperFast4) to 8 (Optimal4)'),
       }),
       handler: async ({ params, logger }) => {
         const validatedParams = z
@@ -799,6 +864,11 @@ export function createStateCaptureCommands(bridge: BridgeManager): CommandDefini
             outputPath: z.string(),
             format: z.enum(['json', 'binary']).optional().default('json'),
             compress: z.boolean().optional().default(true),
+            codec: z
+              .enum(['kraken', 'mermaid', 'selkie', 'leviathan'])
+              .optional()
+              .default('kraken'),
+            compressionLevel: z.number().int().min(-4).max(8).optional().default(4),
           })
           .parse(params);
 
@@ -821,6 +891,8 @@ export function createStateCaptureCommands(bridge: BridgeManager): CommandDefini
             OutputPath: validatedParams.outputPath,
             Format: validatedParams.format,
             Compress: validatedParams.compress,
+            Codec: validatedParams.compress ? validatedParams.codec : 'none',
+            CompressionLevel: validatedParams.compressionLevel,
           }
         );
 
@@ -904,6 +976,58 @@ export function createStateCaptureCommands(bridge: BridgeManager): CommandDefini
         };
       },
     },
+
+    // ========================================================================
+    // get_world_hash - Merkle hash of the world for determinism checks
+    // ========================================================================
+    {
+      name: 'get_world_hash',
+      description: 'Compute a Merkle hash of the current world (or a stored snapshot) and locate drift against known node hashes',
+      category: 'seed',
+      parameters: z.object({
+        snapshotId: z.string().optional().describe('Hash a snapshot stored in the editor instead of the live world'),
+        depth: z.number().int().min(0).max(3).optional().default(1).describe('Tree depth to return: 0 root, 1 levels, 2 cells, 3 entities'),
+        knownHashes: z.record(z.string()).optional().describe('Node hashes from a previous reply, by node id ("root" for the root)'),
+        properties: z.array(z.string()).optional().describe('Actor properties to include in entity hashes'),
+        cellSize: z.number().positive().optional().describe('Spatial cell size in world units'),
+      }),
+      handler: async ({ params }) => {
+        const validatedParams = z
+          .object({
+            snapshotId: z.string().optional(),
+            depth: z.number().int().min(0).max(3).optional().default(1),
+            knownHashes: z.record(z.string()).optional(),
+            properties: z.array(z.string()).optional(),
+            cellSize: z.number().positive().optional(),
+          })
+          .parse(params);
+
+        const result = await bridge.remoteControl.callFunction(
+          '/Script/AegisBridge.AegisSeedSubsystem',
+          'ComputeWorldHash',
+          {
+            SnapshotId: validatedParams.snapshotId,
+            Depth: validatedParams.depth,
+            KnownHashes: validatedParams.knownHashes,
+            Properties: validatedParams.properties,
+            CellSize: validatedParams.cellSize,
+          }
+        );
+
+        if (!result.success) {
+          return {
+            success: false,
+            error: 'Failed to compute world hash',
+            details: result.error,
+          };
+        }
+
+        return {
+          success: true,
+          ...result.data,
+        };
+      },
+    },
   ];
 }
 
@@ -0,0 +1,68 @@
+/**
+ * AEGIS MCP Server - Wire Codec Tests
+ */
+
+import { describe, it, expect } from 'vitest';
+import { decodeMessagePack, encodeMessagePack, isMessagePack } from '../../../src/bridge/wire-codec.js';
+
+describe('wire codec', () => {
+  it('should round-trip bridge messages', () => {
+    const message = {
+      type: 'event',
+      event: 'world.entity.changed',
+      timestamp: 1700000000,
+      data: {
+        spawned: [{ actorName: 'Cube_1', actorClass: 'StaticMeshActor', actorPath: '/Game/Map.Map:PersistentLevel.Cube_1' }],
+        destroyed: [],
+        cancelled: 3,
+        location: { x: 1.5, y: -0.1, z: 100000 },
+        flags: [true, false, null],
+        note: 'é'.repeat(300),
+      },
+    };
+
+    const packed = encodeMessagePack(message);
+
+    expect(isMessagePack(packed)).toBe(true);
+    expect(decodeMessagePack(packed)).toEqual(message);
+  });
+
+  it('should use the smallest integer encodings', () => {
+    expect(Array.from(encodeMessagePack(5))).toEqual([0x05]);
+    expect(Array.from(encodeMessagePack(-3))).toEqual([0xfd]);
+    expect(Array.from(encodeMessagePack(200))).toEqual([0xcc, 200]);
+    expect(Array.from(encodeMessagePack(-200))).toEqual([0xd1, 0xff, 0x38]);
+    expect(decodeMessagePack(encodeMessagePack(2 ** 40))).toBe(2 ** 40);
+    expect(decodeMessagePack(encodeMessagePack(-(2 ** 40)))).toBe(-(2 ** 40));
+  });
+
+  it('should narrow exact floats to float32', () => {
+    expect(encodeMessagePack(0.5)[0]).toBe(0xca);
+    expect(encodeMessagePack(0.1)[0]).toBe(0xcb);
+    expect(decodeMessagePack(encodeMessagePack(0.1))).toBe(0.1);
+  });
+
+  it('should skip undefined members like JSON', () => {
+    expect(decodeMessagePack(encodeMessagePack({ a: 1, b: undefined }))).toEqual({ a: 1 });
+  });
+
+  it('should decode a __proto__ key as a plain member', () => {
+    const packed = encodeMessagePack(JSON.parse('{"type":"event","__proto__":{"polluted":true}}'));
+    const decoded = decodeMessagePack(packed) as Record<string, unknown>;
+
+    expect(Object.getPrototypeOf(decoded)).toBe(Object.prototype);
+    expect(Object.keys(decoded)).toEqual(['type', '__proto__']);
+    expect(decoded.polluted).toBeUndefined();
+    expect(({} as Record<string, unknown>).polluted).toBeUndefined();
+  });
+
+  it('should tell JSON frames from MessagePack frames', () => {
+    expect(isMessagePack(new TextEncoder().encode('{"type":"pong"}'))).toBe(false);
+    expect(isMessagePack(encodeMessagePack({ type: 'pong' }))).toBe(true);
+  });
+
+  it('should reject truncated frames', () => {
+    const packed = encodeMessagePack({ type: 'event', data: 'payload' });
+    expect(() => decodeMessagePack(packed.subarray(0, packed.length - 2))).toThrow();
+  });
+});
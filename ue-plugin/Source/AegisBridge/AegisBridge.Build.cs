@@ -34,6 +34,7 @@ public class AegisBridge : ModuleRules
                 "JsonUtilities",
                 "HTTP",
                 "WebSockets",
+                "WebSocketNetworking",
                 "RemoteControl",
                 "RemoteControlCommon",
                 "AegisBridgeRuntime",
@@ -0,0 +1,264 @@
+// Copyright AEGIS Team. All Rights Reserved.
+
+#include "AegisActorCapture.h"
+#include "AegisActorQuery.h"
+#include "AegisGUIDRegistry.h"
+#include "AegisJsonWriter.h"
+#include "Async/ParallelFor.h"
+#include "Components/ActorComponent.h"
+#include "Engine/World.h"
+#include "EngineUtils.h"
+#include "GameFramework/Actor.h"
+#include "UObject/Package.h"
+
+namespace
+{
+    EParallelForFlags GetParallelFlags(int32 TaskCount)
+    {
+        return TaskCount > 1 ? EParallelForFlags::None : EParallelForFlags::ForceSingleThread;
+    }
+}
+
+void FAegisActorCapture::Gather(UWorld* World)
+{
+    if (!World)
+    {
+        return;
+    }
+
+    Reserve(World->GetActorCount());
+    for (TActorIterator<AActor> It(World); It; ++It)
+    {
+        GatherActor(*It);
+    }
+}
+
+void FAegisActorCapture::Gather(TConstArrayView<AActor*> Actors)
+{
+    Reserve(Actors.Num());
+    for (AActor* Actor : Actors)
+    {
+        if (IsValid(Actor))
+        {
+            GatherActor(Actor);
+        }
+    }
+}
+
+void FAegisActorCapture::Reserve(int32 Count)
+{
+    Locations.Reserve(Locations.Num() + Count);
+    Rotations.Reserve(Rotations.Num() + Count);
+    Scales.Reserve(Scales.Num() + Count);
+    Names.Reserve(Names.Num() + Count);
+    ClassIds.Reserve(ClassIds.Num() + Count);
+    OuterIds.Reserve(OuterIds.Num() + Count);
+    TagStarts.Reserve(TagStarts.Num() + Count);
+    ComponentStarts.Reserve(ComponentStarts.Num() + Count);
+}
+
+void FAegisActorCapture::GatherActor(AActor* Actor)
+{
+    Locations.Add(Actor->GetActorLocation());
+    Rotations.Add(Actor->GetActorRotation());
+    Scales.Add(Actor->GetActorScale3D());
+    Names.Add(Actor->GetFName());
+    ClassIds.Add(InternClass(Actor->GetClass()));
+
+    // Actors share a handful of outers (the persistent level, streamed levels), so the
+    // expensive part of GetPathName is done once per outer
+    UObject* Outer = Actor->GetOuter();
+    int32* OuterId = OuterLookup.Find(Outer);
+    if (!OuterId)
+    {
+        FString Prefix;
+        if (Outer)
+        {
+            Prefix = Outer->GetPathName();
+
+            // Same delimiter rule as UObjectBaseUtility::GetPathName for subobjects of a package's top-level object
+            UObject* OuterOuter = Outer->GetOuter();
+            const bool bSubObject = OuterOuter && OuterOuter->IsA<UPackage>() && !Outer->IsA<UPackage>();
+            Prefix.AppendChar(bSubObject ? SUBOBJECT_DELIMITER_CHAR : TCHAR('.'));
+        }
+        OuterId = &OuterLookup.Add(Outer, OuterPrefixes.Add(MoveTemp(Prefix)));
+    }
+    OuterIds.Add(*OuterId);
+
+    TagStarts.Add(Tags.Num());
+    Tags.Append(Actor->Tags);
+
+    ComponentStarts.Add(ComponentNames.Num());
+    for (UActorComponent* Component : Actor->GetComponents())
+    {
+        ComponentNames.Add(Component->GetFName());
+        ComponentClassIds.Add(InternClass(Component->GetClass()));
+    }
+}
+
+int32 FAegisActorCapture::InternClass(UClass* Class)
+{
+    if (const int32* Existing = ClassLookup.Find(Class))
+    {
+        return *Existing;
+    }
+    Classes.Add(Class);
+    const int32 ClassId = ClassNames.Add(Class->GetName());
+    ClassLookup.Add(Class, ClassId);
+    return ClassId;
+}
+
+FString FAegisActorCapture::GetPath(int32 Index) const
+{
+    return OuterPrefixes[OuterIds[Index]] + Names[Index].ToString();
+}
+
+void FAegisActorCapture::GetAllIndices(TArray<int32>& OutIndices) const
+{
+    OutIndices.Reset(Num());
+    for (int32 Index = 0; Index < Num(); ++Index)
+    {
+        OutIndices.Add(Index);
+    }
+}
+
+void FAegisActorCapture::Filter(const FAegisActorQuery& Query, TArray<int32>& OutIndices) const
+{
+    const int32 Count = Num();
+    OutIndices.Reset(Count);
+
+    if (Query.IsUnsatisfiable())
+    {
+        return;
+    }
+
+    // Class filter: decided once per class instead of once per actor
+    TArray<bool> ClassPasses;
+    ClassPasses.SetNumUninitialized(Classes.Num());
+    for (int32 ClassId = 0; ClassId < Classes.Num(); ++ClassId)
+    {
+        ClassPasses[ClassId] = Query.MatchesClass(Classes[ClassId]);
+    }
+
+    TArray<bool> Passes;
+    Passes.SetNumUninitialized(Count);
+
+    const bool bFilterTags = Query.GetParams().TagFilter.Num() > 0;
+    const int32 TaskCount = FMath::DivideAndRoundUp(Count, ActorsPerTask);
+    ParallelFor(TaskCount, [&](int32 TaskIndex)
+    {
+        const int32 Begin = TaskIndex * ActorsPerTask;
+        const int32 End = FMath::Min(Begin + ActorsPerTask, Count);
+        for (int32 Index = Begin; Index < End; ++Index)
+        {
+            bool bPasses = ClassPasses[ClassIds[Index]];
+            if (bPasses && bFilterTags)
+            {
+                const int32 TagEnd = Index + 1 < Count ? TagStarts[Index + 1] : Tags.Num();
+                bPasses = Query.MatchesTags(TConstArrayView<FName>(Tags.GetData() + TagStarts[Index], TagEnd - TagStarts[Index]));
+            }
+            Passes[Index] = bPasses;
+        }
+    }, GetParallelFlags(TaskCount));
+
+    for (int32 Index = 0; Index < Count; ++Index)
+    {
+        if (Passes[Index])
+        {
+            OutIndices.Add(Index);
+        }
+    }
+}
+
+void FAegisActorCapture::Encode(TConstArrayView<int32> Indices, const FAegisGUIDRegistry& GUIDRegistry, const TCHAR* Separator, TArray<FString>& OutBatches) const
+{
+    const int32 Count = Indices.Num();
+    const int32 TaskCount = FMath::DivideAndRoundUp(Count, ActorsPerTask);
+
+    OutBatches.Reset(TaskCount);
+    OutBatches.SetNum(TaskCount);
+
+    ParallelFor(TaskCount, [&](int32 TaskIndex)
+    {
+        const int32 Begin = TaskIndex * ActorsPerTask;
+        const int32 End = FMath::Min(Begin + ActorsPerTask, Count);
+
+        FString& Batch = OutBatches[TaskIndex];
+        FString Actor;
+        for (int32 Position = Begin; Position < End; ++Position)
+        {
+            Actor.Reset();
+            EncodeActor(Actor, Indices[Position], GUIDRegistry);
+
+            if (Position > Begin)
+            {
+                Batch.Append(Separator);
+            }
+            Batch.Append(Actor);
+        }
+    }, GetParallelFlags(TaskCount));
+}
+
+FString FAegisActorCapture::EncodeArray(TConstArrayView<int32> Indices, const FAegisGUIDRegistry& GUIDRegistry) const
+{
+    TArray<FString> Batches;
+    Encode(Indices, GUIDRegistry, TEXT(","), Batches);
+
+    int32 Length = 2 + Batches.Num();
+    for (const FString& Batch : Batches)
+    {
+        Length += Batch.Len();
+    }
+
+    FString Json;
+    Json.Reserve(Length);
+    Json.AppendChar(TCHAR('['));
+    for (int32 BatchIndex = 0; BatchIndex < Batches.Num(); ++BatchIndex)
+    {
+        if (BatchIndex > 0)
+        {
+            Json.AppendChar(TCHAR(','));
+        }
+        Json.Append(Batches[BatchIndex]);
+    }
+    Json.AppendChar(TCHAR(']'));
+    return Json;
+}
+
+void FAegisActorCapture::EncodeActor(FString& Out, int32 Index, const FAegisGUIDRegistry& GUIDRegistry) const
+{
+    const FString ActorPath = GetPath(Index);
+
+    TSharedRef<FAegisJsonWriter> Writer = FAegisJsonWriterFactory::Create(&Out);
+    Writer->WriteObjectStart();
+
+    Writer->WriteValue(TEXT("guid"), GUIDRegistry.FindGUIDByPath(ActorPath));
+    Writer->WriteValue(TEXT("name"), Names[Index].ToString());
+    Writer->WriteValue(TEXT("class"), ClassNames[ClassIds[Index]]);
+    Writer->WriteValue(TEXT("path"), ActorPath);
+
+    AegisJson::WriteTransform(*Writer, TEXT("transform"), Locations[Index], Rotations[Index], Scales[Index]);
+
+    const int32 Count = Num();
+    const int32 TagEnd = Index + 1 < Count ? TagStarts[Index + 1] : Tags.Num();
+    Writer->WriteArrayStart(TEXT("tags"));
+    for (int32 TagIndex = TagStarts[Index]; TagIndex < TagEnd; ++TagIndex)
+    {
+        Writer->WriteValue(Tags[TagIndex].ToString());
+    }
+    Writer->WriteArrayEnd();
+
+    const int32 ComponentEnd = Index + 1 < Count ? ComponentStarts[Index + 1] : ComponentNames.Num();
+    Writer->WriteArrayStart(TEXT("components"));
+    for (int32 ComponentIndex = ComponentStarts[Index]; ComponentIndex < ComponentEnd; ++ComponentIndex)
+    {
+        Writer->WriteObjectStart();
+        Writer->WriteValue(TEXT("name"), ComponentNames[ComponentIndex].ToString());
+        Writer->WriteValue(TEXT("class"), ClassNames[ComponentClassIds[ComponentIndex]]);
+        Writer->WriteObjectEnd();
+    }
+    Writer->WriteArrayEnd();
+
+    Writer->WriteObjectEnd();
+    Writer->Close();
+}
@@ -0,0 +1,285 @@
+// Copyright AEGIS Team. All Rights Reserved.
+
+#include "AegisActorIndex.h"
+#include "AegisBridgeModule.h"
+#include "Engine/World.h"
+#include "Engine/Level.h"
+#include "EngineUtils.h"
+#include "GameFramework/Actor.h"
+
+AActor* FAegisActorIndex::FindActor(UWorld* World, const FString& PathOrName)
+{
+    if (!World || PathOrName.IsEmpty())
+    {
+        return nullptr;
+    }
+
+    EnsureBuilt(World);
+
+    // Full object path
+    if (const TWeakObjectPtr<AActor>* Found = ByPath.Find(PathOrName))
+    {
+        AActor* Actor = Found->Get();
+        if (IsUsable(Actor))
+        {
+            return Actor;
+        }
+    }
+
+    // Object name. FNAME_Find avoids growing the name table for unknown input.
+    const FName Name(*PathOrName, FNAME_Find);
+    if (!Name.IsNone())
+    {
+        for (auto It = ByName.CreateConstKeyIterator(Name); It; ++It)
+        {
+            AActor* Actor = It.Value().Get();
+            if (IsUsable(Actor))
+            {
+                return Actor;
+            }
+        }
+    }
+
+    // Not indexed yet (e.g. created without an editor notification): resolve through
+    // the object hash and remember the result
+    AActor* Actor = PathOrName.StartsWith(TEXT("/"))
+        ? FindObject<AActor>(nullptr, *PathOrName)
+        : FindObject<AActor>(World->GetCurrentLevel(), *PathOrName);
+
+    if (IsUsable(Actor))
+    {
+        AddActor(Actor);
+        return Actor;
+    }
+
+    return nullptr;
+}
+
+void FAegisActorIndex::GetActorsOfClass(UWorld* World, const UClass* Class, bool bIncludeSubclasses, TArray<AActor*>& OutActors)
+{
+    if (!World || !Class)
+    {
+        return;
+    }
+
+    EnsureBuilt(World);
+
+    auto CollectBucket = [this, &OutActors](const TSet<TWeakObjectPtr<AActor>>& Bucket)
+    {
+        for (const TWeakObjectPtr<AActor>& WeakActor : Bucket)
+        {
+            AActor* Actor = WeakActor.Get();
+            if (IsUsable(Actor))
+            {
+                OutActors.Add(Actor);
+            }
+        }
+    };
+
+    if (!bIncludeSubclasses)
+    {
+        if (const TSet<TWeakObjectPtr<AActor>>* Bucket = ByClass.Find(TObjectKey<UClass>(const_cast<UClass*>(Class))))
+        {
+            CollectBucket(*Bucket);
+        }
+        return;
+    }
+
+    // The number of distinct classes is small compared to the number of actors
+    for (const auto& Pair : ByClass)
+    {
+        const UClass* BucketClass = Pair.Key.ResolveObjectPtr();
+        if (BucketClass && BucketClass->IsChildOf(Class))
+        {
+            CollectBucket(Pair.Value);
+        }
+    }
+}
+
+void FAegisActorIndex::GetClasses(UWorld* World, TArray<UClass*>& OutClasses)
+{
+    if (!World)
+    {
+        return;
+    }
+
+    EnsureBuilt(World);
+
+    OutClasses.Reserve(OutClasses.Num() + ByClass.Num());
+    for (const auto& Pair : ByClass)
+    {
+        if (UClass* BucketClass = Pair.Key.ResolveObjectPtr())
+        {
+            OutClasses.Add(BucketClass);
+        }
+    }
+}
+
+void FAegisActorIndex::GetAllActors(UWorld* World, TArray<AActor*>& OutActors)
+{
+    if (!World)
+    {
+        return;
+    }
+
+    EnsureBuilt(World);
+
+    OutActors.Reserve(OutActors.Num() + Entries.Num());
+    for (const auto& Pair : Entries)
+    {
+        AActor* Actor = Pair.Value.Actor.Get();
+        if (IsUsable(Actor))
+        {
+            OutActors.Add(Actor);
+        }
+    }
+}
+
+void FAegisActorIndex::Rebuild(UWorld* World)
+{
+    Reset();
+
+    if (!World)
+    {
+        return;
+    }
+
+    const double StartTime = FPlatformTime::Seconds();
+
+    IndexedWorld = World;
+    for (TActorIterator<AActor> It(World); It; ++It)
+    {
+        AddActor(*It);
+    }
+    bDirty = false;
+
+    UE_LOG(LogAegisBridge, Verbose, TEXT("Actor index built for %s: %d actors in %.2f ms"),
+        *World->GetName(), Entries.Num(), (FPlatformTime::Seconds() - StartTime) * 1000.0);
+}
+
+void FAegisActorIndex::Reset()
+{
+    ByPath.Empty();
+    ByName.Empty();
+    ByClass.Empty();
+    Entries.Empty();
+    IndexedWorld.Reset();
+    bDirty = true;
+}
+
+void FAegisActorIndex::OnActorAdded(AActor* Actor)
+{
+    // While stale, the next rebuild picks the actor up anyway
+    if (!bDirty && Actor && Actor->GetWorld() == IndexedWorld.Get())
+    {
+        AddActor(Actor);
+    }
+}
+
+void FAegisActorIndex::OnActorRemoved(AActor* Actor)
+{
+    if (!bDirty && Actor)
+    {
+        RemoveActor(TObjectKey<AActor>(Actor));
+    }
+}
+
+void FAegisActorIndex::OnLevelAdded(ULevel* Level, UWorld* World)
+{
+    if (bDirty || !Level || World != IndexedWorld.Get())
+    {
+        return;
+    }
+
+    for (AActor* Actor : Level->Actors)
+    {
+        if (Actor)
+        {
+            AddActor(Actor);
+        }
+    }
+}
+
+void FAegisActorIndex::OnLevelRemoved(ULevel* Level, UWorld* World)
+{
+    if (bDirty || World != IndexedWorld.Get())
+    {
+        return;
+    }
+
+    // A null level means every level is being removed from the world
+    if (!Level)
+    {
+        Invalidate();
+        return;
+    }
+
+    for (AActor* Actor : Level->Actors)
+    {
+        if (Actor)
+        {
+            RemoveActor(TObjectKey<AActor>(Actor));
+        }
+    }
+}
+
+void FAegisActorIndex::EnsureBuilt(UWorld* World)
+{
+    if (bDirty || IndexedWorld.Get() != World)
+    {
+        Rebuild(World);
+    }
+}
+
+void FAegisActorIndex::AddActor(AActor* Actor)
+{
+    const TObjectKey<AActor> ActorKey(Actor);
+    if (Entries.Contains(ActorKey))
+    {
+        RemoveActor(ActorKey);
+    }
+
+    FEntry Entry;
+    Entry.Actor = Actor;
+    Entry.Path = Actor->GetPathName();
+    Entry.Name = Actor->GetFName();
+    Entry.Class = TObjectKey<UClass>(Actor->GetClass());
+
+    ByPath.Add(Entry.Path, Entry.Actor);
+    ByName.Add(Entry.Name, Entry.Actor);
+    ByClass.FindOrAdd(Entry.Class).Add(Entry.Actor);
+    Entries.Add(ActorKey, MoveTemp(Entry));
+}
+
+void FAegisActorIndex::RemoveActor(const TObjectKey<AActor>& ActorKey)
+{
+    FEntry Entry;
+    if (!Entries.RemoveAndCopyValue(ActorKey, Entry))
+    {
+        return;
+    }
+
+    if (const TWeakObjectPtr<AActor>* PathEntry = ByPath.Find(Entry.Path))
+    {
+        if (*PathEntry == Entry.Actor)
+        {
+            ByPath.Remove(Entry.Path);
+        }
+    }
+
+    ByName.RemoveSingle(Entry.Name, Entry.Actor);
+
+    if (TSet<TWeakObjectPtr<AActor>>* Bucket = ByClass.Find(Entry.Class))
+    {
+        Bucket->Remove(Entry.Actor);
+        if (Bucket->Num() == 0)
+        {
+            ByClass.Remove(Entry.Class);
+        }
+    }
+}
+
+bool FAegisActorIndex::IsUsable(const AActor* Actor) const
+{
+    return IsValid(Actor) && Actor->GetWorld() == IndexedWorld.Get();
+}
@@ -0,0 +1,245 @@
+// Copyright AEGIS Team. All Rights Reserved.
+
+#include "AegisActorQuery.h"
+#include "AegisActorIndex.h"
+#include "Algo/Sort.h"
+#include "Engine/World.h"
+#include "GameFramework/Actor.h"
+#include "String/Find.h"
+
+namespace
+{
+    /**
+     * Leave Items holding positions [Offset, Offset + Count) of the order Less defines. Only
+     * Offset + Count entries are ever kept, in a heap with the largest on top, so a page of a
+     * large match set costs O(N log K) rather than a full sort.
+     */
+    template <typename ItemType, typename PredicateType>
+    void SelectPage(TArray<ItemType>& Items, int32 Offset, int32 Count, PredicateType Less)
+    {
+        if (Count <= 0)
+        {
+            Items.Reset();
+            return;
+        }
+
+        const int32 Keep = Offset + Count;
+        if (Keep < Items.Num())
+        {
+            auto Greater = [&Less](const ItemType& A, const ItemType& B) { return Less(B, A); };
+
+            TArray<ItemType> Heap;
+            Heap.Reserve(Keep + 1);
+            for (ItemType& Item : Items)
+            {
+                if (Heap.Num() < Keep)
+                {
+                    Heap.HeapPush(MoveTemp(Item), Greater);
+                }
+                else if (Less(Item, Heap.HeapTop()))
+                {
+                    Heap.HeapPopDiscard(Greater, false);
+                    Heap.HeapPush(MoveTemp(Item), Greater);
+                }
+            }
+            Items = MoveTemp(Heap);
+        }
+
+        Algo::Sort(Items, Less);
+        Items.RemoveAt(0, Offset, false);
+    }
+
+    /** Index iteration order follows hashing, so pages are cut from name order; path names only settle equal names */
+    bool ActorNameLess(const AActor* A, const AActor* B)
+    {
+        const int32 Compare = A->GetFName().Compare(B->GetFName());
+        return Compare != 0 ? Compare < 0 : A->GetPathName() < B->GetPathName();
+    }
+}
+
+FAegisActorQuery::FAegisActorQuery(const FAegisActorQueryParams& InParams)
+    : Params(InParams)
+{
+    for (const FString& ClassName : Params.ClassFilter)
+    {
+        const UClass* Class = ClassName.Contains(TEXT("."))
+            ? FindObject<UClass>(nullptr, *ClassName)
+            : FindFirstObject<UClass>(*ClassName, EFindFirstObjectOptions::None);
+
+        if (Class && Class->IsChildOf(AActor::StaticClass()))
+        {
+            FilterClasses.AddUnique(Class);
+        }
+    }
+
+    // FNAME_Find avoids growing the name table; a tag that was never named is on no actor
+    for (const FString& Tag : Params.TagFilter)
+    {
+        const FName TagName(*Tag, FNAME_Find);
+        if (TagName.IsNone() && Tag != TEXT("None"))
+        {
+            bUnsatisfiable = true;
+            break;
+        }
+        RequiredTags.AddUnique(TagName);
+    }
+}
+
+bool FAegisActorQuery::MatchesClass(const UClass* Class) const
+{
+    if (Params.ClassFilter.Num() == 0)
+    {
+        return true;
+    }
+    if (!Class)
+    {
+        return false;
+    }
+
+    if (const bool* Decision = ClassDecisions.Find(Class))
+    {
+        return *Decision;
+    }
+
+    bool bMatches = FilterClasses.ContainsByPredicate([Class](const UClass* FilterClass)
+    {
+        return Class->IsChildOf(FilterClass);
+    });
+
+    if (!bMatches)
+    {
+        // Substring matching keeps partial names such as "Light" working
+        const FString ClassName = Class->GetName();
+        bMatches = Params.ClassFilter.ContainsByPredicate([&ClassName](const FString& ClassFilterStr)
+        {
+            return ClassName.Contains(ClassFilterStr);
+        });
+    }
+
+    ClassDecisions.Add(Class, bMatches);
+    return bMatches;
+}
+
+bool FAegisActorQuery::MatchesTags(TConstArrayView<FName> Tags) const
+{
+    if (bUnsatisfiable)
+    {
+        return false;
+    }
+
+    for (const FName& Tag : RequiredTags)
+    {
+        if (!Tags.Contains(Tag))
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+bool FAegisActorQuery::MatchesLocation(const FVector& Location) const
+{
+    if (Params.Bounds.IsSet() && !Params.Bounds->IsInsideOrOn(Location))
+    {
+        return false;
+    }
+
+    if (Params.Origin.IsSet() && Params.Radius > 0.0 && FVector::DistSquared(*Params.Origin, Location) > FMath::Square(Params.Radius))
+    {
+        return false;
+    }
+
+    return true;
+}
+
+bool FAegisActorQuery::Matches(const AActor* Actor) const
+{
+    if (!Actor || !MatchesClass(Actor->GetClass()) || !MatchesTags(Actor->Tags))
+    {
+        return false;
+    }
+
+    if (!Params.NameFilter.IsEmpty())
+    {
+        TStringBuilder<FName::StringBufferSize> Name;
+        Actor->GetFName().ToString(Name);
+        if (UE::String::FindFirst(Name.ToView(), Params.NameFilter, ESearchCase::IgnoreCase) == INDEX_NONE)
+        {
+            return false;
+        }
+    }
+
+    return (!Params.Bounds.IsSet() && !Params.Origin.IsSet()) || MatchesLocation(Actor->GetActorLocation());
+}
+
+int32 FAegisActorQuery::Execute(UWorld* World, FAegisActorIndex& Index, TArray<AActor*>& OutActors) const
+{
+    if (!World || bUnsatisfiable)
+    {
+        return 0;
+    }
+
+    // Whole class buckets are accepted or skipped; only the remaining filters look at each actor
+    TArray<AActor*> Candidates;
+    if (Params.ClassFilter.Num() > 0)
+    {
+        TArray<UClass*> Classes;
+        Index.GetClasses(World, Classes);
+        for (UClass* Class : Classes)
+        {
+            if (MatchesClass(Class))
+            {
+                Index.GetActorsOfClass(World, Class, false, Candidates);
+            }
+        }
+    }
+    else
+    {
+        Index.GetAllActors(World, Candidates);
+    }
+
+    TArray<AActor*> Matched;
+    Matched.Reserve(Candidates.Num());
+    for (AActor* Actor : Candidates)
+    {
+        if (Matches(Actor))
+        {
+            Matched.Add(Actor);
+        }
+    }
+
+    const int32 Total = Matched.Num();
+    const int32 Offset = FMath::Clamp(Params.Offset, 0, Total);
+    const int32 Count = Params.Limit > 0 ? FMath::Min(Params.Limit, Total - Offset) : Total - Offset;
+
+    if (Params.Origin.IsSet())
+    {
+        TArray<TPair<double, AActor*>> ByDistance;
+        ByDistance.Reserve(Total);
+        for (AActor* Actor : Matched)
+        {
+            ByDistance.Emplace(FVector::DistSquared(*Params.Origin, Actor->GetActorLocation()), Actor);
+        }
+        SelectPage(ByDistance, Offset, Count, [](const TPair<double, AActor*>& A, const TPair<double, AActor*>& B)
+        {
+            return A.Key != B.Key ? A.Key < B.Key : ActorNameLess(A.Value, B.Value);
+        });
+
+        OutActors.Reserve(OutActors.Num() + ByDistance.Num());
+        for (const TPair<double, AActor*>& Entry : ByDistance)
+        {
+            OutActors.Add(Entry.Value);
+        }
+    }
+    else if (Offset > 0 || Count < Total)
+    {
+        SelectPage(Matched, Offset, Count, ActorNameLess);
+        OutActors.Append(Matched);
+    }
+    else
+    {
+        OutActors.Append(Matched);
+    }
+
+    return Total;
+}
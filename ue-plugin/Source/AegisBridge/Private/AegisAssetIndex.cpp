@@ -0,0 +1,377 @@
+// Copyright AEGIS Team. All Rights Reserved.
+
+#include "AegisAssetIndex.h"
+#include "AegisBridgeModule.h"
+#include "Algo/BinarySearch.h"
+#include "Algo/Sort.h"
+#include "AssetRegistry/AssetData.h"
+#include "AssetRegistry/AssetRegistryModule.h"
+#include "AssetRegistry/IAssetRegistry.h"
+#include "HAL/PlatformTime.h"
+
+namespace
+{
+    /** Removed entries tolerated before the next search rebuilds the index */
+    constexpr int32 MinRemovedForCompaction = 4096;
+
+    IAssetRegistry& GetAssetRegistry()
+    {
+        // Also reached from search workers, which must not load modules
+        return IAssetRegistry::GetChecked();
+    }
+
+    bool IsUnderPath(const FString& ObjectPath, FStringView Path)
+    {
+        return ObjectPath.Len() > Path.Len() && ObjectPath[Path.Len()] == TCHAR('/') && FStringView(ObjectPath).StartsWith(Path, ESearchCase::IgnoreCase);
+    }
+}
+
+void FAegisAssetIndex::Initialize()
+{
+    IAssetRegistry& AssetRegistry = GetAssetRegistry();
+    AssetAddedHandle = AssetRegistry.OnAssetAdded().AddRaw(this, &FAegisAssetIndex::OnAssetAdded);
+    AssetRemovedHandle = AssetRegistry.OnAssetRemoved().AddRaw(this, &FAegisAssetIndex::OnAssetRemoved);
+    AssetRenamedHandle = AssetRegistry.OnAssetRenamed().AddRaw(this, &FAegisAssetIndex::OnAssetRenamed);
+
+    // An index built during the initial scan only saw part of the project
+    FilesLoadedHandle = AssetRegistry.OnFilesLoaded().AddRaw(this, &FAegisAssetIndex::Invalidate);
+}
+
+void FAegisAssetIndex::Invalidate()
+{
+    FWriteScopeLock WriteLock(Lock);
+    bDirty = true;
+}
+
+void FAegisAssetIndex::Shutdown()
+{
+    if (FAssetRegistryModule* AssetRegistryModule = FModuleManager::GetModulePtr<FAssetRegistryModule>("AssetRegistry"))
+    {
+        IAssetRegistry& AssetRegistry = AssetRegistryModule->Get();
+        AssetRegistry.OnAssetAdded().Remove(AssetAddedHandle);
+        AssetRegistry.OnAssetRemoved().Remove(AssetRemovedHandle);
+        AssetRegistry.OnAssetRenamed().Remove(AssetRenamedHandle);
+        AssetRegistry.OnFilesLoaded().Remove(FilesLoadedHandle);
+    }
+
+    FWriteScopeLock WriteLock(Lock);
+    Entries.Empty();
+    ByPath.Empty();
+    Postings.Empty();
+    RemovedCount = 0;
+    bDirty = true;
+}
+
+int32 FAegisAssetIndex::Num()
+{
+    EnsureBuilt();
+
+    FReadScopeLock ReadLock(Lock);
+    return Entries.Num() - RemovedCount;
+}
+
+void FAegisAssetIndex::EnsureBuilt()
+{
+    {
+        FReadScopeLock ReadLock(Lock);
+        if (!bDirty)
+        {
+            return;
+        }
+    }
+
+    // Searches racing here rebuild once
+    FWriteScopeLock WriteLock(Lock);
+    if (bDirty)
+    {
+        Rebuild();
+    }
+}
+
+void FAegisAssetIndex::Rebuild()
+{
+    const double StartTime = FPlatformTime::Seconds();
+
+    Entries.Reset();
+    ByPath.Reset();
+    Postings.Reset();
+    RemovedCount = 0;
+    ++Generation;
+
+    TArray<FAssetData> Assets;
+    GetAssetRegistry().GetAllAssets(Assets);
+
+    Entries.Reserve(Assets.Num());
+    ByPath.Reserve(Assets.Num());
+    for (const FAssetData& Asset : Assets)
+    {
+        AddAsset(Asset);
+    }
+    bDirty = false;
+
+    UE_LOG(LogAegisBridge, Log, TEXT("Asset index built: %d assets, %d trigrams in %.2f ms"),
+        Entries.Num(), Postings.Num(), (FPlatformTime::Seconds() - StartTime) * 1000.0);
+}
+
+void FAegisAssetIndex::AddAsset(const FAssetData& Asset)
+{
+    FString ObjectPath = Asset.GetObjectPathString();
+    if (ByPath.Contains(ObjectPath))
+    {
+        RemoveAsset(ObjectPath);
+    }
+
+    const int32 Id = Entries.Num();
+
+    FEntry& Entry = Entries.AddDefaulted_GetRef();
+    Entry.ObjectPath = MoveTemp(ObjectPath);
+    Entry.LowerName = Asset.AssetName.ToString().ToLower();
+    Entry.AssetName = Asset.AssetName;
+    Entry.PackageName = Asset.PackageName;
+    Entry.ClassPath = Asset.AssetClassPath;
+
+    ByPath.Add(Entry.ObjectPath, Id);
+
+    // Ids only grow, so appending keeps every posting list sorted
+    TArray<FTrigram> Trigrams;
+    GetTrigrams(Entry.LowerName, Trigrams);
+    for (FTrigram Trigram : Trigrams)
+    {
+        Postings.FindOrAdd(Trigram).Add(Id);
+    }
+}
+
+void FAegisAssetIndex::RemoveAsset(const FString& ObjectPath)
+{
+    int32 Id = INDEX_NONE;
+    if (!ByPath.RemoveAndCopyValue(ObjectPath, Id))
+    {
+        return;
+    }
+
+    // Postings keep the id; searches skip removed entries
+    FEntry& Entry = Entries[Id];
+    Entry.bRemoved = true;
+    Entry.ObjectPath.Empty();
+    Entry.LowerName.Empty();
+    ++RemovedCount;
+
+    if (RemovedCount >= MinRemovedForCompaction && RemovedCount * 2 > Entries.Num())
+    {
+        bDirty = true;
+    }
+}
+
+void FAegisAssetIndex::OnAssetAdded(const FAssetData& Asset)
+{
+    // While stale, the next rebuild picks the asset up anyway
+    FWriteScopeLock WriteLock(Lock);
+    if (!bDirty)
+    {
+        AddAsset(Asset);
+    }
+}
+
+void FAegisAssetIndex::OnAssetRemoved(const FAssetData& Asset)
+{
+    FWriteScopeLock WriteLock(Lock);
+    if (!bDirty)
+    {
+        RemoveAsset(Asset.GetObjectPathString());
+    }
+}
+
+void FAegisAssetIndex::OnAssetRenamed(const FAssetData& Asset, const FString& OldObjectPath)
+{
+    FWriteScopeLock WriteLock(Lock);
+    if (!bDirty)
+    {
+        RemoveAsset(OldObjectPath);
+        AddAsset(Asset);
+    }
+}
+
+void FAegisAssetIndex::GetTrigrams(FStringView LowerText, TArray<FTrigram>& OutTrigrams)
+{
+    // 21 bits per code unit covers every TCHAR width
+    for (int32 Index = 0; Index + 3 <= LowerText.Len(); ++Index)
+    {
+        const FTrigram Trigram =
+            (static_cast<FTrigram>(LowerText[Index] & 0x1FFFFF)) |
+            (static_cast<FTrigram>(LowerText[Index + 1] & 0x1FFFFF) << 21) |
+            (static_cast<FTrigram>(LowerText[Index + 2] & 0x1FFFFF) << 42);
+        OutTrigrams.AddUnique(Trigram);
+    }
+}
+
+void FAegisAssetIndex::GetCandidates(const TArray<FTrigram>& Trigrams, int32 AfterId, TArray<int32>& OutIds) const
+{
+    TArray<const TArray<int32>*> Lists;
+    Lists.Reserve(Trigrams.Num());
+    for (FTrigram Trigram : Trigrams)
+    {
+        const TArray<int32>* List = Postings.Find(Trigram);
+        if (!List)
+        {
+            return;
+        }
+        Lists.Add(List);
+    }
+
+    // Walk the shortest list and probe the others
+    Algo::SortBy(Lists, [](const TArray<int32>* List) { return List->Num(); });
+
+    const TArray<int32>& Shortest = *Lists[0];
+    for (int32 Position = Algo::UpperBound(Shortest, AfterId); Position < Shortest.Num(); ++Position)
+    {
+        const int32 Id = Shortest[Position];
+
+        bool bInAll = true;
+        for (int32 ListIndex = 1; ListIndex < Lists.Num() && bInAll; ++ListIndex)
+        {
+            bInAll = Algo::BinarySearch(*Lists[ListIndex], Id) != INDEX_NONE;
+        }
+
+        if (bInAll)
+        {
+            OutIds.Add(Id);
+        }
+    }
+}
+
+bool FAegisAssetIndex::Search(const FAegisAssetSearchParams& Params, TArray<FEntry>& OutEntries, FString& OutNextCursor, FString& OutError)
+{
+    EnsureBuilt();
+
+    FReadScopeLock ReadLock(Lock);
+
+    // Cursor format: "<Generation>:<LastId>"
+    int32 AfterId = INDEX_NONE;
+    if (!Params.Cursor.IsEmpty())
+    {
+        FString GenerationString;
+        FString IdString;
+        uint32 CursorGeneration = 0;
+        if (!Params.Cursor.Split(TEXT(":"), &GenerationString, &IdString) ||
+            !LexTryParseString(CursorGeneration, *GenerationString) || !LexTryParseString(AfterId, *IdString))
+        {
+            OutError = TEXT("Invalid search cursor");
+            return false;
+        }
+        if (CursorGeneration != Generation)
+        {
+            OutError = TEXT("Search cursor expired; the asset index was rebuilt");
+            return false;
+        }
+    }
+
+    const int32 Limit = Params.Limit > 0 ? FMath::Min(Params.Limit, MaxLimit) : DefaultLimit;
+
+    // Classes: full paths, or short names compared against the path's asset name
+    TArray<FTopLevelAssetPath> ClassPaths;
+    TArray<FName> ClassShortNames;
+    for (const FString& ClassName : Params.ClassNames)
+    {
+        if (ClassName.Contains(TEXT(".")))
+        {
+            const FTopLevelAssetPath ClassPath(ClassName);
+            if (!ClassPath.IsNull())
+            {
+                ClassPaths.Add(ClassPath);
+            }
+        }
+        else
+        {
+            const FName ShortName(*ClassName, FNAME_Find);
+            if (!ShortName.IsNone())
+            {
+                ClassShortNames.Add(ShortName);
+            }
+        }
+    }
+
+    // None of the requested classes exists
+    const bool bFilterClasses = Params.ClassNames.Num() > 0;
+    if (bFilterClasses && ClassPaths.Num() == 0 && ClassShortNames.Num() == 0)
+    {
+        return true;
+    }
+
+    FString Path = Params.Path;
+    while (Path.EndsWith(TEXT("/")))
+    {
+        Path.LeftChopInline(1);
+    }
+
+    const FString LowerQuery = Params.Query.ToLower();
+
+    auto Matches = [&](const FEntry& Entry)
+    {
+        if (Entry.bRemoved)
+        {
+            return false;
+        }
+        if (!LowerQuery.IsEmpty())
+        {
+            const bool bNameMatches = Params.bPrefix
+                ? Entry.LowerName.StartsWith(LowerQuery, ESearchCase::CaseSensitive)
+                : Entry.LowerName.Contains(LowerQuery, ESearchCase::CaseSensitive);
+            if (!bNameMatches)
+            {
+                return false;
+            }
+        }
+        if (bFilterClasses && !ClassPaths.Contains(Entry.ClassPath) && !ClassShortNames.Contains(Entry.ClassPath.GetAssetName()))
+        {
+            return false;
+        }
+        return Path.IsEmpty() || IsUnderPath(Entry.ObjectPath, Path);
+    };
+
+    // Returns false once the page is full and one more match proves there is a next page
+    int32 LastId = AfterId;
+    auto Visit = [&](int32 Id)
+    {
+        if (!Matches(Entries[Id]))
+        {
+            return true;
+        }
+        if (OutEntries.Num() == Limit)
+        {
+            OutNextCursor = FString::Printf(TEXT("%u:%d"), Generation, LastId);
+            return false;
+        }
+        OutEntries.Add(Entries[Id]);
+        LastId = Id;
+        return true;
+    };
+
+    if (LowerQuery.Len() >= 3)
+    {
+        TArray<FTrigram> Trigrams;
+        GetTrigrams(LowerQuery, Trigrams);
+
+        TArray<int32> Candidates;
+        GetCandidates(Trigrams, AfterId, Candidates);
+        for (int32 Id : Candidates)
+        {
+            if (!Visit(Id))
+            {
+                break;
+            }
+        }
+    }
+    else
+    {
+        // Too short for trigrams: scan, still without building any strings
+        for (int32 Id = AfterId + 1; Id < Entries.Num(); ++Id)
+        {
+            if (!Visit(Id))
+            {
+                break;
+            }
+        }
+    }
+
+    return true;
+}
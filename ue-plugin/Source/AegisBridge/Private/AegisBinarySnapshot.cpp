@@ -0,0 +1,677 @@
+// Copyright AEGIS Team. All Rights Reserved.
+
+#include "AegisBinarySnapshot.h"
+#include "AegisBridgeModule.h"
+#include "AegisJsonWriter.h"
+#include "AegisParallelJson.h"
+#include "AegisSeedSubsystem.h"
+#include "Dom/JsonObject.h"
+#include "Serialization/JsonSerializer.h"
+#include "Serialization/MemoryReader.h"
+#include "Serialization/MemoryWriter.h"
+
+const TCHAR* FAegisBinarySnapshot::FileExtension = TEXT(".aegissnap");
+
+namespace
+{
+    /** Serialize a JSON object as condensed text */
+    FString ToCondensedJson(const TSharedPtr<FJsonObject>& Object)
+    {
+        // Empty objects are stored as empty strings so they compare equal to absent blocks
+        FString Json;
+        if (Object.IsValid() && Object->Values.Num() > 0)
+        {
+            TSharedRef<FAegisJsonWriter> Writer = FAegisJsonWriterFactory::Create(&Json);
+            FJsonSerializer::Serialize(Object.ToSharedRef(), Writer);
+        }
+        return Json;
+    }
+
+    /** Write an opaque JSON block, falling back to an empty object */
+    void WriteObjectBlock(FAegisJsonWriter& Writer, const TCHAR* Identifier, const FString& Json)
+    {
+        if (Json.IsEmpty())
+        {
+            Writer.WriteObjectStart(Identifier);
+            Writer.WriteObjectEnd();
+        }
+        else
+        {
+            AegisJson::WriteRawJson(Writer, Identifier, Json);
+        }
+    }
+
+    /** Smallest encoded records: the int32 string indices plus an empty FString's length */
+    constexpr int64 MinComponentSize = 3 * sizeof(int32) + sizeof(int32);
+    constexpr int64 MinReferenceSize = 3 * sizeof(int32);
+
+    /**
+     * Serialize a record count. On load, a count the rest of the archive cannot hold marks
+     * the archive as failed, so a corrupt file never drives the allocation.
+     */
+    bool SerializeRecordCount(FArchive& Ar, int32& Count, int64 MinRecordSize)
+    {
+        Ar << Count;
+        if (Ar.IsLoading() && (Ar.IsError() || Count < 0 || Count * MinRecordSize > Ar.TotalSize() - Ar.Tell()))
+        {
+            Ar.SetError();
+            Count = 0;
+            return false;
+        }
+        return true;
+    }
+
+    FVector3f ReadVector(const FJsonObject& Object, const FVector3f& Default)
+    {
+        return FVector3f(
+            Object.HasField(TEXT("x")) ? static_cast<float>(Object.GetNumberField(TEXT("x"))) : Default.X,
+            Object.HasField(TEXT("y")) ? static_cast<float>(Object.GetNumberField(TEXT("y"))) : Default.Y,
+            Object.HasField(TEXT("z")) ? static_cast<float>(Object.GetNumberField(TEXT("z"))) : Default.Z);
+    }
+
+    FRotator3f ReadRotator(const FJsonObject& Object)
+    {
+        return FRotator3f(
+            static_cast<float>(Object.GetNumberField(TEXT("pitch"))),
+            static_cast<float>(Object.GetNumberField(TEXT("yaw"))),
+            static_cast<float>(Object.GetNumberField(TEXT("roll"))));
+    }
+}
+
+// ============================================================================
+// Records
+// ============================================================================
+
+void FAegisSnapshotComponent::Serialize(FArchive& Ar)
+{
+    Ar << GUID << Class << Name << PropertiesJson;
+}
+
+void FAegisSnapshotReference::Serialize(FArchive& Ar)
+{
+    Ar << PropertyName << TargetGUID << TargetPath;
+}
+
+void FAegisSnapshotEntity::Serialize(FArchive& Ar)
+{
+    Ar << GUID << Class << Path << Name << ParentGUID;
+
+    Ar << bHasTransform;
+    if (bHasTransform)
+    {
+        Ar << Location << Rotation << Scale;
+    }
+
+    Ar << Tags;
+
+    int32 ComponentCount = Components.Num();
+    if (!SerializeRecordCount(Ar, ComponentCount, MinComponentSize))
+    {
+        return;
+    }
+    if (Ar.IsLoading())
+    {
+        Components.SetNum(ComponentCount);
+    }
+    for (FAegisSnapshotComponent& Component : Components)
+    {
+        Component.Serialize(Ar);
+    }
+
+    int32 ReferenceCount = References.Num();
+    if (!SerializeRecordCount(Ar, ReferenceCount, MinReferenceSize))
+    {
+        return;
+    }
+    if (Ar.IsLoading())
+    {
+        References.SetNum(ReferenceCount);
+    }
+    for (FAegisSnapshotReference& Reference : References)
+    {
+        Reference.Serialize(Ar);
+    }
+
+    Ar << PropertiesJson;
+}
+
+// ============================================================================
+// String Table
+// ============================================================================
+
+int32 FAegisBinarySnapshot::AddString(const FString& Value)
+{
+    if (Value.IsEmpty())
+    {
+        return INDEX_NONE;
+    }
+
+    if (const int32* Existing = StringLookup.Find(Value))
+    {
+        return *Existing;
+    }
+
+    const int32 Index = Strings.Add(Value);
+    StringLookup.Add(Value, Index);
+    return Index;
+}
+
+const FString& FAegisBinarySnapshot::GetString(int32 Index) const
+{
+    static const FString Empty;
+    return Strings.IsValidIndex(Index) ? Strings[Index] : Empty;
+}
+
+// ============================================================================
+// Binary Encoding
+// ============================================================================
+
+void FAegisBinarySnapshot::SerializeHeader(FArchive& Ar, int32& EntityCount)
+{
+    Ar << Id << Name << Description << Timestamp << Seed << Checksum;
+    Ar << Targets;
+    Ar << MetadataJson;
+    Ar << EntityCount;
+}
+
+bool FAegisBinarySnapshot::ReadPreamble(FArchive& Ar)
+{
+    uint32 FileMagic = 0;
+    uint32 FileVersion = 0;
+    Ar << FileMagic << FileVersion;
+
+    if (Ar.IsError() || FileMagic != Magic)
+    {
+        return false;
+    }
+
+    if (FileVersion > Version)
+    {
+        UE_LOG(LogAegisBridge, Error, TEXT("Binary snapshot version %u is newer than supported version %u"), FileVersion, Version);
+        return false;
+    }
+
+    return true;
+}
+
+void FAegisBinarySnapshot::Save(TArray<uint8>& OutData) const
+{
+    FAegisBinarySnapshot& This = const_cast<FAegisBinarySnapshot&>(*this);
+
+    // Entities are encoded first so the offset table can precede them
+    TArray<uint8> EntityBlock;
+    TArray<int64> EntityOffsets;
+    EntityOffsets.Reserve(Entities.Num());
+    {
+        FMemoryWriter EntityWriter(EntityBlock);
+        for (FAegisSnapshotEntity& Entity : This.Entities)
+        {
+            EntityOffsets.Add(EntityWriter.Tell());
+            Entity.Serialize(EntityWriter);
+        }
+    }
+
+    OutData.Reset();
+    FMemoryWriter Ar(OutData);
+
+    uint32 FileMagic = Magic;
+    uint32 FileVersion = Version;
+    Ar << FileMagic << FileVersion;
+
+    int32 EntityCount = Entities.Num();
+    This.SerializeHeader(Ar, EntityCount);
+
+    Ar << This.Strings;
+    Ar << EntityOffsets;
+    Ar.Serialize(EntityBlock.GetData(), EntityBlock.Num());
+}
+
+bool FAegisBinarySnapshot::Load(const TArray<uint8>& Data)
+{
+    FMemoryReader Ar(Data);
+    if (!ReadPreamble(Ar))
+    {
+        return false;
+    }
+
+    int32 EntityCount = 0;
+    SerializeHeader(Ar, EntityCount);
+    Ar << Strings;
+
+    TArray<int64> EntityOffsets;
+    Ar << EntityOffsets;
+
+    if (Ar.IsError() || EntityCount < 0 || EntityOffsets.Num() != EntityCount)
+    {
+        return false;
+    }
+
+    Entities.SetNum(EntityCount);
+    for (FAegisSnapshotEntity& Entity : Entities)
+    {
+        Entity.Serialize(Ar);
+        if (Ar.IsError())
+        {
+            return false;
+        }
+    }
+
+    StringLookup.Reset();
+    for (int32 Index = 0; Index < Strings.Num(); ++Index)
+    {
+        StringLookup.Add(Strings[Index], Index);
+    }
+
+    return !Ar.IsError();
+}
+
+bool FAegisBinarySnapshot::LoadHeader(const TArray<uint8>& Data, FAegisWorldSnapshot& OutInfo)
+{
+    FMemoryReader Ar(Data);
+    if (!ReadPreamble(Ar))
+    {
+        return false;
+    }
+
+    FAegisBinarySnapshot Header;
+    int32 EntityCount = 0;
+    Header.SerializeHeader(Ar, EntityCount);
+    if (Ar.IsError())
+    {
+        return false;
+    }
+
+    OutInfo.SnapshotId = Header.Id;
+    OutInfo.Name = Header.Name;
+    OutInfo.Description = Header.Description;
+    OutInfo.Checksum = Header.Checksum;
+    OutInfo.EntityCount = EntityCount;
+    FDateTime::ParseIso8601(*Header.Timestamp, OutInfo.Timestamp);
+
+    return true;
+}
+
+bool FAegisBinarySnapshot::LoadEntity(const TArray<uint8>& Data, int32 EntityIndex, FAegisBinarySnapshot& OutSnapshot, FAegisSnapshotEntity& OutEntity)
+{
+    FMemoryReader Ar(Data);
+    if (!ReadPreamble(Ar))
+    {
+        return false;
+    }
+
+    int32 EntityCount = 0;
+    OutSnapshot.SerializeHeader(Ar, EntityCount);
+    Ar << OutSnapshot.Strings;
+
+    TArray<int64> EntityOffsets;
+    Ar << EntityOffsets;
+
+    if (Ar.IsError() || !EntityOffsets.IsValidIndex(EntityIndex))
+    {
+        return false;
+    }
+
+    Ar.Seek(Ar.Tell() + EntityOffsets[EntityIndex]);
+    OutEntity.Serialize(Ar);
+
+    return !Ar.IsError();
+}
+
+bool FAegisBinarySnapshot::IsBinarySnapshot(const TArray<uint8>& Data)
+{
+    return Data.Num() >= static_cast<int32>(sizeof(uint32)) && FMemory::Memcmp(Data.GetData(), &Magic, sizeof(uint32)) == 0;
+}
+
+// ============================================================================
+// JSON Conversion
+// ============================================================================
+
+bool FAegisBinarySnapshot::FromJson(FStringView Json)
+{
+    // Bare entity arrays, as passed to RestoreWorldState
+    TArray<TPair<FStringView, FStringView>> Members;
+    if (!FAegisParallelJson::SplitObject(Json, Members))
+    {
+        return AddEntitiesFromJsonText(Json);
+    }
+
+    // The header is small and goes through the tree parser; the entities never do
+    FStringView EntitiesJson;
+    FString HeaderJson(TEXT("{"));
+    for (const TPair<FStringView, FStringView>& Member : Members)
+    {
+        if (Member.Key == TEXT("entities"))
+        {
+            EntitiesJson = Member.Value;
+            continue;
+        }
+
+        if (HeaderJson.Len() > 1)
+        {
+            HeaderJson.AppendChar(TCHAR(','));
+        }
+        HeaderJson.AppendChar(TCHAR('"'));
+        HeaderJson.Append(Member.Key.GetData(), Member.Key.Len());
+        HeaderJson.Append(TEXT("\":"));
+        HeaderJson.Append(Member.Value.GetData(), Member.Value.Len());
+    }
+    HeaderJson.AppendChar(TCHAR('}'));
+
+    TSharedPtr<FJsonObject> RootObject;
+    TSharedRef<TJsonReader<>> Reader = TJsonReaderFactory<>::Create(HeaderJson);
+    if (!FJsonSerializer::Deserialize(Reader, RootObject) || !RootObject.IsValid())
+    {
+        return false;
+    }
+
+    RootObject->TryGetStringField(TEXT("id"), Id);
+    RootObject->TryGetStringField(TEXT("name"), Name);
+    RootObject->TryGetStringField(TEXT("description"), Description);
+    RootObject->TryGetStringField(TEXT("timestamp"), Timestamp);
+    RootObject->TryGetStringField(TEXT("seed"), Seed);
+    RootObject->TryGetStringField(TEXT("checksum"), Checksum);
+    RootObject->TryGetStringArrayField(TEXT("targets"), Targets);
+
+    const TSharedPtr<FJsonObject>* MetadataObject = nullptr;
+    if (RootObject->TryGetObjectField(TEXT("metadata"), MetadataObject))
+    {
+        MetadataJson = ToCondensedJson(*MetadataObject);
+    }
+
+    // A non-array entities member is ignored, as before
+    return EntitiesJson.IsEmpty() || EntitiesJson[0] != TCHAR('[') || AddEntitiesFromJsonText(EntitiesJson);
+}
+
+void FAegisBinarySnapshot::AddEntitiesFromJson(const TArray<TSharedPtr<FJsonValue>>& EntityValues)
+{
+    Entities.Reserve(Entities.Num() + EntityValues.Num());
+    for (const TSharedPtr<FJsonValue>& EntityValue : EntityValues)
+    {
+        const TSharedPtr<FJsonObject>* EntityObject = nullptr;
+        if (EntityValue.IsValid() && EntityValue->TryGetObject(EntityObject))
+        {
+            AddEntityFromJson(**EntityObject);
+        }
+    }
+}
+
+bool FAegisBinarySnapshot::AddEntitiesFromJsonText(FStringView EntitiesJson)
+{
+    TArray<FAegisParsedEntity> Parsed;
+    if (!FAegisParallelJson::ParseArray<FAegisParsedEntity>(EntitiesJson, Parsed, [](const TSharedPtr<FJsonObject>& Object, FAegisParsedEntity& OutEntity)
+    {
+        ParseEntityJson(*Object, OutEntity);
+    }))
+    {
+        return false;
+    }
+
+    // Interning stays sequential so string indices are deterministic
+    Entities.Reserve(Entities.Num() + Parsed.Num());
+    for (const FAegisParsedEntity& Entity : Parsed)
+    {
+        AddParsedEntity(Entity);
+    }
+    return true;
+}
+
+void FAegisBinarySnapshot::AddEntityFromJson(const FJsonObject& EntityObject)
+{
+    FAegisParsedEntity Parsed;
+    ParseEntityJson(EntityObject, Parsed);
+    AddParsedEntity(Parsed);
+}
+
+void FAegisBinarySnapshot::ParseEntityJson(const FJsonObject& EntityObject, FAegisParsedEntity& OutEntity)
+{
+    OutEntity.GUID = EntityObject.GetStringField(TEXT("guid"));
+    OutEntity.Class = EntityObject.GetStringField(TEXT("class"));
+    OutEntity.Path = EntityObject.GetStringField(TEXT("path"));
+    OutEntity.Name = EntityObject.GetStringField(TEXT("name"));
+    OutEntity.bHasParentGUID = EntityObject.TryGetStringField(TEXT("parentGuid"), OutEntity.ParentGUID);
+
+    const TSharedPtr<FJsonObject>* TransformObject = nullptr;
+    if (EntityObject.TryGetObjectField(TEXT("transform"), TransformObject))
+    {
+        OutEntity.bHasTransform = true;
+
+        const TSharedPtr<FJsonObject>* Field = nullptr;
+        if ((*TransformObject)->TryGetObjectField(TEXT("location"), Field))
+        {
+            OutEntity.Location = ReadVector(**Field, FVector3f::ZeroVector);
+        }
+        if ((*TransformObject)->TryGetObjectField(TEXT("rotation"), Field))
+        {
+            OutEntity.Rotation = ReadRotator(**Field);
+        }
+        if ((*TransformObject)->TryGetObjectField(TEXT("scale"), Field))
+        {
+            OutEntity.Scale = ReadVector(**Field, FVector3f::OneVector);
+        }
+    }
+
+    EntityObject.TryGetStringArrayField(TEXT("tags"), OutEntity.Tags);
+
+    const TArray<TSharedPtr<FJsonValue>>* ComponentValues = nullptr;
+    if (EntityObject.TryGetArrayField(TEXT("components"), ComponentValues))
+    {
+        for (const TSharedPtr<FJsonValue>& ComponentValue : *ComponentValues)
+        {
+            const TSharedPtr<FJsonObject>* ComponentObject = nullptr;
+            if (!ComponentValue->TryGetObject(ComponentObject))
+            {
+                continue;
+            }
+
+            FAegisParsedEntity::FComponent& Component = OutEntity.Components.AddDefaulted_GetRef();
+            Component.GUID = (*ComponentObject)->GetStringField(TEXT("guid"));
+            Component.Class = (*ComponentObject)->GetStringField(TEXT("class"));
+            Component.Name = (*ComponentObject)->GetStringField(TEXT("name"));
+
+            const TSharedPtr<FJsonObject>* Properties = nullptr;
+            if ((*ComponentObject)->TryGetObjectField(TEXT("properties"), Properties))
+            {
+                Component.PropertiesJson = ToCondensedJson(*Properties);
+            }
+        }
+    }
+
+    const TArray<TSharedPtr<FJsonValue>>* ReferenceValues = nullptr;
+    if (EntityObject.TryGetArrayField(TEXT("references"), ReferenceValues))
+    {
+        for (const TSharedPtr<FJsonValue>& ReferenceValue : *ReferenceValues)
+        {
+            const TSharedPtr<FJsonObject>* ReferenceObject = nullptr;
+            if (!ReferenceValue->TryGetObject(ReferenceObject))
+            {
+                continue;
+            }
+
+            FAegisParsedEntity::FReference& Reference = OutEntity.References.AddDefaulted_GetRef();
+            Reference.PropertyName = (*ReferenceObject)->GetStringField(TEXT("propertyName"));
+            Reference.TargetGUID = (*ReferenceObject)->GetStringField(TEXT("targetGuid"));
+            Reference.TargetPath = (*ReferenceObject)->GetStringField(TEXT("targetPath"));
+        }
+    }
+
+    const TSharedPtr<FJsonObject>* Properties = nullptr;
+    if (EntityObject.TryGetObjectField(TEXT("properties"), Properties))
+    {
+        OutEntity.PropertiesJson = ToCondensedJson(*Properties);
+    }
+}
+
+FAegisSnapshotEntity& FAegisBinarySnapshot::AddParsedEntity(const FAegisParsedEntity& Parsed)
+{
+    FAegisSnapshotEntity& Entity = Entities.AddDefaulted_GetRef();
+
+    Entity.GUID = AddString(Parsed.GUID);
+    Entity.Class = AddString(Parsed.Class);
+    Entity.Path = AddString(Parsed.Path);
+    Entity.Name = AddString(Parsed.Name);
+    if (Parsed.bHasParentGUID)
+    {
+        Entity.ParentGUID = AddString(Parsed.ParentGUID);
+    }
+
+    Entity.bHasTransform = Parsed.bHasTransform;
+    Entity.Location = Parsed.Location;
+    Entity.Rotation = Parsed.Rotation;
+    Entity.Scale = Parsed.Scale;
+
+    Entity.Tags.Reserve(Parsed.Tags.Num());
+    for (const FString& Tag : Parsed.Tags)
+    {
+        Entity.Tags.Add(AddString(Tag));
+    }
+
+    Entity.Components.Reserve(Parsed.Components.Num());
+    for (const FAegisParsedEntity::FComponent& ParsedComponent : Parsed.Components)
+    {
+        FAegisSnapshotComponent& Component = Entity.Components.AddDefaulted_GetRef();
+        Component.GUID = AddString(ParsedComponent.GUID);
+        Component.Class = AddString(ParsedComponent.Class);
+        Component.Name = AddString(ParsedComponent.Name);
+        Component.PropertiesJson = ParsedComponent.PropertiesJson;
+    }
+
+    Entity.References.Reserve(Parsed.References.Num());
+    for (const FAegisParsedEntity::FReference& ParsedReference : Parsed.References)
+    {
+        FAegisSnapshotReference& Reference = Entity.References.AddDefaulted_GetRef();
+        Reference.PropertyName = AddString(ParsedReference.PropertyName);
+        Reference.TargetGUID = AddString(ParsedReference.TargetGUID);
+        Reference.TargetPath = AddString(ParsedReference.TargetPath);
+    }
+
+    Entity.PropertiesJson = Parsed.PropertiesJson;
+    return Entity;
+}
+
+FString FAegisBinarySnapshot::ToJson() const
+{
+    FString Json;
+    TSharedRef<FAegisJsonWriter> Writer = FAegisJsonWriterFactory::Create(&Json);
+
+    Writer->WriteObjectStart();
+    Writer->WriteValue(TEXT("id"), Id);
+    Writer->WriteValue(TEXT("name"), Name);
+    Writer->WriteValue(TEXT("description"), Description);
+    Writer->WriteValue(TEXT("timestamp"), Timestamp);
+    Writer->WriteValue(TEXT("seed"), Seed);
+    Writer->WriteValue(TEXT("checksum"), Checksum);
+
+    Writer->WriteArrayStart(TEXT("targets"));
+    for (const FString& Target : Targets)
+    {
+        Writer->WriteValue(Target);
+    }
+    Writer->WriteArrayEnd();
+
+    Writer->WriteArrayStart(TEXT("entities"));
+    for (const FAegisSnapshotEntity& Entity : Entities)
+    {
+        WriteEntityJson(*Writer, Entity);
+    }
+    Writer->WriteArrayEnd();
+
+    WriteObjectBlock(*Writer, TEXT("metadata"), MetadataJson);
+    Writer->WriteObjectEnd();
+    Writer->Close();
+
+    return Json;
+}
+
+void FAegisBinarySnapshot::WriteEntityJson(FAegisJsonWriter& Writer, const FAegisSnapshotEntity& Entity) const
+{
+    Writer.WriteObjectStart();
+    Writer.WriteValue(TEXT("guid"), GetString(Entity.GUID));
+    Writer.WriteValue(TEXT("class"), GetString(Entity.Class));
+    Writer.WriteValue(TEXT("path"), GetString(Entity.Path));
+    Writer.WriteValue(TEXT("name"), GetString(Entity.Name));
+
+    if (Entity.ParentGUID != INDEX_NONE)
+    {
+        Writer.WriteValue(TEXT("parentGuid"), GetString(Entity.ParentGUID));
+    }
+
+    if (Entity.bHasTransform)
+    {
+        AegisJson::WriteTransform(Writer, TEXT("transform"), FVector(Entity.Location), FRotator(Entity.Rotation), FVector(Entity.Scale));
+    }
+
+    WriteObjectBlock(Writer, TEXT("properties"), Entity.PropertiesJson);
+
+    Writer.WriteArrayStart(TEXT("components"));
+    for (const FAegisSnapshotComponent& Component : Entity.Components)
+    {
+        Writer.WriteObjectStart();
+        Writer.WriteValue(TEXT("guid"), GetString(Component.GUID));
+        Writer.WriteValue(TEXT("class"), GetString(Component.Class));
+        Writer.WriteValue(TEXT("name"), GetString(Component.Name));
+        WriteObjectBlock(Writer, TEXT("properties"), Component.PropertiesJson);
+        Writer.WriteObjectEnd();
+    }
+    Writer.WriteArrayEnd();
+
+    Writer.WriteArrayStart(TEXT("references"));
+    for (const FAegisSnapshotReference& Reference : Entity.References)
+    {
+        Writer.WriteObjectStart();
+        Writer.WriteValue(TEXT("propertyName"), GetString(Reference.PropertyName));
+        Writer.WriteValue(TEXT("targetGuid"), GetString(Reference.TargetGUID));
+        Writer.WriteValue(TEXT("targetPath"), GetString(Reference.TargetPath));
+        Writer.WriteObjectEnd();
+    }
+    Writer.WriteArrayEnd();
+
+    Writer.WriteArrayStart(TEXT("tags"));
+    for (int32 Tag : Entity.Tags)
+    {
+        Writer.WriteValue(GetString(Tag));
+    }
+    Writer.WriteArrayEnd();
+
+    Writer.WriteObjectEnd();
+}
+
+FAegisSnapshotEntity& FAegisBinarySnapshot::AddEntityFrom(const FAegisBinarySnapshot& Source, const FAegisSnapshotEntity& Entity)
+{
+    auto Remap = [this, &Source](int32 Index)
+    {
+        return AddString(Source.GetString(Index));
+    };
+
+    FAegisSnapshotEntity& Copy = Entities.Add_GetRef(Entity);
+    Copy.GUID = Remap(Entity.GUID);
+    Copy.Class = Remap(Entity.Class);
+    Copy.Path = Remap(Entity.Path);
+    Copy.Name = Remap(Entity.Name);
+    Copy.ParentGUID = Remap(Entity.ParentGUID);
+
+    for (int32& Tag : Copy.Tags)
+    {
+        Tag = Remap(Tag);
+    }
+
+    for (FAegisSnapshotComponent& Component : Copy.Components)
+    {
+        Component.GUID = Remap(Component.GUID);
+        Component.Class = Remap(Component.Class);
+        Component.Name = Remap(Component.Name);
+    }
+
+    for (FAegisSnapshotReference& Reference : Copy.References)
+    {
+        Reference.PropertyName = Remap(Reference.PropertyName);
+        Reference.TargetGUID = Remap(Reference.TargetGUID);
+        Reference.TargetPath = Remap(Reference.TargetPath);
+    }
+
+    return Copy;
+}
+
+const FString& FAegisBinarySnapshot::GetEntityKey(const FAegisSnapshotEntity& Entity) const
+{
+    return Entity.GUID != INDEX_NONE ? GetString(Entity.GUID) : GetString(Entity.Path);
+}
@@ -0,0 +1,707 @@
+// Copyright AEGIS Team. All Rights Reserved.
+
+#include "AegisJobManager.h"
+#include "AegisActorCapture.h"
+#include "AegisAssetIndex.h"
+#include "AegisBridgeModule.h"
+#include "AegisLandscapeCapture.h"
+#include "AegisRemoteControlHandler.h"
+#include "AegisSeedSubsystem.h"
+#include "AegisSubsystem.h"
+#include "AegisWorldRestore.h"
+#include "Editor.h"
+#include "Engine/Blueprint.h"
+#include "Engine/Level.h"
+#include "Engine/StreamableManager.h"
+#include "EngineUtils.h"
+#include "Kismet2/CompilerResultsLog.h"
+#include "Kismet2/KismetEditorUtilities.h"
+#include "LandscapeProxy.h"
+#include "Tasks/Task.h"
+
+namespace
+{
+    /** Actors visited between budget checks while gathering */
+    constexpr int32 GatherCheckInterval = 256;
+
+    // ========================================================================
+    // CaptureAllActors
+    // ========================================================================
+
+    /**
+     * CaptureAllActors in slices: matching actors are gathered level by level under the
+     * budget, then written a chunk at a time. Every chunk is streamed as job.chunk
+     * {offset, actors[]} and the result is the same {"actors":[...]} document the
+     * synchronous route returns.
+     */
+    class FAegisCaptureActorsJob : public FAegisJob
+    {
+    public:
+        FAegisCaptureActorsJob(const TArray<FString>& ClassFilter, const TArray<FString>& TagFilter, int32 InChunkSize)
+            : Query(UAegisSeedSubsystem::MakeCaptureQuery(ClassFilter, TagFilter))
+            , ChunkSize(InChunkSize)
+        {
+        }
+
+        virtual void Step(FAegisJobContext& Context) override
+        {
+            UAegisSeedSubsystem* Seed = UAegisSeedSubsystem::Get();
+            UWorld* World = GEditor ? GEditor->GetEditorWorldContext().World() : nullptr;
+            if (!Seed || !World)
+            {
+                Context.Fail(TEXT("No editor world available"));
+                return;
+            }
+
+            if (!bGathered)
+            {
+                if (!Gather(*World, Context))
+                {
+                    Context.SetProgress(0, 0, TEXT("gathering"));
+                    return;
+                }
+                bGathered = true;
+                Context.SetProgress(0, Actors.Num(), TEXT("capturing"));
+            }
+
+            while (NextIndex < Actors.Num() && !Context.ShouldYield())
+            {
+                WriteChunk(*Seed, Context);
+            }
+
+            if (NextIndex >= Actors.Num())
+            {
+                Context.Succeed(FString::Printf(TEXT("{\"actors\":[%s]}"), *Body));
+            }
+        }
+
+    private:
+        /** Collect matching actors from the visible levels, resuming where the last step stopped. False when the budget ran out first. */
+        bool Gather(UWorld& World, FAegisJobContext& Context)
+        {
+            const TArray<ULevel*>& Levels = World.GetLevels();
+
+            int32 SinceCheck = 0;
+            for (; LevelIndex < Levels.Num(); ++LevelIndex, ActorIndex = 0)
+            {
+                const ULevel* Level = Levels[LevelIndex];
+                if (!Level || !Level->bIsVisible)
+                {
+                    continue;
+                }
+
+                for (; ActorIndex < Level->Actors.Num(); ++ActorIndex)
+                {
+                    if (++SinceCheck >= GatherCheckInterval)
+                    {
+                        SinceCheck = 0;
+                        if (Context.ShouldYield())
+                        {
+                            return false;
+                        }
+                    }
+
+                    AActor* Actor = Level->Actors[ActorIndex];
+                    if (IsValid(Actor) && Query.Matches(Actor))
+                    {
+                        Actors.Add(Actor);
+                    }
+                }
+            }
+            return true;
+        }
+
+        void WriteChunk(UAegisSeedSubsystem& Seed, FAegisJobContext& Context)
+        {
+            const int32 Offset = NextIndex;
+            const int32 End = FMath::Min(Offset + ChunkSize, Actors.Num());
+
+            TArray<AActor*> ChunkActors;
+            ChunkActors.Reserve(End - Offset);
+            for (; NextIndex < End; ++NextIndex)
+            {
+                ChunkActors.Add(Actors[NextIndex].Get());
+            }
+
+            // Actors deleted since the gather are skipped; the chunk is encoded across workers
+            FAegisActorCapture Capture;
+            Capture.Gather(ChunkActors);
+
+            TArray<int32> Indices;
+            Capture.GetAllIndices(Indices);
+            const FString ChunkJson = Capture.EncodeArray(Indices, Seed.GetGUIDRegistry());
+
+            Context.EmitChunk([Offset, &ChunkJson](FAegisJsonWriter& ChunkWriter)
+            {
+                ChunkWriter.WriteObjectStart();
+                ChunkWriter.WriteValue(TEXT("offset"), Offset);
+                AegisJson::WriteRawJson(ChunkWriter, TEXT("actors"), ChunkJson);
+                ChunkWriter.WriteObjectEnd();
+            });
+
+            // Append the chunk's elements to the result without re-encoding them
+            if (ChunkJson.Len() > 2)
+            {
+                if (!Body.IsEmpty())
+                {
+                    Body.AppendChar(TCHAR(','));
+                }
+                Body.Append(*ChunkJson + 1, ChunkJson.Len() - 2);
+            }
+
+            Context.SetProgress(NextIndex, Actors.Num());
+        }
+
+    private:
+        FAegisActorQuery Query;
+        int32 ChunkSize;
+
+        /** Gather position: level and actor index within it */
+        int32 LevelIndex = 0;
+        int32 ActorIndex = 0;
+        bool bGathered = false;
+
+        TArray<TWeakObjectPtr<AActor>> Actors;
+        int32 NextIndex = 0;
+
+        /** Comma-separated actor objects written so far */
+        FString Body;
+    };
+
+    // ========================================================================
+    // SearchAssets
+    // ========================================================================
+
+    /**
+     * One page of the asset index, the same page cap and cursor as the SearchAssets route.
+     * The index lookup and the page encoding run on a worker; Step only polls for completion.
+     */
+    class FAegisSearchAssetsJob : public FAegisJob
+    {
+    public:
+        explicit FAegisSearchAssetsJob(FAegisAssetSearchParams InSearchParams)
+            : SearchParams(MoveTemp(InSearchParams))
+            , Result(MakeShared<FAegisCommandResult, ESPMode::ThreadSafe>())
+        {
+        }
+
+        virtual void Step(FAegisJobContext& Context) override
+        {
+            if (!Task.IsValid())
+            {
+                Task = UE::Tasks::Launch(UE_SOURCE_LOCATION, [SearchParams = SearchParams, Result = Result]()
+                {
+                    *Result = UAegisSubsystem::SearchAssetIndex(SearchParams);
+                });
+                Context.SetProgress(0, 1, TEXT("searching"));
+                return;
+            }
+
+            if (!Task.IsCompleted())
+            {
+                return;
+            }
+
+            Context.SetProgress(1, 1);
+            if (Result->bSuccess)
+            {
+                Context.Succeed(MoveTemp(Result->Data));
+            }
+            else
+            {
+                Context.Fail(Result->Message);
+            }
+        }
+
+    private:
+        FAegisAssetSearchParams SearchParams;
+        TSharedRef<FAegisCommandResult, ESPMode::ThreadSafe> Result;
+        UE::Tasks::FTask Task;
+    };
+
+    // ========================================================================
+    // CaptureLandscape
+    // ========================================================================
+
+    /**
+     * CaptureLandscape one landscape proxy at a time. Each proxy is streamed as job.chunk
+     * {offset, landscapes[]} as soon as it is captured; the tile blob, when requested, is
+     * compressed and written on a worker. The result is the synchronous route's document.
+     */
+    class FAegisCaptureLandscapeJob : public FAegisJob
+    {
+    public:
+        explicit FAegisCaptureLandscapeJob(FAegisLandscapeCaptureOptions InOptions)
+            : Options(MoveTemp(InOptions))
+            , TileData(MakeShared<FTileData, ESPMode::ThreadSafe>())
+        {
+        }
+
+        virtual void Step(FAegisJobContext& Context) override
+        {
+            UAegisSeedSubsystem* Seed = UAegisSeedSubsystem::Get();
+            UWorld* World = GEditor ? GEditor->GetEditorWorldContext().World() : nullptr;
+            if (!Seed || !World)
+            {
+                Context.Fail(TEXT("No editor world available"));
+                return;
+            }
+
+            if (!bGathered)
+            {
+                for (TActorIterator<ALandscapeProxy> It(World); It; ++It)
+                {
+                    Landscapes.Add(*It);
+                }
+                bGathered = true;
+                Context.SetProgress(0, Landscapes.Num(), TEXT("capturing"));
+            }
+
+            // A proxy is read in one piece; the budget is checked between proxies
+            while (NextIndex < Landscapes.Num() && !Context.ShouldYield())
+            {
+                CaptureNext(*Seed, Context);
+            }
+            if (NextIndex < Landscapes.Num())
+            {
+                return;
+            }
+
+            if (!Options.TileDataPath.IsEmpty())
+            {
+                if (!SaveTask.IsValid())
+                {
+                    SaveTask = UE::Tasks::Launch(UE_SOURCE_LOCATION, [Options = Options, TileData = TileData]()
+                    {
+                        TileData->bSaved = UAegisSeedSubsystem::SaveLandscapeTileBlob(Options, TileData->Blob);
+                    });
+                    Context.SetProgress(NextIndex, Landscapes.Num(), TEXT("saving"));
+                    return;
+                }
+                if (!SaveTask.IsCompleted())
+                {
+                    return;
+                }
+            }
+
+            FString ResultJson;
+            TSharedRef<FAegisJsonWriter> Writer = FAegisJsonWriterFactory::Create(&ResultJson);
+            Writer->WriteObjectStart();
+            AegisJson::WriteRawJson(*Writer, TEXT("landscapes"), FString::Printf(TEXT("[%s]"), *Body));
+            if (!Options.TileDataPath.IsEmpty())
+            {
+                UAegisSeedSubsystem::WriteLandscapeTileData(*Writer, Options, TileData->Blob, TileData->bSaved);
+            }
+            Writer->WriteObjectEnd();
+            Writer->Close();
+
+            Context.Succeed(MoveTemp(ResultJson));
+        }
+
+    private:
+        struct FTileData
+        {
+            FAegisLandscapeTileBlob Blob;
+            bool bSaved = false;
+        };
+
+        void CaptureNext(UAegisSeedSubsystem& Seed, FAegisJobContext& Context)
+        {
+            const int32 Offset = NextIndex++;
+            ALandscapeProxy* Landscape = Landscapes[Offset].Get();
+            if (!Landscape)
+            {
+                return;
+            }
+
+            FString LandscapeJson;
+            TSharedRef<FAegisJsonWriter> Writer = FAegisJsonWriterFactory::Create(&LandscapeJson);
+            Seed.WriteLandscape(*Writer, Landscape, Options, TileData->Blob);
+            Writer->Close();
+
+            Context.EmitChunk([Offset, &LandscapeJson](FAegisJsonWriter& ChunkWriter)
+            {
+                ChunkWriter.WriteObjectStart();
+                ChunkWriter.WriteValue(TEXT("offset"), Offset);
+                AegisJson::WriteRawJson(ChunkWriter, TEXT("landscapes"), FString::Printf(TEXT("[%s]"), *LandscapeJson));
+                ChunkWriter.WriteObjectEnd();
+            });
+
+            if (!Body.IsEmpty())
+            {
+                Body.AppendChar(TCHAR(','));
+            }
+            Body.Append(LandscapeJson);
+
+            Context.SetProgress(NextIndex, Landscapes.Num());
+        }
+
+    private:
+        FAegisLandscapeCaptureOptions Options;
+
+        bool bGathered = false;
+        TArray<TWeakObjectPtr<ALandscapeProxy>> Landscapes;
+        int32 NextIndex = 0;
+
+        /** Comma-separated landscape objects written so far */
+        FString Body;
+
+        /** Shared with the save task, which may outlive a cancelled job */
+        TSharedRef<FTileData, ESPMode::ThreadSafe> TileData;
+        UE::Tasks::FTask SaveTask;
+    };
+
+    // ========================================================================
+    // CompileBlueprint
+    // ========================================================================
+
+    /**
+     * CompileBlueprint for one or more Blueprints. Unloaded Blueprints are requested as one
+     * async batch through FStreamableManager; each is then compiled in its own slice, with the
+     * budget checked between compiles, and streamed as job.chunk {path, hasErrors, numErrors,
+     * numWarnings}. The result lists every Blueprint with the error and warning totals.
+     */
+    class FAegisCompileBlueprintsJob : public FAegisJob
+    {
+    public:
+        explicit FAegisCompileBlueprintsJob(TArray<FSoftObjectPath> InPaths)
+            : Paths(MoveTemp(InPaths))
+        {
+        }
+
+        virtual void Step(FAegisJobContext& Context) override
+        {
+            if (!bLoadRequested)
+            {
+                bLoadRequested = true;
+                LoadHandle = StreamableManager.RequestAsyncLoad(Paths, FStreamableDelegate(), FStreamableManager::AsyncLoadHighPriority);
+                Context.SetProgress(0, Paths.Num(), TEXT("loading"));
+            }
+
+            if (LoadHandle.IsValid() && !LoadHandle->HasLoadCompleted())
+            {
+                return;
+            }
+
+            while (NextIndex < Paths.Num() && !Context.ShouldYield())
+            {
+                CompileNext(Context);
+            }
+            if (NextIndex < Paths.Num())
+            {
+                return;
+            }
+
+            LoadHandle.Reset();
+            Context.Succeed(FString::Printf(TEXT("{\"blueprints\":[%s],\"numErrors\":%d,\"numWarnings\":%d,\"hasErrors\":%s}"),
+                *Body, TotalErrors, TotalWarnings, TotalErrors > 0 ? TEXT("true") : TEXT("false")));
+        }
+
+        virtual void Cancel() override
+        {
+            if (LoadHandle.IsValid())
+            {
+                LoadHandle->CancelHandle();
+                LoadHandle.Reset();
+            }
+        }
+
+    private:
+        void CompileNext(FAegisJobContext& Context)
+        {
+            const FSoftObjectPath& Path = Paths[NextIndex++];
+
+            FString Entry;
+            TSharedRef<FAegisJsonWriter> Writer = FAegisJsonWriterFactory::Create(&Entry);
+            Writer->WriteObjectStart();
+            Writer->WriteValue(TEXT("path"), Path.ToString());
+
+            UBlueprint* Blueprint = Cast<UBlueprint>(Path.ResolveObject());
+            if (Blueprint)
+            {
+                FCompilerResultsLog Results;
+                FKismetEditorUtilities::CompileBlueprint(Blueprint, EBlueprintCompileOptions::None, &Results);
+                TotalErrors += Results.NumErrors;
+                TotalWarnings += Results.NumWarnings;
+
+                Writer->WriteValue(TEXT("hasErrors"), Results.NumErrors > 0);
+                Writer->WriteValue(TEXT("numErrors"), Results.NumErrors);
+                Writer->WriteValue(TEXT("numWarnings"), Results.NumWarnings);
+            }
+            else
+            {
+                ++TotalErrors;
+                Writer->WriteValue(TEXT("hasErrors"), true);
+                Writer->WriteValue(TEXT("error"), FString::Printf(TEXT("Blueprint not found: %s"), *Path.ToString()));
+            }
+
+            Writer->WriteObjectEnd();
+            Writer->Close();
+
+            Context.EmitChunk([&Entry](FAegisJsonWriter& ChunkWriter)
+            {
+                ChunkWriter.WriteRawJSONValue(Entry);
+            });
+
+            if (!Body.IsEmpty())
+            {
+                Body.AppendChar(TCHAR(','));
+            }
+            Body.Append(Entry);
+
+            Context.SetProgress(NextIndex, Paths.Num(), TEXT("compiling"));
+        }
+
+    private:
+        TArray<FSoftObjectPath> Paths;
+
+        FStreamableManager StreamableManager;
+        TSharedPtr<FStreamableHandle> LoadHandle;
+        bool bLoadRequested = false;
+
+        int32 NextIndex = 0;
+        int32 TotalErrors = 0;
+        int32 TotalWarnings = 0;
+
+        /** Comma-separated per-Blueprint objects written so far */
+        FString Body;
+    };
+
+    // ========================================================================
+    // RestoreWorldState
+    // ========================================================================
+
+    /**
+     * Staged restore. The snapshot is decoded on a worker, then FAegisWorldRestore resolves
+     * classes and spawns and constructs actors a frame budget at a time.
+     */
+    class FAegisRestoreJob : public FAegisJob
+    {
+    public:
+        /** Decode Source on a worker: entities JSON, or a snapshot file path when bFromFile */
+        FAegisRestoreJob(FString InSource, bool bInFromFile, bool bInPreserveGUIDs, bool bInReplace)
+            : Source(MoveTemp(InSource))
+            , bFromFile(bInFromFile)
+            , bPreserveGUIDs(bInPreserveGUIDs)
+            , bReplace(bInReplace)
+            , Decoded(MakeShared<FDecodedSnapshot, ESPMode::ThreadSafe>())
+        {
+        }
+
+        virtual void Step(FAegisJobContext& Context) override
+        {
+            if (!Restore.IsValid())
+            {
+                if (!DecodeTask.IsValid())
+                {
+                    LaunchDecode();
+                    Context.SetProgress(0, 0, TEXT("decoding"));
+                    return;
+                }
+                if (!DecodeTask.IsCompleted())
+                {
+                    return;
+                }
+                if (!Decoded->bSuccess)
+                {
+                    Context.Fail(bFromFile ? FString::Printf(TEXT("Failed to load binary snapshot: %s"), *Source) : TEXT("Failed to parse entities JSON"));
+                    return;
+                }
+
+                UWorld* World = GEditor ? GEditor->GetEditorWorldContext().World() : nullptr;
+                if (!World)
+                {
+                    Context.Fail(TEXT("No editor world available"));
+                    return;
+                }
+                Restore = MakeUnique<FAegisWorldRestore>(World, MoveTemp(Decoded->Snapshot), bPreserveGUIDs);
+                if (bReplace)
+                {
+                    UAegisSeedSubsystem* Seed = UAegisSeedSubsystem::Get();
+                    if (!Seed)
+                    {
+                        Context.Fail(TEXT("AEGIS seed subsystem not available"));
+                        return;
+                    }
+                    Restore->SetReplacedActors(Seed->GetTrackedActors(World));
+                }
+            }
+
+            const bool bDone = Restore->Advance(Context.GetDeadline());
+
+            int64 Done = 0;
+            int64 Total = 0;
+            Restore->GetProgress(Done, Total);
+            Context.SetProgress(Done, Total, Restore->GetStageName());
+
+            if (!bDone)
+            {
+                return;
+            }
+
+            if (Restore->WasAborted())
+            {
+                Context.Fail(TEXT("The editor world changed during the restore"));
+                return;
+            }
+
+            UE_LOG(LogAegisBridge, Log, TEXT("Restored %d of %d entities"), Restore->GetRestoredCount(), Restore->GetEntityCount());
+            Context.Succeed(FString::Printf(TEXT("{\"success\":true,\"restoredCount\":%d,\"entityCount\":%d,\"missingClassCount\":%d}"),
+                Restore->GetRestoredCount(), Restore->GetEntityCount(), Restore->GetMissingClassCount()));
+        }
+
+        virtual void Cancel() override
+        {
+            if (Restore.IsValid())
+            {
+                Restore->Cancel();
+            }
+        }
+
+    private:
+        struct FDecodedSnapshot
+        {
+            FAegisBinarySnapshot Snapshot;
+            bool bSuccess = false;
+        };
+
+        void LaunchDecode()
+        {
+            DecodeTask = UE::Tasks::Launch(UE_SOURCE_LOCATION, [Source = Source, bFromFile = bFromFile, Decoded = Decoded]()
+            {
+                Decoded->bSuccess = bFromFile
+                    ? FAegisWorldRestore::LoadSnapshotFile(Source, Decoded->Snapshot)
+                    : Decoded->Snapshot.FromJson(Source);
+            });
+        }
+
+    private:
+        FString Source;
+        bool bFromFile;
+        bool bPreserveGUIDs;
+        bool bReplace;
+
+        TSharedRef<FDecodedSnapshot, ESPMode::ThreadSafe> Decoded;
+        UE::Tasks::FTask DecodeTask;
+
+        TUniquePtr<FAegisWorldRestore> Restore;
+    };
+
+    /** MergeMode of a restore job, "merge" when absent */
+    bool ParseRestoreMergeMode(const FAegisRequestParams& Args, bool& bOutReplace, FString& OutError)
+    {
+        const FString MergeMode = Args.GetString(TEXT("MergeMode"), TEXT("merge"));
+        if (!UAegisSeedSubsystem::ParseMergeMode(MergeMode, bOutReplace))
+        {
+            OutError = FString::Printf(TEXT("Unknown merge mode: %s"), *MergeMode);
+            return false;
+        }
+        return true;
+    }
+}
+
+void RegisterAegisBridgeJobs(UAegisJobManager& Manager)
+{
+    Manager.RegisterJobKind(TEXT("CaptureAllActors"), [](const FAegisRequestParams& Params, FString& OutError) -> TUniquePtr<FAegisJob>
+    {
+        const FAegisRequestParams Args = Params.GetNested(TEXT("Params"));
+        return MakeUnique<FAegisCaptureActorsJob>(
+            Args.GetStringArray(TEXT("ClassFilter")),
+            Args.GetStringArray(TEXT("TagFilter")),
+            FMath::Clamp(Args.GetInt(TEXT("ChunkSize"), 500), 1, 10000));
+    });
+
+    Manager.RegisterJobKind(TEXT("SearchAssets"), [](const FAegisRequestParams& Params, FString& OutError) -> TUniquePtr<FAegisJob>
+    {
+        const FAegisRequestParams Args = Params.GetNested(TEXT("Params"));
+
+        FAegisAssetSearchParams SearchParams;
+        SearchParams.Query = Args.GetString(TEXT("SearchQuery"));
+        SearchParams.bPrefix = Args.GetBool(TEXT("bPrefix"));
+        SearchParams.ClassNames = Args.GetStringArray(TEXT("AssetTypes"));
+        const FString AssetType = Args.GetString(TEXT("AssetType"));
+        if (!AssetType.IsEmpty())
+        {
+            SearchParams.ClassNames.Add(AssetType);
+        }
+        SearchParams.Path = Args.GetString(TEXT("Path"));
+        SearchParams.Cursor = Args.GetString(TEXT("Cursor"));
+        SearchParams.Limit = Args.GetInt(TEXT("Limit"));
+
+        return MakeUnique<FAegisSearchAssetsJob>(MoveTemp(SearchParams));
+    });
+
+    Manager.RegisterJobKind(TEXT("CaptureLandscape"), [](const FAegisRequestParams& Params, FString& OutError) -> TUniquePtr<FAegisJob>
+    {
+        const FAegisRequestParams Args = Params.GetNested(TEXT("Params"));
+
+        FAegisLandscapeCaptureOptions Options;
+        Options.bIncludeHeightmap = Args.GetBool(TEXT("bIncludeHeightmap"));
+        Options.bIncludeLayers = Args.GetBool(TEXT("bIncludeLayers"));
+        Options.KnownTiles = Args.GetStringMap(TEXT("KnownTiles"));
+        Options.TileDataPath = Args.GetString(TEXT("TileDataPath"));
+        Options.Codec = Args.GetString(TEXT("Codec"), Options.Codec);
+
+        return MakeUnique<FAegisCaptureLandscapeJob>(MoveTemp(Options));
+    });
+
+    // {BlueprintPath} or {BlueprintPaths: [...]}
+    Manager.RegisterJobKind(TEXT("CompileBlueprint"), [](const FAegisRequestParams& Params, FString& OutError) -> TUniquePtr<FAegisJob>
+    {
+        const FAegisRequestParams Args = Params.GetNested(TEXT("Params"));
+
+        TArray<FString> PathStrings = Args.GetStringArray(TEXT("BlueprintPaths"));
+        const FString BlueprintPath = Args.GetString(TEXT("BlueprintPath"));
+        if (!BlueprintPath.IsEmpty())
+        {
+            PathStrings.Add(BlueprintPath);
+        }
+
+        TArray<FSoftObjectPath> Paths;
+        for (const FString& PathString : PathStrings)
+        {
+            FSoftObjectPath Path(PathString);
+            if (!Path.IsValid())
+            {
+                OutError = FString::Printf(TEXT("Invalid Blueprint path: %s"), *PathString);
+                return nullptr;
+            }
+            Paths.AddUnique(MoveTemp(Path));
+        }
+        if (Paths.Num() == 0)
+        {
+            OutError = TEXT("BlueprintPath or BlueprintPaths is required");
+            return nullptr;
+        }
+
+        return MakeUnique<FAegisCompileBlueprintsJob>(MoveTemp(Paths));
+    });
+
+    Manager.RegisterJobKind(TEXT("RestoreWorldState"), [](const FAegisRequestParams& Params, FString& OutError) -> TUniquePtr<FAegisJob>
+    {
+        const FAegisRequestParams Args = Params.GetNested(TEXT("Params"));
+        bool bReplace = false;
+        if (!ParseRestoreMergeMode(Args, bReplace, OutError))
+        {
+            return nullptr;
+        }
+        return MakeUnique<FAegisRestoreJob>(Args.GetJsonString(TEXT("Entities"), TEXT("[]")), false, Args.GetBool(TEXT("bPreserveGUIDs"), true), bReplace);
+    });
+
+    Manager.RegisterJobKind(TEXT("RestoreWorldStateFromFile"), [](const FAegisRequestParams& Params, FString& OutError) -> TUniquePtr<FAegisJob>
+    {
+        const FAegisRequestParams Args = Params.GetNested(TEXT("Params"));
+        const FString InputPath = Args.GetString(TEXT("InputPath"));
+        if (InputPath.IsEmpty())
+        {
+            OutError = TEXT("InputPath is required");
+            return nullptr;
+        }
+        bool bReplace = false;
+        if (!ParseRestoreMergeMode(Args, bReplace, OutError))
+        {
+            return nullptr;
+        }
+        return MakeUnique<FAegisRestoreJob>(InputPath, true, Args.GetBool(TEXT("bPreserveGUIDs"), true), bReplace);
+    });
+}
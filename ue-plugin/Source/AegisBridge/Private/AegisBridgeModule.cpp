@@ -1,6 +1,7 @@
 // Copyright AEGIS Team. All Rights Reserved.
 
 #include "AegisBridgeModule.h"
+#include "AegisChangeJournal.h"
 #include "AegisRemoteControlHandler.h"
 #include "AegisWebSocketServer.h"
 #include "AegisSubsystem.h"
@@ -10,6 +11,10 @@
 #include "LevelEditor.h"
 #include "Engine/World.h"
 #include "GameFramework/Actor.h"
+#include "Misc/CoreDelegates.h"
+#include "Misc/Paths.h"
+#include "Misc/TransactionObjectEvent.h"
+#include "UObject/UObjectGlobals.h"
 #include "RemoteControlSettings.h"
 #include "IRemoteControlModule.h"
 
@@ -29,7 +34,8 @@ void FAegisBridgeModule::StartupModule()
 
     // Load configuration
     HttpServerPort = GetDefault<URemoteControlSettings>()->RemoteControlHttpServerPort;
-    WebSocketServerPort = GetDefault<URemoteControlSettings>()->RemoteControlWebSocketServerPort;
+    // The Remote Control plugin serves its own WebSocket port; the AEGIS event server sits next to it
+    WebSocketServerPort = GetDefault<URemoteControlSettings>()->RemoteControlWebSocketServerPort + 1;
 
     // Override with AEGIS-specific ports if configured
     if (GConfig)
@@ -60,6 +66,9 @@ void FAegisBridgeModule::ShutdownModule()
     // Unregister delegates
     UnregisterEditorDelegates();
 
+    UAegisRemoteControlHandler::Get()->Shutdown();
+    UAegisWebSocketServer::Get()->Shutdown();
+
     UE_LOG(LogAegisBridge, Log, TEXT("AEGIS Bridge Module shut down"));
 }
 
@@ -74,16 +83,15 @@ void FAegisBridgeModule::InitializeRemoteControlServer()
 
 void FAegisBridgeModule::InitializeWebSocketServer()
 {
-    // WebSocket server is also managed by Remote Control
-    // We extend it with AEGIS-specific handlers
-
-    UE_LOG(LogAegisBridge, Log, TEXT("WebSocket server initialized"));
+    // Event stream to MCP clients, separate from the Remote Control WebSocket API
+    UAegisWebSocketServer::Get()->Initialize(WebSocketServerPort);
 }
 
 void FAegisBridgeModule::RegisterRemoteControlEndpoints()
 {
     // Register AEGIS-specific function handlers
     // These will be called via Remote Control API
+    UAegisRemoteControlHandler::Get()->Initialize();
 
     UE_LOG(LogAegisBridge, Log, TEXT("AEGIS Remote Control endpoints registered"));
 }
@@ -97,20 +105,47 @@ void FAegisBridgeModule::RegisterEditorDelegates()
     }
 
     // Level loaded
-    FEditorDelegates::OnMapOpened.AddRaw(this, &FAegisBridgeModule::OnLevelLoaded);
+    LevelLoadedHandle = FEditorDelegates::OnMapOpened.AddRaw(this, &FAegisBridgeModule::OnLevelLoaded);
+
+    // Streaming levels keep the actor index current without a full rebuild
+    LevelAddedHandle = FWorldDelegates::LevelAddedToWorld.AddRaw(this, &FAegisBridgeModule::OnLevelAddedToWorld);
+    LevelRemovedHandle = FWorldDelegates::LevelRemovedFromWorld.AddRaw(this, &FAegisBridgeModule::OnLevelRemovedFromWorld);
+    ActorLabelChangedHandle = FCoreDelegates::OnActorLabelChanged.AddRaw(this, &FAegisBridgeModule::OnActorLabelChanged);
+
+    // Undo/redo can resurrect or remove actors without add/delete notifications
+    PostUndoRedoHandle = FEditorDelegates::PostUndoRedo.AddRaw(this, &FAegisBridgeModule::OnPostUndoRedo);
+
+    // Play state is part of the editor context
+    PIEStartedHandle = FEditorDelegates::PostPIEStarted.AddRaw(this, &FAegisBridgeModule::OnPlayModeChanged);
+    PIEShutdownHandle = FEditorDelegates::ShutdownPIE.AddRaw(this, &FAegisBridgeModule::OnPlayModeChanged);
+
+    // Property edits and transactions feed the change journal
+    ObjectPropertyChangedHandle = FCoreUObjectDelegates::OnObjectPropertyChanged.AddRaw(this, &FAegisBridgeModule::OnObjectPropertyChanged);
+    ObjectTransactedHandle = FCoreUObjectDelegates::OnObjectTransacted.AddRaw(this, &FAegisBridgeModule::OnObjectTransacted);
 
     // Actor spawned/deleted
     if (GEngine)
     {
         ActorSpawnedHandle = GEngine->OnLevelActorAdded().AddRaw(this, &FAegisBridgeModule::OnActorSpawned);
         ActorDeletedHandle = GEngine->OnLevelActorDeleted().AddRaw(this, &FAegisBridgeModule::OnActorDeleted);
+        ActorMovedHandle = GEngine->OnActorMoved().AddRaw(this, &FAegisBridgeModule::OnActorMoved);
     }
 
+    // Asset registry events keep the asset search index current
+    AssetIndex.Initialize();
+
+    // Property plans hold raw property pointers and offsets, which these invalidate
+    ReloadCompleteHandle = FCoreUObjectDelegates::ReloadCompleteDelegate.AddLambda([this](EReloadCompleteReason)
+    {
+        OnClassLayoutsChanged();
+    });
+
     // Selection changed
     if (GEditor)
     {
         SelectionChangedHandle = GEditor->GetSelectedActors()->SelectionChangedEvent.AddRaw(
             this, &FAegisBridgeModule::OnSelectionChanged);
+        BlueprintCompiledHandle = GEditor->OnBlueprintCompiled().AddRaw(this, &FAegisBridgeModule::OnClassLayoutsChanged);
     }
 
     UE_LOG(LogAegisBridge, Log, TEXT("Editor delegates registered"));
@@ -118,33 +153,68 @@ void FAegisBridgeModule::RegisterEditorDelegates()
 
 void FAegisBridgeModule::UnregisterEditorDelegates()
 {
-    FEditorDelegates::OnMapOpened.RemoveAll(this);
+    FEditorDelegates::OnMapOpened.Remove(LevelLoadedHandle);
+    FEditorDelegates::PostUndoRedo.Remove(PostUndoRedoHandle);
+    FEditorDelegates::PostPIEStarted.Remove(PIEStartedHandle);
+    FEditorDelegates::ShutdownPIE.Remove(PIEShutdownHandle);
+    FWorldDelegates::LevelAddedToWorld.Remove(LevelAddedHandle);
+    FWorldDelegates::LevelRemovedFromWorld.Remove(LevelRemovedHandle);
+    FCoreDelegates::OnActorLabelChanged.Remove(ActorLabelChangedHandle);
+    FCoreUObjectDelegates::OnObjectPropertyChanged.Remove(ObjectPropertyChangedHandle);
+    FCoreUObjectDelegates::OnObjectTransacted.Remove(ObjectTransactedHandle);
 
     if (GEngine)
     {
         GEngine->OnLevelActorAdded().Remove(ActorSpawnedHandle);
         GEngine->OnLevelActorDeleted().Remove(ActorDeletedHandle);
+        GEngine->OnActorMoved().Remove(ActorMovedHandle);
     }
 
+    FCoreUObjectDelegates::ReloadCompleteDelegate.Remove(ReloadCompleteHandle);
+
     if (GEditor)
     {
         GEditor->GetSelectedActors()->SelectionChangedEvent.Remove(SelectionChangedHandle);
+        GEditor->OnBlueprintCompiled().Remove(BlueprintCompiledHandle);
     }
+
+    ActorIndex.Reset();
+    PropertyPlans.Reset();
+    EditorContext.Reset();
+    AssetIndex.Shutdown();
 }
 
-void FAegisBridgeModule::OnLevelLoaded(UWorld* World, const FString& LevelName)
+void FAegisBridgeModule::OnLevelLoaded(const FString& Filename, bool bAsTemplate)
 {
+    const FString LevelName = FPaths::GetBaseFilename(Filename);
+    UWorld* World = GEditor ? GEditor->GetEditorWorldContext().World() : nullptr;
+
     UE_LOG(LogAegisBridge, Verbose, TEXT("Level loaded: %s"), *LevelName);
 
-    // Broadcast to WebSocket clients
-    if (UAegisWebSocketServer* WsServer = UAegisWebSocketServer::Get())
+    // New map: rebuild the actor index lazily on first lookup
+    ActorIndex.Invalidate();
+    EditorContext.OnMapOpened();
+
+    // Clients synchronized against the previous map must recapture
+    if (UAegisChangeJournal* Journal = UAegisChangeJournal::Get())
     {
-        TSharedPtr<FJsonObject> EventData = MakeShareable(new FJsonObject());
-        EventData->SetStringField(TEXT("levelName"), LevelName);
-        EventData->SetStringField(TEXT("worldName"), World ? World->GetName() : TEXT(""));
+        Journal->Reset();
+    }
 
-        WsServer->BroadcastEvent(TEXT("world.level.changed"), EventData);
+    // Broadcast to WebSocket clients; changes from the old map go out ahead of the level event
+    if (UAegisWebSocketServer* WsServer = UAegisWebSocketServer::Get())
+    {
+        WsServer->FlushCoalescedEvents();
+        WsServer->BroadcastEvent(TEXT("world.level.changed"), [&](FAegisJsonWriter& Writer)
+        {
+            Writer.WriteObjectStart();
+            Writer.WriteValue(TEXT("levelName"), LevelName);
+            Writer.WriteValue(TEXT("worldName"), World ? World->GetName() : FString());
+            Writer.WriteObjectEnd();
+        });
     }
+
+    NotifyEditorContextChanged();
 }
 
 void FAegisBridgeModule::OnActorSpawned(AActor* Actor)
@@ -153,15 +223,19 @@ void FAegisBridgeModule::OnActorSpawned(AActor* Actor)
 
     UE_LOG(LogAegisBridge, Verbose, TEXT("Actor spawned: %s"), *Actor->GetName());
 
-    // Broadcast to WebSocket clients
-    if (UAegisWebSocketServer* WsServer = UAegisWebSocketServer::Get())
+    ActorIndex.OnActorAdded(Actor);
+    EditorContext.OnActorAdded(Actor);
+
+    if (UAegisChangeJournal* Journal = UAegisChangeJournal::Get())
     {
-        TSharedPtr<FJsonObject> EventData = MakeShareable(new FJsonObject());
-        EventData->SetStringField(TEXT("actorName"), Actor->GetName());
-        EventData->SetStringField(TEXT("actorClass"), Actor->GetClass()->GetName());
-        EventData->SetStringField(TEXT("actorPath"), Actor->GetPathName());
+        Journal->RecordActorAdded(Actor);
+    }
 
-        WsServer->BroadcastEvent(TEXT("world.entity.spawned"), EventData);
+    // Batched into world.entity.changed; nothing is queued unless someone subscribed
+    if (UAegisWebSocketServer* WsServer = UAegisWebSocketServer::Get())
+    {
+        WsServer->QueueActorSpawned(Actor);
+        WsServer->QueueEditorContextChanged();
     }
 }
 
@@ -171,14 +245,19 @@ void FAegisBridgeModule::OnActorDeleted(AActor* Actor)
 
     UE_LOG(LogAegisBridge, Verbose, TEXT("Actor deleted: %s"), *Actor->GetName());
 
-    // Broadcast to WebSocket clients
-    if (UAegisWebSocketServer* WsServer = UAegisWebSocketServer::Get())
+    ActorIndex.OnActorRemoved(Actor);
+    EditorContext.OnActorRemoved(Actor);
+
+    if (UAegisChangeJournal* Journal = UAegisChangeJournal::Get())
     {
-        TSharedPtr<FJsonObject> EventData = MakeShareable(new FJsonObject());
-        EventData->SetStringField(TEXT("actorName"), Actor->GetName());
-        EventData->SetStringField(TEXT("actorClass"), Actor->GetClass()->GetName());
+        Journal->RecordActorRemoved(Actor);
+    }
 
-        WsServer->BroadcastEvent(TEXT("world.entity.destroyed"), EventData);
+    // Batched into world.entity.changed
+    if (UAegisWebSocketServer* WsServer = UAegisWebSocketServer::Get())
+    {
+        WsServer->QueueActorDestroyed(Actor);
+        WsServer->QueueEditorContextChanged();
     }
 }
 
@@ -186,31 +265,101 @@ void FAegisBridgeModule::OnSelectionChanged(UObject* Object)
 {
     UE_LOG(LogAegisBridge, Verbose, TEXT("Selection changed"));
 
-    // Broadcast to WebSocket clients
+    EditorContext.OnSelectionChanged();
+
+    // The latest selection goes out once the coalescing window closes
     if (UAegisWebSocketServer* WsServer = UAegisWebSocketServer::Get())
     {
-        TArray<AActor*> SelectedActors;
-        if (GEditor)
-        {
-            GEditor->GetSelectedActors()->GetSelectedObjects<AActor>(SelectedActors);
-        }
+        WsServer->QueueSelectionChanged();
+        WsServer->QueueEditorContextChanged();
+    }
+}
 
-        TSharedPtr<FJsonObject> EventData = MakeShareable(new FJsonObject());
-        TArray<TSharedPtr<FJsonValue>> ActorArray;
+void FAegisBridgeModule::OnLevelAddedToWorld(ULevel* Level, UWorld* World)
+{
+    ActorIndex.OnLevelAdded(Level, World);
+    EditorContext.OnLevelsChanged();
+    NotifyEditorContextChanged();
 
-        for (AActor* Actor : SelectedActors)
-        {
-            TSharedPtr<FJsonObject> ActorObj = MakeShareable(new FJsonObject());
-            ActorObj->SetStringField(TEXT("name"), Actor->GetName());
-            ActorObj->SetStringField(TEXT("class"), Actor->GetClass()->GetName());
-            ActorObj->SetStringField(TEXT("path"), Actor->GetPathName());
-            ActorArray.Add(MakeShareable(new FJsonValueObject(ActorObj)));
-        }
+    if (UAegisChangeJournal* Journal = UAegisChangeJournal::Get())
+    {
+        Journal->RecordLevelChanged(Level, true);
+    }
+}
+
+void FAegisBridgeModule::OnLevelRemovedFromWorld(ULevel* Level, UWorld* World)
+{
+    ActorIndex.OnLevelRemoved(Level, World);
+    EditorContext.OnLevelsChanged();
+    NotifyEditorContextChanged();
+
+    if (UAegisChangeJournal* Journal = UAegisChangeJournal::Get())
+    {
+        Journal->RecordLevelChanged(Level, false);
+    }
+}
+
+void FAegisBridgeModule::OnActorLabelChanged(AActor* Actor)
+{
+    // Relabelling may rename the underlying object; reindex under the new keys
+    ActorIndex.OnActorAdded(Actor);
+}
+
+void FAegisBridgeModule::OnPostUndoRedo()
+{
+    ActorIndex.Invalidate();
+    EditorContext.OnPostUndoRedo();
+    NotifyEditorContextChanged();
+}
+
+void FAegisBridgeModule::OnObjectPropertyChanged(UObject* Object, FPropertyChangedEvent& Event)
+{
+    if (UAegisChangeJournal* Journal = UAegisChangeJournal::Get())
+    {
+        Journal->RecordPropertyChanged(Object, Event);
+    }
+}
 
-        EventData->SetArrayField(TEXT("selectedActors"), ActorArray);
-        EventData->SetNumberField(TEXT("count"), SelectedActors.Num());
+void FAegisBridgeModule::OnActorMoved(AActor* Actor)
+{
+    if (UAegisChangeJournal* Journal = UAegisChangeJournal::Get())
+    {
+        Journal->RecordActorMoved(Actor);
+    }
+}
 
-        WsServer->BroadcastEvent(TEXT("editor.selection.changed"), EventData);
+void FAegisBridgeModule::OnObjectTransacted(UObject* Object, const FTransactionObjectEvent& Event)
+{
+    // Forward edits already arrive as property and move notifications; undo/redo does not
+    if (Event.GetEventType() != ETransactionObjectEventType::UndoRedo)
+    {
+        return;
+    }
+
+    if (UAegisChangeJournal* Journal = UAegisChangeJournal::Get())
+    {
+        Journal->RecordObjectTransacted(Object);
+    }
+}
+
+void FAegisBridgeModule::OnClassLayoutsChanged()
+{
+    UE_LOG(LogAegisBridge, Verbose, TEXT("Class layouts changed, dropping %d property plans"), PropertyPlans.Num());
+
+    PropertyPlans.Reset();
+}
+
+void FAegisBridgeModule::OnPlayModeChanged(bool bIsSimulating)
+{
+    EditorContext.OnPlayModeChanged();
+    NotifyEditorContextChanged();
+}
+
+void FAegisBridgeModule::NotifyEditorContextChanged()
+{
+    if (UAegisWebSocketServer* WsServer = UAegisWebSocketServer::Get())
+    {
+        WsServer->QueueEditorContextChanged();
     }
 }
 
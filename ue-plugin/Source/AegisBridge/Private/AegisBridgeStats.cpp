@@ -0,0 +1,263 @@
+// Copyright AEGIS Team. All Rights Reserved.
+
+#include "AegisBridgeStats.h"
+#include "AegisBridgeModule.h"
+#include "AegisJobManager.h"
+#include "AegisWebSocketServer.h"
+#include "HAL/IConsoleManager.h"
+#include "Misc/ScopeLock.h"
+
+UE_TRACE_CHANNEL_DEFINE(AegisBridgeChannel);
+
+namespace
+{
+    TAutoConsoleVariable<bool> CVarAegisStatsEnable(
+        TEXT("Aegis.Stats.Enable"),
+        true,
+        TEXT("Record latency and payload figures for bridge commands."));
+
+    FAutoConsoleCommand AegisStatsCommand(
+        TEXT("Aegis.Stats"),
+        TEXT("Log latency, payload and queue figures of the AEGIS bridge."),
+        FConsoleCommandDelegate::CreateLambda([]()
+        {
+            FAegisBridgeStats::Get().LogSummary();
+        }));
+
+    FAutoConsoleCommand AegisStatsResetCommand(
+        TEXT("Aegis.Stats.Reset"),
+        TEXT("Clear the AEGIS bridge figures."),
+        FConsoleCommandDelegate::CreateLambda([]()
+        {
+            FAegisBridgeStats::Get().Reset();
+        }));
+}
+
+// ============================================================================
+// Latency Histogram
+// ============================================================================
+
+int32 FAegisLatencyHistogram::GetBucket(uint64 Micros)
+{
+    if (Micros < SubBucketCount)
+    {
+        return static_cast<int32>(Micros);
+    }
+
+    // The exponent picks the group, the next SubBucketBits bits below the top one the bucket
+    const int32 TopBit = static_cast<int32>(FMath::FloorLog2_64(Micros));
+    const int32 Group = TopBit - SubBucketBits + 1;
+    if (Group > MaxExponent)
+    {
+        return BucketCount - 1;
+    }
+
+    const int32 SubBucket = static_cast<int32>((Micros >> (TopBit - SubBucketBits)) & (SubBucketCount - 1));
+    return Group * SubBucketCount + SubBucket;
+}
+
+uint64 FAegisLatencyHistogram::GetBucketUpperEdge(int32 Bucket)
+{
+    if (Bucket < SubBucketCount)
+    {
+        return static_cast<uint64>(Bucket);
+    }
+
+    const int32 Group = Bucket / SubBucketCount;
+    const int32 SubBucket = Bucket % SubBucketCount;
+    const int32 Shift = Group - 1;
+    const uint64 Lower = static_cast<uint64>(SubBucketCount + SubBucket) << Shift;
+    return Lower + (uint64(1) << Shift) - 1;
+}
+
+void FAegisLatencyHistogram::Record(uint64 Micros)
+{
+    ++Buckets[GetBucket(Micros)];
+    ++Count;
+    Total += Micros;
+    Min = FMath::Min(Min, Micros);
+    Max = FMath::Max(Max, Micros);
+}
+
+void FAegisLatencyHistogram::Reset()
+{
+    *this = FAegisLatencyHistogram();
+}
+
+uint64 FAegisLatencyHistogram::GetPercentile(double Percentile) const
+{
+    if (Count == 0)
+    {
+        return 0;
+    }
+
+    const uint64 Rank = FMath::Clamp<uint64>(static_cast<uint64>(FMath::CeilToDouble(Percentile / 100.0 * Count)), 1, Count);
+    uint64 Seen = 0;
+    for (int32 Bucket = 0; Bucket < BucketCount; ++Bucket)
+    {
+        Seen += Buckets[Bucket];
+        if (Seen >= Rank)
+        {
+            return FMath::Clamp(GetBucketUpperEdge(Bucket), GetMin(), Max);
+        }
+    }
+    return Max;
+}
+
+void FAegisLatencyHistogram::WriteFields(FAegisJsonWriter& Writer) const
+{
+    Writer.WriteValue(TEXT("count"), static_cast<int64>(Count));
+    Writer.WriteValue(TEXT("min"), static_cast<int64>(GetMin()));
+    Writer.WriteValue(TEXT("mean"), GetMean());
+    Writer.WriteValue(TEXT("p50"), static_cast<int64>(GetPercentile(50.0)));
+    Writer.WriteValue(TEXT("p90"), static_cast<int64>(GetPercentile(90.0)));
+    Writer.WriteValue(TEXT("p99"), static_cast<int64>(GetPercentile(99.0)));
+    Writer.WriteValue(TEXT("p999"), static_cast<int64>(GetPercentile(99.9)));
+    Writer.WriteValue(TEXT("max"), static_cast<int64>(Max));
+}
+
+// ============================================================================
+// Bridge Stats
+// ============================================================================
+
+FAegisBridgeStats& FAegisBridgeStats::Get()
+{
+    static FAegisBridgeStats Instance;
+    return Instance;
+}
+
+bool FAegisBridgeStats::IsEnabled()
+{
+    return CVarAegisStatsEnable.GetValueOnAnyThread();
+}
+
+void FAegisBridgeStats::Record(FName Metric, uint64 Micros, int64 BytesIn, int64 BytesOut)
+{
+    FScopeLock ScopeLock(&Lock);
+    FMetric& Entry = Metrics.FindOrAdd(Metric);
+    Entry.Latency.Record(Micros);
+    Entry.BytesIn += BytesIn;
+    Entry.BytesOut += BytesOut;
+}
+
+void FAegisBridgeStats::Reset()
+{
+    FScopeLock ScopeLock(&Lock);
+    Metrics.Reset();
+    StartTime = FPlatformTime::Seconds();
+}
+
+TArray<TPair<FName, FAegisBridgeStats::FMetric>> FAegisBridgeStats::GetSortedMetrics() const
+{
+    TArray<TPair<FName, FMetric>> Sorted;
+    {
+        FScopeLock ScopeLock(&Lock);
+        Sorted.Reserve(Metrics.Num());
+        for (const TPair<FName, FMetric>& Pair : Metrics)
+        {
+            Sorted.Emplace(Pair.Key, Pair.Value);
+        }
+    }
+
+    Sorted.Sort([](const TPair<FName, FMetric>& A, const TPair<FName, FMetric>& B)
+    {
+        return A.Value.Latency.GetTotal() > B.Value.Latency.GetTotal();
+    });
+    return Sorted;
+}
+
+void FAegisBridgeStats::WriteFields(FAegisJsonWriter& Writer) const
+{
+    Writer.WriteValue(TEXT("uptimeSeconds"), FPlatformTime::Seconds() - StartTime);
+    Writer.WriteValue(TEXT("enabled"), IsEnabled());
+
+    // Latencies in microseconds
+    Writer.WriteArrayStart(TEXT("metrics"));
+    for (const TPair<FName, FMetric>& Pair : GetSortedMetrics())
+    {
+        Writer.WriteObjectStart();
+        Writer.WriteValue(TEXT("name"), Pair.Key.ToString());
+        Pair.Value.Latency.WriteFields(Writer);
+        Writer.WriteValue(TEXT("totalMs"), Pair.Value.Latency.GetTotal() / 1000.0);
+        Writer.WriteValue(TEXT("bytesIn"), Pair.Value.BytesIn);
+        Writer.WriteValue(TEXT("bytesOut"), Pair.Value.BytesOut);
+        Writer.WriteObjectEnd();
+    }
+    Writer.WriteArrayEnd();
+
+    // Gauges of the moment
+    TArray<TPair<FString, FAegisWebSocketClientStats>> Clients;
+    if (UAegisWebSocketServer* WsServer = UAegisWebSocketServer::Get())
+    {
+        WsServer->GetAllClientStats(Clients);
+    }
+
+    int64 QueuedMessages = 0;
+    int64 QueuedBytes = 0;
+    Writer.WriteObjectStart(TEXT("webSocket"));
+    Writer.WriteArrayStart(TEXT("clients"));
+    for (const TPair<FString, FAegisWebSocketClientStats>& Client : Clients)
+    {
+        const FAegisWebSocketClientStats& ClientStats = Client.Value;
+        QueuedMessages += ClientStats.QueuedMessages;
+        QueuedBytes += ClientStats.QueuedBytes;
+
+        Writer.WriteObjectStart();
+        Writer.WriteValue(TEXT("clientId"), Client.Key);
+        Writer.WriteValue(TEXT("queuedMessages"), ClientStats.QueuedMessages);
+        Writer.WriteValue(TEXT("queuedBytes"), ClientStats.QueuedBytes);
+        Writer.WriteValue(TEXT("peakQueuedMessages"), ClientStats.PeakQueuedMessages);
+        Writer.WriteValue(TEXT("sentMessages"), ClientStats.SentMessages);
+        Writer.WriteValue(TEXT("sentBytes"), ClientStats.SentBytes);
+        Writer.WriteValue(TEXT("droppedMessages"), ClientStats.DroppedMessages);
+        Writer.WriteValue(TEXT("oversizedMessages"), ClientStats.OversizedMessages);
+        Writer.WriteObjectEnd();
+    }
+    Writer.WriteArrayEnd();
+    Writer.WriteValue(TEXT("queuedMessages"), QueuedMessages);
+    Writer.WriteValue(TEXT("queuedBytes"), QueuedBytes);
+    Writer.WriteObjectEnd();
+
+    const UAegisJobManager* JobManager = UAegisJobManager::Get();
+    Writer.WriteValue(TEXT("activeJobs"), JobManager ? JobManager->GetActiveJobCount() : 0);
+}
+
+void FAegisBridgeStats::LogSummary() const
+{
+    const TArray<TPair<FName, FMetric>> Sorted = GetSortedMetrics();
+
+    UE_LOG(LogAegisBridge, Display, TEXT("AEGIS bridge stats over %.0f s, %d metrics (latency in us)"), FPlatformTime::Seconds() - StartTime, Sorted.Num());
+    for (const TPair<FName, FMetric>& Pair : Sorted)
+    {
+        const FAegisLatencyHistogram& Latency = Pair.Value.Latency;
+        UE_LOG(LogAegisBridge, Display, TEXT("  %-48s n=%-7llu total=%9.1f ms  p50=%-8llu p99=%-8llu max=%-8llu in=%lld out=%lld"),
+            *Pair.Key.ToString(), Latency.GetCount(), Latency.GetTotal() / 1000.0,
+            Latency.GetPercentile(50.0), Latency.GetPercentile(99.0), Latency.GetMax(),
+            Pair.Value.BytesIn, Pair.Value.BytesOut);
+    }
+
+    if (UAegisWebSocketServer* WsServer = UAegisWebSocketServer::Get())
+    {
+        TArray<TPair<FString, FAegisWebSocketClientStats>> Clients;
+        WsServer->GetAllClientStats(Clients);
+        for (const TPair<FString, FAegisWebSocketClientStats>& Client : Clients)
+        {
+            UE_LOG(LogAegisBridge, Display, TEXT("  ws %s: queued=%d (%lld bytes) peak=%d sent=%lld dropped=%lld oversized=%lld"),
+                *Client.Key, Client.Value.QueuedMessages, Client.Value.QueuedBytes, Client.Value.PeakQueuedMessages,
+                Client.Value.SentMessages, Client.Value.DroppedMessages, Client.Value.OversizedMessages);
+        }
+    }
+}
+
+// ============================================================================
+// Stat Scope
+// ============================================================================
+
+FAegisStatScope::~FAegisStatScope()
+{
+    if (StartCycles != 0)
+    {
+        const uint64 Micros = static_cast<uint64>(FPlatformTime::ToSeconds64(FPlatformTime::Cycles64() - StartCycles) * 1000000.0);
+        FAegisBridgeStats::Get().Record(Metric, Micros, BytesIn, BytesOut);
+    }
+}
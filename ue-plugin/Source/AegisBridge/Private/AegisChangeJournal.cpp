@@ -0,0 +1,370 @@
+// Copyright AEGIS Team. All Rights Reserved.
+
+#include "AegisChangeJournal.h"
+#include "AegisBridgeModule.h"
+#include "Editor.h"
+#include "Engine/Level.h"
+#include "Engine/World.h"
+#include "GameFramework/Actor.h"
+#include "Components/SceneComponent.h"
+#include "Misc/ConfigCacheIni.h"
+#include "UObject/UnrealType.h"
+
+namespace
+{
+    /** Ring capacity unless [AegisBridge] ChangeJournalCapacity overrides it */
+    constexpr int32 DefaultCapacity = 8192;
+
+    /** Beyond this many distinct properties a record collapses to "anything changed" */
+    constexpr int32 MaxTrackedProperties = 32;
+
+    void WriteChangeFlags(FAegisJsonWriter& Writer, EAegisJournalChange Changes)
+    {
+        Writer.WriteArrayStart(TEXT("changes"));
+        if (EnumHasAnyFlags(Changes, EAegisJournalChange::Added)) Writer.WriteValue(TEXT("added"));
+        if (EnumHasAnyFlags(Changes, EAegisJournalChange::Removed)) Writer.WriteValue(TEXT("removed"));
+        if (EnumHasAnyFlags(Changes, EAegisJournalChange::Transform)) Writer.WriteValue(TEXT("transform"));
+        if (EnumHasAnyFlags(Changes, EAegisJournalChange::Properties)) Writer.WriteValue(TEXT("properties"));
+        Writer.WriteArrayEnd();
+    }
+}
+
+UAegisChangeJournal* UAegisChangeJournal::Get()
+{
+    if (GEditor)
+    {
+        return GEditor->GetEditorSubsystem<UAegisChangeJournal>();
+    }
+    return nullptr;
+}
+
+void UAegisChangeJournal::Initialize(FSubsystemCollectionBase& Collection)
+{
+    Super::Initialize(Collection);
+
+    int32 Capacity = DefaultCapacity;
+    if (GConfig)
+    {
+        GConfig->GetInt(TEXT("AegisBridge"), TEXT("ChangeJournalCapacity"), Capacity, GEngineIni);
+    }
+    Ring.SetNum(FMath::Max(Capacity, 64));
+
+    UE_LOG(LogAegisBridge, Log, TEXT("AEGIS Change Journal initialized (%d records)"), Ring.Num());
+}
+
+void UAegisChangeJournal::Deinitialize()
+{
+    Ring.Empty();
+    LatestSequence.Empty();
+    First = 0;
+    Count = 0;
+
+    Super::Deinitialize();
+}
+
+// ============================================================================
+// Recording
+// ============================================================================
+
+void UAegisChangeJournal::RecordActorAdded(AActor* Actor)
+{
+    Record(ResolveActor(Actor), EAegisJournalChange::Added);
+}
+
+void UAegisChangeJournal::RecordActorRemoved(AActor* Actor)
+{
+    Record(ResolveActor(Actor), EAegisJournalChange::Removed);
+}
+
+void UAegisChangeJournal::RecordActorMoved(AActor* Actor)
+{
+    Record(ResolveActor(Actor), EAegisJournalChange::Transform);
+}
+
+void UAegisChangeJournal::RecordPropertyChanged(UObject* Object, const FPropertyChangedEvent& Event)
+{
+    AActor* Actor = ResolveActor(Object);
+    if (!Actor)
+    {
+        return;
+    }
+
+    const FName PropertyName = Event.GetMemberPropertyName();
+
+    // Details panel edits of the root component's relative transform move the actor
+    if (Object == Actor->GetRootComponent() &&
+        (PropertyName == USceneComponent::GetRelativeLocationPropertyName() ||
+         PropertyName == USceneComponent::GetRelativeRotationPropertyName() ||
+         PropertyName == USceneComponent::GetRelativeScale3DPropertyName()))
+    {
+        Record(Actor, EAegisJournalChange::Transform);
+        return;
+    }
+
+    // Component edits are reported against the owning actor under the component's name
+    Record(Actor, EAegisJournalChange::Properties, Object == Actor ? PropertyName : Object->GetFName());
+}
+
+void UAegisChangeJournal::RecordObjectTransacted(UObject* Object)
+{
+    AActor* Actor = ResolveActor(Object);
+    if (!Actor)
+    {
+        return;
+    }
+
+    // Undoing a spawn leaves the actor pending kill; anything else may have changed any property
+    Record(Actor, IsValid(Actor) ? EAegisJournalChange::Properties | EAegisJournalChange::Transform : EAegisJournalChange::Removed);
+}
+
+void UAegisChangeJournal::RecordLevelChanged(ULevel* Level, bool bAdded)
+{
+    if (!Level)
+    {
+        return;
+    }
+
+    const EAegisJournalChange Change = bAdded ? EAegisJournalChange::Added : EAegisJournalChange::Removed;
+    for (AActor* Actor : Level->Actors)
+    {
+        Record(ResolveActor(Actor), Change);
+    }
+}
+
+void UAegisChangeJournal::Reset()
+{
+    First = 0;
+    Count = 0;
+    LatestSequence.Reset();
+
+    // The reset consumes a sequence number so readers positioned at the old head resync too
+    ResyncBelow = NextSequence++;
+    ++Epoch;
+
+    UE_LOG(LogAegisBridge, Verbose, TEXT("Change journal reset, epoch %d"), Epoch);
+}
+
+AActor* UAegisChangeJournal::ResolveActor(UObject* Object)
+{
+    if (!Object)
+    {
+        return nullptr;
+    }
+
+    AActor* Actor = Cast<AActor>(Object);
+    if (!Actor)
+    {
+        if (UActorComponent* Component = Cast<UActorComponent>(Object))
+        {
+            Actor = Component->GetOwner();
+        }
+    }
+
+    if (!Actor || Actor->HasAnyFlags(RF_ClassDefaultObject | RF_ArchetypeObject | RF_Transient))
+    {
+        return nullptr;
+    }
+
+    // PIE, preview and thumbnail worlds are not part of the synchronized state
+    UWorld* EditorWorld = GEditor ? GEditor->GetEditorWorldContext().World() : nullptr;
+    return EditorWorld && Actor->GetWorld() == EditorWorld ? Actor : nullptr;
+}
+
+void UAegisChangeJournal::Record(AActor* Actor, EAegisJournalChange Change, FName Property)
+{
+    if (!Actor || Ring.Num() == 0)
+    {
+        return;
+    }
+
+    const FObjectKey ActorKey(Actor);
+
+    // Carry over what the superseded record accumulated
+    EAegisJournalChange Changes = EAegisJournalChange::None;
+    TArray<FName> Properties;
+    bool bAnyProperty = false;
+
+    if (const uint64* Previous = LatestSequence.Find(ActorKey))
+    {
+        const FAegisJournalRecord& PreviousRecord = Ring[GetSlot(static_cast<int32>(*Previous - Ring[First].Sequence))];
+        Changes = PreviousRecord.Changes;
+        Properties = PreviousRecord.Properties;
+        bAnyProperty = EnumHasAnyFlags(Changes, EAegisJournalChange::Properties) && Properties.IsEmpty();
+    }
+
+    if (Change == EAegisJournalChange::Removed)
+    {
+        // Nothing about a destroyed actor matters beyond its removal
+        Changes = EAegisJournalChange::Removed;
+        Properties.Reset();
+    }
+    else if (EnumHasAnyFlags(Change, EAegisJournalChange::Added))
+    {
+        // Readers fetch the full state of added actors
+        Changes = EAegisJournalChange::Added;
+        Properties.Reset();
+    }
+    else
+    {
+        Changes = (Changes & ~EAegisJournalChange::Removed) | Change;
+        if (EnumHasAnyFlags(Change, EAegisJournalChange::Properties))
+        {
+            if (bAnyProperty || Property.IsNone() || Properties.Num() >= MaxTrackedProperties)
+            {
+                Properties.Reset();
+            }
+            else
+            {
+                Properties.AddUnique(Property);
+            }
+        }
+    }
+
+    // Claim the next slot, overwriting the oldest record when full
+    int32 Slot;
+    if (Count < Ring.Num())
+    {
+        Slot = GetSlot(Count++);
+    }
+    else
+    {
+        Slot = First;
+        const FAegisJournalRecord& Evicted = Ring[Slot];
+        if (IsLatest(Evicted))
+        {
+            // Superseded records cost nothing to lose; a live one means readers behind it miss a change
+            LatestSequence.Remove(Evicted.ActorKey);
+            ResyncBelow = FMath::Max(ResyncBelow, Evicted.Sequence);
+        }
+        First = (First + 1) % Ring.Num();
+    }
+
+    FAegisJournalRecord& NewRecord = Ring[Slot];
+    NewRecord.Sequence = NextSequence++;
+    NewRecord.ActorKey = ActorKey;
+    NewRecord.ActorPath = Actor->GetPathName();
+    NewRecord.ActorName = Actor->GetName();
+    NewRecord.ActorClass = Actor->GetClass()->GetName();
+    NewRecord.Changes = Changes;
+    NewRecord.Properties = MoveTemp(Properties);
+    NewRecord.Timestamp = FDateTime::UtcNow();
+
+    LatestSequence.Add(ActorKey, NewRecord.Sequence);
+}
+
+// ============================================================================
+// Reading
+// ============================================================================
+
+int32 UAegisChangeJournal::FindFirstAfter(uint64 Since) const
+{
+    if (Count == 0)
+    {
+        return 0;
+    }
+
+    // Records hold consecutive sequence numbers, so the position is direct
+    const uint64 Oldest = Ring[First].Sequence;
+    if (Since < Oldest)
+    {
+        return 0;
+    }
+    return static_cast<int32>(FMath::Min<uint64>(Since - Oldest + 1, Count));
+}
+
+bool UAegisChangeJournal::IsLatest(const FAegisJournalRecord& Record) const
+{
+    const uint64* Latest = LatestSequence.Find(Record.ActorKey);
+    return Latest && *Latest == Record.Sequence;
+}
+
+void UAegisChangeJournal::GetLatestTimestamps(TMap<FString, FDateTime>& OutByPath) const
+{
+    OutByPath.Reserve(OutByPath.Num() + LatestSequence.Num());
+    for (int32 Index = 0; Index < Count; ++Index)
+    {
+        const FAegisJournalRecord& Record = Ring[GetSlot(Index)];
+        if (IsLatest(Record))
+        {
+            OutByPath.Add(Record.ActorPath, Record.Timestamp);
+        }
+    }
+}
+
+void UAegisChangeJournal::WriteChangesSince(uint64 Since, int32 MaxRecords, FAegisJsonWriter& Writer) const
+{
+    const bool bResyncRequired = Since < ResyncBelow;
+
+    Writer.WriteObjectStart();
+    Writer.WriteValue(TEXT("epoch"), Epoch);
+    Writer.WriteValue(TEXT("head"), static_cast<int64>(GetHeadSequence()));
+    Writer.WriteValue(TEXT("since"), static_cast<int64>(Since));
+    Writer.WriteValue(TEXT("resyncRequired"), bResyncRequired);
+
+    uint64 LastWritten = FMath::Max(Since, GetHeadSequence());
+    bool bHasMore = false;
+
+    Writer.WriteArrayStart(TEXT("records"));
+    if (!bResyncRequired)
+    {
+        LastWritten = Since;
+
+        int32 Written = 0;
+        for (int32 Index = FindFirstAfter(Since); Index < Count; ++Index)
+        {
+            const FAegisJournalRecord& Record = Ring[GetSlot(Index)];
+            if (!IsLatest(Record))
+            {
+                LastWritten = Record.Sequence;
+                continue;
+            }
+
+            if (Written == MaxRecords)
+            {
+                bHasMore = true;
+                break;
+            }
+
+            Writer.WriteObjectStart();
+            Writer.WriteValue(TEXT("sequence"), static_cast<int64>(Record.Sequence));
+            Writer.WriteValue(TEXT("path"), Record.ActorPath);
+            Writer.WriteValue(TEXT("name"), Record.ActorName);
+            Writer.WriteValue(TEXT("class"), Record.ActorClass);
+            WriteChangeFlags(Writer, Record.Changes);
+            if (Record.Properties.Num() > 0)
+            {
+                Writer.WriteArrayStart(TEXT("properties"));
+                for (const FName& Property : Record.Properties)
+                {
+                    Writer.WriteValue(Property.ToString());
+                }
+                Writer.WriteArrayEnd();
+            }
+            Writer.WriteValue(TEXT("timestamp"), Record.Timestamp.ToIso8601());
+            Writer.WriteObjectEnd();
+
+            LastWritten = Record.Sequence;
+            ++Written;
+        }
+
+        // Trailing superseded records are consumed too, so an idle poll always reaches the head
+        if (!bHasMore)
+        {
+            LastWritten = FMath::Max(LastWritten, GetHeadSequence());
+        }
+    }
+    Writer.WriteArrayEnd();
+
+    Writer.WriteValue(TEXT("hasMore"), bHasMore);
+    Writer.WriteValue(TEXT("nextSequence"), static_cast<int64>(LastWritten));
+    Writer.WriteObjectEnd();
+}
+
+FString UAegisChangeJournal::GetChangesSince(int64 Since, int32 MaxRecords)
+{
+    FString Result;
+    TSharedRef<FAegisJsonWriter> Writer = FAegisJsonWriterFactory::Create(&Result);
+    WriteChangesSince(static_cast<uint64>(FMath::Max<int64>(Since, 0)), FMath::Max(MaxRecords, 0), *Writer);
+    Writer->Close();
+    return Result;
+}
@@ -0,0 +1,284 @@
+// Copyright AEGIS Team. All Rights Reserved.
+
+#include "AegisEditorContext.h"
+#include "Editor.h"
+#include "Engine/Level.h"
+#include "Engine/LevelStreaming.h"
+#include "Engine/Selection.h"
+#include "Engine/World.h"
+#include "GameFramework/Actor.h"
+
+int64 FAegisEditorContext::GetVersion()
+{
+    Refresh();
+    return Version;
+}
+
+const FString& FAegisEditorContext::GetContextJson()
+{
+    Refresh();
+
+    if (ContextJson.IsEmpty())
+    {
+        TSharedRef<FAegisJsonWriter> Writer = FAegisJsonWriterFactory::Create(&ContextJson);
+        Writer->WriteObjectStart();
+        Writer->WriteValue(TEXT("version"), Version);
+        if (TrackedWorld.IsValid())
+        {
+            WriteWorld(*Writer);
+        }
+        WriteSelection(*Writer);
+        WriteMode(*Writer);
+        Writer->WriteObjectEnd();
+        Writer->Close();
+    }
+    return ContextJson;
+}
+
+const FString& FAegisEditorContext::GetLevelInfoJson()
+{
+    Refresh();
+
+    if (LevelInfoJson.IsEmpty())
+    {
+        TSharedRef<FAegisJsonWriter> Writer = FAegisJsonWriterFactory::Create(&LevelInfoJson);
+        Writer->WriteObjectStart();
+        Writer->WriteValue(TEXT("version"), Version);
+        Writer->WriteValue(TEXT("worldName"), WorldName);
+        Writer->WriteValue(TEXT("mapName"), MapName);
+        Writer->WriteValue(TEXT("actorCount"), ActorCount);
+        WriteStreamingLevels(*Writer);
+        Writer->WriteObjectEnd();
+        Writer->Close();
+    }
+    return LevelInfoJson;
+}
+
+void FAegisEditorContext::WriteChanges(FAegisJsonWriter& Writer)
+{
+    Refresh();
+
+    const int64 BaseVersion = PushedVersion;
+    PushedVersion = Version;
+
+    Writer.WriteObjectStart();
+    Writer.WriteValue(TEXT("version"), Version);
+    Writer.WriteValue(TEXT("baseVersion"), BaseVersion);
+    if (SectionVersions[0] > BaseVersion && TrackedWorld.IsValid())
+    {
+        WriteWorld(Writer);
+    }
+    if (SectionVersions[1] > BaseVersion)
+    {
+        WriteStreamingLevels(Writer);
+    }
+    if (SectionVersions[2] > BaseVersion)
+    {
+        WriteSelection(Writer);
+    }
+    if (SectionVersions[3] > BaseVersion)
+    {
+        WriteMode(Writer);
+    }
+    Writer.WriteObjectEnd();
+}
+
+// ============================================================================
+// Delegate hooks
+// ============================================================================
+
+void FAegisEditorContext::OnMapOpened()
+{
+    StaleSections = ESection::All;
+    bCountStale = true;
+    MarkChanged(ESection::All);
+}
+
+void FAegisEditorContext::OnActorAdded(AActor* Actor)
+{
+    // A stale count is recounted anyway
+    if (!bCountStale && IsTrackedActor(Actor))
+    {
+        ++ActorCount;
+        MarkChanged(ESection::World);
+    }
+}
+
+void FAegisEditorContext::OnActorRemoved(AActor* Actor)
+{
+    if (!bCountStale && IsTrackedActor(Actor))
+    {
+        ActorCount = FMath::Max(ActorCount - 1, 0);
+        MarkChanged(ESection::World);
+    }
+}
+
+void FAegisEditorContext::OnLevelsChanged()
+{
+    StaleSections |= ESection::World | ESection::Levels;
+    bCountStale = true;
+    MarkChanged(ESection::World | ESection::Levels);
+}
+
+void FAegisEditorContext::OnSelectionChanged()
+{
+    // Rebuilt on the next read, however often it changes in between
+    StaleSections |= ESection::Selection;
+    MarkChanged(ESection::Selection);
+}
+
+void FAegisEditorContext::OnPlayModeChanged()
+{
+    StaleSections |= ESection::Mode;
+    MarkChanged(ESection::Mode);
+}
+
+void FAegisEditorContext::OnPostUndoRedo()
+{
+    StaleSections |= ESection::World | ESection::Selection;
+    bCountStale = true;
+    MarkChanged(ESection::World | ESection::Selection);
+}
+
+void FAegisEditorContext::Reset()
+{
+    *this = FAegisEditorContext();
+}
+
+// ============================================================================
+// Internals
+// ============================================================================
+
+void FAegisEditorContext::MarkChanged(ESection Sections)
+{
+    ++Version;
+    for (int32 Bit = 0; Bit < UE_ARRAY_COUNT(SectionVersions); ++Bit)
+    {
+        if (EnumHasAnyFlags(Sections, static_cast<ESection>(1 << Bit)))
+        {
+            SectionVersions[Bit] = Version;
+        }
+    }
+
+    ContextJson.Reset();
+    LevelInfoJson.Reset();
+}
+
+void FAegisEditorContext::Refresh()
+{
+    UWorld* World = GEditor ? GEditor->GetEditorWorldContext().World() : nullptr;
+    if (World != TrackedWorld.Get())
+    {
+        TrackedWorld = World;
+        StaleSections |= ESection::World | ESection::Levels;
+        bCountStale = true;
+        MarkChanged(ESection::World | ESection::Levels);
+    }
+
+    // Two flags; cheaper to read every time than to trust the PIE delegates' timing
+    const bool bPlaying = GEditor && GEditor->IsPlayingSessionInEditor();
+    const bool bSimulating = GEditor && GEditor->IsSimulatingInEditor();
+    if (bPlaying != bIsPlaying || bSimulating != bIsSimulating)
+    {
+        bIsPlaying = bPlaying;
+        bIsSimulating = bSimulating;
+        MarkChanged(ESection::Mode);
+    }
+
+    if (EnumHasAnyFlags(StaleSections, ESection::World))
+    {
+        WorldName = World ? World->GetName() : FString();
+        MapName = World ? World->GetMapName() : FString();
+    }
+
+    if (bCountStale)
+    {
+        ActorCount = World ? World->GetActorCount() : 0;
+        bCountStale = false;
+    }
+
+    if (EnumHasAnyFlags(StaleSections, ESection::Levels))
+    {
+        StreamingLevels.Reset();
+        if (World)
+        {
+            for (ULevelStreaming* StreamingLevel : World->GetStreamingLevels())
+            {
+                if (StreamingLevel)
+                {
+                    FLevelInfo& Level = StreamingLevels.AddDefaulted_GetRef();
+                    Level.Name = StreamingLevel->GetWorldAssetPackageName();
+                    Level.bLoaded = StreamingLevel->IsLevelLoaded();
+                }
+            }
+        }
+    }
+
+    if (EnumHasAnyFlags(StaleSections, ESection::Selection))
+    {
+        Selection.Reset();
+        if (GEditor)
+        {
+            TArray<AActor*> SelectedActors;
+            GEditor->GetSelectedActors()->GetSelectedObjects<AActor>(SelectedActors);
+
+            Selection.Reserve(SelectedActors.Num());
+            for (AActor* Actor : SelectedActors)
+            {
+                FActorInfo& Info = Selection.AddDefaulted_GetRef();
+                Info.Name = Actor->GetName();
+                Info.Class = Actor->GetClass()->GetName();
+                Info.Path = Actor->GetPathName();
+            }
+        }
+    }
+
+    StaleSections = ESection::None;
+}
+
+bool FAegisEditorContext::IsTrackedActor(const AActor* Actor) const
+{
+    return Actor && TrackedWorld.IsValid() && Actor->GetWorld() == TrackedWorld.Get();
+}
+
+void FAegisEditorContext::WriteWorld(FAegisJsonWriter& Writer) const
+{
+    Writer.WriteObjectStart(TEXT("world"));
+    Writer.WriteValue(TEXT("name"), WorldName);
+    Writer.WriteValue(TEXT("mapName"), MapName);
+    Writer.WriteValue(TEXT("actorCount"), ActorCount);
+    Writer.WriteObjectEnd();
+}
+
+void FAegisEditorContext::WriteStreamingLevels(FAegisJsonWriter& Writer) const
+{
+    Writer.WriteArrayStart(TEXT("streamingLevels"));
+    for (const FLevelInfo& Level : StreamingLevels)
+    {
+        Writer.WriteObjectStart();
+        Writer.WriteValue(TEXT("name"), Level.Name);
+        Writer.WriteValue(TEXT("loaded"), Level.bLoaded);
+        Writer.WriteObjectEnd();
+    }
+    Writer.WriteArrayEnd();
+}
+
+void FAegisEditorContext::WriteSelection(FAegisJsonWriter& Writer) const
+{
+    Writer.WriteArrayStart(TEXT("selection"));
+    for (const FActorInfo& Actor : Selection)
+    {
+        Writer.WriteObjectStart();
+        Writer.WriteValue(TEXT("name"), Actor.Name);
+        Writer.WriteValue(TEXT("class"), Actor.Class);
+        Writer.WriteValue(TEXT("path"), Actor.Path);
+        Writer.WriteObjectEnd();
+    }
+    Writer.WriteArrayEnd();
+}
+
+void FAegisEditorContext::WriteMode(FAegisJsonWriter& Writer) const
+{
+    Writer.WriteValue(TEXT("isPlaying"), bIsPlaying);
+    Writer.WriteValue(TEXT("isSimulating"), bIsSimulating);
+}
@@ -0,0 +1,231 @@
+// Copyright AEGIS Team. All Rights Reserved.
+
+#include "AegisEventCoalescer.h"
+#include "AegisBridgeModule.h"
+#include "AegisWebSocketServer.h"
+#include "Editor.h"
+#include "Engine/Selection.h"
+#include "GameFramework/Actor.h"
+#include "HAL/PlatformTime.h"
+
+void FAegisEventCoalescer::AddSpawned(AActor* Actor)
+{
+    const FObjectKey Key(Actor);
+
+    // Undoing a delete brings the same actor back: the pair is no change at all
+    if (Destroyed.Remove(Key) > 0)
+    {
+        ++Cancelled;
+        return;
+    }
+
+    MarkPending();
+    Spawned.Add(Key, Actor);
+}
+
+void FAegisEventCoalescer::AddDestroyed(AActor* Actor)
+{
+    const FObjectKey Key(Actor);
+
+    // Spawned and destroyed within one window: clients never need to hear about it
+    if (Spawned.Remove(Key) > 0)
+    {
+        ++Cancelled;
+        return;
+    }
+
+    MarkPending();
+    FDestroyedEntity& Entity = Destroyed.Add(Key);
+    Entity.Name = Actor->GetName();
+    Entity.Class = Actor->GetClass()->GetName();
+    Entity.Path = Actor->GetPathName();
+}
+
+void FAegisEventCoalescer::AddSelectionChanged()
+{
+    MarkPending();
+    bSelectionChanged = true;
+}
+
+void FAegisEventCoalescer::AddContextChanged()
+{
+    MarkPending();
+    bContextChanged = true;
+}
+
+void FAegisEventCoalescer::MarkPending()
+{
+    if (!HasPending())
+    {
+        WindowStart = FPlatformTime::Seconds();
+    }
+}
+
+void FAegisEventCoalescer::FlushIfDue(UAegisWebSocketServer& Server, double Now)
+{
+    if (!HasPending())
+    {
+        // Everything cancelled out; there is nothing to tell anyone
+        Cancelled = 0;
+        return;
+    }
+
+    const bool bBatchFull = Spawned.Num() + Destroyed.Num() >= Settings.MaxBatchEntities;
+    if (bBatchFull || Now - WindowStart >= Settings.WindowSeconds)
+    {
+        Flush(Server);
+    }
+}
+
+void FAegisEventCoalescer::Flush(UAegisWebSocketServer& Server)
+{
+    FlushEntities(Server);
+    FlushSelection(Server);
+    FlushContext(Server);
+}
+
+void FAegisEventCoalescer::Reset()
+{
+    Spawned.Reset();
+    Destroyed.Reset();
+    Cancelled = 0;
+    bSelectionChanged = false;
+    bContextChanged = false;
+}
+
+void FAegisEventCoalescer::FlushEntities(UAegisWebSocketServer& Server)
+{
+    if (Spawned.Num() == 0 && Destroyed.Num() == 0)
+    {
+        Cancelled = 0;
+        return;
+    }
+
+    TArray<AActor*> SpawnedActors;
+    SpawnedActors.Reserve(Spawned.Num());
+    for (const TPair<FObjectKey, TWeakObjectPtr<AActor>>& Pair : Spawned)
+    {
+        // Gone without a delete notification, e.g. its level was unloaded
+        if (AActor* Actor = Pair.Value.Get())
+        {
+            SpawnedActors.Add(Actor);
+        }
+    }
+
+    TArray<const FDestroyedEntity*> DestroyedEntities;
+    DestroyedEntities.Reserve(Destroyed.Num());
+    for (const TPair<FObjectKey, FDestroyedEntity>& Pair : Destroyed)
+    {
+        DestroyedEntities.Add(&Pair.Value);
+    }
+
+    UE_LOG(LogAegisBridge, Verbose, TEXT("Coalesced entity changes: %d spawned, %d destroyed, %d cancelled"),
+        SpawnedActors.Num(), DestroyedEntities.Num(), Cancelled);
+
+    // Storms are split so no single frame grows without bound
+    const int32 BatchSize = FMath::Max(Settings.MaxBatchEntities, 1);
+    int32 SpawnedIndex = 0;
+    int32 DestroyedIndex = 0;
+
+    while (SpawnedIndex < SpawnedActors.Num() || DestroyedIndex < DestroyedEntities.Num())
+    {
+        const int32 SpawnedEnd = FMath::Min(SpawnedActors.Num(), SpawnedIndex + BatchSize);
+        const int32 DestroyedEnd = FMath::Min(DestroyedEntities.Num(), DestroyedIndex + BatchSize - (SpawnedEnd - SpawnedIndex));
+
+        Server.BroadcastEvent(TEXT("world.entity.changed"), [&](FAegisJsonWriter& Writer)
+        {
+            Writer.WriteObjectStart();
+
+            Writer.WriteArrayStart(TEXT("spawned"));
+            for (int32 Index = SpawnedIndex; Index < SpawnedEnd; ++Index)
+            {
+                const AActor* Actor = SpawnedActors[Index];
+                Writer.WriteObjectStart();
+                Writer.WriteValue(TEXT("actorName"), Actor->GetName());
+                Writer.WriteValue(TEXT("actorClass"), Actor->GetClass()->GetName());
+                Writer.WriteValue(TEXT("actorPath"), Actor->GetPathName());
+                Writer.WriteObjectEnd();
+            }
+            Writer.WriteArrayEnd();
+
+            Writer.WriteArrayStart(TEXT("destroyed"));
+            for (int32 Index = DestroyedIndex; Index < DestroyedEnd; ++Index)
+            {
+                const FDestroyedEntity& Entity = *DestroyedEntities[Index];
+                Writer.WriteObjectStart();
+                Writer.WriteValue(TEXT("actorName"), Entity.Name);
+                Writer.WriteValue(TEXT("actorClass"), Entity.Class);
+                Writer.WriteValue(TEXT("actorPath"), Entity.Path);
+                Writer.WriteObjectEnd();
+            }
+            Writer.WriteArrayEnd();
+
+            Writer.WriteValue(TEXT("cancelled"), Cancelled);
+            Writer.WriteObjectEnd();
+        });
+
+        // Only the first frame of a split batch reports the cancelled pairs
+        Cancelled = 0;
+        SpawnedIndex = SpawnedEnd;
+        DestroyedIndex = DestroyedEnd;
+    }
+
+    Spawned.Reset();
+    Destroyed.Reset();
+}
+
+void FAegisEventCoalescer::FlushSelection(UAegisWebSocketServer& Server)
+{
+    if (!bSelectionChanged)
+    {
+        return;
+    }
+    bSelectionChanged = false;
+
+    if (!GEditor || !Server.HasSubscribers(TEXT("editor.selection.changed")))
+    {
+        return;
+    }
+
+    // Only the selection as it stands now matters, however often it changed in between
+    TArray<AActor*> SelectedActors;
+    GEditor->GetSelectedActors()->GetSelectedObjects<AActor>(SelectedActors);
+
+    Server.BroadcastEvent(TEXT("editor.selection.changed"), [&SelectedActors](FAegisJsonWriter& Writer)
+    {
+        Writer.WriteObjectStart();
+        Writer.WriteArrayStart(TEXT("selectedActors"));
+        for (AActor* Actor : SelectedActors)
+        {
+            Writer.WriteObjectStart();
+            Writer.WriteValue(TEXT("name"), Actor->GetName());
+            Writer.WriteValue(TEXT("class"), Actor->GetClass()->GetName());
+            Writer.WriteValue(TEXT("path"), Actor->GetPathName());
+            Writer.WriteObjectEnd();
+        }
+        Writer.WriteArrayEnd();
+        Writer.WriteValue(TEXT("count"), SelectedActors.Num());
+        Writer.WriteObjectEnd();
+    });
+}
+
+void FAegisEventCoalescer::FlushContext(UAegisWebSocketServer& Server)
+{
+    if (!bContextChanged)
+    {
+        return;
+    }
+    bContextChanged = false;
+
+    FAegisEditorContext& Context = FAegisBridgeModule::Get().GetEditorContext();
+    if (!Context.HasUnpushedChanges() || !Server.HasSubscribers(TEXT("editor.context.changed")))
+    {
+        return;
+    }
+
+    // Sections changed since the previous push; stale sections are rebuilt once, here
+    Server.BroadcastEvent(TEXT("editor.context.changed"), [&Context](FAegisJsonWriter& Writer)
+    {
+        Context.WriteChanges(Writer);
+    });
+}
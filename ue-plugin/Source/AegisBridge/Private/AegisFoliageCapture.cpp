@@ -0,0 +1,490 @@
+// Copyright AEGIS Team. All Rights Reserved.
+
+#include "AegisFoliageCapture.h"
+#include "AegisBridgeModule.h"
+#include "Async/ParallelFor.h"
+#include "EngineUtils.h"
+#include "FoliageType.h"
+#include "Hash/xxhash.h"
+#include "InstancedFoliage.h"
+#include "InstancedFoliageActor.h"
+#include "Math/Float16.h"
+#include "Serialization/MemoryReader.h"
+
+namespace
+{
+    constexpr float QuantizeScale = 65535.0f;
+
+    /** One instance of one of a type's source arrays */
+    struct FInstanceRef
+    {
+        int32 Source;
+        int32 Index;
+    };
+
+    using FInstanceSources = TArray<const TArray<FFoliageInstance>*>;
+
+    uint64 HashHashes(const TArray<uint64>& Hashes)
+    {
+        return FXxHash64::HashBuffer(Hashes.GetData(), Hashes.Num() * sizeof(uint64)).Hash;
+    }
+
+    FIntPoint GetCellCoord(const FVector& Location, double CellSize)
+    {
+        return FIntPoint(FMath::FloorToInt32(Location.X / CellSize), FMath::FloorToInt32(Location.Y / CellSize));
+    }
+
+    uint16 QuantizeUnit(double Value)
+    {
+        return static_cast<uint16>(FMath::Clamp(FMath::RoundToInt32(Value * QuantizeScale), 0, 65535));
+    }
+
+    /** Offset in [0, 1) of a cell as one of 65536 steps; decoded at the step centre, so never in the next cell */
+    uint16 QuantizeCellOffset(double Value)
+    {
+        return static_cast<uint16>(FMath::Clamp(FMath::FloorToInt32(Value * 65536.0), 0, 65535));
+    }
+
+    double DequantizeCellOffset(uint16 Value, int32 Version)
+    {
+        // Version 1 rounded over 65535 steps, which put the top step on the cell's far edge
+        return Version >= 2 ? (Value + 0.5) / 65536.0 : FMath::Min(Value / static_cast<double>(QuantizeScale), 65535.5 / 65536.0);
+    }
+
+    uint16 QuantizeAngle(double Degrees)
+    {
+        return static_cast<uint16>(FMath::RoundToInt32(FRotator::ClampAxis(Degrees) / 360.0 * 65536.0) & 0xFFFF);
+    }
+
+    void WriteUInt16(uint8*& Dest, uint16 Value)
+    {
+        *Dest++ = static_cast<uint8>(Value & 0xFF);
+        *Dest++ = static_cast<uint8>(Value >> 8);
+    }
+
+    uint16 ReadUInt16(const uint8*& Source)
+    {
+        const uint16 Value = static_cast<uint16>(Source[0] | (Source[1] << 8));
+        Source += 2;
+        return Value;
+    }
+
+    void PackInstance(const FFoliageInstance& Instance, const FVector2D& CellOrigin, double CellSize, float MinZ, float ZRange, uint8* Dest)
+    {
+        WriteUInt16(Dest, QuantizeCellOffset((Instance.Location.X - CellOrigin.X) / CellSize));
+        WriteUInt16(Dest, QuantizeCellOffset((Instance.Location.Y - CellOrigin.Y) / CellSize));
+        WriteUInt16(Dest, ZRange > 0.0f ? QuantizeUnit((Instance.Location.Z - MinZ) / ZRange) : 0);
+
+        WriteUInt16(Dest, QuantizeAngle(Instance.Rotation.Pitch));
+        WriteUInt16(Dest, QuantizeAngle(Instance.Rotation.Yaw));
+        WriteUInt16(Dest, QuantizeAngle(Instance.Rotation.Roll));
+
+        WriteUInt16(Dest, FFloat16(Instance.DrawScale3D.X).Encoded);
+        WriteUInt16(Dest, FFloat16(Instance.DrawScale3D.Y).Encoded);
+        WriteUInt16(Dest, FFloat16(Instance.DrawScale3D.Z).Encoded);
+        WriteUInt16(Dest, FFloat16(Instance.ZOffset).Encoded);
+
+        *Dest = static_cast<uint8>(Instance.Flags & 0xFF);
+    }
+
+    void UnpackInstance(const uint8* Source, int32 Version, const FVector2D& CellOrigin, double CellSize, float MinZ, float ZRange, FFoliageInstance& OutInstance)
+    {
+        OutInstance.Location.X = CellOrigin.X + DequantizeCellOffset(ReadUInt16(Source), Version) * CellSize;
+        OutInstance.Location.Y = CellOrigin.Y + DequantizeCellOffset(ReadUInt16(Source), Version) * CellSize;
+        OutInstance.Location.Z = MinZ + ReadUInt16(Source) / QuantizeScale * ZRange;
+
+        OutInstance.Rotation.Pitch = ReadUInt16(Source) / 65536.0 * 360.0;
+        OutInstance.Rotation.Yaw = ReadUInt16(Source) / 65536.0 * 360.0;
+        OutInstance.Rotation.Roll = ReadUInt16(Source) / 65536.0 * 360.0;
+        OutInstance.PreAlignRotation = OutInstance.Rotation;
+
+        FFloat16 Half;
+        Half.Encoded = ReadUInt16(Source);
+        OutInstance.DrawScale3D.X = Half.GetFloat();
+        Half.Encoded = ReadUInt16(Source);
+        OutInstance.DrawScale3D.Y = Half.GetFloat();
+        Half.Encoded = ReadUInt16(Source);
+        OutInstance.DrawScale3D.Z = Half.GetFloat();
+        Half.Encoded = ReadUInt16(Source);
+        OutInstance.ZOffset = Half.GetFloat();
+
+        OutInstance.Flags = *Source;
+    }
+
+    /** Pack, sort and hash one cell */
+    void BuildCell(FAegisFoliageCell& Cell, const FInstanceSources& Sources, TConstArrayView<FInstanceRef> Members, double CellSize, bool bKeepData)
+    {
+        float MaxZ = -MAX_flt;
+        Cell.MinZ = MAX_flt;
+        for (const FInstanceRef& Ref : Members)
+        {
+            const float Z = static_cast<float>((*Sources[Ref.Source])[Ref.Index].Location.Z);
+            Cell.MinZ = FMath::Min(Cell.MinZ, Z);
+            MaxZ = FMath::Max(MaxZ, Z);
+        }
+        Cell.ZRange = MaxZ - Cell.MinZ;
+        Cell.Count = Members.Num();
+
+        const FVector2D CellOrigin(Cell.Coord.X * CellSize, Cell.Coord.Y * CellSize);
+        constexpr int32 Stride = FAegisFoliageCapture::PackedInstanceSize;
+
+        TArray<uint8> Unsorted;
+        Unsorted.SetNumUninitialized(Members.Num() * Stride);
+        for (int32 Index = 0; Index < Members.Num(); ++Index)
+        {
+            const FInstanceRef& Ref = Members[Index];
+            PackInstance((*Sources[Ref.Source])[Ref.Index], CellOrigin, CellSize, Cell.MinZ, Cell.ZRange, Unsorted.GetData() + Index * Stride);
+        }
+
+        // Foliage arrays reorder on removal; sorting makes the hash order-independent
+        TArray<int32> Order;
+        Order.SetNumUninitialized(Members.Num());
+        for (int32 Index = 0; Index < Order.Num(); ++Index)
+        {
+            Order[Index] = Index;
+        }
+        const uint8* Base = Unsorted.GetData();
+        Order.Sort([Base](int32 A, int32 B)
+        {
+            return FMemory::Memcmp(Base + A * Stride, Base + B * Stride, Stride) < 0;
+        });
+
+        Cell.Packed.SetNumUninitialized(Unsorted.Num());
+        for (int32 Index = 0; Index < Order.Num(); ++Index)
+        {
+            FMemory::Memcpy(Cell.Packed.GetData() + Index * Stride, Base + Order[Index] * Stride, Stride);
+        }
+
+        Cell.Hash = FXxHash64::HashBuffer(Cell.Packed.GetData(), Cell.Packed.Num()).Hash;
+        if (!bKeepData)
+        {
+            Cell.Packed.Empty();
+        }
+    }
+}
+
+FAegisFoliageCapture::FAegisFoliageCapture(double InCellSize)
+    : CellSize(InCellSize > 0.0 ? InCellSize : DefaultCellSize)
+{
+}
+
+void FAegisFoliageCapture::Capture(UWorld* World, bool bKeepData)
+{
+    Types.Reset();
+    Hash = 0;
+    InstanceCount = 0;
+
+    if (!World)
+    {
+        return;
+    }
+
+    // Instance arrays of every foliage actor, by type
+    TMap<UFoliageType*, FInstanceSources> Sources;
+    for (TActorIterator<AInstancedFoliageActor> It(World); It; ++It)
+    {
+        It->ForEachFoliageInfo([&Sources](UFoliageType* FoliageType, FFoliageInfo& Info)
+        {
+            if (FoliageType && Info.Instances.Num() > 0)
+            {
+                Sources.FindOrAdd(FoliageType).Add(&Info.Instances);
+            }
+            return true;
+        });
+    }
+
+    // Bucket instances into cells; the per-cell members are only references
+    struct FPendingCell
+    {
+        const FInstanceSources* Sources;
+        int32 TypeIndex;
+        int32 CellIndex;
+        TArray<FInstanceRef> Members;
+    };
+    TArray<FPendingCell> Pending;
+
+    for (const TPair<UFoliageType*, FInstanceSources>& Source : Sources)
+    {
+        const int32 TypeIndex = Types.Num();
+        FAegisFoliageTypeCapture& Type = Types.AddDefaulted_GetRef();
+        Type.FoliageTypePath = Source.Key->GetPathName();
+
+        TMap<FIntPoint, int32> CellLookup;
+        for (int32 SourceIndex = 0; SourceIndex < Source.Value.Num(); ++SourceIndex)
+        {
+            const TArray<FFoliageInstance>& Instances = *Source.Value[SourceIndex];
+            for (int32 Index = 0; Index < Instances.Num(); ++Index)
+            {
+                const FIntPoint Coord = GetCellCoord(Instances[Index].Location, CellSize);
+                int32& PendingIndex = CellLookup.FindOrAdd(Coord, INDEX_NONE);
+                if (PendingIndex == INDEX_NONE)
+                {
+                    PendingIndex = Pending.Num();
+                    Pending.Add({ &Source.Value, TypeIndex, Type.Cells.Num(), {} });
+                    Type.Cells.AddDefaulted_GetRef().Coord = Coord;
+                }
+                Pending[PendingIndex].Members.Add({ SourceIndex, Index });
+            }
+            Type.InstanceCount += Instances.Num();
+        }
+        InstanceCount += Type.InstanceCount;
+    }
+
+    ParallelFor(Pending.Num(), [this, &Pending, bKeepData](int32 PendingIndex)
+    {
+        FPendingCell& Cell = Pending[PendingIndex];
+        BuildCell(Types[Cell.TypeIndex].Cells[Cell.CellIndex], *Cell.Sources, Cell.Members, CellSize, bKeepData);
+    });
+
+    Types.Sort([](const FAegisFoliageTypeCapture& A, const FAegisFoliageTypeCapture& B)
+    {
+        return A.FoliageTypePath < B.FoliageTypePath;
+    });
+
+    TArray<uint64> TypeHashes;
+    for (FAegisFoliageTypeCapture& Type : Types)
+    {
+        Type.Cells.Sort([](const FAegisFoliageCell& A, const FAegisFoliageCell& B)
+        {
+            return A.Coord.Y != B.Coord.Y ? A.Coord.Y < B.Coord.Y : A.Coord.X < B.Coord.X;
+        });
+
+        TArray<uint64> CellHashes;
+        CellHashes.Reserve(Type.Cells.Num());
+        for (const FAegisFoliageCell& Cell : Type.Cells)
+        {
+            CellHashes.Add(Cell.Hash);
+        }
+        Type.Hash = HashHashes(CellHashes);
+        TypeHashes.Add(Type.Hash);
+    }
+    Hash = HashHashes(TypeHashes);
+}
+
+FString FAegisFoliageCapture::GetCellKey(const FAegisFoliageTypeCapture& Type, const FAegisFoliageCell& Cell)
+{
+    return FString::Printf(TEXT("%s:%d,%d"), *Type.FoliageTypePath, Cell.Coord.X, Cell.Coord.Y);
+}
+
+FString FAegisFoliageCapture::HashToString(uint64 InHash)
+{
+    return FString::Printf(TEXT("%016llx"), InHash);
+}
+
+bool FAegisFoliageCapture::ParseCellKey(const FString& Key, FString& OutFoliageTypePath, FIntPoint& OutCoord)
+{
+    FString CoordString;
+    FString XString;
+    FString YString;
+    return Key.Split(TEXT(":"), &OutFoliageTypePath, &CoordString, ESearchCase::CaseSensitive, ESearchDir::FromEnd) &&
+        CoordString.Split(TEXT(","), &XString, &YString) &&
+        LexTryParseString(OutCoord.X, *XString) && LexTryParseString(OutCoord.Y, *YString);
+}
+
+void FAegisFoliageCapture::Serialize(FArchive& Ar, TConstArrayView<TPair<int32, int32>> CellRefs, const TMap<FString, TArray<FIntPoint>>& ClearedCells) const
+{
+    uint32 Magic = InstanceDataMagic;
+    int32 Version = InstanceDataVersion;
+    double Size = CellSize;
+    Ar << Magic << Version << Size;
+
+    // Type runs of the listed cells, then types that only have cleared cells
+    TArray<TPair<int32, int32>> Runs;
+    for (int32 Index = 0; Index < CellRefs.Num(); ++Index)
+    {
+        if (Index == 0 || CellRefs[Index].Key != CellRefs[Index - 1].Key)
+        {
+            Runs.Emplace(Index, Index);
+        }
+        Runs.Last().Value = Index + 1;
+    }
+
+    TSet<FString> WrittenTypes;
+    for (const TPair<int32, int32>& Run : Runs)
+    {
+        WrittenTypes.Add(Types[CellRefs[Run.Key].Key].FoliageTypePath);
+    }
+
+    int32 TypeCount = Runs.Num();
+    for (const TPair<FString, TArray<FIntPoint>>& Cleared : ClearedCells)
+    {
+        TypeCount += WrittenTypes.Contains(Cleared.Key) ? 0 : 1;
+    }
+    Ar << TypeCount;
+
+    auto WriteEmptyCells = [&Ar](TConstArrayView<FIntPoint> Coords)
+    {
+        for (FIntPoint Coord : Coords)
+        {
+            float MinZ = 0.0f;
+            float ZRange = 0.0f;
+            int32 Count = 0;
+            uint64 CellHash = 0;
+            Ar << Coord << MinZ << ZRange << Count << CellHash;
+        }
+    };
+
+    for (const TPair<int32, int32>& Run : Runs)
+    {
+        const FAegisFoliageTypeCapture& Type = Types[CellRefs[Run.Key].Key];
+        const TArray<FIntPoint>* Cleared = ClearedCells.Find(Type.FoliageTypePath);
+
+        FString Path = Type.FoliageTypePath;
+        int32 CellCount = (Run.Value - Run.Key) + (Cleared ? Cleared->Num() : 0);
+        Ar << Path << CellCount;
+
+        for (int32 Index = Run.Key; Index < Run.Value; ++Index)
+        {
+            const FAegisFoliageCell& Cell = Type.Cells[CellRefs[Index].Value];
+            check(Cell.Packed.Num() == Cell.Count * PackedInstanceSize);
+
+            FIntPoint Coord = Cell.Coord;
+            float MinZ = Cell.MinZ;
+            float ZRange = Cell.ZRange;
+            int32 Count = Cell.Count;
+            uint64 CellHash = Cell.Hash;
+            Ar << Coord << MinZ << ZRange << Count << CellHash;
+            Ar.Serialize(const_cast<uint8*>(Cell.Packed.GetData()), Cell.Packed.Num());
+        }
+        if (Cleared)
+        {
+            WriteEmptyCells(*Cleared);
+        }
+    }
+
+    for (const TPair<FString, TArray<FIntPoint>>& Cleared : ClearedCells)
+    {
+        if (!WrittenTypes.Contains(Cleared.Key))
+        {
+            FString Path = Cleared.Key;
+            int32 CellCount = Cleared.Value.Num();
+            Ar << Path << CellCount;
+            WriteEmptyCells(Cleared.Value);
+        }
+    }
+}
+
+bool FAegisFoliageCapture::Restore(UWorld* World, const TArray<uint8>& Data, int32 BatchSize, FAegisFoliageRestoreResult& OutResult, FString& OutError)
+{
+    if (!World)
+    {
+        OutError = TEXT("No editor world");
+        return false;
+    }
+    BatchSize = BatchSize > 0 ? BatchSize : DefaultRestoreBatchSize;
+
+    FMemoryReader Ar(Data);
+
+    uint32 Magic = 0;
+    int32 Version = 0;
+    double Size = 0.0;
+    int32 TypeCount = 0;
+    Ar << Magic << Version << Size << TypeCount;
+    if (Ar.IsError() || Magic != InstanceDataMagic || Version > InstanceDataVersion || Size <= 0.0 || TypeCount < 0)
+    {
+        OutError = TEXT("Not a foliage instance data blob");
+        return false;
+    }
+
+    for (int32 TypeIndex = 0; TypeIndex < TypeCount; ++TypeIndex)
+    {
+        FString Path;
+        int32 CellCount = 0;
+        Ar << Path << CellCount;
+        if (Ar.IsError() || CellCount < 0)
+        {
+            OutError = TEXT("Truncated foliage instance data");
+            return false;
+        }
+
+        UFoliageType* FoliageType = LoadObject<UFoliageType>(nullptr, *Path);
+        if (!FoliageType)
+        {
+            OutResult.MissingTypes.Add(Path);
+        }
+
+        TSet<FIntPoint> RestoredCells;
+        TArray<FFoliageInstance> NewInstances;
+
+        for (int32 CellIndex = 0; CellIndex < CellCount; ++CellIndex)
+        {
+            FIntPoint Coord;
+            float MinZ = 0.0f;
+            float ZRange = 0.0f;
+            int32 Count = 0;
+            uint64 CellHash = 0;
+            Ar << Coord << MinZ << ZRange << Count << CellHash;
+
+            const int64 Bytes = static_cast<int64>(Count) * PackedInstanceSize;
+            if (Ar.IsError() || Count < 0 || Bytes > Ar.TotalSize() - Ar.Tell())
+            {
+                OutError = TEXT("Truncated foliage instance data");
+                return false;
+            }
+
+            const uint8* Packed = Data.GetData() + Ar.Tell();
+            Ar.Seek(Ar.Tell() + Bytes);
+
+            if (!FoliageType)
+            {
+                continue;
+            }
+
+            RestoredCells.Add(Coord);
+            const FVector2D CellOrigin(Coord.X * Size, Coord.Y * Size);
+            const int32 First = NewInstances.AddDefaulted(Count);
+            for (int32 Index = 0; Index < Count; ++Index)
+            {
+                UnpackInstance(Packed + Index * PackedInstanceSize, Version, CellOrigin, Size, MinZ, ZRange, NewInstances[First + Index]);
+            }
+        }
+
+        if (!FoliageType || RestoredCells.Num() == 0)
+        {
+            continue;
+        }
+
+        // Clear the restored cells in one pass per foliage actor
+        for (TActorIterator<AInstancedFoliageActor> It(World); It; ++It)
+        {
+            FFoliageInfo* Info = It->FindInfo(FoliageType);
+            if (!Info)
+            {
+                continue;
+            }
+
+            TArray<int32> ToRemove;
+            for (int32 Index = 0; Index < Info->Instances.Num(); ++Index)
+            {
+                if (RestoredCells.Contains(GetCellCoord(Info->Instances[Index].Location, Size)))
+                {
+                    ToRemove.Add(Index);
+                }
+            }
+
+            if (ToRemove.Num() > 0)
+            {
+                It->Modify();
+                Info->RemoveInstances(ToRemove, true);
+                OutResult.InstancesRemoved += ToRemove.Num();
+            }
+        }
+
+        // AddInstances places each instance in the foliage actor that owns its location
+        TArray<FFoliageInstance> Batch;
+        for (int32 BatchStart = 0; BatchStart < NewInstances.Num(); BatchStart += BatchSize)
+        {
+            const int32 BatchCount = FMath::Min(BatchSize, NewInstances.Num() - BatchStart);
+            Batch.Reset(BatchCount);
+            Batch.Append(NewInstances.GetData() + BatchStart, BatchCount);
+            AInstancedFoliageActor::AddInstances(World, FoliageType, Batch);
+        }
+
+        OutResult.CellsRestored += RestoredCells.Num();
+        OutResult.InstancesAdded += NewInstances.Num();
+    }
+
+    UE_LOG(LogAegisBridge, Log, TEXT("Restored %d foliage cells: %d instances removed, %d added"),
+        OutResult.CellsRestored, OutResult.InstancesRemoved, OutResult.InstancesAdded);
+    return true;
+}
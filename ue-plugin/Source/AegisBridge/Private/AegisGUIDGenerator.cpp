@@ -0,0 +1,421 @@
+// Copyright AEGIS Team. All Rights Reserved.
+
+#include "AegisGUIDGenerator.h"
+#include "Async/ParallelFor.h"
+
+namespace
+{
+    constexpr uint32 SHA256RoundConstants[64] =
+    {
+        0x428a2f98, 0x71374491, 0xb5c0fbcf, 0xe9b5dba5, 0x3956c25b, 0x59f111f1, 0x923f82a4, 0xab1c5ed5,
+        0xd807aa98, 0x12835b01, 0x243185be, 0x550c7dc3, 0x72be5d74, 0x80deb1fe, 0x9bdc06a7, 0xc19bf174,
+        0xe49b69c1, 0xefbe4786, 0x0fc19dc6, 0x240ca1cc, 0x2de92c6f, 0x4a7484aa, 0x5cb0a9dc, 0x76f988da,
+        0x983e5152, 0xa831c66d, 0xb00327c8, 0xbf597fc7, 0xc6e00bf3, 0xd5a79147, 0x06ca6351, 0x14292967,
+        0x27b70a85, 0x2e1b2138, 0x4d2c6dfc, 0x53380d13, 0x650a7354, 0x766a0abb, 0x81c2c92e, 0x92722c85,
+        0xa2bfe8a1, 0xa81a664b, 0xc24b8b70, 0xc76c51a3, 0xd192e819, 0xd6990624, 0xf40e3585, 0x106aa070,
+        0x19a4c116, 0x1e376c08, 0x2748774c, 0x34b0bcb5, 0x391c0cb3, 0x4ed8aa4a, 0x5b9cca4f, 0x682e6ff3,
+        0x748f82ee, 0x78a5636f, 0x84c87814, 0x8cc70208, 0x90befffa, 0xa4506ceb, 0xbef9a3f7, 0xc67178f2,
+    };
+
+    constexpr TCHAR UpperHexDigits[] = TEXT("0123456789ABCDEF");
+    constexpr TCHAR LowerHexDigits[] = TEXT("0123456789abcdef");
+
+    /** Batch GUIDs generated per worker task */
+    constexpr int32 GUIDsPerTask = 1024;
+
+    FORCEINLINE uint32 RotateRight(uint32 Value, uint32 Bits)
+    {
+        return (Value >> Bits) | (Value << (32 - Bits));
+    }
+
+    /** UTF-8 hash input, on the stack for anything shorter than a long path */
+    struct FHashInput
+    {
+        TArray<uint8, TInlineAllocator<512>> Bytes;
+
+        void Append(FStringView Text)
+        {
+            if (Text.Len() == 0)
+            {
+                return;
+            }
+            const int32 Size = FPlatformString::ConvertedLength<UTF8CHAR>(Text.GetData(), Text.Len());
+            const int32 Start = Bytes.AddUninitialized(Size);
+            FPlatformString::Convert(reinterpret_cast<UTF8CHAR*>(Bytes.GetData() + Start), Size, Text.GetData(), Text.Len());
+        }
+
+        void Append(uint8 Char)
+        {
+            Bytes.Add(Char);
+        }
+
+        /** Decimal, as Number.prototype.toString writes integers */
+        void AppendInteger(int64 Value)
+        {
+            uint8 Digits[20];
+            int32 DigitCount = 0;
+            uint64 Magnitude = Value < 0 ? 0 - static_cast<uint64>(Value) : static_cast<uint64>(Value);
+            do
+            {
+                Digits[DigitCount++] = static_cast<uint8>('0' + Magnitude % 10);
+                Magnitude /= 10;
+            }
+            while (Magnitude > 0);
+
+            if (Value < 0)
+            {
+                Bytes.Add('-');
+            }
+            while (DigitCount > 0)
+            {
+                Bytes.Add(Digits[--DigitCount]);
+            }
+        }
+    };
+}
+
+// ============================================================================
+// SHA-256
+// ============================================================================
+
+FAegisSHA256::FAegisSHA256()
+{
+    State[0] = 0x6a09e667;
+    State[1] = 0xbb67ae85;
+    State[2] = 0x3c6ef372;
+    State[3] = 0xa54ff53a;
+    State[4] = 0x510e527f;
+    State[5] = 0x9b05688c;
+    State[6] = 0x1f83d9ab;
+    State[7] = 0x5be0cd19;
+}
+
+void FAegisSHA256::Transform(const uint8 Block[64])
+{
+    uint32 W[64];
+    for (int32 Index = 0; Index < 16; ++Index)
+    {
+        W[Index] = (uint32(Block[Index * 4]) << 24) | (uint32(Block[Index * 4 + 1]) << 16) | (uint32(Block[Index * 4 + 2]) << 8) | uint32(Block[Index * 4 + 3]);
+    }
+    for (int32 Index = 16; Index < 64; ++Index)
+    {
+        const uint32 S0 = RotateRight(W[Index - 15], 7) ^ RotateRight(W[Index - 15], 18) ^ (W[Index - 15] >> 3);
+        const uint32 S1 = RotateRight(W[Index - 2], 17) ^ RotateRight(W[Index - 2], 19) ^ (W[Index - 2] >> 10);
+        W[Index] = W[Index - 16] + S0 + W[Index - 7] + S1;
+    }
+
+    uint32 A = State[0], B = State[1], C = State[2], D = State[3];
+    uint32 E = State[4], F = State[5], G = State[6], H = State[7];
+
+    for (int32 Index = 0; Index < 64; ++Index)
+    {
+        const uint32 S1 = RotateRight(E, 6) ^ RotateRight(E, 11) ^ RotateRight(E, 25);
+        const uint32 Choose = (E & F) ^ (~E & G);
+        const uint32 Temp1 = H + S1 + Choose + SHA256RoundConstants[Index] + W[Index];
+        const uint32 S0 = RotateRight(A, 2) ^ RotateRight(A, 13) ^ RotateRight(A, 22);
+        const uint32 Majority = (A & B) ^ (A & C) ^ (B & C);
+        const uint32 Temp2 = S0 + Majority;
+
+        H = G;
+        G = F;
+        F = E;
+        E = D + Temp1;
+        D = C;
+        C = B;
+        B = A;
+        A = Temp1 + Temp2;
+    }
+
+    State[0] += A;
+    State[1] += B;
+    State[2] += C;
+    State[3] += D;
+    State[4] += E;
+    State[5] += F;
+    State[6] += G;
+    State[7] += H;
+}
+
+void FAegisSHA256::Update(const uint8* Data, int64 Length)
+{
+    TotalLength += Length;
+
+    if (BufferLength > 0)
+    {
+        const int32 Fill = static_cast<int32>(FMath::Min<int64>(64 - BufferLength, Length));
+        FMemory::Memcpy(Buffer + BufferLength, Data, Fill);
+        BufferLength += Fill;
+        Data += Fill;
+        Length -= Fill;
+
+        if (BufferLength < 64)
+        {
+            return;
+        }
+        Transform(Buffer);
+        BufferLength = 0;
+    }
+
+    for (; Length >= 64; Data += 64, Length -= 64)
+    {
+        Transform(Data);
+    }
+
+    if (Length > 0)
+    {
+        FMemory::Memcpy(Buffer, Data, Length);
+        BufferLength = static_cast<int32>(Length);
+    }
+}
+
+void FAegisSHA256::Final(uint8 OutDigest[DigestSize])
+{
+    const uint64 BitLength = TotalLength * 8;
+
+    Buffer[BufferLength++] = 0x80;
+    if (BufferLength > 56)
+    {
+        FMemory::Memzero(Buffer + BufferLength, 64 - BufferLength);
+        Transform(Buffer);
+        BufferLength = 0;
+    }
+    FMemory::Memzero(Buffer + BufferLength, 56 - BufferLength);
+    for (int32 Index = 0; Index < 8; ++Index)
+    {
+        Buffer[56 + Index] = static_cast<uint8>(BitLength >> (56 - Index * 8));
+    }
+    Transform(Buffer);
+
+    for (int32 Index = 0; Index < 8; ++Index)
+    {
+        OutDigest[Index * 4] = static_cast<uint8>(State[Index] >> 24);
+        OutDigest[Index * 4 + 1] = static_cast<uint8>(State[Index] >> 16);
+        OutDigest[Index * 4 + 2] = static_cast<uint8>(State[Index] >> 8);
+        OutDigest[Index * 4 + 3] = static_cast<uint8>(State[Index]);
+    }
+}
+
+FString FAegisSHA256::HashToHex(FStringView Text)
+{
+    FHashInput Input;
+    Input.Append(Text);
+
+    FAegisSHA256 Hasher;
+    Hasher.Update(Input.Bytes.GetData(), Input.Bytes.Num());
+
+    uint8 Digest[DigestSize];
+    Hasher.Final(Digest);
+
+    FString Hex;
+    TArray<TCHAR>& Chars = Hex.GetCharArray();
+    Chars.SetNumUninitialized(DigestSize * 2 + 1);
+    for (int32 Index = 0; Index < DigestSize; ++Index)
+    {
+        Chars[Index * 2] = LowerHexDigits[Digest[Index] >> 4];
+        Chars[Index * 2 + 1] = LowerHexDigits[Digest[Index] & 0xF];
+    }
+    Chars[DigestSize * 2] = TCHAR('\0');
+    return Hex;
+}
+
+// ============================================================================
+// GUIDs
+// ============================================================================
+
+EAegisGUIDNamespace FAegisGUIDGenerator::ParseNamespace(FStringView Namespace)
+{
+    static const TMap<FName, EAegisGUIDNamespace> Namespaces =
+    {
+        { FName(TEXT("actor")), EAegisGUIDNamespace::Actor },
+        { FName(TEXT("component")), EAegisGUIDNamespace::Component },
+        { FName(TEXT("asset")), EAegisGUIDNamespace::Asset },
+        { FName(TEXT("blueprint")), EAegisGUIDNamespace::Blueprint },
+        { FName(TEXT("material")), EAegisGUIDNamespace::Material },
+        { FName(TEXT("landscape")), EAegisGUIDNamespace::Landscape },
+        { FName(TEXT("foliage")), EAegisGUIDNamespace::Foliage },
+        { FName(TEXT("pcg")), EAegisGUIDNamespace::PCG },
+        { FName(TEXT("ai")), EAegisGUIDNamespace::AI },
+        { FName(TEXT("custom")), EAegisGUIDNamespace::Custom },
+    };
+
+    // Every known namespace is already a name, so a miss never grows the name table
+    const FName Name(Namespace.Len(), Namespace.GetData(), FNAME_Find);
+    const EAegisGUIDNamespace* Found = Name.IsNone() ? nullptr : Namespaces.Find(Name);
+    return Found ? *Found : EAegisGUIDNamespace::Unknown;
+}
+
+const TCHAR* FAegisGUIDGenerator::GetNamespaceCode(EAegisGUIDNamespace Namespace)
+{
+    switch (Namespace)
+    {
+    case EAegisGUIDNamespace::Actor: return TEXT("ACT");
+    case EAegisGUIDNamespace::Component: return TEXT("CMP");
+    case EAegisGUIDNamespace::Asset: return TEXT("AST");
+    case EAegisGUIDNamespace::Blueprint: return TEXT("BPT");
+    case EAegisGUIDNamespace::Material: return TEXT("MAT");
+    case EAegisGUIDNamespace::Landscape: return TEXT("LND");
+    case EAegisGUIDNamespace::Foliage: return TEXT("FOL");
+    case EAegisGUIDNamespace::PCG: return TEXT("PCG");
+    case EAegisGUIDNamespace::AI: return TEXT("AIN");
+    case EAegisGUIDNamespace::Custom: return TEXT("CUS");
+    default: return TEXT("UNK");
+    }
+}
+
+bool FAegisGUIDGenerator::ParseGUID(FStringView GUID, EAegisGUIDNamespace& OutNamespace, uint8 OutBytes[GUIDBytes])
+{
+    if (GUID.Len() != GUIDLength)
+    {
+        return false;
+    }
+
+    OutNamespace = EAegisGUIDNamespace::Unknown;
+    for (uint8 Value = 0; Value <= static_cast<uint8>(EAegisGUIDNamespace::Unknown); ++Value)
+    {
+        const EAegisGUIDNamespace Candidate = static_cast<EAegisGUIDNamespace>(Value);
+        if (FMemory::Memcmp(GUID.GetData(), GetNamespaceCode(Candidate), 3 * sizeof(TCHAR)) == 0)
+        {
+            OutNamespace = Candidate;
+            break;
+        }
+    }
+    if (OutNamespace == EAegisGUIDNamespace::Unknown && GUID.Left(3) != TEXT("UNK"))
+    {
+        return false;
+    }
+
+    auto HexValue = [](TCHAR Char) -> int32
+    {
+        if (Char >= TCHAR('0') && Char <= TCHAR('9')) return Char - TCHAR('0');
+        if (Char >= TCHAR('A') && Char <= TCHAR('F')) return Char - TCHAR('A') + 10;
+        return INDEX_NONE;
+    };
+
+    static constexpr int32 GroupBytes[] = { 4, 2, 2, 6 };
+    const TCHAR* Source = GUID.GetData() + 3;
+    uint8* Byte = OutBytes;
+    for (int32 GroupSize : GroupBytes)
+    {
+        if (*Source++ != TCHAR('-'))
+        {
+            return false;
+        }
+        for (int32 Index = 0; Index < GroupSize; ++Index, ++Byte, Source += 2)
+        {
+            const int32 High = HexValue(Source[0]);
+            const int32 Low = HexValue(Source[1]);
+            if (High == INDEX_NONE || Low == INDEX_NONE)
+            {
+                return false;
+            }
+            *Byte = static_cast<uint8>((High << 4) | Low);
+        }
+    }
+    return true;
+}
+
+FString FAegisGUIDGenerator::FormatGUID(EAegisGUIDNamespace Namespace, const uint8 Bytes[GUIDBytes])
+{
+    FString GUID;
+    TArray<TCHAR>& Chars = GUID.GetCharArray();
+    Chars.SetNumUninitialized(GUIDLength + 1);
+    TCHAR* Dest = Chars.GetData();
+
+    FMemory::Memcpy(Dest, GetNamespaceCode(Namespace), 3 * sizeof(TCHAR));
+    Dest += 3;
+
+    // 8-4-4-12 hex digits
+    static constexpr int32 GroupBytes[] = { 4, 2, 2, 6 };
+    const uint8* Byte = Bytes;
+    for (int32 GroupSize : GroupBytes)
+    {
+        *Dest++ = TCHAR('-');
+        for (int32 Index = 0; Index < GroupSize; ++Index, ++Byte)
+        {
+            *Dest++ = UpperHexDigits[*Byte >> 4];
+            *Dest++ = UpperHexDigits[*Byte & 0xF];
+        }
+    }
+    *Dest = TCHAR('\0');
+
+    return GUID;
+}
+
+FString FAegisGUIDGenerator::Generate(FStringView Namespace, FStringView EntityType, FStringView Seed, int32 Counter, FStringView EntityName, FStringView ParentGUID)
+{
+    FHashInput Input;
+    Input.Append(Namespace);
+    Input.Append(':');
+    Input.Append(EntityType);
+    Input.Append(':');
+    Input.Append(Seed);
+    Input.Append(':');
+    Input.AppendInteger(Counter);
+    Input.Append(':');
+    Input.Append(EntityName);
+    Input.Append(':');
+    Input.Append(ParentGUID);
+
+    FAegisSHA256 Hasher;
+    Hasher.Update(Input.Bytes.GetData(), Input.Bytes.Num());
+
+    uint8 Digest[FAegisSHA256::DigestSize];
+    Hasher.Final(Digest);
+
+    return FormatGUID(ParseNamespace(Namespace), Digest);
+}
+
+void FAegisGUIDGenerator::GenerateBatch(FStringView Namespace, FStringView EntityType, FStringView Seed, int32 StartCounter, int32 Count, FStringView NamePrefix, TArray<FString>& OutGUIDs)
+{
+    OutGUIDs.Reset();
+    if (Count <= 0)
+    {
+        return;
+    }
+    OutGUIDs.SetNum(Count);
+
+    const EAegisGUIDNamespace NamespaceId = ParseNamespace(Namespace);
+
+    // "namespace:entityType:seed:" is common to the batch; its full blocks are hashed once
+    FHashInput Prefix;
+    Prefix.Append(Namespace);
+    Prefix.Append(':');
+    Prefix.Append(EntityType);
+    Prefix.Append(':');
+    Prefix.Append(Seed);
+    Prefix.Append(':');
+
+    FAegisSHA256 PrefixHasher;
+    PrefixHasher.Update(Prefix.Bytes.GetData(), Prefix.Bytes.Num());
+
+    FHashInput Name;
+    Name.Append(NamePrefix.Len() > 0 ? NamePrefix : EntityType);
+    Name.Append('_');
+
+    const int32 TaskCount = FMath::DivideAndRoundUp(Count, GUIDsPerTask);
+    ParallelFor(TaskCount, [&](int32 TaskIndex)
+    {
+        const int32 Begin = TaskIndex * GUIDsPerTask;
+        const int32 End = FMath::Min(Begin + GUIDsPerTask, Count);
+
+        FHashInput Suffix;
+        for (int32 Index = Begin; Index < End; ++Index)
+        {
+            // "counter:<name>_<index>:" with an empty parent GUID
+            Suffix.Bytes.Reset();
+            Suffix.AppendInteger(static_cast<int64>(StartCounter) + Index);
+            Suffix.Append(':');
+            Suffix.Bytes.Append(Name.Bytes);
+            Suffix.AppendInteger(Index);
+            Suffix.Append(':');
+
+            FAegisSHA256 Hasher = PrefixHasher;
+            Hasher.Update(Suffix.Bytes.GetData(), Suffix.Bytes.Num());
+
+            uint8 Digest[FAegisSHA256::DigestSize];
+            Hasher.Final(Digest);
+
+            OutGUIDs[Index] = FormatGUID(NamespaceId, Digest);
+        }
+    }, TaskCount > 1 ? EParallelForFlags::None : EParallelForFlags::ForceSingleThread);
+}
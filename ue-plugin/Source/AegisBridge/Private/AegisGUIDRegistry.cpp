@@ -0,0 +1,464 @@
+// Copyright AEGIS Team. All Rights Reserved.
+
+#include "AegisGUIDRegistry.h"
+#include "AegisBridgeModule.h"
+#include "HAL/FileManager.h"
+#include "HAL/PlatformTime.h"
+#include "Misc/FileHelper.h"
+#include "Serialization/MemoryReader.h"
+#include "Serialization/MemoryWriter.h"
+
+namespace
+{
+    constexpr uint32 RegistryMagic = 0x47524741; // "AGRG"
+    constexpr int32 RegistryVersion = 1;
+
+    /** Dead arena bytes tolerated before the arena is rewritten */
+    constexpr int64 MinDeadMetadataForCompaction = 1024 * 1024;
+}
+
+// ============================================================================
+// Registration
+// ============================================================================
+
+bool FAegisGUIDRegistry::MakeKey(FStringView GUID, FKey& OutKey)
+{
+    EAegisGUIDNamespace Namespace;
+    uint8 Bytes[sizeof(FKey::Words)] = {};
+    if (!FAegisGUIDGenerator::ParseGUID(GUID, Namespace, Bytes + 1))
+    {
+        return false;
+    }
+
+    Bytes[0] = static_cast<uint8>(Namespace);
+    FMemory::Memcpy(OutKey.Words, Bytes, sizeof(Bytes));
+    return true;
+}
+
+EAegisGUIDRegisterResult FAegisGUIDRegistry::Register(FStringView GUID, FStringView EntityPath, FStringView EntityType, FStringView Metadata)
+{
+    if (GUID.IsEmpty() || EntityPath.Len() >= NAME_SIZE)
+    {
+        return EAegisGUIDRegisterResult::Invalid;
+    }
+
+    FKey Key;
+    const bool bHasKey = MakeKey(GUID, Key);
+    const uint32 KeyHash = GetTypeHash(Key);
+
+    const int32* ExistingIndex = nullptr;
+    FString ExternalGUID;
+    if (bHasKey)
+    {
+        ExistingIndex = ByKey.FindByHash(KeyHash, Key);
+    }
+    else
+    {
+        ExternalGUID = FString(GUID);
+        ExistingIndex = ExternalLookup.Find(ExternalGUID);
+    }
+
+    const FName Path(EntityPath.Len(), EntityPath.GetData());
+    const int64 Now = FDateTime::UtcNow().GetTicks();
+
+    if (ExistingIndex)
+    {
+        FRecord& Record = Records[*ExistingIndex];
+        if (Record.EntityPath != Path)
+        {
+            return EAegisGUIDRegisterResult::GUIDConflict;
+        }
+
+        Record.EntityType = FName(EntityType.Len(), EntityType.GetData());
+        Record.CreatedAtTicks = Now;
+        ++Record.Version;
+        SetMetadata(Record, Metadata);
+        bDirty = true;
+        return EAegisGUIDRegisterResult::Registered;
+    }
+
+    // A path registered under this GUID would have been found above
+    const uint32 PathHash = GetTypeHash(Path);
+    if (ByPath.ContainsByHash(PathHash, Path))
+    {
+        return EAegisGUIDRegisterResult::PathConflict;
+    }
+
+    const int32 Index = Records.AddDefaulted();
+    FRecord& Record = Records[Index];
+    Record.EntityPath = Path;
+    Record.EntityType = FName(EntityType.Len(), EntityType.GetData());
+    Record.CreatedAtTicks = Now;
+    Record.Version = 1;
+    SetMetadata(Record, Metadata);
+
+    if (bHasKey)
+    {
+        Record.Key = Key;
+        ByKey.AddByHash(KeyHash, Key, Index);
+    }
+    else
+    {
+        Record.ExternalIndex = ExternalGUIDs.Num();
+        ExternalLookup.Add(ExternalGUID, Index);
+        ExternalGUIDs.Add(MoveTemp(ExternalGUID));
+    }
+    ByPath.AddByHash(PathHash, Path, Index);
+
+    bDirty = true;
+    return EAegisGUIDRegisterResult::Registered;
+}
+
+int32 FAegisGUIDRegistry::RegisterBatch(TConstArrayView<FAegisGUIDRegistration> Registrations, TArray<EAegisGUIDRegisterResult>* OutResults)
+{
+    const double StartTime = FPlatformTime::Seconds();
+
+    int64 MetadataChars = 0;
+    for (const FAegisGUIDRegistration& Registration : Registrations)
+    {
+        MetadataChars += Registration.Metadata.Len();
+    }
+
+    // Sized for the all-new case; re-registrations just leave slack
+    const int32 Expected = Records.Num() + Registrations.Num();
+    Records.Reserve(Expected);
+    ByKey.Reserve(Expected);
+    ByPath.Reserve(Expected);
+    MetadataArena.Reserve(static_cast<int32>(FMath::Min<int64>(MetadataArena.Num() + MetadataChars, MAX_int32)));
+
+    if (OutResults)
+    {
+        OutResults->Reset(Registrations.Num());
+    }
+
+    int32 RegisteredCount = 0;
+    for (const FAegisGUIDRegistration& Registration : Registrations)
+    {
+        const EAegisGUIDRegisterResult Result = Register(Registration.GUID, Registration.EntityPath, Registration.EntityType, Registration.Metadata);
+        if (Result == EAegisGUIDRegisterResult::Registered)
+        {
+            ++RegisteredCount;
+        }
+        if (OutResults)
+        {
+            OutResults->Add(Result);
+        }
+    }
+
+    UE_LOG(LogAegisBridge, Log, TEXT("Registered %d of %d GUIDs in %.2f ms"),
+        RegisteredCount, Registrations.Num(), (FPlatformTime::Seconds() - StartTime) * 1000.0);
+    return RegisteredCount;
+}
+
+void FAegisGUIDRegistry::SetMetadata(FRecord& Record, FStringView Metadata)
+{
+    DeadMetadataBytes += Record.MetadataLength;
+    Record.MetadataOffset = 0;
+    Record.MetadataLength = 0;
+
+    if (!Metadata.IsEmpty())
+    {
+        const int32 Length = FPlatformString::ConvertedLength<UTF8CHAR>(Metadata.GetData(), Metadata.Len());
+        if (static_cast<int64>(MetadataArena.Num()) + Length > MAX_int32)
+        {
+            UE_LOG(LogAegisBridge, Error, TEXT("GUID metadata arena is full; metadata for %s dropped"), *Record.EntityPath.ToString());
+        }
+        else
+        {
+            Record.MetadataOffset = MetadataArena.AddUninitialized(Length);
+            Record.MetadataLength = Length;
+            FPlatformString::Convert(MetadataArena.GetData() + Record.MetadataOffset, Length, Metadata.GetData(), Metadata.Len());
+        }
+    }
+
+    if (DeadMetadataBytes >= MinDeadMetadataForCompaction && DeadMetadataBytes * 2 > MetadataArena.Num())
+    {
+        CompactMetadata();
+    }
+}
+
+void FAegisGUIDRegistry::CompactMetadata()
+{
+    TArray<UTF8CHAR> Compacted;
+    Compacted.Reserve(static_cast<int32>(MetadataArena.Num() - DeadMetadataBytes));
+
+    for (FRecord& Record : Records)
+    {
+        const int32 NewOffset = Compacted.Num();
+        Compacted.Append(MetadataArena.GetData() + Record.MetadataOffset, Record.MetadataLength);
+        Record.MetadataOffset = NewOffset;
+    }
+
+    MetadataArena = MoveTemp(Compacted);
+    DeadMetadataBytes = 0;
+}
+
+// ============================================================================
+// Lookup
+// ============================================================================
+
+int32 FAegisGUIDRegistry::FindRecord(FStringView GUID) const
+{
+    FKey Key;
+    const int32* Index = MakeKey(GUID, Key) ? ByKey.Find(Key) : ExternalLookup.Find(FString(GUID));
+    return Index ? *Index : INDEX_NONE;
+}
+
+FString FAegisGUIDRegistry::GetGUID(const FRecord& Record) const
+{
+    if (Record.ExternalIndex != INDEX_NONE)
+    {
+        return ExternalGUIDs[Record.ExternalIndex];
+    }
+
+    uint8 Bytes[sizeof(FKey::Words)];
+    FMemory::Memcpy(Bytes, Record.Key.Words, sizeof(Bytes));
+    return FAegisGUIDGenerator::FormatGUID(static_cast<EAegisGUIDNamespace>(Bytes[0]), Bytes + 1);
+}
+
+bool FAegisGUIDRegistry::Find(FStringView GUID, FEntryView& OutEntry) const
+{
+    const int32 Index = FindRecord(GUID);
+    if (Index == INDEX_NONE)
+    {
+        return false;
+    }
+
+    const FRecord& Record = Records[Index];
+    OutEntry.GUID = GetGUID(Record);
+    OutEntry.EntityPath = Record.EntityPath.ToString();
+    OutEntry.EntityType = Record.EntityType.ToString();
+    OutEntry.Metadata = FString(Record.MetadataLength, MetadataArena.GetData() + Record.MetadataOffset);
+    OutEntry.CreatedAt = FDateTime(Record.CreatedAtTicks);
+    OutEntry.Version = Record.Version;
+
+    int32 LastSlash;
+    OutEntry.EntityName = OutEntry.EntityPath.FindLastChar(TCHAR('/'), LastSlash) ? OutEntry.EntityPath.Mid(LastSlash + 1) : OutEntry.EntityPath;
+    return true;
+}
+
+bool FAegisGUIDRegistry::Contains(FStringView GUID) const
+{
+    return FindRecord(GUID) != INDEX_NONE;
+}
+
+FString FAegisGUIDRegistry::FindGUIDByPath(FStringView EntityPath) const
+{
+    if (EntityPath.Len() >= NAME_SIZE)
+    {
+        return FString();
+    }
+
+    // Unregistered paths never add to the name table
+    const FName Path(EntityPath.Len(), EntityPath.GetData(), FNAME_Find);
+    const int32* Index = Path.IsNone() ? nullptr : ByPath.Find(Path);
+    return Index ? GetGUID(Records[*Index]) : FString();
+}
+
+FString FAegisGUIDRegistry::FindPathByGUID(FStringView GUID) const
+{
+    const int32 Index = FindRecord(GUID);
+    return Index != INDEX_NONE ? Records[Index].EntityPath.ToString() : FString();
+}
+
+void FAegisGUIDRegistry::Empty()
+{
+    bDirty = bDirty || Records.Num() > 0;
+
+    Records.Empty();
+    ByKey.Empty();
+    ByPath.Empty();
+    ExternalGUIDs.Empty();
+    ExternalLookup.Empty();
+    MetadataArena.Empty();
+    DeadMetadataBytes = 0;
+}
+
+SIZE_T FAegisGUIDRegistry::GetAllocatedSize() const
+{
+    SIZE_T Size = Records.GetAllocatedSize() + ByKey.GetAllocatedSize() + ByPath.GetAllocatedSize() +
+        ExternalGUIDs.GetAllocatedSize() + ExternalLookup.GetAllocatedSize() + MetadataArena.GetAllocatedSize();
+    for (const FString& GUID : ExternalGUIDs)
+    {
+        // Held by both the array and the lookup
+        Size += GUID.GetAllocatedSize() * 2;
+    }
+    return Size;
+}
+
+// ============================================================================
+// Persistence
+// ============================================================================
+
+bool FAegisGUIDRegistry::Save(const FString& FilePath)
+{
+    const double StartTime = FPlatformTime::Seconds();
+
+    if (DeadMetadataBytes > 0)
+    {
+        CompactMetadata();
+    }
+
+    // Types repeat heavily, so records reference a table of them
+    TArray<FString> Types;
+    TMap<FName, int32> TypeIndices;
+    for (const FRecord& Record : Records)
+    {
+        if (!TypeIndices.Contains(Record.EntityType))
+        {
+            TypeIndices.Add(Record.EntityType, Types.Add(Record.EntityType.ToString()));
+        }
+    }
+
+    TArray<uint8> Data;
+    FMemoryWriter Ar(Data);
+
+    uint32 Magic = RegistryMagic;
+    int32 Version = RegistryVersion;
+    Ar << Magic << Version;
+    Ar << Types;
+    Ar << ExternalGUIDs;
+
+    int32 RecordCount = Records.Num();
+    Ar << RecordCount;
+    for (FRecord& Record : Records)
+    {
+        FString Path = Record.EntityPath.ToString();
+        int32 TypeIndex = TypeIndices[Record.EntityType];
+        Ar << Record.Key.Words[0] << Record.Key.Words[1] << Record.ExternalIndex;
+        Ar << Path << TypeIndex;
+        Ar << Record.CreatedAtTicks << Record.MetadataOffset << Record.MetadataLength << Record.Version;
+    }
+
+    int32 ArenaSize = MetadataArena.Num();
+    Ar << ArenaSize;
+    Ar.Serialize(MetadataArena.GetData(), ArenaSize);
+
+    // Write to a temporary file first so a crash never leaves a truncated registry behind
+    const FString TempPath = FilePath + TEXT(".tmp");
+    if (!FFileHelper::SaveArrayToFile(Data, *TempPath) || !IFileManager::Get().Move(*FilePath, *TempPath, true, true))
+    {
+        UE_LOG(LogAegisBridge, Error, TEXT("Failed to write GUID registry: %s"), *FilePath);
+        return false;
+    }
+
+    bDirty = false;
+    UE_LOG(LogAegisBridge, Log, TEXT("Saved %d GUIDs (%lld bytes) in %.2f ms"),
+        Records.Num(), static_cast<int64>(Data.Num()), (FPlatformTime::Seconds() - StartTime) * 1000.0);
+    return true;
+}
+
+bool FAegisGUIDRegistry::Load(const FString& FilePath)
+{
+    Empty();
+    bDirty = false;
+
+    if (!IFileManager::Get().FileExists(*FilePath))
+    {
+        return true;
+    }
+
+    TArray<uint8> Data;
+    if (!FFileHelper::LoadFileToArray(Data, *FilePath))
+    {
+        UE_LOG(LogAegisBridge, Error, TEXT("Failed to read GUID registry: %s"), *FilePath);
+        return false;
+    }
+
+    FMemoryReader Ar(Data);
+
+    uint32 Magic = 0;
+    int32 Version = 0;
+    Ar << Magic << Version;
+    if (Ar.IsError() || Magic != RegistryMagic || Version > RegistryVersion)
+    {
+        UE_LOG(LogAegisBridge, Error, TEXT("Unsupported GUID registry file: %s"), *FilePath);
+        return false;
+    }
+
+    TArray<FString> Types;
+    Ar << Types;
+    Ar << ExternalGUIDs;
+
+    TArray<FName> TypeNames;
+    TypeNames.Reserve(Types.Num());
+    for (const FString& Type : Types)
+    {
+        TypeNames.Add(FName(*Type));
+    }
+
+    int32 RecordCount = 0;
+    Ar << RecordCount;
+    if (RecordCount < 0 || static_cast<int64>(RecordCount) > Ar.TotalSize())
+    {
+        Ar.SetError();
+    }
+
+    bool bValid = !Ar.IsError();
+    if (bValid)
+    {
+        Records.Reserve(RecordCount);
+        ByKey.Reserve(RecordCount);
+        ByPath.Reserve(RecordCount);
+    }
+
+    for (int32 Index = 0; Index < RecordCount && bValid; ++Index)
+    {
+        FRecord& Record = Records.AddDefaulted_GetRef();
+        FString Path;
+        int32 TypeIndex = INDEX_NONE;
+        Ar << Record.Key.Words[0] << Record.Key.Words[1] << Record.ExternalIndex;
+        Ar << Path << TypeIndex;
+        Ar << Record.CreatedAtTicks << Record.MetadataOffset << Record.MetadataLength << Record.Version;
+
+        bValid = !Ar.IsError() && TypeNames.IsValidIndex(TypeIndex) && Path.Len() < NAME_SIZE &&
+            (Record.ExternalIndex == INDEX_NONE || ExternalGUIDs.IsValidIndex(Record.ExternalIndex));
+        if (!bValid)
+        {
+            break;
+        }
+
+        Record.EntityPath = FName(*Path);
+        Record.EntityType = TypeNames[TypeIndex];
+
+        if (Record.ExternalIndex == INDEX_NONE)
+        {
+            ByKey.Add(Record.Key, Index);
+        }
+        else
+        {
+            ExternalLookup.Add(ExternalGUIDs[Record.ExternalIndex], Index);
+        }
+        ByPath.Add(Record.EntityPath, Index);
+    }
+
+    int32 ArenaSize = 0;
+    if (bValid)
+    {
+        Ar << ArenaSize;
+        bValid = !Ar.IsError() && ArenaSize >= 0 && ArenaSize <= Ar.TotalSize() - Ar.Tell();
+    }
+    if (bValid)
+    {
+        MetadataArena.SetNumUninitialized(ArenaSize);
+        Ar.Serialize(MetadataArena.GetData(), ArenaSize);
+        bValid = !Ar.IsError();
+    }
+    for (int32 Index = 0; Index < Records.Num() && bValid; ++Index)
+    {
+        const FRecord& Record = Records[Index];
+        bValid = Record.MetadataOffset >= 0 && Record.MetadataLength >= 0 &&
+            static_cast<int64>(Record.MetadataOffset) + Record.MetadataLength <= ArenaSize;
+    }
+
+    if (!bValid)
+    {
+        UE_LOG(LogAegisBridge, Error, TEXT("Corrupt GUID registry file: %s"), *FilePath);
+        Empty();
+        bDirty = false;
+        return false;
+    }
+
+    UE_LOG(LogAegisBridge, Log, TEXT("Loaded %d GUIDs from %s"), Records.Num(), *FilePath);
+    return true;
+}
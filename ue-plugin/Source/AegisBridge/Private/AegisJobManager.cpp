@@ -0,0 +1,444 @@
+// Copyright AEGIS Team. All Rights Reserved.
+
+#include "AegisJobManager.h"
+#include "AegisBridgeModule.h"
+#include "AegisRemoteControlHandler.h"
+#include "AegisWebSocketServer.h"
+#include "Editor.h"
+#include "HAL/PlatformTime.h"
+#include "Misc/ConfigCacheIni.h"
+
+const TCHAR* LexToString(EAegisJobState State)
+{
+    switch (State)
+    {
+    case EAegisJobState::Queued: return TEXT("queued");
+    case EAegisJobState::Running: return TEXT("running");
+    case EAegisJobState::Succeeded: return TEXT("succeeded");
+    case EAegisJobState::Failed: return TEXT("failed");
+    case EAegisJobState::Cancelled: return TEXT("cancelled");
+    }
+    return TEXT("unknown");
+}
+
+namespace
+{
+    bool IsFinished(EAegisJobState State)
+    {
+        return State == EAegisJobState::Succeeded || State == EAegisJobState::Failed || State == EAegisJobState::Cancelled;
+    }
+}
+
+// ============================================================================
+// Context
+// ============================================================================
+
+FAegisJobContext::FAegisJobContext(FAegisJobRecord& InRecord, double InDeadline)
+    : Record(InRecord)
+    , Deadline(InDeadline)
+{
+}
+
+bool FAegisJobContext::ShouldYield() const
+{
+    return Record.bCancelRequested || FPlatformTime::Seconds() >= Deadline;
+}
+
+bool FAegisJobContext::IsCancelRequested() const
+{
+    return Record.bCancelRequested;
+}
+
+void FAegisJobContext::SetProgress(int64 Done, int64 Total, const FString& Stage)
+{
+    Record.Done = Done;
+    Record.Total = Total;
+    if (!Stage.IsEmpty())
+    {
+        Record.Stage = Stage;
+    }
+    Record.bProgressDirty = true;
+}
+
+void FAegisJobContext::EmitChunk(TFunctionRef<void(FAegisJsonWriter&)> WriteData)
+{
+    const int32 Index = Record.ChunkCount++;
+
+    UAegisWebSocketServer* WsServer = UAegisWebSocketServer::Get();
+    if (!WsServer)
+    {
+        return;
+    }
+
+    WsServer->BroadcastEvent(TEXT("job.chunk"), [this, Index, &WriteData](FAegisJsonWriter& Writer)
+    {
+        Writer.WriteObjectStart();
+        Writer.WriteValue(TEXT("jobId"), Record.JobId);
+        Writer.WriteValue(TEXT("index"), Index);
+        Writer.WriteIdentifierPrefix(TEXT("data"));
+        WriteData(Writer);
+        Writer.WriteObjectEnd();
+    });
+}
+
+void FAegisJobContext::Succeed(FString ResultJson)
+{
+    Record.Result = MoveTemp(ResultJson);
+    Record.State = EAegisJobState::Succeeded;
+}
+
+void FAegisJobContext::Fail(const FString& Error)
+{
+    Record.Error = Error;
+    Record.State = EAegisJobState::Failed;
+}
+
+// ============================================================================
+// Manager
+// ============================================================================
+
+UAegisJobManager* UAegisJobManager::Get()
+{
+    if (GEditor)
+    {
+        return GEditor->GetEditorSubsystem<UAegisJobManager>();
+    }
+    return nullptr;
+}
+
+void UAegisJobManager::Initialize(FSubsystemCollectionBase& Collection)
+{
+    Super::Initialize(Collection);
+
+    if (GConfig)
+    {
+        int32 TimeSliceMs = 0;
+        if (GConfig->GetInt(TEXT("AegisBridge"), TEXT("JobTimeSliceMs"), TimeSliceMs, GEngineIni) && TimeSliceMs > 0)
+        {
+            TimeSliceSeconds = TimeSliceMs / 1000.0;
+        }
+        int32 ProgressIntervalMs = 0;
+        if (GConfig->GetInt(TEXT("AegisBridge"), TEXT("JobProgressIntervalMs"), ProgressIntervalMs, GEngineIni) && ProgressIntervalMs >= 0)
+        {
+            ProgressIntervalSeconds = ProgressIntervalMs / 1000.0;
+        }
+        GConfig->GetDouble(TEXT("AegisBridge"), TEXT("JobRetentionSeconds"), RetentionSeconds, GEngineIni);
+        GConfig->GetInt(TEXT("AegisBridge"), TEXT("MaxRetainedJobs"), MaxRetainedJobs, GEngineIni);
+    }
+
+    RegisterAegisBridgeJobs(*this);
+
+    TickHandle = FTSTicker::GetCoreTicker().AddTicker(FTickerDelegate::CreateUObject(this, &UAegisJobManager::Tick));
+
+    UE_LOG(LogAegisBridge, Log, TEXT("AEGIS Job Manager initialized (%d kinds, %.1f ms per frame)"), Factories.Num(), TimeSliceSeconds * 1000.0);
+}
+
+void UAegisJobManager::Deinitialize()
+{
+    FTSTicker::GetCoreTicker().RemoveTicker(TickHandle);
+    TickHandle.Reset();
+
+    for (const TUniquePtr<FAegisJobRecord>& Record : Jobs)
+    {
+        if (Record->Job)
+        {
+            Record->Job->Cancel();
+        }
+    }
+    Jobs.Empty();
+    Factories.Empty();
+
+    Super::Deinitialize();
+}
+
+void UAegisJobManager::RegisterJobKind(FName Kind, FAegisJobFactory Factory)
+{
+    Factories.Add(Kind, MoveTemp(Factory));
+}
+
+FString UAegisJobManager::StartJob(FName Kind, const FAegisRequestParams& Params, FString& OutError)
+{
+    const FAegisJobFactory* Factory = Factories.Find(Kind);
+    if (!Factory)
+    {
+        OutError = FString::Printf(TEXT("Unknown job kind: %s"), *Kind.ToString());
+        return FString();
+    }
+
+    TUniquePtr<FAegisJob> Job = (*Factory)(Params, OutError);
+    if (!Job)
+    {
+        if (OutError.IsEmpty())
+        {
+            OutError = FString::Printf(TEXT("Invalid parameters for job kind %s"), *Kind.ToString());
+        }
+        return FString();
+    }
+
+    TUniquePtr<FAegisJobRecord>& Record = Jobs.Add_GetRef(MakeUnique<FAegisJobRecord>());
+    Record->JobId = FGuid::NewGuid().ToString(EGuidFormats::Digits);
+    Record->Kind = Kind;
+    Record->Job = MoveTemp(Job);
+    Record->CreatedTime = FPlatformTime::Seconds();
+
+    UE_LOG(LogAegisBridge, Log, TEXT("Started job %s (%s)"), *Record->JobId, *Kind.ToString());
+
+    // The first step runs on the next tick, after the starting request has returned
+    return Record->JobId;
+}
+
+bool UAegisJobManager::CancelJob(const FString& JobId)
+{
+    FAegisJobRecord* Record = const_cast<FAegisJobRecord*>(FindJob(JobId));
+    if (!Record || IsFinished(Record->State))
+    {
+        return false;
+    }
+
+    Record->bCancelRequested = true;
+    return true;
+}
+
+int32 UAegisJobManager::GetActiveJobCount() const
+{
+    int32 Count = 0;
+    for (const TUniquePtr<FAegisJobRecord>& Record : Jobs)
+    {
+        Count += IsFinished(Record->State) ? 0 : 1;
+    }
+    return Count;
+}
+
+bool UAegisJobManager::Tick(float DeltaTime)
+{
+    // Pruning happens here rather than in StartJob, which routed jobs may call mid-tick
+    PruneFinishedJobs();
+
+    const double Start = FPlatformTime::Seconds();
+    const double Deadline = Start + TimeSliceSeconds;
+
+    // Round-robin from where the last tick ran out of budget
+    const int32 JobCount = Jobs.Num();
+    for (int32 Offset = 0; Offset < JobCount; ++Offset)
+    {
+        const int32 Index = (NextJobIndex + Offset) % JobCount;
+        FAegisJobRecord& Record = *Jobs[Index];
+        if (IsFinished(Record.State))
+        {
+            continue;
+        }
+
+        if (FPlatformTime::Seconds() >= Deadline)
+        {
+            NextJobIndex = Index;
+            return true;
+        }
+
+        StepJob(Record, Deadline);
+    }
+
+    NextJobIndex = 0;
+    return true;
+}
+
+void UAegisJobManager::StepJob(FAegisJobRecord& Record, double Deadline)
+{
+    if (Record.bCancelRequested)
+    {
+        Record.Job->Cancel();
+        FinishJob(Record, EAegisJobState::Cancelled);
+        return;
+    }
+
+    Record.State = EAegisJobState::Running;
+
+    FAegisJobContext Context(Record, Deadline);
+    Record.Job->Step(Context);
+
+    if (IsFinished(Record.State))
+    {
+        FinishJob(Record, Record.State);
+        return;
+    }
+
+    // Progress events are throttled; completion always goes out
+    const double Now = FPlatformTime::Seconds();
+    if (Record.bProgressDirty && Now - Record.LastProgressTime >= ProgressIntervalSeconds)
+    {
+        Record.LastProgressTime = Now;
+        BroadcastProgress(Record);
+    }
+}
+
+void UAegisJobManager::FinishJob(FAegisJobRecord& Record, EAegisJobState State)
+{
+    Record.State = State;
+    Record.FinishedTime = FPlatformTime::Seconds();
+    Record.Job.Reset();
+
+    UE_LOG(LogAegisBridge, Log, TEXT("Job %s (%s) %s after %.2f s"), *Record.JobId, *Record.Kind.ToString(),
+        LexToString(State), Record.FinishedTime - Record.CreatedTime);
+
+    BroadcastCompleted(Record);
+}
+
+void UAegisJobManager::BroadcastProgress(FAegisJobRecord& Record)
+{
+    Record.bProgressDirty = false;
+
+    if (UAegisWebSocketServer* WsServer = UAegisWebSocketServer::Get())
+    {
+        WsServer->BroadcastEvent(TEXT("job.progress"), [&Record](FAegisJsonWriter& Writer)
+        {
+            Writer.WriteObjectStart();
+            WriteStatusFields(Record, Writer);
+            Writer.WriteObjectEnd();
+        });
+    }
+}
+
+void UAegisJobManager::BroadcastCompleted(const FAegisJobRecord& Record)
+{
+    UAegisWebSocketServer* WsServer = UAegisWebSocketServer::Get();
+    if (!WsServer)
+    {
+        return;
+    }
+
+    WsServer->BroadcastEvent(TEXT("job.completed"), [this, &Record](FAegisJsonWriter& Writer)
+    {
+        Writer.WriteObjectStart();
+        WriteStatusFields(Record, Writer);
+
+        // Large results stay on the editor side until GetJobResult pulls them
+        const bool bInline = !Record.Result.IsEmpty() && Record.Result.Len() <= MaxInlineResultChars;
+        Writer.WriteValue(TEXT("resultInline"), bInline);
+        Writer.WriteValue(TEXT("resultSize"), Record.Result.Len());
+        if (bInline)
+        {
+            AegisJson::WriteRawJson(Writer, TEXT("result"), Record.Result);
+        }
+        Writer.WriteObjectEnd();
+    });
+}
+
+void UAegisJobManager::PruneFinishedJobs()
+{
+    const double Now = FPlatformTime::Seconds();
+
+    int32 Finished = 0;
+    for (const TUniquePtr<FAegisJobRecord>& Record : Jobs)
+    {
+        Finished += IsFinished(Record->State) ? 1 : 0;
+    }
+
+    // Oldest first: expired jobs go, then the oldest finished ones beyond the cap
+    for (int32 Index = 0; Index < Jobs.Num();)
+    {
+        const FAegisJobRecord& Record = *Jobs[Index];
+        if (IsFinished(Record.State) && (Now - Record.FinishedTime > RetentionSeconds || Finished > MaxRetainedJobs))
+        {
+            --Finished;
+            Jobs.RemoveAt(Index);
+            NextJobIndex = 0;
+            continue;
+        }
+        ++Index;
+    }
+}
+
+void UAegisJobManager::WriteStatusFields(const FAegisJobRecord& Record, FAegisJsonWriter& Writer)
+{
+    Writer.WriteValue(TEXT("jobId"), Record.JobId);
+    Writer.WriteValue(TEXT("kind"), Record.Kind.ToString());
+    Writer.WriteValue(TEXT("state"), LexToString(Record.State));
+    Writer.WriteValue(TEXT("done"), Record.Done);
+    Writer.WriteValue(TEXT("total"), Record.Total);
+    Writer.WriteValue(TEXT("progress"), Record.Total > 0 ? FMath::Clamp(static_cast<double>(Record.Done) / Record.Total, 0.0, 1.0) : 0.0);
+    Writer.WriteValue(TEXT("stage"), Record.Stage);
+    Writer.WriteValue(TEXT("chunks"), Record.ChunkCount);
+    if (!Record.Error.IsEmpty())
+    {
+        Writer.WriteValue(TEXT("error"), Record.Error);
+    }
+}
+
+const FAegisJobRecord* UAegisJobManager::FindJob(const FString& JobId) const
+{
+    for (const TUniquePtr<FAegisJobRecord>& Record : Jobs)
+    {
+        if (Record->JobId == JobId)
+        {
+            return Record.Get();
+        }
+    }
+    return nullptr;
+}
+
+bool UAegisJobManager::WriteJobStatus(const FString& JobId, FAegisJsonWriter& Writer) const
+{
+    const FAegisJobRecord* Record = FindJob(JobId);
+    if (!Record)
+    {
+        return false;
+    }
+
+    Writer.WriteObjectStart();
+    WriteStatusFields(*Record, Writer);
+    Writer.WriteObjectEnd();
+    return true;
+}
+
+bool UAegisJobManager::WriteJobResult(const FString& JobId, FAegisJsonWriter& Writer) const
+{
+    const FAegisJobRecord* Record = FindJob(JobId);
+    if (!Record)
+    {
+        return false;
+    }
+
+    Writer.WriteObjectStart();
+    WriteStatusFields(*Record, Writer);
+    if (!Record->Result.IsEmpty())
+    {
+        AegisJson::WriteRawJson(Writer, TEXT("result"), Record->Result);
+    }
+    Writer.WriteObjectEnd();
+    return true;
+}
+
+void UAegisJobManager::WriteJobList(FAegisJsonWriter& Writer) const
+{
+    Writer.WriteArrayStart();
+    for (const TUniquePtr<FAegisJobRecord>& Record : Jobs)
+    {
+        Writer.WriteObjectStart();
+        WriteStatusFields(*Record, Writer);
+        Writer.WriteObjectEnd();
+    }
+    Writer.WriteArrayEnd();
+}
+
+FString UAegisJobManager::GetJob(const FString& JobId)
+{
+    FString Result;
+    TSharedRef<FAegisJsonWriter> Writer = FAegisJsonWriterFactory::Create(&Result);
+    if (!WriteJobStatus(JobId, *Writer))
+    {
+        return FString();
+    }
+    Writer->Close();
+    return Result;
+}
+
+FString UAegisJobManager::GetJobResult(const FString& JobId)
+{
+    FString Result;
+    TSharedRef<FAegisJsonWriter> Writer = FAegisJsonWriterFactory::Create(&Result);
+    if (!WriteJobResult(JobId, *Writer))
+    {
+        return FString();
+    }
+    Writer->Close();
+    return Result;
+}
@@ -0,0 +1,179 @@
+// Copyright AEGIS Team. All Rights Reserved.
+
+#include "AegisLandscapeCapture.h"
+#include "Async/ParallelFor.h"
+#include "Hash/xxhash.h"
+#include "LandscapeComponent.h"
+#include "LandscapeEdit.h"
+#include "LandscapeInfo.h"
+#include "LandscapeLayerInfoObject.h"
+#include "LandscapeProxy.h"
+#include "Serialization/Archive.h"
+
+namespace
+{
+    uint64 HashBuffer(const void* Data, int64 Size)
+    {
+        return FXxHash64::HashBuffer(Data, static_cast<uint64>(Size)).Hash;
+    }
+
+    uint64 HashHashes(const TArray<uint64>& Hashes)
+    {
+        return HashBuffer(Hashes.GetData(), Hashes.Num() * sizeof(uint64));
+    }
+}
+
+bool FAegisLandscapeCapture::Capture(ALandscapeProxy* Proxy, bool bLayers, bool bKeepData)
+{
+    Tiles.Reset();
+    Layers.Reset();
+    HeightHash = 0;
+
+    ULandscapeInfo* Info = Proxy ? Proxy->GetLandscapeInfo() : nullptr;
+    if (!Info)
+    {
+        return false;
+    }
+
+    ProxyPath = Proxy->GetPathName();
+    LandscapeGuid = Proxy->GetLandscapeGuid();
+    ComponentSizeQuads = Info->ComponentSizeQuads;
+
+    TArray<ULandscapeLayerInfoObject*> LayerInfos;
+    if (bLayers)
+    {
+        for (const FLandscapeInfoLayerSettings& LayerSettings : Info->Layers)
+        {
+            if (LayerSettings.LayerInfoObj)
+            {
+                FLayer& Layer = Layers.AddDefaulted_GetRef();
+                Layer.Name = LayerSettings.GetLayerName();
+                Layer.LayerInfoPath = LayerSettings.LayerInfoObj->GetPathName();
+                LayerInfos.Add(LayerSettings.LayerInfoObj);
+            }
+        }
+    }
+
+    // Read-only access: nothing is written back, so nothing needs uploading
+    FLandscapeEditDataInterface DataInterface(Info, false);
+
+    for (ULandscapeComponent* Component : Proxy->LandscapeComponents)
+    {
+        if (!Component)
+        {
+            continue;
+        }
+
+        FAegisLandscapeTile& Tile = Tiles.AddDefaulted_GetRef();
+        Tile.Origin = FIntPoint(Component->SectionBaseX, Component->SectionBaseY);
+        Tile.Size = Component->ComponentSizeQuads + 1;
+
+        const int32 X1 = Tile.Origin.X;
+        const int32 Y1 = Tile.Origin.Y;
+        const int32 X2 = X1 + Component->ComponentSizeQuads;
+        const int32 Y2 = Y1 + Component->ComponentSizeQuads;
+        const int32 SampleCount = Tile.Size * Tile.Size;
+
+        // The fast reads leave missing samples untouched, so holes hash as zero
+        Tile.Heights.SetNumZeroed(SampleCount);
+        DataInterface.GetHeightDataFast(X1, Y1, X2, Y2, Tile.Heights.GetData(), 0);
+
+        Tile.Weights.SetNumZeroed(SampleCount * LayerInfos.Num());
+        for (int32 LayerIndex = 0; LayerIndex < LayerInfos.Num(); ++LayerIndex)
+        {
+            DataInterface.GetWeightDataFast(LayerInfos[LayerIndex], X1, Y1, X2, Y2, Tile.Weights.GetData() + LayerIndex * SampleCount, 0);
+        }
+    }
+
+    // Component order is not stable across loads
+    Tiles.Sort([](const FAegisLandscapeTile& A, const FAegisLandscapeTile& B)
+    {
+        return A.Origin.Y != B.Origin.Y ? A.Origin.Y < B.Origin.Y : A.Origin.X < B.Origin.X;
+    });
+
+    const int32 LayerCount = Layers.Num();
+    ParallelFor(Tiles.Num(), [this, LayerCount, bKeepData](int32 TileIndex)
+    {
+        FAegisLandscapeTile& Tile = Tiles[TileIndex];
+        const int32 SampleCount = Tile.Size * Tile.Size;
+
+        TArray<uint64> TileHashes;
+        TileHashes.Reserve(LayerCount + 1);
+
+        Tile.HeightHash = HashBuffer(Tile.Heights.GetData(), Tile.Heights.Num() * sizeof(uint16));
+        TileHashes.Add(Tile.HeightHash);
+
+        Tile.LayerHashes.SetNumUninitialized(LayerCount);
+        for (int32 LayerIndex = 0; LayerIndex < LayerCount; ++LayerIndex)
+        {
+            Tile.LayerHashes[LayerIndex] = HashBuffer(Tile.Weights.GetData() + LayerIndex * SampleCount, SampleCount);
+            TileHashes.Add(Tile.LayerHashes[LayerIndex]);
+        }
+
+        Tile.Hash = HashHashes(TileHashes);
+
+        if (!bKeepData)
+        {
+            Tile.Heights.Empty();
+            Tile.Weights.Empty();
+        }
+    });
+
+    TArray<uint64> Hashes;
+    Hashes.SetNumUninitialized(Tiles.Num());
+    for (int32 TileIndex = 0; TileIndex < Tiles.Num(); ++TileIndex)
+    {
+        Hashes[TileIndex] = Tiles[TileIndex].HeightHash;
+    }
+    HeightHash = HashHashes(Hashes);
+
+    for (int32 LayerIndex = 0; LayerIndex < LayerCount; ++LayerIndex)
+    {
+        for (int32 TileIndex = 0; TileIndex < Tiles.Num(); ++TileIndex)
+        {
+            Hashes[TileIndex] = Tiles[TileIndex].LayerHashes[LayerIndex];
+        }
+        Layers[LayerIndex].Hash = HashHashes(Hashes);
+    }
+
+    return true;
+}
+
+FString FAegisLandscapeCapture::GetTileKey(const FAegisLandscapeTile& Tile) const
+{
+    return FString::Printf(TEXT("%s:%d,%d"), *LandscapeGuid.ToString(EGuidFormats::Digits), Tile.Origin.X, Tile.Origin.Y);
+}
+
+FString FAegisLandscapeCapture::HashToString(uint64 Hash)
+{
+    return FString::Printf(TEXT("%016llx"), Hash);
+}
+
+void FAegisLandscapeCapture::SerializeTiles(FArchive& Ar, TConstArrayView<int32> TileIndices) const
+{
+    FString Path = ProxyPath;
+    int32 QuadCount = ComponentSizeQuads;
+    Ar << Path << QuadCount;
+
+    int32 LayerCount = Layers.Num();
+    Ar << LayerCount;
+    for (const FLayer& Layer : Layers)
+    {
+        FString LayerName = Layer.Name.ToString();
+        Ar << LayerName;
+    }
+
+    int32 TileCount = TileIndices.Num();
+    Ar << TileCount;
+    for (int32 TileIndex : TileIndices)
+    {
+        const FAegisLandscapeTile& Tile = Tiles[TileIndex];
+        check(Tile.Heights.Num() == Tile.Size * Tile.Size);
+
+        FIntPoint Origin = Tile.Origin;
+        int32 Size = Tile.Size;
+        Ar << Origin << Size;
+        Ar.Serialize(const_cast<uint16*>(Tile.Heights.GetData()), Tile.Heights.Num() * sizeof(uint16));
+        Ar.Serialize(const_cast<uint8*>(Tile.Weights.GetData()), Tile.Weights.Num());
+    }
+}
@@ -0,0 +1,656 @@
+// Copyright AEGIS Team. All Rights Reserved.
+
+#include "AegisMessagePack.h"
+#include "AegisJsonWriter.h"
+
+namespace
+{
+    /** Nesting limit for both directions; bridge messages stay far below it */
+    constexpr int32 MaxDepth = 128;
+
+    // ========================================================================
+    // JSON -> MessagePack
+    // ========================================================================
+
+    class FJsonToMessagePack
+    {
+    public:
+        FJsonToMessagePack(const FString& Json, TArray<uint8>& InOut)
+            : Cursor(*Json)
+            , End(*Json + Json.Len())
+            , Out(InOut)
+        {
+        }
+
+        bool Run()
+        {
+            SkipWhitespace();
+            if (!Value(0))
+            {
+                return false;
+            }
+            SkipWhitespace();
+            return Cursor == End;
+        }
+
+    private:
+        void SkipWhitespace()
+        {
+            while (Cursor < End && (*Cursor == TCHAR(' ') || *Cursor == TCHAR('\t') || *Cursor == TCHAR('\n') || *Cursor == TCHAR('\r')))
+            {
+                ++Cursor;
+            }
+        }
+
+        bool Consume(const TCHAR* Literal)
+        {
+            const TCHAR* Probe = Cursor;
+            for (; *Literal; ++Literal, ++Probe)
+            {
+                if (Probe >= End || *Probe != *Literal)
+                {
+                    return false;
+                }
+            }
+            Cursor = Probe;
+            return true;
+        }
+
+        void WriteByte(uint8 Byte)
+        {
+            Out.Add(Byte);
+        }
+
+        void WriteBigEndian(uint64 Value, int32 Bytes)
+        {
+            for (int32 Shift = (Bytes - 1) * 8; Shift >= 0; Shift -= 8)
+            {
+                Out.Add(static_cast<uint8>(Value >> Shift));
+            }
+        }
+
+        /** Reserve a 32-bit container header; FinishContainer shrinks it once the count is known */
+        int32 BeginContainer()
+        {
+            const int32 HeaderPos = Out.Num();
+            Out.AddZeroed(5);
+            return HeaderPos;
+        }
+
+        void FinishContainer(int32 HeaderPos, uint32 Count, uint8 FixBase, uint8 Code16, uint8 Code32)
+        {
+            if (Count < 16)
+            {
+                Out[HeaderPos] = FixBase | static_cast<uint8>(Count);
+                Out.RemoveAt(HeaderPos + 1, 4, false);
+            }
+            else if (Count <= 0xFFFF)
+            {
+                Out[HeaderPos] = Code16;
+                Out[HeaderPos + 1] = static_cast<uint8>(Count >> 8);
+                Out[HeaderPos + 2] = static_cast<uint8>(Count);
+                Out.RemoveAt(HeaderPos + 3, 2, false);
+            }
+            else
+            {
+                Out[HeaderPos] = Code32;
+                for (int32 Index = 0; Index < 4; ++Index)
+                {
+                    Out[HeaderPos + 1 + Index] = static_cast<uint8>(Count >> (24 - Index * 8));
+                }
+            }
+        }
+
+        bool Value(int32 Depth)
+        {
+            if (Cursor >= End || Depth > MaxDepth)
+            {
+                return false;
+            }
+
+            switch (*Cursor)
+            {
+            case TCHAR('{'): return Object(Depth);
+            case TCHAR('['): return Array(Depth);
+            case TCHAR('"'): return String();
+            case TCHAR('t'): WriteByte(0xc3); return Consume(TEXT("true"));
+            case TCHAR('f'): WriteByte(0xc2); return Consume(TEXT("false"));
+            case TCHAR('n'): WriteByte(0xc0); return Consume(TEXT("null"));
+            default: return Number();
+            }
+        }
+
+        bool Object(int32 Depth)
+        {
+            ++Cursor;
+            const int32 HeaderPos = BeginContainer();
+            uint32 Count = 0;
+
+            SkipWhitespace();
+            if (Cursor < End && *Cursor == TCHAR('}'))
+            {
+                ++Cursor;
+                FinishContainer(HeaderPos, 0, 0x80, 0xde, 0xdf);
+                return true;
+            }
+
+            while (true)
+            {
+                SkipWhitespace();
+                if (Cursor >= End || *Cursor != TCHAR('"') || !String())
+                {
+                    return false;
+                }
+
+                SkipWhitespace();
+                if (!Consume(TEXT(":")))
+                {
+                    return false;
+                }
+
+                SkipWhitespace();
+                if (!Value(Depth + 1))
+                {
+                    return false;
+                }
+                ++Count;
+
+                SkipWhitespace();
+                if (Consume(TEXT(",")))
+                {
+                    continue;
+                }
+                if (Consume(TEXT("}")))
+                {
+                    break;
+                }
+                return false;
+            }
+
+            FinishContainer(HeaderPos, Count, 0x80, 0xde, 0xdf);
+            return true;
+        }
+
+        bool Array(int32 Depth)
+        {
+            ++Cursor;
+            const int32 HeaderPos = BeginContainer();
+            uint32 Count = 0;
+
+            SkipWhitespace();
+            if (Cursor < End && *Cursor == TCHAR(']'))
+            {
+                ++Cursor;
+                FinishContainer(HeaderPos, 0, 0x90, 0xdc, 0xdd);
+                return true;
+            }
+
+            while (true)
+            {
+                SkipWhitespace();
+                if (!Value(Depth + 1))
+                {
+                    return false;
+                }
+                ++Count;
+
+                SkipWhitespace();
+                if (Consume(TEXT(",")))
+                {
+                    continue;
+                }
+                if (Consume(TEXT("]")))
+                {
+                    break;
+                }
+                return false;
+            }
+
+            FinishContainer(HeaderPos, Count, 0x90, 0xdc, 0xdd);
+            return true;
+        }
+
+        static int32 HexDigit(TCHAR Char)
+        {
+            if (Char >= TCHAR('0') && Char <= TCHAR('9')) return Char - TCHAR('0');
+            if (Char >= TCHAR('a') && Char <= TCHAR('f')) return Char - TCHAR('a') + 10;
+            if (Char >= TCHAR('A') && Char <= TCHAR('F')) return Char - TCHAR('A') + 10;
+            return -1;
+        }
+
+        bool String()
+        {
+            ++Cursor;
+            Scratch.Reset();
+
+            // Runs without escapes are copied in one go
+            const TCHAR* RunStart = Cursor;
+            while (true)
+            {
+                if (Cursor >= End)
+                {
+                    return false;
+                }
+
+                const TCHAR Char = *Cursor;
+                if (Char == TCHAR('"'))
+                {
+                    Scratch.AppendChars(RunStart, static_cast<int32>(Cursor - RunStart));
+                    ++Cursor;
+                    break;
+                }
+                if (Char != TCHAR('\\'))
+                {
+                    ++Cursor;
+                    continue;
+                }
+
+                Scratch.AppendChars(RunStart, static_cast<int32>(Cursor - RunStart));
+                if (++Cursor >= End)
+                {
+                    return false;
+                }
+
+                switch (*Cursor++)
+                {
+                case TCHAR('"'): Scratch.AppendChar(TCHAR('"')); break;
+                case TCHAR('\\'): Scratch.AppendChar(TCHAR('\\')); break;
+                case TCHAR('/'): Scratch.AppendChar(TCHAR('/')); break;
+                case TCHAR('b'): Scratch.AppendChar(TCHAR('\b')); break;
+                case TCHAR('f'): Scratch.AppendChar(TCHAR('\f')); break;
+                case TCHAR('n'): Scratch.AppendChar(TCHAR('\n')); break;
+                case TCHAR('r'): Scratch.AppendChar(TCHAR('\r')); break;
+                case TCHAR('t'): Scratch.AppendChar(TCHAR('\t')); break;
+                case TCHAR('u'):
+                {
+                    if (End - Cursor < 4)
+                    {
+                        return false;
+                    }
+                    int32 CodeUnit = 0;
+                    for (int32 Index = 0; Index < 4; ++Index)
+                    {
+                        const int32 Digit = HexDigit(*Cursor++);
+                        if (Digit < 0)
+                        {
+                            return false;
+                        }
+                        CodeUnit = (CodeUnit << 4) | Digit;
+                    }
+                    // Surrogate pairs are kept as code units; the UTF-8 conversion joins them
+                    Scratch.AppendChar(static_cast<TCHAR>(CodeUnit));
+                    break;
+                }
+                default:
+                    return false;
+                }
+                RunStart = Cursor;
+            }
+
+            const FTCHARToUTF8 Converted(*Scratch, Scratch.Len());
+            const uint32 Length = static_cast<uint32>(Converted.Length());
+            if (Length < 32)
+            {
+                WriteByte(0xa0 | static_cast<uint8>(Length));
+            }
+            else if (Length <= 0xFF)
+            {
+                WriteByte(0xd9);
+                WriteBigEndian(Length, 1);
+            }
+            else if (Length <= 0xFFFF)
+            {
+                WriteByte(0xda);
+                WriteBigEndian(Length, 2);
+            }
+            else
+            {
+                WriteByte(0xdb);
+                WriteBigEndian(Length, 4);
+            }
+            Out.Append(reinterpret_cast<const uint8*>(Converted.Get()), Length);
+            return true;
+        }
+
+        bool Number()
+        {
+            const TCHAR* Start = Cursor;
+            bool bIntegral = true;
+            while (Cursor < End)
+            {
+                const TCHAR Char = *Cursor;
+                if (Char == TCHAR('.') || Char == TCHAR('e') || Char == TCHAR('E'))
+                {
+                    bIntegral = false;
+                }
+                else if (!(FChar::IsDigit(Char) || Char == TCHAR('-') || Char == TCHAR('+')))
+                {
+                    break;
+                }
+                ++Cursor;
+            }
+
+            const int32 Length = static_cast<int32>(Cursor - Start);
+            if (Length == 0 || Length > 64)
+            {
+                return false;
+            }
+
+            TCHAR Buffer[65];
+            FMemory::Memcpy(Buffer, Start, Length * sizeof(TCHAR));
+            Buffer[Length] = TCHAR('\0');
+
+            // Integers beyond 18 digits may not fit an int64; they travel as doubles
+            const bool bNegative = Buffer[0] == TCHAR('-');
+            if (bIntegral && Length - (bNegative ? 1 : 0) <= 18)
+            {
+                WriteInteger(FCString::Atoi64(Buffer));
+                return true;
+            }
+
+            WriteDouble(FCString::Atod(Buffer));
+            return true;
+        }
+
+        void WriteInteger(int64 Value)
+        {
+            if (Value >= 0)
+            {
+                if (Value < 128) { WriteByte(static_cast<uint8>(Value)); }
+                else if (Value <= 0xFF) { WriteByte(0xcc); WriteBigEndian(Value, 1); }
+                else if (Value <= 0xFFFF) { WriteByte(0xcd); WriteBigEndian(Value, 2); }
+                else if (Value <= 0xFFFFFFFFll) { WriteByte(0xce); WriteBigEndian(Value, 4); }
+                else { WriteByte(0xcf); WriteBigEndian(Value, 8); }
+            }
+            else
+            {
+                if (Value >= -32) { WriteByte(static_cast<uint8>(static_cast<int8>(Value))); }
+                else if (Value >= MIN_int8) { WriteByte(0xd0); WriteBigEndian(static_cast<uint64>(Value), 1); }
+                else if (Value >= MIN_int16) { WriteByte(0xd1); WriteBigEndian(static_cast<uint64>(Value), 2); }
+                else if (Value >= MIN_int32) { WriteByte(0xd2); WriteBigEndian(static_cast<uint64>(Value), 4); }
+                else { WriteByte(0xd3); WriteBigEndian(static_cast<uint64>(Value), 8); }
+            }
+        }
+
+        void WriteDouble(double Value)
+        {
+            // Transform components are mostly exact floats, which halves their size
+            const float Narrowed = static_cast<float>(Value);
+            if (static_cast<double>(Narrowed) == Value)
+            {
+                uint32 Bits;
+                FMemory::Memcpy(&Bits, &Narrowed, sizeof(Bits));
+                WriteByte(0xca);
+                WriteBigEndian(Bits, 4);
+            }
+            else
+            {
+                uint64 Bits;
+                FMemory::Memcpy(&Bits, &Value, sizeof(Bits));
+                WriteByte(0xcb);
+                WriteBigEndian(Bits, 8);
+            }
+        }
+
+    private:
+        const TCHAR* Cursor;
+        const TCHAR* End;
+        TArray<uint8>& Out;
+
+        /** Unescaped string, reused across strings */
+        FString Scratch;
+    };
+
+    // ========================================================================
+    // MessagePack -> JSON
+    // ========================================================================
+
+    class FMessagePackToJson
+    {
+    public:
+        FMessagePackToJson(const uint8* InData, int32 Size, FAegisJsonWriter& InWriter)
+            : Cursor(InData)
+            , End(InData + Size)
+            , Writer(InWriter)
+        {
+        }
+
+        bool Run()
+        {
+            return Value(nullptr, 0) && Cursor == End;
+        }
+
+    private:
+        bool Read(uint64& OutValue, int32 Bytes)
+        {
+            if (End - Cursor < Bytes)
+            {
+                return false;
+            }
+            OutValue = 0;
+            for (int32 Index = 0; Index < Bytes; ++Index)
+            {
+                OutValue = (OutValue << 8) | *Cursor++;
+            }
+            return true;
+        }
+
+        bool ReadString(uint64 Length, FString& OutString)
+        {
+            if (static_cast<uint64>(End - Cursor) < Length)
+            {
+                return false;
+            }
+            const FUTF8ToTCHAR Converted(reinterpret_cast<const ANSICHAR*>(Cursor), static_cast<int32>(Length));
+            OutString = FString(Converted.Length(), Converted.Get());
+            Cursor += Length;
+            return true;
+        }
+
+        template <typename ValueType>
+        void Emit(const FString* Key, ValueType Value)
+        {
+            if (Key)
+            {
+                Writer.WriteValue(*Key, Value);
+            }
+            else
+            {
+                Writer.WriteValue(Value);
+            }
+        }
+
+        void EmitNull(const FString* Key)
+        {
+            if (Key)
+            {
+                Writer.WriteNull(*Key);
+            }
+            else
+            {
+                Writer.WriteNull();
+            }
+        }
+
+        bool Map(const FString* Key, uint64 Count, int32 Depth)
+        {
+            if (Key) { Writer.WriteObjectStart(*Key); } else { Writer.WriteObjectStart(); }
+
+            FString EntryKey;
+            for (uint64 Index = 0; Index < Count; ++Index)
+            {
+                if (!MapKey(EntryKey) || !Value(&EntryKey, Depth + 1))
+                {
+                    return false;
+                }
+            }
+
+            Writer.WriteObjectEnd();
+            return true;
+        }
+
+        bool Array(const FString* Key, uint64 Count, int32 Depth)
+        {
+            if (Key) { Writer.WriteArrayStart(*Key); } else { Writer.WriteArrayStart(); }
+
+            for (uint64 Index = 0; Index < Count; ++Index)
+            {
+                if (!Value(nullptr, Depth + 1))
+                {
+                    return false;
+                }
+            }
+
+            Writer.WriteArrayEnd();
+            return true;
+        }
+
+        /** JSON keys are strings; integer keys are accepted and printed */
+        bool MapKey(FString& OutKey)
+        {
+            if (Cursor >= End)
+            {
+                return false;
+            }
+
+            const uint8 Code = *Cursor++;
+            uint64 Length = 0;
+            if ((Code & 0xe0) == 0xa0) { return ReadString(Code & 0x1f, OutKey); }
+            if (Code == 0xd9) { return Read(Length, 1) && ReadString(Length, OutKey); }
+            if (Code == 0xda) { return Read(Length, 2) && ReadString(Length, OutKey); }
+            if (Code == 0xdb) { return Read(Length, 4) && ReadString(Length, OutKey); }
+            if (Code < 0x80) { OutKey = FString::FromInt(Code); return true; }
+            return false;
+        }
+
+        bool Value(const FString* Key, int32 Depth)
+        {
+            if (Cursor >= End || Depth > MaxDepth)
+            {
+                return false;
+            }
+
+            const uint8 Code = *Cursor++;
+            uint64 Raw = 0;
+
+            if (Code < 0x80) { Emit(Key, static_cast<int64>(Code)); return true; }
+            if (Code >= 0xe0) { Emit(Key, static_cast<int64>(static_cast<int8>(Code))); return true; }
+            if ((Code & 0xf0) == 0x80) { return Map(Key, Code & 0x0f, Depth); }
+            if ((Code & 0xf0) == 0x90) { return Array(Key, Code & 0x0f, Depth); }
+
+            if ((Code & 0xe0) == 0xa0)
+            {
+                FString String;
+                if (!ReadString(Code & 0x1f, String)) return false;
+                Emit(Key, String);
+                return true;
+            }
+
+            switch (Code)
+            {
+            case 0xc0: EmitNull(Key); return true;
+            case 0xc2: Emit(Key, false); return true;
+            case 0xc3: Emit(Key, true); return true;
+
+            case 0xca:
+            {
+                if (!Read(Raw, 4)) return false;
+                const uint32 Bits = static_cast<uint32>(Raw);
+                float Float;
+                FMemory::Memcpy(&Float, &Bits, sizeof(Float));
+                Emit(Key, static_cast<double>(Float));
+                return true;
+            }
+            case 0xcb:
+            {
+                if (!Read(Raw, 8)) return false;
+                double Double;
+                FMemory::Memcpy(&Double, &Raw, sizeof(Double));
+                Emit(Key, Double);
+                return true;
+            }
+
+            case 0xcc: if (!Read(Raw, 1)) return false; Emit(Key, static_cast<int64>(Raw)); return true;
+            case 0xcd: if (!Read(Raw, 2)) return false; Emit(Key, static_cast<int64>(Raw)); return true;
+            case 0xce: if (!Read(Raw, 4)) return false; Emit(Key, static_cast<int64>(Raw)); return true;
+            case 0xcf:
+                if (!Read(Raw, 8)) return false;
+                if (Raw > static_cast<uint64>(MAX_int64)) { Emit(Key, static_cast<double>(Raw)); }
+                else { Emit(Key, static_cast<int64>(Raw)); }
+                return true;
+
+            case 0xd0: if (!Read(Raw, 1)) return false; Emit(Key, static_cast<int64>(static_cast<int8>(Raw))); return true;
+            case 0xd1: if (!Read(Raw, 2)) return false; Emit(Key, static_cast<int64>(static_cast<int16>(Raw))); return true;
+            case 0xd2: if (!Read(Raw, 4)) return false; Emit(Key, static_cast<int64>(static_cast<int32>(Raw))); return true;
+            case 0xd3: if (!Read(Raw, 8)) return false; Emit(Key, static_cast<int64>(Raw)); return true;
+
+            case 0xd9:
+            case 0xda:
+            case 0xdb:
+            {
+                FString String;
+                const int32 Bytes = Code == 0xd9 ? 1 : (Code == 0xda ? 2 : 4);
+                if (!Read(Raw, Bytes) || !ReadString(Raw, String)) return false;
+                Emit(Key, String);
+                return true;
+            }
+
+            case 0xdc: return Read(Raw, 2) && Array(Key, Raw, Depth);
+            case 0xdd: return Read(Raw, 4) && Array(Key, Raw, Depth);
+            case 0xde: return Read(Raw, 2) && Map(Key, Raw, Depth);
+            case 0xdf: return Read(Raw, 4) && Map(Key, Raw, Depth);
+
+            default:
+                // bin and ext carry nothing the JSON protocol could express
+                return false;
+            }
+        }
+
+    private:
+        const uint8* Cursor;
+        const uint8* End;
+        FAegisJsonWriter& Writer;
+    };
+}
+
+bool FAegisMessagePack::FromJson(const FString& Json, TArray<uint8>& OutPacked)
+{
+    OutPacked.Reset();
+
+    // Packed frames are rarely larger than half the UTF-16 source
+    OutPacked.Reserve(Json.Len());
+
+    FJsonToMessagePack Transcoder(Json, OutPacked);
+    return Transcoder.Run();
+}
+
+bool FAegisMessagePack::ToJson(const uint8* Data, int32 Size, FString& OutJson)
+{
+    OutJson.Reset();
+    if (!Data || Size <= 0)
+    {
+        return false;
+    }
+
+    TSharedRef<FAegisJsonWriter> Writer = FAegisJsonWriterFactory::Create(&OutJson);
+    FMessagePackToJson Transcoder(Data, Size, *Writer);
+    if (!Transcoder.Run())
+    {
+        OutJson.Reset();
+        return false;
+    }
+
+    Writer->Close();
+    return true;
+}
+
+bool FAegisMessagePack::IsMessagePack(const uint8* Data, int32 Size)
+{
+    if (!Data || Size <= 0)
+    {
+        return false;
+    }
+
+    const uint8 Code = Data[0];
+    return (Code & 0xf0) == 0x80 || Code == 0xde || Code == 0xdf;
+}
@@ -0,0 +1,247 @@
+// Copyright AEGIS Team. All Rights Reserved.
+
+#include "AegisParallelJson.h"
+#include "Async/ParallelFor.h"
+#include "Dom/JsonObject.h"
+#include "Dom/JsonValue.h"
+#include "Serialization/JsonReader.h"
+#include "Serialization/JsonSerializer.h"
+#include <atomic>
+
+namespace
+{
+    bool IsJsonWhitespace(TCHAR Char)
+    {
+        return Char == TCHAR(' ') || Char == TCHAR('\t') || Char == TCHAR('\n') || Char == TCHAR('\r');
+    }
+
+    int32 SkipWhitespace(FStringView Json, int32 Pos)
+    {
+        while (Pos < Json.Len() && IsJsonWhitespace(Json[Pos]))
+        {
+            ++Pos;
+        }
+        return Pos;
+    }
+
+    /** Position after the string starting at Pos, or INDEX_NONE if it is unterminated */
+    int32 ScanString(FStringView Json, int32 Pos)
+    {
+        for (++Pos; Pos < Json.Len(); ++Pos)
+        {
+            if (Json[Pos] == TCHAR('\\'))
+            {
+                ++Pos;
+            }
+            else if (Json[Pos] == TCHAR('"'))
+            {
+                return Pos + 1;
+            }
+        }
+        return INDEX_NONE;
+    }
+
+    /**
+     * Position after the value starting at Pos, or INDEX_NONE. Only structure is checked here;
+     * the element parser validates the contents.
+     */
+    int32 ScanValue(FStringView Json, int32 Pos)
+    {
+        if (Pos >= Json.Len())
+        {
+            return INDEX_NONE;
+        }
+
+        const TCHAR First = Json[Pos];
+        if (First == TCHAR('"'))
+        {
+            return ScanString(Json, Pos);
+        }
+
+        if (First == TCHAR('{') || First == TCHAR('['))
+        {
+            int32 Depth = 0;
+            while (Pos < Json.Len())
+            {
+                const TCHAR Char = Json[Pos];
+                if (Char == TCHAR('"'))
+                {
+                    Pos = ScanString(Json, Pos);
+                    if (Pos == INDEX_NONE)
+                    {
+                        return INDEX_NONE;
+                    }
+                    continue;
+                }
+
+                if (Char == TCHAR('{') || Char == TCHAR('['))
+                {
+                    ++Depth;
+                }
+                else if (Char == TCHAR('}') || Char == TCHAR(']'))
+                {
+                    if (--Depth == 0)
+                    {
+                        return Pos + 1;
+                    }
+                }
+                ++Pos;
+            }
+            return INDEX_NONE;
+        }
+
+        // Numbers, true, false, null
+        const int32 Start = Pos;
+        while (Pos < Json.Len() && !IsJsonWhitespace(Json[Pos]) && Json[Pos] != TCHAR(',') && Json[Pos] != TCHAR(']') && Json[Pos] != TCHAR('}'))
+        {
+            ++Pos;
+        }
+        return Pos > Start ? Pos : INDEX_NONE;
+    }
+
+    /** Consume the separator after a member or element: true and Pos past ',' or at the closer */
+    bool ScanSeparator(FStringView Json, int32& Pos, TCHAR Closer, bool& bOutClosed)
+    {
+        Pos = SkipWhitespace(Json, Pos);
+        if (Pos >= Json.Len())
+        {
+            return false;
+        }
+        if (Json[Pos] == TCHAR(','))
+        {
+            ++Pos;
+            bOutClosed = false;
+            return true;
+        }
+        if (Json[Pos] == Closer)
+        {
+            ++Pos;
+            bOutClosed = true;
+            return true;
+        }
+        return false;
+    }
+}
+
+bool FAegisParallelJson::SplitArray(FStringView Json, TArray<FStringView>& OutElements)
+{
+    int32 Pos = SkipWhitespace(Json, 0);
+    if (Pos >= Json.Len() || Json[Pos] != TCHAR('['))
+    {
+        return false;
+    }
+
+    Pos = SkipWhitespace(Json, Pos + 1);
+    if (Pos < Json.Len() && Json[Pos] == TCHAR(']'))
+    {
+        return SkipWhitespace(Json, Pos + 1) == Json.Len();
+    }
+
+    bool bClosed = false;
+    while (!bClosed)
+    {
+        Pos = SkipWhitespace(Json, Pos);
+        const int32 End = ScanValue(Json, Pos);
+        if (End == INDEX_NONE)
+        {
+            return false;
+        }
+        OutElements.Add(Json.Mid(Pos, End - Pos));
+
+        Pos = End;
+        if (!ScanSeparator(Json, Pos, TCHAR(']'), bClosed))
+        {
+            return false;
+        }
+    }
+
+    return SkipWhitespace(Json, Pos) == Json.Len();
+}
+
+bool FAegisParallelJson::SplitObject(FStringView Json, TArray<TPair<FStringView, FStringView>>& OutMembers)
+{
+    int32 Pos = SkipWhitespace(Json, 0);
+    if (Pos >= Json.Len() || Json[Pos] != TCHAR('{'))
+    {
+        return false;
+    }
+
+    Pos = SkipWhitespace(Json, Pos + 1);
+    if (Pos < Json.Len() && Json[Pos] == TCHAR('}'))
+    {
+        return SkipWhitespace(Json, Pos + 1) == Json.Len();
+    }
+
+    bool bClosed = false;
+    while (!bClosed)
+    {
+        Pos = SkipWhitespace(Json, Pos);
+        if (Pos >= Json.Len() || Json[Pos] != TCHAR('"'))
+        {
+            return false;
+        }
+        const int32 KeyEnd = ScanString(Json, Pos);
+        if (KeyEnd == INDEX_NONE)
+        {
+            return false;
+        }
+        const FStringView Key = Json.Mid(Pos + 1, KeyEnd - Pos - 2);
+
+        Pos = SkipWhitespace(Json, KeyEnd);
+        if (Pos >= Json.Len() || Json[Pos] != TCHAR(':'))
+        {
+            return false;
+        }
+
+        Pos = SkipWhitespace(Json, Pos + 1);
+        const int32 ValueEnd = ScanValue(Json, Pos);
+        if (ValueEnd == INDEX_NONE)
+        {
+            return false;
+        }
+        OutMembers.Emplace(Key, Json.Mid(Pos, ValueEnd - Pos));
+
+        Pos = ValueEnd;
+        if (!ScanSeparator(Json, Pos, TCHAR('}'), bClosed))
+        {
+            return false;
+        }
+    }
+
+    return SkipWhitespace(Json, Pos) == Json.Len();
+}
+
+bool FAegisParallelJson::ParseObjects(TConstArrayView<FStringView> Elements, TArray<bool>& OutIsObject,
+    TFunctionRef<void(int32 Index, const TSharedPtr<FJsonObject>& Object)> Visit)
+{
+    const int32 Num = Elements.Num();
+    OutIsObject.Init(false, Num);
+
+    std::atomic<bool> bMalformed{ false };
+
+    const int32 TaskCount = FMath::DivideAndRoundUp(Num, ElementsPerTask);
+    ParallelFor(TaskCount, [&](int32 TaskIndex)
+    {
+        const int32 Begin = TaskIndex * ElementsPerTask;
+        const int32 End = FMath::Min(Begin + ElementsPerTask, Num);
+        for (int32 Index = Begin; Index < End && !bMalformed.load(std::memory_order_relaxed); ++Index)
+        {
+            TSharedPtr<FJsonValue> Value;
+            TSharedRef<TJsonReader<TCHAR>> Reader = TJsonReaderFactory<TCHAR>::CreateFromView(Elements[Index]);
+            if (!FJsonSerializer::Deserialize(Reader, Value) || !Value.IsValid())
+            {
+                bMalformed = true;
+                return;
+            }
+
+            const TSharedPtr<FJsonObject>* Object = nullptr;
+            if (Value->TryGetObject(Object))
+            {
+                OutIsObject[Index] = true;
+                Visit(Index, *Object);
+            }
+        }
+    }, TaskCount > 1 ? EParallelForFlags::None : EParallelForFlags::ForceSingleThread);
+
+    return !bMalformed;
+}
@@ -0,0 +1,448 @@
+// Copyright AEGIS Team. All Rights Reserved.
+
+#include "AegisPropertyPlan.h"
+#include "Dom/JsonObject.h"
+#include "Dom/JsonValue.h"
+#include "Misc/PackageName.h"
+#include "UObject/EnumProperty.h"
+#include "UObject/UnrealType.h"
+
+namespace
+{
+    template <typename T>
+    void WriteField(FAegisJsonWriter& Writer, const TCHAR* Identifier, T Value)
+    {
+        if (Identifier)
+        {
+            Writer.WriteValue(Identifier, Value);
+        }
+        else
+        {
+            Writer.WriteValue(Value);
+        }
+    }
+
+    void WriteObjectStart(FAegisJsonWriter& Writer, const TCHAR* Identifier)
+    {
+        if (Identifier)
+        {
+            Writer.WriteObjectStart(Identifier);
+        }
+        else
+        {
+            Writer.WriteObjectStart();
+        }
+    }
+
+    FString GetEnumName(const FAegisPropertyPlan::FEntry& Entry, int64 Value)
+    {
+        const FString Name = Entry.Enum->GetNameStringByValue(Value);
+        return Name.IsEmpty() ? LexToString(Value) : Name;
+    }
+
+    FString ExportText(const FAegisPropertyPlan::FEntry& Entry, const UObject* Object)
+    {
+        FString Text;
+        Entry.Property->ExportTextItem_Direct(Text, Entry.GetValuePtr(Object), nullptr, const_cast<UObject*>(Object), PPF_None);
+        return Text;
+    }
+
+    bool ParseBool(const FString& Text, bool& OutValue)
+    {
+        if (Text.Equals(TEXT("true"), ESearchCase::IgnoreCase) || Text == TEXT("1"))
+        {
+            OutValue = true;
+            return true;
+        }
+        if (Text.Equals(TEXT("false"), ESearchCase::IgnoreCase) || Text == TEXT("0"))
+        {
+            OutValue = false;
+            return true;
+        }
+        return false;
+    }
+}
+
+// ============================================================================
+// Plan
+// ============================================================================
+
+FAegisPropertyPlan::FAegisPropertyPlan(const UClass* Class)
+{
+    for (TFieldIterator<FProperty> It(Class, EFieldIteratorFlags::IncludeSuper); It; ++It)
+    {
+        FProperty* Property = *It;
+
+        FEntry& Entry = Entries.AddDefaulted_GetRef();
+        Entry.Property = Property;
+        Entry.Name = Property->GetName();
+        Entry.Offset = Property->GetOffset_ForInternal();
+
+        // Static arrays keep the text form, which covers every element
+        if (Property->ArrayDim == 1)
+        {
+            if (CastField<FBoolProperty>(Property))
+            {
+                Entry.Kind = EKind::Bool;
+            }
+            else if (FEnumProperty* EnumProperty = CastField<FEnumProperty>(Property))
+            {
+                Entry.Kind = EKind::Enum;
+                Entry.Numeric = EnumProperty->GetUnderlyingProperty();
+                Entry.Enum = EnumProperty->GetEnum();
+            }
+            else if (FNumericProperty* Numeric = CastField<FNumericProperty>(Property))
+            {
+                Entry.Numeric = Numeric;
+                Entry.Enum = Numeric->GetIntPropertyEnum();
+                Entry.Kind = Entry.Enum ? EKind::Enum : Numeric->IsFloatingPoint() ? EKind::Float : EKind::Integer;
+            }
+            else if (CastField<FNameProperty>(Property))
+            {
+                Entry.Kind = EKind::Name;
+            }
+            else if (CastField<FStrProperty>(Property))
+            {
+                Entry.Kind = EKind::String;
+            }
+            else if (FStructProperty* StructProperty = CastField<FStructProperty>(Property))
+            {
+                if (StructProperty->Struct == TBaseStructure<FVector>::Get())
+                {
+                    Entry.Kind = EKind::Vector;
+                }
+                else if (StructProperty->Struct == TBaseStructure<FRotator>::Get())
+                {
+                    Entry.Kind = EKind::Rotator;
+                }
+            }
+            else if (FObjectProperty* ObjectProperty = CastField<FObjectProperty>(Property))
+            {
+                Entry.Kind = EKind::Object;
+                Entry.ObjectClass = ObjectProperty->PropertyClass;
+            }
+        }
+
+        const int32 Index = Entries.Num() - 1;
+        ByName.Add(Property->GetFName(), Index);
+        if (Property->HasAnyPropertyFlags(CPF_Edit) && !Property->HasAnyPropertyFlags(CPF_Transient | CPF_Deprecated))
+        {
+            Captured.Add(Index);
+        }
+    }
+}
+
+const FAegisPropertyPlan::FEntry* FAegisPropertyPlan::Find(const FString& Name) const
+{
+    const FName Key(*Name, FNAME_Find);
+    const int32* Index = Key.IsNone() ? nullptr : ByName.Find(Key);
+    return Index ? &Entries[*Index] : nullptr;
+}
+
+void FAegisPropertyPlan::WriteProperties(FAegisJsonWriter& Writer, const UObject* Object) const
+{
+    for (int32 Index : Captured)
+    {
+        const FEntry& Entry = Entries[Index];
+        WriteValue(Writer, *Entry.Name, Entry, Object);
+    }
+}
+
+TSharedPtr<FJsonObject> FAegisPropertyPlan::ToJsonObject(const UObject* Object) const
+{
+    TSharedPtr<FJsonObject> Properties = MakeShared<FJsonObject>();
+    for (int32 Index : Captured)
+    {
+        const FEntry& Entry = Entries[Index];
+        Properties->SetField(Entry.Name, ToJsonValue(Entry, Object));
+    }
+    return Properties;
+}
+
+void FAegisPropertyPlan::WriteValue(FAegisJsonWriter& Writer, const TCHAR* Identifier, const FEntry& Entry, const UObject* Object)
+{
+    const void* Value = Entry.GetValuePtr(Object);
+
+    switch (Entry.Kind)
+    {
+    case EKind::Bool:
+        WriteField(Writer, Identifier, static_cast<FBoolProperty*>(Entry.Property)->GetPropertyValue(Value));
+        break;
+    case EKind::Integer:
+        WriteField(Writer, Identifier, Entry.Numeric->GetSignedIntPropertyValue(Value));
+        break;
+    case EKind::Float:
+        WriteField(Writer, Identifier, Entry.Numeric->GetFloatingPointPropertyValue(Value));
+        break;
+    case EKind::Enum:
+        WriteField(Writer, Identifier, GetEnumName(Entry, Entry.Numeric->GetSignedIntPropertyValue(Value)));
+        break;
+    case EKind::Name:
+        WriteField(Writer, Identifier, static_cast<const FName*>(Value)->ToString());
+        break;
+    case EKind::String:
+        WriteField(Writer, Identifier, *static_cast<const FString*>(Value));
+        break;
+    case EKind::Vector:
+    {
+        const FVector& Vector = *static_cast<const FVector*>(Value);
+        WriteObjectStart(Writer, Identifier);
+        Writer.WriteValue(TEXT("x"), Vector.X);
+        Writer.WriteValue(TEXT("y"), Vector.Y);
+        Writer.WriteValue(TEXT("z"), Vector.Z);
+        Writer.WriteObjectEnd();
+        break;
+    }
+    case EKind::Rotator:
+    {
+        const FRotator& Rotator = *static_cast<const FRotator*>(Value);
+        WriteObjectStart(Writer, Identifier);
+        Writer.WriteValue(TEXT("pitch"), Rotator.Pitch);
+        Writer.WriteValue(TEXT("yaw"), Rotator.Yaw);
+        Writer.WriteValue(TEXT("roll"), Rotator.Roll);
+        Writer.WriteObjectEnd();
+        break;
+    }
+    case EKind::Object:
+    {
+        const UObject* Referenced = static_cast<FObjectProperty*>(Entry.Property)->GetObjectPropertyValue(Value);
+        if (Referenced)
+        {
+            WriteField(Writer, Identifier, Referenced->GetPathName());
+        }
+        else if (Identifier)
+        {
+            Writer.WriteNull(Identifier);
+        }
+        else
+        {
+            Writer.WriteNull();
+        }
+        break;
+    }
+    default:
+        WriteField(Writer, Identifier, ExportText(Entry, Object));
+        break;
+    }
+}
+
+TSharedPtr<FJsonValue> FAegisPropertyPlan::ToJsonValue(const FEntry& Entry, const UObject* Object)
+{
+    const void* Value = Entry.GetValuePtr(Object);
+
+    switch (Entry.Kind)
+    {
+    case EKind::Bool:
+        return MakeShared<FJsonValueBoolean>(static_cast<FBoolProperty*>(Entry.Property)->GetPropertyValue(Value));
+    case EKind::Integer:
+        return MakeShared<FJsonValueNumber>(static_cast<double>(Entry.Numeric->GetSignedIntPropertyValue(Value)));
+    case EKind::Float:
+        return MakeShared<FJsonValueNumber>(Entry.Numeric->GetFloatingPointPropertyValue(Value));
+    case EKind::Enum:
+        return MakeShared<FJsonValueString>(GetEnumName(Entry, Entry.Numeric->GetSignedIntPropertyValue(Value)));
+    case EKind::Name:
+        return MakeShared<FJsonValueString>(static_cast<const FName*>(Value)->ToString());
+    case EKind::String:
+        return MakeShared<FJsonValueString>(*static_cast<const FString*>(Value));
+    case EKind::Vector:
+    {
+        const FVector& Vector = *static_cast<const FVector*>(Value);
+        TSharedPtr<FJsonObject> VectorObject = MakeShared<FJsonObject>();
+        VectorObject->SetNumberField(TEXT("x"), Vector.X);
+        VectorObject->SetNumberField(TEXT("y"), Vector.Y);
+        VectorObject->SetNumberField(TEXT("z"), Vector.Z);
+        return MakeShared<FJsonValueObject>(VectorObject);
+    }
+    case EKind::Rotator:
+    {
+        const FRotator& Rotator = *static_cast<const FRotator*>(Value);
+        TSharedPtr<FJsonObject> RotatorObject = MakeShared<FJsonObject>();
+        RotatorObject->SetNumberField(TEXT("pitch"), Rotator.Pitch);
+        RotatorObject->SetNumberField(TEXT("yaw"), Rotator.Yaw);
+        RotatorObject->SetNumberField(TEXT("roll"), Rotator.Roll);
+        return MakeShared<FJsonValueObject>(RotatorObject);
+    }
+    case EKind::Object:
+    {
+        const UObject* Referenced = static_cast<FObjectProperty*>(Entry.Property)->GetObjectPropertyValue(Value);
+        if (!Referenced)
+        {
+            return MakeShared<FJsonValueNull>();
+        }
+        return MakeShared<FJsonValueString>(Referenced->GetPathName());
+    }
+    default:
+        return MakeShared<FJsonValueString>(ExportText(Entry, Object));
+    }
+}
+
+bool FAegisPropertyPlan::ImportText(const FEntry& Entry, UObject* Object, const FString& Text)
+{
+    void* Value = Entry.GetValuePtr(Object);
+
+    switch (Entry.Kind)
+    {
+    case EKind::Bool:
+    {
+        bool bValue;
+        if (ParseBool(Text, bValue))
+        {
+            static_cast<FBoolProperty*>(Entry.Property)->SetPropertyValue(Value, bValue);
+            return true;
+        }
+        break;
+    }
+    case EKind::Integer:
+    {
+        int64 IntValue;
+        if (LexTryParseString(IntValue, *Text))
+        {
+            Entry.Numeric->SetIntPropertyValue(Value, IntValue);
+            return true;
+        }
+        break;
+    }
+    case EKind::Float:
+    {
+        double FloatValue;
+        if (LexTryParseString(FloatValue, *Text))
+        {
+            Entry.Numeric->SetFloatingPointPropertyValue(Value, FloatValue);
+            return true;
+        }
+        break;
+    }
+    case EKind::Enum:
+    {
+        int64 EnumValue = Entry.Enum->GetValueByNameString(Text);
+        if (EnumValue != INDEX_NONE || LexTryParseString(EnumValue, *Text))
+        {
+            Entry.Numeric->SetIntPropertyValue(Value, EnumValue);
+            return true;
+        }
+        break;
+    }
+    case EKind::Name:
+        *static_cast<FName*>(Value) = FName(*Text);
+        return true;
+    case EKind::String:
+        *static_cast<FString*>(Value) = Text;
+        return true;
+    case EKind::Vector:
+        // "X=.. Y=.. Z=.."; the parenthesized export form goes through ImportText
+        if (static_cast<FVector*>(Value)->InitFromString(Text))
+        {
+            return true;
+        }
+        break;
+    case EKind::Rotator:
+        if (static_cast<FRotator*>(Value)->InitFromString(Text))
+        {
+            return true;
+        }
+        break;
+    case EKind::Object:
+    {
+        FObjectProperty* ObjectProperty = static_cast<FObjectProperty*>(Entry.Property);
+        if (Text.IsEmpty() || Text == TEXT("None"))
+        {
+            ObjectProperty->SetObjectPropertyValue(Value, nullptr);
+            return true;
+        }
+
+        UObject* Referenced = StaticFindObject(Entry.ObjectClass, nullptr, *Text);
+        if (!Referenced && FPackageName::IsValidObjectPath(Text))
+        {
+            Referenced = StaticLoadObject(Entry.ObjectClass, nullptr, *Text);
+        }
+        if (Referenced)
+        {
+            ObjectProperty->SetObjectPropertyValue(Value, Referenced);
+            return true;
+        }
+        break;
+    }
+    default:
+        break;
+    }
+
+    // Relative object paths, literal forms and every other type
+    return Entry.Property->ImportText_Direct(*Text, Value, Object, PPF_None) != nullptr;
+}
+
+bool FAegisPropertyPlan::ImportJson(const FEntry& Entry, UObject* Object, const FJsonValue& JsonValue)
+{
+    void* Value = Entry.GetValuePtr(Object);
+
+    switch (JsonValue.Type)
+    {
+    case EJson::String:
+        return ImportText(Entry, Object, JsonValue.AsString());
+    case EJson::Boolean:
+        if (Entry.Kind == EKind::Bool)
+        {
+            static_cast<FBoolProperty*>(Entry.Property)->SetPropertyValue(Value, JsonValue.AsBool());
+            return true;
+        }
+        break;
+    case EJson::Number:
+        if (Entry.Kind == EKind::Float)
+        {
+            Entry.Numeric->SetFloatingPointPropertyValue(Value, JsonValue.AsNumber());
+            return true;
+        }
+        if (Entry.Kind == EKind::Integer || Entry.Kind == EKind::Enum)
+        {
+            Entry.Numeric->SetIntPropertyValue(Value, static_cast<int64>(JsonValue.AsNumber()));
+            return true;
+        }
+        break;
+    case EJson::Object:
+    {
+        const TSharedPtr<FJsonObject>& Fields = JsonValue.AsObject();
+        if (Entry.Kind == EKind::Vector && Fields.IsValid())
+        {
+            *static_cast<FVector*>(Value) = FVector(Fields->GetNumberField(TEXT("x")), Fields->GetNumberField(TEXT("y")), Fields->GetNumberField(TEXT("z")));
+            return true;
+        }
+        if (Entry.Kind == EKind::Rotator && Fields.IsValid())
+        {
+            *static_cast<FRotator*>(Value) = FRotator(Fields->GetNumberField(TEXT("pitch")), Fields->GetNumberField(TEXT("yaw")), Fields->GetNumberField(TEXT("roll")));
+            return true;
+        }
+        break;
+    }
+    case EJson::Null:
+        if (Entry.Kind == EKind::Object)
+        {
+            static_cast<FObjectProperty*>(Entry.Property)->SetObjectPropertyValue(Value, nullptr);
+            return true;
+        }
+        break;
+    default:
+        break;
+    }
+    return false;
+}
+
+// ============================================================================
+// Cache
+// ============================================================================
+
+const FAegisPropertyPlan& FAegisPropertyPlanCache::Get(const UClass* Class)
+{
+    check(IsInGameThread());
+
+    TUniquePtr<FAegisPropertyPlan>& Plan = Plans.FindOrAdd(FObjectKey(Class));
+    if (!Plan)
+    {
+        Plan = MakeUnique<FAegisPropertyPlan>(Class);
+    }
+    return *Plan;
+}
+
+bool FAegisPropertyPlanCache::SetProperty(UObject* Object, const FString& Name, const FString& Value)
+{
+    const FAegisPropertyPlan::FEntry* Entry = Get(Object->GetClass()).Find(Name);
+    return Entry && FAegisPropertyPlan::ImportText(*Entry, Object, Value);
+}
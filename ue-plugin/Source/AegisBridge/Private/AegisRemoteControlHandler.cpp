@@ -1,15 +1,331 @@
 // Copyright AEGIS Team. All Rights Reserved.
 
 #include "AegisRemoteControlHandler.h"
+#include "AegisActorQuery.h"
+#include "AegisAssetIndex.h"
 #include "AegisBridgeModule.h"
+#include "AegisBridgeStats.h"
 #include "AegisSubsystem.h"
 #include "AegisSeedSubsystem.h"
+#include "AegisChangeJournal.h"
+#include "AegisFoliageCapture.h"
+#include "AegisGUIDGenerator.h"
+#include "AegisWorldHash.h"
+#include "AegisLandscapeCapture.h"
+#include "AegisJobManager.h"
+#include "AegisParallelJson.h"
+#include "AegisBinarySnapshot.h"
+#include "Compression/OodleDataCompression.h"
+#include "HAL/FileManager.h"
 #include "IRemoteControlModule.h"
 #include "RemoteControlPreset.h"
 #include "Json.h"
 
 UAegisRemoteControlHandler* UAegisRemoteControlHandler::Instance = nullptr;
 
+const FName UAegisRemoteControlHandler::NAME_AegisSubsystem(TEXT("AegisSubsystem"));
+const FName UAegisRemoteControlHandler::NAME_AegisSeedSubsystem(TEXT("AegisSeedSubsystem"));
+const FName UAegisRemoteControlHandler::NAME_AegisChangeJournal(TEXT("AegisChangeJournal"));
+const FName UAegisRemoteControlHandler::NAME_AegisJobManager(TEXT("AegisJobManager"));
+
+namespace
+{
+    const FName NAME_RequestDecode(TEXT("request.decode"));
+}
+
+// ============================================================================
+// Request Parameters
+// ============================================================================
+
+FAegisRequestParams::FAegisRequestParams(const TSharedPtr<FJsonObject>& InObject)
+    : Object(InObject)
+{
+}
+
+FString FAegisRequestParams::GetString(const FString& Field, const FString& Default) const
+{
+    FString Value;
+    return Object.IsValid() && Object->TryGetStringField(Field, Value) ? Value : Default;
+}
+
+int32 FAegisRequestParams::GetInt(const FString& Field, int32 Default) const
+{
+    int32 Value;
+    return Object.IsValid() && Object->TryGetNumberField(Field, Value) ? Value : Default;
+}
+
+double FAegisRequestParams::GetNumber(const FString& Field, double Default) const
+{
+    double Value;
+    return Object.IsValid() && Object->TryGetNumberField(Field, Value) ? Value : Default;
+}
+
+bool FAegisRequestParams::GetBool(const FString& Field, bool bDefault) const
+{
+    bool bValue;
+    return Object.IsValid() && Object->TryGetBoolField(Field, bValue) ? bValue : bDefault;
+}
+
+FVector FAegisRequestParams::GetVector(const FString& Field, const FVector& Default) const
+{
+    if (!Object.IsValid())
+    {
+        return Default;
+    }
+
+    const TSharedPtr<FJsonObject>* VectorObj;
+    if (Object->TryGetObjectField(Field, VectorObj))
+    {
+        return FVector(
+            (*VectorObj)->GetNumberField(TEXT("x")),
+            (*VectorObj)->GetNumberField(TEXT("y")),
+            (*VectorObj)->GetNumberField(TEXT("z")));
+    }
+
+    FString VectorString;
+    FVector Vector;
+    if (Object->TryGetStringField(Field, VectorString) && Vector.InitFromString(VectorString))
+    {
+        return Vector;
+    }
+
+    return Default;
+}
+
+FRotator FAegisRequestParams::GetRotator(const FString& Field, const FRotator& Default) const
+{
+    if (!Object.IsValid())
+    {
+        return Default;
+    }
+
+    const TSharedPtr<FJsonObject>* RotObj;
+    if (Object->TryGetObjectField(Field, RotObj))
+    {
+        return FRotator(
+            (*RotObj)->GetNumberField(TEXT("pitch")),
+            (*RotObj)->GetNumberField(TEXT("yaw")),
+            (*RotObj)->GetNumberField(TEXT("roll")));
+    }
+
+    FString RotatorString;
+    FRotator Rotator;
+    if (Object->TryGetStringField(Field, RotatorString) && Rotator.InitFromString(RotatorString))
+    {
+        return Rotator;
+    }
+
+    return Default;
+}
+
+TArray<FString> FAegisRequestParams::GetStringArray(const FString& Field) const
+{
+    TArray<FString> Values;
+    if (const TArray<TSharedPtr<FJsonValue>>* Array = GetArray(Field))
+    {
+        Values.Reserve(Array->Num());
+        for (const TSharedPtr<FJsonValue>& Value : *Array)
+        {
+            Values.Add(Value->AsString());
+        }
+    }
+    return Values;
+}
+
+TMap<FString, FString> FAegisRequestParams::GetStringMap(const FString& Field) const
+{
+    TMap<FString, FString> Values;
+    const TSharedPtr<FJsonObject>* MapObj;
+    if (Object.IsValid() && Object->TryGetObjectField(Field, MapObj))
+    {
+        Values.Reserve((*MapObj)->Values.Num());
+        for (const auto& Pair : (*MapObj)->Values)
+        {
+            Values.Add(Pair.Key, Pair.Value->AsString());
+        }
+    }
+    return Values;
+}
+
+FString FAegisRequestParams::GetJsonString(const FString& Field, const FString& Default) const
+{
+    if (!Object.IsValid())
+    {
+        return Default;
+    }
+
+    const TSharedPtr<FJsonValue> Value = Object->TryGetField(Field);
+    if (!Value.IsValid())
+    {
+        return Default;
+    }
+
+    if (Value->Type == EJson::String)
+    {
+        return Value->AsString();
+    }
+
+    FString JsonString;
+    TSharedRef<FAegisJsonWriter> Writer = FAegisJsonWriterFactory::Create(&JsonString);
+    FJsonSerializer::Serialize(Value, FString(), Writer);
+    return JsonString;
+}
+
+const TArray<TSharedPtr<FJsonValue>>* FAegisRequestParams::GetArray(const FString& Field) const
+{
+    const TArray<TSharedPtr<FJsonValue>>* Array = nullptr;
+    if (Object.IsValid() && Object->TryGetArrayField(Field, Array))
+    {
+        return Array;
+    }
+    return nullptr;
+}
+
+FAegisRequestParams FAegisRequestParams::GetNested(const FString& Field) const
+{
+    const TSharedPtr<FJsonObject>* NestedObj;
+    if (Object.IsValid() && Object->TryGetObjectField(Field, NestedObj))
+    {
+        return FAegisRequestParams(*NestedObj);
+    }
+    return *this;
+}
+
+bool FAegisRequestParams::Has(const FString& Field) const
+{
+    return Object.IsValid() && Object->HasField(Field);
+}
+
+// ============================================================================
+// Route Helpers
+// ============================================================================
+
+namespace
+{
+    /** Wrap a handler so it only runs when its subsystem is available */
+    template <typename TSubsystem>
+    FAegisRouteHandler BindSubsystem(TFunction<bool(TSubsystem&, const FAegisRequestParams&, FAegisJsonWriter&)> Invoke)
+    {
+        return [Invoke = MoveTemp(Invoke)](const FAegisRequestParams& Params, FAegisJsonWriter& Writer)
+        {
+            TSubsystem* Subsystem = TSubsystem::Get();
+            if (!Subsystem)
+            {
+                Writer.WriteValue(TEXT("success"), false);
+                Writer.WriteValue(TEXT("error"), FString::Printf(TEXT("%s not available"), *TSubsystem::StaticClass()->GetName()));
+                return false;
+            }
+            return Invoke(*Subsystem, Params, Writer);
+        };
+    }
+
+    /** Response for UAegisSubsystem commands; Data is spliced, not re-parsed */
+    bool WriteCommandResult(const FAegisCommandResult& CommandResult, FAegisJsonWriter& Writer)
+    {
+        Writer.WriteValue(TEXT("success"), CommandResult.bSuccess);
+        Writer.WriteValue(TEXT("message"), CommandResult.Message);
+        if (!CommandResult.ErrorCode.IsEmpty())
+        {
+            Writer.WriteValue(TEXT("errorCode"), CommandResult.ErrorCode);
+        }
+        if (!CommandResult.Data.IsEmpty())
+        {
+            AegisJson::WriteRawJson(Writer, TEXT("data"), CommandResult.Data);
+        }
+        return CommandResult.bSuccess;
+    }
+
+    /** Response for seed commands that return a JSON document */
+    bool WriteJsonResult(const FString& Json, FAegisJsonWriter& Writer)
+    {
+        Writer.WriteValue(TEXT("success"), true);
+        if (!Json.IsEmpty())
+        {
+            AegisJson::WriteRawJson(Writer, TEXT("data"), Json);
+        }
+        return true;
+    }
+
+    /** Response for stored snapshot payloads */
+    bool WriteSnapshotPayload(const FString& SnapshotData, FAegisJsonWriter& Writer)
+    {
+        Writer.WriteValue(TEXT("success"), !SnapshotData.IsEmpty());
+        if (!SnapshotData.IsEmpty())
+        {
+            AegisJson::WriteRawJson(Writer, TEXT("data"), SnapshotData);
+        }
+        return !SnapshotData.IsEmpty();
+    }
+
+    /** Decode spawn parameters: {ClassName, ActorName, Location, Rotation, Scale, Properties} */
+    FAegisSpawnParams ParseSpawnParams(const FAegisRequestParams& Params)
+    {
+        FAegisSpawnParams SpawnParams;
+        SpawnParams.ClassName = Params.GetString(TEXT("ClassName"));
+        SpawnParams.ActorName = Params.GetString(TEXT("ActorName"));
+        SpawnParams.Location = Params.GetVector(TEXT("Location"));
+        SpawnParams.Rotation = Params.GetRotator(TEXT("Rotation"));
+        SpawnParams.Scale = Params.GetVector(TEXT("Scale"), FVector::OneVector);
+        SpawnParams.Properties = Params.GetStringMap(TEXT("Properties"));
+        return SpawnParams;
+    }
+
+    /** Decode one batch operation: {op, path, class, name, location, rotation, scale, properties} */
+    FAegisBatchOperation ParseBatchOperation(const FAegisRequestParams& Params)
+    {
+        FAegisBatchOperation Operation;
+        Operation.Op = Params.GetString(TEXT("op"));
+        Operation.ActorPath = Params.GetString(TEXT("path"));
+        Operation.SpawnParams.ClassName = Params.GetString(TEXT("class"));
+        Operation.SpawnParams.ActorName = Params.GetString(TEXT("name"));
+        Operation.SpawnParams.Location = Params.GetVector(TEXT("location"));
+        Operation.SpawnParams.Rotation = Params.GetRotator(TEXT("rotation"));
+        Operation.SpawnParams.Scale = Params.GetVector(TEXT("scale"), FVector::OneVector);
+        Operation.Properties = Params.GetStringMap(TEXT("properties"));
+
+        // Spawns apply the same property map after construction
+        Operation.SpawnParams.Properties = Operation.Properties;
+        return Operation;
+    }
+
+    /** "continue" (default), "stop" or "rollback" */
+    EAegisBatchFailureMode ParseBatchFailureMode(const FString& Mode)
+    {
+        if (Mode == TEXT("stop")) return EAegisBatchFailureMode::StopOnError;
+        if (Mode == TEXT("rollback")) return EAegisBatchFailureMode::RollbackOnError;
+        return EAegisBatchFailureMode::ContinueOnError;
+    }
+
+    void WriteGUIDEntry(FAegisJsonWriter& Writer, const TCHAR* Identifier, const FAegisGUIDEntry& Entry)
+    {
+        Writer.WriteObjectStart(Identifier);
+        Writer.WriteValue(TEXT("guid"), Entry.GUID);
+        Writer.WriteValue(TEXT("entityPath"), Entry.EntityPath);
+        Writer.WriteValue(TEXT("entityType"), Entry.EntityType);
+        Writer.WriteValue(TEXT("entityName"), Entry.EntityName);
+        Writer.WriteValue(TEXT("metadata"), Entry.Metadata);
+        Writer.WriteValue(TEXT("createdAt"), Entry.CreatedAt.ToIso8601());
+        Writer.WriteValue(TEXT("version"), Entry.Version);
+        Writer.WriteObjectEnd();
+    }
+
+    void WriteSnapshotInfo(FAegisJsonWriter& Writer, const FAegisWorldSnapshot& Snapshot)
+    {
+        Writer.WriteObjectStart();
+        Writer.WriteValue(TEXT("snapshotId"), Snapshot.SnapshotId);
+        Writer.WriteValue(TEXT("name"), Snapshot.Name);
+        Writer.WriteValue(TEXT("description"), Snapshot.Description);
+        Writer.WriteValue(TEXT("timestamp"), Snapshot.Timestamp.ToIso8601());
+        Writer.WriteValue(TEXT("checksum"), Snapshot.Checksum);
+        Writer.WriteValue(TEXT("entityCount"), Snapshot.EntityCount);
+        Writer.WriteObjectEnd();
+    }
+}
+
+// ============================================================================
+// Handler
+// ============================================================================
+
 UAegisRemoteControlHandler* UAegisRemoteControlHandler::Get()
 {
     if (!Instance)
@@ -51,146 +367,871 @@ void UAegisRemoteControlHandler::Shutdown()
 }
 
 FString UAegisRemoteControlHandler::HandleRequest(const FString& ObjectPath, const FString& FunctionName, const FString& Parameters)
+{
+    bool bSuccess = false;
+    return HandleRequest(ObjectPath, FunctionName, Parameters, bSuccess);
+}
+
+FString UAegisRemoteControlHandler::HandleRequest(const FString& ObjectPath, const FString& FunctionName, const FString& Parameters, bool& bOutSuccess)
 {
     UE_LOG(LogAegisBridge, Verbose, TEXT("Handling request: %s.%s"), *ObjectPath, *FunctionName);
 
-    TSharedPtr<FJsonObject> Result = MakeShareable(new FJsonObject());
+    AEGIS_TRACE_SCOPE(AegisHandleRequest);
+    const uint64 StartCycles = FPlatformTime::Cycles64();
+
+    if (!bIsReady)
+    {
+        Initialize();
+    }
 
     // Parse parameters
     TSharedPtr<FJsonObject> ParamsObj;
     if (!Parameters.IsEmpty())
     {
+        AEGIS_TRACE_SCOPE(AegisDecodeRequest);
+        FAegisStatScope DecodeScope(NAME_RequestDecode);
+        DecodeScope.BytesIn = Parameters.Len();
+
         TSharedRef<TJsonReader<>> Reader = TJsonReaderFactory<>::Create(Parameters);
         FJsonSerializer::Deserialize(Reader, ParamsObj);
     }
 
-    // Route to appropriate subsystem
-    if (ObjectPath.Contains(TEXT("AegisSubsystem")))
+    // Handlers write directly into the response, so every payload is encoded exactly once
+    FString ResultString;
+    TSharedRef<FAegisJsonWriter> Writer = FAegisJsonWriterFactory::Create(&ResultString);
+    Writer->WriteObjectStart();
+
+    // Route through the dispatch table. FNAME_Find never adds request strings to the name table.
+    const FAegisRouteKey Key{ ResolveNamespace(ObjectPath), FName(*FunctionName, FNAME_Find) };
+
+    bOutSuccess = false;
+    const FRoute* Route = Routes.Find(Key);
+    if (Route)
+    {
+        TRACE_CPUPROFILER_EVENT_SCOPE_TEXT_ON_CHANNEL(*FunctionName, AegisBridgeChannel);
+        bOutSuccess = Route->Handler(FAegisRequestParams(ParamsObj), *Writer);
+    }
+    else if (!Namespaces.Contains(Key.Namespace))
+    {
+        Writer->WriteValue(TEXT("success"), false);
+        Writer->WriteValue(TEXT("error"), FString::Printf(TEXT("Unknown object path: %s"), *ObjectPath));
+    }
+    else
+    {
+        Writer->WriteValue(TEXT("success"), false);
+        Writer->WriteValue(TEXT("error"), FString::Printf(TEXT("Unknown function: %s"), *FunctionName));
+    }
+
+    Writer->WriteObjectEnd();
+    Writer->Close();
+
+    // Decode, dispatch and response encoding, with the payload sizes
+    if (Route && FAegisBridgeStats::IsEnabled())
     {
-        UAegisSubsystem* Subsystem = UAegisSubsystem::Get();
-        if (!Subsystem)
+        const uint64 Micros = static_cast<uint64>(FPlatformTime::ToSeconds64(FPlatformTime::Cycles64() - StartCycles) * 1000000.0);
+        FAegisBridgeStats::Get().Record(Route->Metric, Micros, Parameters.Len(), ResultString.Len());
+    }
+
+    return ResultString;
+}
+
+void UAegisRemoteControlHandler::AddRoute(FName Namespace, FName Function, FAegisRouteHandler Handler)
+{
+    const FName Metric(*FString::Printf(TEXT("request.%s.%s"), *Namespace.ToString(), *Function.ToString()));
+    Routes.Add(FAegisRouteKey{ Namespace, Function }, FRoute{ MoveTemp(Handler), Metric });
+    Namespaces.Add(Namespace);
+}
+
+FName UAegisRemoteControlHandler::ResolveNamespace(const FString& ObjectPath)
+{
+    // "/Script/AegisBridge.AegisSeedSubsystem", "/Script/AegisBridge.Default__AegisSubsystem"
+    // or an instance path ending in ":AegisSubsystem_0"
+    FStringView Name(ObjectPath);
+    int32 SeparatorIndex = INDEX_NONE;
+    if (Name.FindLastChar(TEXT(':'), SeparatorIndex) || Name.FindLastChar(TEXT('.'), SeparatorIndex))
+    {
+        Name.RightChopInline(SeparatorIndex + 1);
+    }
+
+    static const FStringView DefaultPrefix(TEXT("Default__"));
+    if (Name.StartsWith(DefaultPrefix))
+    {
+        Name.RightChopInline(DefaultPrefix.Len());
+    }
+
+    // Instance suffixes such as "_0" become the FName number; routes are registered without one
+    FName Namespace(Name, FNAME_Find);
+    Namespace.SetNumber(NAME_NO_NUMBER_INTERNAL);
+    return Namespace;
+}
+
+void UAegisRemoteControlHandler::RegisterFunctionHandlers()
+{
+    Routes.Reset();
+    Namespaces.Reset();
+
+    RegisterSubsystemRoutes();
+    RegisterSeedRoutes();
+    RegisterJournalRoutes();
+    RegisterJobRoutes();
+
+    UE_LOG(LogAegisBridge, Log, TEXT("Registered %d AEGIS function handlers"), Routes.Num());
+}
+
+void UAegisRemoteControlHandler::UnregisterFunctionHandlers()
+{
+    Routes.Empty();
+    Namespaces.Empty();
+
+    UE_LOG(LogAegisBridge, Log, TEXT("Unregistered AEGIS function handlers"));
+}
+
+void UAegisRemoteControlHandler::RegisterSubsystemRoutes()
+{
+    using FParams = FAegisRequestParams;
+    const FName NS = NAME_AegisSubsystem;
+
+    // Actor Operations
+    AddRoute(NS, TEXT("SpawnActor"), BindSubsystem<UAegisSubsystem>([](UAegisSubsystem& Subsystem, const FParams& Params, FAegisJsonWriter& Writer)
+    {
+        return WriteCommandResult(Subsystem.SpawnActor(ParseSpawnParams(Params.GetNested(TEXT("Params")))), Writer);
+    }));
+
+    AddRoute(NS, TEXT("DeleteActor"), BindSubsystem<UAegisSubsystem>([](UAegisSubsystem& Subsystem, const FParams& Params, FAegisJsonWriter& Writer)
+    {
+        return WriteCommandResult(Subsystem.DeleteActor(Params.GetString(TEXT("ActorPath"))), Writer);
+    }));
+
+    AddRoute(NS, TEXT("ModifyActor"), BindSubsystem<UAegisSubsystem>([](UAegisSubsystem& Subsystem, const FParams& Params, FAegisJsonWriter& Writer)
+    {
+        return WriteCommandResult(Subsystem.ModifyActor(Params.GetString(TEXT("ActorPath")), Params.GetStringMap(TEXT("Properties"))), Writer);
+    }));
+
+    AddRoute(NS, TEXT("QueryActors"), BindSubsystem<UAegisSubsystem>([](UAegisSubsystem& Subsystem, const FParams& Params, FAegisJsonWriter& Writer)
+    {
+        FAegisActorQueryParams QueryParams;
+        QueryParams.ClassFilter = Params.GetStringArray(TEXT("ClassFilters"));
+        const FString ClassFilter = Params.GetString(TEXT("ClassFilter"));
+        if (!ClassFilter.IsEmpty())
         {
-            Result->SetBoolField(TEXT("success"), false);
-            Result->SetStringField(TEXT("error"), TEXT("AegisSubsystem not available"));
+            QueryParams.ClassFilter.Add(ClassFilter);
         }
-        else
+        QueryParams.NameFilter = Params.GetString(TEXT("NameFilter"));
+        QueryParams.TagFilter = Params.GetStringArray(TEXT("Tags"));
+
+        if (Params.Has(TEXT("BoundsMin")) && Params.Has(TEXT("BoundsMax")))
         {
-            // Route to subsystem methods
-            // This would be implemented using reflection or a dispatch table
-            Result->SetBoolField(TEXT("success"), true);
-            Result->SetStringField(TEXT("message"), TEXT("Request handled"));
+            QueryParams.Bounds = FBox(Params.GetVector(TEXT("BoundsMin")), Params.GetVector(TEXT("BoundsMax")));
         }
-    }
-    else if (ObjectPath.Contains(TEXT("AegisSeedSubsystem")))
-    {
-        UAegisSeedSubsystem* SeedSubsystem = UAegisSeedSubsystem::Get();
-        if (!SeedSubsystem)
+        if (Params.Has(TEXT("Origin")))
         {
-            Result->SetBoolField(TEXT("success"), false);
-            Result->SetStringField(TEXT("error"), TEXT("AegisSeedSubsystem not available"));
+            QueryParams.Origin = Params.GetVector(TEXT("Origin"));
+            QueryParams.Radius = Params.GetNumber(TEXT("Radius"));
         }
-        else
-        {
-            // Route to seed subsystem methods
-            if (FunctionName == TEXT("GenerateGUID"))
-            {
-                FString Namespace = ParamsObj ? ParamsObj->GetStringField(TEXT("Namespace")) : TEXT("");
-                FString EntityType = ParamsObj ? ParamsObj->GetStringField(TEXT("EntityType")) : TEXT("");
-                FString Seed = ParamsObj ? ParamsObj->GetStringField(TEXT("Seed")) : TEXT("");
-                int32 Counter = ParamsObj ? ParamsObj->GetIntegerField(TEXT("Counter")) : 0;
-                FString EntityName = ParamsObj ? ParamsObj->GetStringField(TEXT("EntityName")) : TEXT("");
+        QueryParams.Offset = Params.GetInt(TEXT("Offset"));
+        QueryParams.Limit = Params.GetInt(TEXT("Limit"));
 
-                FString GUID = SeedSubsystem->GenerateGUID(Namespace, EntityType, Seed, Counter, EntityName);
+        return WriteCommandResult(Subsystem.RunActorQuery(QueryParams), Writer);
+    }));
 
-                Result->SetBoolField(TEXT("success"), true);
-                Result->SetStringField(TEXT("guid"), GUID);
-            }
-            else if (FunctionName == TEXT("RegisterGUID"))
-            {
-                FString GUID = ParamsObj ? ParamsObj->GetStringField(TEXT("GUID")) : TEXT("");
-                FString EntityPath = ParamsObj ? ParamsObj->GetStringField(TEXT("EntityPath")) : TEXT("");
-                FString EntityType = ParamsObj ? ParamsObj->GetStringField(TEXT("EntityType")) : TEXT("");
-                FString Metadata = ParamsObj ? ParamsObj->GetStringField(TEXT("Metadata")) : TEXT("{}");
+    AddRoute(NS, TEXT("GetActorInfo"), BindSubsystem<UAegisSubsystem>([](UAegisSubsystem& Subsystem, const FParams& Params, FAegisJsonWriter& Writer)
+    {
+        return WriteCommandResult(Subsystem.GetActorInfo(
+            Params.GetString(TEXT("ActorPath")),
+            Params.GetBool(TEXT("bIncludeComponents")),
+            Params.GetBool(TEXT("bIncludeProperties"))), Writer);
+    }));
+
+    AddRoute(NS, TEXT("DuplicateActor"), BindSubsystem<UAegisSubsystem>([](UAegisSubsystem& Subsystem, const FParams& Params, FAegisJsonWriter& Writer)
+    {
+        return WriteCommandResult(Subsystem.DuplicateActor(Params.GetString(TEXT("ActorPath")), Params.GetVector(TEXT("Offset"))), Writer);
+    }));
+
+    AddRoute(NS, TEXT("SelectActors"), BindSubsystem<UAegisSubsystem>([](UAegisSubsystem& Subsystem, const FParams& Params, FAegisJsonWriter& Writer)
+    {
+        return WriteCommandResult(Subsystem.SelectActors(Params.GetStringArray(TEXT("ActorPaths")), Params.GetBool(TEXT("bAddToSelection"))), Writer);
+    }));
 
-                bool bSuccess = SeedSubsystem->RegisterGUID(GUID, EntityPath, EntityType, Metadata);
-                Result->SetBoolField(TEXT("success"), bSuccess);
+    AddRoute(NS, TEXT("ExecuteBatch"), BindSubsystem<UAegisSubsystem>([](UAegisSubsystem& Subsystem, const FParams& Params, FAegisJsonWriter& Writer)
+    {
+        TArray<FAegisBatchOperation> Operations;
+        if (!Params.GetArray(TEXT("Operations")) && Params.Has(TEXT("Operations")))
+        {
+            // Operations sent as JSON text skip the request tree and are decoded in parallel
+            if (!FAegisParallelJson::ParseArray<FAegisBatchOperation>(Params.GetString(TEXT("Operations")), Operations,
+                [](const TSharedPtr<FJsonObject>& Object, FAegisBatchOperation& OutOperation)
+                {
+                    OutOperation = ParseBatchOperation(FParams(Object));
+                }))
+            {
+                Writer.WriteValue(TEXT("success"), false);
+                Writer.WriteValue(TEXT("error"), TEXT("Malformed Operations JSON"));
+                return false;
             }
-            else if (FunctionName == TEXT("CaptureAllActors"))
+        }
+        else if (const TArray<TSharedPtr<FJsonValue>>* OperationArray = Params.GetArray(TEXT("Operations")))
+        {
+            Operations.Reserve(OperationArray->Num());
+            for (const TSharedPtr<FJsonValue>& OperationValue : *OperationArray)
             {
-                TArray<FString> ClassFilter;
-                TArray<FString> TagFilter;
-
-                const TArray<TSharedPtr<FJsonValue>>* ClassFilterArray;
-                if (ParamsObj && ParamsObj->TryGetArrayField(TEXT("ClassFilter"), ClassFilterArray))
+                const TSharedPtr<FJsonObject>* OperationObj;
+                if (OperationValue->TryGetObject(OperationObj))
                 {
-                    for (const auto& Val : *ClassFilterArray)
-                    {
-                        ClassFilter.Add(Val->AsString());
-                    }
+                    Operations.Add(ParseBatchOperation(FParams(*OperationObj)));
                 }
+            }
+        }
 
-                const TArray<TSharedPtr<FJsonValue>>* TagFilterArray;
-                if (ParamsObj && ParamsObj->TryGetArrayField(TEXT("TagFilter"), TagFilterArray))
-                {
-                    for (const auto& Val : *TagFilterArray)
-                    {
-                        TagFilter.Add(Val->AsString());
-                    }
-                }
+        return WriteCommandResult(Subsystem.ExecuteBatch(Operations, ParseBatchFailureMode(Params.GetString(TEXT("FailureMode")))), Writer);
+    }));
+
+    // Blueprint Operations
+    AddRoute(NS, TEXT("CreateBlueprint"), BindSubsystem<UAegisSubsystem>([](UAegisSubsystem& Subsystem, const FParams& Params, FAegisJsonWriter& Writer)
+    {
+        return WriteCommandResult(Subsystem.CreateBlueprint(
+            Params.GetString(TEXT("BlueprintName")),
+            Params.GetString(TEXT("ParentClass")),
+            Params.GetString(TEXT("Path"))), Writer);
+    }));
+
+    AddRoute(NS, TEXT("CompileBlueprint"), BindSubsystem<UAegisSubsystem>([](UAegisSubsystem& Subsystem, const FParams& Params, FAegisJsonWriter& Writer)
+    {
+        return WriteCommandResult(Subsystem.CompileBlueprint(Params.GetString(TEXT("BlueprintPath"))), Writer);
+    }));
+
+    AddRoute(NS, TEXT("AddBlueprintComponent"), BindSubsystem<UAegisSubsystem>([](UAegisSubsystem& Subsystem, const FParams& Params, FAegisJsonWriter& Writer)
+    {
+        return WriteCommandResult(Subsystem.AddBlueprintComponent(
+            Params.GetString(TEXT("BlueprintPath")),
+            Params.GetString(TEXT("ComponentClass")),
+            Params.GetString(TEXT("ComponentName"))), Writer);
+    }));
+
+    AddRoute(NS, TEXT("AddBlueprintVariable"), BindSubsystem<UAegisSubsystem>([](UAegisSubsystem& Subsystem, const FParams& Params, FAegisJsonWriter& Writer)
+    {
+        return WriteCommandResult(Subsystem.AddBlueprintVariable(
+            Params.GetString(TEXT("BlueprintPath")),
+            Params.GetString(TEXT("VariableName")),
+            Params.GetString(TEXT("VariableType"))), Writer);
+    }));
+
+    // Asset Operations
+    AddRoute(NS, TEXT("SearchAssets"), BindSubsystem<UAegisSubsystem>([](UAegisSubsystem& Subsystem, const FParams& Params, FAegisJsonWriter& Writer)
+    {
+        FAegisAssetSearchParams SearchParams;
+        SearchParams.Query = Params.GetString(TEXT("SearchQuery"));
+        SearchParams.bPrefix = Params.GetBool(TEXT("bPrefix"));
+        SearchParams.ClassNames = Params.GetStringArray(TEXT("AssetTypes"));
+        const FString AssetType = Params.GetString(TEXT("AssetType"));
+        if (!AssetType.IsEmpty())
+        {
+            SearchParams.ClassNames.Add(AssetType);
+        }
+        SearchParams.Path = Params.GetString(TEXT("Path"));
+        SearchParams.Cursor = Params.GetString(TEXT("Cursor"));
+        SearchParams.Limit = Params.GetInt(TEXT("Limit"));
+
+        return WriteCommandResult(Subsystem.SearchAssetIndex(SearchParams), Writer);
+    }));
+
+    AddRoute(NS, TEXT("LoadAsset"), BindSubsystem<UAegisSubsystem>([](UAegisSubsystem& Subsystem, const FParams& Params, FAegisJsonWriter& Writer)
+    {
+        return WriteCommandResult(Subsystem.LoadAsset(Params.GetString(TEXT("AssetPath"))), Writer);
+    }));
+
+    AddRoute(NS, TEXT("ImportAsset"), BindSubsystem<UAegisSubsystem>([](UAegisSubsystem& Subsystem, const FParams& Params, FAegisJsonWriter& Writer)
+    {
+        return WriteCommandResult(Subsystem.ImportAsset(Params.GetString(TEXT("SourcePath")), Params.GetString(TEXT("DestinationPath"))), Writer);
+    }));
+
+    AddRoute(NS, TEXT("ExportAsset"), BindSubsystem<UAegisSubsystem>([](UAegisSubsystem& Subsystem, const FParams& Params, FAegisJsonWriter& Writer)
+    {
+        return WriteCommandResult(Subsystem.ExportAsset(Params.GetString(TEXT("AssetPath")), Params.GetString(TEXT("ExportPath"))), Writer);
+    }));
+
+    // Level Operations
+    AddRoute(NS, TEXT("LoadLevel"), BindSubsystem<UAegisSubsystem>([](UAegisSubsystem& Subsystem, const FParams& Params, FAegisJsonWriter& Writer)
+    {
+        return WriteCommandResult(Subsystem.LoadLevel(Params.GetString(TEXT("LevelPath"))), Writer);
+    }));
+
+    AddRoute(NS, TEXT("SaveLevel"), BindSubsystem<UAegisSubsystem>([](UAegisSubsystem& Subsystem, const FParams& Params, FAegisJsonWriter& Writer)
+    {
+        return WriteCommandResult(Subsystem.SaveLevel(), Writer);
+    }));
+
+    AddRoute(NS, TEXT("CreateLevel"), BindSubsystem<UAegisSubsystem>([](UAegisSubsystem& Subsystem, const FParams& Params, FAegisJsonWriter& Writer)
+    {
+        return WriteCommandResult(Subsystem.CreateLevel(Params.GetString(TEXT("LevelName")), Params.GetString(TEXT("TemplateName"))), Writer);
+    }));
+
+    AddRoute(NS, TEXT("GetLevelInfo"), BindSubsystem<UAegisSubsystem>([](UAegisSubsystem& Subsystem, const FParams& Params, FAegisJsonWriter& Writer)
+    {
+        return WriteCommandResult(Subsystem.GetLevelInfo(), Writer);
+    }));
+
+    // Editor Operations
+    AddRoute(NS, TEXT("ExecuteEditorCommand"), BindSubsystem<UAegisSubsystem>([](UAegisSubsystem& Subsystem, const FParams& Params, FAegisJsonWriter& Writer)
+    {
+        return WriteCommandResult(Subsystem.ExecuteEditorCommand(Params.GetString(TEXT("Command"))), Writer);
+    }));
+
+    AddRoute(NS, TEXT("Undo"), BindSubsystem<UAegisSubsystem>([](UAegisSubsystem& Subsystem, const FParams& Params, FAegisJsonWriter& Writer)
+    {
+        return WriteCommandResult(Subsystem.Undo(), Writer);
+    }));
+
+    AddRoute(NS, TEXT("Redo"), BindSubsystem<UAegisSubsystem>([](UAegisSubsystem& Subsystem, const FParams& Params, FAegisJsonWriter& Writer)
+    {
+        return WriteCommandResult(Subsystem.Redo(), Writer);
+    }));
+
+    AddRoute(NS, TEXT("GetSelection"), BindSubsystem<UAegisSubsystem>([](UAegisSubsystem& Subsystem, const FParams& Params, FAegisJsonWriter& Writer)
+    {
+        return WriteCommandResult(Subsystem.GetSelection(), Writer);
+    }));
 
-                FString CaptureResult = SeedSubsystem->CaptureAllActors(ClassFilter, TagFilter);
-                Result->SetBoolField(TEXT("success"), true);
+    AddRoute(NS, TEXT("FocusActor"), BindSubsystem<UAegisSubsystem>([](UAegisSubsystem& Subsystem, const FParams& Params, FAegisJsonWriter& Writer)
+    {
+        return WriteCommandResult(Subsystem.FocusActor(Params.GetString(TEXT("ActorPath"))), Writer);
+    }));
+
+    // Context Operations
+    AddRoute(NS, TEXT("GetEditorContext"), BindSubsystem<UAegisSubsystem>([](UAegisSubsystem& Subsystem, const FParams& Params, FAegisJsonWriter& Writer)
+    {
+        return WriteCommandResult(Subsystem.GetEditorContext(static_cast<int64>(Params.GetNumber(TEXT("SinceVersion"), -1.0))), Writer);
+    }));
+
+    AddRoute(NS, TEXT("GetProjectInfo"), BindSubsystem<UAegisSubsystem>([](UAegisSubsystem& Subsystem, const FParams& Params, FAegisJsonWriter& Writer)
+    {
+        return WriteCommandResult(Subsystem.GetProjectInfo(), Writer);
+    }));
+
+    AddRoute(NS, TEXT("GetBridgeStats"), BindSubsystem<UAegisSubsystem>([](UAegisSubsystem& Subsystem, const FParams& Params, FAegisJsonWriter& Writer)
+    {
+        return WriteCommandResult(Subsystem.GetBridgeStats(Params.GetBool(TEXT("bReset"))), Writer);
+    }));
+}
+
+void UAegisRemoteControlHandler::RegisterSeedRoutes()
+{
+    using FParams = FAegisRequestParams;
+    const FName NS = NAME_AegisSeedSubsystem;
+
+    // GUID Operations
+    AddRoute(NS, TEXT("GenerateGUID"), BindSubsystem<UAegisSeedSubsystem>([](UAegisSeedSubsystem& Seed, const FParams& Params, FAegisJsonWriter& Writer)
+    {
+        const FString GUID = FAegisGUIDGenerator::Generate(
+            Params.GetString(TEXT("Namespace")),
+            Params.GetString(TEXT("EntityType")),
+            Params.GetString(TEXT("Seed")),
+            Params.GetInt(TEXT("Counter")),
+            Params.GetString(TEXT("EntityName")),
+            Params.GetString(TEXT("ParentGUID")));
+
+        Writer.WriteValue(TEXT("success"), true);
+        Writer.WriteValue(TEXT("guid"), GUID);
+        return true;
+    }));
+
+    AddRoute(NS, TEXT("GenerateGUIDBatch"), BindSubsystem<UAegisSeedSubsystem>([](UAegisSeedSubsystem& Seed, const FParams& Params, FAegisJsonWriter& Writer)
+    {
+        static constexpr int32 MaxBatchSize = 1 << 20;
+
+        const int32 Count = Params.GetInt(TEXT("Count"));
+        if (Count <= 0 || Count > MaxBatchSize)
+        {
+            Writer.WriteValue(TEXT("success"), false);
+            Writer.WriteValue(TEXT("error"), FString::Printf(TEXT("Count must be between 1 and %d"), MaxBatchSize));
+            return false;
+        }
+
+        const int32 StartCounter = Params.GetInt(TEXT("StartCounter"));
+
+        TArray<FString> GUIDs;
+        FAegisGUIDGenerator::GenerateBatch(
+            Params.GetString(TEXT("Namespace")),
+            Params.GetString(TEXT("EntityType")),
+            Params.GetString(TEXT("Seed")),
+            StartCounter,
+            Count,
+            Params.GetString(TEXT("NamePrefix")),
+            GUIDs);
+
+        Writer.WriteValue(TEXT("success"), true);
+        Writer.WriteValue(TEXT("startCounter"), StartCounter);
+        Writer.WriteArrayStart(TEXT("guids"));
+        for (const FString& GUID : GUIDs)
+        {
+            Writer.WriteValue(GUID);
+        }
+        Writer.WriteArrayEnd();
+        return true;
+    }));
+
+    AddRoute(NS, TEXT("RegisterGUID"), BindSubsystem<UAegisSeedSubsystem>([](UAegisSeedSubsystem& Seed, const FParams& Params, FAegisJsonWriter& Writer)
+    {
+        bool bSuccess = Seed.RegisterGUID(
+            Params.GetString(TEXT("GUID")),
+            Params.GetString(TEXT("EntityPath")),
+            Params.GetString(TEXT("EntityType")),
+            Params.GetJsonString(TEXT("Metadata"), TEXT("{}")));
+        Writer.WriteValue(TEXT("success"), bSuccess);
+        return bSuccess;
+    }));
 
-                TSharedPtr<FJsonObject> CaptureData;
-                TSharedRef<TJsonReader<>> CaptureReader = TJsonReaderFactory<>::Create(CaptureResult);
-                if (FJsonSerializer::Deserialize(CaptureReader, CaptureData))
+    AddRoute(NS, TEXT("RegisterGUIDs"), BindSubsystem<UAegisSeedSubsystem>([](UAegisSeedSubsystem& Seed, const FParams& Params, FAegisJsonWriter& Writer)
+    {
+        auto ParseRegistration = [](const FParams& EntryParams, FAegisGUIDRegistration& OutRegistration)
+        {
+            OutRegistration.GUID = EntryParams.GetString(TEXT("GUID"));
+            OutRegistration.EntityPath = EntryParams.GetString(TEXT("EntityPath"));
+            OutRegistration.EntityType = EntryParams.GetString(TEXT("EntityType"));
+            OutRegistration.Metadata = EntryParams.GetJsonString(TEXT("Metadata"), TEXT("{}"));
+        };
+
+        TArray<FAegisGUIDRegistration> Registrations;
+        if (!Params.GetArray(TEXT("Entries")) && Params.Has(TEXT("Entries")))
+        {
+            // Entries sent as JSON text skip the request tree and are decoded in parallel
+            if (!FAegisParallelJson::ParseArray<FAegisGUIDRegistration>(Params.GetString(TEXT("Entries")), Registrations,
+                [&ParseRegistration](const TSharedPtr<FJsonObject>& Object, FAegisGUIDRegistration& OutRegistration)
                 {
-                    Result->SetObjectField(TEXT("data"), CaptureData);
-                }
+                    ParseRegistration(FParams(Object), OutRegistration);
+                }))
+            {
+                Writer.WriteValue(TEXT("success"), false);
+                Writer.WriteValue(TEXT("error"), TEXT("Malformed Entries JSON"));
+                return false;
             }
-            else if (FunctionName == TEXT("GetCurrentLevelInfo"))
+        }
+        else if (const TArray<TSharedPtr<FJsonValue>>* EntryArray = Params.GetArray(TEXT("Entries")))
+        {
+            Registrations.Reserve(EntryArray->Num());
+            for (const TSharedPtr<FJsonValue>& EntryValue : *EntryArray)
             {
-                FString LevelInfo = SeedSubsystem->GetCurrentLevelInfo();
-                Result->SetBoolField(TEXT("success"), true);
-
-                TSharedPtr<FJsonObject> LevelData;
-                TSharedRef<TJsonReader<>> LevelReader = TJsonReaderFactory<>::Create(LevelInfo);
-                if (FJsonSerializer::Deserialize(LevelReader, LevelData))
+                const TSharedPtr<FJsonObject>* EntryObj;
+                if (EntryValue->TryGetObject(EntryObj))
                 {
-                    Result->SetObjectField(TEXT("data"), LevelData);
+                    ParseRegistration(FParams(*EntryObj), Registrations.AddDefaulted_GetRef());
                 }
             }
-            else
+        }
+
+        TArray<EAegisGUIDRegisterResult> Results;
+        const int32 Registered = Seed.RegisterGUIDs(Registrations, &Results);
+
+        Writer.WriteValue(TEXT("success"), true);
+        Writer.WriteValue(TEXT("registered"), Registered);
+
+        // Failures by request index; successful entries are not echoed back
+        Writer.WriteArrayStart(TEXT("failed"));
+        for (int32 Index = 0; Index < Results.Num(); ++Index)
+        {
+            if (Results[Index] == EAegisGUIDRegisterResult::Registered)
             {
-                Result->SetBoolField(TEXT("success"), false);
-                Result->SetStringField(TEXT("error"), FString::Printf(TEXT("Unknown function: %s"), *FunctionName));
+                continue;
             }
+
+            Writer.WriteObjectStart();
+            Writer.WriteValue(TEXT("index"), Index);
+            Writer.WriteValue(TEXT("guid"), Registrations[Index].GUID);
+            Writer.WriteValue(TEXT("reason"),
+                Results[Index] == EAegisGUIDRegisterResult::GUIDConflict ? TEXT("guid_conflict") :
+                Results[Index] == EAegisGUIDRegisterResult::PathConflict ? TEXT("path_conflict") : TEXT("invalid"));
+            Writer.WriteObjectEnd();
         }
-    }
-    else
+        Writer.WriteArrayEnd();
+        return true;
+    }));
+
+    AddRoute(NS, TEXT("ResolveGUID"), BindSubsystem<UAegisSeedSubsystem>([](UAegisSeedSubsystem& Seed, const FParams& Params, FAegisJsonWriter& Writer)
     {
-        Result->SetBoolField(TEXT("success"), false);
-        Result->SetStringField(TEXT("error"), FString::Printf(TEXT("Unknown object path: %s"), *ObjectPath));
-    }
+        FAegisGUIDEntry Entry;
+        const bool bFound = Seed.ResolveGUID(Params.GetString(TEXT("GUID")), Entry);
+        Writer.WriteValue(TEXT("success"), bFound);
+        if (bFound)
+        {
+            WriteGUIDEntry(Writer, TEXT("data"), Entry);
+        }
+        return bFound;
+    }));
 
-    FString ResultString;
-    TSharedRef<TJsonWriter<>> Writer = TJsonWriterFactory<>::Create(&ResultString);
-    FJsonSerializer::Serialize(Result.ToSharedRef(), Writer);
+    AddRoute(NS, TEXT("VerifyGUIDEntity"), BindSubsystem<UAegisSeedSubsystem>([](UAegisSeedSubsystem& Seed, const FParams& Params, FAegisJsonWriter& Writer)
+    {
+        Writer.WriteValue(TEXT("success"), true);
+        Writer.WriteValue(TEXT("exists"), Seed.VerifyGUIDEntity(Params.GetString(TEXT("GUID")), Params.GetString(TEXT("EntityPath"))));
+        return true;
+    }));
 
-    return ResultString;
+    AddRoute(NS, TEXT("ClearGUIDRegistry"), BindSubsystem<UAegisSeedSubsystem>([](UAegisSeedSubsystem& Seed, const FParams& Params, FAegisJsonWriter& Writer)
+    {
+        Seed.ClearGUIDRegistry();
+        Writer.WriteValue(TEXT("success"), true);
+        return true;
+    }));
+
+    AddRoute(NS, TEXT("SetGlobalSeed"), BindSubsystem<UAegisSeedSubsystem>([](UAegisSeedSubsystem& Seed, const FParams& Params, FAegisJsonWriter& Writer)
+    {
+        Seed.SetGlobalSeed(Params.GetString(TEXT("Seed")), Params.GetBool(TEXT("bResetCounter")));
+        Writer.WriteValue(TEXT("success"), true);
+        return true;
+    }));
+
+    AddRoute(NS, TEXT("GetGlobalSeed"), BindSubsystem<UAegisSeedSubsystem>([](UAegisSeedSubsystem& Seed, const FParams& Params, FAegisJsonWriter& Writer)
+    {
+        Writer.WriteValue(TEXT("success"), true);
+        Writer.WriteValue(TEXT("seed"), Seed.GetGlobalSeed());
+        return true;
+    }));
+
+    AddRoute(NS, TEXT("GetSeedCounter"), BindSubsystem<UAegisSeedSubsystem>([](UAegisSeedSubsystem& Seed, const FParams& Params, FAegisJsonWriter& Writer)
+    {
+        Writer.WriteValue(TEXT("success"), true);
+        Writer.WriteValue(TEXT("counter"), Seed.GetSeedCounter());
+        return true;
+    }));
+
+    // State Capture Operations
+    AddRoute(NS, TEXT("CaptureAllActors"), BindSubsystem<UAegisSeedSubsystem>([](UAegisSeedSubsystem& Seed, const FParams& Params, FAegisJsonWriter& Writer)
+    {
+        // Streamed straight into the response: no intermediate string or JSON tree
+        Writer.WriteValue(TEXT("success"), true);
+        Writer.WriteIdentifierPrefix(TEXT("data"));
+        Seed.WriteAllActors(Writer, Params.GetStringArray(TEXT("ClassFilter")), Params.GetStringArray(TEXT("TagFilter")));
+        return true;
+    }));
+
+    AddRoute(NS, TEXT("CaptureActorsPage"), BindSubsystem<UAegisSeedSubsystem>([](UAegisSeedSubsystem& Seed, const FParams& Params, FAegisJsonWriter& Writer)
+    {
+        Writer.WriteValue(TEXT("success"), true);
+        Writer.WriteIdentifierPrefix(TEXT("data"));
+        Seed.WriteActorsPage(Writer, Params.GetString(TEXT("Cursor")), Params.GetInt(TEXT("PageSize")),
+            Params.GetStringArray(TEXT("ClassFilter")), Params.GetStringArray(TEXT("TagFilter")));
+            return true;
+    }));
+
+    AddRoute(NS, TEXT("ExportActorsNDJSON"), BindSubsystem<UAegisSeedSubsystem>([](UAegisSeedSubsystem& Seed, const FParams& Params, FAegisJsonWriter& Writer)
+    {
+        const int32 ActorCount = Seed.ExportActorsNDJSON(Params.GetString(TEXT("FilePath")),
+            Params.GetStringArray(TEXT("ClassFilter")), Params.GetStringArray(TEXT("TagFilter")));
+
+        Writer.WriteValue(TEXT("success"), ActorCount != INDEX_NONE);
+        if (ActorCount == INDEX_NONE)
+        {
+            Writer.WriteValue(TEXT("error"), TEXT("Cannot open output file"));
+            return false;
+        }
+        Writer.WriteObjectStart(TEXT("data"));
+        Writer.WriteValue(TEXT("actorCount"), ActorCount);
+        Writer.WriteObjectEnd();
+        return true;
+    }));
+
+    AddRoute(NS, TEXT("CaptureLandscape"), BindSubsystem<UAegisSeedSubsystem>([](UAegisSeedSubsystem& Seed, const FParams& Params, FAegisJsonWriter& Writer)
+    {
+        FAegisLandscapeCaptureOptions Options;
+        Options.bIncludeHeightmap = Params.GetBool(TEXT("bIncludeHeightmap"));
+        Options.bIncludeLayers = Params.GetBool(TEXT("bIncludeLayers"));
+        Options.KnownTiles = Params.GetStringMap(TEXT("KnownTiles"));
+        Options.TileDataPath = Params.GetString(TEXT("TileDataPath"));
+        Options.Codec = Params.GetString(TEXT("Codec"), Options.Codec);
+
+        Writer.WriteValue(TEXT("success"), true);
+        Writer.WriteIdentifierPrefix(TEXT("data"));
+        Seed.WriteLandscapes(Writer, Options);
+        return true;
+    }));
+
+    AddRoute(NS, TEXT("CaptureFoliage"), BindSubsystem<UAegisSeedSubsystem>([](UAegisSeedSubsystem& Seed, const FParams& Params, FAegisJsonWriter& Writer)
+    {
+        FAegisFoliageCaptureOptions Options;
+        Options.bIncludeInstances = Params.GetBool(TEXT("bIncludeInstances"));
+        Options.CellSize = Params.GetNumber(TEXT("CellSize"));
+        Options.KnownCells = Params.GetStringMap(TEXT("KnownCells"));
+        Options.InstanceDataPath = Params.GetString(TEXT("InstanceDataPath"));
+        Options.Codec = Params.GetString(TEXT("Codec"), Options.Codec);
+
+        Writer.WriteValue(TEXT("success"), true);
+        Writer.WriteIdentifierPrefix(TEXT("data"));
+        Seed.WriteFoliage(Writer, Options);
+        return true;
+    }));
+
+    AddRoute(NS, TEXT("RestoreFoliage"), BindSubsystem<UAegisSeedSubsystem>([](UAegisSeedSubsystem& Seed, const FParams& Params, FAegisJsonWriter& Writer)
+    {
+        FAegisFoliageRestoreResult Result;
+        FString Error;
+        const bool bRestored = Seed.RestoreFoliage(Params.GetString(TEXT("InputPath")),
+            Params.GetInt(TEXT("BatchSize"), FAegisFoliageCapture::DefaultRestoreBatchSize), Result, Error);
+
+        Writer.WriteValue(TEXT("success"), bRestored);
+        if (!bRestored)
+        {
+            Writer.WriteValue(TEXT("error"), Error);
+            return false;
+        }
+
+        Writer.WriteObjectStart(TEXT("data"));
+        Writer.WriteValue(TEXT("cellsRestored"), Result.CellsRestored);
+        Writer.WriteValue(TEXT("instancesRemoved"), Result.InstancesRemoved);
+        Writer.WriteValue(TEXT("instancesAdded"), Result.InstancesAdded);
+        Writer.WriteArrayStart(TEXT("missingTypes"));
+        for (const FString& MissingType : Result.MissingTypes)
+        {
+            Writer.WriteValue(MissingType);
+        }
+        Writer.WriteArrayEnd();
+        Writer.WriteObjectEnd();
+        return true;
+    }));
+
+    AddRoute(NS, TEXT("StoreSnapshot"), BindSubsystem<UAegisSeedSubsystem>([](UAegisSeedSubsystem& Seed, const FParams& Params, FAegisJsonWriter& Writer)
+    {
+        const bool bStored = Seed.StoreSnapshot(Params.GetString(TEXT("SnapshotId")), Params.GetJsonString(TEXT("SnapshotData")));
+        Writer.WriteValue(TEXT("success"), bStored);
+        return bStored;
+    }));
+
+    AddRoute(NS, TEXT("LoadSnapshot"), BindSubsystem<UAegisSeedSubsystem>([](UAegisSeedSubsystem& Seed, const FParams& Params, FAegisJsonWriter& Writer)
+    {
+        return WriteSnapshotPayload(Seed.LoadSnapshot(Params.GetString(TEXT("SnapshotId"))), Writer);
+    }));
+
+    AddRoute(NS, TEXT("ListSnapshots"), BindSubsystem<UAegisSeedSubsystem>([](UAegisSeedSubsystem& Seed, const FParams& Params, FAegisJsonWriter& Writer)
+    {
+        Writer.WriteValue(TEXT("success"), true);
+        Writer.WriteArrayStart(TEXT("snapshots"));
+        for (const FAegisWorldSnapshot& Snapshot : Seed.ListSnapshots())
+        {
+            WriteSnapshotInfo(Writer, Snapshot);
+        }
+        Writer.WriteArrayEnd();
+        return true;
+    }));
+
+    AddRoute(NS, TEXT("DeleteSnapshot"), BindSubsystem<UAegisSeedSubsystem>([](UAegisSeedSubsystem& Seed, const FParams& Params, FAegisJsonWriter& Writer)
+    {
+        const bool bDeleted = Seed.DeleteSnapshot(Params.GetString(TEXT("SnapshotId")));
+        Writer.WriteValue(TEXT("success"), bDeleted);
+        return bDeleted;
+    }));
+
+    AddRoute(NS, TEXT("ExportSnapshot"), BindSubsystem<UAegisSeedSubsystem>([](UAegisSeedSubsystem& Seed, const FParams& Params, FAegisJsonWriter& Writer)
+    {
+        const FString OutputPath = Params.GetString(TEXT("OutputPath"));
+        const bool bCompress = Params.GetBool(TEXT("bCompress"), Params.GetBool(TEXT("Compress")));
+        const bool bBinary = Params.GetString(TEXT("Format")) == TEXT("binary") || OutputPath.EndsWith(FAegisBinarySnapshot::FileExtension);
+
+        const bool bExported = Seed.ExportSnapshotWithOptions(
+            Params.GetString(TEXT("SnapshotId")),
+            Params.GetJsonString(TEXT("SnapshotData")),
+            OutputPath,
+            bBinary,
+            Params.GetString(TEXT("Codec"), bCompress ? TEXT("kraken") : TEXT("none")),
+            Params.GetInt(TEXT("CompressionLevel"), static_cast<int32>(FOodleDataCompression::ECompressionLevel::Normal)));
+
+        Writer.WriteValue(TEXT("success"), bExported);
+        if (bExported)
+        {
+            Writer.WriteObjectStart(TEXT("data"));
+            Writer.WriteValue(TEXT("outputPath"), OutputPath);
+            Writer.WriteValue(TEXT("fileSize"), IFileManager::Get().FileSize(*OutputPath));
+            Writer.WriteObjectEnd();
+        }
+        return bExported;
+    }));
+
+    AddRoute(NS, TEXT("ImportSnapshot"), BindSubsystem<UAegisSeedSubsystem>([](UAegisSeedSubsystem& Seed, const FParams& Params, FAegisJsonWriter& Writer)
+    {
+        return WriteSnapshotPayload(Seed.ImportSnapshot(Params.GetString(TEXT("InputPath"))), Writer);
+    }));
+
+    // State Restoration Operations
+    AddRoute(NS, TEXT("RestoreWorldState"), BindSubsystem<UAegisSeedSubsystem>([](UAegisSeedSubsystem& Seed, const FParams& Params, FAegisJsonWriter& Writer)
+    {
+        const bool bRestored = Seed.RestoreWorldState(
+            Params.GetString(TEXT("SnapshotId")),
+            Params.GetJsonString(TEXT("Entities"), TEXT("[]")),
+            Params.GetString(TEXT("MergeMode"), TEXT("merge")),
+            Params.GetBool(TEXT("bPreserveGUIDs"), true));
+        Writer.WriteValue(TEXT("success"), bRestored);
+        return bRestored;
+    }));
+
+    AddRoute(NS, TEXT("RestoreWorldStateFromFile"), BindSubsystem<UAegisSeedSubsystem>([](UAegisSeedSubsystem& Seed, const FParams& Params, FAegisJsonWriter& Writer)
+    {
+        const bool bRestored = Seed.RestoreWorldStateFromFile(
+            Params.GetString(TEXT("InputPath")),
+            Params.GetString(TEXT("MergeMode"), TEXT("merge")),
+            Params.GetBool(TEXT("bPreserveGUIDs"), true));
+        Writer.WriteValue(TEXT("success"), bRestored);
+        return bRestored;
+    }));
+
+    AddRoute(NS, TEXT("ComputeWorldHash"), BindSubsystem<UAegisSeedSubsystem>([](UAegisSeedSubsystem& Seed, const FParams& Params, FAegisJsonWriter& Writer)
+    {
+        FAegisWorldHashOptions Options;
+        Options.CellSize = Params.GetNumber(TEXT("CellSize"));
+        Options.Properties = Params.GetStringArray(TEXT("Properties"));
+
+        return Seed.WriteWorldHash(Writer, Options,
+            FMath::Clamp(Params.GetInt(TEXT("Depth"), 1), 0, 3),
+            Params.GetStringMap(TEXT("KnownHashes")),
+            Params.GetString(TEXT("SnapshotId")));
+    }));
+
+    AddRoute(NS, TEXT("SyncWorldState"), BindSubsystem<UAegisSeedSubsystem>([](UAegisSeedSubsystem& Seed, const FParams& Params, FAegisJsonWriter& Writer)
+    {
+        return WriteJsonResult(Seed.SyncWorldState(
+            Params.GetString(TEXT("TargetSnapshotId")),
+            Params.GetJsonString(TEXT("TargetEntities"), TEXT("[]")),
+            Params.GetBool(TEXT("bCaptureCurrentFirst"), Params.GetBool(TEXT("CaptureCurrentFirst"), true)),
+            Params.GetString(TEXT("ConflictResolution")),
+            Params.GetBool(TEXT("bDryRun"), Params.GetBool(TEXT("DryRun"))),
+            Params.GetString(TEXT("BaseSnapshotId"))), Writer);
+    }));
+
+    AddRoute(NS, TEXT("MergeWorldStates"), BindSubsystem<UAegisSeedSubsystem>([](UAegisSeedSubsystem& Seed, const FParams& Params, FAegisJsonWriter& Writer)
+    {
+        return WriteJsonResult(Seed.MergeWorldStates(
+            Params.GetString(TEXT("SourceSnapshotId")),
+            Params.GetString(TEXT("TargetSnapshotId")),
+            Params.GetJsonString(TEXT("Changes"), TEXT("[]")),
+            Params.GetString(TEXT("ConflictResolution")),
+            Params.GetBool(TEXT("bPreserveSourceGUIDs"), Params.GetBool(TEXT("PreserveSourceGUIDs"), true)),
+            Params.GetBool(TEXT("bDryRun"), Params.GetBool(TEXT("DryRun"))),
+            Params.GetBool(TEXT("bIncludeTransforms"), Params.GetBool(TEXT("IncludeTransforms"), true)),
+            Params.GetBool(TEXT("bIncludeProperties"), Params.GetBool(TEXT("IncludeProperties"), true))), Writer);
+    }));
+
+    AddRoute(NS, TEXT("ApplyDiff"), BindSubsystem<UAegisSeedSubsystem>([](UAegisSeedSubsystem& Seed, const FParams& Params, FAegisJsonWriter& Writer)
+    {
+        return WriteJsonResult(Seed.ApplyDiff(
+            Params.GetString(TEXT("DiffId")),
+            Params.GetJsonString(TEXT("Changes"), TEXT("[]")),
+            Params.GetString(TEXT("ConflictResolution"))), Writer);
+    }));
+
+    // Delta Snapshots
+    AddRoute(NS, TEXT("CaptureDeltaSnapshot"), BindSubsystem<UAegisSeedSubsystem>([](UAegisSeedSubsystem& Seed, const FParams& Params, FAegisJsonWriter& Writer)
+    {
+        return WriteSnapshotPayload(Seed.CaptureDeltaSnapshot(Params.GetString(TEXT("BaseSnapshotId"))), Writer);
+    }));
+
+    AddRoute(NS, TEXT("GetDeltaSnapshot"), BindSubsystem<UAegisSeedSubsystem>([](UAegisSeedSubsystem& Seed, const FParams& Params, FAegisJsonWriter& Writer)
+    {
+        return WriteSnapshotPayload(Seed.GetDeltaSnapshot(Params.GetString(TEXT("BaseSnapshotId")), Params.GetString(TEXT("DeltaId"))), Writer);
+    }));
+
+    AddRoute(NS, TEXT("CompactDeltaChain"), BindSubsystem<UAegisSeedSubsystem>([](UAegisSeedSubsystem& Seed, const FParams& Params, FAegisJsonWriter& Writer)
+    {
+        return WriteSnapshotPayload(Seed.CompactDeltaChain(Params.GetString(TEXT("BaseSnapshotId"))), Writer);
+    }));
+
+    // Level Info
+    AddRoute(NS, TEXT("GetCurrentLevelInfo"), BindSubsystem<UAegisSeedSubsystem>([](UAegisSeedSubsystem& Seed, const FParams& Params, FAegisJsonWriter& Writer)
+    {
+        Writer.WriteValue(TEXT("success"), true);
+        Writer.WriteIdentifierPrefix(TEXT("data"));
+        Seed.WriteCurrentLevelInfo(Writer);
+        return true;
+    }));
 }
 
-void UAegisRemoteControlHandler::RegisterFunctionHandlers()
+void UAegisRemoteControlHandler::RegisterJournalRoutes()
 {
-    // Register AEGIS functions with Remote Control
-    // This would integrate with UE's Remote Control preset system
+    using FParams = FAegisRequestParams;
+    const FName NS = NAME_AegisChangeJournal;
 
-    UE_LOG(LogAegisBridge, Log, TEXT("Registered AEGIS function handlers"));
+    AddRoute(NS, TEXT("GetChangesSince"), BindSubsystem<UAegisChangeJournal>([](UAegisChangeJournal& Journal, const FParams& Params, FAegisJsonWriter& Writer)
+    {
+        // Sequences stay well inside the exactly representable range of a JSON number
+        const uint64 Since = static_cast<uint64>(FMath::Max(Params.GetNumber(TEXT("Since")), 0.0));
+
+        Writer.WriteValue(TEXT("success"), true);
+        Writer.WriteIdentifierPrefix(TEXT("data"));
+        Journal.WriteChangesSince(Since, FMath::Max(Params.GetInt(TEXT("MaxRecords"), 1000), 0), Writer);
+        return true;
+    }));
 }
 
-void UAegisRemoteControlHandler::UnregisterFunctionHandlers()
+void UAegisRemoteControlHandler::RegisterJobRoutes()
 {
-    // Unregister AEGIS functions from Remote Control
+    using FParams = FAegisRequestParams;
+    const FName NS = NAME_AegisJobManager;
 
-    UE_LOG(LogAegisBridge, Log, TEXT("Unregistered AEGIS function handlers"));
+    AddRoute(NS, TEXT("StartJob"), BindSubsystem<UAegisJobManager>([](UAegisJobManager& Jobs, const FParams& Params, FAegisJsonWriter& Writer)
+    {
+        // Every registered kind is already in the name table; the client's string is never added to it
+        const FString KindName = Params.GetString(TEXT("Kind"));
+        const FName Kind(*KindName, FNAME_Find);
+
+        FString Error;
+        FString JobId;
+        if (Kind.IsNone())
+        {
+            Error = FString::Printf(TEXT("Unknown job kind: %s"), *KindName);
+        }
+        else
+        {
+            JobId = Jobs.StartJob(Kind, Params, Error);
+        }
+
+        Writer.WriteValue(TEXT("success"), !JobId.IsEmpty());
+        if (JobId.IsEmpty())
+        {
+            Writer.WriteValue(TEXT("error"), Error);
+            return false;
+        }
+        Writer.WriteObjectStart(TEXT("data"));
+        Writer.WriteValue(TEXT("jobId"), JobId);
+        Writer.WriteObjectEnd();
+        return true;
+    }));
+
+    // Status and result queries share the unknown-id response
+    auto WriteJobQuery = [](bool (UAegisJobManager::*Query)(const FString&, FAegisJsonWriter&) const)
+    {
+        return BindSubsystem<UAegisJobManager>([Query](UAegisJobManager& Jobs, const FParams& Params, FAegisJsonWriter& Writer)
+        {
+            const FString JobId = Params.GetString(TEXT("JobId"));
+            if (!Jobs.HasJob(JobId))
+            {
+                Writer.WriteValue(TEXT("success"), false);
+                Writer.WriteValue(TEXT("error"), FString::Printf(TEXT("Unknown job: %s"), *JobId));
+                return false;
+            }
+
+            Writer.WriteValue(TEXT("success"), true);
+            Writer.WriteIdentifierPrefix(TEXT("data"));
+            (Jobs.*Query)(JobId, Writer);
+            return true;
+        });
+    };
+
+    AddRoute(NS, TEXT("GetJob"), WriteJobQuery(&UAegisJobManager::WriteJobStatus));
+    AddRoute(NS, TEXT("GetJobResult"), WriteJobQuery(&UAegisJobManager::WriteJobResult));
+
+    AddRoute(NS, TEXT("CancelJob"), BindSubsystem<UAegisJobManager>([](UAegisJobManager& Jobs, const FParams& Params, FAegisJsonWriter& Writer)
+    {
+        const bool bCancelled = Jobs.CancelJob(Params.GetString(TEXT("JobId")));
+        Writer.WriteValue(TEXT("success"), bCancelled);
+        if (!bCancelled)
+        {
+            Writer.WriteValue(TEXT("error"), TEXT("Job not found or already finished"));
+        }
+        return bCancelled;
+    }));
+
+    AddRoute(NS, TEXT("ListJobs"), BindSubsystem<UAegisJobManager>([](UAegisJobManager& Jobs, const FParams& Params, FAegisJsonWriter& Writer)
+    {
+        Writer.WriteValue(TEXT("success"), true);
+        Writer.WriteObjectStart(TEXT("data"));
+        Writer.WriteValue(TEXT("active"), Jobs.GetActiveJobCount());
+        Writer.WriteIdentifierPrefix(TEXT("jobs"));
+        Jobs.WriteJobList(Writer);
+        Writer.WriteObjectEnd();
+        return true;
+    }));
 }
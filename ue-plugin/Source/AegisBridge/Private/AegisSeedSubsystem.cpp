@@ -1,17 +1,33 @@
 // Copyright AEGIS Team. All Rights Reserved.
 
 #include "AegisSeedSubsystem.h"
+#include "AegisActorCapture.h"
 #include "AegisBridgeModule.h"
+#include "AegisBridgeStats.h"
+#include "AegisFoliageCapture.h"
+#include "AegisGUIDGenerator.h"
+#include "AegisLandscapeCapture.h"
+#include "AegisParallelJson.h"
+#include "AegisBinarySnapshot.h"
+#include "AegisSnapshotDelta.h"
+#include "AegisSnapshotMerge.h"
+#include "AegisChangeJournal.h"
+#include "AegisSnapshotCompression.h"
+#include "AegisWorldHash.h"
+#include "AegisWorldRestore.h"
 #include "Editor.h"
 #include "Engine/World.h"
 #include "GameFramework/Actor.h"
+#include "EngineUtils.h"
 #include "Landscape.h"
 #include "LandscapeProxy.h"
 #include "InstancedFoliageActor.h"
-#include "Misc/SecureHash.h"
+#include "FoliageType.h"
 #include "Serialization/JsonSerializer.h"
 #include "HAL/FileManager.h"
 #include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include "Serialization/MemoryWriter.h"
 #include "Compression/OodleDataCompressionUtil.h"
 
 UAegisSeedSubsystem* UAegisSeedSubsystem::Get()
@@ -26,11 +42,27 @@ UAegisSeedSubsystem* UAegisSeedSubsystem::Get()
 void UAegisSeedSubsystem::Initialize(FSubsystemCollectionBase& Collection)
 {
     Super::Initialize(Collection);
+    SnapshotStore.Initialize(FPaths::Combine(FPaths::ProjectSavedDir(), TEXT("Aegis"), TEXT("Snapshots")));
+
+    // Registrations are flushed on this interval rather than per call
+    static constexpr float RegistrySaveInterval = 30.0f;
+
+    GUIDRegistry.Load(GetGUIDRegistryPath());
+    RegistrySaveHandle = FTSTicker::GetCoreTicker().AddTicker(
+        FTickerDelegate::CreateUObject(this, &UAegisSeedSubsystem::SaveGUIDRegistry), RegistrySaveInterval);
+
     UE_LOG(LogAegisBridge, Log, TEXT("AEGIS Seed Subsystem initialized"));
 }
 
 void UAegisSeedSubsystem::Deinitialize()
 {
+    FTSTicker::GetCoreTicker().RemoveTicker(RegistrySaveHandle);
+    RegistrySaveHandle.Reset();
+    SaveGUIDRegistry(0.0f);
+
+    CaptureSessions.Empty();
+    DeltaChains.Empty();
+    SnapshotStore.Shutdown();
     UE_LOG(LogAegisBridge, Log, TEXT("AEGIS Seed Subsystem deinitialized"));
     Super::Deinitialize();
 }
@@ -41,119 +73,107 @@ void UAegisSeedSubsystem::Deinitialize()
 
 FString UAegisSeedSubsystem::GenerateGUID(const FString& Namespace, const FString& EntityType, const FString& Seed, int32 Counter, const FString& EntityName)
 {
-    // Create deterministic input string
-    FString InputString = FString::Printf(TEXT("%s:%s:%s:%d:%s"), *Namespace, *EntityType, *Seed, Counter, *EntityName);
+    AEGIS_COMMAND_SCOPE(AegisSeedSubsystem, GenerateGUID);
 
-    // Compute SHA256 hash
-    FString Hash = ComputeSHA256(InputString);
-
-    // Get namespace code
-    FString NamespaceCode = GetNamespaceCode(Namespace);
+    return FAegisGUIDGenerator::Generate(Namespace, EntityType, Seed, Counter, EntityName);
+}
 
-    // Format as GUID: XXX-XXXXXXXX-XXXX-XXXX-XXXXXXXXXXXX
-    FString GUID = FString::Printf(TEXT("%s-%s-%s-%s-%s"),
-        *NamespaceCode,
-        *Hash.Mid(0, 8).ToUpper(),
-        *Hash.Mid(8, 4).ToUpper(),
-        *Hash.Mid(12, 4).ToUpper(),
-        *Hash.Mid(16, 12).ToUpper());
+TArray<FString> UAegisSeedSubsystem::GenerateGUIDBatch(const FString& Namespace, const FString& EntityType, const FString& Seed, int32 StartCounter, int32 Count)
+{
+    AEGIS_COMMAND_SCOPE(AegisSeedSubsystem, GenerateGUIDBatch);
 
-    return GUID;
+    TArray<FString> GUIDs;
+    FAegisGUIDGenerator::GenerateBatch(Namespace, EntityType, Seed, StartCounter, Count, FStringView(), GUIDs);
+    return GUIDs;
 }
 
 bool UAegisSeedSubsystem::RegisterGUID(const FString& GUID, const FString& EntityPath, const FString& EntityType, const FString& Metadata)
 {
-    // Check for existing registration
-    if (GUIDRegistry.Contains(GUID))
-    {
-        const FAegisGUIDEntry& Existing = GUIDRegistry[GUID];
-        if (Existing.EntityPath != EntityPath)
-        {
-            UE_LOG(LogAegisBridge, Warning, TEXT("GUID already registered to different entity: %s"), *GUID);
-            return false;
-        }
-    }
-
-    if (PathToGUIDMap.Contains(EntityPath))
-    {
-        const FString& ExistingGUID = PathToGUIDMap[EntityPath];
-        if (ExistingGUID != GUID)
-        {
-            UE_LOG(LogAegisBridge, Warning, TEXT("Entity path already has different GUID: %s"), *EntityPath);
-            return false;
-        }
-    }
+    AEGIS_COMMAND_SCOPE(AegisSeedSubsystem, RegisterGUID);
 
-    // Create entry
-    FAegisGUIDEntry Entry;
-    Entry.GUID = GUID;
-    Entry.EntityPath = EntityPath;
-    Entry.EntityType = EntityType;
-    Entry.Metadata = Metadata;
-    Entry.CreatedAt = FDateTime::UtcNow();
-    Entry.Version = GUIDRegistry.Contains(GUID) ? GUIDRegistry[GUID].Version + 1 : 1;
-
-    // Extract entity name from path
-    int32 LastSlash;
-    if (EntityPath.FindLastChar('/', LastSlash))
-    {
-        Entry.EntityName = EntityPath.Mid(LastSlash + 1);
-    }
-    else
+    switch (GUIDRegistry.Register(GUID, EntityPath, EntityType, Metadata))
     {
-        Entry.EntityName = EntityPath;
+    case EAegisGUIDRegisterResult::Registered:
+        UE_LOG(LogAegisBridge, Verbose, TEXT("Registered GUID: %s -> %s"), *GUID, *EntityPath);
+        return true;
+    case EAegisGUIDRegisterResult::GUIDConflict:
+        UE_LOG(LogAegisBridge, Warning, TEXT("GUID already registered to different entity: %s"), *GUID);
+        return false;
+    case EAegisGUIDRegisterResult::PathConflict:
+        UE_LOG(LogAegisBridge, Warning, TEXT("Entity path already has different GUID: %s"), *EntityPath);
+        return false;
+    default:
+        UE_LOG(LogAegisBridge, Warning, TEXT("Invalid GUID registration: '%s' -> %s"), *GUID, *EntityPath);
+        return false;
     }
+}
 
-    // Register
-    GUIDRegistry.Add(GUID, Entry);
-    PathToGUIDMap.Add(EntityPath, GUID);
+int32 UAegisSeedSubsystem::RegisterGUIDs(TConstArrayView<FAegisGUIDRegistration> Registrations, TArray<EAegisGUIDRegisterResult>* OutResults)
+{
+    AEGIS_COMMAND_SCOPE(AegisSeedSubsystem, RegisterGUIDs);
 
-    UE_LOG(LogAegisBridge, Verbose, TEXT("Registered GUID: %s -> %s"), *GUID, *EntityPath);
-    return true;
+    return GUIDRegistry.RegisterBatch(Registrations, OutResults);
 }
 
 bool UAegisSeedSubsystem::ResolveGUID(const FString& GUID, FAegisGUIDEntry& OutEntry)
 {
-    if (const FAegisGUIDEntry* Entry = GUIDRegistry.Find(GUID))
+    AEGIS_COMMAND_SCOPE(AegisSeedSubsystem, ResolveGUID);
+
+    FAegisGUIDRegistry::FEntryView Entry;
+    if (!GUIDRegistry.Find(GUID, Entry))
     {
-        OutEntry = *Entry;
-        return true;
+        return false;
     }
-    return false;
+
+    OutEntry.GUID = MoveTemp(Entry.GUID);
+    OutEntry.EntityPath = MoveTemp(Entry.EntityPath);
+    OutEntry.EntityType = MoveTemp(Entry.EntityType);
+    OutEntry.EntityName = MoveTemp(Entry.EntityName);
+    OutEntry.Metadata = MoveTemp(Entry.Metadata);
+    OutEntry.CreatedAt = Entry.CreatedAt;
+    OutEntry.Version = Entry.Version;
+    return true;
 }
 
 bool UAegisSeedSubsystem::VerifyGUIDEntity(const FString& GUID, const FString& EntityPath)
 {
+    AEGIS_COMMAND_SCOPE(AegisSeedSubsystem, VerifyGUIDEntity);
+
     UWorld* World = GEditor ? GEditor->GetEditorWorldContext().World() : nullptr;
     if (!World) return false;
 
-    // Try to find the actor
-    AActor* Actor = FindObject<AActor>(World->GetCurrentLevel(), *EntityPath);
-    if (!Actor)
-    {
-        // Try name-based search
-        for (TActorIterator<AActor> It(World); It; ++It)
-        {
-            if (It->GetPathName() == EntityPath || It->GetName() == EntityPath)
-            {
-                return true;
-            }
-        }
-        return false;
-    }
-
-    return true;
+    return FAegisBridgeModule::Get().GetActorIndex().FindActor(World, EntityPath) != nullptr;
 }
 
 void UAegisSeedSubsystem::ClearGUIDRegistry()
 {
+    AEGIS_COMMAND_SCOPE(AegisSeedSubsystem, ClearGUIDRegistry);
+
     GUIDRegistry.Empty();
-    PathToGUIDMap.Empty();
+    SaveGUIDRegistry(0.0f);
     UE_LOG(LogAegisBridge, Log, TEXT("GUID registry cleared"));
 }
 
+FString UAegisSeedSubsystem::GetGUIDRegistryPath()
+{
+    return FPaths::Combine(FPaths::ProjectSavedDir(), TEXT("Aegis"), TEXT("GUIDRegistry.bin"));
+}
+
+bool UAegisSeedSubsystem::SaveGUIDRegistry(float DeltaTime)
+{
+    if (GUIDRegistry.IsDirty())
+    {
+        const FString Path = GetGUIDRegistryPath();
+        IFileManager::Get().MakeDirectory(*FPaths::GetPath(Path), true);
+        GUIDRegistry.Save(Path);
+    }
+    return true;
+}
+
 void UAegisSeedSubsystem::SetGlobalSeed(const FString& Seed, bool bResetCounter)
 {
+    AEGIS_COMMAND_SCOPE(AegisSeedSubsystem, SetGlobalSeed);
+
     GlobalSeed = Seed;
     if (bResetCounter)
     {
@@ -168,527 +188,1770 @@ void UAegisSeedSubsystem::SetGlobalSeed(const FString& Seed, bool bResetCounter)
 
 FString UAegisSeedSubsystem::CaptureAllActors(const TArray<FString>& ClassFilter, const TArray<FString>& TagFilter)
 {
-    UWorld* World = GEditor ? GEditor->GetEditorWorldContext().World() : nullptr;
-    if (!World)
-    {
-        return TEXT("{}");
-    }
+    AEGIS_COMMAND_SCOPE(AegisSeedSubsystem, CaptureAllActors);
 
-    TSharedPtr<FJsonObject> Result = MakeShareable(new FJsonObject());
-    TArray<TSharedPtr<FJsonValue>> ActorArray;
+    FString ResultString;
+    TSharedRef<FAegisJsonWriter> Writer = FAegisJsonWriterFactory::Create(&ResultString);
+    WriteAllActors(*Writer, ClassFilter, TagFilter);
+    Writer->Close();
 
-    for (TActorIterator<AActor> It(World); It; ++It)
-    {
-        AActor* Actor = *It;
+    return ResultString;
+}
 
-        // Apply class filter
-        if (ClassFilter.Num() > 0)
-        {
-            bool bMatchesClass = false;
-            for (const FString& ClassFilterStr : ClassFilter)
-            {
-                if (Actor->GetClass()->GetName().Contains(ClassFilterStr))
-                {
-                    bMatchesClass = true;
-                    break;
-                }
-            }
-            if (!bMatchesClass) continue;
-        }
+void UAegisSeedSubsystem::WriteAllActors(FAegisJsonWriter& Writer, const TArray<FString>& ClassFilter, const TArray<FString>& TagFilter)
+{
+    UWorld* World = GEditor ? GEditor->GetEditorWorldContext().World() : nullptr;
 
-        // Apply tag filter
-        if (TagFilter.Num() > 0)
-        {
-            bool bHasAllTags = true;
-            for (const FString& Tag : TagFilter)
-            {
-                if (!Actor->Tags.ContainsByPredicate([&Tag](const FName& ActorTag) {
-                    return ActorTag.ToString() == Tag;
-                }))
-                {
-                    bHasAllTags = false;
-                    break;
-                }
-            }
-            if (!bHasAllTags) continue;
-        }
-
-        // Create actor object
-        TSharedPtr<FJsonObject> ActorObj = MakeShareable(new FJsonObject());
-
-        // Check if we have a registered GUID for this actor
-        FString* ExistingGUID = PathToGUIDMap.Find(Actor->GetPathName());
-        ActorObj->SetStringField(TEXT("guid"), ExistingGUID ? *ExistingGUID : TEXT(""));
-        ActorObj->SetStringField(TEXT("name"), Actor->GetName());
-        ActorObj->SetStringField(TEXT("class"), Actor->GetClass()->GetName());
-        ActorObj->SetStringField(TEXT("path"), Actor->GetPathName());
-
-        // Transform
-        TSharedPtr<FJsonObject> TransformObj = MakeShareable(new FJsonObject());
-        FVector Location = Actor->GetActorLocation();
-        FRotator Rotation = Actor->GetActorRotation();
-        FVector Scale = Actor->GetActorScale3D();
-
-        TSharedPtr<FJsonObject> LocObj = MakeShareable(new FJsonObject());
-        LocObj->SetNumberField(TEXT("x"), Location.X);
-        LocObj->SetNumberField(TEXT("y"), Location.Y);
-        LocObj->SetNumberField(TEXT("z"), Location.Z);
-        TransformObj->SetObjectField(TEXT("location"), LocObj);
-
-        TSharedPtr<FJsonObject> RotObj = MakeShareable(new FJsonObject());
-        RotObj->SetNumberField(TEXT("pitch"), Rotation.Pitch);
-        RotObj->SetNumberField(TEXT("yaw"), Rotation.Yaw);
-        RotObj->SetNumberField(TEXT("roll"), Rotation.Roll);
-        TransformObj->SetObjectField(TEXT("rotation"), RotObj);
-
-        TSharedPtr<FJsonObject> ScaleObj = MakeShareable(new FJsonObject());
-        ScaleObj->SetNumberField(TEXT("x"), Scale.X);
-        ScaleObj->SetNumberField(TEXT("y"), Scale.Y);
-        ScaleObj->SetNumberField(TEXT("z"), Scale.Z);
-        TransformObj->SetObjectField(TEXT("scale"), ScaleObj);
-
-        ActorObj->SetObjectField(TEXT("transform"), TransformObj);
-
-        // Tags
-        TArray<TSharedPtr<FJsonValue>> TagArray;
-        for (const FName& Tag : Actor->Tags)
-        {
-            TagArray.Add(MakeShareable(new FJsonValueString(Tag.ToString())));
-        }
-        ActorObj->SetArrayField(TEXT("tags"), TagArray);
+    // Only the gather runs on the game thread; filtering and encoding are spread over workers
+    FAegisActorCapture Capture;
+    Capture.Gather(World);
 
-        // Components
-        TArray<TSharedPtr<FJsonValue>> CompArray;
-        for (UActorComponent* Component : Actor->GetComponents())
-        {
-            TSharedPtr<FJsonObject> CompObj = MakeShareable(new FJsonObject());
-            CompObj->SetStringField(TEXT("name"), Component->GetName());
-            CompObj->SetStringField(TEXT("class"), Component->GetClass()->GetName());
-            CompArray.Add(MakeShareable(new FJsonValueObject(CompObj)));
-        }
-        ActorObj->SetArrayField(TEXT("components"), CompArray);
+    TArray<int32> Indices;
+    Capture.Filter(MakeCaptureQuery(ClassFilter, TagFilter), Indices);
 
-        ActorArray.Add(MakeShareable(new FJsonValueObject(ActorObj)));
-    }
+    Writer.WriteObjectStart();
+    AegisJson::WriteRawJson(Writer, TEXT("actors"), Capture.EncodeArray(Indices, GUIDRegistry));
+    Writer.WriteObjectEnd();
+}
 
-    Result->SetArrayField(TEXT("actors"), ActorArray);
+FString UAegisSeedSubsystem::CaptureActorsPage(const FString& Cursor, int32 PageSize, const TArray<FString>& ClassFilter, const TArray<FString>& TagFilter)
+{
+    AEGIS_COMMAND_SCOPE(AegisSeedSubsystem, CaptureActorsPage);
 
     FString ResultString;
-    TSharedRef<TJsonWriter<>> Writer = TJsonWriterFactory<>::Create(&ResultString);
-    FJsonSerializer::Serialize(Result.ToSharedRef(), Writer);
+    TSharedRef<FAegisJsonWriter> Writer = FAegisJsonWriterFactory::Create(&ResultString);
+    WriteActorsPage(*Writer, Cursor, PageSize, ClassFilter, TagFilter);
+    Writer->Close();
 
     return ResultString;
 }
 
-FString UAegisSeedSubsystem::CaptureLandscape(bool bIncludeHeightmap, bool bIncludeLayers)
+void UAegisSeedSubsystem::WriteActorsPage(FAegisJsonWriter& Writer, const FString& Cursor, int32 PageSize, const TArray<FString>& ClassFilter, const TArray<FString>& TagFilter)
 {
-    UWorld* World = GEditor ? GEditor->GetEditorWorldContext().World() : nullptr;
-    if (!World)
-    {
-        return TEXT("{}");
-    }
-
-    TSharedPtr<FJsonObject> Result = MakeShareable(new FJsonObject());
-    TArray<TSharedPtr<FJsonValue>> LandscapeArray;
-
-    for (TActorIterator<ALandscapeProxy> It(World); It; ++It)
-    {
-        ALandscapeProxy* Landscape = *It;
+    static constexpr int32 DefaultPageSize = 1000;
+    static constexpr int32 MaxPageSize = 10000;
 
-        TSharedPtr<FJsonObject> LandscapeObj = MakeShareable(new FJsonObject());
-        LandscapeObj->SetStringField(TEXT("name"), Landscape->GetName());
-        LandscapeObj->SetStringField(TEXT("path"), Landscape->GetPathName());
+    ExpireCaptureSessions();
 
-        // Transform
-        FVector Location = Landscape->GetActorLocation();
-        FRotator Rotation = Landscape->GetActorRotation();
+    PageSize = PageSize > 0 ? FMath::Min(PageSize, MaxPageSize) : DefaultPageSize;
 
-        TSharedPtr<FJsonObject> TransformObj = MakeShareable(new FJsonObject());
-        TSharedPtr<FJsonObject> LocObj = MakeShareable(new FJsonObject());
-        LocObj->SetNumberField(TEXT("x"), Location.X);
-        LocObj->SetNumberField(TEXT("y"), Location.Y);
-        LocObj->SetNumberField(TEXT("z"), Location.Z);
-        TransformObj->SetObjectField(TEXT("location"), LocObj);
+    // Cursor format: "<SessionId>:<Offset>"
+    FString SessionId;
+    int32 Offset = 0;
+    FAegisCaptureSession* Session = nullptr;
 
-        TSharedPtr<FJsonObject> RotObj = MakeShareable(new FJsonObject());
-        RotObj->SetNumberField(TEXT("pitch"), Rotation.Pitch);
-        RotObj->SetNumberField(TEXT("yaw"), Rotation.Yaw);
-        RotObj->SetNumberField(TEXT("roll"), Rotation.Roll);
-        TransformObj->SetObjectField(TEXT("rotation"), RotObj);
-
-        LandscapeObj->SetObjectField(TEXT("transform"), TransformObj);
+    if (Cursor.IsEmpty())
+    {
+        UWorld* World = GEditor ? GEditor->GetEditorWorldContext().World() : nullptr;
 
-        // Size info (simplified)
-        FIntRect Bounds = Landscape->GetBoundingRect();
-        LandscapeObj->SetNumberField(TEXT("sizeX"), Bounds.Width());
-        LandscapeObj->SetNumberField(TEXT("sizeY"), Bounds.Height());
+        SessionId = FGuid::NewGuid().ToString(EGuidFormats::Digits);
+        Session = &CaptureSessions.Add(SessionId);
 
-        if (bIncludeHeightmap)
+        // Only weak pointers are held for the lifetime of the session; the filter is applied once here
+        const FAegisActorQuery Query = MakeCaptureQuery(ClassFilter, TagFilter);
+        for (TActorIterator<AActor> It(World); World && It; ++It)
         {
-            // In production, we would export heightmap data
-            // For now, just include a hash
-            LandscapeObj->SetStringField(TEXT("heightmapHash"), ComputeSHA256(Landscape->GetName()));
+            if (Query.Matches(*It))
+            {
+                Session->Actors.Add(*It);
+            }
         }
-
-        if (bIncludeLayers)
+    }
+    else
+    {
+        FString OffsetString;
+        if (Cursor.Split(TEXT(":"), &SessionId, &OffsetString))
         {
-            // Get layer info
-            TArray<TSharedPtr<FJsonValue>> LayerArray;
-            // Would iterate through landscape layers here
-            LandscapeObj->SetArrayField(TEXT("layers"), LayerArray);
+            Session = CaptureSessions.Find(SessionId);
+            LexFromString(Offset, *OffsetString);
         }
-
-        LandscapeArray.Add(MakeShareable(new FJsonValueObject(LandscapeObj)));
     }
 
-    Result->SetArrayField(TEXT("landscapes"), LandscapeArray);
-
-    FString ResultString;
-    TSharedRef<TJsonWriter<>> Writer = TJsonWriterFactory<>::Create(&ResultString);
-    FJsonSerializer::Serialize(Result.ToSharedRef(), Writer);
-
-    return ResultString;
-}
+    Writer.WriteObjectStart();
 
-FString UAegisSeedSubsystem::CaptureFoliage(bool bIncludeInstances)
-{
-    UWorld* World = GEditor ? GEditor->GetEditorWorldContext().World() : nullptr;
-    if (!World)
+    if (!Session || Offset < 0 || Offset > Session->Actors.Num())
     {
-        return TEXT("{}");
+        Writer.WriteValue(TEXT("error"), TEXT("Invalid or expired capture cursor"));
+        Writer.WriteArrayStart(TEXT("actors"));
+        Writer.WriteArrayEnd();
+        Writer.WriteValue(TEXT("nextCursor"), FString());
+        Writer.WriteValue(TEXT("done"), true);
+        Writer.WriteObjectEnd();
+        return;
     }
 
-    TSharedPtr<FJsonObject> Result = MakeShareable(new FJsonObject());
-    TArray<TSharedPtr<FJsonValue>> FoliageArray;
-
-    for (TActorIterator<AInstancedFoliageActor> It(World); It; ++It)
-    {
-        AInstancedFoliageActor* Foliage = *It;
-
-        TSharedPtr<FJsonObject> FoliageObj = MakeShareable(new FJsonObject());
-        FoliageObj->SetStringField(TEXT("name"), Foliage->GetName());
-        FoliageObj->SetStringField(TEXT("path"), Foliage->GetPathName());
-
-        // Count instances (simplified)
-        int32 InstanceCount = 0;
-        // Would iterate through foliage instances here
-        FoliageObj->SetNumberField(TEXT("instanceCount"), InstanceCount);
+    Session->LastAccessTime = FPlatformTime::Seconds();
 
-        if (bIncludeInstances)
-        {
-            // In production, would include instance data hash
-            FoliageObj->SetStringField(TEXT("instanceDataHash"), ComputeSHA256(Foliage->GetName()));
-        }
+    const int32 Total = Session->Actors.Num();
+    const int32 End = FMath::Min(Offset + PageSize, Total);
 
-        FoliageArray.Add(MakeShareable(new FJsonValueObject(FoliageObj)));
+    TArray<AActor*> PageActors;
+    PageActors.Reserve(End - Offset);
+    for (int32 Index = Offset; Index < End; ++Index)
+    {
+        PageActors.Add(Session->Actors[Index].Get());
     }
 
-    Result->SetArrayField(TEXT("foliageActors"), FoliageArray);
+    // Stale entries are dropped by the gather
+    FAegisActorCapture Capture;
+    Capture.Gather(PageActors);
 
-    FString ResultString;
-    TSharedRef<TJsonWriter<>> Writer = TJsonWriterFactory<>::Create(&ResultString);
-    FJsonSerializer::Serialize(Result.ToSharedRef(), Writer);
+    TArray<int32> Indices;
+    Capture.GetAllIndices(Indices);
+    AegisJson::WriteRawJson(Writer, TEXT("actors"), Capture.EncodeArray(Indices, GUIDRegistry));
 
-    return ResultString;
-}
+    const bool bDone = End >= Total;
 
-bool UAegisSeedSubsystem::StoreSnapshot(const FString& SnapshotId, const FString& SnapshotData)
-{
-    SnapshotStorage.Add(SnapshotId, SnapshotData);
-    UE_LOG(LogAegisBridge, Log, TEXT("Stored snapshot: %s"), *SnapshotId);
-    return true;
-}
+    Writer.WriteValue(TEXT("offset"), Offset);
+    Writer.WriteValue(TEXT("total"), Total);
+    Writer.WriteValue(TEXT("nextCursor"), bDone ? FString() : FString::Printf(TEXT("%s:%d"), *SessionId, End));
+    Writer.WriteValue(TEXT("done"), bDone);
+    Writer.WriteObjectEnd();
 
-FString UAegisSeedSubsystem::LoadSnapshot(const FString& SnapshotId)
-{
-    if (const FString* Data = SnapshotStorage.Find(SnapshotId))
+    if (bDone)
     {
-        return *Data;
+        CaptureSessions.Remove(SessionId);
     }
-    return TEXT("");
 }
 
-TArray<FAegisWorldSnapshot> UAegisSeedSubsystem::ListSnapshots()
+int32 UAegisSeedSubsystem::ExportActorsNDJSON(const FString& FilePath, const TArray<FString>& ClassFilter, const TArray<FString>& TagFilter)
 {
-    TArray<FAegisWorldSnapshot> Result;
+    AEGIS_COMMAND_SCOPE(AegisSeedSubsystem, ExportActorsNDJSON);
+    // Lines are buffered and flushed to disk once a chunk fills up
+    static constexpr int32 ChunkSize = 256 * 1024;
 
-    for (const auto& Pair : SnapshotStorage)
+    TUniquePtr<FArchive> FileWriter(IFileManager::Get().CreateFileWriter(*FilePath));
+    if (!FileWriter)
     {
-        FAegisWorldSnapshot Snapshot;
-        Snapshot.SnapshotId = Pair.Key;
+        UE_LOG(LogAegisBridge, Error, TEXT("Cannot open %s for actor export"), *FilePath);
+        return INDEX_NONE;
+    }
 
-        // Parse snapshot data for metadata
-        TSharedPtr<FJsonObject> JsonObj;
-        TSharedRef<TJsonReader<>> Reader = TJsonReaderFactory<>::Create(Pair.Value);
-        if (FJsonSerializer::Deserialize(Reader, JsonObj) && JsonObj.IsValid())
-        {
-            Snapshot.Name = JsonObj->GetStringField(TEXT("name"));
-            Snapshot.Description = JsonObj->GetStringField(TEXT("description"));
-            Snapshot.Checksum = JsonObj->GetStringField(TEXT("checksum"));
+    UWorld* World = GEditor ? GEditor->GetEditorWorldContext().World() : nullptr;
 
-            const TArray<TSharedPtr<FJsonValue>>* Entities;
-            if (JsonObj->TryGetArrayField(TEXT("entities"), Entities))
-            {
-                Snapshot.EntityCount = Entities->Num();
-            }
+    TArray<ANSICHAR> Chunk;
+    Chunk.Reserve(ChunkSize + 4096);
+
+    int32 ActorCount = 0;
+    int64 BytesWritten = 0;
+
+    auto FlushChunk = [&FileWriter, &Chunk, &BytesWritten]()
+    {
+        if (Chunk.Num() > 0)
+        {
+            FileWriter->Serialize(Chunk.GetData(), Chunk.Num());
+            BytesWritten += Chunk.Num();
+            Chunk.Reset();
         }
+    };
 
-        Result.Add(Snapshot);
-    }
+    FAegisActorCapture Capture;
+    Capture.Gather(World);
 
-    return Result;
-}
+    TArray<int32> Indices;
+    Capture.Filter(MakeCaptureQuery(ClassFilter, TagFilter), Indices);
 
-bool UAegisSeedSubsystem::DeleteSnapshot(const FString& SnapshotId)
-{
-    if (SnapshotStorage.Remove(SnapshotId) > 0)
+    // Each encoded batch is a run of complete lines
+    TArray<FString> Batches;
+    Capture.Encode(Indices, GUIDRegistry, TEXT("\n"), Batches);
+
+    for (const FString& Batch : Batches)
     {
-        UE_LOG(LogAegisBridge, Log, TEXT("Deleted snapshot: %s"), *SnapshotId);
-        return true;
+        const FTCHARToUTF8 Utf8(*Batch);
+        Chunk.Append(Utf8.Get(), Utf8.Length());
+        Chunk.Add('\n');
+
+        if (Chunk.Num() >= ChunkSize)
+        {
+            FlushChunk();
+        }
     }
-    return false;
+    ActorCount = Indices.Num();
+
+    FlushChunk();
+    FileWriter->Close();
+
+    UE_LOG(LogAegisBridge, Log, TEXT("Exported %d actors (%lld bytes) to %s"), ActorCount, BytesWritten, *FilePath);
+
+    return ActorCount;
 }
 
-bool UAegisSeedSubsystem::ExportSnapshot(const FString& SnapshotId, const FString& SnapshotData, const FString& OutputPath, bool bCompress)
+FAegisActorQuery UAegisSeedSubsystem::MakeCaptureQuery(const TArray<FString>& ClassFilter, const TArray<FString>& TagFilter)
 {
-    FString DataToWrite = SnapshotData;
+    // Class filter: any match; tag filter: all tags required
+    FAegisActorQueryParams QueryParams;
+    QueryParams.ClassFilter = ClassFilter;
+    QueryParams.TagFilter = TagFilter;
+    return FAegisActorQuery(QueryParams);
+}
 
-    // Would apply compression here if bCompress
+void UAegisSeedSubsystem::ExpireCaptureSessions()
+{
+    static constexpr double SessionTimeoutSeconds = 300.0;
 
-    if (FFileHelper::SaveStringToFile(DataToWrite, *OutputPath))
+    const double Now = FPlatformTime::Seconds();
+    for (auto It = CaptureSessions.CreateIterator(); It; ++It)
     {
-        UE_LOG(LogAegisBridge, Log, TEXT("Exported snapshot to: %s"), *OutputPath);
-        return true;
+        if (Now - It.Value().LastAccessTime > SessionTimeoutSeconds)
+        {
+            It.RemoveCurrent();
+        }
     }
-
-    UE_LOG(LogAegisBridge, Error, TEXT("Failed to export snapshot to: %s"), *OutputPath);
-    return false;
 }
 
-FString UAegisSeedSubsystem::ImportSnapshot(const FString& InputPath)
+FString UAegisSeedSubsystem::CaptureLandscape(bool bIncludeHeightmap, bool bIncludeLayers)
 {
-    FString SnapshotData;
-    if (FFileHelper::LoadFileToString(SnapshotData, *InputPath))
-    {
-        UE_LOG(LogAegisBridge, Log, TEXT("Imported snapshot from: %s"), *InputPath);
-        return SnapshotData;
-    }
+    AEGIS_COMMAND_SCOPE(AegisSeedSubsystem, CaptureLandscape);
 
-    UE_LOG(LogAegisBridge, Error, TEXT("Failed to import snapshot from: %s"), *InputPath);
-    return TEXT("");
-}
+    FAegisLandscapeCaptureOptions Options;
+    Options.bIncludeHeightmap = bIncludeHeightmap;
+    Options.bIncludeLayers = bIncludeLayers;
 
-// ============================================================================
-// State Restoration Operations
-// ============================================================================
+    FString ResultString;
+    TSharedRef<FAegisJsonWriter> Writer = FAegisJsonWriterFactory::Create(&ResultString);
+    WriteLandscapes(*Writer, Options);
+    Writer->Close();
+    return ResultString;
+}
 
-bool UAegisSeedSubsystem::RestoreWorldState(const FString& SnapshotId, const FString& Entities, const FString& MergeMode, bool bPreserveGUIDs)
+void UAegisSeedSubsystem::WriteLandscapes(FAegisJsonWriter& Writer, const FAegisLandscapeCaptureOptions& Options)
 {
+    Writer.WriteObjectStart();
+
     UWorld* World = GEditor ? GEditor->GetEditorWorldContext().World() : nullptr;
     if (!World)
     {
-        return false;
+        Writer.WriteObjectEnd();
+        return;
     }
 
-    // Parse entities
-    TSharedPtr<FJsonValue> JsonValue;
-    TSharedRef<TJsonReader<>> Reader = TJsonReaderFactory<>::Create(Entities);
-    if (!FJsonSerializer::Deserialize(Reader, JsonValue))
-    {
-        UE_LOG(LogAegisBridge, Error, TEXT("Failed to parse entities JSON"));
-        return false;
-    }
+    FAegisLandscapeTileBlob TileBlob;
 
-    const TArray<TSharedPtr<FJsonValue>>* EntityArray;
-    if (!JsonValue->TryGetArray(EntityArray))
+    Writer.WriteArrayStart(TEXT("landscapes"));
+    for (TActorIterator<ALandscapeProxy> It(World); It; ++It)
     {
-        UE_LOG(LogAegisBridge, Error, TEXT("Entities is not an array"));
-        return false;
+        WriteLandscape(Writer, *It, Options, TileBlob);
     }
+    Writer.WriteArrayEnd();
 
-    // Begin transaction
-    GEditor->BeginTransaction(FText::FromString(TEXT("AEGIS Restore World State")));
-
-    if (MergeMode == TEXT("replace"))
+    if (!Options.TileDataPath.IsEmpty())
     {
-        // Clear existing actors (simplified - would be more selective in production)
-        // This is a placeholder for the actual implementation
+        WriteLandscapeTileData(Writer, Options, TileBlob, SaveLandscapeTileBlob(Options, TileBlob));
     }
 
-    int32 RestoredCount = 0;
+    Writer.WriteObjectEnd();
+}
 
-    for (const TSharedPtr<FJsonValue>& EntityValue : *EntityArray)
+void UAegisSeedSubsystem::WriteLandscape(FAegisJsonWriter& Writer, ALandscapeProxy* Landscape, const FAegisLandscapeCaptureOptions& Options, FAegisLandscapeTileBlob& TileBlob)
+{
+    const bool bWriteTileData = !Options.TileDataPath.IsEmpty();
+    const bool bCaptureTiles = Options.bIncludeHeightmap || Options.bIncludeLayers || bWriteTileData;
+
+    Writer.WriteObjectStart();
+    Writer.WriteValue(TEXT("name"), Landscape->GetName());
+    Writer.WriteValue(TEXT("path"), Landscape->GetPathName());
+
+    const FVector Location = Landscape->GetActorLocation();
+    const FRotator Rotation = Landscape->GetActorRotation();
+    Writer.WriteObjectStart(TEXT("transform"));
+    Writer.WriteObjectStart(TEXT("location"));
+    Writer.WriteValue(TEXT("x"), Location.X);
+    Writer.WriteValue(TEXT("y"), Location.Y);
+    Writer.WriteValue(TEXT("z"), Location.Z);
+    Writer.WriteObjectEnd();
+    Writer.WriteObjectStart(TEXT("rotation"));
+    Writer.WriteValue(TEXT("pitch"), Rotation.Pitch);
+    Writer.WriteValue(TEXT("yaw"), Rotation.Yaw);
+    Writer.WriteValue(TEXT("roll"), Rotation.Roll);
+    Writer.WriteObjectEnd();
+    Writer.WriteObjectEnd();
+
+    const FIntRect Bounds = Landscape->GetBoundingRect();
+    Writer.WriteValue(TEXT("sizeX"), Bounds.Width());
+    Writer.WriteValue(TEXT("sizeY"), Bounds.Height());
+
+    FAegisLandscapeCapture Capture;
+    if (bCaptureTiles && Capture.Capture(Landscape, Options.bIncludeLayers, bWriteTileData))
     {
-        const TSharedPtr<FJsonObject>* EntityObj;
-        if (!EntityValue->TryGetObject(EntityObj))
+        Writer.WriteValue(TEXT("componentSizeQuads"), Capture.GetComponentSizeQuads());
+
+        if (Options.bIncludeHeightmap)
         {
-            continue;
+            Writer.WriteValue(TEXT("heightmapHash"), FAegisLandscapeCapture::HashToString(Capture.GetHeightHash()));
         }
 
-        FString ClassName = (*EntityObj)->GetStringField(TEXT("class"));
-        FString EntityName = (*EntityObj)->GetStringField(TEXT("name"));
-        FString EntityGUID = (*EntityObj)->GetStringField(TEXT("guid"));
+        if (Options.bIncludeLayers)
+        {
+            Writer.WriteArrayStart(TEXT("layers"));
+            for (const FAegisLandscapeCapture::FLayer& Layer : Capture.GetLayers())
+            {
+                Writer.WriteObjectStart();
+                Writer.WriteValue(TEXT("name"), Layer.Name.ToString());
+                Writer.WriteValue(TEXT("layerInfo"), Layer.LayerInfoPath);
+                Writer.WriteValue(TEXT("hash"), FAegisLandscapeCapture::HashToString(Layer.Hash));
+                Writer.WriteObjectEnd();
+            }
+            Writer.WriteArrayEnd();
+        }
 
-        // Get transform
-        FVector Location = FVector::ZeroVector;
-        FRotator Rotation = FRotator::ZeroRotator;
-        FVector Scale = FVector::OneVector;
+        TArray<int32> ChangedTiles;
+        const TArray<FAegisLandscapeTile>& Tiles = Capture.GetTiles();
 
-        const TSharedPtr<FJsonObject>* TransformObj;
-        if ((*EntityObj)->TryGetObjectField(TEXT("transform"), TransformObj))
+        Writer.WriteArrayStart(TEXT("tiles"));
+        for (int32 TileIndex = 0; TileIndex < Tiles.Num(); ++TileIndex)
         {
-            const TSharedPtr<FJsonObject>* LocObj;
-            if ((*TransformObj)->TryGetObjectField(TEXT("location"), LocObj))
+            const FAegisLandscapeTile& Tile = Tiles[TileIndex];
+            const FString Key = Capture.GetTileKey(Tile);
+            const FString Hash = FAegisLandscapeCapture::HashToString(Tile.Hash);
+
+            const FString* KnownHash = Options.KnownTiles.Find(Key);
+            const bool bChanged = !KnownHash || *KnownHash != Hash;
+            if (bChanged)
             {
-                Location.X = (*LocObj)->GetNumberField(TEXT("x"));
-                Location.Y = (*LocObj)->GetNumberField(TEXT("y"));
-                Location.Z = (*LocObj)->GetNumberField(TEXT("z"));
+                ChangedTiles.Add(TileIndex);
             }
 
-            const TSharedPtr<FJsonObject>* RotObj;
-            if ((*TransformObj)->TryGetObjectField(TEXT("rotation"), RotObj))
+            Writer.WriteObjectStart();
+            Writer.WriteValue(TEXT("key"), Key);
+            Writer.WriteValue(TEXT("x"), Tile.Origin.X);
+            Writer.WriteValue(TEXT("y"), Tile.Origin.Y);
+            Writer.WriteValue(TEXT("size"), Tile.Size);
+            Writer.WriteValue(TEXT("hash"), Hash);
+            Writer.WriteValue(TEXT("changed"), bChanged);
+            if (Options.bIncludeHeightmap)
             {
-                Rotation.Pitch = (*RotObj)->GetNumberField(TEXT("pitch"));
-                Rotation.Yaw = (*RotObj)->GetNumberField(TEXT("yaw"));
-                Rotation.Roll = (*RotObj)->GetNumberField(TEXT("roll"));
+                Writer.WriteValue(TEXT("heightHash"), FAegisLandscapeCapture::HashToString(Tile.HeightHash));
             }
-
-            const TSharedPtr<FJsonObject>* ScaleObj;
-            if ((*TransformObj)->TryGetObjectField(TEXT("scale"), ScaleObj))
+            if (Options.bIncludeLayers)
             {
-                Scale.X = (*ScaleObj)->GetNumberField(TEXT("x"));
-                Scale.Y = (*ScaleObj)->GetNumberField(TEXT("y"));
-                Scale.Z = (*ScaleObj)->GetNumberField(TEXT("z"));
+                Writer.WriteArrayStart(TEXT("layerHashes"));
+                for (uint64 LayerHash : Tile.LayerHashes)
+                {
+                    Writer.WriteValue(FAegisLandscapeCapture::HashToString(LayerHash));
+                }
+                Writer.WriteArrayEnd();
             }
+            Writer.WriteObjectEnd();
         }
+        Writer.WriteArrayEnd();
+        Writer.WriteValue(TEXT("changedTiles"), ChangedTiles.Num());
 
-        // Find or spawn actor
-        // This is simplified - production would handle all entity types
-        UClass* ActorClass = FindObject<UClass>(nullptr, *ClassName);
-        if (!ActorClass)
+        if (bWriteTileData && ChangedTiles.Num() > 0)
         {
-            ActorClass = LoadClass<AActor>(nullptr, *ClassName);
+            // Sections are appended; the blob header goes in front once the count is known
+            FMemoryWriter TileWriter(TileBlob.Sections, false, true);
+            Capture.SerializeTiles(TileWriter, ChangedTiles);
+            ++TileBlob.SectionCount;
+            TileBlob.TileCount += ChangedTiles.Num();
         }
+    }
 
-        if (ActorClass)
-        {
-            FActorSpawnParameters SpawnParams;
-            SpawnParams.Name = *EntityName;
-
-            AActor* Actor = World->SpawnActor<AActor>(ActorClass, Location, Rotation, SpawnParams);
-            if (Actor)
-            {
-                Actor->SetActorScale3D(Scale);
+    Writer.WriteObjectEnd();
+}
 
-                if (bPreserveGUIDs && !EntityGUID.IsEmpty())
-                {
-                    RegisterGUID(EntityGUID, Actor->GetPathName(), ClassName, TEXT("{}"));
-                }
+bool UAegisSeedSubsystem::SaveLandscapeTileBlob(const FAegisLandscapeCaptureOptions& Options, const FAegisLandscapeTileBlob& TileBlob)
+{
+    TArray<uint8> Payload;
+    Payload.Reserve(TileBlob.Sections.Num() + 16);
+    FMemoryWriter PayloadWriter(Payload);
 
-                RestoredCount++;
-            }
-        }
-    }
+    uint32 Magic = FAegisLandscapeCapture::TileDataMagic;
+    int32 Version = FAegisLandscapeCapture::TileDataVersion;
+    int32 SectionCount = TileBlob.SectionCount;
+    PayloadWriter << Magic << Version << SectionCount;
+    PayloadWriter.Serialize(const_cast<uint8*>(TileBlob.Sections.GetData()), TileBlob.Sections.Num());
 
-    GEditor->EndTransaction();
+    return SaveDataBlob(Options.TileDataPath, Options.Codec, Payload);
+}
 
-    UE_LOG(LogAegisBridge, Log, TEXT("Restored %d entities from snapshot %s"), RestoredCount, *SnapshotId);
-    return true;
+void UAegisSeedSubsystem::WriteLandscapeTileData(FAegisJsonWriter& Writer, const FAegisLandscapeCaptureOptions& Options, const FAegisLandscapeTileBlob& TileBlob, bool bSaved)
+{
+    Writer.WriteObjectStart(TEXT("tileData"));
+    if (bSaved)
+    {
+        Writer.WriteValue(TEXT("path"), Options.TileDataPath);
+        Writer.WriteValue(TEXT("fileSize"), IFileManager::Get().FileSize(*Options.TileDataPath));
+        Writer.WriteValue(TEXT("tileCount"), TileBlob.TileCount);
+    }
+    else
+    {
+        Writer.WriteValue(TEXT("error"), TEXT("Failed to write tile data"));
+    }
+    Writer.WriteObjectEnd();
 }
 
-FString UAegisSeedSubsystem::SyncWorldState(const FString& TargetSnapshotId, const FString& TargetEntities, bool bCaptureCurrentFirst, const FString& ConflictResolution, bool bDryRun)
+bool UAegisSeedSubsystem::SaveDataBlob(const FString& FilePath, const FString& Codec, TArray<uint8>& Payload)
 {
-    // Simplified implementation - would compute diff and apply changes
-    TSharedPtr<FJsonObject> Result = MakeShareable(new FJsonObject());
-    Result->SetBoolField(TEXT("success"), true);
-    Result->SetNumberField(TEXT("plannedChanges"), 0);
+    FAegisSnapshotCompression::ECompressor Compressor;
+    if (!FAegisSnapshotCompression::ParseCompressor(Codec, Compressor))
+    {
+        UE_LOG(LogAegisBridge, Error, TEXT("Unknown compression codec: %s"), *Codec);
+        return false;
+    }
 
-    FString ResultString;
-    TSharedRef<TJsonWriter<>> Writer = TJsonWriterFactory<>::Create(&ResultString);
-    FJsonSerializer::Serialize(Result.ToSharedRef(), Writer);
+    if (Compressor != FAegisSnapshotCompression::ECompressor::NotSet)
+    {
+        // Small or flat data may not compress; readers detect the container by its magic
+        TArray<uint8> Container;
+        if (FAegisSnapshotCompression::Compress(Payload, Container, Compressor, FAegisSnapshotCompression::ECompressionLevel::Normal))
+        {
+            Payload = MoveTemp(Container);
+        }
+    }
 
-    return ResultString;
+    if (!FFileHelper::SaveArrayToFile(Payload, *FilePath))
+    {
+        UE_LOG(LogAegisBridge, Error, TEXT("Failed to write data blob to: %s"), *FilePath);
+        return false;
+    }
+    return true;
 }
 
-FString UAegisSeedSubsystem::MergeWorldStates(const FString& SourceSnapshotId, const FString& TargetSnapshotId, const FString& Changes, const FString& ConflictResolution, bool bPreserveSourceGUIDs)
+bool UAegisSeedSubsystem::LoadDataBlob(const FString& FilePath, TArray<uint8>& OutPayload)
 {
-    // Simplified implementation
-    TSharedPtr<FJsonObject> Result = MakeShareable(new FJsonObject());
-    Result->SetBoolField(TEXT("success"), true);
-    Result->SetNumberField(TEXT("appliedChanges"), 0);
-
-    FString ResultString;
-    TSharedRef<TJsonWriter<>> Writer = TJsonWriterFactory<>::Create(&ResultString);
-    FJsonSerializer::Serialize(Result.ToSharedRef(), Writer);
+    if (!FFileHelper::LoadFileToArray(OutPayload, *FilePath))
+    {
+        UE_LOG(LogAegisBridge, Error, TEXT("Failed to read data blob from: %s"), *FilePath);
+        return false;
+    }
 
-    return ResultString;
+    if (FAegisSnapshotCompression::IsCompressed(OutPayload))
+    {
+        TArray<uint8> Payload;
+        if (!FAegisSnapshotCompression::Decompress(OutPayload, Payload))
+        {
+            UE_LOG(LogAegisBridge, Error, TEXT("Corrupt compressed data blob: %s"), *FilePath);
+            return false;
+        }
+        OutPayload = MoveTemp(Payload);
+    }
+    return true;
 }
 
-FString UAegisSeedSubsystem::ApplyDiff(const FString& DiffId, const FString& Changes, const FString& ConflictResolution)
+FString UAegisSeedSubsystem::CaptureFoliage(bool bIncludeInstances)
 {
-    // Simplified implementation
-    TSharedPtr<FJsonObject> Result = MakeShareable(new FJsonObject());
-    Result->SetBoolField(TEXT("success"), true);
-    Result->SetNumberField(TEXT("appliedChanges"), 0);
+    AEGIS_COMMAND_SCOPE(AegisSeedSubsystem, CaptureFoliage);
 
-    FString ResultString;
-    TSharedRef<TJsonWriter<>> Writer = TJsonWriterFactory<>::Create(&ResultString);
-    FJsonSerializer::Serialize(Result.ToSharedRef(), Writer);
+    FAegisFoliageCaptureOptions Options;
+    Options.bIncludeInstances = bIncludeInstances;
 
+    FString ResultString;
+    TSharedRef<FAegisJsonWriter> Writer = FAegisJsonWriterFactory::Create(&ResultString);
+    WriteFoliage(*Writer, Options);
+    Writer->Close();
     return ResultString;
 }
 
-FString UAegisSeedSubsystem::GetCurrentLevelInfo()
+void UAegisSeedSubsystem::WriteFoliage(FAegisJsonWriter& Writer, const FAegisFoliageCaptureOptions& Options)
 {
+    Writer.WriteObjectStart();
+
+    UWorld* World = GEditor ? GEditor->GetEditorWorldContext().World() : nullptr;
+    if (!World)
+    {
+        Writer.WriteObjectEnd();
+        return;
+    }
+
+    // Per-actor summary; instance data is captured world-wide below
+    Writer.WriteArrayStart(TEXT("foliageActors"));
+    for (TActorIterator<AInstancedFoliageActor> It(World); It; ++It)
+    {
+        AInstancedFoliageActor* Foliage = *It;
+
+        Writer.WriteObjectStart();
+        Writer.WriteValue(TEXT("name"), Foliage->GetName());
+        Writer.WriteValue(TEXT("path"), Foliage->GetPathName());
+
+        int32 InstanceCount = 0;
+        Writer.WriteArrayStart(TEXT("types"));
+        Foliage->ForEachFoliageInfo([&Writer, &InstanceCount](UFoliageType* FoliageType, FFoliageInfo& Info)
+        {
+            if (FoliageType)
+            {
+                Writer.WriteObjectStart();
+                Writer.WriteValue(TEXT("foliageType"), FoliageType->GetPathName());
+                Writer.WriteValue(TEXT("instanceCount"), Info.Instances.Num());
+                Writer.WriteObjectEnd();
+                InstanceCount += Info.Instances.Num();
+            }
+            return true;
+        });
+        Writer.WriteArrayEnd();
+        Writer.WriteValue(TEXT("instanceCount"), InstanceCount);
+
+        Writer.WriteObjectEnd();
+    }
+    Writer.WriteArrayEnd();
+
+    const bool bWriteInstanceData = !Options.InstanceDataPath.IsEmpty();
+    if (Options.bIncludeInstances || bWriteInstanceData)
+    {
+        FAegisFoliageCapture Capture(Options.CellSize);
+        Capture.Capture(World, bWriteInstanceData);
+
+        Writer.WriteValue(TEXT("instanceCount"), Capture.GetInstanceCount());
+        Writer.WriteValue(TEXT("instanceDataHash"), FAegisFoliageCapture::HashToString(Capture.GetHash()));
+        Writer.WriteValue(TEXT("cellSize"), Capture.GetCellSize());
+
+        TArray<TPair<int32, int32>> ChangedCells;
+        TSet<FString> CapturedKeys;
+
+        const TArray<FAegisFoliageTypeCapture>& Types = Capture.GetTypes();
+        Writer.WriteArrayStart(TEXT("foliageTypes"));
+        for (int32 TypeIndex = 0; TypeIndex < Types.Num(); ++TypeIndex)
+        {
+            const FAegisFoliageTypeCapture& Type = Types[TypeIndex];
+
+            Writer.WriteObjectStart();
+            Writer.WriteValue(TEXT("foliageType"), Type.FoliageTypePath);
+            Writer.WriteValue(TEXT("instanceCount"), Type.InstanceCount);
+            Writer.WriteValue(TEXT("hash"), FAegisFoliageCapture::HashToString(Type.Hash));
+
+            Writer.WriteArrayStart(TEXT("cells"));
+            for (int32 CellIndex = 0; CellIndex < Type.Cells.Num(); ++CellIndex)
+            {
+                const FAegisFoliageCell& Cell = Type.Cells[CellIndex];
+                FString Key = FAegisFoliageCapture::GetCellKey(Type, Cell);
+                const FString Hash = FAegisFoliageCapture::HashToString(Cell.Hash);
+
+                const FString* KnownHash = Options.KnownCells.Find(Key);
+                const bool bChanged = !KnownHash || *KnownHash != Hash;
+                if (bChanged)
+                {
+                    ChangedCells.Emplace(TypeIndex, CellIndex);
+                }
+
+                Writer.WriteObjectStart();
+                Writer.WriteValue(TEXT("key"), Key);
+                Writer.WriteValue(TEXT("x"), Cell.Coord.X);
+                Writer.WriteValue(TEXT("y"), Cell.Coord.Y);
+                Writer.WriteValue(TEXT("count"), Cell.Count);
+                Writer.WriteValue(TEXT("hash"), Hash);
+                Writer.WriteValue(TEXT("changed"), bChanged);
+                Writer.WriteObjectEnd();
+
+                CapturedKeys.Add(MoveTemp(Key));
+            }
+            Writer.WriteArrayEnd();
+
+            Writer.WriteObjectEnd();
+        }
+        Writer.WriteArrayEnd();
+        Writer.WriteValue(TEXT("changedCells"), ChangedCells.Num());
+
+        // Known cells with no instances left must be cleared on the other side
+        TMap<FString, TArray<FIntPoint>> ClearedCells;
+        int32 ClearedCount = 0;
+        Writer.WriteArrayStart(TEXT("removedCells"));
+        for (const TPair<FString, FString>& Known : Options.KnownCells)
+        {
+            FString TypePath;
+            FIntPoint Coord;
+            if (!CapturedKeys.Contains(Known.Key) && FAegisFoliageCapture::ParseCellKey(Known.Key, TypePath, Coord))
+            {
+                Writer.WriteValue(Known.Key);
+                ClearedCells.FindOrAdd(MoveTemp(TypePath)).Add(Coord);
+                ++ClearedCount;
+            }
+        }
+        Writer.WriteArrayEnd();
+
+        if (bWriteInstanceData)
+        {
+            TArray<uint8> Payload;
+            FMemoryWriter PayloadWriter(Payload);
+            Capture.Serialize(PayloadWriter, ChangedCells, ClearedCells);
+
+            Writer.WriteObjectStart(TEXT("instanceData"));
+            if (SaveDataBlob(Options.InstanceDataPath, Options.Codec, Payload))
+            {
+                Writer.WriteValue(TEXT("path"), Options.InstanceDataPath);
+                Writer.WriteValue(TEXT("fileSize"), IFileManager::Get().FileSize(*Options.InstanceDataPath));
+                Writer.WriteValue(TEXT("cellCount"), ChangedCells.Num() + ClearedCount);
+            }
+            else
+            {
+                Writer.WriteValue(TEXT("error"), TEXT("Failed to write instance data"));
+            }
+            Writer.WriteObjectEnd();
+        }
+    }
+
+    Writer.WriteObjectEnd();
+}
+
+bool UAegisSeedSubsystem::RestoreFoliage(const FString& InputPath, int32 BatchSize, FAegisFoliageRestoreResult& OutResult, FString& OutError)
+{
+    UWorld* World = GEditor ? GEditor->GetEditorWorldContext().World() : nullptr;
+    if (!World)
+    {
+        OutError = TEXT("No editor world");
+        return false;
+    }
+
+    TArray<uint8> Data;
+    if (!LoadDataBlob(InputPath, Data))
+    {
+        OutError = FString::Printf(TEXT("Cannot read foliage instance data: %s"), *InputPath);
+        return false;
+    }
+
+    GEditor->BeginTransaction(FText::FromString(TEXT("AEGIS Restore Foliage")));
+    const bool bRestored = FAegisFoliageCapture::Restore(World, Data, BatchSize, OutResult, OutError);
+    GEditor->EndTransaction();
+
+    if (!bRestored)
+    {
+        UE_LOG(LogAegisBridge, Error, TEXT("Foliage restore from %s failed: %s"), *InputPath, *OutError);
+    }
+    return bRestored;
+}
+
+bool UAegisSeedSubsystem::StoreSnapshot(const FString& SnapshotId, const FString& SnapshotData)
+{
+    AEGIS_COMMAND_SCOPE(AegisSeedSubsystem, StoreSnapshot);
+
+    if (!SnapshotStore.Store(SnapshotId, SnapshotData, ReadSnapshotRecord(SnapshotData)))
+    {
+        UE_LOG(LogAegisBridge, Error, TEXT("Failed to store snapshot: %s"), *SnapshotId);
+        return false;
+    }
+
+    UE_LOG(LogAegisBridge, Log, TEXT("Stored snapshot: %s"), *SnapshotId);
+    return true;
+}
+
+FString UAegisSeedSubsystem::LoadSnapshot(const FString& SnapshotId)
+{
+    AEGIS_COMMAND_SCOPE(AegisSeedSubsystem, LoadSnapshot);
+
+    FString Data;
+    SnapshotStore.Load(SnapshotId, Data);
+    return Data;
+}
+
+TArray<FAegisWorldSnapshot> UAegisSeedSubsystem::ListSnapshots()
+{
+    AEGIS_COMMAND_SCOPE(AegisSeedSubsystem, ListSnapshots);
+
+    TArray<FAegisSnapshotRecord> Records;
+    SnapshotStore.List(Records);
+
+    // Index metadata only; payloads stay on disk
+    TArray<FAegisWorldSnapshot> Result;
+    Result.Reserve(Records.Num());
+    for (const FAegisSnapshotRecord& Record : Records)
+    {
+        FAegisWorldSnapshot& Snapshot = Result.AddDefaulted_GetRef();
+        Snapshot.SnapshotId = Record.SnapshotId;
+        Snapshot.Name = Record.Name;
+        Snapshot.Description = Record.Description;
+        Snapshot.Timestamp = Record.Timestamp;
+        Snapshot.Checksum = Record.Checksum;
+        Snapshot.EntityCount = Record.EntityCount;
+    }
+
+    return Result;
+}
+
+bool UAegisSeedSubsystem::DeleteSnapshot(const FString& SnapshotId)
+{
+    AEGIS_COMMAND_SCOPE(AegisSeedSubsystem, DeleteSnapshot);
+
+    if (SnapshotStore.Remove(SnapshotId))
+    {
+        RemoveStoredDeltas(SnapshotId);
+        DeltaChains.Remove(SnapshotId);
+        UE_LOG(LogAegisBridge, Log, TEXT("Deleted snapshot: %s"), *SnapshotId);
+        return true;
+    }
+    return false;
+}
+
+bool UAegisSeedSubsystem::ExportSnapshot(const FString& SnapshotId, const FString& SnapshotData, const FString& OutputPath, bool bCompress)
+{
+    AEGIS_COMMAND_SCOPE(AegisSeedSubsystem, ExportSnapshot);
+
+    return ExportSnapshotWithOptions(SnapshotId, SnapshotData, OutputPath,
+        OutputPath.EndsWith(FAegisBinarySnapshot::FileExtension),
+        bCompress ? TEXT("kraken") : TEXT("none"),
+        static_cast<int32>(FOodleDataCompression::ECompressionLevel::Normal));
+}
+
+bool UAegisSeedSubsystem::ExportSnapshotWithOptions(const FString& SnapshotId, const FString& SnapshotData, const FString& OutputPath, bool bBinary, const FString& Codec, int32 CompressionLevel)
+{
+    AEGIS_COMMAND_SCOPE(AegisSeedSubsystem, ExportSnapshotWithOptions);
+
+    FAegisSnapshotCompression::ECompressor Compressor;
+    if (!FAegisSnapshotCompression::ParseCompressor(Codec, Compressor))
+    {
+        UE_LOG(LogAegisBridge, Error, TEXT("Unknown snapshot compression codec: %s"), *Codec);
+        return false;
+    }
+
+    TArray<uint8> Payload;
+    if (bBinary)
+    {
+        FAegisBinarySnapshot Snapshot;
+        if (!Snapshot.FromJson(SnapshotData))
+        {
+            UE_LOG(LogAegisBridge, Error, TEXT("Failed to parse snapshot %s for binary export"), *SnapshotId);
+            return false;
+        }
+        Snapshot.Save(Payload);
+    }
+    else
+    {
+        const FTCHARToUTF8 Utf8(*SnapshotData);
+        Payload.Append(reinterpret_cast<const uint8*>(Utf8.Get()), Utf8.Length());
+    }
+
+    const int32 PayloadSize = Payload.Num();
+    if (Compressor != FAegisSnapshotCompression::ECompressor::NotSet)
+    {
+        TArray<uint8> Container;
+        if (!FAegisSnapshotCompression::Compress(Payload, Container, Compressor, FAegisSnapshotCompression::ToCompressionLevel(CompressionLevel)))
+        {
+            return false;
+        }
+        Payload = MoveTemp(Container);
+    }
+
+    if (FFileHelper::SaveArrayToFile(Payload, *OutputPath))
+    {
+        UE_LOG(LogAegisBridge, Log, TEXT("Exported snapshot to: %s (%d -> %d bytes)"), *OutputPath, PayloadSize, Payload.Num());
+        return true;
+    }
+
+    UE_LOG(LogAegisBridge, Error, TEXT("Failed to export snapshot to: %s"), *OutputPath);
+    return false;
+}
+
+FString UAegisSeedSubsystem::ImportSnapshot(const FString& InputPath)
+{
+    AEGIS_COMMAND_SCOPE(AegisSeedSubsystem, ImportSnapshot);
+
+    TArray<uint8> Buffer;
+    if (!FFileHelper::LoadFileToArray(Buffer, *InputPath))
+    {
+        UE_LOG(LogAegisBridge, Error, TEXT("Failed to import snapshot from: %s"), *InputPath);
+        return TEXT("");
+    }
+
+    // Containers wrap either format, so unwrap before detecting the payload
+    if (FAegisSnapshotCompression::IsCompressed(Buffer))
+    {
+        TArray<uint8> Payload;
+        if (!FAegisSnapshotCompression::Decompress(Buffer, Payload))
+        {
+            UE_LOG(LogAegisBridge, Error, TEXT("Corrupt compressed snapshot: %s"), *InputPath);
+            return TEXT("");
+        }
+        Buffer = MoveTemp(Payload);
+    }
+
+    FString SnapshotData;
+    if (FAegisBinarySnapshot::IsBinarySnapshot(Buffer))
+    {
+        FAegisBinarySnapshot Snapshot;
+        if (!Snapshot.Load(Buffer))
+        {
+            UE_LOG(LogAegisBridge, Error, TEXT("Corrupt binary snapshot: %s"), *InputPath);
+            return TEXT("");
+        }
+        SnapshotData = Snapshot.ToJson();
+    }
+    else
+    {
+        FFileHelper::BufferToString(SnapshotData, Buffer.GetData(), Buffer.Num());
+    }
+
+    UE_LOG(LogAegisBridge, Log, TEXT("Imported snapshot from: %s"), *InputPath);
+    return SnapshotData;
+}
+
+// ============================================================================
+// State Restoration Operations
+// ============================================================================
+
+bool UAegisSeedSubsystem::RestoreWorldState(const FString& SnapshotId, const FString& Entities, const FString& MergeMode, bool bPreserveGUIDs)
+{
+    AEGIS_COMMAND_SCOPE(AegisSeedSubsystem, RestoreWorldState);
+
+    UWorld* World = GEditor ? GEditor->GetEditorWorldContext().World() : nullptr;
+    if (!World)
+    {
+        return false;
+    }
+
+    // Parse entities into the compact record form shared with binary snapshots
+    FAegisBinarySnapshot Snapshot;
+    if (!Snapshot.FromJson(Entities))
+    {
+        UE_LOG(LogAegisBridge, Error, TEXT("Failed to parse entities JSON"));
+        return false;
+    }
+
+    const int32 RestoredCount = RestoreSnapshotEntities(World, MoveTemp(Snapshot), MergeMode, bPreserveGUIDs);
+    if (RestoredCount == INDEX_NONE)
+    {
+        return false;
+    }
+
+    UE_LOG(LogAegisBridge, Log, TEXT("Restored %d entities from snapshot %s"), RestoredCount, *SnapshotId);
+    return true;
+}
+
+bool UAegisSeedSubsystem::RestoreWorldStateFromFile(const FString& InputPath, const FString& MergeMode, bool bPreserveGUIDs)
+{
+    AEGIS_COMMAND_SCOPE(AegisSeedSubsystem, RestoreWorldStateFromFile);
+
+    UWorld* World = GEditor ? GEditor->GetEditorWorldContext().World() : nullptr;
+    if (!World)
+    {
+        return false;
+    }
+
+    FAegisBinarySnapshot Snapshot;
+    if (!FAegisWorldRestore::LoadSnapshotFile(InputPath, Snapshot))
+    {
+        UE_LOG(LogAegisBridge, Error, TEXT("Failed to load binary snapshot: %s"), *InputPath);
+        return false;
+    }
+
+    const int32 RestoredCount = RestoreSnapshotEntities(World, MoveTemp(Snapshot), MergeMode, bPreserveGUIDs);
+    if (RestoredCount == INDEX_NONE)
+    {
+        return false;
+    }
+
+    UE_LOG(LogAegisBridge, Log, TEXT("Restored %d entities from %s"), RestoredCount, *InputPath);
+    return true;
+}
+
+bool UAegisSeedSubsystem::ParseMergeMode(const FString& MergeMode, bool& bOutReplace)
+{
+    // The entity list of a selective restore is already the selection, so it merges like "merge"
+    bOutReplace = MergeMode == TEXT("replace");
+    return bOutReplace || MergeMode == TEXT("merge") || MergeMode == TEXT("selective");
+}
+
+TArray<AActor*> UAegisSeedSubsystem::GetTrackedActors(UWorld* World) const
+{
+    TArray<AActor*> TrackedActors;
+    for (TActorIterator<AActor> It(World); It; ++It)
+    {
+        if (!GUIDRegistry.FindGUIDByPath(It->GetPathName()).IsEmpty())
+        {
+            TrackedActors.Add(*It);
+        }
+    }
+    return TrackedActors;
+}
+
+int32 UAegisSeedSubsystem::RestoreSnapshotEntities(UWorld* World, FAegisBinarySnapshot&& Snapshot, const FString& MergeMode, bool bPreserveGUIDs)
+{
+    bool bReplace = false;
+    if (!ParseMergeMode(MergeMode, bReplace))
+    {
+        UE_LOG(LogAegisBridge, Error, TEXT("Unknown merge mode: %s"), *MergeMode);
+        return INDEX_NONE;
+    }
+
+    // Classes are resolved once up front and every actor is constructed once, in one transaction
+    FAegisWorldRestore Restore(World, MoveTemp(Snapshot), bPreserveGUIDs);
+    if (bReplace)
+    {
+        // Only actors AEGIS tracks are replaced; untracked level content is left alone
+        Restore.SetReplacedActors(GetTrackedActors(World));
+    }
+    const int32 RestoredCount = Restore.Run();
+
+    if (Restore.GetMissingClassCount() > 0)
+    {
+        UE_LOG(LogAegisBridge, Warning, TEXT("Skipped %d entities with unresolved classes"), Restore.GetMissingClassCount());
+    }
+
+    return RestoredCount;
+}
+
+AActor* UAegisSeedSubsystem::SpawnSnapshotEntity(UWorld* World, const FAegisBinarySnapshot& Snapshot, const FAegisSnapshotEntity& Entity, TMap<int32, UClass*>& ClassCache, bool bPreserveGUIDs)
+{
+    const FString& ClassName = Snapshot.GetString(Entity.Class);
+    const FString& EntityGUID = Snapshot.GetString(Entity.GUID);
+
+    UClass** CachedClass = ClassCache.Find(Entity.Class);
+    UClass* ActorClass = CachedClass ? *CachedClass : nullptr;
+    if (!CachedClass)
+    {
+        ActorClass = FAegisWorldRestore::ResolveClass(ClassName);
+        ClassCache.Add(Entity.Class, ActorClass);
+    }
+
+    if (!ActorClass)
+    {
+        return nullptr;
+    }
+
+    // The captured name is only a request: the level may hold another actor of that name by now
+    FActorSpawnParameters SpawnParams;
+    SpawnParams.Name = *Snapshot.GetString(Entity.Name);
+    SpawnParams.NameMode = FActorSpawnParameters::ESpawnActorNameMode::Requested;
+
+    const FTransform Transform(FRotator(Entity.Rotation), FVector(Entity.Location), FVector(Entity.Scale));
+    AActor* Actor = World->SpawnActor(ActorClass, &Transform, SpawnParams);
+    if (Actor && bPreserveGUIDs && !EntityGUID.IsEmpty())
+    {
+        RegisterGUID(EntityGUID, Actor->GetPathName(), ClassName, TEXT("{}"));
+    }
+
+    return Actor;
+}
+
+// ============================================================================
+// Delta Snapshots
+// ============================================================================
+
+FString UAegisSeedSubsystem::CaptureDeltaSnapshot(const FString& BaseSnapshotId)
+{
+    AEGIS_COMMAND_SCOPE(AegisSeedSubsystem, CaptureDeltaSnapshot);
+
+    static constexpr int32 MaxChainLength = 32;
+
+    UWorld* World = GEditor ? GEditor->GetEditorWorldContext().World() : nullptr;
+    if (!World || BaseSnapshotId.IsEmpty())
+    {
+        return TEXT("");
+    }
+
+    FAegisBinarySnapshot Current;
+    CaptureWorldState(World, Current);
+
+    FString ResultString;
+    TSharedRef<FAegisJsonWriter> Writer = FAegisJsonWriterFactory::Create(&ResultString);
+    Writer->WriteObjectStart();
+    Writer->WriteValue(TEXT("success"), true);
+    Writer->WriteValue(TEXT("baseSnapshotId"), BaseSnapshotId);
+
+    FAegisDeltaChain* Chain = FindOrLoadDeltaChain(BaseSnapshotId);
+    if (!Chain)
+    {
+        // First capture for this id establishes the base; records left by a vanished base go first
+        RemoveStoredDeltas(BaseSnapshotId);
+        Current.Id = BaseSnapshotId;
+        Current.Timestamp = FDateTime::UtcNow().ToIso8601();
+        Current.Checksum = ComputeChecksum(Current);
+        SnapshotStore.Store(BaseSnapshotId, Current.ToJson(), MakeSnapshotRecord(Current));
+
+        FAegisDeltaChain& NewChain = DeltaChains.Add(BaseSnapshotId);
+        NewChain.BaseSnapshotId = BaseSnapshotId;
+        NewChain.Head = MoveTemp(Current);
+
+        Writer->WriteValue(TEXT("createdBase"), true);
+        Writer->WriteValue(TEXT("entityCount"), NewChain.Head.Entities.Num());
+        Writer->WriteObjectEnd();
+        Writer->Close();
+        return ResultString;
+    }
+
+    FAegisSnapshotDelta Delta = FAegisSnapshotDelta::Compute(Chain->Head, Current);
+    Delta.DeltaId = FString::Printf(TEXT("DELTA-%s"), *FGuid::NewGuid().ToString(EGuidFormats::Digits).Left(16));
+    Delta.BaseSnapshotId = BaseSnapshotId;
+    Delta.ParentDeltaId = Chain->Deltas.Num() > 0 ? Chain->Deltas.Last().DeltaId : FString();
+
+    Writer->WriteValue(TEXT("deltaId"), Delta.IsEmpty() ? FString() : Delta.DeltaId);
+    Writer->WriteObjectStart(TEXT("summary"));
+    Writer->WriteValue(TEXT("total"), Delta.Num());
+    Writer->WriteValue(TEXT("added"), Delta.CountChanges(EAegisEntityChange::Added));
+    Writer->WriteValue(TEXT("removed"), Delta.CountChanges(EAegisEntityChange::Removed));
+    Writer->WriteValue(TEXT("transformChanged"), Delta.CountChanges(EAegisEntityChange::Transform));
+    Writer->WriteValue(TEXT("propertyChanged"), Delta.CountChanges(EAegisEntityChange::Properties));
+    Writer->WriteObjectEnd();
+
+    if (!Delta.IsEmpty())
+    {
+        // The capture is the new head; applying the delta would produce the same state
+        Current.Id = Chain->Head.Id;
+        Current.Name = Chain->Head.Name;
+        Current.Description = Chain->Head.Description;
+        Current.Seed = Chain->Head.Seed;
+        Current.Targets = Chain->Head.Targets;
+        Current.MetadataJson = Chain->Head.MetadataJson;
+        Current.Timestamp = FDateTime::UtcNow().ToIso8601();
+        Current.Checksum = ComputeChecksum(Current);
+        Chain->Head = MoveTemp(Current);
+        StoreDelta(Chain->Deltas.Add_GetRef(MoveTemp(Delta)));
+    }
+
+    bool bCompacted = false;
+    if (Chain->Deltas.Num() >= MaxChainLength)
+    {
+        bCompacted = CompactChain(*Chain);
+    }
+
+    Writer->WriteValue(TEXT("chainLength"), Chain->Deltas.Num());
+    Writer->WriteValue(TEXT("compacted"), bCompacted);
+    Writer->WriteObjectEnd();
+    Writer->Close();
+
+    return ResultString;
+}
+
+FString UAegisSeedSubsystem::GetDeltaSnapshot(const FString& BaseSnapshotId, const FString& DeltaId)
+{
+    AEGIS_COMMAND_SCOPE(AegisSeedSubsystem, GetDeltaSnapshot);
+
+    const FAegisDeltaChain* Chain = FindOrLoadDeltaChain(BaseSnapshotId);
+    const FAegisSnapshotDelta* Delta = Chain ? Chain->FindDelta(DeltaId) : nullptr;
+    if (!Delta)
+    {
+        return TEXT("");
+    }
+
+    FString ResultString;
+    TSharedRef<FAegisJsonWriter> Writer = FAegisJsonWriterFactory::Create(&ResultString);
+    Delta->WriteJson(*Writer);
+    Writer->Close();
+
+    return ResultString;
+}
+
+FString UAegisSeedSubsystem::CompactDeltaChain(const FString& BaseSnapshotId)
+{
+    AEGIS_COMMAND_SCOPE(AegisSeedSubsystem, CompactDeltaChain);
+
+    FAegisDeltaChain* Chain = FindOrLoadDeltaChain(BaseSnapshotId);
+    if (!Chain)
+    {
+        return TEXT("");
+    }
+
+    const int32 DeltaCount = Chain->Deltas.Num();
+    const bool bStored = CompactChain(*Chain);
+
+    FString ResultString;
+    TSharedRef<FAegisJsonWriter> Writer = FAegisJsonWriterFactory::Create(&ResultString);
+    Writer->WriteObjectStart();
+    Writer->WriteValue(TEXT("success"), bStored);
+    Writer->WriteValue(TEXT("baseSnapshotId"), BaseSnapshotId);
+    Writer->WriteValue(TEXT("compactedDeltas"), DeltaCount);
+    Writer->WriteValue(TEXT("entityCount"), Chain->Head.Entities.Num());
+    Writer->WriteObjectEnd();
+    Writer->Close();
+
+    return ResultString;
+}
+
+FAegisDeltaChain* UAegisSeedSubsystem::FindOrLoadDeltaChain(const FString& BaseSnapshotId)
+{
+    if (FAegisDeltaChain* Chain = DeltaChains.Find(BaseSnapshotId))
+    {
+        return Chain;
+    }
+
+    // A compacted chain starts from its own stored base; the user's snapshot is never rewritten
+    const FString CompactedBaseId = GetCompactedBaseStoreId(BaseSnapshotId);
+    const FString& StartId = SnapshotStore.Contains(CompactedBaseId) ? CompactedBaseId : BaseSnapshotId;
+
+    FAegisBinarySnapshot Base;
+    if (!SnapshotStore.Contains(BaseSnapshotId) || !Base.FromJson(SnapshotStore.LoadText(StartId)))
+    {
+        return nullptr;
+    }
+
+    FAegisDeltaChain& Chain = DeltaChains.Add(BaseSnapshotId);
+    Chain.BaseSnapshotId = BaseSnapshotId;
+    Chain.Head = MoveTemp(Base);
+
+    // Stored deltas are replayed in parent order; the first one after the base has no parent
+    TArray<FString> DeltaIds;
+    SnapshotStore.ListDeltas(BaseSnapshotId, DeltaIds);
+
+    TMap<FString, FAegisSnapshotDelta> ByParent;
+    for (const FString& DeltaId : DeltaIds)
+    {
+        if (DeltaId == CompactedBaseId)
+        {
+            continue;
+        }
+
+        FAegisSnapshotDelta Delta;
+        if (Delta.FromJson(SnapshotStore.LoadText(DeltaId)))
+        {
+            ByParent.Add(Delta.ParentDeltaId, MoveTemp(Delta));
+        }
+        else
+        {
+            UE_LOG(LogAegisBridge, Warning, TEXT("Skipping unreadable delta record %s"), *DeltaId);
+        }
+    }
+
+    FString ParentDeltaId;
+    FAegisSnapshotDelta Delta;
+    while (ByParent.RemoveAndCopyValue(ParentDeltaId, Delta))
+    {
+        Delta.ApplyTo(Chain.Head);
+        ParentDeltaId = Delta.DeltaId;
+        Chain.Deltas.Add(MoveTemp(Delta));
+    }
+
+    if (ByParent.Num() > 0)
+    {
+        UE_LOG(LogAegisBridge, Warning, TEXT("Delta chain of %s is broken after %d deltas; %d unreachable deltas ignored"),
+            *BaseSnapshotId, Chain.Deltas.Num(), ByParent.Num());
+    }
+    return &Chain;
+}
+
+bool UAegisSeedSubsystem::CompactChain(FAegisDeltaChain& Chain)
+{
+    // A head replayed from stored deltas carries the base's checksum, not its own
+    Chain.Compact();
+    Chain.Head.Checksum = ComputeChecksum(Chain.Head);
+
+    // Stored as a record of the base, so it stays out of listings and is deleted along with it
+    const FString CompactedBaseId = GetCompactedBaseStoreId(Chain.BaseSnapshotId);
+    FAegisSnapshotRecord Record = MakeSnapshotRecord(Chain.Head);
+    Record.BaseSnapshotId = Chain.BaseSnapshotId;
+    if (!SnapshotStore.Store(CompactedBaseId, Chain.Head.ToJson(), Record))
+    {
+        UE_LOG(LogAegisBridge, Error, TEXT("Failed to store compacted base %s"), *CompactedBaseId);
+        return false;
+    }
+
+    RemoveStoredDeltas(Chain.BaseSnapshotId, false);
+
+    UE_LOG(LogAegisBridge, Log, TEXT("Compacted delta chain of %s (%d entities)"), *Chain.BaseSnapshotId, Chain.Head.Entities.Num());
+    return true;
+}
+
+bool UAegisSeedSubsystem::StoreDelta(const FAegisSnapshotDelta& Delta)
+{
+    FAegisSnapshotRecord Record;
+    Record.BaseSnapshotId = Delta.BaseSnapshotId;
+    if (!SnapshotStore.Store(GetDeltaStoreId(Delta.BaseSnapshotId, Delta.DeltaId), Delta.ToJson(), Record))
+    {
+        UE_LOG(LogAegisBridge, Error, TEXT("Failed to store delta %s of %s; it is lost on restart"), *Delta.DeltaId, *Delta.BaseSnapshotId);
+        return false;
+    }
+    return true;
+}
+
+bool UAegisSeedSubsystem::LoadStoredDelta(const FString& DeltaId, FAegisSnapshotDelta& OutDelta)
+{
+    if (DeltaId.IsEmpty())
+    {
+        return false;
+    }
+
+    // The index names every base with delta records, so no chain has to be replayed to find one
+    TArray<FString> DeltaBases;
+    SnapshotStore.ListDeltaBases(DeltaBases);
+    for (const FString& BaseSnapshotId : DeltaBases)
+    {
+        if (const FAegisDeltaChain* Chain = DeltaChains.Find(BaseSnapshotId))
+        {
+            if (const FAegisSnapshotDelta* Delta = Chain->FindDelta(DeltaId))
+            {
+                OutDelta = *Delta;
+                return true;
+            }
+            continue;
+        }
+
+        const FString StoreId = GetDeltaStoreId(BaseSnapshotId, DeltaId);
+        if (SnapshotStore.Contains(StoreId) && OutDelta.FromJson(SnapshotStore.LoadText(StoreId)))
+        {
+            return true;
+        }
+    }
+    return false;
+}
+
+void UAegisSeedSubsystem::RemoveStoredDeltas(const FString& BaseSnapshotId, bool bIncludeCompactedBase)
+{
+    const FString CompactedBaseId = GetCompactedBaseStoreId(BaseSnapshotId);
+
+    TArray<FString> DeltaIds;
+    SnapshotStore.ListDeltas(BaseSnapshotId, DeltaIds);
+    if (!bIncludeCompactedBase)
+    {
+        DeltaIds.Remove(CompactedBaseId);
+    }
+    SnapshotStore.Remove(DeltaIds);
+}
+
+FString UAegisSeedSubsystem::GetDeltaStoreId(const FString& BaseSnapshotId, const FString& DeltaId)
+{
+    return FString::Printf(TEXT("%s#%s"), *BaseSnapshotId, *DeltaId);
+}
+
+FAegisSnapshotRecord UAegisSeedSubsystem::MakeSnapshotRecord(const FAegisBinarySnapshot& Snapshot)
+{
+    FAegisSnapshotRecord Record;
+    Record.Name = Snapshot.Name;
+    Record.Description = Snapshot.Description;
+    Record.Checksum = Snapshot.Checksum;
+    Record.EntityCount = Snapshot.Entities.Num();
+    FDateTime::ParseIso8601(*Snapshot.Timestamp, Record.Timestamp);
+    return Record;
+}
+
+FAegisSnapshotRecord UAegisSeedSubsystem::ReadSnapshotRecord(const FString& SnapshotData)
+{
+    FAegisSnapshotRecord Record;
+
+    // Only the header members go through the tree parser; entities are counted, not parsed
+    TArray<TPair<FStringView, FStringView>> Members;
+    if (!FAegisParallelJson::SplitObject(SnapshotData, Members))
+    {
+        return Record;
+    }
+
+    FString HeaderJson(TEXT("{"));
+    for (const TPair<FStringView, FStringView>& Member : Members)
+    {
+        if (Member.Key == TEXT("entities"))
+        {
+            TArray<FStringView> Entities;
+            if (FAegisParallelJson::SplitArray(Member.Value, Entities))
+            {
+                Record.EntityCount = Entities.Num();
+            }
+        }
+        else if (Member.Key == TEXT("name") || Member.Key == TEXT("description") || Member.Key == TEXT("checksum") || Member.Key == TEXT("timestamp"))
+        {
+            if (HeaderJson.Len() > 1)
+            {
+                HeaderJson.AppendChar(TCHAR(','));
+            }
+            HeaderJson.AppendChar(TCHAR('"'));
+            HeaderJson.Append(Member.Key.GetData(), Member.Key.Len());
+            HeaderJson.Append(TEXT("\":"));
+            HeaderJson.Append(Member.Value.GetData(), Member.Value.Len());
+        }
+    }
+    HeaderJson.AppendChar(TCHAR('}'));
+
+    TSharedPtr<FJsonObject> Header;
+    TSharedRef<TJsonReader<>> Reader = TJsonReaderFactory<>::Create(HeaderJson);
+    if (FJsonSerializer::Deserialize(Reader, Header) && Header.IsValid())
+    {
+        Header->TryGetStringField(TEXT("name"), Record.Name);
+        Header->TryGetStringField(TEXT("description"), Record.Description);
+        Header->TryGetStringField(TEXT("checksum"), Record.Checksum);
+
+        FString Timestamp;
+        if (Header->TryGetStringField(TEXT("timestamp"), Timestamp))
+        {
+            FDateTime::ParseIso8601(*Timestamp, Record.Timestamp);
+        }
+    }
+    return Record;
+}
+
+FString UAegisSeedSubsystem::GetCompactedBaseStoreId(const FString& BaseSnapshotId)
+{
+    // Delta ids never contain '@', so this cannot collide with a delta record
+    return FString::Printf(TEXT("%s#@compacted"), *BaseSnapshotId);
+}
+
+void UAegisSeedSubsystem::CaptureWorldState(UWorld* World, FAegisBinarySnapshot& OutSnapshot, TConstArrayView<FString> Properties)
+{
+    FAegisPropertyPlanCache& Plans = FAegisBridgeModule::Get().GetPropertyPlans();
+
+    for (TActorIterator<AActor> It(World); It; ++It)
+    {
+        AActor* Actor = *It;
+        const FString ActorPath = Actor->GetPathName();
+        const FString ExistingGUID = GUIDRegistry.FindGUIDByPath(ActorPath);
+
+        FAegisSnapshotEntity& Entity = OutSnapshot.Entities.AddDefaulted_GetRef();
+        Entity.GUID = !ExistingGUID.IsEmpty() ? OutSnapshot.AddString(ExistingGUID) : INDEX_NONE;
+        Entity.Class = OutSnapshot.AddString(Actor->GetClass()->GetName());
+        Entity.Path = OutSnapshot.AddString(ActorPath);
+        Entity.Name = OutSnapshot.AddString(Actor->GetName());
+
+        Entity.bHasTransform = true;
+        Entity.Location = FVector3f(Actor->GetActorLocation());
+        Entity.Rotation = FRotator3f(Actor->GetActorRotation());
+        Entity.Scale = FVector3f(Actor->GetActorScale3D());
+
+        for (const FName& Tag : Actor->Tags)
+        {
+            Entity.Tags.Add(OutSnapshot.AddString(Tag.ToString()));
+        }
+
+        for (UActorComponent* Component : Actor->GetComponents())
+        {
+            FAegisSnapshotComponent& Record = Entity.Components.AddDefaulted_GetRef();
+            Record.Class = OutSnapshot.AddString(Component->GetClass()->GetName());
+            Record.Name = OutSnapshot.AddString(Component->GetName());
+        }
+
+        // Typed values where the plan has a codec, text otherwise; ApplyEntityProperties reads both
+        if (Properties.Num() > 0)
+        {
+            const FAegisPropertyPlan& Plan = Plans.Get(Actor->GetClass());
+            TSharedRef<FAegisJsonWriter> Writer = FAegisJsonWriterFactory::Create(&Entity.PropertiesJson);
+            Writer->WriteObjectStart();
+            for (const FString& PropertyName : Properties)
+            {
+                if (const FAegisPropertyPlan::FEntry* Entry = Plan.Find(PropertyName))
+                {
+                    FAegisPropertyPlan::WriteValue(*Writer, *PropertyName, *Entry, Actor);
+                }
+            }
+            Writer->WriteObjectEnd();
+            Writer->Close();
+        }
+    }
+}
+
+bool UAegisSeedSubsystem::WriteWorldHash(FAegisJsonWriter& Writer, const FAegisWorldHashOptions& Options, int32 Depth,
+    const TMap<FString, FString>& KnownHashes, const FString& SnapshotId)
+{
+    FAegisBinarySnapshot State;
+    if (!SnapshotId.IsEmpty())
+    {
+        if (!LoadSnapshotState(SnapshotId, State))
+        {
+            Writer.WriteValue(TEXT("success"), false);
+            Writer.WriteValue(TEXT("error"), FString::Printf(TEXT("Snapshot not found: %s"), *SnapshotId));
+            return false;
+        }
+    }
+    else
+    {
+        UWorld* World = GEditor ? GEditor->GetEditorWorldContext().World() : nullptr;
+        if (!World)
+        {
+            Writer.WriteValue(TEXT("success"), false);
+            Writer.WriteValue(TEXT("error"), TEXT("No editor world"));
+            return false;
+        }
+        CaptureWorldState(World, State, Options.Properties);
+    }
+
+    FAegisWorldHash Hash;
+    Hash.Build(State, Options);
+
+    Writer.WriteValue(TEXT("success"), true);
+    Writer.WriteObjectStart(TEXT("data"));
+    Hash.WriteJson(Writer, Depth);
+    if (KnownHashes.Num() > 0)
+    {
+        Hash.WriteDiff(Writer, KnownHashes);
+    }
+    Writer.WriteObjectEnd();
+    return true;
+}
+
+FString UAegisSeedSubsystem::ComputeWorldHash(int32 Depth)
+{
+    AEGIS_COMMAND_SCOPE(AegisSeedSubsystem, ComputeWorldHash);
+
+    FString ResultString;
+    TSharedRef<FAegisJsonWriter> Writer = FAegisJsonWriterFactory::Create(&ResultString);
+    Writer->WriteObjectStart();
+    WriteWorldHash(*Writer, FAegisWorldHashOptions(), Depth, TMap<FString, FString>(), FString());
+    Writer->WriteObjectEnd();
+    Writer->Close();
+    return ResultString;
+}
+
+FString UAegisSeedSubsystem::ComputeChecksum(const FAegisBinarySnapshot& State)
+{
+    FAegisWorldHash Hash;
+    Hash.Build(State, FAegisWorldHashOptions());
+    return FAegisWorldHash::HashToString(Hash.GetRootHash());
+}
+
+AActor* UAegisSeedSubsystem::FindEntityActor(UWorld* World, const FString& EntityKey, const FString& FallbackPath)
+{
+    FAegisActorIndex& ActorIndex = FAegisBridgeModule::Get().GetActorIndex();
+
+    const FString RegisteredPath = GUIDRegistry.FindPathByGUID(EntityKey);
+    if (!RegisteredPath.IsEmpty())
+    {
+        if (AActor* Actor = ActorIndex.FindActor(World, RegisteredPath))
+        {
+            return Actor;
+        }
+    }
+
+    // Unregistered entities are keyed by path
+    return ActorIndex.FindActor(World, FallbackPath.IsEmpty() ? EntityKey : FallbackPath);
+}
+
+int32 UAegisSeedSubsystem::ApplyEntityProperties(AActor* Actor, const FString& PropertiesJson)
+{
+    TSharedPtr<FJsonObject> Properties;
+    TSharedRef<TJsonReader<>> Reader = TJsonReaderFactory<>::Create(PropertiesJson);
+    if (PropertiesJson.IsEmpty() || !FJsonSerializer::Deserialize(Reader, Properties) || !Properties.IsValid())
+    {
+        return 0;
+    }
+
+    const FAegisPropertyPlan& Plan = FAegisBridgeModule::Get().GetPropertyPlans().Get(Actor->GetClass());
+    int32 ModifiedCount = 0;
+    for (const auto& Pair : Properties->Values)
+    {
+        const FAegisPropertyPlan::FEntry* Entry = Plan.Find(Pair.Key);
+        if (Entry && Pair.Value.IsValid() && FAegisPropertyPlan::ImportJson(*Entry, Actor, *Pair.Value))
+        {
+            ModifiedCount++;
+        }
+    }
+    return ModifiedCount;
+}
+
+void UAegisSeedSubsystem::ApplyDeltaToWorld(UWorld* World, const FAegisSnapshotDelta& Delta, bool bPreserveGUIDs, FAegisDeltaApplyResult& OutResult)
+{
+    GEditor->BeginTransaction(FText::FromString(TEXT("AEGIS Apply Delta")));
+
+    for (const FString& Key : Delta.Removed)
+    {
+        AActor* Actor = FindEntityActor(World, Key, FString());
+        if (!Actor)
+        {
+            OutResult.Skipped++;
+            continue;
+        }
+
+        Actor->Modify();
+        Actor->Destroy();
+        OutResult.Applied++;
+    }
+
+    TMap<int32, UClass*> ClassCache;
+    const FAegisBinarySnapshot& Upserts = Delta.Upserts;
+
+    for (int32 Index = 0; Index < Upserts.Entities.Num(); ++Index)
+    {
+        const FAegisSnapshotEntity& Entity = Upserts.Entities[Index];
+        const EAegisEntityChange Change = Delta.Changes[Index];
+        const FString& Key = Upserts.GetEntityKey(Entity);
+
+        AActor* Actor = FindEntityActor(World, Key, Upserts.GetString(Entity.Path));
+        if (!Actor)
+        {
+            if (EnumHasAnyFlags(Change, EAegisEntityChange::Added) && SpawnSnapshotEntity(World, Upserts, Entity, ClassCache, bPreserveGUIDs))
+            {
+                OutResult.Applied++;
+            }
+            else
+            {
+                OutResult.Skipped++;
+                OutResult.Warnings.Add(FString::Printf(TEXT("Entity not found: %s"), *Key));
+            }
+            continue;
+        }
+
+        // Added entities that already exist are updated in place
+        Actor->Modify();
+
+        if (Entity.bHasTransform && EnumHasAnyFlags(Change, EAegisEntityChange::Transform | EAegisEntityChange::Added))
+        {
+            Actor->SetActorLocationAndRotation(FVector(Entity.Location), FRotator(Entity.Rotation));
+            Actor->SetActorScale3D(FVector(Entity.Scale));
+        }
+
+        if (EnumHasAnyFlags(Change, EAegisEntityChange::Properties | EAegisEntityChange::Added))
+        {
+            ApplyEntityProperties(Actor, Entity.PropertiesJson);
+        }
+
+        if (EnumHasAnyFlags(Change, EAegisEntityChange::Structure))
+        {
+            OutResult.Warnings.Add(FString::Printf(TEXT("Structural changes are not applied in place: %s"), *Key));
+        }
+
+        OutResult.Applied++;
+    }
+
+    GEditor->EndTransaction();
+
+    if (OutResult.Applied > 0)
+    {
+        World->MarkPackageDirty();
+    }
+}
+
+void UAegisSeedSubsystem::WriteDeltaApplyResult(FAegisJsonWriter& Writer, const FAegisSnapshotDelta& Delta, const FAegisDeltaApplyResult& Result, bool bDryRun)
+{
+    Writer.WriteValue(TEXT("plannedChanges"), Delta.Num());
+    Writer.WriteObjectStart(TEXT("summary"));
+    Writer.WriteValue(TEXT("added"), Delta.CountChanges(EAegisEntityChange::Added));
+    Writer.WriteValue(TEXT("removed"), Delta.CountChanges(EAegisEntityChange::Removed));
+    Writer.WriteValue(TEXT("transformChanged"), Delta.CountChanges(EAegisEntityChange::Transform));
+    Writer.WriteValue(TEXT("propertyChanged"), Delta.CountChanges(EAegisEntityChange::Properties));
+    Writer.WriteObjectEnd();
+
+    if (!bDryRun)
+    {
+        Writer.WriteValue(TEXT("appliedChanges"), Result.Applied);
+        Writer.WriteValue(TEXT("skippedChanges"), Result.Skipped);
+        Writer.WriteArrayStart(TEXT("warnings"));
+        for (const FString& Warning : Result.Warnings)
+        {
+            Writer.WriteValue(Warning);
+        }
+        Writer.WriteArrayEnd();
+    }
+}
+
+bool UAegisSeedSubsystem::LoadSnapshotState(const FString& SnapshotId, FAegisBinarySnapshot& OutSnapshot)
+{
+    return !SnapshotId.IsEmpty() && OutSnapshot.FromJson(SnapshotStore.LoadText(SnapshotId));
+}
+
+void UAegisSeedSubsystem::SetMergeTimes(FAegisMergeOptions& Options, const FAegisBinarySnapshot& Base, const FAegisBinarySnapshot& Theirs)
+{
+    if (Options.Resolution != EAegisMergeResolution::Newest)
+    {
+        return;
+    }
+
+    // World edits are dated by the journal; edits it no longer holds date from the base capture
+    FDateTime::ParseIso8601(*Theirs.Timestamp, Options.TheirsTime);
+    FDateTime::ParseIso8601(*Base.Timestamp, Options.OursDefaultTime);
+    if (UAegisChangeJournal* Journal = UAegisChangeJournal::Get())
+    {
+        Journal->GetLatestTimestamps(Options.OursTimes);
+    }
+}
+
+FString UAegisSeedSubsystem::SyncWorldState(const FString& TargetSnapshotId, const FString& TargetEntities, bool bCaptureCurrentFirst, const FString& ConflictResolution, bool bDryRun, const FString& BaseSnapshotId)
+{
+    AEGIS_COMMAND_SCOPE(AegisSeedSubsystem, SyncWorldState);
+
     UWorld* World = GEditor ? GEditor->GetEditorWorldContext().World() : nullptr;
 
-    TSharedPtr<FJsonObject> Result = MakeShareable(new FJsonObject());
+    FString ResultString;
+    TSharedRef<FAegisJsonWriter> Writer = FAegisJsonWriterFactory::Create(&ResultString);
+    Writer->WriteObjectStart();
+
+    // "source" is the current world, "target" the snapshot being synced to
+    FAegisMergeOptions Options;
+    if (!FAegisSnapshotMerge::ParseResolution(ConflictResolution, false, Options.Resolution))
+    {
+        Writer->WriteValue(TEXT("success"), false);
+        Writer->WriteValue(TEXT("error"), FString::Printf(TEXT("Unknown conflict resolution: %s"), *ConflictResolution));
+        Writer->WriteObjectEnd();
+        Writer->Close();
+        return ResultString;
+    }
 
-    if (World)
+    // Explicit entities win over the stored target payload
+    FAegisBinarySnapshot Target;
+    const bool bHasEntities = !TargetEntities.IsEmpty() && TargetEntities != TEXT("[]");
+    if (!World || !Target.FromJson(bHasEntities ? FStringView(TargetEntities) : SnapshotStore.LoadText(TargetSnapshotId)))
+    {
+        Writer->WriteValue(TEXT("success"), false);
+        Writer->WriteValue(TEXT("error"), FString::Printf(TEXT("Target snapshot not available: %s"), *TargetSnapshotId));
+        Writer->WriteObjectEnd();
+        Writer->Close();
+        return ResultString;
+    }
+
+    FAegisBinarySnapshot Current;
+    CaptureWorldState(World, Current);
+
+    // Without the state the world was synced from, every difference is the target's to make
+    FAegisBinarySnapshot Base;
+    const bool bHasBase = LoadSnapshotState(BaseSnapshotId, Base);
+    const FAegisBinarySnapshot& MergeBase = bHasBase ? Base : Current;
+    SetMergeTimes(Options, MergeBase, Target);
+
+    FAegisSnapshotDelta Delta;
+    TArray<FAegisMergeConflict> Conflicts;
+    FAegisSnapshotMerge::Merge(MergeBase, Current, Target, Options, Delta, Conflicts);
+
+    // Only entities tracked by the Seed protocol are removed; untracked actors are left alone
+    Delta.Removed.RemoveAll([this](const FString& Key) { return !GUIDRegistry.Contains(Key); });
+
+    Writer->WriteValue(TEXT("success"), true);
+    Writer->WriteValue(TEXT("threeWay"), bHasBase);
+
+    FAegisDeltaApplyResult Result;
+    if (!bDryRun)
     {
-        Result->SetStringField(TEXT("worldName"), World->GetName());
-        Result->SetStringField(TEXT("mapName"), World->GetMapName());
-        Result->SetStringField(TEXT("levelName"), World->GetCurrentLevel()->GetName());
-        Result->SetStringField(TEXT("projectName"), FApp::GetProjectName());
-        Result->SetStringField(TEXT("engineVersion"), FEngineVersion::Current().ToString());
+        if (bCaptureCurrentFirst)
+        {
+            const FString CurrentSnapshotId = FString::Printf(TEXT("SYNC-%s"), *FGuid::NewGuid().ToString(EGuidFormats::Digits).Left(16));
+            Current.Id = CurrentSnapshotId;
+            Current.Timestamp = FDateTime::UtcNow().ToIso8601();
+            Current.Checksum = ComputeChecksum(Current);
+            if (SnapshotStore.Store(CurrentSnapshotId, Current.ToJson(), MakeSnapshotRecord(Current)))
+            {
+                Writer->WriteValue(TEXT("currentSnapshotId"), CurrentSnapshotId);
+            }
+        }
+
+        ApplyDeltaToWorld(World, Delta, true, Result);
     }
 
+    WriteDeltaApplyResult(*Writer, Delta, Result, bDryRun);
+    Delta.WriteChangeList(*Writer, TEXT("changes"));
+    FAegisSnapshotMerge::WriteConflicts(*Writer, Conflicts, Options.Resolution);
+    Writer->WriteObjectEnd();
+    Writer->Close();
+
+    return ResultString;
+}
+
+FString UAegisSeedSubsystem::MergeWorldStates(const FString& SourceSnapshotId, const FString& TargetSnapshotId, const FString& Changes, const FString& ConflictResolution, bool bPreserveSourceGUIDs,
+    bool bDryRun, bool bIncludeTransforms, bool bIncludeProperties)
+{
+    AEGIS_COMMAND_SCOPE(AegisSeedSubsystem, MergeWorldStates);
+
+    UWorld* World = GEditor ? GEditor->GetEditorWorldContext().World() : nullptr;
+
     FString ResultString;
-    TSharedRef<TJsonWriter<>> Writer = TJsonWriterFactory<>::Create(&ResultString);
-    FJsonSerializer::Serialize(Result.ToSharedRef(), Writer);
+    TSharedRef<FAegisJsonWriter> Writer = FAegisJsonWriterFactory::Create(&ResultString);
+    Writer->WriteObjectStart();
+
+    // "source" is the snapshot being merged in, "target" the state the world started from
+    FAegisMergeOptions Options;
+    if (!World || !FAegisSnapshotMerge::ParseResolution(ConflictResolution, true, Options.Resolution))
+    {
+        Writer->WriteValue(TEXT("success"), false);
+        Writer->WriteValue(TEXT("error"), World ? FString::Printf(TEXT("Unknown conflict resolution: %s"), *ConflictResolution) : FString(TEXT("No editor world")));
+        Writer->WriteObjectEnd();
+        Writer->Close();
+        return ResultString;
+    }
+
+    if (!bIncludeTransforms)
+    {
+        Options.Fields &= ~EAegisEntityChange::Transform;
+    }
+    if (!bIncludeProperties)
+    {
+        Options.Fields &= ~EAegisEntityChange::Properties;
+    }
+
+    FAegisSnapshotDelta Delta;
+    TArray<FAegisMergeConflict> Conflicts;
+
+    FAegisBinarySnapshot Source;
+    FAegisBinarySnapshot Target;
+    const bool bThreeWay = LoadSnapshotState(SourceSnapshotId, Source) && LoadSnapshotState(TargetSnapshotId, Target);
+    if (bThreeWay)
+    {
+        // The diff records select which entities to merge
+        TArray<TSharedPtr<FJsonValue>> Records;
+        TSharedRef<TJsonReader<>> Reader = TJsonReaderFactory<>::Create(Changes);
+        if (FJsonSerializer::Deserialize(Reader, Records))
+        {
+            for (const TSharedPtr<FJsonValue>& Record : Records)
+            {
+                const TSharedPtr<FJsonObject>* RecordObject = nullptr;
+                FString Key;
+                if (Record.IsValid() && Record->TryGetObject(RecordObject) && (*RecordObject)->TryGetStringField(TEXT("guid"), Key))
+                {
+                    Options.OnlyKeys.Add(MoveTemp(Key));
+                }
+            }
+        }
+
+        FAegisBinarySnapshot Current;
+        CaptureWorldState(World, Current);
+        SetMergeTimes(Options, Target, Source);
+        FAegisSnapshotMerge::Merge(Target, Current, Source, Options, Delta, Conflicts);
+    }
+    else if (!Delta.FromDiffJson(Changes))
+    {
+        // Snapshots the store does not hold can only be merged from the client's diff
+        Writer->WriteValue(TEXT("success"), false);
+        Writer->WriteValue(TEXT("error"), TEXT("Invalid merge changes"));
+        Writer->WriteObjectEnd();
+        Writer->Close();
+        return ResultString;
+    }
+
+    FAegisDeltaApplyResult Result;
+    if (!bDryRun)
+    {
+        ApplyDeltaToWorld(World, Delta, bPreserveSourceGUIDs, Result);
+    }
+
+    Writer->WriteValue(TEXT("success"), true);
+    Writer->WriteValue(TEXT("threeWay"), bThreeWay);
+    WriteDeltaApplyResult(*Writer, Delta, Result, bDryRun);
+    Delta.WriteChangeList(*Writer, TEXT("changes"));
+    FAegisSnapshotMerge::WriteConflicts(*Writer, Conflicts, Options.Resolution);
+    Writer->WriteObjectEnd();
+    Writer->Close();
 
     return ResultString;
 }
 
-// ============================================================================
-// Helper Functions
-// ============================================================================
+FString UAegisSeedSubsystem::ApplyDiff(const FString& DiffId, const FString& Changes, const FString& ConflictResolution)
+{
+    AEGIS_COMMAND_SCOPE(AegisSeedSubsystem, ApplyDiff);
+
+    UWorld* World = GEditor ? GEditor->GetEditorWorldContext().World() : nullptr;
+
+    FString ResultString;
+    TSharedRef<FAegisJsonWriter> Writer = FAegisJsonWriterFactory::Create(&ResultString);
+    Writer->WriteObjectStart();
+
+    // A delta captured in the editor can be applied by id alone; otherwise decode the MCP diff
+    FAegisSnapshotDelta StoredDelta;
+    const bool bStoredDelta = LoadStoredDelta(DiffId, StoredDelta);
+
+    FAegisSnapshotDelta ParsedDelta;
+    if (!World || (!bStoredDelta && !ParsedDelta.FromDiffJson(Changes)))
+    {
+        Writer->WriteValue(TEXT("success"), false);
+        Writer->WriteValue(TEXT("error"), FString::Printf(TEXT("Invalid diff: %s"), *DiffId));
+        Writer->WriteObjectEnd();
+        Writer->Close();
+        return ResultString;
+    }
+
+    const FAegisSnapshotDelta& Delta = bStoredDelta ? StoredDelta : ParsedDelta;
+
+    FAegisDeltaApplyResult Result;
+    ApplyDeltaToWorld(World, Delta, true, Result);
+
+    Writer->WriteValue(TEXT("success"), true);
+    WriteDeltaApplyResult(*Writer, Delta, Result, false);
+    Writer->WriteObjectEnd();
+    Writer->Close();
+
+    return ResultString;
+}
 
-FString UAegisSeedSubsystem::GetNamespaceCode(const FString& Namespace)
+FString UAegisSeedSubsystem::GetCurrentLevelInfo()
 {
-    if (Namespace == TEXT("actor")) return TEXT("ACT");
-    if (Namespace == TEXT("component")) return TEXT("CMP");
-    if (Namespace == TEXT("asset")) return TEXT("AST");
-    if (Namespace == TEXT("blueprint")) return TEXT("BPT");
-    if (Namespace == TEXT("material")) return TEXT("MAT");
-    if (Namespace == TEXT("landscape")) return TEXT("LND");
-    if (Namespace == TEXT("foliage")) return TEXT("FOL");
-    if (Namespace == TEXT("pcg")) return TEXT("PCG");
-    if (Namespace == TEXT("ai")) return TEXT("AIN");
-    if (Namespace == TEXT("custom")) return TEXT("CUS");
-    return TEXT("UNK");
+    AEGIS_COMMAND_SCOPE(AegisSeedSubsystem, GetCurrentLevelInfo);
+
+    FString ResultString;
+    TSharedRef<FAegisJsonWriter> Writer = FAegisJsonWriterFactory::Create(&ResultString);
+    WriteCurrentLevelInfo(*Writer);
+    Writer->Close();
+
+    return ResultString;
 }
 
-FString UAegisSeedSubsystem::ComputeSHA256(const FString& Input)
+void UAegisSeedSubsystem::WriteCurrentLevelInfo(FAegisJsonWriter& Writer)
 {
-    FSHAHash Hash;
-    FSHA1::HashBuffer(TCHAR_TO_UTF8(*Input), Input.Len(), Hash.Hash);
+    UWorld* World = GEditor ? GEditor->GetEditorWorldContext().World() : nullptr;
 
-    FString HashString;
-    for (int32 i = 0; i < 20; i++)
+    Writer.WriteObjectStart();
+
+    if (World)
     {
-        HashString += FString::Printf(TEXT("%02x"), Hash.Hash[i]);
+        Writer.WriteValue(TEXT("worldName"), World->GetName());
+        Writer.WriteValue(TEXT("mapName"), World->GetMapName());
+        Writer.WriteValue(TEXT("levelName"), World->GetCurrentLevel()->GetName());
+        Writer.WriteValue(TEXT("projectName"), FApp::GetProjectName());
+        Writer.WriteValue(TEXT("engineVersion"), FEngineVersion::Current().ToString());
     }
 
-    return HashString;
+    Writer.WriteObjectEnd();
 }
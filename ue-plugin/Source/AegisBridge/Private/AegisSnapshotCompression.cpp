@@ -0,0 +1,130 @@
+// Copyright AEGIS Team. All Rights Reserved.
+
+#include "AegisSnapshotCompression.h"
+#include "AegisBridgeModule.h"
+
+namespace
+{
+    /** On-disk container header, followed by the compressed payload */
+    struct FContainerHeader
+    {
+        uint32 Magic = 0;
+        uint32 Version = 0;
+        uint8 Codec = 0;
+        int8 Level = 0;
+        uint8 Padding[6] = {};
+        int64 UncompressedSize = 0;
+        int64 CompressedSize = 0;
+    };
+
+    static_assert(sizeof(FContainerHeader) == 32, "Snapshot container header layout changed");
+}
+
+bool FAegisSnapshotCompression::Compress(const TArray<uint8>& Payload, TArray<uint8>& OutContainer, ECompressor Compressor, ECompressionLevel Level)
+{
+    const int64 UncompressedSize = Payload.Num();
+    const int64 WorstCaseSize = FOodleDataCompression::CompressedBufferSizeNeeded(UncompressedSize);
+
+    OutContainer.SetNumUninitialized(sizeof(FContainerHeader) + WorstCaseSize);
+
+    const int64 CompressedSize = FOodleDataCompression::Compress(
+        OutContainer.GetData() + sizeof(FContainerHeader), WorstCaseSize,
+        Payload.GetData(), UncompressedSize,
+        Compressor, Level);
+
+    if (CompressedSize <= 0)
+    {
+        UE_LOG(LogAegisBridge, Error, TEXT("Oodle compression of %lld bytes failed"), UncompressedSize);
+        OutContainer.Reset();
+        return false;
+    }
+
+    FContainerHeader Header;
+    Header.Magic = Magic;
+    Header.Version = Version;
+    Header.Codec = static_cast<uint8>(Compressor);
+    Header.Level = static_cast<int8>(Level);
+    Header.UncompressedSize = UncompressedSize;
+    Header.CompressedSize = CompressedSize;
+    FMemory::Memcpy(OutContainer.GetData(), &Header, sizeof(FContainerHeader));
+
+    OutContainer.SetNum(sizeof(FContainerHeader) + CompressedSize);
+    return true;
+}
+
+bool FAegisSnapshotCompression::Decompress(const TArray<uint8>& Container, TArray<uint8>& OutPayload)
+{
+    if (!IsCompressed(Container) || Container.Num() < static_cast<int32>(sizeof(FContainerHeader)))
+    {
+        return false;
+    }
+
+    FContainerHeader Header;
+    FMemory::Memcpy(&Header, Container.GetData(), sizeof(FContainerHeader));
+
+    if (Header.Version > Version)
+    {
+        UE_LOG(LogAegisBridge, Error, TEXT("Snapshot container version %u is newer than supported version %u"), Header.Version, Version);
+        return false;
+    }
+
+    if (Header.UncompressedSize < 0 || Header.CompressedSize <= 0 ||
+        Header.CompressedSize > Container.Num() - static_cast<int64>(sizeof(FContainerHeader)) ||
+        Header.UncompressedSize > MAX_int32)
+    {
+        UE_LOG(LogAegisBridge, Error, TEXT("Snapshot container header is corrupt"));
+        return false;
+    }
+
+    OutPayload.SetNumUninitialized(Header.UncompressedSize);
+    if (!FOodleDataCompression::Decompress(
+        OutPayload.GetData(), Header.UncompressedSize,
+        Container.GetData() + sizeof(FContainerHeader), Header.CompressedSize))
+    {
+        UE_LOG(LogAegisBridge, Error, TEXT("Oodle decompression failed"));
+        OutPayload.Reset();
+        return false;
+    }
+
+    return true;
+}
+
+bool FAegisSnapshotCompression::IsCompressed(const TArray<uint8>& Data)
+{
+    return Data.Num() >= static_cast<int32>(sizeof(uint32)) && FMemory::Memcmp(Data.GetData(), &Magic, sizeof(uint32)) == 0;
+}
+
+bool FAegisSnapshotCompression::ParseCompressor(const FString& Name, ECompressor& OutCompressor)
+{
+    if (Name.IsEmpty() || Name.Equals(TEXT("none"), ESearchCase::IgnoreCase))
+    {
+        OutCompressor = ECompressor::NotSet;
+        return true;
+    }
+
+    static const TPair<const TCHAR*, ECompressor> Compressors[] =
+    {
+        { TEXT("kraken"), ECompressor::Kraken },
+        { TEXT("mermaid"), ECompressor::Mermaid },
+        { TEXT("selkie"), ECompressor::Selkie },
+        { TEXT("leviathan"), ECompressor::Leviathan },
+    };
+
+    for (const TPair<const TCHAR*, ECompressor>& Entry : Compressors)
+    {
+        if (Name.Equals(Entry.Key, ESearchCase::IgnoreCase))
+        {
+            OutCompressor = Entry.Value;
+            return true;
+        }
+    }
+
+    return false;
+}
+
+FAegisSnapshotCompression::ECompressionLevel FAegisSnapshotCompression::ToCompressionLevel(int32 Level)
+{
+    return static_cast<ECompressionLevel>(FMath::Clamp(Level,
+        static_cast<int32>(ECompressionLevel::HyperFast4),
+        static_cast<int32>(ECompressionLevel::Optimal4)));
+}
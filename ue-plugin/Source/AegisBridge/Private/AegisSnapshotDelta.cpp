@@ -0,0 +1,449 @@
+// Copyright AEGIS Team. All Rights Reserved.
+
+#include "AegisSnapshotDelta.h"
+#include "Dom/JsonObject.h"
+#include "Serialization/JsonSerializer.h"
+
+namespace
+{
+    bool TagsEqual(const FAegisBinarySnapshot& A, const FAegisSnapshotEntity& EntityA, const FAegisBinarySnapshot& B, const FAegisSnapshotEntity& EntityB)
+    {
+        if (EntityA.Tags.Num() != EntityB.Tags.Num())
+        {
+            return false;
+        }
+        for (int32 Index = 0; Index < EntityA.Tags.Num(); ++Index)
+        {
+            if (A.GetString(EntityA.Tags[Index]) != B.GetString(EntityB.Tags[Index]))
+            {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    bool PropertiesDiffer(const FString& A, const FString& B)
+    {
+        return !A.IsEmpty() && !B.IsEmpty() && A != B;
+    }
+
+    /** Keep the properties an upsert did not capture, so the state does not lose them */
+    void KeepUncapturedProperties(const FAegisSnapshotEntity& Previous, FAegisSnapshotEntity& Entity)
+    {
+        if (Entity.PropertiesJson.IsEmpty())
+        {
+            Entity.PropertiesJson = Previous.PropertiesJson;
+        }
+        if (Entity.Components.Num() == Previous.Components.Num())
+        {
+            for (int32 Index = 0; Index < Entity.Components.Num(); ++Index)
+            {
+                if (Entity.Components[Index].PropertiesJson.IsEmpty())
+                {
+                    Entity.Components[Index].PropertiesJson = Previous.Components[Index].PropertiesJson;
+                }
+            }
+        }
+    }
+}
+
+// ============================================================================
+// Delta
+// ============================================================================
+
+FAegisSnapshotDelta FAegisSnapshotDelta::Compute(const FAegisBinarySnapshot& From, const FAegisBinarySnapshot& To, float Tolerance)
+{
+    FAegisSnapshotDelta Delta;
+
+    TMap<FString, int32> FromIndex;
+    FromIndex.Reserve(From.Entities.Num());
+    for (int32 Index = 0; Index < From.Entities.Num(); ++Index)
+    {
+        FromIndex.Add(From.GetEntityKey(From.Entities[Index]), Index);
+    }
+
+    TBitArray<> Matched(false, From.Entities.Num());
+
+    for (const FAegisSnapshotEntity& ToEntity : To.Entities)
+    {
+        const FString& Key = To.GetEntityKey(ToEntity);
+        if (Key.IsEmpty())
+        {
+            continue;
+        }
+
+        EAegisEntityChange Change = EAegisEntityChange::Added;
+        if (const int32* FromEntityIndex = FromIndex.Find(Key))
+        {
+            Matched[*FromEntityIndex] = true;
+            Change = DiffEntity(From, From.Entities[*FromEntityIndex], To, ToEntity, Tolerance);
+        }
+
+        if (Change != EAegisEntityChange::None)
+        {
+            Delta.Upserts.AddEntityFrom(To, ToEntity);
+            Delta.Changes.Add(Change);
+        }
+    }
+
+    for (int32 Index = 0; Index < From.Entities.Num(); ++Index)
+    {
+        if (!Matched[Index])
+        {
+            Delta.Removed.Add(From.GetEntityKey(From.Entities[Index]));
+        }
+    }
+
+    return Delta;
+}
+
+void FAegisSnapshotDelta::ApplyTo(FAegisBinarySnapshot& State) const
+{
+    TMap<FString, int32> UpsertIndex;
+    UpsertIndex.Reserve(Upserts.Entities.Num());
+    for (int32 Index = 0; Index < Upserts.Entities.Num(); ++Index)
+    {
+        UpsertIndex.Add(Upserts.GetEntityKey(Upserts.Entities[Index]), Index);
+    }
+
+    TSet<FString> RemovedKeys;
+    RemovedKeys.Append(Removed);
+    TBitArray<> Applied(false, Upserts.Entities.Num());
+
+    // Modified entities keep their position; removed ones drop out
+    TArray<FAegisSnapshotEntity> Previous = MoveTemp(State.Entities);
+    State.Entities.Reset();
+    State.Entities.Reserve(Previous.Num() + Upserts.Entities.Num());
+
+    for (FAegisSnapshotEntity& Entity : Previous)
+    {
+        const FString& Key = State.GetEntityKey(Entity);
+        if (RemovedKeys.Contains(Key))
+        {
+            continue;
+        }
+
+        if (const int32* Upsert = UpsertIndex.Find(Key))
+        {
+            KeepUncapturedProperties(Entity, State.AddEntityFrom(Upserts, Upserts.Entities[*Upsert]));
+            Applied[*Upsert] = true;
+        }
+        else
+        {
+            State.Entities.Add(MoveTemp(Entity));
+        }
+    }
+
+    for (int32 Index = 0; Index < Upserts.Entities.Num(); ++Index)
+    {
+        if (!Applied[Index])
+        {
+            State.AddEntityFrom(Upserts, Upserts.Entities[Index]);
+        }
+    }
+}
+
+EAegisEntityChange FAegisSnapshotDelta::DiffEntity(const FAegisBinarySnapshot& A, const FAegisSnapshotEntity& EntityA, const FAegisBinarySnapshot& B, const FAegisSnapshotEntity& EntityB, float Tolerance)
+{
+    EAegisEntityChange Change = EAegisEntityChange::None;
+
+    if (EntityA.bHasTransform != EntityB.bHasTransform ||
+        !EntityA.Location.Equals(EntityB.Location, Tolerance) ||
+        !EntityA.Rotation.Equals(EntityB.Rotation, Tolerance) ||
+        !EntityA.Scale.Equals(EntityB.Scale, Tolerance))
+    {
+        Change |= EAegisEntityChange::Transform;
+    }
+
+    // Live captures may carry no properties at all, so only compare them when both sides have some
+    bool bPropertiesChanged = PropertiesDiffer(EntityA.PropertiesJson, EntityB.PropertiesJson);
+
+    bool bStructureChanged =
+        A.GetString(EntityA.Class) != B.GetString(EntityB.Class) ||
+        A.GetString(EntityA.Name) != B.GetString(EntityB.Name) ||
+        A.GetString(EntityA.ParentGUID) != B.GetString(EntityB.ParentGUID) ||
+        !TagsEqual(A, EntityA, B, EntityB) ||
+        EntityA.Components.Num() != EntityB.Components.Num() ||
+        EntityA.References.Num() != EntityB.References.Num();
+
+    for (int32 Index = 0; !bStructureChanged && Index < EntityA.Components.Num(); ++Index)
+    {
+        const FAegisSnapshotComponent& CompA = EntityA.Components[Index];
+        const FAegisSnapshotComponent& CompB = EntityB.Components[Index];
+        // Live captures carry no component GUIDs, so only compare them when both sides have one
+        const bool bCompareGUIDs = CompA.GUID != INDEX_NONE && CompB.GUID != INDEX_NONE;
+        bStructureChanged =
+            (bCompareGUIDs && A.GetString(CompA.GUID) != B.GetString(CompB.GUID)) ||
+            A.GetString(CompA.Class) != B.GetString(CompB.Class) ||
+            A.GetString(CompA.Name) != B.GetString(CompB.Name);
+        bPropertiesChanged |= PropertiesDiffer(CompA.PropertiesJson, CompB.PropertiesJson);
+    }
+
+    for (int32 Index = 0; !bStructureChanged && Index < EntityA.References.Num(); ++Index)
+    {
+        const FAegisSnapshotReference& RefA = EntityA.References[Index];
+        const FAegisSnapshotReference& RefB = EntityB.References[Index];
+        bStructureChanged =
+            A.GetString(RefA.PropertyName) != B.GetString(RefB.PropertyName) ||
+            A.GetString(RefA.TargetGUID) != B.GetString(RefB.TargetGUID) ||
+            A.GetString(RefA.TargetPath) != B.GetString(RefB.TargetPath);
+    }
+
+    if (bPropertiesChanged)
+    {
+        Change |= EAegisEntityChange::Properties;
+    }
+    if (bStructureChanged)
+    {
+        Change |= EAegisEntityChange::Structure;
+    }
+
+    return Change;
+}
+
+void FAegisSnapshotDelta::WriteChangeNames(FAegisJsonWriter& Writer, const TCHAR* Identifier, EAegisEntityChange Change)
+{
+    Writer.WriteArrayStart(Identifier);
+    if (EnumHasAnyFlags(Change, EAegisEntityChange::Added)) Writer.WriteValue(TEXT("added"));
+    if (EnumHasAnyFlags(Change, EAegisEntityChange::Removed)) Writer.WriteValue(TEXT("removed"));
+    if (EnumHasAnyFlags(Change, EAegisEntityChange::Transform)) Writer.WriteValue(TEXT("transform"));
+    if (EnumHasAnyFlags(Change, EAegisEntityChange::Properties)) Writer.WriteValue(TEXT("properties"));
+    if (EnumHasAnyFlags(Change, EAegisEntityChange::Structure)) Writer.WriteValue(TEXT("structure"));
+    Writer.WriteArrayEnd();
+}
+
+int32 FAegisSnapshotDelta::CountChanges(EAegisEntityChange Change) const
+{
+    if (Change == EAegisEntityChange::Removed)
+    {
+        return Removed.Num();
+    }
+
+    int32 Count = 0;
+    for (EAegisEntityChange Entry : Changes)
+    {
+        Count += EnumHasAnyFlags(Entry, Change) ? 1 : 0;
+    }
+    return Count;
+}
+
+void FAegisSnapshotDelta::WriteJson(FAegisJsonWriter& Writer) const
+{
+    Writer.WriteObjectStart();
+    Writer.WriteValue(TEXT("deltaId"), DeltaId);
+    Writer.WriteValue(TEXT("baseSnapshotId"), BaseSnapshotId);
+    Writer.WriteValue(TEXT("parentDeltaId"), ParentDeltaId);
+
+    Writer.WriteObjectStart(TEXT("summary"));
+    Writer.WriteValue(TEXT("total"), Num());
+    Writer.WriteValue(TEXT("added"), CountChanges(EAegisEntityChange::Added));
+    Writer.WriteValue(TEXT("removed"), CountChanges(EAegisEntityChange::Removed));
+    Writer.WriteValue(TEXT("transformChanged"), CountChanges(EAegisEntityChange::Transform));
+    Writer.WriteValue(TEXT("propertyChanged"), CountChanges(EAegisEntityChange::Properties));
+    Writer.WriteValue(TEXT("structureChanged"), CountChanges(EAegisEntityChange::Structure));
+    Writer.WriteObjectEnd();
+
+    Writer.WriteArrayStart(TEXT("records"));
+    for (int32 Index = 0; Index < Upserts.Entities.Num(); ++Index)
+    {
+        const FAegisSnapshotEntity& Entity = Upserts.Entities[Index];
+        Writer.WriteObjectStart();
+        Writer.WriteValue(TEXT("guid"), Upserts.GetEntityKey(Entity));
+        WriteChangeNames(Writer, TEXT("changes"), Changes[Index]);
+        Writer.WriteIdentifierPrefix(TEXT("entity"));
+        Upserts.WriteEntityJson(Writer, Entity);
+        Writer.WriteObjectEnd();
+    }
+    for (const FString& Key : Removed)
+    {
+        Writer.WriteObjectStart();
+        Writer.WriteValue(TEXT("guid"), Key);
+        WriteChangeNames(Writer, TEXT("changes"), EAegisEntityChange::Removed);
+        Writer.WriteObjectEnd();
+    }
+    Writer.WriteArrayEnd();
+
+    Writer.WriteObjectEnd();
+}
+
+FString FAegisSnapshotDelta::ToJson() const
+{
+    FString Json;
+    TSharedRef<FAegisJsonWriter> Writer = FAegisJsonWriterFactory::Create(&Json);
+    WriteJson(*Writer);
+    Writer->Close();
+    return Json;
+}
+
+bool FAegisSnapshotDelta::FromJson(FStringView Json)
+{
+    TSharedPtr<FJsonObject> DeltaObject;
+    TSharedRef<TJsonReader<TCHAR>> Reader = TJsonReaderFactory<TCHAR>::CreateFromView(Json);
+    if (!FJsonSerializer::Deserialize(Reader, DeltaObject) || !DeltaObject.IsValid())
+    {
+        return false;
+    }
+
+    DeltaObject->TryGetStringField(TEXT("deltaId"), DeltaId);
+    DeltaObject->TryGetStringField(TEXT("baseSnapshotId"), BaseSnapshotId);
+    DeltaObject->TryGetStringField(TEXT("parentDeltaId"), ParentDeltaId);
+
+    const TArray<TSharedPtr<FJsonValue>>* Records = nullptr;
+    if (!DeltaObject->TryGetArrayField(TEXT("records"), Records))
+    {
+        return false;
+    }
+
+    for (const TSharedPtr<FJsonValue>& RecordValue : *Records)
+    {
+        const TSharedPtr<FJsonObject>* Record = nullptr;
+        if (!RecordValue.IsValid() || !RecordValue->TryGetObject(Record))
+        {
+            continue;
+        }
+
+        EAegisEntityChange Change = EAegisEntityChange::None;
+        TArray<FString> ChangeNames;
+        (*Record)->TryGetStringArrayField(TEXT("changes"), ChangeNames);
+        for (const FString& ChangeName : ChangeNames)
+        {
+            if (ChangeName == TEXT("added")) Change |= EAegisEntityChange::Added;
+            else if (ChangeName == TEXT("removed")) Change |= EAegisEntityChange::Removed;
+            else if (ChangeName == TEXT("transform")) Change |= EAegisEntityChange::Transform;
+            else if (ChangeName == TEXT("properties")) Change |= EAegisEntityChange::Properties;
+            else if (ChangeName == TEXT("structure")) Change |= EAegisEntityChange::Structure;
+        }
+
+        if (EnumHasAnyFlags(Change, EAegisEntityChange::Removed))
+        {
+            Removed.Add((*Record)->GetStringField(TEXT("guid")));
+            continue;
+        }
+
+        const TSharedPtr<FJsonObject>* Entity = nullptr;
+        if ((*Record)->TryGetObjectField(TEXT("entity"), Entity))
+        {
+            Upserts.AddEntityFromJson(**Entity);
+            Changes.Add(Change);
+        }
+    }
+
+    return true;
+}
+
+void FAegisSnapshotDelta::WriteChangeList(FAegisJsonWriter& Writer, const TCHAR* Identifier) const
+{
+    Writer.WriteArrayStart(Identifier);
+    for (int32 Index = 0; Index < Upserts.Entities.Num(); ++Index)
+    {
+        Writer.WriteObjectStart();
+        Writer.WriteValue(TEXT("guid"), Upserts.GetEntityKey(Upserts.Entities[Index]));
+        WriteChangeNames(Writer, TEXT("fields"), Changes[Index]);
+        Writer.WriteObjectEnd();
+    }
+    for (const FString& Key : Removed)
+    {
+        Writer.WriteObjectStart();
+        Writer.WriteValue(TEXT("guid"), Key);
+        WriteChangeNames(Writer, TEXT("fields"), EAegisEntityChange::Removed);
+        Writer.WriteObjectEnd();
+    }
+    Writer.WriteArrayEnd();
+}
+
+bool FAegisSnapshotDelta::FromDiffJson(const FString& Json)
+{
+    TArray<TSharedPtr<FJsonValue>> DiffValues;
+    TSharedRef<TJsonReader<>> Reader = TJsonReaderFactory<>::Create(Json);
+    if (!FJsonSerializer::Deserialize(Reader, DiffValues))
+    {
+        return false;
+    }
+
+    for (const TSharedPtr<FJsonValue>& DiffValue : DiffValues)
+    {
+        const TSharedPtr<FJsonObject>* Diff = nullptr;
+        if (!DiffValue.IsValid() || !DiffValue->TryGetObject(Diff))
+        {
+            continue;
+        }
+
+        const FString ChangeType = (*Diff)->GetStringField(TEXT("changeType"));
+        if (ChangeType == TEXT("removed"))
+        {
+            Removed.Add((*Diff)->GetStringField(TEXT("guid")));
+            continue;
+        }
+
+        const TSharedPtr<FJsonObject>* TargetEntity = nullptr;
+        if ((ChangeType != TEXT("added") && ChangeType != TEXT("modified")) ||
+            !(*Diff)->TryGetObjectField(TEXT("targetEntity"), TargetEntity))
+        {
+            continue;
+        }
+
+        EAegisEntityChange Change = EAegisEntityChange::Added;
+        if (ChangeType == TEXT("modified"))
+        {
+            const TArray<TSharedPtr<FJsonValue>>* Records = nullptr;
+            Change = EAegisEntityChange::None;
+            if ((*Diff)->HasTypedField<EJson::Object>(TEXT("transformChanges")))
+            {
+                Change |= EAegisEntityChange::Transform;
+            }
+            if ((*Diff)->TryGetArrayField(TEXT("propertyChanges"), Records) && Records->Num() > 0)
+            {
+                Change |= EAegisEntityChange::Properties;
+            }
+            if (((*Diff)->TryGetArrayField(TEXT("componentChanges"), Records) && Records->Num() > 0) ||
+                ((*Diff)->TryGetArrayField(TEXT("referenceChanges"), Records) && Records->Num() > 0))
+            {
+                Change |= EAegisEntityChange::Structure;
+            }
+            if (Change == EAegisEntityChange::None)
+            {
+                // Modified without details: treat the whole entity as changed
+                Change = EAegisEntityChange::Transform | EAegisEntityChange::Properties;
+            }
+        }
+
+        Upserts.AddEntityFromJson(**TargetEntity);
+        Changes.Add(Change);
+    }
+
+    return true;
+}
+
+// ============================================================================
+// Chain
+// ============================================================================
+
+const FAegisSnapshotDelta* FAegisDeltaChain::FindDelta(const FString& DeltaId) const
+{
+    return Deltas.FindByPredicate([&DeltaId](const FAegisSnapshotDelta& Delta)
+    {
+        return Delta.DeltaId == DeltaId;
+    });
+}
+
+void FAegisDeltaChain::Compact()
+{
+    FAegisBinarySnapshot Compacted;
+    Compacted.Id = Head.Id;
+    Compacted.Name = Head.Name;
+    Compacted.Description = Head.Description;
+    Compacted.Timestamp = Head.Timestamp;
+    Compacted.Seed = Head.Seed;
+    Compacted.Checksum = Head.Checksum;
+    Compacted.Targets = Head.Targets;
+    Compacted.MetadataJson = Head.MetadataJson;
+
+    Compacted.Entities.Reserve(Head.Entities.Num());
+    for (const FAegisSnapshotEntity& Entity : Head.Entities)
+    {
+        Compacted.AddEntityFrom(Head, Entity);
+    }
+
+    Head = MoveTemp(Compacted);
+    Deltas.Empty();
+}
@@ -0,0 +1,258 @@
+// Copyright AEGIS Team. All Rights Reserved.
+
+#include "AegisSnapshotMerge.h"
+#include "Async/ParallelFor.h"
+
+namespace
+{
+    /** Outcome for one entity, filled on a worker thread */
+    struct FMergeDecision
+    {
+        /** Entity in theirs, or in base when removing */
+        int32 EntityIndex = INDEX_NONE;
+        EAegisEntityChange Apply = EAegisEntityChange::None;
+        bool bRemove = false;
+
+        bool bConflict = false;
+        EAegisMergeConflictKind Kind = EAegisMergeConflictKind::Modified;
+        EAegisEntityChange ConflictFields = EAegisEntityChange::None;
+    };
+
+    TMap<FString, int32> BuildKeyIndex(const FAegisBinarySnapshot& Snapshot)
+    {
+        TMap<FString, int32> Index;
+        Index.Reserve(Snapshot.Entities.Num());
+        for (int32 EntityIndex = 0; EntityIndex < Snapshot.Entities.Num(); ++EntityIndex)
+        {
+            const FString& Key = Snapshot.GetEntityKey(Snapshot.Entities[EntityIndex]);
+            if (!Key.IsEmpty())
+            {
+                Index.Add(Key, EntityIndex);
+            }
+        }
+        return Index;
+    }
+
+    const TCHAR* GetKindName(EAegisMergeConflictKind Kind)
+    {
+        switch (Kind)
+        {
+        case EAegisMergeConflictKind::Added: return TEXT("added_both");
+        case EAegisMergeConflictKind::RemovedOurs: return TEXT("removed_ours");
+        case EAegisMergeConflictKind::RemovedTheirs: return TEXT("removed_theirs");
+        default: return TEXT("modified_both");
+        }
+    }
+}
+
+void FAegisSnapshotMerge::Merge(const FAegisBinarySnapshot& Base, const FAegisBinarySnapshot& Ours, const FAegisBinarySnapshot& Theirs,
+    const FAegisMergeOptions& Options, FAegisSnapshotDelta& OutDelta, TArray<FAegisMergeConflict>& OutConflicts)
+{
+    // The three joins are independent
+    TMap<FString, int32> KeyIndices[3];
+    const FAegisBinarySnapshot* Sides[3] = { &Base, &Ours, &Theirs };
+    ParallelFor(3, [&KeyIndices, &Sides](int32 Side)
+    {
+        KeyIndices[Side] = BuildKeyIndex(*Sides[Side]);
+    });
+    const TMap<FString, int32>& BaseIndex = KeyIndices[0];
+    const TMap<FString, int32>& OursIndex = KeyIndices[1];
+    const TMap<FString, int32>& TheirsIndex = KeyIndices[2];
+
+    const EAegisEntityChange Fields = Options.Fields;
+    const float Tolerance = Options.Tolerance;
+
+    // Theirs' entities first, then base entities theirs removed
+    const int32 TheirsCount = Theirs.Entities.Num();
+    TArray<FMergeDecision> Decisions;
+    Decisions.SetNum(TheirsCount + Base.Entities.Num());
+
+    ParallelFor(Decisions.Num(), [&](int32 Item)
+    {
+        FMergeDecision& Decision = Decisions[Item];
+
+        const bool bTheirsItem = Item < TheirsCount;
+        const FAegisSnapshotEntity& Entity = bTheirsItem ? Theirs.Entities[Item] : Base.Entities[Item - TheirsCount];
+        const FString& Key = bTheirsItem ? Theirs.GetEntityKey(Entity) : Base.GetEntityKey(Entity);
+        if (Key.IsEmpty() || (Options.OnlyKeys.Num() > 0 && !Options.OnlyKeys.Contains(Key)))
+        {
+            return;
+        }
+
+        const int32* BaseEntity = bTheirsItem ? BaseIndex.Find(Key) : nullptr;
+        const int32* OursEntity = OursIndex.Find(Key);
+
+        if (!bTheirsItem)
+        {
+            // Removed by theirs, unless theirs still holds it
+            if (TheirsIndex.Contains(Key) || !OursEntity)
+            {
+                return;
+            }
+
+            const EAegisEntityChange OursChange = FAegisSnapshotDelta::DiffEntity(Base, Entity, Ours, Ours.Entities[*OursEntity], Tolerance);
+            Decision.EntityIndex = Item - TheirsCount;
+            Decision.bRemove = true;
+            if (OursChange != EAegisEntityChange::None)
+            {
+                Decision.bConflict = true;
+                Decision.Kind = EAegisMergeConflictKind::RemovedTheirs;
+                Decision.ConflictFields = OursChange;
+            }
+            return;
+        }
+
+        Decision.EntityIndex = Item;
+
+        if (!BaseEntity)
+        {
+            if (!OursEntity)
+            {
+                Decision.Apply = EAegisEntityChange::Added;
+                return;
+            }
+
+            // Added on both sides
+            const EAegisEntityChange Divergent = FAegisSnapshotDelta::DiffEntity(Ours, Ours.Entities[*OursEntity], Theirs, Entity, Tolerance) & Fields;
+            if (Divergent != EAegisEntityChange::None)
+            {
+                Decision.Apply = Divergent;
+                Decision.bConflict = true;
+                Decision.Kind = EAegisMergeConflictKind::Added;
+                Decision.ConflictFields = Divergent;
+            }
+            return;
+        }
+
+        const EAegisEntityChange TheirsChange = FAegisSnapshotDelta::DiffEntity(Base, Base.Entities[*BaseEntity], Theirs, Entity, Tolerance) & Fields;
+        if (TheirsChange == EAegisEntityChange::None)
+        {
+            return;
+        }
+
+        if (!OursEntity)
+        {
+            // Theirs changed what ours removed; taking theirs brings it back
+            Decision.Apply = EAegisEntityChange::Added;
+            Decision.bConflict = true;
+            Decision.Kind = EAegisMergeConflictKind::RemovedOurs;
+            Decision.ConflictFields = TheirsChange;
+            return;
+        }
+
+        const FAegisSnapshotEntity& Current = Ours.Entities[*OursEntity];
+
+        // Fields where ours already matches theirs need nothing, whoever changed them
+        const EAegisEntityChange Remaining = FAegisSnapshotDelta::DiffEntity(Ours, Current, Theirs, Entity, Tolerance) & TheirsChange;
+        if (Remaining == EAegisEntityChange::None)
+        {
+            return;
+        }
+
+        const EAegisEntityChange OursChange = FAegisSnapshotDelta::DiffEntity(Base, Base.Entities[*BaseEntity], Ours, Current, Tolerance);
+        Decision.Apply = Remaining;
+        Decision.ConflictFields = Remaining & OursChange;
+        Decision.bConflict = Decision.ConflictFields != EAegisEntityChange::None;
+    });
+
+    for (FMergeDecision& Decision : Decisions)
+    {
+        if (Decision.Apply == EAegisEntityChange::None && !Decision.bRemove)
+        {
+            continue;
+        }
+
+        const FAegisBinarySnapshot& Side = Decision.bRemove ? Base : Theirs;
+        const FAegisSnapshotEntity& Entity = Side.Entities[Decision.EntityIndex];
+        const FString& Key = Side.GetEntityKey(Entity);
+
+        if (Decision.bConflict)
+        {
+            bool bTheirsWins = Options.Resolution == EAegisMergeResolution::Theirs;
+            if (Options.Resolution == EAegisMergeResolution::Newest)
+            {
+                const FAegisSnapshotEntity* Current = nullptr;
+                if (const int32* OursEntity = OursIndex.Find(Key))
+                {
+                    Current = &Ours.Entities[*OursEntity];
+                }
+
+                // Ours' removals leave no path behind; they date from the default time
+                const FDateTime* OursTime = Current ? Options.OursTimes.Find(Ours.GetString(Current->Path)) : nullptr;
+                bTheirsWins = Options.TheirsTime >= (OursTime ? *OursTime : Options.OursDefaultTime);
+            }
+
+            FAegisMergeConflict& Conflict = OutConflicts.AddDefaulted_GetRef();
+            Conflict.Key = Key;
+            Conflict.Kind = Decision.Kind;
+            Conflict.Fields = Decision.ConflictFields;
+            Conflict.bTheirsApplied = bTheirsWins;
+
+            if (!bTheirsWins)
+            {
+                // Theirs' uncontested fields still go through
+                if (Decision.Kind != EAegisMergeConflictKind::Modified)
+                {
+                    continue;
+                }
+                Decision.Apply &= ~Decision.ConflictFields;
+                if (Decision.Apply == EAegisEntityChange::None)
+                {
+                    continue;
+                }
+            }
+        }
+
+        if (Decision.bRemove)
+        {
+            OutDelta.Removed.Add(Key);
+        }
+        else
+        {
+            OutDelta.Upserts.AddEntityFrom(Theirs, Entity);
+            OutDelta.Changes.Add(Decision.Apply);
+        }
+    }
+}
+
+bool FAegisSnapshotMerge::ParseResolution(const FString& Name, bool bSourceIsTheirs, EAegisMergeResolution& OutResolution)
+{
+    if (Name.IsEmpty() || Name == TEXT("manual"))
+    {
+        OutResolution = EAegisMergeResolution::Manual;
+    }
+    else if (Name == TEXT("newest"))
+    {
+        OutResolution = EAegisMergeResolution::Newest;
+    }
+    else if (Name == TEXT("source"))
+    {
+        OutResolution = bSourceIsTheirs ? EAegisMergeResolution::Theirs : EAegisMergeResolution::Ours;
+    }
+    else if (Name == TEXT("target"))
+    {
+        OutResolution = bSourceIsTheirs ? EAegisMergeResolution::Ours : EAegisMergeResolution::Theirs;
+    }
+    else
+    {
+        return false;
+    }
+    return true;
+}
+
+void FAegisSnapshotMerge::WriteConflicts(FAegisJsonWriter& Writer, TConstArrayView<FAegisMergeConflict> Conflicts, EAegisMergeResolution Resolution)
+{
+    Writer.WriteArrayStart(TEXT("conflicts"));
+    for (const FAegisMergeConflict& Conflict : Conflicts)
+    {
+        Writer.WriteObjectStart();
+        Writer.WriteValue(TEXT("guid"), Conflict.Key);
+        Writer.WriteValue(TEXT("kind"), GetKindName(Conflict.Kind));
+        FAegisSnapshotDelta::WriteChangeNames(Writer, TEXT("fields"), Conflict.Fields);
+        Writer.WriteValue(TEXT("resolution"),
+            Resolution == EAegisMergeResolution::Manual ? TEXT("manual") :
+            Conflict.bTheirsApplied ? TEXT("theirs") : TEXT("ours"));
+        Writer.WriteObjectEnd();
+    }
+    Writer.WriteArrayEnd();
+}
@@ -0,0 +1,438 @@
+// Copyright AEGIS Team. All Rights Reserved.
+
+#include "AegisSnapshotStore.h"
+#include "AegisBridgeModule.h"
+#include "AegisJsonWriter.h"
+#include "Async/MappedFileHandle.h"
+#include "Dom/JsonObject.h"
+#include "HAL/FileManager.h"
+#include "HAL/PlatformFileManager.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include "Serialization/JsonSerializer.h"
+
+namespace
+{
+    /** Index file format version. 2 added per-payload character sizes. */
+    constexpr int32 IndexVersion = 2;
+
+    const TCHAR* IndexFileName = TEXT("Index.json");
+
+    /**
+     * Payload file name of a snapshot id. Characters outside [A-Za-z0-9._-] are escaped as
+     * %XXXX, so the mapping is reversible and distinct ids never share a file.
+     */
+    FString MakePayloadFileName(const FString& SnapshotId)
+    {
+        // An id spelling the index name gets its first character escaped as well
+        const bool bReserved = SnapshotId + TEXT(".json") == IndexFileName;
+
+        FString FileName;
+        FileName.Reserve(SnapshotId.Len() + 5);
+        for (int32 Index = 0; Index < SnapshotId.Len(); ++Index)
+        {
+            const TCHAR Char = SnapshotId[Index];
+            const bool bSafe = (Char >= TEXT('a') && Char <= TEXT('z')) || (Char >= TEXT('A') && Char <= TEXT('Z')) ||
+                (Char >= TEXT('0') && Char <= TEXT('9')) || Char == TEXT('.') || Char == TEXT('_') || Char == TEXT('-');
+
+            if (bSafe && !(bReserved && Index == 0))
+            {
+                FileName.AppendChar(Char);
+            }
+            else
+            {
+                FileName.Appendf(TEXT("%%%04X"), static_cast<uint32>(Char));
+            }
+        }
+        FileName += TEXT(".json");
+        return FileName;
+    }
+}
+
+FAegisSnapshotStore::FAegisSnapshotStore() = default;
+
+FAegisSnapshotStore::~FAegisSnapshotStore()
+{
+    Shutdown();
+}
+
+void FAegisSnapshotStore::Initialize(const FString& InRootDir, int64 InMaxResidentBytes)
+{
+    Shutdown();
+
+    RootDir = InRootDir;
+    MaxResidentBytes = InMaxResidentBytes;
+
+    IFileManager::Get().MakeDirectory(*RootDir, true);
+    LoadIndex();
+
+    UE_LOG(LogAegisBridge, Log, TEXT("Snapshot store opened at %s (%d snapshots)"), *RootDir, Records.Num());
+}
+
+void FAegisSnapshotStore::Shutdown()
+{
+    // Regions must be released before their handles
+    for (auto& Pair : Resident)
+    {
+        Pair.Value.Region.Reset();
+        Pair.Value.Handle.Reset();
+    }
+    Resident.Empty();
+    ResidentBytes = 0;
+}
+
+bool FAegisSnapshotStore::Store(const FString& SnapshotId, const FString& SnapshotData, const FAegisSnapshotRecord& Metadata)
+{
+    if (RootDir.IsEmpty() || SnapshotId.IsEmpty())
+    {
+        return false;
+    }
+
+    // An open mapping would keep the old file locked on some platforms
+    Unmap(SnapshotId);
+
+    FAegisSnapshotRecord Record = Metadata;
+    Record.SnapshotId = SnapshotId;
+    Record.FileName = MakePayloadFileName(SnapshotId);
+    Record.CharSize = sizeof(TCHAR);
+    if (Record.Timestamp.GetTicks() == 0)
+    {
+        Record.Timestamp = FDateTime::UtcNow();
+    }
+
+    // Written as the string's own characters, so a load can view the mapping as text
+    const FString PayloadPath = GetPayloadPath(Record);
+    const TArrayView<const uint8> PayloadBytes(reinterpret_cast<const uint8*>(*SnapshotData), SnapshotData.Len() * sizeof(TCHAR));
+    if (!FFileHelper::SaveArrayToFile(PayloadBytes, *PayloadPath))
+    {
+        UE_LOG(LogAegisBridge, Error, TEXT("Failed to write snapshot payload: %s"), *PayloadPath);
+        return false;
+    }
+    Record.Size = IFileManager::Get().FileSize(*PayloadPath);
+
+    // Records indexed before ids were escaped may still point at an old, possibly shared, file name
+    const FAegisSnapshotRecord* Existing = Records.Find(SnapshotId);
+    if (Existing && Existing->FileName != Record.FileName)
+    {
+        const FString OldFileName = Existing->FileName;
+        bool bShared = false;
+        for (const TPair<FString, FAegisSnapshotRecord>& Pair : Records)
+        {
+            bShared |= Pair.Key != SnapshotId && Pair.Value.FileName == OldFileName;
+        }
+        if (!bShared)
+        {
+            IFileManager::Get().Delete(*GetPayloadPath(*Existing), false, true, true);
+        }
+    }
+
+    Records.Add(SnapshotId, MoveTemp(Record));
+    return SaveIndex();
+}
+
+FStringView FAegisSnapshotStore::LoadText(const FString& SnapshotId)
+{
+    const FAegisSnapshotRecord* Record = Records.Find(SnapshotId);
+    if (!Record)
+    {
+        return FStringView();
+    }
+
+    if (Record->CharSize != sizeof(TCHAR))
+    {
+        // Payloads from before index version 2 are UTF-8; convert them once
+        const TConstArrayView<uint8> Legacy = LoadView(SnapshotId);
+        if (Legacy.Num() == 0)
+        {
+            return FStringView();
+        }
+
+        FString Data;
+        FFileHelper::BufferToString(Data, Legacy.GetData(), Legacy.Num());
+        const FAegisSnapshotRecord Metadata = *Record;
+        if (!Store(SnapshotId, Data, Metadata))
+        {
+            return FStringView();
+        }
+    }
+
+    const TConstArrayView<uint8> Payload = LoadView(SnapshotId);
+    return FStringView(reinterpret_cast<const TCHAR*>(Payload.GetData()), Payload.Num() / sizeof(TCHAR));
+}
+
+bool FAegisSnapshotStore::Load(const FString& SnapshotId, FString& OutData)
+{
+    const FStringView Text = LoadText(SnapshotId);
+    if (Text.IsEmpty())
+    {
+        return false;
+    }
+
+    OutData = FString(Text);
+    return true;
+}
+
+TConstArrayView<uint8> FAegisSnapshotStore::LoadView(const FString& SnapshotId)
+{
+    const FResidentPayload* Payload = MapPayload(SnapshotId);
+    if (!Payload)
+    {
+        return TConstArrayView<uint8>();
+    }
+
+    return TConstArrayView<uint8>(Payload->Region->GetMappedPtr(), Payload->Region->GetMappedSize());
+}
+
+bool FAegisSnapshotStore::Remove(const FString& SnapshotId)
+{
+    return Remove(MakeArrayView(&SnapshotId, 1)) > 0;
+}
+
+int32 FAegisSnapshotStore::Remove(TConstArrayView<FString> SnapshotIds)
+{
+    int32 Removed = 0;
+    for (const FString& SnapshotId : SnapshotIds)
+    {
+        FAegisSnapshotRecord Record;
+        if (Records.RemoveAndCopyValue(SnapshotId, Record))
+        {
+            Unmap(SnapshotId);
+            IFileManager::Get().Delete(*GetPayloadPath(Record), false, true, true);
+            ++Removed;
+        }
+    }
+
+    // The index is rewritten once for the whole batch
+    if (Removed > 0)
+    {
+        SaveIndex();
+    }
+    return Removed;
+}
+
+void FAegisSnapshotStore::List(TArray<FAegisSnapshotRecord>& OutRecords) const
+{
+    OutRecords.Reset(Records.Num());
+    for (const TPair<FString, FAegisSnapshotRecord>& Pair : Records)
+    {
+        if (Pair.Value.BaseSnapshotId.IsEmpty())
+        {
+            OutRecords.Add(Pair.Value);
+        }
+    }
+}
+
+void FAegisSnapshotStore::ListDeltas(const FString& BaseSnapshotId, TArray<FString>& OutSnapshotIds) const
+{
+    OutSnapshotIds.Reset();
+    for (const TPair<FString, FAegisSnapshotRecord>& Pair : Records)
+    {
+        if (!BaseSnapshotId.IsEmpty() && Pair.Value.BaseSnapshotId == BaseSnapshotId)
+        {
+            OutSnapshotIds.Add(Pair.Key);
+        }
+    }
+}
+
+void FAegisSnapshotStore::ListDeltaBases(TArray<FString>& OutBaseSnapshotIds) const
+{
+    OutBaseSnapshotIds.Reset();
+    for (const TPair<FString, FAegisSnapshotRecord>& Pair : Records)
+    {
+        if (!Pair.Value.BaseSnapshotId.IsEmpty())
+        {
+            OutBaseSnapshotIds.AddUnique(Pair.Value.BaseSnapshotId);
+        }
+    }
+}
+
+// ============================================================================
+// Residency
+// ============================================================================
+
+const FAegisSnapshotStore::FResidentPayload* FAegisSnapshotStore::MapPayload(const FString& SnapshotId)
+{
+    if (FResidentPayload* Existing = Resident.Find(SnapshotId))
+    {
+        Existing->LastUse = ++UseClock;
+        return Existing;
+    }
+
+    const FAegisSnapshotRecord* Record = Records.Find(SnapshotId);
+    if (!Record || Record->Size <= 0)
+    {
+        return nullptr;
+    }
+
+    const FString PayloadPath = GetPayloadPath(*Record);
+
+    FResidentPayload Payload;
+    Payload.Handle.Reset(FPlatformFileManager::Get().GetPlatformFile().OpenMapped(*PayloadPath));
+    if (Payload.Handle)
+    {
+        Payload.Region.Reset(Payload.Handle->MapRegion(0, Payload.Handle->GetFileSize()));
+    }
+
+    if (!Payload.Region)
+    {
+        UE_LOG(LogAegisBridge, Error, TEXT("Failed to map snapshot payload: %s"), *PayloadPath);
+        return nullptr;
+    }
+
+    ResidentBytes += Payload.Region->GetMappedSize();
+    Payload.LastUse = ++UseClock;
+    Resident.Add(SnapshotId, MoveTemp(Payload));
+
+    // The payload just mapped is most recent, so it is never the one evicted
+    EnforceBudget();
+
+    return Resident.Find(SnapshotId);
+}
+
+void FAegisSnapshotStore::Unmap(const FString& SnapshotId)
+{
+    if (FResidentPayload* Payload = Resident.Find(SnapshotId))
+    {
+        ResidentBytes -= Payload->Region->GetMappedSize();
+        Payload->Region.Reset();
+        Payload->Handle.Reset();
+        Resident.Remove(SnapshotId);
+    }
+}
+
+void FAegisSnapshotStore::EnforceBudget()
+{
+    // Touches are O(1); the scan for the oldest payload only runs when the budget is exceeded
+    while (ResidentBytes > MaxResidentBytes && Resident.Num() > 1)
+    {
+        const FString* Oldest = nullptr;
+        uint64 OldestUse = MAX_uint64;
+        for (const TPair<FString, FResidentPayload>& Pair : Resident)
+        {
+            if (Pair.Value.LastUse < OldestUse)
+            {
+                OldestUse = Pair.Value.LastUse;
+                Oldest = &Pair.Key;
+            }
+        }
+
+        const FString OldestId = *Oldest;
+        Unmap(OldestId);
+    }
+}
+
+// ============================================================================
+// Index
+// ============================================================================
+
+FString FAegisSnapshotStore::GetIndexPath() const
+{
+    return FPaths::Combine(RootDir, IndexFileName);
+}
+
+FString FAegisSnapshotStore::GetPayloadPath(const FAegisSnapshotRecord& Record) const
+{
+    return FPaths::Combine(RootDir, Record.FileName);
+}
+
+void FAegisSnapshotStore::LoadIndex()
+{
+    Records.Empty();
+
+    FString IndexString;
+    if (!FFileHelper::LoadFileToString(IndexString, *GetIndexPath()))
+    {
+        return;
+    }
+
+    TSharedPtr<FJsonObject> IndexObj;
+    TSharedRef<TJsonReader<>> Reader = TJsonReaderFactory<>::Create(IndexString);
+    if (!FJsonSerializer::Deserialize(Reader, IndexObj) || !IndexObj.IsValid())
+    {
+        UE_LOG(LogAegisBridge, Warning, TEXT("Snapshot index is corrupt, starting empty: %s"), *GetIndexPath());
+        return;
+    }
+
+    if (IndexObj->GetIntegerField(TEXT("version")) > IndexVersion)
+    {
+        UE_LOG(LogAegisBridge, Warning, TEXT("Snapshot index was written by a newer version, starting empty"));
+        return;
+    }
+
+    const TArray<TSharedPtr<FJsonValue>>* Entries;
+    if (!IndexObj->TryGetArrayField(TEXT("snapshots"), Entries))
+    {
+        return;
+    }
+
+    for (const TSharedPtr<FJsonValue>& EntryValue : *Entries)
+    {
+        const TSharedPtr<FJsonObject>* Entry;
+        if (!EntryValue->TryGetObject(Entry))
+        {
+            continue;
+        }
+
+        FAegisSnapshotRecord Record;
+        Record.SnapshotId = (*Entry)->GetStringField(TEXT("snapshotId"));
+        Record.Name = (*Entry)->GetStringField(TEXT("name"));
+        Record.Description = (*Entry)->GetStringField(TEXT("description"));
+        Record.Checksum = (*Entry)->GetStringField(TEXT("checksum"));
+        Record.EntityCount = (*Entry)->GetIntegerField(TEXT("entityCount"));
+        Record.FileName = (*Entry)->GetStringField(TEXT("file"));
+        Record.Size = static_cast<int64>((*Entry)->GetNumberField(TEXT("size")));
+        (*Entry)->TryGetStringField(TEXT("base"), Record.BaseSnapshotId);
+        (*Entry)->TryGetNumberField(TEXT("charSize"), Record.CharSize);
+        FDateTime::ParseIso8601(*(*Entry)->GetStringField(TEXT("timestamp")), Record.Timestamp);
+
+        // Drop entries whose payload disappeared behind our back
+        if (!Record.SnapshotId.IsEmpty() && IFileManager::Get().FileExists(*GetPayloadPath(Record)))
+        {
+            Records.Add(Record.SnapshotId, MoveTemp(Record));
+        }
+    }
+}
+
+bool FAegisSnapshotStore::SaveIndex() const
+{
+    FString IndexString;
+    TSharedRef<FAegisJsonWriter> Writer = FAegisJsonWriterFactory::Create(&IndexString);
+
+    Writer->WriteObjectStart();
+    Writer->WriteValue(TEXT("version"), IndexVersion);
+    Writer->WriteArrayStart(TEXT("snapshots"));
+    for (const auto& Pair : Records)
+    {
+        const FAegisSnapshotRecord& Record = Pair.Value;
+        Writer->WriteObjectStart();
+        Writer->WriteValue(TEXT("snapshotId"), Record.SnapshotId);
+        Writer->WriteValue(TEXT("name"), Record.Name);
+        Writer->WriteValue(TEXT("description"), Record.Description);
+        Writer->WriteValue(TEXT("checksum"), Record.Checksum);
+        Writer->WriteValue(TEXT("timestamp"), Record.Timestamp.ToIso8601());
+        Writer->WriteValue(TEXT("entityCount"), Record.EntityCount);
+        Writer->WriteValue(TEXT("file"), Record.FileName);
+        Writer->WriteValue(TEXT("size"), Record.Size);
+        if (!Record.BaseSnapshotId.IsEmpty())
+        {
+            Writer->WriteValue(TEXT("base"), Record.BaseSnapshotId);
+        }
+        Writer->WriteValue(TEXT("charSize"), Record.CharSize);
+        Writer->WriteObjectEnd();
+    }
+    Writer->WriteArrayEnd();
+    Writer->WriteObjectEnd();
+    Writer->Close();
+
+    // Write to a temporary file first so a crash never leaves a truncated index behind
+    const FString IndexPath = GetIndexPath();
+    const FString TempPath = IndexPath + TEXT(".tmp");
+    if (!FFileHelper::SaveStringToFile(IndexString, *TempPath, FFileHelper::EEncodingOptions::ForceUTF8WithoutBOM) ||
+        !IFileManager::Get().Move(*IndexPath, *TempPath, true, true))
+    {
+        UE_LOG(LogAegisBridge, Error, TEXT("Failed to write snapshot index: %s"), *IndexPath);
+        return false;
+    }
+
+    return true;
+}
@@ -0,0 +1,128 @@
+// Copyright AEGIS Team. All Rights Reserved.
+
+#include "AegisSubscriptionRegistry.h"
+
+bool FAegisSubscriptionRegistry::Subscribe(const FString& ClientId, const FString& Pattern)
+{
+    if (ClientId.IsEmpty() || !IsValidPattern(Pattern))
+    {
+        return false;
+    }
+
+    bool bAlreadySubscribed = false;
+    ClientPatterns.FindOrAdd(ClientId).Add(Pattern, &bAlreadySubscribed);
+    if (!bAlreadySubscribed)
+    {
+        PatternClients.FindOrAdd(Pattern).Add(ClientId);
+        MatchCache.Reset();
+    }
+    return true;
+}
+
+bool FAegisSubscriptionRegistry::Unsubscribe(const FString& ClientId, const FString& Pattern)
+{
+    TSet<FString>* Patterns = ClientPatterns.Find(ClientId);
+    if (!Patterns || Patterns->Remove(Pattern) == 0)
+    {
+        return false;
+    }
+
+    if (Patterns->Num() == 0)
+    {
+        ClientPatterns.Remove(ClientId);
+    }
+
+    if (TSet<FString>* Clients = PatternClients.Find(Pattern))
+    {
+        Clients->Remove(ClientId);
+        if (Clients->Num() == 0)
+        {
+            PatternClients.Remove(Pattern);
+        }
+    }
+
+    MatchCache.Reset();
+    return true;
+}
+
+void FAegisSubscriptionRegistry::RemoveClient(const FString& ClientId)
+{
+    TSet<FString> Patterns;
+    if (!ClientPatterns.RemoveAndCopyValue(ClientId, Patterns))
+    {
+        return;
+    }
+
+    for (const FString& Pattern : Patterns)
+    {
+        if (TSet<FString>* Clients = PatternClients.Find(Pattern))
+        {
+            Clients->Remove(ClientId);
+            if (Clients->Num() == 0)
+            {
+                PatternClients.Remove(Pattern);
+            }
+        }
+    }
+
+    MatchCache.Reset();
+}
+
+const TArray<FString>& FAegisSubscriptionRegistry::GetSubscribers(const FString& EventType) const
+{
+    if (const TArray<FString>* Cached = MatchCache.Find(EventType))
+    {
+        return *Cached;
+    }
+
+    TArray<FString> Subscribers;
+    auto Collect = [this, &Subscribers](const FString& Pattern)
+    {
+        if (const TSet<FString>* Clients = PatternClients.Find(Pattern))
+        {
+            for (const FString& ClientId : *Clients)
+            {
+                Subscribers.AddUnique(ClientId);
+            }
+        }
+    };
+
+    // "world.entity.spawned" matches itself, "world.entity.*", "world.*" and "*"
+    if (PatternClients.Num() > 0)
+    {
+        Collect(EventType);
+
+        int32 DotIndex = EventType.Len();
+        while ((DotIndex = EventType.Find(TEXT("."), ESearchCase::CaseSensitive, ESearchDir::FromEnd, DotIndex)) != INDEX_NONE)
+        {
+            Collect(EventType.Left(DotIndex) + TEXT(".*"));
+        }
+
+        Collect(TEXT("*"));
+    }
+
+    return MatchCache.Add(EventType, MoveTemp(Subscribers));
+}
+
+TArray<FString> FAegisSubscriptionRegistry::GetPatterns(const FString& ClientId) const
+{
+    const TSet<FString>* Patterns = ClientPatterns.Find(ClientId);
+    return Patterns ? Patterns->Array() : TArray<FString>();
+}
+
+bool FAegisSubscriptionRegistry::IsValidPattern(const FString& Pattern)
+{
+    if (Pattern.IsEmpty())
+    {
+        return false;
+    }
+
+    int32 StarIndex;
+    if (!Pattern.FindChar(TEXT('*'), StarIndex))
+    {
+        return true;
+    }
+
+    // A single trailing wildcard, either alone or after a dot
+    return StarIndex == Pattern.Len() - 1 && (StarIndex == 0 || Pattern[StarIndex - 1] == TEXT('.'));
+}
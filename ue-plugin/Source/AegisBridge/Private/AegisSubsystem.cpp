@@ -1,6 +1,11 @@
 // Copyright AEGIS Team. All Rights Reserved.
 
 #include "AegisSubsystem.h"
+#include "AegisActorQuery.h"
+#include "AegisAssetIndex.h"
+#include "AegisBridgeModule.h"
+#include "AegisBridgeStats.h"
+#include "AegisJsonWriter.h"
 #include "Editor.h"
 #include "Engine/World.h"
 #include "Engine/Level.h"
@@ -9,7 +14,6 @@
 #include "Engine/Blueprint.h"
 #include "Kismet2/BlueprintEditorUtils.h"
 #include "Kismet2/KismetEditorUtilities.h"
-#include "AssetRegistry/AssetRegistryModule.h"
 #include "EditorAssetLibrary.h"
 #include "FileHelpers.h"
 #include "LevelEditor.h"
@@ -45,6 +49,8 @@ void UAegisSubsystem::Deinitialize()
 
 FAegisCommandResult UAegisSubsystem::SpawnActor(const FAegisSpawnParams& Params)
 {
+    AEGIS_COMMAND_SCOPE(AegisSubsystem, SpawnActor);
+
     UWorld* World = GEditor ? GEditor->GetEditorWorldContext().World() : nullptr;
     if (!World)
     {
@@ -52,40 +58,18 @@ FAegisCommandResult UAegisSubsystem::SpawnActor(const FAegisSpawnParams& Params)
     }
 
     // Find class
-    UClass* ActorClass = FindObject<UClass>(nullptr, *Params.ClassName);
-    if (!ActorClass)
-    {
-        ActorClass = LoadClass<AActor>(nullptr, *Params.ClassName);
-    }
+    UClass* ActorClass = ResolveActorClass(Params.ClassName);
     if (!ActorClass)
     {
         return MakeError(FString::Printf(TEXT("Class not found: %s"), *Params.ClassName), TEXT("CLASS_NOT_FOUND"));
     }
 
-    // Spawn actor
-    FActorSpawnParameters SpawnParams;
-    SpawnParams.Name = *Params.ActorName;
-    SpawnParams.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AdjustIfPossibleButAlwaysSpawn;
-
-    AActor* NewActor = World->SpawnActor<AActor>(ActorClass, Params.Location, Params.Rotation, SpawnParams);
+    AActor* NewActor = SpawnActorInternal(World, ActorClass, Params);
     if (!NewActor)
     {
         return MakeError(TEXT("Failed to spawn actor"), TEXT("SPAWN_FAILED"));
     }
 
-    // Set scale
-    NewActor->SetActorScale3D(Params.Scale);
-
-    // Apply properties
-    for (const auto& Prop : Params.Properties)
-    {
-        FProperty* Property = NewActor->GetClass()->FindPropertyByName(*Prop.Key);
-        if (Property)
-        {
-            Property->ImportText_Direct(*Prop.Value, Property->ContainerPtrToValuePtr<void>(NewActor), NewActor, PPF_None);
-        }
-    }
-
     // Mark level dirty
     World->MarkPackageDirty();
 
@@ -99,6 +83,8 @@ FAegisCommandResult UAegisSubsystem::SpawnActor(const FAegisSpawnParams& Params)
 
 FAegisCommandResult UAegisSubsystem::DeleteActor(const FString& ActorPath)
 {
+    AEGIS_COMMAND_SCOPE(AegisSubsystem, DeleteActor);
+
     AActor* Actor = FindActorByPath(ActorPath);
     if (!Actor)
     {
@@ -120,6 +106,8 @@ FAegisCommandResult UAegisSubsystem::DeleteActor(const FString& ActorPath)
 
 FAegisCommandResult UAegisSubsystem::ModifyActor(const FString& ActorPath, const TMap<FString, FString>& Properties)
 {
+    AEGIS_COMMAND_SCOPE(AegisSubsystem, ModifyActor);
+
     AActor* Actor = FindActorByPath(ActorPath);
     if (!Actor)
     {
@@ -129,47 +117,7 @@ FAegisCommandResult UAegisSubsystem::ModifyActor(const FString& ActorPath, const
     GEditor->BeginTransaction(FText::FromString(TEXT("AEGIS Modify Actor")));
     Actor->Modify();
 
-    int32 ModifiedCount = 0;
-    for (const auto& Prop : Properties)
-    {
-        // Handle transform properties specially
-        if (Prop.Key == TEXT("Location"))
-        {
-            FVector Location;
-            if (Location.InitFromString(Prop.Value))
-            {
-                Actor->SetActorLocation(Location);
-                ModifiedCount++;
-            }
-        }
-        else if (Prop.Key == TEXT("Rotation"))
-        {
-            FRotator Rotation;
-            if (Rotation.InitFromString(Prop.Value))
-            {
-                Actor->SetActorRotation(Rotation);
-                ModifiedCount++;
-            }
-        }
-        else if (Prop.Key == TEXT("Scale"))
-        {
-            FVector Scale;
-            if (Scale.InitFromString(Prop.Value))
-            {
-                Actor->SetActorScale3D(Scale);
-                ModifiedCount++;
-            }
-        }
-        else
-        {
-            FProperty* Property = Actor->GetClass()->FindPropertyByName(*Prop.Key);
-            if (Property)
-            {
-                Property->ImportText_Direct(*Prop.Value, Property->ContainerPtrToValuePtr<void>(Actor), Actor, PPF_None);
-                ModifiedCount++;
-            }
-        }
-    }
+    const int32 ModifiedCount = ApplyActorProperties(Actor, Properties);
 
     GEditor->EndTransaction();
 
@@ -181,47 +129,38 @@ FAegisCommandResult UAegisSubsystem::ModifyActor(const FString& ActorPath, const
 
 FAegisCommandResult UAegisSubsystem::QueryActors(const FString& ClassFilter, const FString& NameFilter, const TArray<FString>& Tags)
 {
-    UWorld* World = GEditor ? GEditor->GetEditorWorldContext().World() : nullptr;
-    if (!World)
+    AEGIS_COMMAND_SCOPE(AegisSubsystem, QueryActors);
+
+    FAegisActorQueryParams QueryParams;
+    if (!ClassFilter.IsEmpty())
     {
-        return MakeError(TEXT("No valid world context"), TEXT("NO_WORLD"));
+        QueryParams.ClassFilter.Add(ClassFilter);
     }
+    QueryParams.NameFilter = NameFilter;
+    QueryParams.TagFilter = Tags;
 
-    TArray<TSharedPtr<FJsonValue>> ActorArray;
+    return RunActorQuery(QueryParams);
+}
 
-    for (TActorIterator<AActor> It(World); It; ++It)
-    {
-        AActor* Actor = *It;
+FAegisCommandResult UAegisSubsystem::RunActorQuery(const FAegisActorQueryParams& QueryParams)
+{
+    AEGIS_COMMAND_SCOPE(AegisSubsystem, RunActorQuery);
 
-        // Apply class filter
-        if (!ClassFilter.IsEmpty() && !Actor->GetClass()->GetName().Contains(ClassFilter))
-        {
-            continue;
-        }
+    UWorld* World = GEditor ? GEditor->GetEditorWorldContext().World() : nullptr;
+    if (!World)
+    {
+        return MakeError(TEXT("No valid world context"), TEXT("NO_WORLD"));
+    }
 
-        // Apply name filter
-        if (!NameFilter.IsEmpty() && !Actor->GetName().Contains(NameFilter))
-        {
-            continue;
-        }
+    const FAegisActorQuery Query(QueryParams);
 
-        // Apply tag filter
-        if (Tags.Num() > 0)
-        {
-            bool bHasAllTags = true;
-            for (const FString& Tag : Tags)
-            {
-                if (!Actor->Tags.ContainsByPredicate([&Tag](const FName& ActorTag) {
-                    return ActorTag.ToString() == Tag;
-                }))
-                {
-                    bHasAllTags = false;
-                    break;
-                }
-            }
-            if (!bHasAllTags) continue;
-        }
+    TArray<AActor*> Actors;
+    const int32 Total = Query.Execute(World, FAegisBridgeModule::Get().GetActorIndex(), Actors);
 
+    TArray<TSharedPtr<FJsonValue>> ActorArray;
+    ActorArray.Reserve(Actors.Num());
+    for (AActor* Actor : Actors)
+    {
         TSharedPtr<FJsonObject> ActorObj = ActorToJson(Actor, false, false);
         ActorArray.Add(MakeShareable(new FJsonValueObject(ActorObj)));
     }
@@ -229,12 +168,15 @@ FAegisCommandResult UAegisSubsystem::QueryActors(const FString& ClassFilter, con
     TSharedPtr<FJsonObject> ResultData = MakeShareable(new FJsonObject());
     ResultData->SetArrayField(TEXT("actors"), ActorArray);
     ResultData->SetNumberField(TEXT("count"), ActorArray.Num());
+    ResultData->SetNumberField(TEXT("total"), Total);
 
-    return MakeSuccess(FString::Printf(TEXT("Found %d actors"), ActorArray.Num()), ResultData);
+    return MakeSuccess(FString::Printf(TEXT("Found %d actors"), Total), ResultData);
 }
 
 FAegisCommandResult UAegisSubsystem::GetActorInfo(const FString& ActorPath, bool bIncludeComponents, bool bIncludeProperties)
 {
+    AEGIS_COMMAND_SCOPE(AegisSubsystem, GetActorInfo);
+
     AActor* Actor = FindActorByPath(ActorPath);
     if (!Actor)
     {
@@ -247,6 +189,8 @@ FAegisCommandResult UAegisSubsystem::GetActorInfo(const FString& ActorPath, bool
 
 FAegisCommandResult UAegisSubsystem::DuplicateActor(const FString& ActorPath, const FVector& Offset)
 {
+    AEGIS_COMMAND_SCOPE(AegisSubsystem, DuplicateActor);
+
     AActor* SourceActor = FindActorByPath(ActorPath);
     if (!SourceActor)
     {
@@ -282,6 +226,8 @@ FAegisCommandResult UAegisSubsystem::DuplicateActor(const FString& ActorPath, co
 
 FAegisCommandResult UAegisSubsystem::SelectActors(const TArray<FString>& ActorPaths, bool bAddToSelection)
 {
+    AEGIS_COMMAND_SCOPE(AegisSubsystem, SelectActors);
+
     if (!GEditor)
     {
         return MakeError(TEXT("Editor not available"), TEXT("NO_EDITOR"));
@@ -309,12 +255,158 @@ FAegisCommandResult UAegisSubsystem::SelectActors(const TArray<FString>& ActorPa
     return MakeSuccess(FString::Printf(TEXT("Selected %d actors"), SelectedCount), ResultData);
 }
 
+FAegisCommandResult UAegisSubsystem::ExecuteBatch(const TArray<FAegisBatchOperation>& Operations, EAegisBatchFailureMode FailureMode)
+{
+    AEGIS_COMMAND_SCOPE(AegisSubsystem, ExecuteBatch);
+
+    UWorld* World = GEditor ? GEditor->GetEditorWorldContext().World() : nullptr;
+    if (!World)
+    {
+        return MakeError(TEXT("No valid world context"), TEXT("NO_WORLD"));
+    }
+
+    // Classes repeat heavily inside a batch; resolve each one once, misses included
+    TMap<FString, UClass*> ClassCache;
+
+    TArray<TSharedPtr<FJsonValue>> ResultArray;
+    ResultArray.Reserve(Operations.Num());
+
+    int32 SucceededCount = 0;
+    int32 FailedCount = 0;
+    bool bSpawnedAny = false;
+    bool bAborted = false;
+
+    GEditor->BeginTransaction(FText::Format(
+        NSLOCTEXT("AegisSubsystem", "BatchTransaction", "AEGIS Batch ({0} operations)"), Operations.Num()));
+
+    for (const FAegisBatchOperation& Operation : Operations)
+    {
+        // Compact per-operation result: {"ok":true,"path":...} or {"ok":false,"code":...,"error":...}
+        TSharedPtr<FJsonObject> OpResult = MakeShareable(new FJsonObject());
+        FString ErrorCode;
+        FString Error;
+
+        if (Operation.Op == TEXT("spawn"))
+        {
+            UClass* ActorClass = nullptr;
+            if (UClass** CachedClass = ClassCache.Find(Operation.SpawnParams.ClassName))
+            {
+                ActorClass = *CachedClass;
+            }
+            else
+            {
+                ActorClass = ResolveActorClass(Operation.SpawnParams.ClassName);
+                ClassCache.Add(Operation.SpawnParams.ClassName, ActorClass);
+            }
+
+            AActor* NewActor = ActorClass ? SpawnActorInternal(World, ActorClass, Operation.SpawnParams) : nullptr;
+            if (NewActor)
+            {
+                OpResult->SetStringField(TEXT("path"), NewActor->GetPathName());
+                bSpawnedAny = true;
+            }
+            else if (!ActorClass)
+            {
+                ErrorCode = TEXT("CLASS_NOT_FOUND");
+                Error = Operation.SpawnParams.ClassName;
+            }
+            else
+            {
+                ErrorCode = TEXT("SPAWN_FAILED");
+                Error = Operation.SpawnParams.ActorName;
+            }
+        }
+        else if (Operation.Op == TEXT("modify") || Operation.Op == TEXT("delete"))
+        {
+            AActor* Actor = FindActorByPath(Operation.ActorPath);
+            if (!Actor)
+            {
+                ErrorCode = TEXT("ACTOR_NOT_FOUND");
+                Error = Operation.ActorPath;
+            }
+            else if (Operation.Op == TEXT("modify"))
+            {
+                Actor->Modify();
+                OpResult->SetNumberField(TEXT("modified"), ApplyActorProperties(Actor, Operation.Properties));
+            }
+            else
+            {
+                Actor->Modify();
+                Actor->Destroy();
+            }
+        }
+        else
+        {
+            ErrorCode = TEXT("UNKNOWN_OPERATION");
+            Error = Operation.Op;
+        }
+
+        const bool bOk = ErrorCode.IsEmpty();
+        OpResult->SetBoolField(TEXT("ok"), bOk);
+        if (!bOk)
+        {
+            OpResult->SetStringField(TEXT("code"), ErrorCode);
+            OpResult->SetStringField(TEXT("error"), Error);
+        }
+        ResultArray.Add(MakeShareable(new FJsonValueObject(OpResult)));
+
+        if (bOk)
+        {
+            SucceededCount++;
+        }
+        else
+        {
+            FailedCount++;
+            if (FailureMode != EAegisBatchFailureMode::ContinueOnError)
+            {
+                bAborted = true;
+                break;
+            }
+        }
+    }
+
+    GEditor->EndTransaction();
+
+    const bool bRolledBack = bAborted && FailureMode == EAegisBatchFailureMode::RollbackOnError;
+    if (bRolledBack)
+    {
+        // Undo the batch transaction as a whole
+        GEditor->UndoTransaction(false);
+    }
+    else if (bSpawnedAny)
+    {
+        // Single dirty pass for the whole batch
+        World->MarkPackageDirty();
+    }
+
+    TSharedPtr<FJsonObject> ResultData = MakeShareable(new FJsonObject());
+    ResultData->SetArrayField(TEXT("results"), ResultArray);
+    ResultData->SetNumberField(TEXT("succeeded"), SucceededCount);
+    ResultData->SetNumberField(TEXT("failed"), FailedCount);
+    ResultData->SetNumberField(TEXT("skipped"), Operations.Num() - ResultArray.Num());
+    ResultData->SetBoolField(TEXT("rolledBack"), bRolledBack);
+
+    if (bRolledBack)
+    {
+        FAegisCommandResult Result = MakeError(
+            FString::Printf(TEXT("Batch rolled back after %d of %d operations"), ResultArray.Num(), Operations.Num()),
+            TEXT("BATCH_ROLLED_BACK"));
+        TSharedRef<FAegisJsonWriter> Writer = FAegisJsonWriterFactory::Create(&Result.Data);
+        FJsonSerializer::Serialize(ResultData.ToSharedRef(), Writer);
+        return Result;
+    }
+
+    return MakeSuccess(FString::Printf(TEXT("Batch: %d succeeded, %d failed"), SucceededCount, FailedCount), ResultData);
+}
+
 // ============================================================================
 // Blueprint Operations
 // ============================================================================
 
 FAegisCommandResult UAegisSubsystem::CreateBlueprint(const FString& BlueprintName, const FString& ParentClass, const FString& Path)
 {
+    AEGIS_COMMAND_SCOPE(AegisSubsystem, CreateBlueprint);
+
     UClass* ParentUClass = FindObject<UClass>(nullptr, *ParentClass);
     if (!ParentUClass)
     {
@@ -361,6 +453,8 @@ FAegisCommandResult UAegisSubsystem::CreateBlueprint(const FString& BlueprintNam
 
 FAegisCommandResult UAegisSubsystem::CompileBlueprint(const FString& BlueprintPath)
 {
+    AEGIS_COMMAND_SCOPE(AegisSubsystem, CompileBlueprint);
+
     UBlueprint* Blueprint = LoadObject<UBlueprint>(nullptr, *BlueprintPath);
     if (!Blueprint)
     {
@@ -385,6 +479,8 @@ FAegisCommandResult UAegisSubsystem::CompileBlueprint(const FString& BlueprintPa
 
 FAegisCommandResult UAegisSubsystem::AddBlueprintComponent(const FString& BlueprintPath, const FString& ComponentClass, const FString& ComponentName)
 {
+    AEGIS_COMMAND_SCOPE(AegisSubsystem, AddBlueprintComponent);
+
     UBlueprint* Blueprint = LoadObject<UBlueprint>(nullptr, *BlueprintPath);
     if (!Blueprint)
     {
@@ -418,6 +514,8 @@ FAegisCommandResult UAegisSubsystem::AddBlueprintComponent(const FString& Bluepr
 
 FAegisCommandResult UAegisSubsystem::AddBlueprintVariable(const FString& BlueprintPath, const FString& VariableName, const FString& VariableType)
 {
+    AEGIS_COMMAND_SCOPE(AegisSubsystem, AddBlueprintVariable);
+
     UBlueprint* Blueprint = LoadObject<UBlueprint>(nullptr, *BlueprintPath);
     if (!Blueprint)
     {
@@ -464,51 +562,63 @@ FAegisCommandResult UAegisSubsystem::AddBlueprintVariable(const FString& Bluepri
 
 FAegisCommandResult UAegisSubsystem::SearchAssets(const FString& SearchQuery, const FString& AssetType, const FString& Path)
 {
-    FAssetRegistryModule& AssetRegistryModule = FModuleManager::LoadModuleChecked<FAssetRegistryModule>("AssetRegistry");
-    IAssetRegistry& AssetRegistry = AssetRegistryModule.Get();
-
-    FARFilter Filter;
-
-    if (!Path.IsEmpty())
-    {
-        Filter.PackagePaths.Add(*Path);
-        Filter.bRecursivePaths = true;
-    }
+    AEGIS_COMMAND_SCOPE(AegisSubsystem, SearchAssets);
 
+    FAegisAssetSearchParams SearchParams;
+    SearchParams.Query = SearchQuery;
     if (!AssetType.IsEmpty())
     {
-        Filter.ClassPaths.Add(FTopLevelAssetPath(TEXT("/Script/CoreUObject"), *AssetType));
+        SearchParams.ClassNames.Add(AssetType);
     }
+    SearchParams.Path = Path;
 
-    TArray<FAssetData> AssetList;
-    AssetRegistry.GetAssets(Filter, AssetList);
+    return SearchAssetIndex(SearchParams);
+}
 
-    TArray<TSharedPtr<FJsonValue>> AssetArray;
-    for (const FAssetData& Asset : AssetList)
-    {
-        if (!SearchQuery.IsEmpty() && !Asset.AssetName.ToString().Contains(SearchQuery))
-        {
-            continue;
-        }
+FAegisCommandResult UAegisSubsystem::SearchAssetIndex(const FAegisAssetSearchParams& SearchParams)
+{
+    // Static and thread-safe: the job manager runs it on workers, and Record takes the stats lock
+    AEGIS_COMMAND_SCOPE(AegisSubsystem, SearchAssetIndex);
 
-        TSharedPtr<FJsonObject> AssetObj = MakeShareable(new FJsonObject());
-        AssetObj->SetStringField(TEXT("name"), Asset.AssetName.ToString());
-        AssetObj->SetStringField(TEXT("path"), Asset.GetObjectPathString());
-        AssetObj->SetStringField(TEXT("class"), Asset.AssetClassPath.GetAssetName().ToString());
-        AssetObj->SetStringField(TEXT("package"), Asset.PackageName.ToString());
+    FAegisCommandResult Result;
 
-        AssetArray.Add(MakeShareable(new FJsonValueObject(AssetObj)));
+    TArray<FAegisAssetIndex::FEntry> Assets;
+    FString NextCursor;
+    if (!FAegisBridgeModule::Get().GetAssetIndex().Search(SearchParams, Assets, NextCursor, Result.Message))
+    {
+        Result.ErrorCode = TEXT("INVALID_CURSOR");
+        return Result;
     }
 
-    TSharedPtr<FJsonObject> ResultData = MakeShareable(new FJsonObject());
-    ResultData->SetArrayField(TEXT("assets"), AssetArray);
-    ResultData->SetNumberField(TEXT("count"), AssetArray.Num());
+    Result.bSuccess = true;
+    Result.Message = FString::Printf(TEXT("Found %d assets"), Assets.Num());
 
-    return MakeSuccess(FString::Printf(TEXT("Found %d assets"), AssetArray.Num()), ResultData);
+    // Pages can hold thousands of assets, so they are written straight to the response string
+    TSharedRef<FAegisJsonWriter> Writer = FAegisJsonWriterFactory::Create(&Result.Data);
+    Writer->WriteObjectStart();
+    Writer->WriteArrayStart(TEXT("assets"));
+    for (const FAegisAssetIndex::FEntry& Asset : Assets)
+    {
+        Writer->WriteObjectStart();
+        Writer->WriteValue(TEXT("name"), Asset.AssetName.ToString());
+        Writer->WriteValue(TEXT("path"), Asset.ObjectPath);
+        Writer->WriteValue(TEXT("class"), Asset.ClassPath.GetAssetName().ToString());
+        Writer->WriteValue(TEXT("package"), Asset.PackageName.ToString());
+        Writer->WriteObjectEnd();
+    }
+    Writer->WriteArrayEnd();
+    Writer->WriteValue(TEXT("count"), Assets.Num());
+    Writer->WriteValue(TEXT("nextCursor"), NextCursor);
+    Writer->WriteObjectEnd();
+    Writer->Close();
+
+    return Result;
 }
 
 FAegisCommandResult UAegisSubsystem::LoadAsset(const FString& AssetPath)
 {
+    AEGIS_COMMAND_SCOPE(AegisSubsystem, LoadAsset);
+
     UObject* Asset = UEditorAssetLibrary::LoadAsset(AssetPath);
     if (!Asset)
     {
@@ -524,12 +634,14 @@ FAegisCommandResult UAegisSubsystem::LoadAsset(const FString& AssetPath)
 
 FAegisCommandResult UAegisSubsystem::ImportAsset(const FString& SourcePath, const FString& DestinationPath)
 {
+    AEGIS_COMMAND_SCOPE(AegisSubsystem, ImportAsset);
     // This is a simplified implementation - production would use asset import factories
     return MakeError(TEXT("Import not implemented - use Content Browser"), TEXT("NOT_IMPLEMENTED"));
 }
 
 FAegisCommandResult UAegisSubsystem::ExportAsset(const FString& AssetPath, const FString& ExportPath)
 {
+    AEGIS_COMMAND_SCOPE(AegisSubsystem, ExportAsset);
     // This is a simplified implementation - production would use asset export
     return MakeError(TEXT("Export not implemented - use Content Browser"), TEXT("NOT_IMPLEMENTED"));
 }
@@ -540,6 +652,8 @@ FAegisCommandResult UAegisSubsystem::ExportAsset(const FString& AssetPath, const
 
 FAegisCommandResult UAegisSubsystem::LoadLevel(const FString& LevelPath)
 {
+    AEGIS_COMMAND_SCOPE(AegisSubsystem, LoadLevel);
+
     if (!FEditorFileUtils::LoadMap(LevelPath))
     {
         return MakeError(FString::Printf(TEXT("Failed to load level: %s"), *LevelPath), TEXT("LOAD_FAILED"));
@@ -550,6 +664,8 @@ FAegisCommandResult UAegisSubsystem::LoadLevel(const FString& LevelPath)
 
 FAegisCommandResult UAegisSubsystem::SaveLevel()
 {
+    AEGIS_COMMAND_SCOPE(AegisSubsystem, SaveLevel);
+
     if (!FEditorFileUtils::SaveCurrentLevel())
     {
         return MakeError(TEXT("Failed to save level"), TEXT("SAVE_FAILED"));
@@ -560,6 +676,7 @@ FAegisCommandResult UAegisSubsystem::SaveLevel()
 
 FAegisCommandResult UAegisSubsystem::CreateLevel(const FString& LevelName, const FString& TemplateName)
 {
+    AEGIS_COMMAND_SCOPE(AegisSubsystem, CreateLevel);
     // Create new level - simplified implementation
     FString PackagePath = FString::Printf(TEXT("/Game/Maps/%s"), *LevelName);
 
@@ -577,29 +694,17 @@ FAegisCommandResult UAegisSubsystem::CreateLevel(const FString& LevelName, const
 
 FAegisCommandResult UAegisSubsystem::GetLevelInfo()
 {
+    AEGIS_COMMAND_SCOPE(AegisSubsystem, GetLevelInfo);
+
     UWorld* World = GEditor ? GEditor->GetEditorWorldContext().World() : nullptr;
     if (!World)
     {
         return MakeError(TEXT("No valid world context"), TEXT("NO_WORLD"));
     }
 
-    TSharedPtr<FJsonObject> ResultData = MakeShareable(new FJsonObject());
-    ResultData->SetStringField(TEXT("worldName"), World->GetName());
-    ResultData->SetStringField(TEXT("mapName"), World->GetMapName());
-    ResultData->SetNumberField(TEXT("actorCount"), World->GetActorCount());
-
-    // Get streaming levels
-    TArray<TSharedPtr<FJsonValue>> LevelArray;
-    for (ULevelStreaming* StreamingLevel : World->GetStreamingLevels())
-    {
-        TSharedPtr<FJsonObject> LevelObj = MakeShareable(new FJsonObject());
-        LevelObj->SetStringField(TEXT("name"), StreamingLevel->GetWorldAssetPackageName());
-        LevelObj->SetBoolField(TEXT("loaded"), StreamingLevel->IsLevelLoaded());
-        LevelArray.Add(MakeShareable(new FJsonValueObject(LevelObj)));
-    }
-    ResultData->SetArrayField(TEXT("streamingLevels"), LevelArray);
-
-    return MakeSuccess(TEXT("Level info retrieved"), ResultData);
+    FAegisCommandResult Result = MakeSuccess(TEXT("Level info retrieved"));
+    Result.Data = FAegisBridgeModule::Get().GetEditorContext().GetLevelInfoJson();
+    return Result;
 }
 
 // ============================================================================
@@ -608,6 +713,8 @@ FAegisCommandResult UAegisSubsystem::GetLevelInfo()
 
 FAegisCommandResult UAegisSubsystem::ExecuteEditorCommand(const FString& Command)
 {
+    AEGIS_COMMAND_SCOPE(AegisSubsystem, ExecuteEditorCommand);
+
     if (GEditor)
     {
         GEditor->Exec(GEditor->GetEditorWorldContext().World(), *Command);
@@ -618,6 +725,8 @@ FAegisCommandResult UAegisSubsystem::ExecuteEditorCommand(const FString& Command
 
 FAegisCommandResult UAegisSubsystem::Undo()
 {
+    AEGIS_COMMAND_SCOPE(AegisSubsystem, Undo);
+
     if (GEditor && GEditor->Trans)
     {
         if (GEditor->Trans->Undo())
@@ -630,6 +739,8 @@ FAegisCommandResult UAegisSubsystem::Undo()
 
 FAegisCommandResult UAegisSubsystem::Redo()
 {
+    AEGIS_COMMAND_SCOPE(AegisSubsystem, Redo);
+
     if (GEditor && GEditor->Trans)
     {
         if (GEditor->Trans->Redo())
@@ -642,6 +753,8 @@ FAegisCommandResult UAegisSubsystem::Redo()
 
 FAegisCommandResult UAegisSubsystem::GetSelection()
 {
+    AEGIS_COMMAND_SCOPE(AegisSubsystem, GetSelection);
+
     if (!GEditor)
     {
         return MakeError(TEXT("Editor not available"), TEXT("NO_EDITOR"));
@@ -665,6 +778,8 @@ FAegisCommandResult UAegisSubsystem::GetSelection()
 
 FAegisCommandResult UAegisSubsystem::FocusActor(const FString& ActorPath)
 {
+    AEGIS_COMMAND_SCOPE(AegisSubsystem, FocusActor);
+
     AActor* Actor = FindActorByPath(ActorPath);
     if (!Actor)
     {
@@ -679,47 +794,29 @@ FAegisCommandResult UAegisSubsystem::FocusActor(const FString& ActorPath)
 // Context Operations
 // ============================================================================
 
-FAegisCommandResult UAegisSubsystem::GetEditorContext()
+FAegisCommandResult UAegisSubsystem::GetEditorContext(int64 SinceVersion)
 {
-    TSharedPtr<FJsonObject> ResultData = MakeShareable(new FJsonObject());
+    AEGIS_COMMAND_SCOPE(AegisSubsystem, GetEditorContext);
 
-    // World info
-    UWorld* World = GEditor ? GEditor->GetEditorWorldContext().World() : nullptr;
-    if (World)
-    {
-        TSharedPtr<FJsonObject> WorldObj = MakeShareable(new FJsonObject());
-        WorldObj->SetStringField(TEXT("name"), World->GetName());
-        WorldObj->SetStringField(TEXT("mapName"), World->GetMapName());
-        WorldObj->SetNumberField(TEXT("actorCount"), World->GetActorCount());
-        ResultData->SetObjectField(TEXT("world"), WorldObj);
-    }
+    FAegisEditorContext& Context = FAegisBridgeModule::Get().GetEditorContext();
 
-    // Selection
-    if (GEditor)
+    const int64 Version = Context.GetVersion();
+    if (Version == SinceVersion)
     {
-        TArray<AActor*> SelectedActors;
-        GEditor->GetSelectedActors()->GetSelectedObjects<AActor>(SelectedActors);
-
-        TArray<TSharedPtr<FJsonValue>> SelectionArray;
-        for (AActor* Actor : SelectedActors)
-        {
-            TSharedPtr<FJsonObject> ActorObj = MakeShareable(new FJsonObject());
-            ActorObj->SetStringField(TEXT("name"), Actor->GetName());
-            ActorObj->SetStringField(TEXT("class"), Actor->GetClass()->GetName());
-            SelectionArray.Add(MakeShareable(new FJsonValueObject(ActorObj)));
-        }
-        ResultData->SetArrayField(TEXT("selection"), SelectionArray);
+        FAegisCommandResult Result = MakeSuccess(TEXT("Editor context unchanged"));
+        Result.Data = FString::Printf(TEXT("{\"version\":%lld,\"unchanged\":true}"), Version);
+        return Result;
     }
 
-    // Editor mode
-    ResultData->SetBoolField(TEXT("isPlaying"), GEditor ? GEditor->IsPlayingSessionInEditor() : false);
-    ResultData->SetBoolField(TEXT("isSimulating"), GEditor ? GEditor->IsSimulatingInEditor() : false);
-
-    return MakeSuccess(TEXT("Editor context retrieved"), ResultData);
+    FAegisCommandResult Result = MakeSuccess(TEXT("Editor context retrieved"));
+    Result.Data = Context.GetContextJson();
+    return Result;
 }
 
 FAegisCommandResult UAegisSubsystem::GetProjectInfo()
 {
+    AEGIS_COMMAND_SCOPE(AegisSubsystem, GetProjectInfo);
+
     TSharedPtr<FJsonObject> ResultData = MakeShareable(new FJsonObject());
 
     ResultData->SetStringField(TEXT("projectName"), FApp::GetProjectName());
@@ -730,6 +827,26 @@ FAegisCommandResult UAegisSubsystem::GetProjectInfo()
     return MakeSuccess(TEXT("Project info retrieved"), ResultData);
 }
 
+FAegisCommandResult UAegisSubsystem::GetBridgeStats(bool bReset)
+{
+    AEGIS_COMMAND_SCOPE(AegisSubsystem, GetBridgeStats);
+
+    FAegisBridgeStats& Stats = FAegisBridgeStats::Get();
+
+    FAegisCommandResult Result = MakeSuccess(TEXT("Bridge stats retrieved"));
+    TSharedRef<FAegisJsonWriter> Writer = FAegisJsonWriterFactory::Create(&Result.Data);
+    Writer->WriteObjectStart();
+    Stats.WriteFields(*Writer);
+    Writer->WriteObjectEnd();
+    Writer->Close();
+
+    if (bReset)
+    {
+        Stats.Reset();
+    }
+    return Result;
+}
+
 // ============================================================================
 // Helper Functions
 // ============================================================================
@@ -739,20 +856,85 @@ AActor* UAegisSubsystem::FindActorByPath(const FString& ActorPath)
     UWorld* World = GEditor ? GEditor->GetEditorWorldContext().World() : nullptr;
     if (!World) return nullptr;
 
-    // Try direct path lookup first
-    AActor* Actor = FindObject<AActor>(World->GetCurrentLevel(), *ActorPath);
-    if (Actor) return Actor;
+    // Hash lookup by path or name through the module's actor index
+    return FAegisBridgeModule::Get().GetActorIndex().FindActor(World, ActorPath);
+}
+
+UClass* UAegisSubsystem::ResolveActorClass(const FString& ClassName)
+{
+    UClass* ActorClass = FindObject<UClass>(nullptr, *ClassName);
+    if (!ActorClass)
+    {
+        ActorClass = LoadClass<AActor>(nullptr, *ClassName);
+    }
+    return ActorClass;
+}
+
+AActor* UAegisSubsystem::SpawnActorInternal(UWorld* World, UClass* ActorClass, const FAegisSpawnParams& Params)
+{
+    FActorSpawnParameters SpawnParams;
+    SpawnParams.Name = *Params.ActorName;
+    SpawnParams.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AdjustIfPossibleButAlwaysSpawn;
+
+    AActor* NewActor = World->SpawnActor<AActor>(ActorClass, Params.Location, Params.Rotation, SpawnParams);
+    if (!NewActor)
+    {
+        return nullptr;
+    }
 
-    // Try name-based search
-    for (TActorIterator<AActor> It(World); It; ++It)
+    // Set scale
+    NewActor->SetActorScale3D(Params.Scale);
+
+    // Apply properties
+    FAegisPropertyPlanCache& Plans = FAegisBridgeModule::Get().GetPropertyPlans();
+    for (const auto& Prop : Params.Properties)
+    {
+        Plans.SetProperty(NewActor, Prop.Key, Prop.Value);
+    }
+
+    return NewActor;
+}
+
+int32 UAegisSubsystem::ApplyActorProperties(AActor* Actor, const TMap<FString, FString>& Properties)
+{
+    FAegisPropertyPlanCache& Plans = FAegisBridgeModule::Get().GetPropertyPlans();
+    int32 ModifiedCount = 0;
+    for (const auto& Prop : Properties)
     {
-        if (It->GetName() == ActorPath || It->GetPathName() == ActorPath)
+        // Handle transform properties specially
+        if (Prop.Key == TEXT("Location"))
         {
-            return *It;
+            FVector Location;
+            if (Location.InitFromString(Prop.Value))
+            {
+                Actor->SetActorLocation(Location);
+                ModifiedCount++;
+            }
+        }
+        else if (Prop.Key == TEXT("Rotation"))
+        {
+            FRotator Rotation;
+            if (Rotation.InitFromString(Prop.Value))
+            {
+                Actor->SetActorRotation(Rotation);
+                ModifiedCount++;
+            }
+        }
+        else if (Prop.Key == TEXT("Scale"))
+        {
+            FVector Scale;
+            if (Scale.InitFromString(Prop.Value))
+            {
+                Actor->SetActorScale3D(Scale);
+                ModifiedCount++;
+            }
+        }
+        else if (Plans.SetProperty(Actor, Prop.Key, Prop.Value))
+        {
+            ModifiedCount++;
         }
     }
-
-    return nullptr;
+    return ModifiedCount;
 }
 
 TSharedPtr<FJsonObject> UAegisSubsystem::ActorToJson(AActor* Actor, bool bIncludeComponents, bool bIncludeProperties)
@@ -811,6 +993,13 @@ TSharedPtr<FJsonObject> UAegisSubsystem::ActorToJson(AActor* Actor, bool bInclud
         ActorObj->SetArrayField(TEXT("components"), CompArray);
     }
 
+    // Editable properties
+    if (bIncludeProperties)
+    {
+        const FAegisPropertyPlan& Plan = FAegisBridgeModule::Get().GetPropertyPlans().Get(Actor->GetClass());
+        ActorObj->SetObjectField(TEXT("properties"), Plan.ToJsonObject(Actor));
+    }
+
     return ActorObj;
 }
 
@@ -822,10 +1011,9 @@ FAegisCommandResult UAegisSubsystem::MakeSuccess(const FString& Message, const T
 
     if (Data.IsValid())
     {
-        FString DataString;
-        TSharedRef<TJsonWriter<>> Writer = TJsonWriterFactory<>::Create(&DataString);
+        // Serialized once here; HandleRequest splices the string into its response as-is
+        TSharedRef<FAegisJsonWriter> Writer = FAegisJsonWriterFactory::Create(&Result.Data);
         FJsonSerializer::Serialize(Data.ToSharedRef(), Writer);
-        Result.Data = DataString;
     }
 
     return Result;
@@ -2,12 +2,47 @@
 
 #include "AegisWebSocketServer.h"
 #include "AegisBridgeModule.h"
-#include "WebSocketsModule.h"
-#include "IWebSocketServer.h"
+#include "AegisBridgeStats.h"
+#include "AegisJsonWriter.h"
+#include "AegisMessagePack.h"
+#include "HAL/PlatformTime.h"
+#include "Misc/ConfigCacheIni.h"
+#include "ProfilingDebugging/CountersTrace.h"
 #include "Json.h"
 
+TRACE_DECLARE_INT_COUNTER(AegisWebSocketQueuedMessages, TEXT("AEGIS/WebSocket/QueuedMessages"));
+TRACE_DECLARE_INT_COUNTER(AegisWebSocketQueuedBytes, TEXT("AEGIS/WebSocket/QueuedBytes"));
+
+namespace
+{
+    const FName NAME_WsBroadcast(TEXT("ws.broadcast"));
+    const FName NAME_WsReceive(TEXT("ws.receive"));
+}
+
 UAegisWebSocketServer* UAegisWebSocketServer::Instance = nullptr;
 
+namespace
+{
+    /** Topic of a (un)subscribe message: {event}, {topic} or {payload: {topic|eventType}} */
+    FString ReadTopic(const FJsonObject& Message)
+    {
+        FString Topic;
+        if (Message.TryGetStringField(TEXT("event"), Topic) || Message.TryGetStringField(TEXT("topic"), Topic))
+        {
+            return Topic;
+        }
+
+        const TSharedPtr<FJsonObject>* Payload;
+        if (Message.TryGetObjectField(TEXT("payload"), Payload) &&
+            ((*Payload)->TryGetStringField(TEXT("topic"), Topic) || (*Payload)->TryGetStringField(TEXT("eventType"), Topic)))
+        {
+            return Topic;
+        }
+
+        return FString();
+    }
+}
+
 UAegisWebSocketServer* UAegisWebSocketServer::Get()
 {
     if (!Instance)
@@ -28,8 +63,43 @@ void UAegisWebSocketServer::Initialize(int32 Port)
 
     UE_LOG(LogAegisBridge, Log, TEXT("Initializing AEGIS WebSocket server on port %d"), Port);
 
-    // Note: This is a simplified implementation
-    // Production would integrate with UE's WebSocket server or Remote Control WebSocket
+    FAegisWebSocketTransport::FSettings Settings;
+    Settings.Port = Port;
+
+    FAegisEventCoalescer::FSettings CoalescerSettings;
+
+    if (GConfig)
+    {
+        FString DropPolicy;
+        if (GConfig->GetString(TEXT("AegisBridge"), TEXT("WebSocketDropPolicy"), DropPolicy, GEngineIni) &&
+            !ParseDropPolicy(DropPolicy, Settings.DropPolicy))
+        {
+            UE_LOG(LogAegisBridge, Warning, TEXT("Unknown WebSocketDropPolicy '%s', using oldest"), *DropPolicy);
+        }
+
+        int32 MaxQueuedKB = 0;
+        if (GConfig->GetInt(TEXT("AegisBridge"), TEXT("WebSocketMaxQueuedKB"), MaxQueuedKB, GEngineIni) && MaxQueuedKB > 0)
+        {
+            Settings.MaxQueuedBytes = static_cast<int64>(MaxQueuedKB) * 1024;
+        }
+
+        int32 CoalesceWindowMs = 0;
+        if (GConfig->GetInt(TEXT("AegisBridge"), TEXT("EventCoalesceWindowMs"), CoalesceWindowMs, GEngineIni))
+        {
+            CoalescerSettings.WindowSeconds = FMath::Max(CoalesceWindowMs, 0) / 1000.0;
+        }
+        GConfig->GetInt(TEXT("AegisBridge"), TEXT("EventBatchMaxEntities"), CoalescerSettings.MaxBatchEntities, GEngineIni);
+    }
+    Coalescer.Configure(CoalescerSettings);
+
+    Transport = MakeUnique<FAegisWebSocketTransport>(Settings);
+    if (!Transport->Start())
+    {
+        Transport.Reset();
+        return;
+    }
+
+    TickHandle = FTSTicker::GetCoreTicker().AddTicker(FTickerDelegate::CreateUObject(this, &UAegisWebSocketServer::Tick));
 
     bIsRunning = true;
     UE_LOG(LogAegisBridge, Log, TEXT("AEGIS WebSocket server initialized"));
@@ -44,53 +114,237 @@ void UAegisWebSocketServer::Shutdown()
 
     UE_LOG(LogAegisBridge, Log, TEXT("Shutting down AEGIS WebSocket server"));
 
+    FTSTicker::GetCoreTicker().RemoveTicker(TickHandle);
+    TickHandle.Reset();
+
+    Coalescer.Reset();
+
+    Transport->Shutdown();
+    Transport.Reset();
+
     ConnectedClients.Empty();
     bIsRunning = false;
 }
 
+bool UAegisWebSocketServer::Tick(float DeltaTime)
+{
+    FAegisWebSocketEvent Event;
+    while (Transport && Transport->PollEvent(Event))
+    {
+        switch (Event.Type)
+        {
+        case FAegisWebSocketEvent::EType::Connected:
+            OnClientConnected(Event.Client);
+            break;
+
+        case FAegisWebSocketEvent::EType::Disconnected:
+            OnClientDisconnected(Event.Client->ClientId);
+            break;
+
+        case FAegisWebSocketEvent::EType::Message:
+            OnMessageReceived(Event.Client->ClientId, Event.Message);
+            break;
+        }
+    }
+
+    Coalescer.FlushIfDue(*this, FPlatformTime::Seconds());
+
+#if COUNTERSTRACE_ENABLED
+    // Queue depth gauges for Unreal Insights
+    if (UE_TRACE_CHANNELEXPR_IS_ENABLED(CountersChannel))
+    {
+        int64 QueuedMessages = 0;
+        int64 QueuedBytes = 0;
+        for (const TPair<FString, FAegisWebSocketClientPtr>& Pair : ConnectedClients)
+        {
+            const FAegisWebSocketClientStats Stats = Pair.Value->GetStats();
+            QueuedMessages += Stats.QueuedMessages;
+            QueuedBytes += Stats.QueuedBytes;
+        }
+        TRACE_COUNTER_SET(AegisWebSocketQueuedMessages, QueuedMessages);
+        TRACE_COUNTER_SET(AegisWebSocketQueuedBytes, QueuedBytes);
+    }
+#endif
+
+    return true;
+}
+
+FAegisWebSocketPayload UAegisWebSocketServer::MakePayload(const FString& Message, EAegisWireEncoding Encoding)
+{
+    if (Encoding == EAegisWireEncoding::MessagePack)
+    {
+        TSharedRef<TArray<uint8>, ESPMode::ThreadSafe> Packed = MakeShared<TArray<uint8>, ESPMode::ThreadSafe>();
+        if (FAegisMessagePack::FromJson(Message, *Packed))
+        {
+            return Packed;
+        }
+
+        // Clients detect the encoding per frame, so JSON is always a safe fallback
+        UE_LOG(LogAegisBridge, Warning, TEXT("Could not pack a %d character frame, sending it as JSON"), Message.Len());
+    }
+
+    const FTCHARToUTF8 Converted(*Message, Message.Len());
+    return MakeShared<TArray<uint8>, ESPMode::ThreadSafe>(reinterpret_cast<const uint8*>(Converted.Get()), Converted.Length());
+}
+
+void UAegisWebSocketServer::Send(FAegisWebSocketClient& Client, const FAegisWebSocketPayload& Payload)
+{
+    if (!Client.Enqueue(Payload))
+    {
+        UE_LOG(LogAegisBridge, Verbose, TEXT("Dropped frame for lagging client %s"), *Client.ClientId);
+    }
+    Transport->Wake();
+}
+
+bool UAegisWebSocketServer::HasSubscribers(const FString& EventType) const
+{
+    return bIsRunning && Subscriptions.HasSubscribers(EventType);
+}
+
+void UAegisWebSocketServer::BroadcastEvent(const FString& EventType, TFunctionRef<void(FAegisJsonWriter&)> WriteData)
+{
+    BroadcastFrame(EventType, [&WriteData](FAegisJsonWriter& Writer)
+    {
+        Writer.WriteIdentifierPrefix(TEXT("data"));
+        WriteData(Writer);
+    });
+}
+
 void UAegisWebSocketServer::BroadcastEvent(const FString& EventType, const TSharedPtr<FJsonObject>& Data)
 {
-    if (!bIsRunning)
+    if (!HasSubscribers(EventType))
     {
         return;
     }
 
-    // Create event message
-    TSharedPtr<FJsonObject> EventMessage = MakeShareable(new FJsonObject());
-    EventMessage->SetStringField(TEXT("type"), TEXT("event"));
-    EventMessage->SetStringField(TEXT("event"), EventType);
-    EventMessage->SetNumberField(TEXT("timestamp"), FDateTime::UtcNow().ToUnixTimestamp());
-
+    // The object is already built; splice its encoding into the shared frame
+    FString DataString;
     if (Data.IsValid())
     {
-        EventMessage->SetObjectField(TEXT("data"), Data);
+        TSharedRef<FAegisJsonWriter> DataWriter = FAegisJsonWriterFactory::Create(&DataString);
+        FJsonSerializer::Serialize(Data.ToSharedRef(), DataWriter);
+    }
+
+    BroadcastFrame(EventType, [&DataString](FAegisJsonWriter& Writer)
+    {
+        if (!DataString.IsEmpty())
+        {
+            AegisJson::WriteRawJson(Writer, TEXT("data"), DataString);
+        }
+    });
+}
+
+void UAegisWebSocketServer::BroadcastFrame(const FString& EventType, TFunctionRef<void(FAegisJsonWriter&)> WriteDataField)
+{
+    if (!bIsRunning)
+    {
+        return;
+    }
+
+    // Events nobody listens to are never built
+    if (!Subscriptions.HasSubscribers(EventType))
+    {
+        return;
     }
 
-    // Serialize to string
+    // The registry's list lives in its match cache; the data callback may subscribe or broadcast
+    const TArray<FString> Subscribers = Subscriptions.GetSubscribers(EventType);
+
+    AEGIS_TRACE_SCOPE(AegisBroadcastFrame);
+    FAegisStatScope StatScope(NAME_WsBroadcast);
+
     FString MessageString;
-    TSharedRef<TJsonWriter<>> Writer = TJsonWriterFactory<>::Create(&MessageString);
-    FJsonSerializer::Serialize(EventMessage.ToSharedRef(), Writer);
+    TSharedRef<FAegisJsonWriter> Writer = FAegisJsonWriterFactory::Create(&MessageString);
+    Writer->WriteObjectStart();
+    Writer->WriteValue(TEXT("type"), TEXT("event"));
+    Writer->WriteValue(TEXT("event"), EventType);
+    Writer->WriteValue(TEXT("timestamp"), FDateTime::UtcNow().ToUnixTimestamp());
+    WriteDataField(*Writer);
+    Writer->WriteObjectEnd();
+    Writer->Close();
+
+    UE_LOG(LogAegisBridge, Verbose, TEXT("Broadcasting event %s to %d clients"), *EventType, Subscribers.Num());
+
+    // Serialized once; every subscriber of an encoding queues the same buffer
+    FAegisWebSocketPayload Payloads[2];
+    for (const FString& ClientId : Subscribers)
+    {
+        const FAegisWebSocketClientPtr* Client = ConnectedClients.Find(ClientId);
+        if (!Client)
+        {
+            continue;
+        }
+
+        const EAegisWireEncoding Encoding = (*Client)->GetEncoding();
+        FAegisWebSocketPayload& Payload = Payloads[static_cast<int32>(Encoding)];
+        if (!Payload.IsValid())
+        {
+            Payload = MakePayload(MessageString, Encoding);
+        }
+
+        if (!(*Client)->Enqueue(Payload))
+        {
+            UE_LOG(LogAegisBridge, Verbose, TEXT("Dropped %s for lagging client %s"), *EventType, *ClientId);
+        }
+        StatScope.BytesOut += Payload->Num();
+    }
+    Transport->Wake();
+}
+
+// ============================================================================
+// Coalesced events
+// ============================================================================
+
+void UAegisWebSocketServer::QueueActorSpawned(AActor* Actor)
+{
+    if (Actor && HasSubscribers(TEXT("world.entity.changed")))
+    {
+        Coalescer.AddSpawned(Actor);
+    }
+}
 
-    UE_LOG(LogAegisBridge, Verbose, TEXT("Broadcasting event: %s"), *EventType);
+void UAegisWebSocketServer::QueueActorDestroyed(AActor* Actor)
+{
+    if (Actor && HasSubscribers(TEXT("world.entity.changed")))
+    {
+        Coalescer.AddDestroyed(Actor);
+    }
+}
 
-    // In production, this would send to all connected WebSocket clients
-    // For now, we log the event
-    for (const auto& Client : ConnectedClients)
+void UAegisWebSocketServer::QueueSelectionChanged()
+{
+    if (HasSubscribers(TEXT("editor.selection.changed")))
     {
-        SendToClient(Client.Key, MessageString);
+        Coalescer.AddSelectionChanged();
+    }
+}
+
+void UAegisWebSocketServer::QueueEditorContextChanged()
+{
+    if (HasSubscribers(TEXT("editor.context.changed")))
+    {
+        Coalescer.AddContextChanged();
+    }
+}
+
+void UAegisWebSocketServer::FlushCoalescedEvents()
+{
+    if (bIsRunning)
+    {
+        Coalescer.Flush(*this);
     }
 }
 
 void UAegisWebSocketServer::SendToClient(const FString& ClientId, const FString& Message)
 {
-    if (!ConnectedClients.Contains(ClientId))
+    const FAegisWebSocketClientPtr* Client = ConnectedClients.Find(ClientId);
+    if (!Client)
     {
         UE_LOG(LogAegisBridge, Warning, TEXT("Client not found: %s"), *ClientId);
         return;
     }
 
-    // In production, this would send via WebSocket
-    UE_LOG(LogAegisBridge, Verbose, TEXT("Sending to client %s: %s"), *ClientId, *Message);
+    Send(**Client, MakePayload(Message, (*Client)->GetEncoding()));
 }
 
 int32 UAegisWebSocketServer::GetClientCount() const
@@ -98,10 +352,43 @@ int32 UAegisWebSocketServer::GetClientCount() const
     return ConnectedClients.Num();
 }
 
-void UAegisWebSocketServer::OnClientConnected(const FString& ClientId)
+bool UAegisWebSocketServer::GetClientStats(const FString& ClientId, FAegisWebSocketClientStats& OutStats) const
+{
+    const FAegisWebSocketClientPtr* Client = ConnectedClients.Find(ClientId);
+    if (!Client)
+    {
+        return false;
+    }
+
+    OutStats = (*Client)->GetStats();
+    return true;
+}
+
+void UAegisWebSocketServer::GetAllClientStats(TArray<TPair<FString, FAegisWebSocketClientStats>>& OutStats) const
 {
-    UE_LOG(LogAegisBridge, Log, TEXT("Client connected: %s"), *ClientId);
-    ConnectedClients.Add(ClientId, true);
+    OutStats.Reset(ConnectedClients.Num());
+    for (const TPair<FString, FAegisWebSocketClientPtr>& Pair : ConnectedClients)
+    {
+        OutStats.Emplace(Pair.Key, Pair.Value->GetStats());
+    }
+}
+
+bool UAegisWebSocketServer::SetClientDropPolicy(const FString& ClientId, EAegisDropPolicy Policy)
+{
+    const FAegisWebSocketClientPtr* Client = ConnectedClients.Find(ClientId);
+    if (!Client)
+    {
+        return false;
+    }
+
+    (*Client)->SetDropPolicy(Policy);
+    return true;
+}
+
+void UAegisWebSocketServer::OnClientConnected(const FAegisWebSocketClientPtr& Client)
+{
+    UE_LOG(LogAegisBridge, Log, TEXT("Client connected: %s (%s)"), *Client->ClientId, *Client->RemoteAddress);
+    ConnectedClients.Add(Client->ClientId, Client);
 
     // Update bridge connection status
     if (FAegisBridgeModule::IsAvailable())
@@ -109,18 +396,38 @@ void UAegisWebSocketServer::OnClientConnected(const FString& ClientId)
         FAegisBridgeModule::Get().SetBridgeConnected(true);
     }
 
-    // Send welcome message
-    TSharedPtr<FJsonObject> WelcomeData = MakeShareable(new FJsonObject());
-    WelcomeData->SetStringField(TEXT("version"), TEXT("1.0.0"));
-    WelcomeData->SetStringField(TEXT("server"), TEXT("AegisBridge"));
-
-    BroadcastEvent(TEXT("connection.established"), WelcomeData);
+    // Send welcome message to the new client only
+    FString WelcomeString;
+    TSharedRef<FAegisJsonWriter> Writer = FAegisJsonWriterFactory::Create(&WelcomeString);
+    Writer->WriteObjectStart();
+    Writer->WriteValue(TEXT("type"), TEXT("event"));
+    Writer->WriteValue(TEXT("event"), TEXT("connection.established"));
+    Writer->WriteValue(TEXT("timestamp"), FDateTime::UtcNow().ToUnixTimestamp());
+    Writer->WriteObjectStart(TEXT("data"));
+    Writer->WriteValue(TEXT("version"), TEXT("1.0.0"));
+    Writer->WriteValue(TEXT("server"), TEXT("AegisBridge"));
+    Writer->WriteValue(TEXT("clientId"), Client->ClientId);
+    Writer->WriteArrayStart(TEXT("encodings"));
+    Writer->WriteValue(TEXT("json"));
+    Writer->WriteValue(TEXT("msgpack"));
+    Writer->WriteArrayEnd();
+    Writer->WriteObjectEnd();
+    Writer->WriteObjectEnd();
+    Writer->Close();
+
+    // Always JSON: the client has not chosen an encoding yet
+    Send(*Client, MakePayload(WelcomeString, EAegisWireEncoding::Json));
 }
 
 void UAegisWebSocketServer::OnClientDisconnected(const FString& ClientId)
 {
+    if (ConnectedClients.Remove(ClientId) == 0)
+    {
+        return;
+    }
+    Subscriptions.RemoveClient(ClientId);
+
     UE_LOG(LogAegisBridge, Log, TEXT("Client disconnected: %s"), *ClientId);
-    ConnectedClients.Remove(ClientId);
 
     // Update bridge connection status
     if (FAegisBridgeModule::IsAvailable() && ConnectedClients.Num() == 0)
@@ -133,6 +440,10 @@ void UAegisWebSocketServer::OnMessageReceived(const FString& ClientId, const FSt
 {
     UE_LOG(LogAegisBridge, Verbose, TEXT("Message from %s: %s"), *ClientId, *Message);
 
+    AEGIS_TRACE_SCOPE(AegisMessageReceived);
+    FAegisStatScope StatScope(NAME_WsReceive);
+    StatScope.BytesIn = Message.Len();
+
     // Parse message
     TSharedPtr<FJsonObject> JsonMessage;
     TSharedRef<TJsonReader<>> Reader = TJsonReaderFactory<>::Create(Message);
@@ -149,14 +460,103 @@ void UAegisWebSocketServer::OnMessageReceived(const FString& ClientId, const FSt
     if (MessageType == TEXT("subscribe"))
     {
         // Handle event subscription
-        FString EventName = JsonMessage->GetStringField(TEXT("event"));
-        UE_LOG(LogAegisBridge, Log, TEXT("Client %s subscribed to event: %s"), *ClientId, *EventName);
+        const FString Topic = ReadTopic(*JsonMessage);
+        if (Subscriptions.Subscribe(ClientId, Topic))
+        {
+            UE_LOG(LogAegisBridge, Log, TEXT("Client %s subscribed to event: %s"), *ClientId, *Topic);
+        }
+        else
+        {
+            UE_LOG(LogAegisBridge, Warning, TEXT("Client %s sent an invalid topic: '%s'"), *ClientId, *Topic);
+        }
     }
     else if (MessageType == TEXT("unsubscribe"))
     {
         // Handle event unsubscription
-        FString EventName = JsonMessage->GetStringField(TEXT("event"));
-        UE_LOG(LogAegisBridge, Log, TEXT("Client %s unsubscribed from event: %s"), *ClientId, *EventName);
+        const FString Topic = ReadTopic(*JsonMessage);
+        if (Subscriptions.Unsubscribe(ClientId, Topic))
+        {
+            UE_LOG(LogAegisBridge, Log, TEXT("Client %s unsubscribed from event: %s"), *ClientId, *Topic);
+        }
+    }
+    else if (MessageType == TEXT("configure"))
+    {
+        const FAegisWebSocketClientPtr* Client = ConnectedClients.Find(ClientId);
+        if (!Client)
+        {
+            return;
+        }
+
+        // Options sit at the top level or in the payload
+        const TSharedPtr<FJsonObject>* PayloadPtr;
+        const FJsonObject& Options = JsonMessage->TryGetObjectField(TEXT("payload"), PayloadPtr) ? **PayloadPtr : *JsonMessage;
+
+        // Clients choose how their own queue sheds load
+        FString PolicyName;
+        EAegisDropPolicy Policy;
+        if (Options.TryGetStringField(TEXT("dropPolicy"), PolicyName) && ParseDropPolicy(PolicyName, Policy))
+        {
+            (*Client)->SetDropPolicy(Policy);
+        }
+
+        // Frames queued from now on use the new encoding; the client detects it per frame
+        FString EncodingName;
+        EAegisWireEncoding Encoding;
+        if (Options.TryGetStringField(TEXT("encoding"), EncodingName))
+        {
+            if (ParseWireEncoding(EncodingName, Encoding))
+            {
+                (*Client)->SetEncoding(Encoding);
+                UE_LOG(LogAegisBridge, Log, TEXT("Client %s switched to %s frames"), *ClientId, *EncodingName);
+            }
+            else
+            {
+                UE_LOG(LogAegisBridge, Warning, TEXT("Client %s asked for unknown encoding '%s'"), *ClientId, *EncodingName);
+            }
+        }
+
+        FString RequestId;
+        JsonMessage->TryGetStringField(TEXT("requestId"), RequestId);
+
+        FString AckString;
+        TSharedRef<FAegisJsonWriter> Writer = FAegisJsonWriterFactory::Create(&AckString);
+        Writer->WriteObjectStart();
+        Writer->WriteValue(TEXT("type"), TEXT("configured"));
+        if (!RequestId.IsEmpty())
+        {
+            Writer->WriteValue(TEXT("requestId"), RequestId);
+        }
+        Writer->WriteObjectStart(TEXT("payload"));
+        Writer->WriteValue(TEXT("encoding"), (*Client)->GetEncoding() == EAegisWireEncoding::MessagePack ? TEXT("msgpack") : TEXT("json"));
+        Writer->WriteObjectEnd();
+        Writer->WriteObjectEnd();
+        Writer->Close();
+
+        SendToClient(ClientId, AckString);
+    }
+    else if (MessageType == TEXT("stats"))
+    {
+        FAegisWebSocketClientStats Stats;
+        if (!GetClientStats(ClientId, Stats))
+        {
+            return;
+        }
+
+        FString StatsString;
+        TSharedRef<FAegisJsonWriter> Writer = FAegisJsonWriterFactory::Create(&StatsString);
+        Writer->WriteObjectStart();
+        Writer->WriteValue(TEXT("type"), TEXT("stats"));
+        Writer->WriteValue(TEXT("queuedMessages"), Stats.QueuedMessages);
+        Writer->WriteValue(TEXT("queuedBytes"), Stats.QueuedBytes);
+        Writer->WriteValue(TEXT("peakQueuedMessages"), Stats.PeakQueuedMessages);
+        Writer->WriteValue(TEXT("sentMessages"), Stats.SentMessages);
+        Writer->WriteValue(TEXT("sentBytes"), Stats.SentBytes);
+        Writer->WriteValue(TEXT("droppedMessages"), Stats.DroppedMessages);
+        Writer->WriteValue(TEXT("oversizedMessages"), Stats.OversizedMessages);
+        Writer->WriteObjectEnd();
+        Writer->Close();
+
+        SendToClient(ClientId, StatsString);
     }
     else if (MessageType == TEXT("ping"))
     {
@@ -166,7 +566,7 @@ void UAegisWebSocketServer::OnMessageReceived(const FString& ClientId, const FSt
         PongMessage->SetNumberField(TEXT("timestamp"), FDateTime::UtcNow().ToUnixTimestamp());
 
         FString PongString;
-        TSharedRef<TJsonWriter<>> Writer = TJsonWriterFactory<>::Create(&PongString);
+        TSharedRef<FAegisJsonWriter> Writer = FAegisJsonWriterFactory::Create(&PongString);
         FJsonSerializer::Serialize(PongMessage.ToSharedRef(), Writer);
 
         SendToClient(ClientId, PongString);
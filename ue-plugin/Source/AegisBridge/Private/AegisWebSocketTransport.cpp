@@ -0,0 +1,324 @@
+// Copyright AEGIS Team. All Rights Reserved.
+
+#include "AegisWebSocketTransport.h"
+#include "AegisBridgeModule.h"
+#include "AegisMessagePack.h"
+#include "HAL/Event.h"
+#include "HAL/PlatformProcess.h"
+#include "HAL/RunnableThread.h"
+#include "INetworkingWebSocket.h"
+#include "IWebSocketNetworkingModule.h"
+#include "IWebSocketServer.h"
+#include "WebSocketNetworkingDelegates.h"
+
+bool ParseDropPolicy(const FString& Name, EAegisDropPolicy& OutPolicy)
+{
+    if (Name.Equals(TEXT("oldest"), ESearchCase::IgnoreCase)) { OutPolicy = EAegisDropPolicy::DropOldest; return true; }
+    if (Name.Equals(TEXT("newest"), ESearchCase::IgnoreCase)) { OutPolicy = EAegisDropPolicy::DropNewest; return true; }
+    if (Name.Equals(TEXT("disconnect"), ESearchCase::IgnoreCase)) { OutPolicy = EAegisDropPolicy::Disconnect; return true; }
+    return false;
+}
+
+bool ParseWireEncoding(const FString& Name, EAegisWireEncoding& OutEncoding)
+{
+    if (Name.Equals(TEXT("json"), ESearchCase::IgnoreCase)) { OutEncoding = EAegisWireEncoding::Json; return true; }
+    if (Name.Equals(TEXT("msgpack"), ESearchCase::IgnoreCase) || Name.Equals(TEXT("messagepack"), ESearchCase::IgnoreCase)) { OutEncoding = EAegisWireEncoding::MessagePack; return true; }
+    return false;
+}
+
+// ============================================================================
+// Client
+// ============================================================================
+
+FAegisWebSocketClient::FAegisWebSocketClient(const FString& InClientId, const FString& InRemoteAddress, EAegisDropPolicy InDropPolicy, int64 InMaxQueuedBytes)
+    : ClientId(InClientId)
+    , RemoteAddress(InRemoteAddress)
+    , MaxQueuedBytes(InMaxQueuedBytes)
+    , DropPolicy(InDropPolicy)
+{
+}
+
+bool FAegisWebSocketClient::Enqueue(const FAegisWebSocketPayload& Payload)
+{
+    if (!Payload.IsValid() || IsCloseRequested())
+    {
+        return false;
+    }
+
+    const int64 Size = Payload->Num();
+    if (Size > MaxQueuedBytes)
+    {
+        // No amount of trimming makes room for it; under DropOldest it would empty the queue and then go itself
+        DroppedMessages.fetch_add(1, std::memory_order_relaxed);
+        if (OversizedMessages.fetch_add(1, std::memory_order_relaxed) == 0)
+        {
+            UE_LOG(LogAegisBridge, Warning, TEXT("WebSocket client %s: dropped a %lld byte frame that exceeds its %lld byte queue budget"),
+                *ClientId, Size, MaxQueuedBytes);
+        }
+        return false;
+    }
+
+    if (QueuedBytes.load(std::memory_order_relaxed) + Size > MaxQueuedBytes)
+    {
+        switch (GetDropPolicy())
+        {
+        case EAegisDropPolicy::DropNewest:
+            DroppedMessages.fetch_add(1, std::memory_order_relaxed);
+            return false;
+
+        case EAegisDropPolicy::Disconnect:
+            DroppedMessages.fetch_add(1, std::memory_order_relaxed);
+            RequestClose();
+            return false;
+
+        case EAegisDropPolicy::DropOldest:
+            // Only the consumer may pop, so the network thread trims before its next send
+            break;
+        }
+    }
+
+    // Counters go up before the frame is visible, so the consumer never drives them negative
+    QueuedBytes.fetch_add(Size, std::memory_order_relaxed);
+    const int32 Depth = QueuedMessages.fetch_add(1, std::memory_order_relaxed) + 1;
+
+    int32 Peak = PeakQueuedMessages.load(std::memory_order_relaxed);
+    while (Depth > Peak && !PeakQueuedMessages.compare_exchange_weak(Peak, Depth, std::memory_order_relaxed))
+    {
+    }
+
+    Outbound.Enqueue(Payload);
+    return true;
+}
+
+bool FAegisWebSocketClient::Dequeue(FAegisWebSocketPayload& OutPayload)
+{
+    if (!Outbound.Dequeue(OutPayload))
+    {
+        return false;
+    }
+
+    QueuedBytes.fetch_sub(OutPayload->Num(), std::memory_order_relaxed);
+    QueuedMessages.fetch_sub(1, std::memory_order_relaxed);
+    return true;
+}
+
+void FAegisWebSocketClient::TrimToBudget()
+{
+    FAegisWebSocketPayload Discarded;
+    while (QueuedBytes.load(std::memory_order_relaxed) > MaxQueuedBytes && Dequeue(Discarded))
+    {
+        DroppedMessages.fetch_add(1, std::memory_order_relaxed);
+    }
+}
+
+void FAegisWebSocketClient::RecordSent(int64 Bytes)
+{
+    SentMessages.fetch_add(1, std::memory_order_relaxed);
+    SentBytes.fetch_add(Bytes, std::memory_order_relaxed);
+}
+
+FAegisWebSocketClientStats FAegisWebSocketClient::GetStats() const
+{
+    FAegisWebSocketClientStats Stats;
+    Stats.QueuedMessages = QueuedMessages.load(std::memory_order_relaxed);
+    Stats.QueuedBytes = QueuedBytes.load(std::memory_order_relaxed);
+    Stats.PeakQueuedMessages = PeakQueuedMessages.load(std::memory_order_relaxed);
+    Stats.SentMessages = SentMessages.load(std::memory_order_relaxed);
+    Stats.SentBytes = SentBytes.load(std::memory_order_relaxed);
+    Stats.DroppedMessages = DroppedMessages.load(std::memory_order_relaxed);
+    Stats.OversizedMessages = OversizedMessages.load(std::memory_order_relaxed);
+    return Stats;
+}
+
+// ============================================================================
+// Transport
+// ============================================================================
+
+FAegisWebSocketTransport::FAegisWebSocketTransport(const FSettings& InSettings)
+    : Settings(InSettings)
+{
+}
+
+FAegisWebSocketTransport::~FAegisWebSocketTransport()
+{
+    Shutdown();
+}
+
+bool FAegisWebSocketTransport::Start()
+{
+    if (Thread)
+    {
+        return true;
+    }
+
+    // Module loading and binding stay on the game thread; only ticking moves off it
+    IWebSocketNetworkingModule& Module = FModuleManager::LoadModuleChecked<IWebSocketNetworkingModule>(TEXT("WebSocketNetworking"));
+    Server = Module.CreateServer();
+
+    FWebSocketClientConnectedCallBack ConnectedCallback;
+    ConnectedCallback.BindRaw(this, &FAegisWebSocketTransport::HandleClientConnected);
+
+    if (!Server || !Server->Init(Settings.Port, ConnectedCallback))
+    {
+        UE_LOG(LogAegisBridge, Error, TEXT("Failed to bind WebSocket server on port %d"), Settings.Port);
+        Server.Reset();
+        return false;
+    }
+
+    bStopping = false;
+    WakeEvent = FPlatformProcess::GetSynchEventFromPool(false);
+    Thread = FRunnableThread::Create(this, TEXT("AegisWebSocketServer"), 0, TPri_AboveNormal);
+
+    return Thread != nullptr;
+}
+
+void FAegisWebSocketTransport::Shutdown()
+{
+    if (Thread)
+    {
+        Stop();
+        Thread->WaitForCompletion();
+        delete Thread;
+        Thread = nullptr;
+    }
+
+    if (WakeEvent)
+    {
+        FPlatformProcess::ReturnSynchEventToPool(WakeEvent);
+        WakeEvent = nullptr;
+    }
+
+    // Never started, or the thread already released everything
+    Connections.Empty();
+    Server.Reset();
+}
+
+void FAegisWebSocketTransport::Wake()
+{
+    if (WakeEvent)
+    {
+        WakeEvent->Trigger();
+    }
+}
+
+void FAegisWebSocketTransport::Stop()
+{
+    bStopping = true;
+    Wake();
+}
+
+uint32 FAegisWebSocketTransport::Run()
+{
+    const uint32 IdleWaitMs = FMath::Max(1, FMath::RoundToInt(Settings.IdleIntervalSeconds * 1000.0f));
+
+    while (!bStopping)
+    {
+        // Accepts, reads and socket writes all happen here; callbacks fire from inside Tick
+        Server->Tick();
+        FlushConnections();
+
+        WakeEvent->Wait(IdleWaitMs);
+    }
+
+    // The server is single threaded: tear it down on the thread that ticked it
+    for (FConnection& Connection : Connections)
+    {
+        Events.Enqueue(FAegisWebSocketEvent{ FAegisWebSocketEvent::EType::Disconnected, Connection.Client });
+    }
+    Connections.Empty();
+    Server.Reset();
+
+    return 0;
+}
+
+void FAegisWebSocketTransport::HandleClientConnected(INetworkingWebSocket* Socket)
+{
+    const FString ClientId = FGuid::NewGuid().ToString(EGuidFormats::Short);
+
+    FConnection& Connection = Connections.AddDefaulted_GetRef();
+    Connection.Socket.Reset(Socket);
+    Connection.Client = MakeShared<FAegisWebSocketClient, ESPMode::ThreadSafe>(
+        ClientId, Socket->RemoteEndPoint(true), Settings.DropPolicy, Settings.MaxQueuedBytes);
+
+    Socket->SetReceiveCallBack(FWebSocketPacketReceivedCallBack::CreateRaw(this, &FAegisWebSocketTransport::HandlePacketReceived, ClientId));
+    Socket->SetSocketClosedCallBack(FWebSocketInfoCallBack::CreateRaw(this, &FAegisWebSocketTransport::HandleSocketClosed, ClientId));
+    Socket->SetErrorCallBack(FWebSocketInfoCallBack::CreateRaw(this, &FAegisWebSocketTransport::HandleSocketClosed, ClientId));
+
+    Events.Enqueue(FAegisWebSocketEvent{ FAegisWebSocketEvent::EType::Connected, Connection.Client });
+}
+
+void FAegisWebSocketTransport::HandlePacketReceived(void* Data, int32 Size, FString ClientId)
+{
+    FConnection* Connection = FindConnection(ClientId);
+    if (!Connection || Size <= 0)
+    {
+        return;
+    }
+
+    // Binary frames are transcoded here, off the game thread, which only ever parses JSON
+    const uint8* Bytes = static_cast<const uint8*>(Data);
+    if (FAegisMessagePack::IsMessagePack(Bytes, Size))
+    {
+        FString Json;
+        if (!FAegisMessagePack::ToJson(Bytes, Size, Json))
+        {
+            UE_LOG(LogAegisBridge, Warning, TEXT("Discarded malformed MessagePack frame from client %s"), *ClientId);
+            return;
+        }
+        Events.Enqueue(FAegisWebSocketEvent{ FAegisWebSocketEvent::EType::Message, Connection->Client, MoveTemp(Json) });
+        return;
+    }
+
+    const FUTF8ToTCHAR Converted(reinterpret_cast<const ANSICHAR*>(Bytes), Size);
+    Events.Enqueue(FAegisWebSocketEvent{ FAegisWebSocketEvent::EType::Message, Connection->Client, FString(Converted.Length(), Converted.Get()) });
+}
+
+void FAegisWebSocketTransport::HandleSocketClosed(FString ClientId)
+{
+    // Deleting the socket from inside its own callback is unsafe; FlushConnections removes it
+    if (FConnection* Connection = FindConnection(ClientId))
+    {
+        Connection->bClosed = true;
+    }
+}
+
+FAegisWebSocketTransport::FConnection* FAegisWebSocketTransport::FindConnection(const FString& ClientId)
+{
+    return Connections.FindByPredicate([&ClientId](const FConnection& Connection)
+    {
+        return Connection.Client->ClientId == ClientId;
+    });
+}
+
+void FAegisWebSocketTransport::FlushConnections()
+{
+    for (int32 Index = Connections.Num() - 1; Index >= 0; --Index)
+    {
+        FConnection& Connection = Connections[Index];
+        FAegisWebSocketClient& Client = *Connection.Client;
+
+        if (Connection.bClosed || Client.IsCloseRequested())
+        {
+            Client.RequestClose();
+            Events.Enqueue(FAegisWebSocketEvent{ FAegisWebSocketEvent::EType::Disconnected, Connection.Client });
+            Connections.RemoveAtSwap(Index);
+            continue;
+        }
+
+        if (Client.GetDropPolicy() == EAegisDropPolicy::DropOldest)
+        {
+            Client.TrimToBudget();
+        }
+
+        // The socket buffers internally without exposing its depth, so pace each client per pass
+        // and leave the rest in the queue where the drop policy can act on it
+        int64 BytesThisPass = 0;
+        FAegisWebSocketPayload Payload;
+        while (BytesThisPass < Settings.MaxSendBytesPerPass && Client.Dequeue(Payload))
+        {
+            Connection.Socket->Send(Payload->GetData(), Payload->Num(), false);
+            Client.RecordSent(Payload->Num());
+            BytesThisPass += Payload->Num();
+        }
+    }
+}
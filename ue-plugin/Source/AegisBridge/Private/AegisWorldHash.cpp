@@ -0,0 +1,358 @@
+// Copyright AEGIS Team. All Rights Reserved.
+
+#include "AegisWorldHash.h"
+#include "AegisBinarySnapshot.h"
+#include "Async/ParallelFor.h"
+#include "Dom/JsonObject.h"
+#include "Hash/xxhash.h"
+#include "Serialization/JsonSerializer.h"
+
+namespace
+{
+    void UpdateString(FXxHash64Builder& Builder, const FString& Value)
+    {
+        // Length-prefixed, so adjacent strings cannot run into each other
+        const int32 Length = Value.Len();
+        Builder.Update(&Length, sizeof(Length));
+        Builder.Update(*Value, Length * sizeof(TCHAR));
+    }
+
+    template <typename T>
+    void UpdateValue(FXxHash64Builder& Builder, const T& Value)
+    {
+        Builder.Update(&Value, sizeof(T));
+    }
+
+    void UpdateQuantized(FXxHash64Builder& Builder, float Value, double Quantum)
+    {
+        UpdateValue(Builder, FMath::RoundToInt64(Value / Quantum));
+    }
+
+    uint64 HashString(const FString& Value)
+    {
+        return FXxHash64::HashBuffer(*Value, Value.Len() * sizeof(TCHAR)).Hash;
+    }
+
+    /** Hash a node's id together with its children's hashes */
+    uint64 HashNode(uint64 IdHash, TConstArrayView<uint64> ChildHashes)
+    {
+        FXxHash64Builder Builder;
+        UpdateValue(Builder, IdHash);
+        Builder.Update(ChildHashes.GetData(), ChildHashes.Num() * sizeof(uint64));
+        return Builder.Finalize().Hash;
+    }
+
+    /** Per-entity results of the parallel pass */
+    struct FEntityHash
+    {
+        FString Level;
+        FIntPoint Coord = FIntPoint::ZeroValue;
+        uint64 Hash = 0;
+    };
+
+    void WriteMismatch(FAegisJsonWriter& Writer, const FString& Id, const TCHAR* Kind, uint64 Hash)
+    {
+        Writer.WriteObjectStart();
+        Writer.WriteValue(TEXT("id"), Id);
+        Writer.WriteValue(TEXT("kind"), Kind);
+        Writer.WriteValue(TEXT("hash"), FAegisWorldHash::HashToString(Hash));
+        Writer.WriteObjectEnd();
+    }
+
+    bool MatchesKnown(const TMap<FString, FString>& KnownHashes, const FString& Id, uint64 Hash)
+    {
+        const FString* Known = KnownHashes.Find(Id);
+        return Known && *Known == FAegisWorldHash::HashToString(Hash);
+    }
+}
+
+void FAegisWorldHash::Build(const FAegisBinarySnapshot& Snapshot, const FAegisWorldHashOptions& Options)
+{
+    CellSize = Options.CellSize > 0.0 ? Options.CellSize : DefaultCellSize;
+    EntityCount = Snapshot.Entities.Num();
+    Levels.Reset();
+
+    TArray<FEntityHash> EntityHashes;
+    EntityHashes.SetNum(EntityCount);
+
+    const double InvCellSize = 1.0 / CellSize;
+    ParallelFor(EntityCount, [&Snapshot, &Options, &EntityHashes, InvCellSize](int32 Index)
+    {
+        const FAegisSnapshotEntity& Entity = Snapshot.Entities[Index];
+        FEntityHash& Result = EntityHashes[Index];
+        Result.Level = GetEntityLevel(Snapshot, Entity);
+        Result.Coord = FIntPoint(
+            FMath::FloorToInt32(Entity.Location.X * InvCellSize),
+            FMath::FloorToInt32(Entity.Location.Y * InvCellSize));
+        Result.Hash = HashEntity(Snapshot, Entity, Options.Properties);
+    });
+
+    // Group into levels and cells; the grouping itself is cheap next to the hashing
+    TMap<FString, int32> LevelIndices;
+    TArray<TMap<FIntPoint, int32>> CellIndices;
+    for (int32 Index = 0; Index < EntityCount; ++Index)
+    {
+        const FEntityHash& Entry = EntityHashes[Index];
+
+        int32 LevelIndex;
+        if (const int32* Found = LevelIndices.Find(Entry.Level))
+        {
+            LevelIndex = *Found;
+        }
+        else
+        {
+            LevelIndex = Levels.Num();
+            LevelIndices.Add(Entry.Level, LevelIndex);
+            Levels.AddDefaulted_GetRef().Level = Entry.Level;
+            CellIndices.AddDefaulted();
+        }
+
+        FAegisWorldHashLevel& Level = Levels[LevelIndex];
+        int32& CellIndex = CellIndices[LevelIndex].FindOrAdd(Entry.Coord, INDEX_NONE);
+        if (CellIndex == INDEX_NONE)
+        {
+            CellIndex = Level.Cells.Num();
+            Level.Cells.AddDefaulted_GetRef().Coord = Entry.Coord;
+        }
+
+        FAegisWorldHashLeaf& Leaf = Level.Cells[CellIndex].Leaves.AddDefaulted_GetRef();
+        Leaf.Key = Snapshot.GetEntityKey(Snapshot.Entities[Index]);
+        Leaf.Hash = Entry.Hash;
+    }
+
+    // Capture order is not stable, so every level is put in a canonical order
+    Levels.Sort([](const FAegisWorldHashLevel& A, const FAegisWorldHashLevel& B)
+    {
+        return A.Level.Compare(B.Level, ESearchCase::CaseSensitive) < 0;
+    });
+
+    TArray<FAegisWorldHashCell*> Cells;
+    for (FAegisWorldHashLevel& Level : Levels)
+    {
+        Level.Cells.Sort([](const FAegisWorldHashCell& A, const FAegisWorldHashCell& B)
+        {
+            return A.Coord.Y != B.Coord.Y ? A.Coord.Y < B.Coord.Y : A.Coord.X < B.Coord.X;
+        });
+        for (FAegisWorldHashCell& Cell : Level.Cells)
+        {
+            Cells.Add(&Cell);
+        }
+    }
+
+    ParallelFor(Cells.Num(), [&Cells](int32 Index)
+    {
+        FAegisWorldHashCell& Cell = *Cells[Index];
+        Cell.Leaves.Sort([](const FAegisWorldHashLeaf& A, const FAegisWorldHashLeaf& B)
+        {
+            return A.Key.Compare(B.Key, ESearchCase::CaseSensitive) < 0;
+        });
+
+        TArray<uint64> LeafHashes;
+        LeafHashes.Reserve(Cell.Leaves.Num());
+        for (const FAegisWorldHashLeaf& Leaf : Cell.Leaves)
+        {
+            LeafHashes.Add(HashNode(HashString(Leaf.Key), MakeArrayView(&Leaf.Hash, 1)));
+        }
+        Cell.Hash = HashNode(FXxHash64::HashBuffer(&Cell.Coord, sizeof(FIntPoint)).Hash, LeafHashes);
+    });
+
+    TArray<uint64> LevelHashes;
+    LevelHashes.Reserve(Levels.Num());
+    for (FAegisWorldHashLevel& Level : Levels)
+    {
+        TArray<uint64> CellHashes;
+        CellHashes.Reserve(Level.Cells.Num());
+        for (const FAegisWorldHashCell& Cell : Level.Cells)
+        {
+            CellHashes.Add(Cell.Hash);
+        }
+        Level.Hash = HashNode(HashString(Level.Level), CellHashes);
+        LevelHashes.Add(Level.Hash);
+    }
+
+    RootHash = HashNode(0, LevelHashes);
+}
+
+uint64 FAegisWorldHash::HashEntity(const FAegisBinarySnapshot& Snapshot, const FAegisSnapshotEntity& Entity, TConstArrayView<FString> Properties)
+{
+    FXxHash64Builder Builder;
+    UpdateString(Builder, Snapshot.GetString(Entity.Class));
+
+    UpdateValue(Builder, Entity.bHasTransform);
+    if (Entity.bHasTransform)
+    {
+        const FRotator3f Rotation = Entity.Rotation.GetNormalized();
+        for (int32 Axis = 0; Axis < 3; ++Axis)
+        {
+            UpdateQuantized(Builder, Entity.Location[Axis], 0.01);
+            UpdateQuantized(Builder, Entity.Scale[Axis], 0.0001);
+        }
+        UpdateQuantized(Builder, Rotation.Pitch, 0.001);
+        UpdateQuantized(Builder, Rotation.Yaw, 0.001);
+        UpdateQuantized(Builder, Rotation.Roll, 0.001);
+    }
+
+    UpdateValue(Builder, Entity.Tags.Num());
+    for (int32 Tag : Entity.Tags)
+    {
+        UpdateString(Builder, Snapshot.GetString(Tag));
+    }
+
+    // Component order follows registration, which is not stable across loads
+    TArray<uint64> ComponentHashes;
+    ComponentHashes.Reserve(Entity.Components.Num());
+    for (const FAegisSnapshotComponent& Component : Entity.Components)
+    {
+        FXxHash64Builder ComponentBuilder;
+        UpdateString(ComponentBuilder, Snapshot.GetString(Component.Class));
+        UpdateString(ComponentBuilder, Snapshot.GetString(Component.Name));
+        ComponentHashes.Add(ComponentBuilder.Finalize().Hash);
+    }
+    ComponentHashes.Sort();
+    UpdateValue(Builder, ComponentHashes.Num());
+    Builder.Update(ComponentHashes.GetData(), ComponentHashes.Num() * sizeof(uint64));
+
+    if (Properties.Num() > 0)
+    {
+        TSharedPtr<FJsonObject> PropertiesObject;
+        TSharedRef<TJsonReader<>> Reader = TJsonReaderFactory<>::Create(Entity.PropertiesJson);
+        const bool bHasProperties = !Entity.PropertiesJson.IsEmpty() && FJsonSerializer::Deserialize(Reader, PropertiesObject) && PropertiesObject.IsValid();
+
+        for (const FString& Property : Properties)
+        {
+            // Missing properties hash differently from empty ones
+            const TSharedPtr<FJsonValue> Value = bHasProperties ? PropertiesObject->TryGetField(Property) : TSharedPtr<FJsonValue>();
+            UpdateValue(Builder, Value.IsValid());
+            if (Value.IsValid())
+            {
+                FString ValueText;
+                TSharedRef<FAegisJsonWriter> Writer = FAegisJsonWriterFactory::Create(&ValueText);
+                FJsonSerializer::Serialize(Value, FString(), Writer);
+                UpdateString(Builder, ValueText);
+            }
+        }
+    }
+
+    return Builder.Finalize().Hash;
+}
+
+FString FAegisWorldHash::GetEntityLevel(const FAegisBinarySnapshot& Snapshot, const FAegisSnapshotEntity& Entity)
+{
+    // "/Game/Maps/Sub.Sub:PersistentLevel.Actor" belongs to "/Game/Maps/Sub"
+    const FString& Path = Snapshot.GetString(Entity.Path);
+    int32 Dot;
+    return Path.FindChar(TEXT('.'), Dot) ? Path.Left(Dot) : FString();
+}
+
+FString FAegisWorldHash::GetCellId(const FAegisWorldHashLevel& Level, const FAegisWorldHashCell& Cell)
+{
+    return FString::Printf(TEXT("%s@%d,%d"), *Level.Level, Cell.Coord.X, Cell.Coord.Y);
+}
+
+FString FAegisWorldHash::HashToString(uint64 Hash)
+{
+    return FString::Printf(TEXT("%016llx"), Hash);
+}
+
+void FAegisWorldHash::WriteJson(FAegisJsonWriter& Writer, int32 Depth) const
+{
+    Writer.WriteValue(TEXT("rootHash"), HashToString(RootHash));
+    Writer.WriteValue(TEXT("entityCount"), EntityCount);
+    Writer.WriteValue(TEXT("cellSize"), CellSize);
+
+    if (Depth < 1)
+    {
+        return;
+    }
+
+    Writer.WriteArrayStart(TEXT("levels"));
+    for (const FAegisWorldHashLevel& Level : Levels)
+    {
+        Writer.WriteObjectStart();
+        Writer.WriteValue(TEXT("id"), Level.Level);
+        Writer.WriteValue(TEXT("hash"), HashToString(Level.Hash));
+        Writer.WriteValue(TEXT("cellCount"), Level.Cells.Num());
+
+        if (Depth >= 2)
+        {
+            Writer.WriteArrayStart(TEXT("cells"));
+            for (const FAegisWorldHashCell& Cell : Level.Cells)
+            {
+                Writer.WriteObjectStart();
+                Writer.WriteValue(TEXT("id"), GetCellId(Level, Cell));
+                Writer.WriteValue(TEXT("x"), Cell.Coord.X);
+                Writer.WriteValue(TEXT("y"), Cell.Coord.Y);
+                Writer.WriteValue(TEXT("hash"), HashToString(Cell.Hash));
+                Writer.WriteValue(TEXT("entityCount"), Cell.Leaves.Num());
+
+                if (Depth >= 3)
+                {
+                    Writer.WriteArrayStart(TEXT("entities"));
+                    for (const FAegisWorldHashLeaf& Leaf : Cell.Leaves)
+                    {
+                        Writer.WriteObjectStart();
+                        Writer.WriteValue(TEXT("id"), Leaf.Key);
+                        Writer.WriteValue(TEXT("hash"), HashToString(Leaf.Hash));
+                        Writer.WriteObjectEnd();
+                    }
+                    Writer.WriteArrayEnd();
+                }
+
+                Writer.WriteObjectEnd();
+            }
+            Writer.WriteArrayEnd();
+        }
+
+        Writer.WriteObjectEnd();
+    }
+    Writer.WriteArrayEnd();
+}
+
+void FAegisWorldHash::WriteDiff(FAegisJsonWriter& Writer, const TMap<FString, FString>& KnownHashes) const
+{
+    const bool bMatch = MatchesKnown(KnownHashes, TEXT("root"), RootHash);
+    Writer.WriteValue(TEXT("match"), bMatch);
+
+    TSet<FString> CurrentIds;
+    Writer.WriteArrayStart(TEXT("mismatches"));
+    for (const FAegisWorldHashLevel& Level : Levels)
+    {
+        CurrentIds.Add(Level.Level);
+        const bool bLevelMatch = bMatch || MatchesKnown(KnownHashes, Level.Level, Level.Hash);
+        if (!bLevelMatch)
+        {
+            WriteMismatch(Writer, Level.Level, TEXT("level"), Level.Hash);
+        }
+
+        for (const FAegisWorldHashCell& Cell : Level.Cells)
+        {
+            FString CellId = GetCellId(Level, Cell);
+            const bool bCellMatch = bLevelMatch || MatchesKnown(KnownHashes, CellId, Cell.Hash);
+            if (!bCellMatch)
+            {
+                WriteMismatch(Writer, CellId, TEXT("cell"), Cell.Hash);
+            }
+
+            for (const FAegisWorldHashLeaf& Leaf : Cell.Leaves)
+            {
+                if (!bCellMatch && !MatchesKnown(KnownHashes, Leaf.Key, Leaf.Hash))
+                {
+                    WriteMismatch(Writer, Leaf.Key, TEXT("entity"), Leaf.Hash);
+                }
+                CurrentIds.Add(Leaf.Key);
+            }
+            CurrentIds.Add(MoveTemp(CellId));
+        }
+    }
+    Writer.WriteArrayEnd();
+
+    Writer.WriteArrayStart(TEXT("removed"));
+    for (const TPair<FString, FString>& Known : KnownHashes)
+    {
+        if (Known.Key != TEXT("root") && !CurrentIds.Contains(Known.Key))
+        {
+            Writer.WriteValue(Known.Key);
+        }
+    }
+    Writer.WriteArrayEnd();
+}
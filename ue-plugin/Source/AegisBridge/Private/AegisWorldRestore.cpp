@@ -0,0 +1,409 @@
+// Copyright AEGIS Team. All Rights Reserved.
+
+#include "AegisWorldRestore.h"
+#include "AegisBridgeModule.h"
+#include "AegisSeedSubsystem.h"
+#include "AegisSnapshotCompression.h"
+#include "Editor.h"
+#include "Engine/World.h"
+#include "GameFramework/Actor.h"
+#include "HAL/PlatformTime.h"
+#include "LevelUtils.h"
+#include "Misc/FileHelper.h"
+#include "Misc/ScopeExit.h"
+
+namespace
+{
+    /** Spawned actors between clock reads */
+    constexpr int32 DeadlineCheckInterval = 8;
+
+    FTransform GetEntityTransform(const FAegisSnapshotEntity& Entity)
+    {
+        return FTransform(FRotator(Entity.Rotation), FVector(Entity.Location), FVector(Entity.Scale));
+    }
+}
+
+FAegisWorldRestore::FAegisWorldRestore(UWorld* InWorld, FAegisBinarySnapshot&& InSnapshot, bool bInPreserveGUIDs)
+    : World(InWorld)
+    , Snapshot(MoveTemp(InSnapshot))
+    , bPreserveGUIDs(bInPreserveGUIDs)
+{
+}
+
+FAegisWorldRestore::~FAegisWorldRestore()
+{
+    if (Stage != EStage::Done)
+    {
+        Cancel();
+    }
+}
+
+void FAegisWorldRestore::AddReferencedObjects(FReferenceCollector& Collector)
+{
+    Collector.AddReferencedObjects(Classes);
+}
+
+bool FAegisWorldRestore::LoadSnapshotFile(const FString& InputPath, FAegisBinarySnapshot& OutSnapshot)
+{
+    TArray<uint8> Buffer;
+    TArray<uint8> Payload;
+    return FFileHelper::LoadFileToArray(Buffer, *InputPath) &&
+        (!FAegisSnapshotCompression::IsCompressed(Buffer) || FAegisSnapshotCompression::Decompress(Buffer, Payload)) &&
+        OutSnapshot.Load(Payload.Num() > 0 ? Payload : Buffer);
+}
+
+const TCHAR* FAegisWorldRestore::GetStageName() const
+{
+    switch (Stage)
+    {
+    case EStage::Resolve: return TEXT("resolving");
+    case EStage::Loading: return TEXT("loading");
+    case EStage::Spawn: return TEXT("spawning");
+    case EStage::Done: return TEXT("done");
+    }
+    return TEXT("unknown");
+}
+
+void FAegisWorldRestore::GetProgress(int64& OutDone, int64& OutTotal) const
+{
+    // Entities skipped at spawn count as done too, so the total is always reached
+    OutDone = NextSpawnIndex;
+    OutTotal = Snapshot.Entities.Num();
+}
+
+bool FAegisWorldRestore::Advance(double Deadline)
+{
+    // The transaction stays open between slices, so the target levels are locked while control is back with the user
+    SetEditsGated(false);
+    ON_SCOPE_EXIT
+    {
+        SetEditsGated(bTransactionOpen);
+    };
+
+    while (Stage != EStage::Done)
+    {
+        if (!World.IsValid())
+        {
+            Cancel();
+            bAborted = true;
+            return true;
+        }
+
+        switch (Stage)
+        {
+        case EStage::Resolve:
+            ResolveClasses(true);
+            Stage = LoadHandle.IsValid() ? EStage::Loading : EStage::Spawn;
+            break;
+
+        case EStage::Loading:
+            if (!LoadHandle->HasLoadCompleted())
+            {
+                return false;
+            }
+            CollectLoadedClasses();
+            Stage = EStage::Spawn;
+            break;
+
+        case EStage::Spawn:
+            BeginTransaction();
+            DestroyReplacedActors();
+            SpawnEntities(Deadline);
+            if (NextSpawnIndex < Snapshot.Entities.Num())
+            {
+                return false;
+            }
+            EndTransaction();
+            RegisterRestoredGUIDs();
+            Stage = EStage::Done;
+            break;
+
+        default:
+            break;
+        }
+
+        if (FPlatformTime::Seconds() >= Deadline && Stage != EStage::Done)
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+int32 FAegisWorldRestore::Run()
+{
+    if (!World.IsValid())
+    {
+        Stage = EStage::Done;
+        bAborted = true;
+        return 0;
+    }
+
+    BeginTransaction();
+    ResolveClasses(false);
+
+    Stage = EStage::Spawn;
+    DestroyReplacedActors();
+    SpawnEntities(MAX_dbl);
+
+    EndTransaction();
+    RegisterRestoredGUIDs();
+    Stage = EStage::Done;
+
+    return RestoredCount;
+}
+
+void FAegisWorldRestore::Cancel()
+{
+    if (LoadHandle.IsValid())
+    {
+        LoadHandle->CancelHandle();
+        LoadHandle.Reset();
+    }
+
+    SetEditsGated(false);
+
+    // Undoing the restore's own transaction removes the spawned actors and brings back the replaced ones
+    const bool bRollBack = bTransactionOpen && GEditor && World.IsValid();
+    EndTransaction();
+    if (bRollBack && !GEditor->IsTransactionActive() && GEditor->UndoTransaction(false))
+    {
+        UE_LOG(LogAegisBridge, Log, TEXT("Restore cancelled: rolled back %d spawned actors"), Spawned.Num());
+        Spawned.Reset();
+        RestoredCount = 0;
+    }
+    else if (bRollBack)
+    {
+        UE_LOG(LogAegisBridge, Warning, TEXT("Restore cancelled: could not roll back, %d actors stay"), Spawned.Num());
+    }
+
+    Stage = EStage::Done;
+}
+
+void FAegisWorldRestore::SetReplacedActors(const TArray<AActor*>& Actors)
+{
+    ReplacedActors.Reset(Actors.Num());
+    for (AActor* Actor : Actors)
+    {
+        ReplacedActors.Add(Actor);
+    }
+}
+
+void FAegisWorldRestore::DestroyReplacedActors()
+{
+    for (const TWeakObjectPtr<AActor>& ReplacedActor : ReplacedActors)
+    {
+        if (AActor* Actor = ReplacedActor.Get())
+        {
+            Actor->Destroy();
+        }
+    }
+
+    if (ReplacedActors.Num() > 0)
+    {
+        UE_LOG(LogAegisBridge, Log, TEXT("Restore: replaced %d tracked actors"), ReplacedActors.Num());
+        ReplacedActors.Empty();
+    }
+}
+
+void FAegisWorldRestore::BeginTransaction()
+{
+    if (!bTransactionOpen && GEditor)
+    {
+        GEditor->BeginTransaction(FText::FromString(TEXT("AEGIS Restore World State")));
+        bTransactionOpen = true;
+    }
+}
+
+void FAegisWorldRestore::EndTransaction()
+{
+    if (bTransactionOpen && GEditor)
+    {
+        GEditor->EndTransaction();
+    }
+    bTransactionOpen = false;
+}
+
+void FAegisWorldRestore::SetEditsGated(bool bGated)
+{
+    UWorld* TargetWorld = World.Get();
+    if (bGated && TargetWorld && GatedLevels.Num() == 0)
+    {
+        // Levels the user locked stay locked afterwards
+        for (ULevel* Level : TargetWorld->GetLevels())
+        {
+            if (Level && !FLevelUtils::IsLevelLocked(Level))
+            {
+                FLevelUtils::SetLevelLocked(Level, true);
+                GatedLevels.Add(Level);
+            }
+        }
+    }
+    else if (!bGated)
+    {
+        for (const TWeakObjectPtr<ULevel>& GatedLevel : GatedLevels)
+        {
+            if (ULevel* Level = GatedLevel.Get())
+            {
+                FLevelUtils::SetLevelLocked(Level, false);
+            }
+        }
+        GatedLevels.Reset();
+    }
+}
+
+UClass* FAegisWorldRestore::FindLoadedClass(const FString& ClassName)
+{
+    // Full paths resolve directly; captures store short native names such as "StaticMeshActor"
+    UClass* Class = ClassName.Contains(TEXT("."))
+        ? FindObject<UClass>(nullptr, *ClassName)
+        : FindFirstObject<UClass>(*ClassName, EFindFirstObjectOptions::None);
+
+    return Class && Class->IsChildOf(AActor::StaticClass()) ? Class : nullptr;
+}
+
+UClass* FAegisWorldRestore::ResolveClass(const FString& ClassName)
+{
+    if (UClass* Class = FindLoadedClass(ClassName))
+    {
+        return Class;
+    }
+    return ClassName.StartsWith(TEXT("/")) ? LoadClass<AActor>(nullptr, *ClassName) : nullptr;
+}
+
+void FAegisWorldRestore::ResolveClasses(bool bAsyncLoad)
+{
+    TArray<FSoftObjectPath> LoadPaths;
+
+    for (const FAegisSnapshotEntity& Entity : Snapshot.Entities)
+    {
+        if (Classes.Contains(Entity.Class))
+        {
+            continue;
+        }
+
+        const FString& ClassName = Snapshot.GetString(Entity.Class);
+        UClass* Class = FindLoadedClass(ClassName);
+        Classes.Add(Entity.Class, Class);
+
+        // Unloaded Blueprint classes are only reachable by package path
+        if (!Class && ClassName.StartsWith(TEXT("/")))
+        {
+            FSoftClassPath ClassPath(ClassName);
+            if (ClassPath.IsValid())
+            {
+                LoadPaths.Add(ClassPath);
+                PendingLoads.Emplace(Entity.Class, MoveTemp(ClassPath));
+            }
+        }
+    }
+
+    if (LoadPaths.Num() == 0)
+    {
+        return;
+    }
+
+    UE_LOG(LogAegisBridge, Log, TEXT("Restore: %d of %d classes need loading"), LoadPaths.Num(), Classes.Num());
+
+    if (bAsyncLoad)
+    {
+        LoadHandle = StreamableManager.RequestAsyncLoad(MoveTemp(LoadPaths), FStreamableDelegate(), FStreamableManager::AsyncLoadHighPriority);
+        if (!LoadHandle.IsValid())
+        {
+            // Everything was already loaded by the time of the request
+            CollectLoadedClasses();
+        }
+    }
+    else
+    {
+        LoadHandle = StreamableManager.RequestSyncLoad(MoveTemp(LoadPaths));
+        CollectLoadedClasses();
+    }
+}
+
+void FAegisWorldRestore::CollectLoadedClasses()
+{
+    for (const TPair<int32, FSoftClassPath>& Pending : PendingLoads)
+    {
+        UClass* Class = Pending.Value.ResolveClass();
+        if (Class && Class->IsChildOf(AActor::StaticClass()))
+        {
+            Classes.Add(Pending.Key, Class);
+        }
+        else
+        {
+            UE_LOG(LogAegisBridge, Warning, TEXT("Restore: failed to load class %s"), *Pending.Value.ToString());
+        }
+    }
+    PendingLoads.Empty();
+
+    // The resolved classes are referenced from Classes from here on
+    LoadHandle.Reset();
+}
+
+void FAegisWorldRestore::SpawnEntities(double Deadline)
+{
+    UWorld* TargetWorld = World.Get();
+    Spawned.Reserve(Snapshot.Entities.Num());
+
+    int32 SinceCheck = 0;
+    while (NextSpawnIndex < Snapshot.Entities.Num())
+    {
+        if (++SinceCheck >= DeadlineCheckInterval)
+        {
+            SinceCheck = 0;
+            if (FPlatformTime::Seconds() >= Deadline)
+            {
+                return;
+            }
+        }
+
+        const int32 EntityIndex = NextSpawnIndex++;
+        const FAegisSnapshotEntity& Entity = Snapshot.Entities[EntityIndex];
+
+        UClass* Class = Classes.FindRef(Entity.Class);
+        if (!Class)
+        {
+            ++MissingClassCount;
+            continue;
+        }
+
+        // Construction is deferred to FinishSpawning right below, so it runs once with the full
+        // transform, scale included, and no unconstructed actor outlives the slice
+        FActorSpawnParameters SpawnParams;
+        SpawnParams.Name = *Snapshot.GetString(Entity.Name);
+        SpawnParams.NameMode = FActorSpawnParameters::ESpawnActorNameMode::Requested;
+        SpawnParams.bDeferConstruction = true;
+
+        const FTransform Transform = GetEntityTransform(Entity);
+        AActor* Actor = TargetWorld->SpawnActor(Class, &Transform, SpawnParams);
+        if (!Actor)
+        {
+            continue;
+        }
+
+        Actor->FinishSpawning(Transform);
+        Spawned.Add({ Actor, EntityIndex });
+        ++RestoredCount;
+    }
+}
+
+void FAegisWorldRestore::RegisterRestoredGUIDs()
+{
+    UAegisSeedSubsystem* Seed = bPreserveGUIDs ? UAegisSeedSubsystem::Get() : nullptr;
+    if (!Seed)
+    {
+        return;
+    }
+
+    for (const FPendingActor& Pending : Spawned)
+    {
+        const FAegisSnapshotEntity& Entity = Snapshot.Entities[Pending.EntityIndex];
+        const FString& EntityGUID = Snapshot.GetString(Entity.GUID);
+        AActor* Actor = Pending.Actor.Get();
+        if (Actor && !EntityGUID.IsEmpty())
+        {
+            Seed->RegisterGUID(EntityGUID, Actor->GetPathName(), Snapshot.GetString(Entity.Class), TEXT("{}"));
+        }
+    }
+}
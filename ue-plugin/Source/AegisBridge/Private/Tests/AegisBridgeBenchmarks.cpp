@@ -0,0 +1,481 @@
+// Copyright AEGIS Team. All Rights Reserved.
+
+#include "AegisBridgeModule.h"
+#include "AegisActorIndex.h"
+#include "AegisBinarySnapshot.h"
+#include "AegisBridgeStats.h"
+#include "AegisJsonWriter.h"
+#include "AegisParallelJson.h"
+#include "AegisRemoteControlHandler.h"
+#include "AegisSeedSubsystem.h"
+#include "AegisSubsystem.h"
+#include "Algo/Find.h"
+#include "Compression/OodleDataCompression.h"
+#include "Dom/JsonObject.h"
+#include "Editor.h"
+#include "Engine/StaticMeshActor.h"
+#include "Engine/TargetPoint.h"
+#include "Engine/World.h"
+#include "HAL/FileManager.h"
+#include "HAL/PlatformMisc.h"
+#include "HAL/PlatformProperties.h"
+#include "Math/RandomStream.h"
+#include "Misc/App.h"
+#include "Misc/AutomationTest.h"
+#include "Misc/CommandLine.h"
+#include "Misc/EngineVersion.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include "Serialization/JsonReader.h"
+#include "Serialization/JsonSerializer.h"
+#include "Tests/AutomationEditorCommon.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+/**
+ * Hot path benchmarks of the bridge, on synthetic worlds of 1k, 10k and 100k actors.
+ *
+ * Run from a build agent with
+ *   UnrealEditor-Cmd <Project> -nullrhi -unattended -ExecCmds="Automation RunTests AEGIS.Benchmarks; Quit"
+ * Each world size writes Saved/Aegis/Benchmarks/HotPaths-<ActorCount>.json, or into
+ * -AegisBenchmarkDir=<Dir>: build and machine info plus, per case, latency in microseconds
+ * (count, min, mean, p50, p90, p99, p999, max), items per second and bytes produced.
+ */
+namespace AegisBenchmarks
+{
+    struct FWorldSize
+    {
+        int32 ActorCount;
+
+        /** Samples of the heavy cases; the light ones take ten times as many */
+        int32 Iterations;
+
+        /** Samples of RestoreWorldState, each into a fresh map */
+        int32 RestoreIterations;
+    };
+
+    static const FWorldSize WorldSizes[] =
+    {
+        { 1000, 20, 5 },
+        { 10000, 10, 3 },
+        { 100000, 3, 1 },
+    };
+
+    /** Lookups, GUIDs and requests per light sample */
+    static constexpr int32 BatchSize = 1000;
+
+    static const TCHAR* SubsystemPath = TEXT("/Script/AegisBridge.AegisSubsystem");
+    static const TCHAR* SeedSubsystemPath = TEXT("/Script/AegisBridge.AegisSeedSubsystem");
+
+    struct FCaseResult
+    {
+        FString Name;
+        FAegisLatencyHistogram Latency;
+        int64 ItemsPerIteration = 1;
+        int64 Bytes = 0;
+    };
+
+    /**
+     * Times cases and writes their results. A case runs once untimed to warm caches, then
+     * Iterations times; Setup runs before each sample, outside the timing. Body returns the
+     * bytes it produced, or 0.
+     */
+    class FBenchmarkRun
+    {
+    public:
+        explicit FBenchmarkRun(int32 InActorCount)
+            : ActorCount(InActorCount)
+        {
+        }
+
+        void Measure(const TCHAR* Name, int32 Iterations, int64 ItemsPerIteration, TFunctionRef<int64()> Body)
+        {
+            Measure(Name, Iterations, ItemsPerIteration, Body, []() {}, true);
+        }
+
+        void Measure(const TCHAR* Name, int32 Iterations, int64 ItemsPerIteration, TFunctionRef<int64()> Body, TFunctionRef<void()> Setup, bool bWarmup)
+        {
+            if (bWarmup)
+            {
+                Setup();
+                Body();
+            }
+
+            FCaseResult& Result = Results.AddDefaulted_GetRef();
+            Result.Name = Name;
+            Result.ItemsPerIteration = ItemsPerIteration;
+
+            for (int32 Iteration = 0; Iteration < Iterations; ++Iteration)
+            {
+                Setup();
+
+                const uint64 StartCycles = FPlatformTime::Cycles64();
+                Result.Bytes = Body();
+                Result.Latency.Record(static_cast<uint64>(FPlatformTime::ToSeconds64(FPlatformTime::Cycles64() - StartCycles) * 1000000.0));
+            }
+
+            UE_LOG(LogAegisBridge, Display, TEXT("Benchmark %d actors  %-32s p50=%-9llu p99=%-9llu max=%-9llu us  %.0f items/s"),
+                ActorCount, Name, Result.Latency.GetPercentile(50.0), Result.Latency.GetPercentile(99.0), Result.Latency.GetMax(),
+                GetItemsPerSecond(Result));
+        }
+
+        /** Write the results file; returns its path, or empty on failure */
+        FString Save() const
+        {
+            FString OutputDir;
+            if (!FParse::Value(FCommandLine::Get(), TEXT("AegisBenchmarkDir="), OutputDir))
+            {
+                OutputDir = FPaths::Combine(FPaths::ProjectSavedDir(), TEXT("Aegis"), TEXT("Benchmarks"));
+            }
+
+            FString Json;
+            TSharedRef<FAegisJsonWriter> Writer = FAegisJsonWriterFactory::Create(&Json);
+            Writer->WriteObjectStart();
+            Writer->WriteValue(TEXT("suite"), TEXT("AEGIS.Benchmarks.HotPaths"));
+            Writer->WriteValue(TEXT("actorCount"), ActorCount);
+            Writer->WriteValue(TEXT("timestamp"), FDateTime::UtcNow().ToIso8601());
+
+            Writer->WriteObjectStart(TEXT("build"));
+            Writer->WriteValue(TEXT("engineVersion"), FEngineVersion::Current().ToString());
+            Writer->WriteValue(TEXT("changelist"), static_cast<int64>(FEngineVersion::Current().GetChangelist()));
+            Writer->WriteValue(TEXT("buildVersion"), FString(FApp::GetBuildVersion()));
+            Writer->WriteValue(TEXT("configuration"), FString(LexToString(FApp::GetBuildConfiguration())));
+            Writer->WriteObjectEnd();
+
+            Writer->WriteObjectStart(TEXT("machine"));
+            Writer->WriteValue(TEXT("platform"), FString(FPlatformProperties::IniPlatformName()));
+            Writer->WriteValue(TEXT("cpu"), FPlatformMisc::GetCPUBrand().TrimStartAndEnd());
+            Writer->WriteValue(TEXT("cores"), FPlatformMisc::NumberOfCoresIncludingHyperthreads());
+            Writer->WriteValue(TEXT("canRender"), FApp::CanEverRender());
+            Writer->WriteObjectEnd();
+
+            Writer->WriteArrayStart(TEXT("results"));
+            for (const FCaseResult& Result : Results)
+            {
+                Writer->WriteObjectStart();
+                Writer->WriteValue(TEXT("name"), Result.Name);
+                Result.Latency.WriteFields(*Writer);
+                Writer->WriteValue(TEXT("itemsPerIteration"), Result.ItemsPerIteration);
+                Writer->WriteValue(TEXT("itemsPerSecond"), GetItemsPerSecond(Result));
+                Writer->WriteValue(TEXT("bytes"), Result.Bytes);
+                Writer->WriteObjectEnd();
+            }
+            Writer->WriteArrayEnd();
+
+            Writer->WriteObjectEnd();
+            Writer->Close();
+
+            const FString FilePath = FPaths::Combine(OutputDir, FString::Printf(TEXT("HotPaths-%d.json"), ActorCount));
+            return FFileHelper::SaveStringToFile(Json, *FilePath, FFileHelper::EEncodingOptions::ForceUTF8WithoutBOM) ? FilePath : FString();
+        }
+
+    private:
+        static double GetItemsPerSecond(const FCaseResult& Result)
+        {
+            const uint64 TotalMicros = Result.Latency.GetTotal();
+            return TotalMicros > 0 ? Result.Latency.GetCount() * Result.ItemsPerIteration * 1000000.0 / TotalMicros : 0.0;
+        }
+
+    private:
+        int32 ActorCount;
+        TArray<FCaseResult> Results;
+    };
+
+    /**
+     * Fill a fresh map with ActorCount actors laid out from a fixed seed: 70% static mesh
+     * actors without a mesh, the rest target points, every tenth tagged "AegisBench".
+     */
+    static void PopulateWorld(UWorld* World, int32 ActorCount, TArray<AActor*>& OutActors)
+    {
+        FRandomStream Random(0xAE615);
+        OutActors.Reset(ActorCount);
+
+        FActorSpawnParameters SpawnParams;
+        SpawnParams.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AlwaysSpawn;
+
+        for (int32 Index = 0; Index < ActorCount; ++Index)
+        {
+            const FVector Location(Random.FRandRange(-500000.0, 500000.0), Random.FRandRange(-500000.0, 500000.0), Random.FRandRange(0.0, 20000.0));
+            const FRotator Rotation(0.0, Random.FRandRange(-180.0, 180.0), 0.0);
+
+            SpawnParams.Name = *FString::Printf(TEXT("AegisBench_%d"), Index);
+            UClass* ActorClass = Random.FRand() < 0.7f ? AStaticMeshActor::StaticClass() : ATargetPoint::StaticClass();
+
+            AActor* Actor = World->SpawnActor<AActor>(ActorClass, Location, Rotation, SpawnParams);
+            if (Actor)
+            {
+                if (Index % 10 == 0)
+                {
+                    Actor->Tags.Add(TEXT("AegisBench"));
+                }
+                OutActors.Add(Actor);
+            }
+        }
+    }
+
+    /** The "actors" array of a CaptureAllActors document, as text */
+    static FString GetCapturedActors(const FString& Capture)
+    {
+        TArray<TPair<FStringView, FStringView>> Members;
+        if (FAegisParallelJson::SplitObject(Capture, Members))
+        {
+            for (const TPair<FStringView, FStringView>& Member : Members)
+            {
+                if (Member.Key == TEXT("actors"))
+                {
+                    return FString(Member.Value);
+                }
+            }
+        }
+        return FString();
+    }
+
+    /** Whether a HandleRequest response parses and reports success */
+    static bool IsSuccessResponse(const FString& Response)
+    {
+        TSharedPtr<FJsonObject> ResponseObject;
+        TSharedRef<TJsonReader<>> Reader = TJsonReaderFactory<>::Create(Response);
+        bool bSuccess = false;
+        return FJsonSerializer::Deserialize(Reader, ResponseObject) && ResponseObject.IsValid()
+            && ResponseObject->TryGetBoolField(TEXT("success"), bSuccess) && bSuccess;
+    }
+
+    /** Release a finished world size: an empty map, no undo history, no garbage */
+    static void ReleaseWorld()
+    {
+        FAutomationEditorCommonUtils::CreateNewMap();
+        if (GEditor)
+        {
+            GEditor->ResetTransaction(FText::FromString(TEXT("AEGIS benchmark")));
+        }
+        CollectGarbage(GARBAGE_COLLECTION_KEEPFLAGS);
+    }
+}
+
+IMPLEMENT_COMPLEX_AUTOMATION_TEST(FAegisHotPathBenchmark, "AEGIS.Benchmarks.HotPaths",
+    EAutomationTestFlags::EditorContext | EAutomationTestFlags::PerfFilter)
+
+void FAegisHotPathBenchmark::GetTests(TArray<FString>& OutBeautifiedNames, TArray<FString>& OutTestCommands) const
+{
+    for (const AegisBenchmarks::FWorldSize& Size : AegisBenchmarks::WorldSizes)
+    {
+        OutBeautifiedNames.Add(FString::Printf(TEXT("%dk Actors"), Size.ActorCount / 1000));
+        OutTestCommands.Add(LexToString(Size.ActorCount));
+    }
+}
+
+bool FAegisHotPathBenchmark::RunTest(const FString& Parameters)
+{
+    using namespace AegisBenchmarks;
+
+    int32 ActorCount = 0;
+    LexFromString(ActorCount, *Parameters);
+
+    const FWorldSize* Size = Algo::FindBy(WorldSizes, ActorCount, &FWorldSize::ActorCount);
+    UAegisSubsystem* Subsystem = UAegisSubsystem::Get();
+    UAegisSeedSubsystem* Seed = UAegisSeedSubsystem::Get();
+    UAegisRemoteControlHandler* Handler = UAegisRemoteControlHandler::Get();
+    if (!Size || !Subsystem || !Seed || !Handler)
+    {
+        AddError(FString::Printf(TEXT("Cannot run the hot path benchmark for '%s'; the bridge is not initialized"), *Parameters));
+        return false;
+    }
+
+    UWorld* World = FAutomationEditorCommonUtils::CreateNewMap();
+    if (!TestNotNull(TEXT("Benchmark world"), World))
+    {
+        return false;
+    }
+
+    TArray<AActor*> Actors;
+    PopulateWorld(World, ActorCount, Actors);
+    if (!TestEqual(TEXT("Spawned actors"), Actors.Num(), ActorCount))
+    {
+        ReleaseWorld();
+        return false;
+    }
+
+    FBenchmarkRun Run(ActorCount);
+    const int32 Iterations = Size->Iterations;
+    const int32 LightIterations = Size->Iterations * 10;
+
+    // Capture and query
+    FString Capture;
+    Run.Measure(TEXT("CaptureAllActors"), Iterations, ActorCount, [&]()
+    {
+        Capture = Seed->CaptureAllActors(TArray<FString>(), TArray<FString>());
+        return static_cast<int64>(Capture.Len());
+    });
+
+    Run.Measure(TEXT("CaptureAllActors.TagFilter"), Iterations, ActorCount, [&]()
+    {
+        return static_cast<int64>(Seed->CaptureAllActors(TArray<FString>(), { TEXT("AegisBench") }).Len());
+    });
+
+    Run.Measure(TEXT("QueryActors.Class"), Iterations, ActorCount, [&]()
+    {
+        return static_cast<int64>(Subsystem->QueryActors(TEXT("TargetPoint"), FString(), TArray<FString>()).Data.Len());
+    });
+
+    Run.Measure(TEXT("QueryActors.Tag"), Iterations, ActorCount, [&]()
+    {
+        return static_cast<int64>(Subsystem->QueryActors(FString(), FString(), { TEXT("AegisBench") }).Data.Len());
+    });
+
+    Run.Measure(TEXT("QueryActors.Name"), Iterations, ActorCount, [&]()
+    {
+        return static_cast<int64>(Subsystem->QueryActors(FString(), TEXT("AegisBench_7"), TArray<FString>()).Data.Len());
+    });
+
+    // Path resolution, through the index UAegisSubsystem::FindActorByPath uses
+    FRandomStream Random(0xAE616);
+    TArray<FString> Paths;
+    TArray<FString> Names;
+    for (int32 Index = 0; Index < BatchSize; ++Index)
+    {
+        const AActor* Actor = Actors[Random.RandHelper(Actors.Num())];
+        Paths.Add(Actor->GetPathName());
+        Names.Add(Actor->GetName());
+    }
+
+    FAegisActorIndex& ActorIndex = FAegisBridgeModule::Get().GetActorIndex();
+    int32 Misses = 0;
+    Run.Measure(TEXT("FindActorByPath"), LightIterations, BatchSize, [&]()
+    {
+        for (const FString& Path : Paths)
+        {
+            Misses += ActorIndex.FindActor(World, Path) ? 0 : 1;
+        }
+        return int64(0);
+    });
+
+    Run.Measure(TEXT("FindActorByName"), LightIterations, BatchSize, [&]()
+    {
+        for (const FString& Name : Names)
+        {
+            Misses += ActorIndex.FindActor(World, Name) ? 0 : 1;
+        }
+        return int64(0);
+    });
+    TestEqual(TEXT("Unresolved actor lookups"), Misses, 0);
+
+    // GUID throughput
+    Run.Measure(TEXT("GenerateGUID"), LightIterations, BatchSize, [&]()
+    {
+        for (int32 Counter = 0; Counter < BatchSize; ++Counter)
+        {
+            Seed->GenerateGUID(TEXT("aegis-bench"), TEXT("Actor"), TEXT("bench-seed"), Counter, TEXT("AegisBench"));
+        }
+        return int64(0);
+    });
+
+    Run.Measure(TEXT("GenerateGUIDBatch"), LightIterations, BatchSize, [&]()
+    {
+        return static_cast<int64>(Seed->GenerateGUIDBatch(TEXT("aegis-bench"), TEXT("Actor"), TEXT("bench-seed"), 0, BatchSize).Num());
+    });
+
+    // Snapshot export and import, through each file format
+    const FString Entities = GetCapturedActors(Capture);
+    if (!TestFalse(TEXT("Captured actors are empty"), Entities.IsEmpty()))
+    {
+        ReleaseWorld();
+        return false;
+    }
+    const FString SnapshotData = FString::Printf(TEXT("{\"id\":\"aegis-bench\",\"name\":\"AEGIS benchmark %d\",\"entities\":%s}"), ActorCount, *Entities);
+
+    struct FSnapshotFormat
+    {
+        const TCHAR* Name;
+        const TCHAR* Extension;
+        bool bBinary;
+        const TCHAR* Codec;
+    };
+    const FSnapshotFormat Formats[] =
+    {
+        { TEXT("Json"), TEXT(".json"), false, TEXT("none") },
+        { TEXT("Binary"), FAegisBinarySnapshot::FileExtension, true, TEXT("none") },
+        { TEXT("BinaryKraken"), FAegisBinarySnapshot::FileExtension, true, TEXT("kraken") },
+    };
+
+    const FString SnapshotDir = FPaths::Combine(FPaths::ProjectIntermediateDir(), TEXT("AegisBenchmarks"));
+    for (const FSnapshotFormat& Format : Formats)
+    {
+        const FString SnapshotPath = FPaths::Combine(SnapshotDir, FString::Printf(TEXT("HotPaths-%d-%s%s"), ActorCount, Format.Name, Format.Extension));
+
+        bool bExported = true;
+        Run.Measure(*FString::Printf(TEXT("ExportSnapshot.%s"), Format.Name), Iterations, ActorCount, [&]()
+        {
+            bExported &= Seed->ExportSnapshotWithOptions(TEXT("aegis-bench"), SnapshotData, SnapshotPath, Format.bBinary, Format.Codec,
+                static_cast<int32>(FOodleDataCompression::ECompressionLevel::Normal));
+            return IFileManager::Get().FileSize(*SnapshotPath);
+        });
+
+        bool bImported = bExported;
+        Run.Measure(*FString::Printf(TEXT("ImportSnapshot.%s"), Format.Name), Iterations, ActorCount, [&]()
+        {
+            const FString Imported = Seed->ImportSnapshot(SnapshotPath);
+            bImported &= !Imported.IsEmpty();
+            return static_cast<int64>(Imported.Len());
+        });
+
+        TestTrue(*FString::Printf(TEXT("%s snapshot round trip"), Format.Name), bExported && bImported);
+    }
+    IFileManager::Get().DeleteDirectory(*SnapshotDir, false, true);
+
+    // Request round trips: build the parameters, dispatch, parse the response as a client would
+    struct FRequestCase
+    {
+        const TCHAR* Name;
+        const TCHAR* ObjectPath;
+        const TCHAR* Function;
+        FString Parameters;
+    };
+    const FRequestCase Requests[] =
+    {
+        { TEXT("HandleRequest.GetLevelInfo"), SubsystemPath, TEXT("GetLevelInfo"), TEXT("{}") },
+        { TEXT("HandleRequest.GetActorInfo"), SubsystemPath, TEXT("GetActorInfo"), FString::Printf(TEXT("{\"ActorPath\":\"%s\",\"bIncludeComponents\":true}"), *Paths[0]) },
+        { TEXT("HandleRequest.QueryActors"), SubsystemPath, TEXT("QueryActors"), TEXT("{\"ClassFilter\":\"TargetPoint\",\"Limit\":100}") },
+        { TEXT("HandleRequest.GenerateGUIDBatch"), SeedSubsystemPath, TEXT("GenerateGUIDBatch"), TEXT("{\"Namespace\":\"aegis-bench\",\"EntityType\":\"Actor\",\"Seed\":\"bench-seed\",\"StartCounter\":0,\"Count\":100}") },
+    };
+
+    for (const FRequestCase& Request : Requests)
+    {
+        bool bSucceeded = true;
+        Run.Measure(Request.Name, LightIterations, 1, [&]()
+        {
+            const FString Response = Handler->HandleRequest(Request.ObjectPath, Request.Function, Request.Parameters);
+            bSucceeded &= IsSuccessResponse(Response);
+            return static_cast<int64>(Response.Len());
+        });
+        TestTrue(*FString::Printf(TEXT("%s succeeded"), Request.Name), bSucceeded);
+    }
+
+    // Restore, each sample into a fresh map so actor names never collide
+    Actors.Reset();
+    UWorld* RestoreWorld = nullptr;
+    bool bRestored = true;
+    Run.Measure(TEXT("RestoreWorldState"), Size->RestoreIterations, ActorCount, [&]()
+    {
+        bRestored &= Seed->RestoreWorldState(TEXT("aegis-bench"), Entities, TEXT("merge"), false);
+        return static_cast<int64>(Entities.Len());
+    },
+    [&]()
+    {
+        RestoreWorld = FAutomationEditorCommonUtils::CreateNewMap();
+    },
+    false);
+
+    TestTrue(TEXT("RestoreWorldState succeeded"), bRestored);
+    TestTrue(TEXT("Restored actors"), RestoreWorld && RestoreWorld->GetActorCount() >= ActorCount);
+
+    const FString ResultsPath = Run.Save();
+    if (TestFalse(TEXT("Benchmark results written"), ResultsPath.IsEmpty()))
+    {
+        AddInfo(FString::Printf(TEXT("Benchmark results: %s"), *ResultsPath));
+    }
+
+    ReleaseWorld();
+    return true;
+}
+
+#endif // WITH_DEV_AUTOMATION_TESTS
@@ -0,0 +1,89 @@
+// Copyright AEGIS Team. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+class AActor;
+class FAegisActorQuery;
+class FAegisGUIDRegistry;
+class UWorld;
+
+/**
+ * AEGIS Actor Capture
+ * Two-phase actor capture. Gather copies the raw state the capture schema needs into flat
+ * arrays on the game thread: transforms, names, interned class and outer ids, and tag and
+ * component ranges. Filtering, GUID lookup and JSON encoding then run across worker threads
+ * on those arrays alone, without touching a UObject.
+ *
+ * Encoded actors are the objects of the CaptureAllActors "actors" array.
+ */
+class AEGISBRIDGE_API FAegisActorCapture
+{
+public:
+    /** Actors encoded per worker task */
+    static constexpr int32 ActorsPerTask = 128;
+
+    /** Gather every actor of a world. Game thread only. */
+    void Gather(UWorld* World);
+
+    /** Gather the given actors, in order. Game thread only. */
+    void Gather(TConstArrayView<AActor*> Actors);
+
+    int32 Num() const { return Names.Num(); }
+
+    /**
+     * Indices of the actors passing the query's class and tag filters, in gather order.
+     * Class decisions are made on the calling thread, one per class; tags are tested on workers.
+     */
+    void Filter(const FAegisActorQuery& Query, TArray<int32>& OutIndices) const;
+
+    /** Indices of every gathered actor */
+    void GetAllIndices(TArray<int32>& OutIndices) const;
+
+    /**
+     * Encode actor objects in parallel. Each batch holds the actors of one task joined by
+     * Separator; join non-empty batches with Separator for the full sequence.
+     * GUIDRegistry is only read, and must not change until the call returns.
+     */
+    void Encode(TConstArrayView<int32> Indices, const FAegisGUIDRegistry& GUIDRegistry, const TCHAR* Separator, TArray<FString>& OutBatches) const;
+
+    /** Encode the actors as a JSON array document */
+    FString EncodeArray(TConstArrayView<int32> Indices, const FAegisGUIDRegistry& GUIDRegistry) const;
+
+    /** Full object path of a gathered actor, as AActor::GetPathName returns it */
+    FString GetPath(int32 Index) const;
+
+private:
+    void Reserve(int32 Count);
+    void GatherActor(AActor* Actor);
+
+    int32 InternClass(UClass* Class);
+
+    void EncodeActor(FString& Out, int32 Index, const FAegisGUIDRegistry& GUIDRegistry) const;
+
+private:
+    // Per actor
+    TArray<FVector> Locations;
+    TArray<FRotator> Rotations;
+    TArray<FVector> Scales;
+    TArray<FName> Names;
+    TArray<int32> ClassIds;
+    TArray<int32> OuterIds;
+    TArray<int32> TagStarts;
+    TArray<int32> ComponentStarts;
+
+    // Flattened ranges; actor I owns [Starts[I], Starts[I + 1])
+    TArray<FName> Tags;
+    TArray<FName> ComponentNames;
+    TArray<int32> ComponentClassIds;
+
+    /** Classes and their names by class id. The classes are only dereferenced on the game thread. */
+    TArray<const UClass*> Classes;
+    TArray<FString> ClassNames;
+    TMap<UClass*, int32> ClassLookup;
+
+    /** Outer path plus delimiter by outer id, so actor paths are built without the UObject */
+    TArray<FString> OuterPrefixes;
+    TMap<UObject*, int32> OuterLookup;
+};
@@ -0,0 +1,92 @@
+// Copyright AEGIS Team. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "UObject/ObjectKey.h"
+#include "UObject/WeakObjectPtr.h"
+
+class AActor;
+class ULevel;
+class UWorld;
+
+/**
+ * AEGIS Actor Index
+ * World-scoped hash index of actors by name, path and class.
+ * Built lazily once per map and kept current by the bridge module's editor delegates,
+ * so actor path resolution never has to walk every actor in the world.
+ */
+class AEGISBRIDGE_API FAegisActorIndex
+{
+public:
+    /** Resolve an actor by full object path or by name. Returns nullptr if not found. */
+    AActor* FindActor(UWorld* World, const FString& PathOrName);
+
+    /** Collect all indexed actors of the given class, optionally including subclasses */
+    void GetActorsOfClass(UWorld* World, const UClass* Class, bool bIncludeSubclasses, TArray<AActor*>& OutActors);
+
+    /** Collect the distinct exact classes of the indexed actors, one per class bucket */
+    void GetClasses(UWorld* World, TArray<UClass*>& OutClasses);
+
+    /** Collect every indexed actor in the world */
+    void GetAllActors(UWorld* World, TArray<AActor*>& OutActors);
+
+    /** Number of indexed actors */
+    int32 Num() const { return Entries.Num(); }
+
+    /** Drop the current index and rebuild it from the given world */
+    void Rebuild(UWorld* World);
+
+    /** Mark the index stale; it is rebuilt on the next lookup */
+    void Invalidate() { bDirty = true; }
+
+    /** Clear all index data */
+    void Reset();
+
+    /** Delegate hooks, called by FAegisBridgeModule */
+    void OnActorAdded(AActor* Actor);
+    void OnActorRemoved(AActor* Actor);
+    void OnLevelAdded(ULevel* Level, UWorld* World);
+    void OnLevelRemoved(ULevel* Level, UWorld* World);
+
+private:
+    /** Per-actor bookkeeping, used to unindex an actor even after it was renamed */
+    struct FEntry
+    {
+        TWeakObjectPtr<AActor> Actor;
+        FString Path;
+        FName Name;
+        TObjectKey<UClass> Class;
+    };
+
+    /** Rebuild if the index is stale or was built for a different world */
+    void EnsureBuilt(UWorld* World);
+
+    /** Add a single actor to all lookup tables */
+    void AddActor(AActor* Actor);
+
+    /** Remove a single actor from all lookup tables */
+    void RemoveActor(const TObjectKey<AActor>& ActorKey);
+
+    /** Check that a cached actor is still alive and belongs to the indexed world */
+    bool IsUsable(const AActor* Actor) const;
+
+private:
+    /** World the index was built for */
+    TWeakObjectPtr<UWorld> IndexedWorld;
+
+    /** True when the index must be rebuilt before the next lookup */
+    bool bDirty = true;
+
+    /** Full object path -> actor */
+    TMap<FString, TWeakObjectPtr<AActor>> ByPath;
+
+    /** Object name -> actors (names are only unique per level) */
+    TMultiMap<FName, TWeakObjectPtr<AActor>> ByName;
+
+    /** Exact class -> actors */
+    TMap<TObjectKey<UClass>, TSet<TWeakObjectPtr<AActor>>> ByClass;
+
+    /** Actor -> indexed keys */
+    TMap<TObjectKey<AActor>, FEntry> Entries;
+};
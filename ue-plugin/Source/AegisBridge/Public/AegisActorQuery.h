@@ -0,0 +1,86 @@
+// Copyright AEGIS Team. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+class AActor;
+class FAegisActorIndex;
+class UWorld;
+
+/** Filters and paging for an actor query. Empty fields do not filter. */
+struct FAegisActorQueryParams
+{
+    /** Any of: a class name or path (matches the class and its subclasses), or text contained in the class name */
+    TArray<FString> ClassFilter;
+
+    /** Text contained in the actor name, case-insensitive */
+    FString NameFilter;
+
+    /** All of these tags */
+    TArray<FString> TagFilter;
+
+    /** Actor location inside this box */
+    TOptional<FBox> Bounds;
+
+    /** Results are ordered nearest first from this point */
+    TOptional<FVector> Origin;
+
+    /** With Origin: only actors within this distance. Zero or less is unbounded. */
+    double Radius = 0.0;
+
+    /** Skipped matches, after ordering: nearest first with Origin, by actor name otherwise */
+    int32 Offset = 0;
+
+    /** Maximum actors returned. Zero or less is unlimited. */
+    int32 Limit = 0;
+};
+
+/**
+ * AEGIS Actor Query
+ * Filters compiled once against the name table and class hierarchy, so matching an actor
+ * compares FNames and cached per-class decisions instead of building strings.
+ * Execute draws candidates from the actor index's class buckets.
+ *
+ * Game thread only; the per-class decisions are cached on first use.
+ */
+class AEGISBRIDGE_API FAegisActorQuery
+{
+public:
+    explicit FAegisActorQuery(const FAegisActorQueryParams& InParams);
+
+    /** True if the actor passes the class, name, tag and spatial filters. Paging is not applied. */
+    bool Matches(const AActor* Actor) const;
+
+    /** True if actors of this exact class pass the class filter */
+    bool MatchesClass(const UClass* Class) const;
+
+    /** True if the tags contain every required tag */
+    bool MatchesTags(TConstArrayView<FName> Tags) const;
+
+    /** True when a required tag was never created as a name, so no actor can match */
+    bool IsUnsatisfiable() const { return bUnsatisfiable; }
+
+    /**
+     * Collect the matching actors of a world, ordered and paged.
+     * Returns the number of matches before paging.
+     */
+    int32 Execute(UWorld* World, FAegisActorIndex& Index, TArray<AActor*>& OutActors) const;
+
+    const FAegisActorQueryParams& GetParams() const { return Params; }
+
+private:
+    bool MatchesLocation(const FVector& Location) const;
+
+private:
+    FAegisActorQueryParams Params;
+
+    /** Resolved class filters, matched with IsChildOf */
+    TArray<const UClass*> FilterClasses;
+
+    TArray<FName> RequiredTags;
+    bool bUnsatisfiable = false;
+
+    /** Class filter decision by exact class */
+    mutable TMap<const UClass*, bool> ClassDecisions;
+};
@@ -0,0 +1,123 @@
+// Copyright AEGIS Team. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Misc/ScopeRWLock.h"
+#include "UObject/TopLevelAssetPath.h"
+
+struct FAssetData;
+
+/** Asset search request against FAegisAssetIndex */
+struct FAegisAssetSearchParams
+{
+    /** Text in the asset name, case-insensitive. Empty matches every asset. */
+    FString Query;
+
+    /** Match Query at the start of the name only */
+    bool bPrefix = false;
+
+    /** Any of these asset classes: short name ("StaticMesh") or full path ("/Script/Engine.StaticMesh") */
+    TArray<FString> ClassNames;
+
+    /** Package path, searched recursively */
+    FString Path;
+
+    /** nextCursor of the previous page; empty for the first page */
+    FString Cursor;
+
+    /** Maximum assets per page, clamped to the index's result cap. Zero or less uses the default. */
+    int32 Limit = 0;
+};
+
+/**
+ * AEGIS Asset Index
+ * In-memory name index over the asset registry. Lowercased asset names are broken into
+ * trigrams with sorted posting lists, so a search intersects a few lists and checks only
+ * the surviving candidates instead of stringifying every asset in the project.
+ *
+ * Built lazily on the first search and kept current by the registry's add, remove and
+ * rename events. Entry ids only grow, which keeps posting lists sorted and lets a cursor
+ * name the last id returned; removed entries are compacted away once they pile up, and
+ * cursors from before the compaction are rejected.
+ *
+ * Searches may run on any thread: they hold a read lock while registry events, which
+ * arrive on the game thread, and rebuilds take the write lock.
+ */
+class AEGISBRIDGE_API FAegisAssetIndex
+{
+public:
+    struct FEntry
+    {
+        FString ObjectPath;
+        FString LowerName;
+        FName AssetName;
+        FName PackageName;
+        FTopLevelAssetPath ClassPath;
+        bool bRemoved = false;
+    };
+
+    static constexpr int32 DefaultLimit = 200;
+    static constexpr int32 MaxLimit = 5000;
+
+    /** Register for asset registry events. Called by FAegisBridgeModule. */
+    void Initialize();
+
+    /** Unregister and drop all index data */
+    void Shutdown();
+
+    /**
+     * One page of matching assets, in index order, copied out so they stay valid once the
+     * lock is released. OutNextCursor is empty on the last page. Returns false with OutError
+     * for a malformed or expired cursor.
+     */
+    bool Search(const FAegisAssetSearchParams& Params, TArray<FEntry>& OutEntries, FString& OutNextCursor, FString& OutError);
+
+    /** Number of live assets, building the index if needed */
+    int32 Num();
+
+    /** Mark the index stale; it is rebuilt on the next search */
+    void Invalidate();
+
+private:
+    using FTrigram = uint64;
+
+    void EnsureBuilt();
+    void Rebuild();
+
+    void AddAsset(const FAssetData& Asset);
+    void RemoveAsset(const FString& ObjectPath);
+
+    void OnAssetAdded(const FAssetData& Asset);
+    void OnAssetRemoved(const FAssetData& Asset);
+    void OnAssetRenamed(const FAssetData& Asset, const FString& OldObjectPath);
+
+    /** Trigrams of a lowercased string, without duplicates */
+    static void GetTrigrams(FStringView LowerText, TArray<FTrigram>& OutTrigrams);
+
+    /** Ids of the entries whose names contain every trigram, ascending and greater than AfterId */
+    void GetCandidates(const TArray<FTrigram>& Trigrams, int32 AfterId, TArray<int32>& OutIds) const;
+
+private:
+    /** Guards everything below */
+    mutable FRWLock Lock;
+
+    bool bDirty = true;
+
+    /** Bumped on every rebuild; cursors carry it */
+    uint32 Generation = 0;
+
+    TArray<FEntry> Entries;
+    int32 RemovedCount = 0;
+
+    /** Object path -> entry id */
+    TMap<FString, int32> ByPath;
+
+    /** Trigram -> ascending entry ids */
+    TMap<FTrigram, TArray<int32>> Postings;
+
+    FDelegateHandle AssetAddedHandle;
+    FDelegateHandle AssetRemovedHandle;
+    FDelegateHandle AssetRenamedHandle;
+    FDelegateHandle FilesLoadedHandle;
+};
@@ -0,0 +1,207 @@
+// Copyright AEGIS Team. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "AegisJsonWriter.h"
+
+class FJsonObject;
+class FJsonValue;
+struct FAegisWorldSnapshot;
+
+/**
+ * Component record of a binary snapshot entity
+ */
+struct FAegisSnapshotComponent
+{
+    int32 GUID = INDEX_NONE;
+    int32 Class = INDEX_NONE;
+    int32 Name = INDEX_NONE;
+
+    /** Opaque property block, condensed JSON */
+    FString PropertiesJson;
+
+    void Serialize(FArchive& Ar);
+};
+
+/**
+ * Reference record of a binary snapshot entity
+ */
+struct FAegisSnapshotReference
+{
+    int32 PropertyName = INDEX_NONE;
+    int32 TargetGUID = INDEX_NONE;
+    int32 TargetPath = INDEX_NONE;
+
+    void Serialize(FArchive& Ar);
+};
+
+/**
+ * Entity record of a binary snapshot.
+ * All identifying strings are indices into the snapshot string table.
+ */
+struct FAegisSnapshotEntity
+{
+    int32 GUID = INDEX_NONE;
+    int32 Class = INDEX_NONE;
+    int32 Path = INDEX_NONE;
+    int32 Name = INDEX_NONE;
+    int32 ParentGUID = INDEX_NONE;
+
+    bool bHasTransform = false;
+    FVector3f Location = FVector3f::ZeroVector;
+    FRotator3f Rotation = FRotator3f::ZeroRotator;
+    FVector3f Scale = FVector3f::OneVector;
+
+    TArray<int32> Tags;
+    TArray<FAegisSnapshotComponent> Components;
+    TArray<FAegisSnapshotReference> References;
+
+    /** Opaque property block, condensed JSON */
+    FString PropertiesJson;
+
+    void Serialize(FArchive& Ar);
+};
+
+/**
+ * Entity decoded from JSON but not yet interned into a string table. Decoding needs no
+ * shared state, so entities are produced on worker threads and interned afterwards.
+ */
+struct FAegisParsedEntity
+{
+    struct FComponent
+    {
+        FString GUID;
+        FString Class;
+        FString Name;
+        FString PropertiesJson;
+    };
+
+    struct FReference
+    {
+        FString PropertyName;
+        FString TargetGUID;
+        FString TargetPath;
+    };
+
+    FString GUID;
+    FString Class;
+    FString Path;
+    FString Name;
+
+    bool bHasParentGUID = false;
+    FString ParentGUID;
+
+    bool bHasTransform = false;
+    FVector3f Location = FVector3f::ZeroVector;
+    FRotator3f Rotation = FRotator3f::ZeroRotator;
+    FVector3f Scale = FVector3f::OneVector;
+
+    TArray<FString> Tags;
+    TArray<FComponent> Components;
+    TArray<FReference> References;
+
+    /** Opaque property block, condensed JSON */
+    FString PropertiesJson;
+};
+
+/**
+ * AEGIS Binary Snapshot
+ * Versioned FArchive encoding of the Seed protocol snapshot schema:
+ *
+ *   Magic | Version | Header (metadata, entity count) | String table | Entity offsets | Entity records
+ *
+ * Class names, paths, names, GUIDs and tags are deduplicated through the string table and
+ * transforms are stored as packed floats. The header can be read without touching the
+ * entity block, and the offset table gives random access to single entities.
+ */
+class AEGISBRIDGE_API FAegisBinarySnapshot
+{
+public:
+    /** File magic, "AGSS" */
+    static constexpr uint32 Magic = 0x53534741;
+
+    /** Current format version */
+    static constexpr uint32 Version = 1;
+
+    /** File extension that selects the binary format on export */
+    static const TCHAR* FileExtension;
+
+    FString Id;
+    FString Name;
+    FString Description;
+    FString Timestamp;
+    FString Seed;
+    FString Checksum;
+    TArray<FString> Targets;
+
+    /** Snapshot metadata object, condensed JSON */
+    FString MetadataJson;
+
+    TArray<FString> Strings;
+    TArray<FAegisSnapshotEntity> Entities;
+
+    /** Intern a string into the string table. Empty strings map to INDEX_NONE. */
+    int32 AddString(const FString& Value);
+
+    /** String table lookup; INDEX_NONE and out-of-range indices yield an empty string */
+    const FString& GetString(int32 Index) const;
+
+    /** Encode into a byte buffer */
+    void Save(TArray<uint8>& OutData) const;
+
+    /** Decode a byte buffer. Fails on bad magic, newer versions or truncated data. */
+    bool Load(const TArray<uint8>& Data);
+
+    /** Decode only the header, for listing snapshots without reading entities */
+    static bool LoadHeader(const TArray<uint8>& Data, FAegisWorldSnapshot& OutInfo);
+
+    /** Decode a single entity through the offset table */
+    static bool LoadEntity(const TArray<uint8>& Data, int32 EntityIndex, FAegisBinarySnapshot& OutSnapshot, FAegisSnapshotEntity& OutEntity);
+
+    /** Check a buffer for the binary snapshot magic */
+    static bool IsBinarySnapshot(const TArray<uint8>& Data);
+
+    /**
+     * Convert from the JSON schema: a snapshot object, or a bare entities array. The entities
+     * array is split without building a tree and its elements are decoded in parallel.
+     */
+    bool FromJson(FStringView Json);
+
+    /** Convert from already parsed entity values */
+    void AddEntitiesFromJson(const TArray<TSharedPtr<FJsonValue>>& EntityValues);
+
+    /** Decode the text of an entities array in parallel and intern the results in order */
+    bool AddEntitiesFromJsonText(FStringView EntitiesJson);
+
+    /** Build one entity record from a JSON entity object */
+    void AddEntityFromJson(const FJsonObject& EntityObject);
+
+    /** Intern a decoded entity */
+    FAegisSnapshotEntity& AddParsedEntity(const FAegisParsedEntity& Parsed);
+
+    /** Decode a JSON entity object without touching any string table; safe on any thread */
+    static void ParseEntityJson(const FJsonObject& EntityObject, FAegisParsedEntity& OutEntity);
+
+    /** Convert back to the JSON snapshot schema */
+    FString ToJson() const;
+
+    /** Write one entity in the JSON snapshot schema */
+    void WriteEntityJson(FAegisJsonWriter& Writer, const FAegisSnapshotEntity& Entity) const;
+
+    /** Copy an entity from another snapshot, remapping its strings into this string table */
+    FAegisSnapshotEntity& AddEntityFrom(const FAegisBinarySnapshot& Source, const FAegisSnapshotEntity& Entity);
+
+    /** Identity used to match entities across snapshots: the GUID, or the path for unregistered entities */
+    const FString& GetEntityKey(const FAegisSnapshotEntity& Entity) const;
+
+private:
+    /** Serialize the header fields, shared by Save, Load and LoadHeader */
+    void SerializeHeader(FArchive& Ar, int32& EntityCount);
+
+    /** Validate magic and version, reading the header */
+    static bool ReadPreamble(FArchive& Ar);
+
+    /** String table reverse lookup, rebuilt on load */
+    TMap<FString, int32> StringLookup;
+};
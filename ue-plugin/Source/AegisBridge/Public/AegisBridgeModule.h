@@ -4,6 +4,13 @@
 
 #include "CoreMinimal.h"
 #include "Modules/ModuleManager.h"
+#include "AegisActorIndex.h"
+#include "AegisAssetIndex.h"
+#include "AegisEditorContext.h"
+#include "AegisPropertyPlan.h"
+
+class FTransactionObjectEvent;
+struct FPropertyChangedEvent;
 
 DECLARE_LOG_CATEGORY_EXTERN(LogAegisBridge, Log, All);
 
@@ -50,6 +57,18 @@ public:
     /** Set bridge connection status */
     void SetBridgeConnected(bool bConnected) { bBridgeConnected = bConnected; }
 
+    /** Get the editor world actor index */
+    FAegisActorIndex& GetActorIndex() { return ActorIndex; }
+
+    /** Get the asset name search index */
+    FAegisAssetIndex& GetAssetIndex() { return AssetIndex; }
+
+    /** Get the per-class reflected property plans */
+    FAegisPropertyPlanCache& GetPropertyPlans() { return PropertyPlans; }
+
+    /** Get the cached editor context */
+    FAegisEditorContext& GetEditorContext() { return EditorContext; }
+
 private:
     /** Initialize the Remote Control server */
     void InitializeRemoteControlServer();
@@ -67,7 +86,7 @@ private:
     void UnregisterEditorDelegates();
 
     /** Handle level load */
-    void OnLevelLoaded(UWorld* World, const FString& LevelName);
+    void OnLevelLoaded(const FString& Filename, bool bAsTemplate);
 
     /** Handle actor spawned */
     void OnActorSpawned(AActor* Actor);
@@ -78,13 +97,66 @@ private:
     /** Handle selection changed */
     void OnSelectionChanged(UObject* Object);
 
+    /** Handle streaming level added to a world */
+    void OnLevelAddedToWorld(ULevel* Level, UWorld* World);
+
+    /** Handle streaming level removed from a world */
+    void OnLevelRemovedFromWorld(ULevel* Level, UWorld* World);
+
+    /** Handle actor label changed */
+    void OnActorLabelChanged(AActor* Actor);
+
+    /** Handle undo/redo */
+    void OnPostUndoRedo();
+
+    /** Handle a property edit on any object */
+    void OnObjectPropertyChanged(UObject* Object, FPropertyChangedEvent& Event);
+
+    /** Handle an actor moved in the viewport */
+    void OnActorMoved(AActor* Actor);
+
+    /** Handle an object changed by a transaction or its undo/redo */
+    void OnObjectTransacted(UObject* Object, const FTransactionObjectEvent& Event);
+
+    /** Handle a blueprint compile or code reload changing class layouts */
+    void OnClassLayoutsChanged();
+
+    /** Handle a play or simulate session starting or ending */
+    void OnPlayModeChanged(bool bIsSimulating);
+
+    /** Mark the editor context changed, pushing it to subscribed clients */
+    void NotifyEditorContextChanged();
+
 private:
     int32 HttpServerPort = 30010;
-    int32 WebSocketServerPort = 30020;
+    int32 WebSocketServerPort = 30021;
     bool bBridgeConnected = false;
 
     FDelegateHandle LevelLoadedHandle;
     FDelegateHandle ActorSpawnedHandle;
     FDelegateHandle ActorDeletedHandle;
     FDelegateHandle SelectionChangedHandle;
+    FDelegateHandle LevelAddedHandle;
+    FDelegateHandle LevelRemovedHandle;
+    FDelegateHandle ActorLabelChangedHandle;
+    FDelegateHandle PostUndoRedoHandle;
+    FDelegateHandle ObjectPropertyChangedHandle;
+    FDelegateHandle ActorMovedHandle;
+    FDelegateHandle ObjectTransactedHandle;
+    FDelegateHandle BlueprintCompiledHandle;
+    FDelegateHandle ReloadCompleteHandle;
+    FDelegateHandle PIEStartedHandle;
+    FDelegateHandle PIEShutdownHandle;
+
+    /** Name/path/class index over the editor world's actors */
+    FAegisActorIndex ActorIndex;
+
+    /** Trigram name index over the asset registry */
+    FAegisAssetIndex AssetIndex;
+
+    /** Resolved property lists per class, for capture and property edits */
+    FAegisPropertyPlanCache PropertyPlans;
+
+    /** World, selection and play state served to context polls */
+    FAegisEditorContext EditorContext;
 };
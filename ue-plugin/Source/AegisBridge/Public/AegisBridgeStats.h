@@ -0,0 +1,134 @@
+// Copyright AEGIS Team. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "HAL/CriticalSection.h"
+#include "HAL/PlatformTime.h"
+#include "ProfilingDebugging/CpuProfilerTrace.h"
+#include "AegisJsonWriter.h"
+
+/** Unreal Insights channel of the bridge's CPU scopes; enable with -trace=cpu,AegisBridge */
+UE_TRACE_CHANNEL_EXTERN(AegisBridgeChannel, AEGISBRIDGE_API);
+
+/** CPU scope on the bridge channel */
+#define AEGIS_TRACE_SCOPE(Name) TRACE_CPUPROFILER_EVENT_SCOPE_ON_CHANNEL(Name, AegisBridgeChannel)
+
+/** CPU scope plus a "<Namespace>.<Function>" latency record; first statement of a command */
+#define AEGIS_COMMAND_SCOPE(Namespace, Function) \
+    TRACE_CPUPROFILER_EVENT_SCOPE_ON_CHANNEL_STR(#Namespace "::" #Function, AegisBridgeChannel); \
+    static const FName PREPROCESSOR_JOIN(AegisCommandMetric, __LINE__)(#Namespace "." #Function); \
+    const FAegisStatScope PREPROCESSOR_JOIN(AegisCommandScope, __LINE__)(PREPROCESSOR_JOIN(AegisCommandMetric, __LINE__))
+
+/**
+ * Log-linear latency histogram in microseconds, HDR style: each power of two is split into
+ * 16 linear buckets, so any recorded value is reported within about 6%, from 1 us to over
+ * half an hour, in fixed memory.
+ */
+class AEGISBRIDGE_API FAegisLatencyHistogram
+{
+public:
+    static constexpr int32 SubBucketBits = 4;
+    static constexpr int32 SubBucketCount = 1 << SubBucketBits;
+    static constexpr int32 MaxExponent = 27;
+    static constexpr int32 BucketCount = (MaxExponent + 1) * SubBucketCount;
+
+    void Record(uint64 Micros);
+    void Reset();
+
+    uint64 GetCount() const { return Count; }
+    uint64 GetTotal() const { return Total; }
+    uint64 GetMin() const { return Count > 0 ? Min : 0; }
+    uint64 GetMax() const { return Max; }
+    double GetMean() const { return Count > 0 ? static_cast<double>(Total) / Count : 0.0; }
+
+    /** Value at a percentile in [0, 100], as the upper edge of its bucket */
+    uint64 GetPercentile(double Percentile) const;
+
+    /** Write {count, min, mean, p50, p90, p99, p999, max} as an open object's fields */
+    void WriteFields(FAegisJsonWriter& Writer) const;
+
+private:
+    static int32 GetBucket(uint64 Micros);
+    static uint64 GetBucketUpperEdge(int32 Bucket);
+
+private:
+    uint32 Buckets[BucketCount] = {};
+    uint64 Count = 0;
+    uint64 Total = 0;
+    uint64 Min = MAX_uint64;
+    uint64 Max = 0;
+};
+
+/**
+ * AEGIS Bridge Stats
+ * Latency and throughput figures for every bridge command and transport path: a latency
+ * histogram, call count and request/response bytes per metric name. Commands record as
+ * "<Namespace>.<Function>", HandleRequest dispatches as "request.<Namespace>.<Function>",
+ * and the transport as "request.decode", "ws.broadcast" and "ws.receive". Bytes count the
+ * characters of the JSON text. Safe to record from any thread.
+ *
+ * Queried through the GetBridgeStats command and the Aegis.Stats console command, which
+ * add the WebSocket queue depths and job counts of the moment.
+ */
+class AEGISBRIDGE_API FAegisBridgeStats
+{
+public:
+    static FAegisBridgeStats& Get();
+
+    /** Record one timed call; byte counts are optional */
+    void Record(FName Metric, uint64 Micros, int64 BytesIn = 0, int64 BytesOut = 0);
+
+    /** Drop every figure and restart the uptime */
+    void Reset();
+
+    /**
+     * Write {uptimeSeconds, metrics, webSocket, activeJobs} as an open object's fields.
+     * Metrics are ordered by total time, busiest first. Game thread only, for the gauges.
+     */
+    void WriteFields(FAegisJsonWriter& Writer) const;
+
+    /** One line per metric for the output log */
+    void LogSummary() const;
+
+    /** Whether recording is on; Aegis.Stats.Enable turns it off */
+    static bool IsEnabled();
+
+private:
+    struct FMetric
+    {
+        FAegisLatencyHistogram Latency;
+        int64 BytesIn = 0;
+        int64 BytesOut = 0;
+    };
+
+    /** Metrics copied under the lock, busiest first */
+    TArray<TPair<FName, FMetric>> GetSortedMetrics() const;
+
+private:
+    mutable FCriticalSection Lock;
+    TMap<FName, FMetric> Metrics;
+    double StartTime = FPlatformTime::Seconds();
+};
+
+/**
+ * Times a scope into FAegisBridgeStats. Byte counts can be filled in before it ends.
+ */
+class AEGISBRIDGE_API FAegisStatScope
+{
+public:
+    explicit FAegisStatScope(FName InMetric)
+        : Metric(InMetric)
+        , StartCycles(FAegisBridgeStats::IsEnabled() ? FPlatformTime::Cycles64() : 0)
+    {
+    }
+
+    ~FAegisStatScope();
+
+    int64 BytesIn = 0;
+    int64 BytesOut = 0;
+
+private:
+    FName Metric;
+    uint64 StartCycles;
+};
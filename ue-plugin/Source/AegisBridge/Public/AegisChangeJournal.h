@@ -0,0 +1,151 @@
+// Copyright AEGIS Team. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/EditorSubsystem.h"
+#include "UObject/ObjectKey.h"
+#include "AegisJsonWriter.h"
+#include "AegisChangeJournal.generated.h"
+
+class AActor;
+class ULevel;
+struct FPropertyChangedEvent;
+
+/**
+ * Kinds of change accumulated on one journal record
+ */
+enum class EAegisJournalChange : uint8
+{
+    None = 0,
+    Added = 1 << 0,
+    Removed = 1 << 1,
+    Transform = 1 << 2,
+
+    /** Reflected properties; an empty property list means "anything may have changed" */
+    Properties = 1 << 3,
+};
+ENUM_CLASS_FLAGS(EAegisJournalChange)
+
+/**
+ * Dirty record for one actor. Each new change to the actor supersedes its previous record
+ * with a fresh sequence number, so readers only ever see the latest record per actor.
+ */
+struct FAegisJournalRecord
+{
+    uint64 Sequence = 0;
+
+    /** Identity across renames, and after the actor is destroyed */
+    FObjectKey ActorKey;
+
+    FString ActorPath;
+    FString ActorName;
+    FString ActorClass;
+
+    EAegisJournalChange Changes = EAegisJournalChange::None;
+
+    /** Changed member properties of the actor, or names of edited components */
+    TArray<FName> Properties;
+
+    FDateTime Timestamp;
+};
+
+/**
+ * AEGIS Change Journal
+ * Ring buffer of per-actor dirty records stamped with a monotonically increasing sequence
+ * number, fed by the editor delegates hooked in FAegisBridgeModule. Clients remember the last
+ * sequence they saw and ask for the changes since, instead of recapturing the world.
+ *
+ * When the ring overwrites a record a client has not seen yet, or the map changes, the reply
+ * carries resyncRequired and the client falls back to a full capture.
+ */
+UCLASS()
+class AEGISBRIDGE_API UAegisChangeJournal : public UEditorSubsystem
+{
+    GENERATED_BODY()
+
+public:
+    /** Get singleton instance */
+    static UAegisChangeJournal* Get();
+
+    //~ Begin UEditorSubsystem Interface
+    virtual void Initialize(FSubsystemCollectionBase& Collection) override;
+    virtual void Deinitialize() override;
+    //~ End UEditorSubsystem Interface
+
+    // =========================================================================
+    // Recording
+    // =========================================================================
+
+    void RecordActorAdded(AActor* Actor);
+    void RecordActorRemoved(AActor* Actor);
+    void RecordActorMoved(AActor* Actor);
+
+    /** Property edit on an actor or one of its components */
+    void RecordPropertyChanged(UObject* Object, const FPropertyChangedEvent& Event);
+
+    /** Undo/redo touched an object; liveness decides between removed and modified */
+    void RecordObjectTransacted(UObject* Object);
+
+    /** Streaming level shown or hidden: one record per actor it contains */
+    void RecordLevelChanged(ULevel* Level, bool bAdded);
+
+    /** Drop every record and start a new epoch; readers from before must resync */
+    void Reset();
+
+    // =========================================================================
+    // Reading
+    // =========================================================================
+
+    /** Sequence of the most recent record */
+    uint64 GetHeadSequence() const { return NextSequence - 1; }
+
+    /** Number of map changes seen since startup */
+    int32 GetEpoch() const { return Epoch; }
+
+    /**
+     * Write {epoch, head, since, resyncRequired, records, hasMore, nextSequence} for the records
+     * newer than Since, oldest first, at most MaxRecords of them. Readers continue from nextSequence.
+     */
+    void WriteChangesSince(uint64 Since, int32 MaxRecords, FAegisJsonWriter& Writer) const;
+
+    /** Time of the newest change of every actor still in the ring, by actor path */
+    void GetLatestTimestamps(TMap<FString, FDateTime>& OutByPath) const;
+
+    /** JSON form of WriteChangesSince */
+    UFUNCTION(BlueprintCallable, Category = "AEGIS|Journal")
+    FString GetChangesSince(int64 Since, int32 MaxRecords = 1000);
+
+private:
+    /** Resolve a changed object to the editor world actor it belongs to */
+    static AActor* ResolveActor(UObject* Object);
+
+    /** Supersede the actor's previous record with a new one carrying the merged changes */
+    void Record(AActor* Actor, EAegisJournalChange Change, FName Property = NAME_None);
+
+    /** Ring slot of the Index-th oldest record */
+    int32 GetSlot(int32 Index) const { return (First + Index) % Ring.Num(); }
+
+    /** Index of the oldest record with a sequence greater than Since */
+    int32 FindFirstAfter(uint64 Since) const;
+
+    /** Whether the record is still the newest one for its actor */
+    bool IsLatest(const FAegisJournalRecord& Record) const;
+
+private:
+    TArray<FAegisJournalRecord> Ring;
+
+    /** Slot of the oldest record, and number of records held */
+    int32 First = 0;
+    int32 Count = 0;
+
+    uint64 NextSequence = 1;
+
+    /** Readers that last saw a sequence below this have missed records */
+    uint64 ResyncBelow = 0;
+
+    int32 Epoch = 0;
+
+    /** Actor -> sequence of its newest record */
+    TMap<FObjectKey, uint64> LatestSequence;
+};
@@ -0,0 +1,126 @@
+// Copyright AEGIS Team. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "UObject/WeakObjectPtr.h"
+#include "AegisJsonWriter.h"
+
+class AActor;
+class UWorld;
+
+/**
+ * AEGIS Editor Context
+ * Cached model of the editor state that GetEditorContext and GetLevelInfo report: the editor
+ * world, its actor count and streaming levels, the selection and the play mode. The bridge
+ * module's delegates mark sections stale and bump a version; a read rebuilds only the stale
+ * sections and serializes once per version, so a poll that finds nothing new costs a compare.
+ *
+ * Actor adds and deletes adjust the count in place; map loads, streaming changes and undo
+ * recount it on the next read. Game thread only.
+ */
+class AEGISBRIDGE_API FAegisEditorContext
+{
+public:
+    enum class ESection : uint8
+    {
+        None = 0,
+        World = 1 << 0,
+        Levels = 1 << 1,
+        Selection = 1 << 2,
+        Mode = 1 << 3,
+        All = World | Levels | Selection | Mode,
+    };
+
+    /** Current version; brings stale sections up to date first */
+    int64 GetVersion();
+
+    /** {version, world, selection, isPlaying, isSimulating} */
+    const FString& GetContextJson();
+
+    /** {version, worldName, mapName, actorCount, streamingLevels} */
+    const FString& GetLevelInfoJson();
+
+    /**
+     * Write {version, baseVersion, ...} with the sections changed since the previous call,
+     * in the fields GetContextJson uses plus "streamingLevels". A client holding baseVersion
+     * applies it; any other client fetches the context again.
+     */
+    void WriteChanges(FAegisJsonWriter& Writer);
+
+    /** Whether sections changed since the last WriteChanges */
+    bool HasUnpushedChanges() const { return Version != PushedVersion; }
+
+    /** Delegate hooks, called by FAegisBridgeModule */
+    void OnMapOpened();
+    void OnActorAdded(AActor* Actor);
+    void OnActorRemoved(AActor* Actor);
+    void OnLevelsChanged();
+    void OnSelectionChanged();
+    void OnPlayModeChanged();
+
+    /** Undo/redo can add or remove actors without notifications */
+    void OnPostUndoRedo();
+
+    /** Drop all cached state */
+    void Reset();
+
+private:
+    /** Bump the version for sections whose content changed */
+    void MarkChanged(ESection Sections);
+
+    /** Rebuild stale sections */
+    void Refresh();
+
+    /** Whether an actor belongs to the world the count was taken for */
+    bool IsTrackedActor(const AActor* Actor) const;
+
+    void WriteWorld(FAegisJsonWriter& Writer) const;
+    void WriteStreamingLevels(FAegisJsonWriter& Writer) const;
+    void WriteSelection(FAegisJsonWriter& Writer) const;
+    void WriteMode(FAegisJsonWriter& Writer) const;
+
+private:
+    struct FActorInfo
+    {
+        FString Name;
+        FString Class;
+        FString Path;
+    };
+
+    struct FLevelInfo
+    {
+        FString Name;
+        bool bLoaded = false;
+    };
+
+    int64 Version = 1;
+
+    /** Version last written by WriteChanges */
+    int64 PushedVersion = 1;
+
+    /** Version each section last changed at, by bit index */
+    int64 SectionVersions[4] = { 1, 1, 1, 1 };
+
+    /** Sections to rebuild on the next read */
+    ESection StaleSections = ESection::All;
+
+    /** The actor count needs a full recount */
+    bool bCountStale = true;
+
+    /** Editor world the state was read from */
+    TWeakObjectPtr<UWorld> TrackedWorld;
+    FString WorldName;
+    FString MapName;
+    int32 ActorCount = 0;
+    TArray<FLevelInfo> StreamingLevels;
+    TArray<FActorInfo> Selection;
+    bool bIsPlaying = false;
+    bool bIsSimulating = false;
+
+    /** Serialized forms, empty when stale */
+    FString ContextJson;
+    FString LevelInfoJson;
+};
+
+ENUM_CLASS_FLAGS(FAegisEditorContext::ESection);
@@ -0,0 +1,80 @@
+// Copyright AEGIS Team. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "UObject/ObjectKey.h"
+#include "UObject/WeakObjectPtrTemplates.h"
+
+class AActor;
+class UAegisWebSocketServer;
+
+/**
+ * AEGIS Event Coalescer
+ * Buffers high-rate editor events for one window and turns them into a few batched frames.
+ * Spawns and deletes of the same actor inside a window cancel out, every remaining change
+ * goes into "world.entity.changed" messages with spawned/destroyed arrays, and any number of
+ * selection changes collapse into one "editor.selection.changed" with the latest selection.
+ * Editor context changes go out as one "editor.context.changed" diff per window.
+ */
+class AEGISBRIDGE_API FAegisEventCoalescer
+{
+public:
+    struct FSettings
+    {
+        /** Events are held this long after the first one; 0 flushes on every tick */
+        double WindowSeconds = 0.05;
+
+        /** Entities per world.entity.changed message; a full batch flushes early */
+        int32 MaxBatchEntities = 2048;
+    };
+
+    void Configure(const FSettings& InSettings) { Settings = InSettings; }
+
+    void AddSpawned(AActor* Actor);
+    void AddDestroyed(AActor* Actor);
+    void AddSelectionChanged();
+    void AddContextChanged();
+
+    bool HasPending() const { return bSelectionChanged || bContextChanged || Spawned.Num() > 0 || Destroyed.Num() > 0; }
+
+    /** Send the pending batches if the window elapsed or a batch filled up */
+    void FlushIfDue(UAegisWebSocketServer& Server, double Now);
+
+    /** Send everything pending now */
+    void Flush(UAegisWebSocketServer& Server);
+
+    /** Drop everything pending */
+    void Reset();
+
+private:
+    /** A destroyed actor may be collected before the flush, so it is described up front */
+    struct FDestroyedEntity
+    {
+        FString Name;
+        FString Class;
+        FString Path;
+    };
+
+    void MarkPending();
+
+    void FlushEntities(UAegisWebSocketServer& Server);
+    void FlushSelection(UAegisWebSocketServer& Server);
+    void FlushContext(UAegisWebSocketServer& Server);
+
+private:
+    FSettings Settings;
+
+    /** Spawned actors are described at flush time; those destroyed meanwhile never are */
+    TMap<FObjectKey, TWeakObjectPtr<AActor>> Spawned;
+    TMap<FObjectKey, FDestroyedEntity> Destroyed;
+
+    /** Spawn/destroy pairs that cancelled out during the window */
+    int32 Cancelled = 0;
+
+    bool bSelectionChanged = false;
+    bool bContextChanged = false;
+
+    /** Time the first pending event arrived */
+    double WindowStart = 0.0;
+};
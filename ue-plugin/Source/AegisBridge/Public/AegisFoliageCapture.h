@@ -0,0 +1,149 @@
+// Copyright AEGIS Team. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+class FArchive;
+class UFoliageType;
+class UWorld;
+
+/** What UAegisSeedSubsystem::WriteFoliage captures */
+struct FAegisFoliageCaptureOptions
+{
+    /** Per-type cell hashes */
+    bool bIncludeInstances = false;
+
+    /** Grid cell size in world units; zero or less uses the default */
+    double CellSize = 0.0;
+
+    /** Cell hashes the caller already holds, by cell key; matching cells are reported unchanged */
+    TMap<FString, FString> KnownCells;
+
+    /** When set, every changed or emptied cell is written here as an instance data blob */
+    FString InstanceDataPath;
+
+    /** Oodle codec for the blob ("none" to store it raw) */
+    FString Codec = TEXT("kraken");
+};
+
+/** One grid cell of one foliage type */
+struct FAegisFoliageCell
+{
+    /** Cell coordinate: floor(location / cell size) on X and Y */
+    FIntPoint Coord = FIntPoint::ZeroValue;
+
+    int32 Count = 0;
+
+    /** Z range the packed heights are quantized over */
+    float MinZ = 0.0f;
+    float ZRange = 0.0f;
+
+    /** Hash of the packed instances */
+    uint64 Hash = 0;
+
+    /** Count packed instances, sorted. Only kept when the capture keeps data. */
+    TArray<uint8> Packed;
+};
+
+/** Every instance of one foliage type in the world */
+struct FAegisFoliageTypeCapture
+{
+    FString FoliageTypePath;
+    int32 InstanceCount = 0;
+
+    /** Hash over the cell hashes */
+    uint64 Hash = 0;
+
+    /** Occupied cells, ordered by Y then X */
+    TArray<FAegisFoliageCell> Cells;
+};
+
+/** Outcome of FAegisFoliageCapture::Restore */
+struct FAegisFoliageRestoreResult
+{
+    int32 CellsRestored = 0;
+    int32 InstancesRemoved = 0;
+    int32 InstancesAdded = 0;
+
+    /** Foliage types in the data that could not be loaded; their cells are skipped */
+    TArray<FString> MissingTypes;
+};
+
+/**
+ * AEGIS Foliage Capture
+ * Captures foliage instances per UFoliageType into packed, quantized buffers bucketed on
+ * a square XY grid, with a content hash per cell. Instances from every foliage actor in
+ * the world are merged, so cells do not depend on which partition actor holds them.
+ *
+ * Packed instance, 21 bytes, little-endian:
+ *   uint16 X, Y        offset within the cell, over the cell size
+ *   uint16 Z           offset over the cell's Z range
+ *   uint16 P, Y, R     rotation, over 360 degrees
+ *   half   SX, SY, SZ  scale
+ *   half   ZOffset
+ *   uint8  Flags
+ *
+ * A cell's instances are sorted by their packed bytes, so its hash does not depend on
+ * instance order. Restore replaces whole cells: existing instances of the type inside each
+ * cell are removed and the packed ones added back in batches, so an empty cell clears it.
+ */
+class AEGISBRIDGE_API FAegisFoliageCapture
+{
+public:
+    /** Instance data blob magic, "AGFI" */
+    static constexpr uint32 InstanceDataMagic = 0x49464741;
+    /** 2: XY offsets are floored over 65536 steps */
+    static constexpr int32 InstanceDataVersion = 2;
+
+    static constexpr int32 PackedInstanceSize = 21;
+
+    /** 256 m cells; keeps XY quantization under 4 mm */
+    static constexpr double DefaultCellSize = 25600.0;
+
+    static constexpr int32 DefaultRestoreBatchSize = 50000;
+
+    explicit FAegisFoliageCapture(double InCellSize = DefaultCellSize);
+
+    /** Capture every foliage instance of the world. bKeepData keeps the packed cells for Serialize. */
+    void Capture(UWorld* World, bool bKeepData);
+
+    const TArray<FAegisFoliageTypeCapture>& GetTypes() const { return Types; }
+
+    /** Hash over every type's hash */
+    uint64 GetHash() const { return Hash; }
+
+    int32 GetInstanceCount() const { return InstanceCount; }
+
+    double GetCellSize() const { return CellSize; }
+
+    /** Change detection key of a cell: "<FoliageTypePath>:<X>,<Y>" */
+    static FString GetCellKey(const FAegisFoliageTypeCapture& Type, const FAegisFoliageCell& Cell);
+
+    /** Hashes as 16 lowercase hex digits */
+    static FString HashToString(uint64 InHash);
+
+    /** Split a cell key back into its type path and coordinate */
+    static bool ParseCellKey(const FString& Key, FString& OutFoliageTypePath, FIntPoint& OutCoord);
+
+    /**
+     * Write an instance data blob holding the listed cells, as (type index, cell index)
+     * pairs grouped by type, plus empty cells by type path for cells that no longer hold
+     * instances. Requires a capture that kept data.
+     */
+    void Serialize(FArchive& Ar, TConstArrayView<TPair<int32, int32>> CellRefs, const TMap<FString, TArray<FIntPoint>>& ClearedCells) const;
+
+    /**
+     * Replace the cells of an instance data blob in the world, adding instances through
+     * AInstancedFoliageActor::AddInstances at most BatchSize at a time.
+     * Returns false with OutError for a malformed blob.
+     */
+    static bool Restore(UWorld* World, const TArray<uint8>& Data, int32 BatchSize, FAegisFoliageRestoreResult& OutResult, FString& OutError);
+
+private:
+    double CellSize;
+    uint64 Hash = 0;
+    int32 InstanceCount = 0;
+
+    TArray<FAegisFoliageTypeCapture> Types;
+};
@@ -0,0 +1,90 @@
+// Copyright AEGIS Team. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+/** Seed protocol GUID namespaces, in the order of the MCP server's GUIDNamespace enum */
+enum class EAegisGUIDNamespace : uint8
+{
+    Actor,
+    Component,
+    Asset,
+    Blueprint,
+    Material,
+    Landscape,
+    Foliage,
+    PCG,
+    AI,
+    Custom,
+    Unknown,
+};
+
+/** Incremental SHA-256 (FIPS 180-4). Copy a context to reuse a hashed prefix. */
+class AEGISBRIDGE_API FAegisSHA256
+{
+public:
+    static constexpr int32 DigestSize = 32;
+
+    FAegisSHA256();
+
+    void Update(const uint8* Data, int64 Length);
+    void Final(uint8 OutDigest[DigestSize]);
+
+    /** Digest of the UTF-8 encoding of Text, as lowercase hex */
+    static FString HashToHex(FStringView Text);
+
+private:
+    void Transform(const uint8 Block[64]);
+
+private:
+    uint32 State[8];
+    uint8 Buffer[64];
+    uint64 TotalLength = 0;
+    int32 BufferLength = 0;
+};
+
+/**
+ * AEGIS GUID Generator
+ * Deterministic Seed protocol GUIDs, byte-compatible with the MCP server's
+ * generateDeterministicGUID: SHA-256 over the UTF-8 of
+ * "namespace:entityType:seed:counter:entityName:parentGUID", formatted as
+ * CODE-XXXXXXXX-XXXX-XXXX-XXXXXXXXXXXX from the first 14 digest bytes.
+ *
+ * Inputs are encoded straight into a stack buffer; no call allocates beyond the result.
+ * Thread-safe.
+ */
+class AEGISBRIDGE_API FAegisGUIDGenerator
+{
+public:
+    /** Length of a generated GUID */
+    static constexpr int32 GUIDLength = 3 + 1 + 8 + 1 + 4 + 1 + 4 + 1 + 12;
+
+    /** Digest bytes carried in a GUID's hex groups */
+    static constexpr int32 GUIDBytes = 14;
+
+    /** Namespace by name, case-insensitive */
+    static EAegisGUIDNamespace ParseNamespace(FStringView Namespace);
+
+    /** Three-letter GUID prefix, "UNK" for unknown namespaces */
+    static const TCHAR* GetNamespaceCode(EAegisGUIDNamespace Namespace);
+
+    /** Generate one GUID. Namespace is hashed as given. */
+    static FString Generate(FStringView Namespace, FStringView EntityType, FStringView Seed, int32 Counter, FStringView EntityName, FStringView ParentGUID = FStringView());
+
+    /**
+     * Generate Count GUIDs for counters StartCounter.. with entity names "<NamePrefix>_<Index>",
+     * NamePrefix defaulting to EntityType, as batch_generate_guids does. The shared input
+     * prefix is hashed once and the batch is split across worker threads.
+     */
+    static void GenerateBatch(FStringView Namespace, FStringView EntityType, FStringView Seed, int32 StartCounter, int32 Count, FStringView NamePrefix, TArray<FString>& OutGUIDs);
+
+    /**
+     * Split a GUID in the exact form FormatGUID produces into its namespace and bytes.
+     * Returns false for anything else, including lowercase hex.
+     */
+    static bool ParseGUID(FStringView GUID, EAegisGUIDNamespace& OutNamespace, uint8 OutBytes[GUIDBytes]);
+
+    /** Namespace code followed by the bytes as upper-case 8-4-4-12 hex groups */
+    static FString FormatGUID(EAegisGUIDNamespace Namespace, const uint8 Bytes[GUIDBytes]);
+};
@@ -0,0 +1,157 @@
+// Copyright AEGIS Team. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "AegisGUIDGenerator.h"
+
+/** One entity registration, for FAegisGUIDRegistry::RegisterBatch */
+struct FAegisGUIDRegistration
+{
+    FString GUID;
+    FString EntityPath;
+    FString EntityType;
+    FString Metadata;
+};
+
+/** Outcome of registering one GUID */
+enum class EAegisGUIDRegisterResult : uint8
+{
+    Registered,
+
+    /** The GUID is registered to another path */
+    GUIDConflict,
+
+    /** The path is registered under another GUID */
+    PathConflict,
+
+    /** Empty GUID, or a path too long to intern */
+    Invalid,
+};
+
+/**
+ * AEGIS GUID Registry
+ * GUID <-> entity path registry sized for millions of entities. Records are flat:
+ * generator GUIDs are stored as a 128-bit key (namespace plus the 14 hashed bytes),
+ * paths and types are interned FNames, and metadata JSON lives as UTF-8 in one side
+ * arena. Only GUIDs not in generator form keep their string.
+ *
+ * Persisted to a single binary file so registrations survive editor restarts.
+ * Mutation is game thread only; the const lookups may run on workers while no
+ * mutation is in flight.
+ */
+class AEGISBRIDGE_API FAegisGUIDRegistry
+{
+public:
+    /** Expanded view of a record, built on demand */
+    struct FEntryView
+    {
+        FString GUID;
+        FString EntityPath;
+        FString EntityType;
+        FString EntityName;
+        FString Metadata;
+        FDateTime CreatedAt;
+        int32 Version = 0;
+    };
+
+    /** Register or re-register one entity. Re-registering the same pair bumps its version. */
+    EAegisGUIDRegisterResult Register(FStringView GUID, FStringView EntityPath, FStringView EntityType, FStringView Metadata);
+
+    /**
+     * Register many entities with one reservation for the maps and arena.
+     * OutResults, when given, receives one result per registration. Returns the number registered.
+     */
+    int32 RegisterBatch(TConstArrayView<FAegisGUIDRegistration> Registrations, TArray<EAegisGUIDRegisterResult>* OutResults = nullptr);
+
+    /** Expand the record for a GUID */
+    bool Find(FStringView GUID, FEntryView& OutEntry) const;
+
+    bool Contains(FStringView GUID) const;
+
+    /** GUID registered for an entity path, empty if none */
+    FString FindGUIDByPath(FStringView EntityPath) const;
+
+    /** Entity path registered for a GUID, empty if none */
+    FString FindPathByGUID(FStringView GUID) const;
+
+    void Empty();
+
+    int32 Num() const { return Records.Num(); }
+
+    /** Heap bytes held by the records, lookups and arena */
+    SIZE_T GetAllocatedSize() const;
+
+    /** True when registrations changed since the last Save or Load */
+    bool IsDirty() const { return bDirty; }
+
+    /** Write the registry to disk, through a temporary file */
+    bool Save(const FString& FilePath);
+
+    /** Replace the registry with the file's contents. A missing file leaves it empty. */
+    bool Load(const FString& FilePath);
+
+private:
+    /** 128-bit generator GUID key: the namespace byte followed by the 14 hashed bytes, zero padded */
+    struct FKey
+    {
+        uint64 Words[2] = { 0, 0 };
+
+        bool operator==(const FKey& Other) const
+        {
+            return Words[0] == Other.Words[0] && Words[1] == Other.Words[1];
+        }
+
+        friend uint32 GetTypeHash(const FKey& Key)
+        {
+            // Past the namespace byte the key is hash output already
+            return static_cast<uint32>(Key.Words[0] >> 8) ^ static_cast<uint32>(Key.Words[1]);
+        }
+    };
+
+    struct FRecord
+    {
+        FKey Key;
+        FName EntityPath;
+        FName EntityType;
+        int64 CreatedAtTicks = 0;
+        int32 MetadataOffset = 0;
+        int32 MetadataLength = 0;
+        int32 Version = 0;
+
+        /** Index into ExternalGUIDs, or INDEX_NONE for generator GUIDs */
+        int32 ExternalIndex = INDEX_NONE;
+    };
+
+    /** Key of a GUID in generator form; false for any other GUID */
+    static bool MakeKey(FStringView GUID, FKey& OutKey);
+
+    FString GetGUID(const FRecord& Record) const;
+    int32 FindRecord(FStringView GUID) const;
+
+    void SetMetadata(FRecord& Record, FStringView Metadata);
+    void CompactMetadata();
+
+private:
+    TArray<FRecord> Records;
+
+    /** Key -> record index */
+    TMap<FKey, int32> ByKey;
+
+    /** Entity path -> record index */
+    TMap<FName, int32> ByPath;
+
+    /** GUIDs not in generator form */
+    TArray<FString> ExternalGUIDs;
+
+    /** External GUID -> record index */
+    TMap<FString, int32> ExternalLookup;
+
+    /** UTF-8 metadata of every record, back to back */
+    TArray<UTF8CHAR> MetadataArena;
+
+    /** Arena bytes no record points at any more */
+    int64 DeadMetadataBytes = 0;
+
+    bool bDirty = false;
+};
@@ -0,0 +1,205 @@
+// Copyright AEGIS Team. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/EditorSubsystem.h"
+#include "Containers/Ticker.h"
+#include "AegisJsonWriter.h"
+#include "AegisJobManager.generated.h"
+
+class FAegisRequestParams;
+struct FAegisJobRecord;
+
+/**
+ * Lifecycle of a bridge job
+ */
+enum class EAegisJobState : uint8
+{
+    Queued,
+    Running,
+    Succeeded,
+    Failed,
+    Cancelled,
+};
+
+AEGISBRIDGE_API const TCHAR* LexToString(EAegisJobState State);
+
+/**
+ * Services handed to a job for one step: the time budget, progress and result reporting
+ */
+class AEGISBRIDGE_API FAegisJobContext
+{
+public:
+    FAegisJobContext(FAegisJobRecord& InRecord, double InDeadline);
+
+    /** The step used up its share of the frame; return and continue next tick */
+    bool ShouldYield() const;
+
+    bool IsCancelRequested() const;
+
+    /** FPlatformTime::Seconds() at which the step should return */
+    double GetDeadline() const { return Deadline; }
+
+    /** Progress in job-defined units, e.g. actors written out of actors to write */
+    void SetProgress(int64 Done, int64 Total, const FString& Stage = FString());
+
+    /** Stream a partial result to subscribers as "job.chunk"; WriteData writes the chunk value */
+    void EmitChunk(TFunctionRef<void(FAegisJsonWriter&)> WriteData);
+
+    /** Finish with a JSON result document */
+    void Succeed(FString ResultJson);
+
+    /** Finish with an error */
+    void Fail(const FString& Error);
+
+private:
+    FAegisJobRecord& Record;
+    const double Deadline;
+};
+
+/**
+ * A long-running bridge command. Step runs on the game thread once per tick until the job
+ * calls Succeed or Fail, and should return as soon as ShouldYield says so. Read-only work
+ * may run on UE::Tasks workers, with Step polling for completion.
+ */
+class AEGISBRIDGE_API FAegisJob
+{
+public:
+    virtual ~FAegisJob() = default;
+
+    virtual void Step(FAegisJobContext& Context) = 0;
+
+    /** Cancellation was requested; release anything held. The job is dropped afterwards. */
+    virtual void Cancel() {}
+};
+
+/** Build a job from the StartJob request {Kind, Params}, or null with OutError set if the arguments are unusable */
+using FAegisJobFactory = TFunction<TUniquePtr<FAegisJob>(const FAegisRequestParams& Params, FString& OutError)>;
+
+/**
+ * Job state and outcome; owned by the manager
+ */
+struct FAegisJobRecord
+{
+    FString JobId;
+    FName Kind;
+    EAegisJobState State = EAegisJobState::Queued;
+
+    TUniquePtr<FAegisJob> Job;
+
+    int64 Done = 0;
+    int64 Total = 0;
+    FString Stage;
+
+    FString Error;
+    FString Result;
+
+    int32 ChunkCount = 0;
+    bool bCancelRequested = false;
+    bool bProgressDirty = false;
+
+    double CreatedTime = 0.0;
+    double FinishedTime = 0.0;
+    double LastProgressTime = 0.0;
+};
+
+/**
+ * AEGIS Job Manager
+ * Runs long bridge commands without blocking the request that started them or the editor
+ * frame. StartJob returns a job id at once; the job then advances a slice at a time from a
+ * core ticker within [AegisBridge] JobTimeSliceMs per frame, shared by all running jobs.
+ *
+ * Progress, streamed chunks and completion go out over the WebSocket as "job.progress",
+ * "job.chunk" and "job.completed" with the job id in their data. Results also stay
+ * available through GetJobResult until the job is pruned.
+ */
+UCLASS()
+class AEGISBRIDGE_API UAegisJobManager : public UEditorSubsystem
+{
+    GENERATED_BODY()
+
+public:
+    /** Get singleton instance */
+    static UAegisJobManager* Get();
+
+    //~ Begin UEditorSubsystem Interface
+    virtual void Initialize(FSubsystemCollectionBase& Collection) override;
+    virtual void Deinitialize() override;
+    //~ End UEditorSubsystem Interface
+
+    /** Register a job kind; replaces any existing factory */
+    void RegisterJobKind(FName Kind, FAegisJobFactory Factory);
+
+    /** Start a job. Returns its id, or an empty string with OutError set. */
+    FString StartJob(FName Kind, const FAegisRequestParams& Params, FString& OutError);
+
+    /** Request cancellation; takes effect before the job's next step */
+    bool CancelJob(const FString& JobId);
+
+    bool HasJob(const FString& JobId) const { return FindJob(JobId) != nullptr; }
+
+    /** Write {jobId, kind, state, done, total, progress, stage, error?, chunks} */
+    bool WriteJobStatus(const FString& JobId, FAegisJsonWriter& Writer) const;
+
+    /** Write status plus the result document of a finished job */
+    bool WriteJobResult(const FString& JobId, FAegisJsonWriter& Writer) const;
+
+    /** Write the status of every retained job */
+    void WriteJobList(FAegisJsonWriter& Writer) const;
+
+    int32 GetActiveJobCount() const;
+
+    // =========================================================================
+    // Blueprint / Remote Control surface
+    // =========================================================================
+
+    UFUNCTION(BlueprintCallable, Category = "AEGIS|Jobs")
+    FString GetJob(const FString& JobId);
+
+    UFUNCTION(BlueprintCallable, Category = "AEGIS|Jobs")
+    FString GetJobResult(const FString& JobId);
+
+    UFUNCTION(BlueprintCallable, Category = "AEGIS|Jobs")
+    bool RequestCancel(const FString& JobId) { return CancelJob(JobId); }
+
+private:
+    bool Tick(float DeltaTime);
+
+    /** Give one job a step and report what changed */
+    void StepJob(FAegisJobRecord& Record, double Deadline);
+
+    void FinishJob(FAegisJobRecord& Record, EAegisJobState State);
+
+    void BroadcastProgress(FAegisJobRecord& Record);
+    void BroadcastCompleted(const FAegisJobRecord& Record);
+
+    /** Drop finished jobs past the retention limits */
+    void PruneFinishedJobs();
+
+    const FAegisJobRecord* FindJob(const FString& JobId) const;
+
+    static void WriteStatusFields(const FAegisJobRecord& Record, FAegisJsonWriter& Writer);
+
+private:
+    TMap<FName, FAegisJobFactory> Factories;
+
+    /** Jobs in start order */
+    TArray<TUniquePtr<FAegisJobRecord>> Jobs;
+
+    /** Index of the job stepped first next tick, so one slow job cannot starve the rest */
+    int32 NextJobIndex = 0;
+
+    FTSTicker::FDelegateHandle TickHandle;
+
+    double TimeSliceSeconds = 0.008;
+    double ProgressIntervalSeconds = 0.1;
+    double RetentionSeconds = 600.0;
+    int32 MaxRetainedJobs = 64;
+
+    /** Results up to this size are inlined in job.completed; larger ones are fetched */
+    int32 MaxInlineResultChars = 64 * 1024;
+};
+
+/** Register the built-in job kinds: CaptureAllActors, SearchAssets, staged restores and command routes */
+void RegisterAegisBridgeJobs(UAegisJobManager& Manager);
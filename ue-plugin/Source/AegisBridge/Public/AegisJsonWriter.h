@@ -0,0 +1,70 @@
+// Copyright AEGIS Team. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Policies/CondensedJsonPrintPolicy.h"
+#include "Serialization/JsonWriter.h"
+
+/** Condensed JSON writer used for every bridge response */
+using FAegisJsonWriter = TJsonWriter<TCHAR, TCondensedJsonPrintPolicy<TCHAR>>;
+using FAegisJsonWriterFactory = TJsonWriterFactory<TCHAR, TCondensedJsonPrintPolicy<TCHAR>>;
+
+/**
+ * Streaming helpers for the Seed protocol JSON schema.
+ * Writing straight into the response avoids building intermediate FJsonObject trees.
+ */
+namespace AegisJson
+{
+    /** Write {"x","y","z"} */
+    inline void WriteVector(FAegisJsonWriter& Writer, const TCHAR* Identifier, const FVector& Vector)
+    {
+        Writer.WriteObjectStart(Identifier);
+        Writer.WriteValue(TEXT("x"), Vector.X);
+        Writer.WriteValue(TEXT("y"), Vector.Y);
+        Writer.WriteValue(TEXT("z"), Vector.Z);
+        Writer.WriteObjectEnd();
+    }
+
+    /** Write {"pitch","yaw","roll"} */
+    inline void WriteRotator(FAegisJsonWriter& Writer, const TCHAR* Identifier, const FRotator& Rotator)
+    {
+        Writer.WriteObjectStart(Identifier);
+        Writer.WriteValue(TEXT("pitch"), Rotator.Pitch);
+        Writer.WriteValue(TEXT("yaw"), Rotator.Yaw);
+        Writer.WriteValue(TEXT("roll"), Rotator.Roll);
+        Writer.WriteObjectEnd();
+    }
+
+    /** Write {"location","rotation","scale"} */
+    inline void WriteTransform(FAegisJsonWriter& Writer, const TCHAR* Identifier, const FVector& Location, const FRotator& Rotation, const FVector& Scale)
+    {
+        Writer.WriteObjectStart(Identifier);
+        WriteVector(Writer, TEXT("location"), Location);
+        WriteRotator(Writer, TEXT("rotation"), Rotation);
+        WriteVector(Writer, TEXT("scale"), Scale);
+        Writer.WriteObjectEnd();
+    }
+
+    /**
+     * Splice an already serialized JSON document into the writer without re-parsing it.
+     * Payloads that are not an object or array are written as a plain string instead.
+     */
+    inline void WriteRawJson(FAegisJsonWriter& Writer, const TCHAR* Identifier, const FString& Json)
+    {
+        const TCHAR* First = *Json;
+        while (*First && FChar::IsWhitespace(*First))
+        {
+            ++First;
+        }
+
+        if (*First == TCHAR('{') || *First == TCHAR('['))
+        {
+            Writer.WriteRawJSONValue(Identifier, Json);
+        }
+        else
+        {
+            Writer.WriteValue(Identifier, Json);
+        }
+    }
+}
@@ -0,0 +1,122 @@
+// Copyright AEGIS Team. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+class ALandscapeProxy;
+class FArchive;
+
+/** What UAegisSeedSubsystem::WriteLandscapes captures */
+struct FAegisLandscapeCaptureOptions
+{
+    /** Per-tile height hashes and the landscape's heightmap hash */
+    bool bIncludeHeightmap = false;
+
+    /** Per-tile weight hashes for every paint layer */
+    bool bIncludeLayers = false;
+
+    /** Tile hashes the caller already holds, by tile key; matching tiles are reported unchanged */
+    TMap<FString, FString> KnownTiles;
+
+    /** When set, the raw samples of every changed tile are written here as a tile blob */
+    FString TileDataPath;
+
+    /** Oodle codec for the tile blob ("none" to store it raw) */
+    FString Codec = TEXT("kraken");
+};
+
+/** Landscape sections of a tile blob written so far; the blob header is added when it is saved */
+struct FAegisLandscapeTileBlob
+{
+    TArray<uint8> Sections;
+    int32 SectionCount = 0;
+    int32 TileCount = 0;
+};
+
+/** One landscape component's worth of terrain data */
+struct FAegisLandscapeTile
+{
+    /** Component section base, in landscape vertex coordinates */
+    FIntPoint Origin = FIntPoint::ZeroValue;
+
+    /** Vertices per side; neighbouring tiles share their edge vertices */
+    int32 Size = 0;
+
+    uint64 HeightHash = 0;
+
+    /** One hash per captured layer, in FAegisLandscapeCapture layer order */
+    TArray<uint64> LayerHashes;
+
+    /** Hash over the height and layer hashes; what change detection compares */
+    uint64 Hash = 0;
+
+    /** Size * Size heights, row-major. Only kept when the capture keeps data. */
+    TArray<uint16> Heights;
+
+    /** Size * Size weights per layer, layers back to back. Only kept when the capture keeps data. */
+    TArray<uint8> Weights;
+};
+
+/**
+ * AEGIS Landscape Capture
+ * Reads a landscape proxy's height and paint layer weight data through
+ * FLandscapeEditDataInterface, one tile per landscape component, and hashes every tile.
+ * Reads happen on the game thread; hashing runs across worker threads.
+ *
+ * Tiles are keyed by the landscape GUID and the tile origin, so the proxies of one
+ * landscape share a key space and a caller can send back the hashes it already holds
+ * to learn which tiles changed.
+ */
+class AEGISBRIDGE_API FAegisLandscapeCapture
+{
+public:
+    struct FLayer
+    {
+        FName Name;
+        FString LayerInfoPath;
+
+        /** Hash over the layer's tile hashes */
+        uint64 Hash = 0;
+    };
+
+    /** Raw tile blob magic, "AGLT" */
+    static constexpr uint32 TileDataMagic = 0x544C4741;
+    static constexpr int32 TileDataVersion = 1;
+
+    /**
+     * Capture the proxy's components. bLayers adds weight data for every paint layer;
+     * bKeepData keeps the raw samples for SerializeTiles. Returns false if the proxy
+     * has no landscape info.
+     */
+    bool Capture(ALandscapeProxy* Proxy, bool bLayers, bool bKeepData);
+
+    const TArray<FAegisLandscapeTile>& GetTiles() const { return Tiles; }
+    const TArray<FLayer>& GetLayers() const { return Layers; }
+
+    /** Hash over every tile's height hash */
+    uint64 GetHeightHash() const { return HeightHash; }
+
+    int32 GetComponentSizeQuads() const { return ComponentSizeQuads; }
+
+    /** Change detection key of a tile: "<LandscapeGuid>:<X>,<Y>" */
+    FString GetTileKey(const FAegisLandscapeTile& Tile) const;
+
+    /** Hashes as 16 lowercase hex digits */
+    static FString HashToString(uint64 Hash);
+
+    /**
+     * Write one landscape section of the tile blob: proxy path, layer names, then each
+     * listed tile's origin, size, heights and weights. Requires a capture that kept data.
+     */
+    void SerializeTiles(FArchive& Ar, TConstArrayView<int32> TileIndices) const;
+
+private:
+    FString ProxyPath;
+    FGuid LandscapeGuid;
+    int32 ComponentSizeQuads = 0;
+    uint64 HeightHash = 0;
+
+    TArray<FLayer> Layers;
+    TArray<FAegisLandscapeTile> Tiles;
+};
@@ -0,0 +1,31 @@
+// Copyright AEGIS Team. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+/**
+ * AEGIS MessagePack
+ * Binary wire encoding negotiated per WebSocket client. Frames are produced by the same
+ * JSON writers as the text protocol and transcoded in one streaming pass, so every
+ * message keeps a single schema:
+ *
+ *   - objects and arrays use the smallest map/array header for their size
+ *   - integral numbers become the smallest int family, others float32 when exact, else float64
+ *   - strings are UTF-8 str, so clients decode without a UTF-16 round trip
+ *
+ * Clients tell the encodings apart by the first byte: JSON frames start with '{', MessagePack
+ * frames with a map header.
+ */
+class AEGISBRIDGE_API FAegisMessagePack
+{
+public:
+    /** Transcode a JSON document. Fails on malformed JSON. */
+    static bool FromJson(const FString& Json, TArray<uint8>& OutPacked);
+
+    /** Transcode a MessagePack document into condensed JSON. Fails on bin/ext or truncated data. */
+    static bool ToJson(const uint8* Data, int32 Size, FString& OutJson);
+
+    /** Whether a frame starts with a MessagePack map header rather than JSON text */
+    static bool IsMessagePack(const uint8* Data, int32 Size);
+};
@@ -0,0 +1,76 @@
+// Copyright AEGIS Team. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+class FJsonObject;
+
+/**
+ * AEGIS Parallel JSON
+ * Splits large JSON arrays into element views with one scan of the text, then parses the
+ * elements on worker threads. Decoders turn each element into a plain struct, so no JSON
+ * tree outlives the parse and the consuming thread only sees finished records.
+ *
+ * JSON parsing touches no UObjects, so any thread may call these.
+ */
+class AEGISBRIDGE_API FAegisParallelJson
+{
+public:
+    /** Elements parsed per worker task; smaller arrays are parsed on the calling thread */
+    static constexpr int32 ElementsPerTask = 64;
+
+    /** Element views of an array document. Fails if the brackets or strings do not balance. */
+    static bool SplitArray(FStringView Json, TArray<FStringView>& OutElements);
+
+    /**
+     * Top-level members of an object document as (key, value text). Keys are returned as
+     * written, without unescaping. Fails if the brackets or strings do not balance.
+     */
+    static bool SplitObject(FStringView Json, TArray<TPair<FStringView, FStringView>>& OutMembers);
+
+    /**
+     * Parse elements concurrently. Visit runs once per element that is an object, possibly on
+     * several threads at a time, and must only write state owned by that index.
+     * Returns false if any element is not valid JSON.
+     */
+    static bool ParseObjects(TConstArrayView<FStringView> Elements, TArray<bool>& OutIsObject,
+        TFunctionRef<void(int32 Index, const TSharedPtr<FJsonObject>& Object)> Visit);
+
+    /**
+     * Decode an array document into records, in order. Elements that are not objects are
+     * skipped, as the tree-based parsers do.
+     */
+    template <typename TRecord>
+    static bool ParseArray(FStringView Json, TArray<TRecord>& OutRecords,
+        TFunctionRef<void(const TSharedPtr<FJsonObject>& Object, TRecord& OutRecord)> Decode)
+    {
+        TArray<FStringView> Elements;
+        if (!SplitArray(Json, Elements))
+        {
+            return false;
+        }
+
+        TArray<TRecord> Records;
+        Records.SetNum(Elements.Num());
+
+        TArray<bool> IsObject;
+        if (!ParseObjects(Elements, IsObject, [&Records, &Decode](int32 Index, const TSharedPtr<FJsonObject>& Object)
+        {
+            Decode(Object, Records[Index]);
+        }))
+        {
+            return false;
+        }
+
+        OutRecords.Reserve(OutRecords.Num() + Records.Num());
+        for (int32 Index = 0; Index < Records.Num(); ++Index)
+        {
+            if (IsObject[Index])
+            {
+                OutRecords.Add(MoveTemp(Records[Index]));
+            }
+        }
+        return true;
+    }
+};
@@ -0,0 +1,116 @@
+// Copyright AEGIS Team. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "UObject/ObjectKey.h"
+#include "AegisJsonWriter.h"
+
+class FJsonObject;
+class FJsonValue;
+class FNumericProperty;
+class FProperty;
+class UEnum;
+
+/**
+ * AEGIS Property Plan
+ * The reflected properties of one UClass, resolved once: each property's value offset and a
+ * typed codec for the common types. Numbers, bools, enums, names, strings, vectors, rotators
+ * and hard object references are read and written directly; every other type goes through
+ * ExportText/ImportText.
+ *
+ * Captured properties are the ones editable on instances (CPF_Edit, not transient or
+ * deprecated); lookup by name covers every property of the class.
+ */
+class AEGISBRIDGE_API FAegisPropertyPlan
+{
+public:
+    enum class EKind : uint8
+    {
+        Bool,
+        Integer,
+        Float,
+        Enum,
+        Name,
+        String,
+        Vector,
+        Rotator,
+        Object,
+
+        /** ExportText/ImportText */
+        Text,
+    };
+
+    struct FEntry
+    {
+        FProperty* Property = nullptr;
+        FString Name;
+        int32 Offset = 0;
+        EKind Kind = EKind::Text;
+
+        /** Value property of numeric and enum kinds */
+        FNumericProperty* Numeric = nullptr;
+
+        /** Enum of the Enum kind */
+        UEnum* Enum = nullptr;
+
+        /** Required class of the Object kind */
+        UClass* ObjectClass = nullptr;
+
+        void* GetValuePtr(void* Container) const { return static_cast<uint8*>(Container) + Offset; }
+        const void* GetValuePtr(const void* Container) const { return static_cast<const uint8*>(Container) + Offset; }
+    };
+
+    explicit FAegisPropertyPlan(const UClass* Class);
+
+    /** Property by name, case-insensitive; never creates a name */
+    const FEntry* Find(const FString& Name) const;
+
+    /** Properties written by WriteProperties, in class order */
+    TConstArrayView<int32> GetCaptured() const { return Captured; }
+
+    const FEntry& GetEntry(int32 Index) const { return Entries[Index]; }
+
+    /** Write every captured property of Object as the fields of an open JSON object */
+    void WriteProperties(FAegisJsonWriter& Writer, const UObject* Object) const;
+
+    /** Captured properties as a JSON object */
+    TSharedPtr<FJsonObject> ToJsonObject(const UObject* Object) const;
+
+    /** Write one value; Identifier may be null inside an array */
+    static void WriteValue(FAegisJsonWriter& Writer, const TCHAR* Identifier, const FEntry& Entry, const UObject* Object);
+
+    /** One value as a JSON value */
+    static TSharedPtr<FJsonValue> ToJsonValue(const FEntry& Entry, const UObject* Object);
+
+    /** Set a value from text: the typed form first, ImportText otherwise */
+    static bool ImportText(const FEntry& Entry, UObject* Object, const FString& Text);
+
+    /** Set a value from JSON written by WriteValue, or from a string taken as text */
+    static bool ImportJson(const FEntry& Entry, UObject* Object, const FJsonValue& Value);
+
+private:
+    TArray<FEntry> Entries;
+    TArray<int32> Captured;
+    TMap<FName, int32> ByName;
+};
+
+/**
+ * Property plans by class, built on first use. Game thread only.
+ * Blueprint compiles and code reloads change class layouts, so they drop every plan.
+ */
+class AEGISBRIDGE_API FAegisPropertyPlanCache
+{
+public:
+    const FAegisPropertyPlan& Get(const UClass* Class);
+
+    /** Set a property of an object by name from text. Returns false for unknown properties or bad values. */
+    bool SetProperty(UObject* Object, const FString& Name, const FString& Value);
+
+    void Reset() { Plans.Reset(); }
+
+    int32 Num() const { return Plans.Num(); }
+
+private:
+    TMap<FObjectKey, TUniquePtr<FAegisPropertyPlan>> Plans;
+};
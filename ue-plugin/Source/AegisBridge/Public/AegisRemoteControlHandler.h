@@ -4,8 +4,73 @@
 
 #include "CoreMinimal.h"
 #include "UObject/NoExportTypes.h"
+#include "Dom/JsonObject.h"
+#include "AegisJsonWriter.h"
 #include "AegisRemoteControlHandler.generated.h"
 
+/**
+ * Typed read-only view over a request's JSON parameters.
+ * Missing or mistyped fields fall back to the supplied default.
+ */
+class AEGISBRIDGE_API FAegisRequestParams
+{
+public:
+    explicit FAegisRequestParams(const TSharedPtr<FJsonObject>& InObject);
+
+    FString GetString(const FString& Field, const FString& Default = FString()) const;
+    int32 GetInt(const FString& Field, int32 Default = 0) const;
+    double GetNumber(const FString& Field, double Default = 0.0) const;
+    bool GetBool(const FString& Field, bool bDefault = false) const;
+
+    /** Accepts {x,y,z} objects or "X=.. Y=.. Z=.." strings */
+    FVector GetVector(const FString& Field, const FVector& Default = FVector::ZeroVector) const;
+
+    /** Accepts {pitch,yaw,roll} objects or "P=.. Y=.. R=.." strings */
+    FRotator GetRotator(const FString& Field, const FRotator& Default = FRotator::ZeroRotator) const;
+
+    TArray<FString> GetStringArray(const FString& Field) const;
+    TMap<FString, FString> GetStringMap(const FString& Field) const;
+
+    /** Field as JSON text; string fields are returned verbatim, anything else is serialized */
+    FString GetJsonString(const FString& Field, const FString& Default = FString()) const;
+
+    /** Raw array access, nullptr if absent */
+    const TArray<TSharedPtr<FJsonValue>>* GetArray(const FString& Field) const;
+
+    /** Nested parameter object, or this object if the field is absent */
+    FAegisRequestParams GetNested(const FString& Field) const;
+
+    bool Has(const FString& Field) const;
+
+private:
+    TSharedPtr<FJsonObject> Object;
+};
+
+/**
+ * Dispatch table key: (subsystem namespace, function name), both pre-hashed FNames
+ */
+struct FAegisRouteKey
+{
+    FName Namespace;
+    FName Function;
+
+    bool operator==(const FAegisRouteKey& Other) const
+    {
+        return Namespace == Other.Namespace && Function == Other.Function;
+    }
+
+    friend uint32 GetTypeHash(const FAegisRouteKey& Key)
+    {
+        return HashCombine(GetTypeHash(Key.Namespace), GetTypeHash(Key.Function));
+    }
+};
+
+/**
+ * Route handler: decodes typed parameters, invokes the command and writes the response
+ * fields straight into the already opened response object. Returns the success it wrote.
+ */
+using FAegisRouteHandler = TFunction<bool(const FAegisRequestParams& Params, FAegisJsonWriter& Writer)>;
+
 /**
  * AEGIS Remote Control Handler
  * Handles Remote Control API requests from MCP server
@@ -29,9 +94,30 @@ public:
     UFUNCTION(BlueprintCallable, Category = "AEGIS|RemoteControl")
     FString HandleRequest(const FString& ObjectPath, const FString& FunctionName, const FString& Parameters);
 
+    /** Handle a request and report the success its route returned */
+    FString HandleRequest(const FString& ObjectPath, const FString& FunctionName, const FString& Parameters, bool& bOutSuccess);
+
     /** Check if handler is ready */
     bool IsReady() const { return bIsReady; }
 
+    /** Register a route; replaces any existing handler for the same key */
+    void AddRoute(FName Namespace, FName Function, FAegisRouteHandler Handler);
+
+    /** Number of registered routes */
+    int32 GetRouteCount() const { return Routes.Num(); }
+
+    /** Route namespace of UAegisSubsystem */
+    static const FName NAME_AegisSubsystem;
+
+    /** Route namespace of UAegisSeedSubsystem */
+    static const FName NAME_AegisSeedSubsystem;
+
+    /** Route namespace of UAegisChangeJournal */
+    static const FName NAME_AegisChangeJournal;
+
+    /** Route namespace of UAegisJobManager */
+    static const FName NAME_AegisJobManager;
+
 protected:
     /** Register AEGIS function handlers */
     void RegisterFunctionHandlers();
@@ -39,9 +125,39 @@ protected:
     /** Unregister AEGIS function handlers */
     void UnregisterFunctionHandlers();
 
+private:
+    /** Register the UAegisSubsystem command surface */
+    void RegisterSubsystemRoutes();
+
+    /** Register the UAegisSeedSubsystem command surface */
+    void RegisterSeedRoutes();
+
+    /** Register the UAegisChangeJournal command surface */
+    void RegisterJournalRoutes();
+
+    /** Register the UAegisJobManager command surface */
+    void RegisterJobRoutes();
+
+    /** Map an object path such as "/Script/AegisBridge.AegisSeedSubsystem" to its route namespace */
+    static FName ResolveNamespace(const FString& ObjectPath);
+
 private:
     bool bIsReady = false;
 
+    struct FRoute
+    {
+        FAegisRouteHandler Handler;
+
+        /** "request.<Namespace>.<Function>", built once at registration */
+        FName Metric;
+    };
+
+    /** Constant-time dispatch table */
+    TMap<FAegisRouteKey, FRoute> Routes;
+
+    /** Namespaces with at least one route, to tell unknown objects from unknown functions */
+    TSet<FName> Namespaces;
+
     /** Singleton instance */
     static UAegisRemoteControlHandler* Instance;
 };
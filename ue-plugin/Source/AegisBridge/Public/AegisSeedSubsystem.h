@@ -4,8 +4,23 @@
 
 #include "CoreMinimal.h"
 #include "Subsystems/EditorSubsystem.h"
+#include "Containers/Ticker.h"
+#include "AegisActorQuery.h"
+#include "AegisGUIDRegistry.h"
+#include "AegisJsonWriter.h"
+#include "AegisSnapshotStore.h"
+#include "AegisSnapshotDelta.h"
 #include "AegisSeedSubsystem.generated.h"
 
+class AActor;
+class ALandscapeProxy;
+struct FAegisFoliageCaptureOptions;
+struct FAegisFoliageRestoreResult;
+struct FAegisLandscapeCaptureOptions;
+struct FAegisLandscapeTileBlob;
+struct FAegisMergeOptions;
+struct FAegisWorldHashOptions;
+
 /**
  * GUID Entry for tracking entities
  */
@@ -36,6 +51,30 @@ struct FAegisGUIDEntry
     int32 Version = 1;
 };
 
+/**
+ * Resumable paged actor capture.
+ * The actor set and order are fixed when the session opens, so pages stay consistent
+ * while the caller pulls them; actors destroyed in between are skipped.
+ */
+struct FAegisCaptureSession
+{
+    /** Filtered actors in capture order */
+    TArray<TWeakObjectPtr<AActor>> Actors;
+
+    /** Last time a page was pulled, for idle expiry */
+    double LastAccessTime = 0.0;
+};
+
+/**
+ * Outcome of applying a delta to the editor world
+ */
+struct FAegisDeltaApplyResult
+{
+    int32 Applied = 0;
+    int32 Skipped = 0;
+    TArray<FString> Warnings;
+};
+
 /**
  * World snapshot data
  */
@@ -89,10 +128,23 @@ public:
     UFUNCTION(BlueprintCallable, Category = "AEGIS|Seed")
     FString GenerateGUID(const FString& Namespace, const FString& EntityType, const FString& Seed, int32 Counter, const FString& EntityName);
 
+    /**
+     * Generate Count GUIDs for consecutive counters from StartCounter, with the entity names
+     * batch_generate_guids uses ("<EntityType>_<Index>")
+     */
+    UFUNCTION(BlueprintCallable, Category = "AEGIS|Seed")
+    TArray<FString> GenerateGUIDBatch(const FString& Namespace, const FString& EntityType, const FString& Seed, int32 StartCounter, int32 Count);
+
     /** Register a GUID with an entity */
     UFUNCTION(BlueprintCallable, Category = "AEGIS|Seed")
     bool RegisterGUID(const FString& GUID, const FString& EntityPath, const FString& EntityType, const FString& Metadata);
 
+    /**
+     * Register many GUIDs in one pass. OutResults, when given, receives one result per
+     * registration. Returns the number registered.
+     */
+    int32 RegisterGUIDs(TConstArrayView<FAegisGUIDRegistration> Registrations, TArray<EAegisGUIDRegisterResult>* OutResults = nullptr);
+
     /** Resolve a GUID to its entity */
     UFUNCTION(BlueprintCallable, Category = "AEGIS|Seed")
     bool ResolveGUID(const FString& GUID, FAegisGUIDEntry& OutEntry);
@@ -101,6 +153,9 @@ public:
     UFUNCTION(BlueprintCallable, Category = "AEGIS|Seed")
     bool VerifyGUIDEntity(const FString& GUID, const FString& EntityPath);
 
+    /** The GUID registry. Read-only; capture workers look actors up here while the game thread waits. */
+    const FAegisGUIDRegistry& GetGUIDRegistry() const { return GUIDRegistry; }
+
     /** Clear the GUID registry */
     UFUNCTION(BlueprintCallable, Category = "AEGIS|Seed")
     void ClearGUIDRegistry();
@@ -125,14 +180,52 @@ public:
     UFUNCTION(BlueprintCallable, Category = "AEGIS|Seed")
     FString CaptureAllActors(const TArray<FString>& ClassFilter, const TArray<FString>& TagFilter);
 
+    /** Stream the CaptureAllActors document into an open writer, encoding it exactly once */
+    void WriteAllActors(FAegisJsonWriter& Writer, const TArray<FString>& ClassFilter, const TArray<FString>& TagFilter);
+
+    /** Compile the capture class and tag filters into a query */
+    static FAegisActorQuery MakeCaptureQuery(const TArray<FString>& ClassFilter, const TArray<FString>& TagFilter);
+
+    /**
+     * Capture one page of actors. Pass an empty cursor to open a new capture session,
+     * then the returned nextCursor until it comes back empty.
+     */
+    UFUNCTION(BlueprintCallable, Category = "AEGIS|Seed")
+    FString CaptureActorsPage(const FString& Cursor, int32 PageSize, const TArray<FString>& ClassFilter, const TArray<FString>& TagFilter);
+
+    /** Stream one capture page into an open writer */
+    void WriteActorsPage(FAegisJsonWriter& Writer, const FString& Cursor, int32 PageSize, const TArray<FString>& ClassFilter, const TArray<FString>& TagFilter);
+
+    /** Write every matching actor to a file as NDJSON, one actor object per line, in fixed-size chunks. Returns the actor count or INDEX_NONE. */
+    UFUNCTION(BlueprintCallable, Category = "AEGIS|Seed")
+    int32 ExportActorsNDJSON(const FString& FilePath, const TArray<FString>& ClassFilter, const TArray<FString>& TagFilter);
+
     /** Capture landscape data */
     UFUNCTION(BlueprintCallable, Category = "AEGIS|Seed")
     FString CaptureLandscape(bool bIncludeHeightmap, bool bIncludeLayers);
 
+    /** Stream the landscape capture into an open writer, with per-tile hashes and optional raw tile data */
+    void WriteLandscapes(FAegisJsonWriter& Writer, const FAegisLandscapeCaptureOptions& Options);
+
+    /** Write one landscape object of the "landscapes" array; changed tiles are appended to TileBlob when tile data is requested */
+    void WriteLandscape(FAegisJsonWriter& Writer, ALandscapeProxy* Landscape, const FAegisLandscapeCaptureOptions& Options, FAegisLandscapeTileBlob& TileBlob);
+
+    /** Compress and write the tile blob to Options.TileDataPath. Touches no UObjects, so any thread may call it. */
+    static bool SaveLandscapeTileBlob(const FAegisLandscapeCaptureOptions& Options, const FAegisLandscapeTileBlob& TileBlob);
+
+    /** Write the "tileData" object describing a saved (or failed) tile blob */
+    static void WriteLandscapeTileData(FAegisJsonWriter& Writer, const FAegisLandscapeCaptureOptions& Options, const FAegisLandscapeTileBlob& TileBlob, bool bSaved);
+
     /** Capture foliage data */
     UFUNCTION(BlueprintCallable, Category = "AEGIS|Seed")
     FString CaptureFoliage(bool bIncludeInstances);
 
+    /** Stream the foliage capture into an open writer, with per-cell hashes and optional packed instance data */
+    void WriteFoliage(FAegisJsonWriter& Writer, const FAegisFoliageCaptureOptions& Options);
+
+    /** Replace the foliage cells of an instance data blob written by WriteFoliage, inside one transaction */
+    bool RestoreFoliage(const FString& InputPath, int32 BatchSize, FAegisFoliageRestoreResult& OutResult, FString& OutError);
+
     /** Store a snapshot */
     UFUNCTION(BlueprintCallable, Category = "AEGIS|Seed")
     bool StoreSnapshot(const FString& SnapshotId, const FString& SnapshotData);
@@ -153,6 +246,13 @@ public:
     UFUNCTION(BlueprintCallable, Category = "AEGIS|Seed")
     bool ExportSnapshot(const FString& SnapshotId, const FString& SnapshotData, const FString& OutputPath, bool bCompress);
 
+    /**
+     * Export snapshot with explicit format and compression.
+     * Codec is "none", "kraken", "mermaid", "selkie" or "leviathan"; CompressionLevel is the Oodle level (-4..8).
+     */
+    UFUNCTION(BlueprintCallable, Category = "AEGIS|Seed")
+    bool ExportSnapshotWithOptions(const FString& SnapshotId, const FString& SnapshotData, const FString& OutputPath, bool bBinary, const FString& Codec, int32 CompressionLevel);
+
     /** Import snapshot from file */
     UFUNCTION(BlueprintCallable, Category = "AEGIS|Seed")
     FString ImportSnapshot(const FString& InputPath);
@@ -165,13 +265,53 @@ public:
     UFUNCTION(BlueprintCallable, Category = "AEGIS|Seed")
     bool RestoreWorldState(const FString& SnapshotId, const FString& Entities, const FString& MergeMode, bool bPreserveGUIDs);
 
-    /** Synchronize world state with target */
+    /** Restore world state straight from a binary snapshot file, without going through JSON */
+    UFUNCTION(BlueprintCallable, Category = "AEGIS|Seed")
+    bool RestoreWorldStateFromFile(const FString& InputPath, const FString& MergeMode, bool bPreserveGUIDs);
+
+    /**
+     * Parse a restore merge mode. "merge" and "selective" add the snapshot's entities to the
+     * level; "replace" also destroys the tracked actors first. Returns false for any other mode.
+     */
+    static bool ParseMergeMode(const FString& MergeMode, bool& bOutReplace);
+
+    /** Actors in the world with a registered GUID: the set a "replace" restore swaps for the snapshot's */
+    TArray<AActor*> GetTrackedActors(UWorld* World) const;
+
+    // =========================================================================
+    // Delta Snapshots
+    // =========================================================================
+
+    /**
+     * Capture the current world as a delta against the head of a base snapshot's chain.
+     * The first capture for an unknown id stores the world as that base.
+     */
     UFUNCTION(BlueprintCallable, Category = "AEGIS|Seed")
-    FString SyncWorldState(const FString& TargetSnapshotId, const FString& TargetEntities, bool bCaptureCurrentFirst, const FString& ConflictResolution, bool bDryRun);
+    FString CaptureDeltaSnapshot(const FString& BaseSnapshotId);
 
-    /** Merge world states */
+    /** Get the change records of a delta */
     UFUNCTION(BlueprintCallable, Category = "AEGIS|Seed")
-    FString MergeWorldStates(const FString& SourceSnapshotId, const FString& TargetSnapshotId, const FString& Changes, const FString& ConflictResolution, bool bPreserveSourceGUIDs);
+    FString GetDeltaSnapshot(const FString& BaseSnapshotId, const FString& DeltaId);
+
+    /** Fold a chain's deltas into a compacted base; the stored base snapshot is not modified */
+    UFUNCTION(BlueprintCallable, Category = "AEGIS|Seed")
+    FString CompactDeltaChain(const FString& BaseSnapshotId);
+
+    /**
+     * Synchronize world state with target. With a base snapshot the world's own edits since
+     * the base are kept, and entities both changed are settled by ConflictResolution.
+     */
+    UFUNCTION(BlueprintCallable, Category = "AEGIS|Seed")
+    FString SyncWorldState(const FString& TargetSnapshotId, const FString& TargetEntities, bool bCaptureCurrentFirst, const FString& ConflictResolution, bool bDryRun, const FString& BaseSnapshotId = TEXT(""));
+
+    /**
+     * Merge the changes from target to source into the world. When the store holds both
+     * snapshots this is a three-way merge against the current world, limited to the entities
+     * listed in Changes if any; otherwise the client's diff records are applied.
+     */
+    UFUNCTION(BlueprintCallable, Category = "AEGIS|Seed")
+    FString MergeWorldStates(const FString& SourceSnapshotId, const FString& TargetSnapshotId, const FString& Changes, const FString& ConflictResolution, bool bPreserveSourceGUIDs,
+        bool bDryRun = false, bool bIncludeTransforms = true, bool bIncludeProperties = true);
 
     /** Apply a diff to the world */
     UFUNCTION(BlueprintCallable, Category = "AEGIS|Seed")
@@ -185,15 +325,30 @@ public:
     UFUNCTION(BlueprintCallable, Category = "AEGIS|Seed")
     FString GetCurrentLevelInfo();
 
+    /** Stream the GetCurrentLevelInfo document into an open writer */
+    void WriteCurrentLevelInfo(FAegisJsonWriter& Writer);
+
+    /** Merkle hash of the world (or of a stored snapshot), with its tree down to Depth */
+    UFUNCTION(BlueprintCallable, Category = "AEGIS|Seed")
+    FString ComputeWorldHash(int32 Depth = 1);
+
+    /**
+     * Stream success and the world hash into an open object, returning the success written.
+     * SnapshotId hashes a stored snapshot instead of the live world; KnownHashes adds the
+     * mismatching subtrees.
+     */
+    bool WriteWorldHash(FAegisJsonWriter& Writer, const FAegisWorldHashOptions& Options, int32 Depth,
+        const TMap<FString, FString>& KnownHashes, const FString& SnapshotId);
+
 private:
-    /** GUID Registry */
-    TMap<FString, FAegisGUIDEntry> GUIDRegistry;
+    /** GUID Registry, persisted under Saved/Aegis */
+    FAegisGUIDRegistry GUIDRegistry;
 
-    /** Path to GUID mapping */
-    TMap<FString, FString> PathToGUIDMap;
+    /** Periodic save of a changed registry */
+    FTSTicker::FDelegateHandle RegistrySaveHandle;
 
-    /** Snapshot storage */
-    TMap<FString, FString> SnapshotStorage;
+    /** Disk-backed snapshot storage */
+    FAegisSnapshotStore SnapshotStore;
 
     /** Global seed for GUID generation */
     FString GlobalSeed;
@@ -201,9 +356,84 @@ private:
     /** Counter for GUID generation */
     int32 SeedCounter = 0;
 
-    /** Get namespace code */
-    FString GetNamespaceCode(const FString& Namespace);
+    /** Open paged capture sessions by session id */
+    TMap<FString, FAegisCaptureSession> CaptureSessions;
+
+    /** Delta chains by base snapshot id, loaded on first use */
+    TMap<FString, FAegisDeltaChain> DeltaChains;
+
+    /** Chain for a base snapshot, loading the base from the store on first use */
+    FAegisDeltaChain* FindOrLoadDeltaChain(const FString& BaseSnapshotId);
+
+    /**
+     * Compact a chain, persist its head as the chain's compacted base and drop its stored
+     * deltas. The user's base snapshot is left as captured.
+     */
+    bool CompactChain(FAegisDeltaChain& Chain);
+
+    /** Persist one delta of a chain as a delta record of its base */
+    bool StoreDelta(const FAegisSnapshotDelta& Delta);
+
+    /** Find a delta of any base by id, through the store index; loaded chains are not replayed */
+    bool LoadStoredDelta(const FString& DeltaId, FAegisSnapshotDelta& OutDelta);
+
+    /** Delete every stored delta record of a base, optionally keeping its compacted base */
+    void RemoveStoredDeltas(const FString& BaseSnapshotId, bool bIncludeCompactedBase = true);
+
+    /** Store id of a delta record */
+    static FString GetDeltaStoreId(const FString& BaseSnapshotId, const FString& DeltaId);
+
+    /** Index metadata of a decoded snapshot */
+    static FAegisSnapshotRecord MakeSnapshotRecord(const FAegisBinarySnapshot& Snapshot);
+
+    /** Index metadata of a client's snapshot document, read from its header members */
+    static FAegisSnapshotRecord ReadSnapshotRecord(const FString& SnapshotData);
+
+    /** Store id of the compacted base a chain replays from instead of the user's snapshot */
+    static FString GetCompactedBaseStoreId(const FString& BaseSnapshotId);
+
+    /** Decode a stored snapshot; false for an empty id or a snapshot the store does not hold */
+    bool LoadSnapshotState(const FString& SnapshotId, FAegisBinarySnapshot& OutSnapshot);
+
+    /** Fill the change times a Newest resolution compares */
+    static void SetMergeTimes(FAegisMergeOptions& Options, const FAegisBinarySnapshot& Base, const FAegisBinarySnapshot& Theirs);
+
+    /** Capture every actor of the world into snapshot records, with the named properties as text */
+    void CaptureWorldState(UWorld* World, FAegisBinarySnapshot& OutSnapshot, TConstArrayView<FString> Properties = TConstArrayView<FString>());
+
+    /** Root of the world hash of a state with default options, as a snapshot checksum */
+    static FString ComputeChecksum(const FAegisBinarySnapshot& State);
+
+    /** Resolve an entity key (registered GUID or path) to an actor */
+    AActor* FindEntityActor(UWorld* World, const FString& EntityKey, const FString& FallbackPath);
+
+    /** Import properties from a condensed JSON block, typed values or text */
+    static int32 ApplyEntityProperties(AActor* Actor, const FString& PropertiesJson);
+
+    /** Apply a delta to the world inside one transaction */
+    void ApplyDeltaToWorld(UWorld* World, const FAegisSnapshotDelta& Delta, bool bPreserveGUIDs, FAegisDeltaApplyResult& OutResult);
+
+    /** Write plannedChanges, summary and, unless dry run, the apply outcome */
+    static void WriteDeltaApplyResult(FAegisJsonWriter& Writer, const FAegisSnapshotDelta& Delta, const FAegisDeltaApplyResult& Result, bool bDryRun);
+
+    /** Spawn one snapshot entity, resolving its class through the cache */
+    AActor* SpawnSnapshotEntity(UWorld* World, const FAegisBinarySnapshot& Snapshot, const FAegisSnapshotEntity& Entity, TMap<int32, UClass*>& ClassCache, bool bPreserveGUIDs);
+
+    /** Spawn the entities of a decoded snapshot inside one transaction. Returns the restored count, or INDEX_NONE for an unknown merge mode. */
+    int32 RestoreSnapshotEntities(UWorld* World, FAegisBinarySnapshot&& Snapshot, const FString& MergeMode, bool bPreserveGUIDs);
+
+    /** Write a binary capture blob, wrapped in the Oodle container unless Codec is "none" */
+    static bool SaveDataBlob(const FString& FilePath, const FString& Codec, TArray<uint8>& Payload);
+
+    /** Read a binary capture blob, unwrapping the Oodle container if present */
+    static bool LoadDataBlob(const FString& FilePath, TArray<uint8>& OutPayload);
+
+    /** GUID registry file path */
+    static FString GetGUIDRegistryPath();
+
+    /** Save the GUID registry if it changed; ticker callback */
+    bool SaveGUIDRegistry(float DeltaTime);
 
-    /** Compute SHA256 hash */
-    FString ComputeSHA256(const FString& Input);
+    /** Drop capture sessions nobody pulled from recently */
+    void ExpireCaptureSessions();
 };
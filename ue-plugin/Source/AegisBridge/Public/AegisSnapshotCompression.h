@@ -0,0 +1,43 @@
+// Copyright AEGIS Team. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Compression/OodleDataCompression.h"
+
+/**
+ * AEGIS Snapshot Compression
+ * Oodle container for exported snapshots:
+ *
+ *   Magic | Version | Codec | Level | Uncompressed size | Compressed size | Payload
+ *
+ * The payload is either a JSON or a binary snapshot; readers detect the container by
+ * its magic and fall through to the uncompressed formats otherwise.
+ */
+class AEGISBRIDGE_API FAegisSnapshotCompression
+{
+public:
+    using ECompressor = FOodleDataCompression::ECompressor;
+    using ECompressionLevel = FOodleDataCompression::ECompressionLevel;
+
+    /** Container magic, "AGSZ" */
+    static constexpr uint32 Magic = 0x5A534741;
+
+    /** Current container version */
+    static constexpr uint32 Version = 1;
+
+    /** Compress a payload into a container. Fails if the payload does not compress. */
+    static bool Compress(const TArray<uint8>& Payload, TArray<uint8>& OutContainer, ECompressor Compressor, ECompressionLevel Level);
+
+    /** Extract the payload of a container */
+    static bool Decompress(const TArray<uint8>& Container, TArray<uint8>& OutPayload);
+
+    /** Check a buffer for the container magic */
+    static bool IsCompressed(const TArray<uint8>& Data);
+
+    /** Parse a codec name ("kraken", "mermaid", "selkie", "leviathan"). "none" and empty yield NotSet. */
+    static bool ParseCompressor(const FString& Name, ECompressor& OutCompressor);
+
+    /** Map a numeric level (-4 HyperFast4 .. 8 Optimal4) onto the Oodle level enum */
+    static ECompressionLevel ToCompressionLevel(int32 Level);
+};
@@ -0,0 +1,109 @@
+// Copyright AEGIS Team. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "AegisBinarySnapshot.h"
+
+/**
+ * Kinds of change recorded for one entity
+ */
+enum class EAegisEntityChange : uint8
+{
+    None = 0,
+    Added = 1 << 0,
+    Removed = 1 << 1,
+    Transform = 1 << 2,
+    Properties = 1 << 3,
+
+    /** Class, name, parent, tags, components or references */
+    Structure = 1 << 4,
+};
+ENUM_CLASS_FLAGS(EAegisEntityChange)
+
+/**
+ * AEGIS Snapshot Delta
+ * Per-entity change records between two snapshot states, keyed by entity GUID
+ * (or path for entities without a registered GUID). Added and modified entities carry
+ * their complete new state so a delta can be applied without its predecessor's payload.
+ */
+class AEGISBRIDGE_API FAegisSnapshotDelta
+{
+public:
+    FString DeltaId;
+
+    /** Snapshot the chain starts from */
+    FString BaseSnapshotId;
+
+    /** Previous delta in the chain, empty for the first delta */
+    FString ParentDeltaId;
+
+    /** New state of added and modified entities */
+    FAegisBinarySnapshot Upserts;
+
+    /** Change flags, parallel to Upserts.Entities */
+    TArray<EAegisEntityChange> Changes;
+
+    /** Keys of removed entities */
+    TArray<FString> Removed;
+
+    /** Compare two states. Transforms are equal when every component is within Tolerance. */
+    static FAegisSnapshotDelta Compute(const FAegisBinarySnapshot& From, const FAegisBinarySnapshot& To, float Tolerance = 1.e-3f);
+
+    /** Apply the changes onto a snapshot state */
+    void ApplyTo(FAegisBinarySnapshot& State) const;
+
+    /** Total number of change records */
+    int32 Num() const { return Changes.Num() + Removed.Num(); }
+
+    bool IsEmpty() const { return Num() == 0; }
+
+    /** Number of records with the given change flag */
+    int32 CountChanges(EAegisEntityChange Change) const;
+
+    /** Write {deltaId, baseSnapshotId, parentDeltaId, summary, records} */
+    void WriteJson(FAegisJsonWriter& Writer) const;
+
+    /** WriteJson as a string */
+    FString ToJson() const;
+
+    /** Read a delta written by WriteJson */
+    bool FromJson(FStringView Json);
+
+    /** Write the records without entity state: [{guid, fields}] */
+    void WriteChangeList(FAegisJsonWriter& Writer, const TCHAR* Identifier) const;
+
+    /** Classify how an entity changed between two states; safe on any thread */
+    static EAegisEntityChange DiffEntity(const FAegisBinarySnapshot& A, const FAegisSnapshotEntity& EntityA, const FAegisBinarySnapshot& B, const FAegisSnapshotEntity& EntityB, float Tolerance);
+
+    /** Write change flags as an array of names */
+    static void WriteChangeNames(FAegisJsonWriter& Writer, const TCHAR* Identifier, EAegisEntityChange Change);
+
+    /**
+     * Build a delta from the MCP diff schema: [{changeType: added|removed|modified, guid, targetEntity, ...}].
+     * "modified" records are applied with their full target state.
+     */
+    bool FromDiffJson(const FString& Json);
+};
+
+/**
+ * A base snapshot followed by deltas, with the resulting head state cached
+ */
+struct FAegisDeltaChain
+{
+    FString BaseSnapshotId;
+
+    /** Base with every delta applied */
+    FAegisBinarySnapshot Head;
+
+    TArray<FAegisSnapshotDelta> Deltas;
+
+    /** Find a delta by id */
+    const FAegisSnapshotDelta* FindDelta(const FString& DeltaId) const;
+
+    /**
+     * Fold every delta into a fresh head state and drop them. The string table is rebuilt
+     * so strings only referenced by replaced entities are released.
+     */
+    void Compact();
+};
@@ -0,0 +1,116 @@
+// Copyright AEGIS Team. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "AegisSnapshotDelta.h"
+
+/**
+ * Which side wins a conflicting change
+ */
+enum class EAegisMergeResolution : uint8
+{
+    /** The incoming state */
+    Theirs,
+
+    /** The current world */
+    Ours,
+
+    /** The side whose change is more recent */
+    Newest,
+
+    /** Neither: conflicts are reported and left out of the delta */
+    Manual,
+};
+
+/**
+ * How both sides changed one entity
+ */
+enum class EAegisMergeConflictKind : uint8
+{
+    /** Both sides changed the same fields differently */
+    Modified,
+
+    /** Both sides added the entity, with different state */
+    Added,
+
+    /** Ours removed the entity, theirs changed it */
+    RemovedOurs,
+
+    /** Theirs removed the entity, ours changed it */
+    RemovedTheirs,
+};
+
+/**
+ * One entity both sides changed
+ */
+struct FAegisMergeConflict
+{
+    FString Key;
+    EAegisMergeConflictKind Kind = EAegisMergeConflictKind::Modified;
+
+    /** Fields changed on both sides */
+    EAegisEntityChange Fields = EAegisEntityChange::None;
+
+    /** Whether the delta carries theirs for this entity */
+    bool bTheirsApplied = false;
+};
+
+/**
+ * Parameters of FAegisSnapshotMerge::Merge
+ */
+struct FAegisMergeOptions
+{
+    EAegisMergeResolution Resolution = EAegisMergeResolution::Manual;
+
+    /** Fields taken from theirs; Added and Removed are always considered */
+    EAegisEntityChange Fields = EAegisEntityChange::Transform | EAegisEntityChange::Properties | EAegisEntityChange::Structure;
+
+    /** Transforms are equal when every component is within Tolerance */
+    float Tolerance = 1.e-3f;
+
+    /** When set, only these entity keys are merged */
+    TSet<FString> OnlyKeys;
+
+    /** Time of theirs' changes, for Newest */
+    FDateTime TheirsTime;
+
+    /** Time of each of ours' changes, by entity path, for Newest */
+    TMap<FString, FDateTime> OursTimes;
+
+    /** Time of ours' changes with no entry in OursTimes */
+    FDateTime OursDefaultTime;
+};
+
+/**
+ * AEGIS Snapshot Merge
+ * Three-way merge of snapshot states keyed by entity GUID (or path). Base is the state both
+ * sides started from; ours is the current world and theirs is the state being merged in.
+ * Every entity is classified per field against base on both sides: changes only theirs made
+ * are taken, changes only ours made are kept, and fields both changed to different values
+ * are conflicts settled by the resolution.
+ *
+ * The hash joins are built up front and entities are classified on worker threads; the
+ * resulting delta is assembled in theirs' order, so it applies through the same path as
+ * delta snapshots.
+ */
+class AEGISBRIDGE_API FAegisSnapshotMerge
+{
+public:
+    /**
+     * Merge theirs into ours. OutDelta holds the changes to apply to the world, with
+     * upserts carrying theirs' state and flags naming the fields to take from it.
+     */
+    static void Merge(const FAegisBinarySnapshot& Base, const FAegisBinarySnapshot& Ours, const FAegisBinarySnapshot& Theirs,
+        const FAegisMergeOptions& Options, FAegisSnapshotDelta& OutDelta, TArray<FAegisMergeConflict>& OutConflicts);
+
+    /**
+     * Parse a Seed protocol conflict resolution: "source", "target", "newest" or "manual".
+     * bSourceIsTheirs tells whether "source" names the incoming state or the current world.
+     * Empty selects Manual.
+     */
+    static bool ParseResolution(const FString& Name, bool bSourceIsTheirs, EAegisMergeResolution& OutResolution);
+
+    /** Write conflicts as [{guid, kind, fields, resolution}] */
+    static void WriteConflicts(FAegisJsonWriter& Writer, TConstArrayView<FAegisMergeConflict> Conflicts, EAegisMergeResolution Resolution);
+};
@@ -0,0 +1,136 @@
+// Copyright AEGIS Team. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+class IMappedFileHandle;
+class IMappedFileRegion;
+
+/**
+ * Snapshot metadata kept in the store index
+ */
+struct FAegisSnapshotRecord
+{
+    FString SnapshotId;
+    FString Name;
+    FString Description;
+    FString Checksum;
+    FDateTime Timestamp;
+    int32 EntityCount = 0;
+
+    /** Payload file name, relative to the store directory */
+    FString FileName;
+
+    /** Payload size in bytes */
+    int64 Size = 0;
+
+    /** Snapshot a delta record belongs to; empty for full snapshots */
+    FString BaseSnapshotId;
+
+    /** Bytes per character of the payload: sizeof(TCHAR) for text viewed in place, 1 for UTF-8 */
+    int32 CharSize = 1;
+};
+
+/**
+ * AEGIS Snapshot Store
+ * Disk-backed snapshot storage under Saved/Aegis/Snapshots.
+ * Metadata lives in a small index file so listing never touches payloads. Payloads are
+ * written as TCHAR text, memory mapped on load and read in place, and kept resident in LRU
+ * order within a byte budget.
+ */
+class AEGISBRIDGE_API FAegisSnapshotStore
+{
+public:
+    FAegisSnapshotStore();
+    ~FAegisSnapshotStore();
+
+    FAegisSnapshotStore(const FAegisSnapshotStore&) = delete;
+    FAegisSnapshotStore& operator=(const FAegisSnapshotStore&) = delete;
+
+    /** Open the store in the given directory and read its index */
+    void Initialize(const FString& InRootDir, int64 InMaxResidentBytes = 256 * 1024 * 1024);
+
+    /** Release all mappings */
+    void Shutdown();
+
+    /**
+     * Write a payload to disk and index it under the caller's metadata, so the payload is never
+     * parsed here. SnapshotId, FileName and Size are filled in; an unset Timestamp means now.
+     * A delta record names its base snapshot in Metadata.BaseSnapshotId.
+     */
+    bool Store(const FString& SnapshotId, const FString& SnapshotData, const FAegisSnapshotRecord& Metadata = FAegisSnapshotRecord());
+
+    /**
+     * Payload text viewed in place in its mapping, valid until the next store operation.
+     * A payload still stored as UTF-8 is converted and rewritten as TCHAR text on first load.
+     */
+    FStringView LoadText(const FString& SnapshotId);
+
+    /** Copy a payload into a string, for callers that keep it past the next store operation */
+    bool Load(const FString& SnapshotId, FString& OutData);
+
+    /** Raw payload bytes, valid until the next store operation */
+    TConstArrayView<uint8> LoadView(const FString& SnapshotId);
+
+    /** Delete a payload and its index entry */
+    bool Remove(const FString& SnapshotId);
+
+    /** Delete several payloads with one index write; returns how many were stored */
+    int32 Remove(TConstArrayView<FString> SnapshotIds);
+
+    bool Contains(const FString& SnapshotId) const { return Records.Contains(SnapshotId); }
+
+    /** Metadata of every full snapshot, read from the index only */
+    void List(TArray<FAegisSnapshotRecord>& OutRecords) const;
+
+    /** Ids of the delta records stored for a base snapshot */
+    void ListDeltas(const FString& BaseSnapshotId, TArray<FString>& OutSnapshotIds) const;
+
+    /** Base snapshots with at least one delta record */
+    void ListDeltaBases(TArray<FString>& OutBaseSnapshotIds) const;
+
+    /** Bytes currently mapped */
+    int64 GetResidentBytes() const { return ResidentBytes; }
+
+private:
+    /** A mapped payload */
+    struct FResidentPayload
+    {
+        TUniquePtr<IMappedFileHandle> Handle;
+        TUniquePtr<IMappedFileRegion> Region;
+
+        /** UseClock value of the last access */
+        uint64 LastUse = 0;
+    };
+
+    /** Map a payload, evicting least recently used payloads beyond the budget */
+    const FResidentPayload* MapPayload(const FString& SnapshotId);
+
+    /** Unmap a payload if resident */
+    void Unmap(const FString& SnapshotId);
+
+    /** Unmap least recently used payloads until the budget holds */
+    void EnforceBudget();
+
+    FString GetIndexPath() const;
+    FString GetPayloadPath(const FAegisSnapshotRecord& Record) const;
+
+    void LoadIndex();
+    bool SaveIndex() const;
+
+private:
+    FString RootDir;
+
+    int64 MaxResidentBytes = 0;
+    int64 ResidentBytes = 0;
+
+    /** Snapshot id -> metadata */
+    TMap<FString, FAegisSnapshotRecord> Records;
+
+    /** Snapshot id -> mapped payload */
+    TMap<FString, FResidentPayload> Resident;
+
+    /** Advances on every access; the resident payload with the lowest LastUse is evicted first */
+    uint64 UseClock = 0;
+};
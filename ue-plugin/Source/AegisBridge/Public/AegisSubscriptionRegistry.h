@@ -0,0 +1,46 @@
+// Copyright AEGIS Team. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+/**
+ * AEGIS Subscription Registry
+ * Topic patterns per WebSocket client. A pattern is an exact event type such as
+ * "world.entity.spawned", a dotted prefix wildcard such as "world.entity.*", or "*".
+ * Matching an event walks its prefixes, so the cost depends on the topic depth rather than
+ * the number of subscriptions, and results are cached until the subscriptions change.
+ */
+class AEGISBRIDGE_API FAegisSubscriptionRegistry
+{
+public:
+    /** Add a pattern for a client. Returns false for malformed patterns. */
+    bool Subscribe(const FString& ClientId, const FString& Pattern);
+
+    /** Remove a pattern; returns false if the client did not hold it */
+    bool Unsubscribe(const FString& ClientId, const FString& Pattern);
+
+    /** Drop every pattern of a disconnected client */
+    void RemoveClient(const FString& ClientId);
+
+    /** Clients with at least one pattern matching the event type. Points into the match cache; copy it before anything that may touch the registry. */
+    const TArray<FString>& GetSubscribers(const FString& EventType) const;
+
+    bool HasSubscribers(const FString& EventType) const { return GetSubscribers(EventType).Num() > 0; }
+
+    /** Patterns held by a client */
+    TArray<FString> GetPatterns(const FString& ClientId) const;
+
+    /** Exact topics, "prefix.*" and "*" are valid; wildcards elsewhere are not */
+    static bool IsValidPattern(const FString& Pattern);
+
+private:
+    /** Pattern -> clients holding it */
+    TMap<FString, TSet<FString>> PatternClients;
+
+    /** Client -> patterns it holds */
+    TMap<FString, TSet<FString>> ClientPatterns;
+
+    /** Event type -> matching clients, reset on every subscription change */
+    mutable TMap<FString, TArray<FString>> MatchCache;
+};
@@ -6,6 +6,9 @@
 #include "Subsystems/EditorSubsystem.h"
 #include "AegisSubsystem.generated.h"
 
+struct FAegisActorQueryParams;
+struct FAegisAssetSearchParams;
+
 DECLARE_LOG_CATEGORY_EXTERN(LogAegisSubsystem, Log, All);
 
 /**
@@ -56,6 +59,47 @@ struct FAegisSpawnParams
     TMap<FString, FString> Properties;
 };
 
+/**
+ * How a batch reacts to a failing operation
+ */
+UENUM(BlueprintType)
+enum class EAegisBatchFailureMode : uint8
+{
+    /** Run every operation and report failures individually */
+    ContinueOnError,
+
+    /** Stop at the first failure, keeping operations already applied */
+    StopOnError,
+
+    /** Stop at the first failure and undo the whole batch */
+    RollbackOnError
+};
+
+/**
+ * Single operation inside a command batch
+ */
+USTRUCT(BlueprintType)
+struct FAegisBatchOperation
+{
+    GENERATED_BODY()
+
+    /** Operation kind: "spawn", "modify" or "delete" */
+    UPROPERTY(BlueprintReadWrite)
+    FString Op;
+
+    /** Target actor for modify/delete */
+    UPROPERTY(BlueprintReadWrite)
+    FString ActorPath;
+
+    /** Spawn parameters for spawn */
+    UPROPERTY(BlueprintReadWrite)
+    FAegisSpawnParams SpawnParams;
+
+    /** Properties for modify */
+    UPROPERTY(BlueprintReadWrite)
+    TMap<FString, FString> Properties;
+};
+
 /**
  * AEGIS Editor Subsystem
  * Core subsystem for AI-powered Unreal Engine operations
@@ -94,6 +138,9 @@ public:
     UFUNCTION(BlueprintCallable, Category = "AEGIS|Actors")
     FAegisCommandResult QueryActors(const FString& ClassFilter, const FString& NameFilter, const TArray<FString>& Tags);
 
+    /** Query actors with the full filter set: spatial clauses, nearest-first ordering and paging */
+    FAegisCommandResult RunActorQuery(const FAegisActorQueryParams& QueryParams);
+
     /** Get actor information */
     UFUNCTION(BlueprintCallable, Category = "AEGIS|Actors")
     FAegisCommandResult GetActorInfo(const FString& ActorPath, bool bIncludeComponents, bool bIncludeProperties);
@@ -106,6 +153,10 @@ public:
     UFUNCTION(BlueprintCallable, Category = "AEGIS|Actors")
     FAegisCommandResult SelectActors(const TArray<FString>& ActorPaths, bool bAddToSelection);
 
+    /** Run spawn/modify/delete operations in a single undo transaction */
+    UFUNCTION(BlueprintCallable, Category = "AEGIS|Actors")
+    FAegisCommandResult ExecuteBatch(const TArray<FAegisBatchOperation>& Operations, EAegisBatchFailureMode FailureMode);
+
     // =========================================================================
     // Blueprint Operations
     // =========================================================================
@@ -134,6 +185,9 @@ public:
     UFUNCTION(BlueprintCallable, Category = "AEGIS|Assets")
     FAegisCommandResult SearchAssets(const FString& SearchQuery, const FString& AssetType, const FString& Path);
 
+    /** Search the asset index one page at a time: {assets, count, nextCursor}. Safe on any thread. */
+    static FAegisCommandResult SearchAssetIndex(const FAegisAssetSearchParams& SearchParams);
+
     /** Load an asset */
     UFUNCTION(BlueprintCallable, Category = "AEGIS|Assets")
     FAegisCommandResult LoadAsset(const FString& AssetPath);
@@ -194,18 +248,34 @@ public:
     // Context Operations
     // =========================================================================
 
-    /** Get current editor context for AI */
+    /**
+     * Get current editor context for AI, from the cached context model.
+     * When SinceVersion is the current version only {version, unchanged} is returned.
+     */
     UFUNCTION(BlueprintCallable, Category = "AEGIS|Context")
-    FAegisCommandResult GetEditorContext();
+    FAegisCommandResult GetEditorContext(int64 SinceVersion = -1);
 
     /** Get project information */
     UFUNCTION(BlueprintCallable, Category = "AEGIS|Context")
     FAegisCommandResult GetProjectInfo();
 
+    /** Get bridge latency, payload and queue figures; bReset clears them after reading */
+    UFUNCTION(BlueprintCallable, Category = "AEGIS|Context")
+    FAegisCommandResult GetBridgeStats(bool bReset = false);
+
 private:
     /** Find actor by path */
     AActor* FindActorByPath(const FString& ActorPath);
 
+    /** Resolve an actor class by name or path */
+    UClass* ResolveActorClass(const FString& ClassName);
+
+    /** Spawn an actor without opening a transaction or dirtying the level */
+    AActor* SpawnActorInternal(UWorld* World, UClass* ActorClass, const FAegisSpawnParams& Params);
+
+    /** Apply transform and reflected properties, returns the number applied */
+    int32 ApplyActorProperties(AActor* Actor, const TMap<FString, FString>& Properties);
+
     /** Convert actor to JSON */
     TSharedPtr<FJsonObject> ActorToJson(AActor* Actor, bool bIncludeComponents, bool bIncludeProperties);
 
@@ -4,12 +4,17 @@
 
 #include "CoreMinimal.h"
 #include "UObject/NoExportTypes.h"
-#include "IWebSocketServer.h"
+#include "Containers/Ticker.h"
+#include "AegisEventCoalescer.h"
+#include "AegisJsonWriter.h"
+#include "AegisSubscriptionRegistry.h"
+#include "AegisWebSocketTransport.h"
 #include "AegisWebSocketServer.generated.h"
 
 /**
  * AEGIS WebSocket Server
- * Handles real-time bidirectional communication with MCP server
+ * Handles real-time bidirectional communication with MCP server.
+ * Game-thread calls only serialize and queue frames; FAegisWebSocketTransport owns the sockets.
  */
 UCLASS()
 class AEGISBRIDGE_API UAegisWebSocketServer : public UObject
@@ -21,14 +26,42 @@ public:
     static UAegisWebSocketServer* Get();
 
     /** Initialize the WebSocket server */
-    void Initialize(int32 Port = 30020);
+    void Initialize(int32 Port = 30021);
 
     /** Shutdown the WebSocket server */
     void Shutdown();
 
-    /** Broadcast an event to all connected clients */
+    /** Whether any client subscribed to a topic matching the event type */
+    bool HasSubscribers(const FString& EventType) const;
+
+    /**
+     * Broadcast an event to its subscribers. WriteData writes the data object value and only
+     * runs when someone is subscribed; the encoded frame is shared by every recipient.
+     */
+    void BroadcastEvent(const FString& EventType, TFunctionRef<void(FAegisJsonWriter&)> WriteData);
+
+    /** Broadcast an already built event object to its subscribers */
     void BroadcastEvent(const FString& EventType, const TSharedPtr<FJsonObject>& Data);
 
+    // =========================================================================
+    // Coalesced events
+    // =========================================================================
+
+    /** Queue an actor spawn for the next world.entity.changed batch */
+    void QueueActorSpawned(AActor* Actor);
+
+    /** Queue an actor delete; a spawn of the same actor in the window cancels it */
+    void QueueActorDestroyed(AActor* Actor);
+
+    /** Report the selection once the window closes, however often it changed */
+    void QueueSelectionChanged();
+
+    /** Push the editor context sections changed in the window as one diff */
+    void QueueEditorContextChanged();
+
+    /** Send the pending batches now, e.g. before a level change */
+    void FlushCoalescedEvents();
+
     /** Send a message to a specific client */
     void SendToClient(const FString& ClientId, const FString& Message);
 
@@ -38,9 +71,18 @@ public:
     /** Get connected client count */
     int32 GetClientCount() const;
 
+    /** Backpressure counters of a connected client */
+    bool GetClientStats(const FString& ClientId, FAegisWebSocketClientStats& OutStats) const;
+
+    /** Backpressure counters of every connected client, by client id */
+    void GetAllClientStats(TArray<TPair<FString, FAegisWebSocketClientStats>>& OutStats) const;
+
+    /** Change what a client's queue does when it falls behind */
+    bool SetClientDropPolicy(const FString& ClientId, EAegisDropPolicy Policy);
+
 protected:
     /** Handle new client connection */
-    void OnClientConnected(const FString& ClientId);
+    void OnClientConnected(const FAegisWebSocketClientPtr& Client);
 
     /** Handle client disconnection */
     void OnClientDisconnected(const FString& ClientId);
@@ -49,11 +91,32 @@ protected:
     void OnMessageReceived(const FString& ClientId, const FString& Message);
 
 private:
-    /** WebSocket server instance */
-    TSharedPtr<IWebSocketServer> WebSocketServer;
+    /** Dispatch connection events queued by the network thread and flush due batches */
+    bool Tick(float DeltaTime);
+
+    /** Encode a message once for any number of clients sharing an encoding */
+    static FAegisWebSocketPayload MakePayload(const FString& Message, EAegisWireEncoding Encoding);
+
+    /** Encode {type, event, timestamp, data} once per encoding in use and queue it for every subscriber */
+    void BroadcastFrame(const FString& EventType, TFunctionRef<void(FAegisJsonWriter&)> WriteDataField);
+
+    /** Queue a frame for one client and wake the network thread */
+    void Send(FAegisWebSocketClient& Client, const FAegisWebSocketPayload& Payload);
+
+private:
+    /** Network thread and sockets */
+    TUniquePtr<FAegisWebSocketTransport> Transport;
+
+    FTSTicker::FDelegateHandle TickHandle;
+
+    /** Connected clients, game thread view */
+    TMap<FString, FAegisWebSocketClientPtr> ConnectedClients;
+
+    /** Event topics per client */
+    FAegisSubscriptionRegistry Subscriptions;
 
-    /** Connected clients */
-    TMap<FString, bool> ConnectedClients;
+    /** Spawn/delete and selection storms, batched per window */
+    FAegisEventCoalescer Coalescer;
 
     /** Server running state */
     bool bIsRunning = false;
@@ -0,0 +1,222 @@
+// Copyright AEGIS Team. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "HAL/Runnable.h"
+#include "Containers/Queue.h"
+#include <atomic>
+
+class IWebSocketServer;
+class INetworkingWebSocket;
+class FRunnableThread;
+class FEvent;
+
+/**
+ * What a client's outbound queue does once it exceeds its byte budget
+ */
+enum class EAegisDropPolicy : uint8
+{
+    /** Discard the oldest queued frames; suits state events where only the latest matters */
+    DropOldest,
+
+    /** Refuse new frames until the queue drains */
+    DropNewest,
+
+    /** Close the connection; the client reconnects and resyncs */
+    Disconnect,
+};
+
+/** Parse "oldest", "newest" or "disconnect" */
+AEGISBRIDGE_API bool ParseDropPolicy(const FString& Name, EAegisDropPolicy& OutPolicy);
+
+/**
+ * Frame encoding negotiated per client through the "configure" message
+ */
+enum class EAegisWireEncoding : uint8
+{
+    /** UTF-8 JSON text */
+    Json,
+
+    /** MessagePack, see FAegisMessagePack */
+    MessagePack,
+};
+
+/** Parse "json" or "msgpack" */
+AEGISBRIDGE_API bool ParseWireEncoding(const FString& Name, EAegisWireEncoding& OutEncoding);
+
+/** Immutable encoded frame, shared by every client it is queued for */
+using FAegisWebSocketPayload = TSharedPtr<const TArray<uint8>, ESPMode::ThreadSafe>;
+
+/**
+ * Backpressure counters of one client
+ */
+struct FAegisWebSocketClientStats
+{
+    int32 QueuedMessages = 0;
+    int64 QueuedBytes = 0;
+    int32 PeakQueuedMessages = 0;
+    int64 SentMessages = 0;
+    int64 SentBytes = 0;
+    int64 DroppedMessages = 0;
+
+    /** Frames larger than the whole queue budget; also counted in DroppedMessages */
+    int64 OversizedMessages = 0;
+};
+
+/**
+ * Connection state shared between the threads that queue frames and the network thread
+ * that drains them onto the socket. Queuing never blocks and never touches the socket.
+ */
+class AEGISBRIDGE_API FAegisWebSocketClient
+{
+public:
+    FAegisWebSocketClient(const FString& InClientId, const FString& InRemoteAddress, EAegisDropPolicy InDropPolicy, int64 InMaxQueuedBytes);
+
+    const FString ClientId;
+    const FString RemoteAddress;
+
+    /**
+     * Queue a frame from any thread. Returns false when the drop policy rejected it, or when the
+     * frame alone exceeds the byte budget and could never be sent.
+     */
+    bool Enqueue(const FAegisWebSocketPayload& Payload);
+
+    /** Network thread: pop the next frame */
+    bool Dequeue(FAegisWebSocketPayload& OutPayload);
+
+    /** Network thread: discard oldest frames until the queue fits its budget */
+    void TrimToBudget();
+
+    FAegisWebSocketClientStats GetStats() const;
+
+    EAegisDropPolicy GetDropPolicy() const { return DropPolicy.load(std::memory_order_relaxed); }
+    void SetDropPolicy(EAegisDropPolicy InPolicy) { DropPolicy.store(InPolicy, std::memory_order_relaxed); }
+
+    /** Encoding of the frames queued for this client */
+    EAegisWireEncoding GetEncoding() const { return Encoding.load(std::memory_order_relaxed); }
+    void SetEncoding(EAegisWireEncoding InEncoding) { Encoding.store(InEncoding, std::memory_order_relaxed); }
+
+    /** The network thread closes the socket on its next pass */
+    void RequestClose() { bCloseRequested.store(true); }
+    bool IsCloseRequested() const { return bCloseRequested.load(); }
+
+    /** Network thread: account for a frame handed to the socket */
+    void RecordSent(int64 Bytes);
+
+private:
+    TQueue<FAegisWebSocketPayload, EQueueMode::Mpsc> Outbound;
+
+    const int64 MaxQueuedBytes;
+
+    std::atomic<EAegisDropPolicy> DropPolicy;
+    std::atomic<EAegisWireEncoding> Encoding{ EAegisWireEncoding::Json };
+    std::atomic<bool> bCloseRequested{ false };
+
+    std::atomic<int32> QueuedMessages{ 0 };
+    std::atomic<int64> QueuedBytes{ 0 };
+    std::atomic<int32> PeakQueuedMessages{ 0 };
+    std::atomic<int64> SentMessages{ 0 };
+    std::atomic<int64> SentBytes{ 0 };
+    std::atomic<int64> DroppedMessages{ 0 };
+    std::atomic<int64> OversizedMessages{ 0 };
+};
+
+using FAegisWebSocketClientPtr = TSharedPtr<FAegisWebSocketClient, ESPMode::ThreadSafe>;
+
+/**
+ * Connection event handed from the network thread to the game thread
+ */
+struct FAegisWebSocketEvent
+{
+    enum class EType : uint8
+    {
+        Connected,
+        Disconnected,
+        Message,
+    };
+
+    EType Type = EType::Message;
+    FAegisWebSocketClientPtr Client;
+    FString Message;
+};
+
+/**
+ * AEGIS WebSocket Transport
+ * Owns the WebSocketNetworking server on a dedicated network thread. The thread ticks the
+ * server, drains every client's outbound queue within a per-pass byte budget so one lagging
+ * client cannot starve the others, and reports connections and inbound messages through a
+ * queue the game thread polls.
+ */
+class AEGISBRIDGE_API FAegisWebSocketTransport : public FRunnable
+{
+public:
+    struct FSettings
+    {
+        int32 Port = 30021;
+
+        EAegisDropPolicy DropPolicy = EAegisDropPolicy::DropOldest;
+
+        /** Outbound queue budget per client */
+        int64 MaxQueuedBytes = 8 * 1024 * 1024;
+
+        /** Bytes handed to one socket per network pass */
+        int64 MaxSendBytesPerPass = 256 * 1024;
+
+        /** Network pass interval when no frames are queued */
+        float IdleIntervalSeconds = 0.005f;
+    };
+
+    explicit FAegisWebSocketTransport(const FSettings& InSettings);
+    virtual ~FAegisWebSocketTransport() override;
+
+    /** Bind the port and start the network thread */
+    bool Start();
+
+    /** Stop and join the network thread; sockets are closed on that thread */
+    void Shutdown();
+
+    /** Wake the network thread after queuing frames */
+    void Wake();
+
+    /** Game thread: pop the next connection event. Messages arrive as JSON whatever their encoding. */
+    bool PollEvent(FAegisWebSocketEvent& OutEvent) { return Events.Dequeue(OutEvent); }
+
+    const FSettings& GetSettings() const { return Settings; }
+
+    //~ Begin FRunnable Interface
+    virtual uint32 Run() override;
+    virtual void Stop() override;
+    //~ End FRunnable Interface
+
+private:
+    /** Socket state, touched by the network thread only */
+    struct FConnection
+    {
+        TUniquePtr<INetworkingWebSocket> Socket;
+        FAegisWebSocketClientPtr Client;
+        bool bClosed = false;
+    };
+
+    void HandleClientConnected(INetworkingWebSocket* Socket);
+    void HandlePacketReceived(void* Data, int32 Size, FString ClientId);
+    void HandleSocketClosed(FString ClientId);
+
+    FConnection* FindConnection(const FString& ClientId);
+
+    /** Send queued frames and drop closed connections */
+    void FlushConnections();
+
+private:
+    const FSettings Settings;
+
+    TUniquePtr<IWebSocketServer> Server;
+    TArray<FConnection> Connections;
+
+    /** Network thread -> game thread */
+    TQueue<FAegisWebSocketEvent, EQueueMode::Spsc> Events;
+
+    FRunnableThread* Thread = nullptr;
+    FEvent* WakeEvent = nullptr;
+    std::atomic<bool> bStopping{ false };
+};
@@ -0,0 +1,106 @@
+// Copyright AEGIS Team. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "AegisJsonWriter.h"
+
+class FAegisBinarySnapshot;
+struct FAegisSnapshotEntity;
+
+/** What FAegisWorldHash::Build hashes */
+struct FAegisWorldHashOptions
+{
+    /** Grid cell size in world units; zero or less uses the default */
+    double CellSize = 0.0;
+
+    /** Properties hashed from each entity's property block, in this order; others are ignored */
+    TArray<FString> Properties;
+};
+
+/** One entity leaf */
+struct FAegisWorldHashLeaf
+{
+    /** Entity GUID, or path for unregistered entities */
+    FString Key;
+    uint64 Hash = 0;
+};
+
+/** Entities of one level whose location falls in one grid cell */
+struct FAegisWorldHashCell
+{
+    FIntPoint Coord = FIntPoint::ZeroValue;
+    uint64 Hash = 0;
+
+    /** Ordered by key */
+    TArray<FAegisWorldHashLeaf> Leaves;
+};
+
+/** Cells of one level, keyed by the level package */
+struct FAegisWorldHashLevel
+{
+    FString Level;
+    uint64 Hash = 0;
+
+    /** Ordered by Y then X */
+    TArray<FAegisWorldHashCell> Cells;
+};
+
+/**
+ * AEGIS World Hash
+ * Merkle tree over the entities of a snapshot state: entity leaves are grouped into square
+ * XY grid cells per level, cell hashes into level hashes and level hashes into the root.
+ * Two states with the same root hold the same content; otherwise comparing the tree top down
+ * against a previous reply narrows the drift to levels, cells and entities.
+ *
+ * A leaf hash covers the class, the transform, tags, components and the selected properties.
+ * Transforms are quantized before hashing (0.01 units, 0.001 degrees, 0.0001 scale) so float
+ * round trips through the snapshot formats do not change the hash. Every hash pairs a node's
+ * content with its identity, so moved or renamed entities change their parents.
+ */
+class AEGISBRIDGE_API FAegisWorldHash
+{
+public:
+    /** 1 km cells */
+    static constexpr double DefaultCellSize = 100000.0;
+
+    /** Hash every entity of a snapshot state. Leaves are hashed in parallel. */
+    void Build(const FAegisBinarySnapshot& Snapshot, const FAegisWorldHashOptions& Options);
+
+    uint64 GetRootHash() const { return RootHash; }
+    int32 GetEntityCount() const { return EntityCount; }
+    double GetCellSize() const { return CellSize; }
+    const TArray<FAegisWorldHashLevel>& GetLevels() const { return Levels; }
+
+    /** Content hash of one entity; safe on any thread */
+    static uint64 HashEntity(const FAegisBinarySnapshot& Snapshot, const FAegisSnapshotEntity& Entity, TConstArrayView<FString> Properties);
+
+    /** Level an entity belongs to: the package part of its path */
+    static FString GetEntityLevel(const FAegisBinarySnapshot& Snapshot, const FAegisSnapshotEntity& Entity);
+
+    /** Node id of a cell: "<Level>@<X>,<Y>". Levels use the level package and leaves the entity key. */
+    static FString GetCellId(const FAegisWorldHashLevel& Level, const FAegisWorldHashCell& Cell);
+
+    /** Hashes as 16 lowercase hex digits */
+    static FString HashToString(uint64 Hash);
+
+    /**
+     * Write {rootHash, entityCount, cellSize, levels} with the tree down to Depth:
+     * 0 root only, 1 levels, 2 cells, 3 entities.
+     */
+    void WriteJson(FAegisJsonWriter& Writer, int32 Depth) const;
+
+    /**
+     * Compare against node hashes from a previous reply, by node id ("root" for the root).
+     * Writes {match, mismatches: [{id, kind, hash}], removed: [id]}, descending only into
+     * mismatching nodes; cells and entities the known hashes omit count as mismatching.
+     */
+    void WriteDiff(FAegisJsonWriter& Writer, const TMap<FString, FString>& KnownHashes) const;
+
+private:
+    double CellSize = DefaultCellSize;
+    uint64 RootHash = 0;
+    int32 EntityCount = 0;
+
+    TArray<FAegisWorldHashLevel> Levels;
+};
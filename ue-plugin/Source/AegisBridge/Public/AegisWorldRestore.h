@@ -0,0 +1,139 @@
+// Copyright AEGIS Team. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "AegisBinarySnapshot.h"
+#include "Engine/StreamableManager.h"
+#include "UObject/GCObject.h"
+#include "UObject/WeakObjectPtrTemplates.h"
+
+class AActor;
+class ULevel;
+class UWorld;
+
+/**
+ * AEGIS World Restore
+ * Spawns the entities of a decoded snapshot in two stages, each of which can be advanced
+ * under a time budget:
+ *
+ *   1. Resolve: every distinct class is resolved once; classes not in memory are requested
+ *      as one async batch through FStreamableManager.
+ *   2. Spawn: each actor is spawned with bDeferConstruction and finished in the same slice,
+ *      so construction runs once with the full transform and never spans a frame.
+ *
+ * The whole restore is one transaction, so one undo reverts it. Advance() keeps it open
+ * between slices; the transaction buffer refuses undo meanwhile, and the world's levels are
+ * locked so the user's own edits cannot land in the restore's undo record.
+ */
+class AEGISBRIDGE_API FAegisWorldRestore : public FGCObject
+{
+public:
+    enum class EStage : uint8
+    {
+        Resolve,
+        Loading,
+        Spawn,
+        Done,
+    };
+
+    FAegisWorldRestore(UWorld* InWorld, FAegisBinarySnapshot&& InSnapshot, bool bInPreserveGUIDs);
+    virtual ~FAegisWorldRestore();
+
+    //~ Begin FGCObject Interface
+    virtual void AddReferencedObjects(FReferenceCollector& Collector) override;
+    virtual FString GetReferencerName() const override { return TEXT("FAegisWorldRestore"); }
+    //~ End FGCObject Interface
+
+    /** Load a binary snapshot file, compressed or not. Touches no UObjects, so any thread may call it. */
+    static bool LoadSnapshotFile(const FString& InputPath, FAegisBinarySnapshot& OutSnapshot);
+
+    /** Advance until done or the deadline passes. Returns true when the restore finished. */
+    bool Advance(double Deadline);
+
+    /** Run to completion on the calling thread, loading classes synchronously */
+    int32 Run();
+
+    /**
+     * Stop early. Once spawning has begun the restore's transaction is undone, which removes
+     * the spawned actors and restores the replaced ones.
+     */
+    void Cancel();
+
+    /** Actors the snapshot replaces. They are destroyed ahead of the first spawn, in the same transaction. */
+    void SetReplacedActors(const TArray<AActor*>& Actors);
+
+    EStage GetStage() const { return Stage; }
+    const TCHAR* GetStageName() const;
+
+    /** Progress over the spawn stage: every entity is spawned or skipped */
+    void GetProgress(int64& OutDone, int64& OutTotal) const;
+
+    int32 GetEntityCount() const { return Snapshot.Entities.Num(); }
+
+    /** Actors that completed spawning */
+    int32 GetRestoredCount() const { return RestoredCount; }
+
+    /** Entities whose class could not be resolved */
+    int32 GetMissingClassCount() const { return MissingClassCount; }
+
+    /** The target world went away mid-restore */
+    bool WasAborted() const { return bAborted; }
+
+    /** An actor class already in memory, by path or by the short native name captures store */
+    static UClass* FindLoadedClass(const FString& ClassName);
+
+    /** An actor class by name, loading a Blueprint class by package path synchronously */
+    static UClass* ResolveClass(const FString& ClassName);
+
+private:
+    struct FPendingActor
+    {
+        TWeakObjectPtr<AActor> Actor;
+        int32 EntityIndex = INDEX_NONE;
+    };
+
+    void BeginTransaction();
+    void EndTransaction();
+
+    /** Lock the world's unlocked levels against user edits, or unlock the ones locked here */
+    void SetEditsGated(bool bGated);
+
+    void DestroyReplacedActors();
+
+    void ResolveClasses(bool bAsyncLoad);
+    void CollectLoadedClasses();
+    void SpawnEntities(double Deadline);
+
+    /** GUIDs are registered only once the restore completed, so a cancelled one leaves none behind */
+    void RegisterRestoredGUIDs();
+
+private:
+    TWeakObjectPtr<UWorld> World;
+    FAegisBinarySnapshot Snapshot;
+    bool bPreserveGUIDs;
+
+    EStage Stage = EStage::Resolve;
+    bool bTransactionOpen = false;
+    bool bAborted = false;
+
+    /** Resolved class per class string index; null for unresolvable classes. Kept alive across ticks. */
+    TMap<int32, TObjectPtr<UClass>> Classes;
+
+    /** Class string indices waiting for the async load, with their soft paths */
+    TArray<TPair<int32, FSoftClassPath>> PendingLoads;
+
+    FStreamableManager StreamableManager;
+    TSharedPtr<FStreamableHandle> LoadHandle;
+
+    TArray<TWeakObjectPtr<AActor>> ReplacedActors;
+
+    /** Levels locked between slices, unlocked again when the restore ends */
+    TArray<TWeakObjectPtr<ULevel>> GatedLevels;
+
+    TArray<FPendingActor> Spawned;
+    int32 NextSpawnIndex = 0;
+
+    int32 RestoredCount = 0;
+    int32 MissingClassCount = 0;
+};